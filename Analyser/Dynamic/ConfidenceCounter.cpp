@@ -11,6 +11,11 @@
 using namespace Analyser::Dynamic;
 
 float ConfidenceCounter::get_confidence() {
+	switch(definitive_) {
+		case Definitive::Appropriate:	return 1.0f;
+		case Definitive::Inappropriate:	return 0.0f;
+		default: break;
+	}
 	return float(hits_) / float(hits_ + misses_);
 }
 
@@ -28,3 +33,9 @@ void ConfidenceCounter::add_equivocal() {
 		++misses_;
 	}
 }
+
+void ConfidenceCounter::add_definitive(bool is_appropriate) {
+	if(definitive_ == Definitive::Unknown) {
+		definitive_ = is_appropriate ? Definitive::Appropriate : Definitive::Inappropriate;
+	}
+}
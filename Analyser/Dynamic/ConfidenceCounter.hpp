@@ -36,9 +36,18 @@ class ConfidenceCounter: public ConfidenceSource {
 		*/
 		void add_equivocal();
 
+		/*!
+			Records an event that settles the question: if @c is_appropriate is @c true then the
+			probability becomes 1.0, otherwise it becomes 0.0. No further events will affect it.
+		*/
+		void add_definitive(bool is_appropriate);
+
 	private:
 		int hits_ = 1;
 		int misses_ = 1;
+		enum class Definitive {
+			Unknown, Appropriate, Inappropriate
+		} definitive_ = Definitive::Unknown;
 };
 
 }
@@ -9,6 +9,7 @@
 #include "MultiConfigurable.hpp"
 
 #include <algorithm>
+#include <set>
 
 using namespace Analyser::Dynamic;
 
@@ -17,9 +18,14 @@ namespace {
 class MultiStruct: public Reflection::Struct {
 	public:
 		MultiStruct(const std::vector<Configurable::Device *> &devices) : devices_(devices) {
+			std::set<std::string> keys;
 			for(auto device: devices) {
 				options_.emplace_back(device->get_options());
+				for(size_t c = 0; c < options_.back()->key_count(); c++) {
+					keys.emplace(options_.back()->key(c));
+				}
 			}
+			keys_.assign(keys.begin(), keys.end());
 		}
 
 		void apply() {
@@ -30,16 +36,15 @@ class MultiStruct: public Reflection::Struct {
 			}
 		}
 
-		std::vector<std::string> all_keys() const final {
-			std::set<std::string> keys;
-			for(auto &options: options_) {
-				const auto new_keys = options->all_keys();
-				keys.insert(new_keys.begin(), new_keys.end());
-			}
-			return std::vector<std::string>(keys.begin(), keys.end());
+		size_t key_count() const final {
+			return keys_.size();
+		}
+
+		std::string_view key(size_t index) const final {
+			return keys_[index];
 		}
 
-		std::vector<std::string> values_for(const std::string &name) const final {
+		std::vector<std::string> values_for(std::string_view name) const final {
 			std::set<std::string> values;
 			for(auto &options: options_) {
 				const auto new_values = options->values_for(name);
@@ -48,7 +53,7 @@ class MultiStruct: public Reflection::Struct {
 			return std::vector<std::string>(values.begin(), values.end());
 		}
 
-		const std::type_info *type_of(const std::string &name) const final {
+		const std::type_info *type_of(std::string_view name) const final {
 			for(auto &options: options_) {
 				auto info = options->type_of(name);
 				if(info) return info;
@@ -56,7 +61,7 @@ class MultiStruct: public Reflection::Struct {
 			return nullptr;
 		}
 
-		size_t count_of(const std::string &name) const final {
+		size_t count_of(std::string_view name) const final {
 			for(auto &options: options_) {
 				auto info = options->type_of(name);
 				if(info) return options->count_of(name);
@@ -64,7 +69,7 @@ class MultiStruct: public Reflection::Struct {
 			return 0;
 		}
 
-		const void *get(const std::string &name) const final {
+		const void *get(std::string_view name) const final {
 			for(auto &options: options_) {
 				auto value = options->get(name);
 				if(value) return value;
@@ -72,7 +77,7 @@ class MultiStruct: public Reflection::Struct {
 			return nullptr;
 		}
 
-		void *get(const std::string &name) final {
+		void *get(std::string_view name) final {
 			for(auto &options: options_) {
 				auto value = options->get(name);
 				if(value) return value;
@@ -80,7 +85,7 @@ class MultiStruct: public Reflection::Struct {
 			return nullptr;
 		}
 
-		void set(const std::string &name, const void *value, size_t offset) final {
+		void set(std::string_view name, const void *value, size_t offset) final {
 			const auto safe_type = type_of(name);
 			if(!safe_type) return;
 
@@ -99,6 +104,7 @@ class MultiStruct: public Reflection::Struct {
 	private:
 		const std::vector<Configurable::Device *> &devices_;
 		std::vector<std::unique_ptr<Reflection::Struct>> options_;
+		std::vector<std::string> keys_;
 };
 
 }
@@ -17,19 +17,22 @@ using namespace Analyser::Dynamic;
 
 template <typename MachineType>
 void MultiInterface<MachineType>::perform_parallel(const std::function<void(MachineType *)> &function) {
-	// Apply a blunt force parallelisation of the machines; each run_for is dispatched
-	// to a separate queue and this queue will block until all are done.
+	// Apply a blunt force parallelisation of the machines; each run_for other than the front machine's
+	// is dispatched to a separate queue, the front machine is run on the calling thread, and this thread
+	// then blocks until all are done. So no machine waits on any other except at the end of each call.
 	volatile std::size_t outstanding_machines;
 	std::condition_variable condition;
 	std::mutex mutex;
+	MachineType *front_machine;
 	{
 		std::lock_guard machines_lock(machines_mutex_);
 		std::lock_guard lock(mutex);
-		outstanding_machines = machines_.size();
+		outstanding_machines = machines_.size() - 1;
+		front_machine = ::Machine::get<MachineType>(*machines_.front().get());
 
-		for(std::size_t index = 0; index < machines_.size(); ++index) {
+		for(std::size_t index = 1; index < machines_.size(); ++index) {
 			const auto machine = ::Machine::get<MachineType>(*machines_[index].get());
-			queues_[index].enqueue([&mutex, &condition, machine, function, &outstanding_machines]() {
+			queues_[index].enqueue([&mutex, &condition, machine, &function, &outstanding_machines]() {
 				if(machine) function(machine);
 
 				std::lock_guard lock(mutex);
@@ -39,6 +42,8 @@ void MultiInterface<MachineType>::perform_parallel(const std::function<void(Mach
 		}
 	}
 
+	if(front_machine) function(front_machine);
+
 	std::unique_lock lock(mutex);
 	condition.wait(lock, [&outstanding_machines] { return !outstanding_machines; });
 }
@@ -100,6 +105,13 @@ void MultiTimedMachine::run_for(Time::Seconds duration) {
 	perform_parallel([duration](::MachineTypes::TimedMachine *machine) {
 		if(machine->get_confidence() >= 0.01f) machine->run_for(duration);
 	});
+	time_run_ += duration;
 
 	if(delegate_) delegate_->did_run_machines(this);
 }
+
+void MultiTimedMachine::set_loading_speed_multiplier(double multiplier) {
+	perform_serial([multiplier](::MachineTypes::TimedMachine *machine) {
+		machine->set_loading_speed_multiplier(multiplier);
+	});
+}
@@ -32,7 +32,8 @@ template <typename MachineType> class MultiInterface {
 			Performs a parallel for operation across all machines, performing the supplied
 			function on each and returning only once all applications have completed.
 
-			No guarantees are extended as to which thread operations will occur on.
+			The front machine is always processed on the calling thread; no guarantees are
+			extended as to which threads others will be processed on.
 		*/
 		void perform_parallel(const std::function<void(MachineType *)> &);
 
@@ -67,10 +68,17 @@ class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, publ
 		}
 
 		void run_for(Time::Seconds duration) final;
+		void set_loading_speed_multiplier(double multiplier) final;
+
+		/// @returns The total amount of time for which machines have been run.
+		Time::Seconds get_time_run() const {
+			return time_run_;
+		}
 
 	private:
 		void run_for(const Cycles) final {}
 		Delegate *delegate_ = nullptr;
+		Time::Seconds time_run_ = 0.0;
 };
 
 class MultiScanProducer: public MultiInterface<MachineTypes::ScanProducer>, public MachineTypes::ScanProducer {
@@ -45,12 +45,23 @@ Provider(MachineTypes::AudioProducer, audio_producer, audio_producer_)
 Provider(MachineTypes::JoystickMachine, joystick_machine, joystick_machine_)
 Provider(MachineTypes::KeyboardMachine, keyboard_machine, keyboard_machine_)
 Provider(MachineTypes::MediaTarget, media_target, media_target_)
+Provider(MachineTypes::Profiled, profiled, timed_machine_)
 
 MachineTypes::MouseMachine *MultiMachine::mouse_machine() {
 	// TODO.
 	return nullptr;
 }
 
+MachineTypes::StateProducer *MultiMachine::state_producer() {
+	// A state can be produced only once it is known which machine is really in use.
+	return nullptr;
+}
+
+MachineTypes::BusTraceable *MultiMachine::bus_traceable() {
+	// Similarly, there's no single bus to trace until a machine has been selected.
+	return nullptr;
+}
+
 #undef Provider
 
 bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines) {
@@ -82,7 +93,13 @@ void MultiMachine::did_run_machines(MultiTimedMachine *) {
 		audio_producer_.did_change_machine_order();
 	}
 
-	if(would_collapse(machines_)) {
+	if(
+		would_collapse(machines_) ||
+		(
+			timed_machine_.get_time_run() >= EarlyCollapseTime &&
+			machines_.front()->timed_machine()->get_confidence() > machines_[1]->timed_machine()->get_confidence()
+		)
+	) {
 		pick_first();
 	}
 }
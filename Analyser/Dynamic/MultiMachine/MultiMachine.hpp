@@ -37,7 +37,8 @@ namespace Dynamic {
 	confidence.
 
 	If confidence for any machine becomes disproportionately low compared to
-	the others in the set, that machine stops running.
+	the others in the set, that machine stops running. Once the machines have run
+	for EarlyCollapseTime, any lead at all is sufficient for the frontmost to be picked.
 */
 class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::Delegate {
 	public:
@@ -49,6 +50,10 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 				@c false otherwise.
 		*/
 		static bool would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines);
+
+		/// The amount of emulated time after which the machines are no longer given the
+		/// opportunity to establish a clear winner, and the frontmost is picked if it leads at all.
+		static constexpr Time::Seconds EarlyCollapseTime = 0.5;
 		MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machines);
 
 		Activity::Source *activity_source() final;
@@ -60,6 +65,9 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		MachineTypes::KeyboardMachine *keyboard_machine() final;
 		MachineTypes::MouseMachine *mouse_machine() final;
 		MachineTypes::MediaTarget *media_target() final;
+		MachineTypes::StateProducer *state_producer() final;
+		MachineTypes::Profiled *profiled() final;
+		MachineTypes::BusTraceable *bus_traceable() final;
 		void *raw_pointer() final;
 
 	private:
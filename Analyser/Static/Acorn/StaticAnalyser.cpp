@@ -68,7 +68,7 @@ Analyser::Static::TargetList Analyser::Static::Acorn::GetTargets(const Media &me
 	// if there are any tapes, attempt to get data from the first
 	if(!media.tapes.empty()) {
 		std::shared_ptr<Storage::Tape::Tape> tape = media.tapes.front();
-		std::vector<File> files = GetFiles(tape);
+		std::vector<File> files = GetFiles(AnalysisPrefix(tape), 1);
 		tape->reset();
 
 		// continue if there are any files
@@ -124,7 +124,20 @@ static std::unique_ptr<File> GetNextFile(std::deque<File::Chunk> &chunks) {
 	return file;
 }
 
-std::vector<File> Analyser::Static::Acorn::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape) {
+static std::vector<File> DecomposeChunks(std::deque<File::Chunk> chunk_list) {
+	std::vector<File> file_list;
+
+	while(chunk_list.size()) {
+		std::unique_ptr<File> next_file = GetNextFile(chunk_list);
+		if(next_file) {
+			file_list.push_back(*next_file);
+		}
+	}
+
+	return file_list;
+}
+
+std::vector<File> Analyser::Static::Acorn::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files) {
 	Storage::Tape::Acorn::Parser parser;
 
 	// populate chunk list
@@ -133,18 +146,18 @@ std::vector<File> Analyser::Static::Acorn::GetFiles(const std::shared_ptr<Storag
 		std::unique_ptr<File::Chunk> chunk = GetNextChunk(tape, parser);
 		if(chunk) {
 			chunk_list.push_back(*chunk);
-		}
-	}
-
-	// decompose into file list
-	std::vector<File> file_list;
 
-	while(chunk_list.size()) {
-		std::unique_ptr<File> next_file = GetNextFile(chunk_list);
-		if(next_file) {
-			file_list.push_back(*next_file);
+			// Files are complete only at a final block; stop reading once enough have been.
+			if(maximum_files != SIZE_MAX && (chunk->block_flag & 0x80)) {
+				std::vector<File> file_list = DecomposeChunks(chunk_list);
+				if(file_list.size() >= maximum_files) {
+					file_list.resize(maximum_files);
+					return file_list;
+				}
+			}
 		}
 	}
 
-	return file_list;
+	// decompose into file list
+	return DecomposeChunks(std::move(chunk_list));
 }
@@ -9,6 +9,7 @@
 #ifndef StaticAnalyser_Acorn_Tape_hpp
 #define StaticAnalyser_Acorn_Tape_hpp
 
+#include <cstdint>
 #include <memory>
 
 #include "File.hpp"
@@ -18,7 +19,8 @@ namespace Analyser {
 namespace Static {
 namespace Acorn {
 
-std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape);
+/// @returns Files found on @c tape, stopping once @c maximum_files are complete.
+std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files = SIZE_MAX);
 
 }
 }
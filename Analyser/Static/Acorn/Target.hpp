@@ -33,6 +33,8 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			DeclareField(has_dfs);
 			DeclareField(has_ap6_rom);
 			DeclareField(has_sideways_ram);
+			DeclareField(should_shift_restart);
+			DeclareField(loading_command);
 		}
 	}
 };
@@ -26,6 +26,7 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 	Target() : Analyser::Static::Target(Machine::AmstradCPC) {
 		if(needs_declare()) {
 			DeclareField(model);
+			DeclareField(loading_command);
 			AnnounceEnum(Model);
 		}
 	}
@@ -33,7 +33,7 @@ static void DeterminePagingFor2kCartridge(Target &target, const Storage::Cartrid
 	// Assume that any kind of store that looks likely to be intended for large amounts of memory implies
 	// large amounts of memory.
 	bool has_wide_area_store = false;
-	for(std::map<uint16_t, Analyser::Static::MOS6502::Instruction>::value_type &entry : high_location_disassembly.instructions_by_address) {
+	for(const auto &entry : high_location_disassembly.instructions_by_address) {
 		if(entry.second.operation == Analyser::Static::MOS6502::Instruction::STA) {
 			has_wide_area_store |= entry.second.addressing_mode == Analyser::Static::MOS6502::Instruction::Indirect;
 			has_wide_area_store |= entry.second.addressing_mode == Analyser::Static::MOS6502::Instruction::IndexedIndirectX;
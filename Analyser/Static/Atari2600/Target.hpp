@@ -9,14 +9,16 @@
 #ifndef Analyser_Static_Atari2600_Target_h
 #define Analyser_Static_Atari2600_Target_h
 
+#include "../../../Reflection/Enum.hpp"
+#include "../../../Reflection/Struct.hpp"
 #include "../StaticAnalyser.hpp"
 
 namespace Analyser {
 namespace Static {
 namespace Atari2600 {
 
-struct Target: public ::Analyser::Static::Target {
-	enum class PagingModel {
+struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<Target> {
+	ReflectableEnum(PagingModel,
 		None,
 		CommaVid,
 		Atari8k,
@@ -29,13 +31,19 @@ struct Target: public ::Analyser::Static::Target {
 		MNetwork,
 		MegaBoy,
 		Pitfall2
-	};
+	);
 
 	// TODO: shouldn't these be properties of the cartridge?
 	PagingModel paging_model = PagingModel::None;
 	bool uses_superchip = false;
 
-	Target() : Analyser::Static::Target(Machine::Atari2600) {}
+	Target() : Analyser::Static::Target(Machine::Atari2600) {
+		if(needs_declare()) {
+			DeclareField(paging_model);
+			DeclareField(uses_superchip);
+			AnnounceEnum(PagingModel);
+		}
+	}
 };
 
 }
@@ -11,7 +11,7 @@
 
 Analyser::Static::TargetList Analyser::Static::AtariST::GetTargets(const Media &media, const std::string &, TargetPlatform::IntType) {
 	// This analyser can comprehend disks and mass-storage devices only.
-	if(media.disks.empty()) return {};
+	if(media.disks.empty() && media.mass_storage_devices.empty()) return {};
 
 	// As there is at least one usable media image, wave it through.
 	Analyser::Static::TargetList targets;
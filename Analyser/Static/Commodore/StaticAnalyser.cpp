@@ -69,7 +69,7 @@ Analyser::Static::TargetList Analyser::Static::Commodore::GetTargets(const Media
 
 	// check tapes
 	for(auto &tape : media.tapes) {
-		std::vector<File> tape_files = GetFiles(tape);
+		std::vector<File> tape_files = GetFiles(AnalysisPrefix(tape), 1);
 		tape->reset();
 		if(!tape_files.empty()) {
 			files.insert(files.end(), tape_files.begin(), tape_files.end());
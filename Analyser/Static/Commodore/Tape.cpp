@@ -12,13 +12,13 @@
 
 using namespace Analyser::Static::Commodore;
 
-std::vector<File> Analyser::Static::Commodore::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape) {
+std::vector<File> Analyser::Static::Commodore::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files) {
 	Storage::Tape::Commodore::Parser parser;
 	std::vector<File> file_list;
 
 	std::unique_ptr<Storage::Tape::Commodore::Header> header = parser.get_next_header(tape);
 
-	while(!tape->is_at_end()) {
+	while(!tape->is_at_end() && file_list.size() < maximum_files) {
 		if(!header) {
 			header = parser.get_next_header(tape);
 			continue;
@@ -12,11 +12,14 @@
 #include "../../../Storage/Tape/Tape.hpp"
 #include "File.hpp"
 
+#include <cstdint>
+
 namespace Analyser {
 namespace Static {
 namespace Commodore {
 
-std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape);
+/// @returns Files found on @c tape, stopping once @c maximum_files have been found.
+std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files = SIZE_MAX);
 
 }
 }
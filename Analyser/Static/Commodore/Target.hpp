@@ -66,6 +66,7 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			DeclareField(enabled_ram.bank5);
 			DeclareField(region);
 			DeclareField(has_c1540);
+			DeclareField(loading_command);
 			AnnounceEnum(Region);
 		}
 	}
@@ -9,6 +9,8 @@
 #ifndef StaticAnalyser_Disassembler_6502_hpp
 #define StaticAnalyser_Disassembler_6502_hpp
 
+#include "AddressSet.hpp"
+
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -74,15 +76,15 @@ struct Instruction {
 /*! Represents the disassembled form of a program. */
 struct Disassembly {
 	/*! All instructions found, mapped by address. */
-	std::map<uint16_t, Instruction> instructions_by_address;
+	Disassembler::AddressMap<Instruction> instructions_by_address;
 	/*! The set of all calls or jumps that land outside of the area covered by the data provided for disassembly. */
-	std::set<uint16_t> outward_calls;
+	Disassembler::AddressSet outward_calls;
 	/*! The set of all calls or jumps that land inside of the area covered by the data provided for disassembly. */
-	std::set<uint16_t> internal_calls;
+	Disassembler::AddressSet internal_calls;
 	/*! The sets of all stores, loads and modifies that occur to data outside of the area covered by the data provided for disassembly. */
-	std::set<uint16_t> external_stores, external_loads, external_modifies;
+	Disassembler::AddressSet external_stores, external_loads, external_modifies;
 	/*! The sets of all stores, loads and modifies that occur to data inside of the area covered by the data provided for disassembly. */
-	std::set<uint16_t> internal_stores, internal_loads, internal_modifies;
+	Disassembler::AddressSet internal_stores, internal_loads, internal_modifies;
 };
 
 /*!
@@ -0,0 +1,249 @@
+//
+//  AddressSet.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef AddressSet_hpp
+#define AddressSet_hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Analyser {
+namespace Static {
+namespace Disassembler {
+
+/*!
+	A set of 16-bit addresses, stored as a bitmap. It offers the subset of std::set's interface
+	that disassembly uses, and iterates in ascending order.
+*/
+class AddressSet {
+	public:
+		class const_iterator {
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = uint16_t;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const uint16_t *;
+				using reference = uint16_t;
+
+				uint16_t operator *() const {
+					return uint16_t(address_);
+				}
+
+				const_iterator &operator ++() {
+					address_ = set_->next(address_ + 1);
+					return *this;
+				}
+
+				const_iterator operator ++(int) {
+					const auto result = *this;
+					++*this;
+					return result;
+				}
+
+				bool operator ==(const const_iterator &rhs) const {
+					return address_ == rhs.address_;
+				}
+
+				bool operator !=(const const_iterator &rhs) const {
+					return address_ != rhs.address_;
+				}
+
+			private:
+				friend AddressSet;
+				const_iterator(const AddressSet *set, size_t address) : set_(set), address_(address) {}
+
+				const AddressSet *set_;
+				size_t address_;
+		};
+		using iterator = const_iterator;
+
+		void insert(uint16_t address) {
+			uint64_t &word = words_[address >> 6];
+			const uint64_t bit = uint64_t(1) << (address & 63);
+			size_ += !(word & bit);
+			word |= bit;
+		}
+
+		bool contains(uint16_t address) const {
+			return words_[address >> 6] & (uint64_t(1) << (address & 63));
+		}
+
+		size_t count(uint16_t address) const {
+			return contains(address) ? 1 : 0;
+		}
+
+		const_iterator find(uint16_t address) const {
+			return contains(address) ? const_iterator(this, address) : end();
+		}
+
+		const_iterator begin() const {
+			return const_iterator(this, next(0));
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, 65536);
+		}
+
+		size_t size() const {
+			return size_;
+		}
+
+		bool empty() const {
+			return !size_;
+		}
+
+	private:
+		std::array<uint64_t, 1024> words_{};
+		size_t size_ = 0;
+
+		/// @returns The lowest address at or above @c address that is in this set, or 65536 if there is none.
+		size_t next(size_t address) const {
+			while(address < 65536) {
+				const uint64_t word = words_[address >> 6] >> (address & 63);
+				if(word) {
+					// Find the lowest set bit.
+					uint64_t mask = 1;
+					while(!(word & mask)) {
+						mask <<= 1;
+						++address;
+					}
+					return address;
+				}
+				address = (address + 64) & ~size_t(63);
+			}
+			return 65536;
+		}
+};
+
+/*!
+	A map from 16-bit addresses to instances of @c ValueT, stored as a vector of values in order of insertion plus
+	a flat index from address to position in that vector, and an @c AddressSet to indicate which entries of the index
+	are valid. It offers the subset of std::map's interface that disassembly uses; iteration is in ascending order of
+	address and yields pairs of address and value.
+*/
+template <typename ValueT> class AddressMap {
+	public:
+		class const_iterator {
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = std::pair<uint16_t, const ValueT &>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = value_type;
+
+				value_type operator *() const {
+					return value_type(*address_, map_->values_[map_->index_[*address_]]);
+				}
+
+				const_iterator &operator ++() {
+					++address_;
+					return *this;
+				}
+
+				const_iterator operator ++(int) {
+					const auto result = *this;
+					++*this;
+					return result;
+				}
+
+				bool operator ==(const const_iterator &rhs) const {
+					return address_ == rhs.address_;
+				}
+
+				bool operator !=(const const_iterator &rhs) const {
+					return address_ != rhs.address_;
+				}
+
+			private:
+				friend AddressMap;
+				const_iterator(const AddressMap *map, AddressSet::const_iterator address) : map_(map), address_(address) {}
+
+				const AddressMap *map_;
+				AddressSet::const_iterator address_;
+		};
+		using iterator = const_iterator;
+
+		AddressMap() = default;
+		AddressMap(AddressMap &&) = default;
+		AddressMap &operator =(AddressMap &&) = default;
+
+		AddressMap(const AddressMap &rhs) {
+			*this = rhs;
+		}
+
+		AddressMap &operator =(const AddressMap &rhs) {
+			if(this == &rhs) return *this;
+			addresses_ = rhs.addresses_;
+			values_ = rhs.values_;
+			index_.reset();
+			if(rhs.index_) {
+				allocate_index();
+				for(const auto address: addresses_) {
+					index_[address] = rhs.index_[address];
+				}
+			}
+			return *this;
+		}
+
+		/// @returns A reference to the value at @c address, creating it with a default value if it is not yet present.
+		ValueT &operator[](uint16_t address) {
+			if(!addresses_.contains(address)) {
+				if(!index_) allocate_index();
+				addresses_.insert(address);
+				index_[address] = uint16_t(values_.size());
+				values_.emplace_back();
+			}
+			return values_[index_[address]];
+		}
+
+		size_t count(uint16_t address) const {
+			return addresses_.count(address);
+		}
+
+		const_iterator find(uint16_t address) const {
+			return const_iterator(this, addresses_.find(address));
+		}
+
+		const_iterator begin() const {
+			return const_iterator(this, addresses_.begin());
+		}
+
+		const_iterator end() const {
+			return const_iterator(this, addresses_.end());
+		}
+
+		size_t size() const {
+			return addresses_.size();
+		}
+
+		bool empty() const {
+			return addresses_.empty();
+		}
+
+	private:
+		AddressSet addresses_;
+		std::vector<ValueT> values_;
+
+		// Entries in the index are valid only for addresses in addresses_, so the
+		// index is deliberately left uninitialised.
+		std::unique_ptr<uint16_t[]> index_;
+		void allocate_index() {
+			index_.reset(new uint16_t[65536]);
+		}
+};
+
+}
+}
+}
+
+#endif /* AddressSet_hpp */
@@ -31,8 +31,7 @@ template <typename D, typename S, typename Disassembler> D Disassemble(
 		partial_disassembly.remaining_entry_points.pop_back();
 
 		// if that address has already been visited, forget about it
-		if(	partial_disassembly.disassembly.instructions_by_address.find(next_entry_point)
-			!= partial_disassembly.disassembly.instructions_by_address.end()) continue;
+		if(partial_disassembly.disassembly.instructions_by_address.count(next_entry_point)) continue;
 
 		// if it's outgoing, log it as such and forget about it; otherwise disassemble
 		std::size_t mapped_entry_point = address_mapper(next_entry_point);
@@ -42,7 +41,7 @@ template <typename D, typename S, typename Disassembler> D Disassemble(
 			Disassembler::AddToDisassembly(partial_disassembly, memory, address_mapper, next_entry_point);
 	}
 
-	return partial_disassembly.disassembly;
+	return std::move(partial_disassembly.disassembly);
 }
 
 }
@@ -9,6 +9,8 @@
 #ifndef StaticAnalyser_Disassembler_Z80_hpp
 #define StaticAnalyser_Disassembler_Z80_hpp
 
+#include "AddressSet.hpp"
+
 #include <cstdint>
 #include <functional>
 #include <map>
@@ -71,11 +73,11 @@ struct Instruction {
 };
 
 struct Disassembly {
-	std::map<uint16_t, Instruction> instructions_by_address;
-	std::set<uint16_t> outward_calls;
-	std::set<uint16_t> internal_calls;
-	std::set<uint16_t> external_stores, external_loads, external_modifies;
-	std::set<uint16_t> internal_stores, internal_loads, internal_modifies;
+	Disassembler::AddressMap<Instruction> instructions_by_address;
+	Disassembler::AddressSet outward_calls;
+	Disassembler::AddressSet internal_calls;
+	Disassembler::AddressSet external_stores, external_loads, external_modifies;
+	Disassembler::AddressSet internal_stores, internal_loads, internal_modifies;
 };
 
 Disassembly Disassemble(
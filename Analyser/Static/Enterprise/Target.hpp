@@ -46,6 +46,7 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			DeclareField(basic_version);
 			DeclareField(dos);
 			DeclareField(speed);
+			DeclareField(loading_command);
 		}
 	}
 };
@@ -119,7 +119,7 @@ static Analyser::Static::TargetList CartridgeTargetsFrom(
 //		// Look for a indirect store followed by an unconditional JP or CALL into another
 //		// segment, that's a fairly explicit sign where found.
 		using Instruction = Analyser::Static::Z80::Instruction;
-		std::map<uint16_t, Instruction> &instructions = disassembly.instructions_by_address;
+		auto &instructions = disassembly.instructions_by_address;
 		bool is_ascii = false;
 //		auto iterator = instructions.begin();
 //		while(iterator != instructions.end()) {
@@ -272,7 +272,7 @@ Analyser::Static::TargetList Analyser::Static::MSX::GetTargets(const Media &medi
 
 	// Check tapes for loadable files.
 	for(auto &tape : media.tapes) {
-		std::vector<File> files_on_tape = GetFiles(tape);
+		std::vector<File> files_on_tape = GetFiles(AnalysisPrefix(tape), 1);
 		if(!files_on_tape.empty()) {
 			switch(files_on_tape.front().type) {
 				case File::Type::ASCII:				target->loading_command = "RUN\"CAS:\r";		break;
@@ -24,7 +24,7 @@ File::File() :
 	starting_address(0),
 	entry_address(0) {}	// For the sake of initialising in a defined state.
 
-std::vector<File> Analyser::Static::MSX::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape) {
+std::vector<File> Analyser::Static::MSX::GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files) {
 	std::vector<File> files;
 
 	Storage::Tape::BinaryTapePlayer tape_player(1000000);
@@ -33,8 +33,8 @@ std::vector<File> Analyser::Static::MSX::GetFiles(const std::shared_ptr<Storage:
 
 	using Parser = Storage::Tape::MSX::Parser;
 
-	// Get all recognisable files from the tape.
-	while(!tape->is_at_end()) {
+	// Get recognisable files from the tape, up to the limit.
+	while(!tape->is_at_end() && files.size() < maximum_files) {
 		// Try to locate and measure a header.
 		std::unique_ptr<Parser::FileSpeed> file_speed = Parser::find_header(tape_player);
 		if(!file_speed) continue;
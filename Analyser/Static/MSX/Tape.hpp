@@ -11,6 +11,7 @@
 
 #include "../../../Storage/Tape/Tape.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -35,7 +36,8 @@ struct File {
 	File();
 };
 
-std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape);
+/// @returns Files found on @c tape, stopping once @c maximum_files have been found.
+std::vector<File> GetFiles(const std::shared_ptr<Storage::Tape::Tape> &tape, std::size_t maximum_files = SIZE_MAX);
 
 }
 }
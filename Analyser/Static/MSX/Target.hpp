@@ -38,6 +38,7 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 	Target(): Analyser::Static::Target(Machine::MSX) {
 		if(needs_declare()) {
 			DeclareField(has_disk_drive);
+			DeclareField(loading_command);
 			DeclareField(region);
 			AnnounceEnum(Region);
 			DeclareField(model);
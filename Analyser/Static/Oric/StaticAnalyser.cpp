@@ -153,7 +153,7 @@ Analyser::Static::TargetList Analyser::Static::Oric::GetTargets(const Media &med
 	int basic11_votes = 0;
 
 	for(auto &tape : media.tapes) {
-		std::vector<File> tape_files = GetFiles(tape);
+		std::vector<File> tape_files = GetFiles(AnalysisPrefix(tape));
 		tape->reset();
 		if(!tape_files.empty()) {
 			for(const auto &file : tape_files) {
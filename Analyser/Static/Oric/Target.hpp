@@ -49,6 +49,8 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 			DeclareField(rom);
 			DeclareField(disk_interface);
 			DeclareField(processor);
+			DeclareField(loading_command);
+			DeclareField(should_start_jasmin);
 			AnnounceEnum(ROM);
 			AnnounceEnum(DiskInterface);
 			AnnounceEnum(Processor);
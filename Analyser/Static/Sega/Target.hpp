@@ -18,11 +18,11 @@ namespace Static {
 namespace Sega {
 
 struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Target> {
-	enum class Model {
+	ReflectableEnum(Model,
 		SG1000,
 		MasterSystem,
-		MasterSystem2,
-	};
+		MasterSystem2
+	);
 
 	ReflectableEnum(Region,
 		Japan,
@@ -31,10 +31,10 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 		Brazil
 	);
 
-	enum class PagingScheme {
+	ReflectableEnum(PagingScheme,
 		Sega,
 		Codemasters
-	};
+	);
 
 	Model model = Model::MasterSystem;
 	Region region = Region::Japan;
@@ -42,8 +42,12 @@ struct Target: public Analyser::Static::Target, public Reflection::StructImpl<Ta
 
 	Target() : Analyser::Static::Target(Machine::MasterSystem) {
 		if(needs_declare()) {
+			DeclareField(model);
 			DeclareField(region);
+			DeclareField(paging_scheme);
+			AnnounceEnum(Model);
 			AnnounceEnum(Region);
+			AnnounceEnum(PagingScheme);
 		}
 	}
 };
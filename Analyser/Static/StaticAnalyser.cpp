@@ -7,11 +7,15 @@
 //
 
 #include "StaticAnalyser.hpp"
+#include "TargetCache.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <optional>
+#include <thread>
 
 // Analysers
 #include "Acorn/StaticAnalyser.hpp"
@@ -55,12 +59,15 @@
 #include "../../Storage/Disk/DiskImage/Formats/SSD.hpp"
 #include "../../Storage/Disk/DiskImage/Formats/STX.hpp"
 #include "../../Storage/Disk/DiskImage/Formats/WOZ.hpp"
+#include "../../Storage/Disk/Overlay.hpp"
 
 // Mass Storage Devices (i.e. usually, hard disks)
 #include "../../Storage/MassStorage/Formats/DAT.hpp"
 #include "../../Storage/MassStorage/Formats/DSK.hpp"
+#include "../../Storage/MassStorage/Formats/HD.hpp"
 #include "../../Storage/MassStorage/Formats/HDV.hpp"
 #include "../../Storage/MassStorage/Formats/HFV.hpp"
+#include "../../Storage/MassStorage/Overlay.hpp"
 
 // State Snapshots
 #include "../../Storage/State/SNA.hpp"
@@ -77,6 +84,10 @@
 #include "../../Storage/Tape/Formats/TZX.hpp"
 #include "../../Storage/Tape/Formats/ZX80O81P.hpp"
 #include "../../Storage/Tape/Formats/ZXSpectrumTAP.hpp"
+#include "../../Storage/Tape/TapePrefix.hpp"
+
+// Archives
+#include "../../Storage/Container.hpp"
 
 // Target Platform Types
 #include "../../Storage/TargetPlatforms.hpp"
@@ -101,6 +112,19 @@ std::string get_extension(const std::string &name) {
 
 static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::IntType &potential_platforms) {
 	Media result;
+
+	// Archives: decompress all files within concurrently, then collect the media from each.
+	if(Storage::Container::is_container(file_name)) {
+		const auto members = Storage::Container::members(file_name);
+		Storage::Container::prefetch(members);
+		for(const auto &member: members) {
+			TargetPlatform::IntType member_platforms = 0;
+			result += GetMediaAndPlatforms(member, member_platforms);
+			potential_platforms |= member_platforms;
+		}
+		return result;
+	}
+
 	const std::string extension = get_extension(file_name);
 
 #define InsertInstance(list, instance, platforms) \
@@ -171,6 +195,7 @@ static Media GetMediaAndPlatforms(const std::string &file_name, TargetPlatform::
 	Format("dsk", result.disks, Disk::DiskImageHolder<Storage::Disk::FAT12>, TargetPlatform::MSX)				// DSK (MSX)
 	Format("dsk", result.disks, Disk::DiskImageHolder<Storage::Disk::OricMFMDSK>, TargetPlatform::Oric)			// DSK (Oric)
 	Format("g64", result.disks, Disk::DiskImageHolder<Storage::Disk::G64>, TargetPlatform::Commodore)			// G64
+	Format("hd", result.mass_storage_devices, MassStorage::HD, TargetPlatform::AtariST)							// HD (Atari ST, hard disk)
 	Format("hdv", result.mass_storage_devices, MassStorage::HDV, TargetPlatform::AppleII)						// HDV (Apple II, hard disk, single volume image)
 	Format(	"hfe",
 			result.disks,
@@ -239,7 +264,147 @@ Media Analyser::Static::GetMedia(const std::string &file_name) {
 	return GetMediaAndPlatforms(file_name, throwaway);
 }
 
-TargetList Analyser::Static::GetTargets(const std::string &file_name) {
+std::shared_ptr<Storage::Tape::Tape> Analyser::Static::AnalysisPrefix(const std::shared_ptr<Storage::Tape::Tape> &tape) {
+	return std::make_shared<Storage::Tape::TapePrefix>(tape, Storage::Time(TapeAnalysisSeconds));
+}
+
+Media Analyser::Static::CopyOnWrite(const Media &media) {
+	Media result = media;
+
+	for(auto &disk: result.disks) {
+		if(const auto overlay = std::dynamic_pointer_cast<Storage::Disk::Overlay>(disk)) {
+			disk = overlay->sibling();
+		} else {
+			disk = std::make_shared<Storage::Disk::Overlay>(disk);
+		}
+	}
+
+	for(auto &device: result.mass_storage_devices) {
+		if(const auto overlay = std::dynamic_pointer_cast<Storage::MassStorage::Overlay>(device)) {
+			device = overlay->sibling();
+		} else {
+			device = std::make_shared<Storage::MassStorage::Overlay>(device);
+		}
+	}
+
+	return result;
+}
+
+Media Analyser::Static::Fork(const Media &media) {
+	Media result = media;
+	result.tapes.clear();
+
+	for(auto &disk: result.disks) {
+		if(const auto overlay = std::dynamic_pointer_cast<Storage::Disk::Overlay>(disk)) {
+			disk = overlay->fork();
+		} else {
+			disk = std::make_shared<Storage::Disk::Overlay>(disk);
+		}
+	}
+
+	for(auto &device: result.mass_storage_devices) {
+		if(const auto overlay = std::dynamic_pointer_cast<Storage::MassStorage::Overlay>(device)) {
+			device = overlay->fork();
+		} else {
+			device = std::make_shared<Storage::MassStorage::Overlay>(device);
+		}
+	}
+
+	return result;
+}
+
+namespace {
+
+/// Replaces each member of @c list that is also in @c from with the corresponding member of @c to.
+template <typename ListT> void substitute(ListT &list, const ListT &from, const ListT &to) {
+	if(from.size() != to.size()) return;
+	for(auto &item: list) {
+		const auto match = std::find(from.begin(), from.end(), item);
+		if(match != from.end()) {
+			item = to[size_t(match - from.begin())];
+		}
+	}
+}
+
+/*!
+	Runs each of @c analysers on a pool of threads, including the calling thread, and maps whatever media the
+	results refer to back to the equivalent parts of @c media.
+
+	Disks and mass storage devices are shared between analysers via copy-on-write overlays, and cartridges are
+	shared directly. Tapes have a read position, so can't be shared; each analyser instead receives tapes freshly
+	obtained from @c file_name.
+
+	Results are collected in the order that @c analysers are supplied, regardless of completion order.
+	If a @c time_limit is given then analysers not yet started when it expires are skipped, and contribute
+	no targets; those already running are allowed to finish. @c is_complete is set to indicate whether
+	every analyser ran.
+*/
+template <typename AnalyserT> TargetList GetTargetsInParallel(
+	const std::vector<AnalyserT> &analysers,
+	const Media &media,
+	const std::string &file_name,
+	TargetPlatform::IntType potential_platforms,
+	std::optional<std::chrono::milliseconds> time_limit,
+	bool &is_complete
+) {
+	const Media shared_media = CopyOnWrite(media);
+	std::vector<std::optional<std::pair<TargetList, Media>>> results(analysers.size());
+	std::atomic<size_t> next_analyser = 0;
+	std::atomic<bool> did_skip = false;
+
+	const auto start = std::chrono::steady_clock::now();
+	const auto work = [&] {
+		while(true) {
+			const size_t index = next_analyser++;
+			if(index >= analysers.size()) return;
+			if(time_limit && std::chrono::steady_clock::now() - start >= *time_limit) {
+				did_skip = true;
+				return;
+			}
+
+			try {
+				Media own_media = CopyOnWrite(shared_media);
+				if(!media.tapes.empty()) {
+					own_media.tapes = GetMedia(file_name).tapes;
+				}
+				TargetList targets = analysers[index](own_media, file_name, potential_platforms);
+				results[index].emplace(std::move(targets), std::move(own_media));
+			} catch(...) {}
+		}
+	};
+
+	const size_t worker_count =
+		std::min(analysers.size(), size_t(std::max(2u, std::thread::hardware_concurrency())));
+	std::vector<std::thread> workers;
+	for(size_t c = 1; c < worker_count; ++c) {
+		workers.emplace_back(work);
+	}
+	work();
+	for(auto &worker: workers) {
+		worker.join();
+	}
+	is_complete = !did_skip;
+
+	// Gather.
+	TargetList targets;
+	for(auto &result: results) {
+		if(!result) continue;
+
+		const Media &own_media = result->second;
+		for(auto &target: result->first) {
+			substitute(target->media.disks, own_media.disks, media.disks);
+			substitute(target->media.tapes, own_media.tapes, media.tapes);
+			substitute(target->media.cartridges, own_media.cartridges, media.cartridges);
+			substitute(target->media.mass_storage_devices, own_media.mass_storage_devices, media.mass_storage_devices);
+			targets.push_back(std::move(target));
+		}
+	}
+	return targets;
+}
+
+}
+
+TargetList Analyser::Static::GetTargets(const std::string &file_name, std::optional<std::chrono::milliseconds> time_limit) {
 	TargetList targets;
 	const std::string extension = get_extension(file_name);
 
@@ -268,12 +433,17 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	TargetPlatform::IntType potential_platforms = 0;
 	Media media = GetMediaAndPlatforms(file_name, potential_platforms);
 
+	// Use a previous analysis if there is one.
+	const TargetCache cache(file_name);
+	if(auto cached = cache.targets(media)) {
+		return std::move(*cached);
+	}
+
 	// Hand off to platform-specific determination of whether these
 	// things are actually compatible and, if so, how to load them.
-#define Append(x) if(potential_platforms & TargetPlatform::x) {\
-	auto new_targets = x::GetTargets(media, file_name, potential_platforms);\
-	std::move(new_targets.begin(), new_targets.end(), std::back_inserter(targets));\
-}
+	using AnalyserFunction = TargetList (*)(const Media &, const std::string &, TargetPlatform::IntType);
+	std::vector<AnalyserFunction> analysers;
+#define Append(x) if(potential_platforms & TargetPlatform::x) analysers.push_back(&x::GetTargets);
 	Append(Acorn);
 	Append(AmstradCPC);
 	Append(AppleII);
@@ -293,6 +463,13 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 	Append(ZXSpectrum);
 #undef Append
 
+	bool is_complete = true;
+	if(analysers.size() == 1) {
+		targets = analysers.front()(media, file_name, potential_platforms);
+	} else if(!analysers.empty()) {
+		targets = GetTargetsInParallel(analysers, media, file_name, potential_platforms, time_limit, is_complete);
+	}
+
 	// Reset any tapes to their initial position.
 	for(const auto &target : targets) {
 		for(auto &tape : target->media.tapes) {
@@ -307,5 +484,10 @@ TargetList Analyser::Static::GetTargets(const std::string &file_name) {
 			return a->confidence > b->confidence;
 		});
 
+	// Retain this analysis only if it wasn't curtailed.
+	if(is_complete) {
+		cache.store(media, targets);
+	}
+
 	return targets;
 }
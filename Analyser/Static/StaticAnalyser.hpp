@@ -17,7 +17,9 @@
 #include "../../Storage/Tape/Tape.hpp"
 #include "../../Reflection/Struct.hpp"
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -70,15 +72,47 @@ typedef std::vector<std::unique_ptr<Target>> TargetList;
 /*!
 	Attempts, through any available means, to return a list of potential targets for the file with the given name.
 
+	If the file might suit several platforms then their analysers run concurrently. If a @c time_limit is
+	supplied then any analysers not yet started once it has expired are skipped, and contribute no targets.
+
 	@returns The list of potential targets, sorted from most to least probable.
 */
-TargetList GetTargets(const std::string &file_name);
+TargetList GetTargets(const std::string &file_name, std::optional<std::chrono::milliseconds> time_limit = std::nullopt);
+
+/*!
+	Tape analysers search for files only within this many seconds of a tape's running time, so that
+	launching from a multi-hour capture doesn't require all of it to be decoded first.
+*/
+constexpr unsigned int TapeAnalysisSeconds = 30 * 60;
+
+/*!
+	@returns The portion of @c tape, from its current position, that a tape analyser should search;
+	see @c TapeAnalysisSeconds.
+*/
+std::shared_ptr<Storage::Tape::Tape> AnalysisPrefix(const std::shared_ptr<Storage::Tape::Tape> &tape);
 
 /*!
 	Inspects the supplied file and determines the media included.
 */
 Media GetMedia(const std::string &file_name);
 
+/*!
+	@returns A copy of @c media in which every disk and mass storage device is a copy-on-write overlay,
+	so that nothing written will reach the underlying images. Tapes and cartridges are shared as-is.
+
+	Any disk or device in @c media that is already an overlay will yield a sibling with the same base.
+	So to run several machines from one set of images, apply this to the original media once and then
+	to that result once for each machine.
+*/
+Media CopyOnWrite(const Media &media);
+
+/*!
+	@returns A copy of @c media suitable for a duplicate of a machine that is using it: as per @c CopyOnWrite
+	except that disks and devices that are already overlays yield forks, retaining all changes made so far.
+	Tapes are omitted, since a tape's position can't be shared.
+*/
+Media Fork(const Media &media);
+
 }
 }
 
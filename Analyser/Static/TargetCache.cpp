@@ -0,0 +1,273 @@
+//
+//  TargetCache.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "TargetCache.hpp"
+
+#include "Acorn/Target.hpp"
+#include "Amiga/Target.hpp"
+#include "AmstradCPC/Target.hpp"
+#include "AppleII/Target.hpp"
+#include "AppleIIgs/Target.hpp"
+#include "Atari2600/Target.hpp"
+#include "AtariST/Target.hpp"
+#include "Commodore/Target.hpp"
+#include "Enterprise/Target.hpp"
+#include "Macintosh/Target.hpp"
+#include "MSX/Target.hpp"
+#include "Oric/Target.hpp"
+#include "Sega/Target.hpp"
+#include "ZX8081/Target.hpp"
+#include "ZXSpectrum/Target.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <typeinfo>
+
+using namespace Analyser::Static;
+
+/*
+	Cache files are laid out as follows, with all fields being little endian:
+
+		8 bytes:	"CLKTGTS1"
+		4 bytes:	number of targets
+
+		per target:
+			4 bytes:	machine
+			4 bytes:	confidence, as an IEEE 754 single-precision float
+
+			for each of disks, tapes, cartridges and mass storage devices:
+				4 bytes:	number of items
+				per item, 4 bytes:	index into the media obtained by opening the file
+
+			4 bytes:	length of the BSON serialisation of the target's fields, which may be 0
+			the BSON serialisation
+*/
+
+namespace {
+
+constexpr char Signature[] = "CLKTGTS1";
+constexpr size_t SignatureLength = sizeof(Signature) - 1;
+
+void put32(std::vector<uint8_t> &destination, uint32_t value) {
+	destination.push_back(uint8_t(value));
+	destination.push_back(uint8_t(value >> 8));
+	destination.push_back(uint8_t(value >> 16));
+	destination.push_back(uint8_t(value >> 24));
+}
+
+/// Reads sequential fields from a cache file, noting any attempt to read beyond its end.
+struct Reader {
+	const std::vector<uint8_t> &data;
+	size_t offset = 0;
+	bool overran = false;
+
+	uint32_t get32() {
+		if(data.size() - offset < 4) {
+			overran = true;
+			return 0;
+		}
+		const uint8_t *const source = &data[offset];
+		offset += 4;
+		return uint32_t(source[0]) | (uint32_t(source[1]) << 8) | (uint32_t(source[2]) << 16) | (uint32_t(source[3]) << 24);
+	}
+
+	/// @returns A pointer to the next @c length bytes, which are then skipped, or @c nullptr if there are insufficient.
+	const uint8_t *get(size_t length) {
+		if(data.size() - offset < length) {
+			overran = true;
+			return nullptr;
+		}
+		offset += length;
+		return data.data() + offset - length;
+	}
+};
+
+/// Appends the indices within @c all of each member of @c list to @c destination.
+/// @returns @c false if any member of @c list isn't in @c all.
+template <typename ListT> bool put_indices(std::vector<uint8_t> &destination, const ListT &list, const ListT &all) {
+	put32(destination, uint32_t(list.size()));
+	for(const auto &item: list) {
+		const auto match = std::find(all.begin(), all.end(), item);
+		if(match == all.end()) return false;
+		put32(destination, uint32_t(match - all.begin()));
+	}
+	return true;
+}
+
+/// Reads indices as written by @c put_indices, populating @c list from @c all.
+/// @returns @c false if any index is out of range.
+template <typename ListT> bool get_indices(Reader &reader, ListT &list, const ListT &all) {
+	const uint32_t count = reader.get32();
+	for(uint32_t c = 0; c < count && !reader.overran; ++c) {
+		const uint32_t index = reader.get32();
+		if(index >= all.size()) return false;
+		list.push_back(all[index]);
+	}
+	return !reader.overran;
+}
+
+/// @returns A default target for @c machine.
+std::unique_ptr<Target> target_for(Analyser::Machine machine) {
+	switch(machine) {
+		case Analyser::Machine::AmstradCPC:		return std::make_unique<AmstradCPC::Target>();
+		case Analyser::Machine::AppleII:		return std::make_unique<AppleII::Target>();
+		case Analyser::Machine::AppleIIgs:		return std::make_unique<AppleIIgs::Target>();
+		case Analyser::Machine::Atari2600:		return std::make_unique<Atari2600::Target>();
+		case Analyser::Machine::AtariST:		return std::make_unique<AtariST::Target>();
+		case Analyser::Machine::Amiga:			return std::make_unique<Amiga::Target>();
+		case Analyser::Machine::ColecoVision:	return std::make_unique<Target>(Analyser::Machine::ColecoVision);
+		case Analyser::Machine::Electron:		return std::make_unique<Acorn::Target>();
+		case Analyser::Machine::Enterprise:		return std::make_unique<Enterprise::Target>();
+		case Analyser::Machine::Macintosh:		return std::make_unique<Macintosh::Target>();
+		case Analyser::Machine::MasterSystem:	return std::make_unique<Sega::Target>();
+		case Analyser::Machine::MSX:			return std::make_unique<MSX::Target>();
+		case Analyser::Machine::Oric:			return std::make_unique<Oric::Target>();
+		case Analyser::Machine::Vic20:			return std::make_unique<Commodore::Target>();
+		case Analyser::Machine::ZX8081:			return std::make_unique<ZX8081::Target>();
+		case Analyser::Machine::ZXSpectrum:		return std::make_unique<ZXSpectrum::Target>();
+	}
+	return nullptr;
+}
+
+/// @returns A 64-bit FNV-1a hash of @c name and the contents of the file it names, or 0 if it can't be read.
+uint64_t file_hash(const std::string &file_name, const std::string &name) {
+	FILE *const file = fopen(file_name.c_str(), "rb");
+	if(!file) return 0;
+
+	uint64_t hash = 14695981039346656037ull;
+	for(const char c: name) {
+		hash = (hash ^ uint8_t(c)) * 1099511628211ull;
+	}
+
+	uint8_t buffer[65536];
+	size_t length;
+	while((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		for(size_t c = 0; c < length; ++c) {
+			hash = (hash ^ buffer[c]) * 1099511628211ull;
+		}
+	}
+	fclose(file);
+	return hash;
+}
+
+}
+
+std::string TargetCache::cache_directory_;
+
+void TargetCache::set_cache_directory(const std::string &directory) {
+	cache_directory_ = directory;
+}
+
+TargetCache::TargetCache(const std::string &file_name) {
+	if(cache_directory_.empty()) return;
+
+	// Analysers may make decisions based on the file's name, so that's part of the key.
+	const auto final_separator = file_name.find_last_of("/\\");
+	const std::string name = final_separator == std::string::npos ? file_name : file_name.substr(final_separator + 1);
+
+	const uint64_t hash = file_hash(file_name, name);
+	if(!hash) return;
+
+	char cache_name[32];
+	snprintf(cache_name, sizeof(cache_name), "%016llx.targets", static_cast<unsigned long long>(hash));
+	cache_file_name_ = cache_directory_ + "/" + cache_name;
+}
+
+std::optional<TargetList> TargetCache::targets(const Media &media) const {
+	if(cache_file_name_.empty()) return std::nullopt;
+
+	FILE *const file = fopen(cache_file_name_.c_str(), "rb");
+	if(!file) return std::nullopt;
+
+	std::vector<uint8_t> data;
+	uint8_t buffer[4096];
+	size_t length;
+	while((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		data.insert(data.end(), buffer, buffer + length);
+	}
+	fclose(file);
+
+	if(data.size() < SignatureLength || memcmp(data.data(), Signature, SignatureLength)) return std::nullopt;
+
+	Reader reader{data, SignatureLength};
+	TargetList targets;
+	const uint32_t count = reader.get32();
+	for(uint32_t c = 0; c < count && !reader.overran; ++c) {
+		auto target = target_for(Analyser::Machine(reader.get32()));
+		if(!target) return std::nullopt;
+
+		const uint32_t confidence = reader.get32();
+		memcpy(&target->confidence, &confidence, sizeof(confidence));
+
+		if(
+			!get_indices(reader, target->media.disks, media.disks) ||
+			!get_indices(reader, target->media.tapes, media.tapes) ||
+			!get_indices(reader, target->media.cartridges, media.cartridges) ||
+			!get_indices(reader, target->media.mass_storage_devices, media.mass_storage_devices)
+		) {
+			return std::nullopt;
+		}
+
+		const uint32_t bson_size = reader.get32();
+		const uint8_t *const bson = reader.get(bson_size);
+		if(bson && bson_size) {
+			const auto reflectable = dynamic_cast<Reflection::Struct *>(target.get());
+			if(!reflectable || !reflectable->deserialise(bson, bson_size)) return std::nullopt;
+		}
+
+		targets.push_back(std::move(target));
+	}
+	if(reader.overran) return std::nullopt;
+
+	return targets;
+}
+
+void TargetCache::store(const Media &media, const TargetList &targets) const {
+	if(cache_file_name_.empty() || targets.empty()) return;
+
+	std::vector<uint8_t> file(Signature, Signature + SignatureLength);
+	put32(file, uint32_t(targets.size()));
+	for(const auto &target: targets) {
+		// Only targets that will be recreated exactly by target_for plus deserialisation can be stored.
+		const auto reflectable = dynamic_cast<const Reflection::Struct *>(target.get());
+		const auto prototype = target_for(target->machine);
+		if(!prototype || typeid(*prototype) != typeid(*target) || target->state) return;
+
+		put32(file, uint32_t(target->machine));
+
+		uint32_t confidence;
+		memcpy(&confidence, &target->confidence, sizeof(confidence));
+		put32(file, confidence);
+
+		if(
+			!put_indices(file, target->media.disks, media.disks) ||
+			!put_indices(file, target->media.tapes, media.tapes) ||
+			!put_indices(file, target->media.cartridges, media.cartridges) ||
+			!put_indices(file, target->media.mass_storage_devices, media.mass_storage_devices)
+		) {
+			return;
+		}
+
+		const auto bson = reflectable ? reflectable->serialise() : std::vector<uint8_t>();
+		put32(file, uint32_t(bson.size()));
+		file.insert(file.end(), bson.begin(), bson.end());
+	}
+
+	// Write to a temporary and then rename, so that a concurrent reader never sees a partial file.
+	const std::string temporary_name = cache_file_name_ + ".tmp";
+	FILE *const output = fopen(temporary_name.c_str(), "wb");
+	if(output) {
+		const bool did_write = fwrite(file.data(), 1, file.size(), output) == file.size();
+		fclose(output);
+
+		if(!did_write || rename(temporary_name.c_str(), cache_file_name_.c_str())) {
+			remove(temporary_name.c_str());
+		}
+	}
+}
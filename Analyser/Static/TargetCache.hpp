@@ -0,0 +1,53 @@
+//
+//  TargetCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef TargetCache_hpp
+#define TargetCache_hpp
+
+#include "StaticAnalyser.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Analyser {
+namespace Static {
+
+/*!
+	Retains the results of static analysis in a file keyed by a hash of the analysed file's name and
+	contents, so that a later analysis of the same file can skip the platform-specific analysers.
+
+	Targets are stored through their reflective fields, and the media they refer to are stored as
+	indices into the media obtained by opening the file, so a file can be cached only if its targets
+	are all reflectable and refer only to media obtained in that way.
+
+	The cache is inactive unless a host has nominated a directory via @c set_cache_directory.
+*/
+class TargetCache {
+	public:
+		/// Nominates the directory in which cache files should be stored; if empty, caching is disabled.
+		static void set_cache_directory(const std::string &directory);
+
+		/// Prepares to look up or store the analysis of @c file_name.
+		TargetCache(const std::string &file_name);
+
+		/// @returns The cached targets for this file, referring to the equivalent parts of @c media, if any.
+		std::optional<TargetList> targets(const Media &media) const;
+
+		/// Records @c targets as the analysis of this file, if they can be stored.
+		void store(const Media &media, const TargetList &targets) const;
+
+	private:
+		static std::string cache_directory_;
+		std::string cache_file_name_;
+};
+
+}
+}
+
+#endif /* TargetCache_hpp */
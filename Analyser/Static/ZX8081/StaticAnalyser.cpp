@@ -31,7 +31,7 @@ static std::vector<Storage::Data::ZX8081::File> GetFiles(const std::shared_ptr<S
 Analyser::Static::TargetList Analyser::Static::ZX8081::GetTargets(const Media &media, const std::string &, TargetPlatform::IntType potential_platforms) {
 	TargetList destination;
 	if(!media.tapes.empty()) {
-		std::vector<Storage::Data::ZX8081::File> files = GetFiles(media.tapes.front());
+		std::vector<Storage::Data::ZX8081::File> files = GetFiles(AnalysisPrefix(media.tapes.front()));
 		media.tapes.front()->reset();
 		if(!files.empty()) {
 			Target *const target = new Target;
@@ -35,6 +35,7 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 			DeclareField(memory_model);
 			DeclareField(is_ZX81);
 			DeclareField(ZX80_uses_ZX81_ROM);
+			DeclareField(loading_command);
 			AnnounceEnum(MemoryModel);
 		}
 	}
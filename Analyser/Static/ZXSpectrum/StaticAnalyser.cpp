@@ -64,7 +64,7 @@ Analyser::Static::TargetList Analyser::Static::ZXSpectrum::GetTargets(const Medi
 	if(!media.tapes.empty()) {
 		bool has_spectrum_tape = false;
 		for(auto &tape: media.tapes) {
-			has_spectrum_tape |= IsSpectrumTape(tape);
+			has_spectrum_tape |= IsSpectrumTape(AnalysisPrefix(tape));
 		}
 
 		if(has_spectrum_tape) {
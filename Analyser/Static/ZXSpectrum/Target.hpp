@@ -33,6 +33,7 @@ struct Target: public ::Analyser::Static::Target, public Reflection::StructImpl<
 	Target(): Analyser::Static::Target(Machine::ZXSpectrum) {
 		if(needs_declare()) {
 			DeclareField(model);
+			DeclareField(should_hold_enter);
 			AnnounceEnum(Model);
 		}
 	}
@@ -9,7 +9,14 @@
 #ifndef DeferredQueue_h
 #define DeferredQueue_h
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 /*!
@@ -85,14 +92,207 @@ template <typename TimeUnit> class DeferredQueue {
 		std::vector<DeferredAction> pending_actions_;
 };
 
+/*!
+	Provides the same interface as DeferredQueue but without heap allocation: actions are
+	stored in place in one of @c capacity slots, each of which can hold any callable no larger
+	than @c action_size, and are ordered by a binary heap of due times.
+
+	Advancing is O(1) if no action is due; deferral and performance are O(log capacity).
+	Actions that fall due at the same time are performed in the order in which they were deferred.
+
+	Up to @c capacity actions can be pending without allocation. Any more are held in a std::function-based
+	overflow list, preserving their timing and order at the cost of allocation; a user that overflows should
+	increase @c capacity.
+*/
+template <typename TimeUnit, size_t capacity = 16, size_t action_size = 32> class InlineDeferredQueue {
+	static_assert(capacity <= 256, "Slot indices are stored as bytes");
+
+	public:
+		/// Indicates whether a callable of type @c Func can be stored by this queue.
+		template <typename Func> static constexpr bool fits =
+			sizeof(std::decay_t<Func>) <= action_size &&
+			alignof(std::decay_t<Func>) <= alignof(std::max_align_t);
+
+		InlineDeferredQueue() {
+			for(size_t c = 0; c < capacity; c++) {
+				free_[c] = uint8_t(c);
+			}
+		}
+
+		~InlineDeferredQueue() {
+			// Destroy, without performing, anything that remains.
+			for(size_t c = 0; c < size_; c++) {
+				Slot &slot = slots_[heap_[c].slot];
+				slot.perform(slot.storage, false);
+			}
+		}
+
+		InlineDeferredQueue(const InlineDeferredQueue &) = delete;
+		InlineDeferredQueue &operator =(const InlineDeferredQueue &) = delete;
+
+		/*!
+			Schedules @c action to occur in @c delay units of time.
+		*/
+		template <typename Func> void defer(TimeUnit delay, Func &&action) {
+			static_assert(fits<Func>);
+			using Stored = std::decay_t<Func>;
+
+			// Apply immediately if there's no delay (or a negative delay).
+			if(delay <= TimeUnit(0)) {
+				action();
+				return;
+			}
+
+			// Resort to the overflow list if there's no space.
+			if(!free_count_) {
+				overflow_.push_back(Overflow{now_ + delay, sequence_++, std::forward<Func>(action)});
+				return;
+			}
+
+			const uint8_t slot_index = free_[--free_count_];
+			Slot &slot = slots_[slot_index];
+			new (slot.storage) Stored(std::forward<Func>(action));
+			slot.perform = [] (void *storage, bool invoke) {
+				Stored *const stored = std::launder(reinterpret_cast<Stored *>(storage));
+				if(invoke) (*stored)();
+				stored->~Stored();
+			};
+
+			// Sift up.
+			const Entry entry{now_ + delay, sequence_++, slot_index};
+			size_t index = size_++;
+			while(index) {
+				const size_t parent = (index - 1) >> 1;
+				if(!precedes(entry, heap_[parent])) break;
+				heap_[index] = heap_[parent];
+				index = parent;
+			}
+			heap_[index] = entry;
+		}
+
+		/*!
+			@returns The amount of time until the next enqueued action will occur,
+				or TimeUnit(-1) if the queue is empty.
+		*/
+		TimeUnit time_until_next_action() const {
+			if(overflow_.empty()) {
+				if(!size_) return TimeUnit(-1);
+				return heap_[0].due - now_;
+			}
+
+			const auto overflow = next_overflow();
+			if(!size_ || precedes(*overflow, heap_[0])) return overflow->due - now_;
+			return heap_[0].due - now_;
+		}
+
+		/*!
+			Advances the queue the specified amount of time, performing any actions it reaches.
+
+			Each action is performed with the queue's time set to the moment at which it was due,
+			so any further deferrals it makes are relative to that moment.
+		*/
+		void advance(TimeUnit time) {
+			const TimeUnit target = now_ + time;
+			while(true) {
+				if(!overflow_.empty()) {
+					const auto overflow = next_overflow();
+					if(!size_ || precedes(*overflow, heap_[0])) {
+						if(overflow->due > target) break;
+						now_ = overflow->due;
+
+						const auto action = std::move(overflow->action);
+						overflow_.erase(overflow);
+						action();
+						continue;
+					}
+				}
+
+				if(!size_ || heap_[0].due > target) break;
+				now_ = heap_[0].due;
+				const uint8_t slot_index = pop();
+
+				// The slot is released only after performance, as the action may defer others.
+				Slot &slot = slots_[slot_index];
+				slot.perform(slot.storage, true);
+				free_[free_count_++] = slot_index;
+			}
+
+			// Rebase time whenever the queue empties, so that it can never approach overflow.
+			now_ = (size_ || !overflow_.empty()) ? target : TimeUnit(0);
+		}
+
+	private:
+		struct Slot {
+			alignas(std::max_align_t) unsigned char storage[action_size];
+			void (*perform)(void *, bool);
+		};
+		std::array<Slot, capacity> slots_;
+
+		struct Entry {
+			TimeUnit due;
+			uint32_t sequence;
+			uint8_t slot;
+		};
+		std::array<Entry, capacity> heap_;
+
+		// A stack of available slot indices.
+		std::array<uint8_t, capacity> free_;
+		size_t free_count_ = capacity;
+
+		size_t size_ = 0;
+		TimeUnit now_ = TimeUnit(0);
+		uint32_t sequence_ = 0;
+
+		// Actions deferred while all slots were occupied.
+		struct Overflow {
+			TimeUnit due;
+			uint32_t sequence;
+			std::function<void(void)> action;
+		};
+		std::vector<Overflow> overflow_;
+
+		template <typename LHS, typename RHS> static bool precedes(const LHS &lhs, const RHS &rhs) {
+			if(lhs.due != rhs.due) return lhs.due < rhs.due;
+			return int32_t(lhs.sequence - rhs.sequence) < 0;
+		}
+
+		/// @returns The earliest member of the overflow list, which must not be empty.
+		typename std::vector<Overflow>::iterator next_overflow() {
+			return std::min_element(overflow_.begin(), overflow_.end(), precedes<Overflow, Overflow>);
+		}
+		typename std::vector<Overflow>::const_iterator next_overflow() const {
+			return std::min_element(overflow_.begin(), overflow_.end(), precedes<Overflow, Overflow>);
+		}
+
+		/// Removes the root of the heap, returning its slot index; the slot retains its action.
+		uint8_t pop() {
+			const uint8_t result = heap_[0].slot;
+			const Entry last = heap_[--size_];
+
+			// Sift down.
+			size_t index = 0;
+			while(true) {
+				size_t child = (index << 1) + 1;
+				if(child >= size_) break;
+				if(child + 1 < size_ && precedes(heap_[child + 1], heap_[child])) ++child;
+				if(!precedes(heap_[child], last)) break;
+				heap_[index] = heap_[child];
+				index = child;
+			}
+			heap_[index] = last;
+			return result;
+		}
+};
+
 /*!
 	A DeferredQueue maintains a list of ordered actions and the times at which
 	they should happen, and divides a total execution period up into the portions
 	that occur between those actions, triggering each action when it is reached.
 
-	This list is efficient only for short queues.
+	This list is efficient only for short queues; supply an InlineDeferredQueue as @c Queue
+	for allocation-free deferral.
 */
-template <typename TimeUnit> class DeferredQueuePerformer: public DeferredQueue<TimeUnit> {
+template <typename TimeUnit, typename Queue = DeferredQueue<TimeUnit>> class DeferredQueuePerformer: public Queue {
 	public:
 		/// Constructs a DeferredQueue that will call target(period) in between deferred actions.
 		constexpr DeferredQueuePerformer(std::function<void(TimeUnit)> &&target) : target_(std::move(target)) {}
@@ -104,14 +304,14 @@ template <typename TimeUnit> class DeferredQueuePerformer: public DeferredQueue<
 			any scheduled actions will be called between periods.
 		*/
 		void run_for(TimeUnit length) {
-			auto time_to_next = DeferredQueue<TimeUnit>::time_until_next_action();
+			auto time_to_next = Queue::time_until_next_action();
 			while(time_to_next != TimeUnit(-1) && time_to_next <= length) {
 				target_(time_to_next);
 				length -= time_to_next;
-				DeferredQueue<TimeUnit>::advance(time_to_next);
+				Queue::advance(time_to_next);
 			}
 
-			DeferredQueue<TimeUnit>::advance(length);
+			Queue::advance(length);
 			target_(length);
 
 			// TODO: optimise this to avoid the multiple std::vector deletes. Find a neat way to expose that solution, maybe?
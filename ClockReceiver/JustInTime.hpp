@@ -13,6 +13,11 @@
 #include "../Concurrency/AsyncTaskQueue.hpp"
 #include "ClockingHintSource.hpp"
 #include "ForceInline.hpp"
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
 
 /*!
 	A JustInTimeActor holds (i) an embedded object with a run_for method; and (ii) an amount
@@ -31,7 +36,9 @@
 	observer and potentially stop clocking or stop delaying clocking until just-in-time references
 	as directed.
 
-	TODO: incorporate and codify AsyncJustInTimeActor.
+	If profiling is enabled, time spent in the held object's run_for is attributed to @c T.
+
+	See also AsyncJustInTimeActor, below, for components that can usefully run on a worker thread.
 */
 template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int divider = 1> class JustInTimeActor:
 	public ClockingHint::Observer {
@@ -169,11 +176,14 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 				did_flush_ = is_flushed_ = true;
 				if constexpr (divider == 1) {
 					const auto duration = time_since_update_.template flush<TargetTimeScale>();
+					Profiling::Scope<T> profiling_scope(duration.as_integral());
 					object_.run_for(duration);
 				} else {
 					const auto duration = time_since_update_.template divide<TargetTimeScale>(LocalTimeScale(divider));
-					if(duration > TargetTimeScale(0))
+					if(duration > TargetTimeScale(0)) {
+						Profiling::Scope<T> profiling_scope(duration.as_integral());
 						object_.run_for(duration);
+					}
 				}
 			}
 		}
@@ -197,6 +207,30 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 			return time_until_event_ / divider;
 		}
 
+		/// @returns the amount of time that may be added via += before this actor will flush implicitly; @c LocalTimeScale(0)
+		/// if every addition will cause a flush, or @c LocalTimeScale::max() if no addition will.
+		[[nodiscard]] LocalTimeScale time_until_implicit_flush() const {
+			if constexpr (std::is_base_of<ClockingHint::Source, T>::value) {
+				switch(clocking_preference_) {
+					case ClockingHint::Preference::None:		return LocalTimeScale::max();
+					case ClockingHint::Preference::RealTime:	return LocalTimeScale(0);
+					default: break;
+				}
+			}
+
+			if constexpr (has_sequence_points<T>::value) {
+				if constexpr (multiplier == 1) {
+					return time_until_event_;
+				} else {
+					// Round up, without risking overflow if the next sequence point is distant.
+					const auto time = time_until_event_.as_integral();
+					return LocalTimeScale(time / multiplier + (time % multiplier > 0));
+				}
+			} else {
+				return LocalTimeScale::max();
+			}
+		}
+
 		/// Indicates whether a sequence-point-caused flush will occur if the specified period is added.
 		[[nodiscard]] forceinline bool will_flush(LocalTimeScale rhs) const {
 			if constexpr (!has_sequence_points<T>::value) {
@@ -239,7 +273,10 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 					if(time == TargetTimeScale::max()) {
 						time_until_event_ = LocalTimeScale::max();
 					} else {
+						// Any remainder left over by the most recent division will be supplied
+						// to the object along with the next run, so counts towards the sequence point.
 						time_until_event_ = time * divider;
+						time_until_event_ -= time_since_update_;
 					}
 				}
 				assert(time_until_event_ > LocalTimeScale(0));
@@ -267,55 +304,282 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 };
 
 /*!
-	An AsyncJustInTimeActor acts like a JustInTimeActor but additionally contains an AsyncTaskQueue.
-	Any time the amount of accumulated time crosses a threshold provided at construction time,
-	the object will be updated on the AsyncTaskQueue.
+	A JustInTimeGroup clocks several JustInTimeActors that share a local time scale as one: time
+	added to the group is accumulated locally and passed on to the actors, in a single pass, only
+	when at least one of them would flush implicitly or upon an explicit commit.
+
+	So a bus handler pays for a single addition and comparison per bus cycle regardless of the
+	number of actors, and actors receive time in runs bounded only by the earliest of their
+	sequence points and the machine's own accesses.
+
+	Because the actors are not kept up to date, callers must commit() before any direct use of a
+	member actor, whether via -> or otherwise. Sequence points are re-evaluated upon the next
+	addition of time after a commit, so may be changed by whatever access follows it.
+
+	Actors are passed time in the order supplied at construction; an actor's implicit flush may
+	therefore observe later actors without their share of the time being committed. So supply
+	actors without sequence points first if their state may be inspected in response to another's.
+*/
+template <typename LocalTimeScale, typename... Actors> class JustInTimeGroup {
+	public:
+		JustInTimeGroup(Actors &... actors) : actors_(actors...) {}
+
+		/// Adds time to the group.
+		///
+		/// @returns @c true if adding time caused any actor to flush; @c false otherwise.
+		forceinline bool operator += (LocalTimeScale rhs) {
+			pending_ += rhs;
+			if(pending_ < horizon_) {
+				return false;
+			}
+
+			const bool did_flush = push();
+			horizon_ = std::apply([] (const auto &... actors) {
+				return std::min({actors.time_until_implicit_flush()...});
+			}, actors_);
+			return did_flush;
+		}
+
+		/// Passes all accumulated time to the actors, causing them to flush only if a sequence point is reached.
+		///
+		/// @returns @c true if any actor flushed; @c false otherwise.
+		forceinline bool commit() {
+			horizon_ = LocalTimeScale(0);
+			return push();
+		}
+
+		/// Passes all accumulated time to the actors and then flushes each of them.
+		void flush() {
+			commit();
+			std::apply([] (auto &... actors) {
+				(actors.flush(), ...);
+			}, actors_);
+		}
+
+		/// @returns the amount of time that has been added to the group but not yet passed to its actors.
+		[[nodiscard]] forceinline LocalTimeScale time_since_commit() const {
+			return pending_;
+		}
+
+	private:
+		std::tuple<Actors &...> actors_;
+		LocalTimeScale pending_, horizon_;
+
+		forceinline bool push() {
+			if(pending_ == LocalTimeScale(0)) {
+				return false;
+			}
+
+			// Take a copy of the pending time, so that any commit triggered by an actor's flush is harmless.
+			const LocalTimeScale time = pending_;
+			pending_ = LocalTimeScale(0);
+			return std::apply([time] (auto &... actors) {
+				return (false | ... | (actors += time));
+			}, actors_);
+		}
+};
+
+/*!
+	An AsyncJustInTimeActor acts like a JustInTimeActor but runs the embedded object on a worker
+	thread: whenever the accumulated time crosses a threshold provided at construction, that time
+	is dispatched to the worker and the caller continues without waiting.
+
+	The -> operator, flush() and the reaching of a sequence point all wait for the worker to
+	finish before completing synchronously, so all observable behaviour is as per JustInTimeActor.
+	The exception is anything the object produces as a side effect of running, such as video
+	output to a ScanTarget, which will arrive on the worker thread.
+
+	post() allows an action upon the embedded object to be performed asynchronously, after the
+	worker has caught up to the current time; it is intended for accesses that produce no result,
+	such as writes, which can then be batched with the following time. Actions posted must not
+	change the object's next sequence point, which is not re-evaluated, or anything else that
+	the caller may observe without going through the -> operator, such as an interrupt line.
+	E.g. a TMS9918's data port writes qualify but its control port writes do not, since the
+	latter may enable or disable interrupts.
+
+	The threshold trades latency against overhead: each dispatch costs a queue operation
+	and a potential thread wake-up, so it should cover a substantial amount of work; for
+	video hardware a few lines' worth is reasonable.
+
+	So this is appropriate only for components that (i) are expensive to run; (ii) share no state
+	with the rest of the machine other than via calls made through this actor; and (iii) are read
+	from by the caller only rarely.
+
+	On hosts with only a single core all work is performed synchronously, there being nothing to gain.
+
+	Clocking hints are not observed. If profiling is enabled, time spent in the held object's
+	run_for is attributed to @c T, on whichever thread performs it.
 */
 template <class T, class LocalTimeScale = HalfCycles, class TargetTimeScale = LocalTimeScale> class AsyncJustInTimeActor {
+	private:
+		template <typename S, typename = void> struct has_sequence_points : std::false_type {};
+		template <typename S> struct has_sequence_points<S, decltype(void(std::declval<S &>().get_next_sequence_point()))> : std::true_type {};
+
+		/// Updates the actor's sequence point upon destruction, as per JustInTimeActor's equivalent.
+		class SequencePointAwareDeleter {
+			public:
+				explicit SequencePointAwareDeleter(AsyncJustInTimeActor<T, LocalTimeScale, TargetTimeScale> *actor) noexcept
+					: actor_(actor) {}
+
+				forceinline void operator ()(const T *const) const {
+					if constexpr (has_sequence_points<T>::value) {
+						actor_->update_sequence_point();
+					}
+				}
+
+			private:
+				AsyncJustInTimeActor<T, LocalTimeScale, TargetTimeScale> *const actor_;
+		};
+
 	public:
 		/// Constructs a new AsyncJustInTimeActor using the same construction arguments as the included object.
-		template<typename... Args> AsyncJustInTimeActor(TargetTimeScale threshold, Args&&... args) :
+		template<typename... Args> AsyncJustInTimeActor(LocalTimeScale threshold, Args&&... args) :
 			object_(std::forward<Args>(args)...),
-		 	threshold_(threshold) {}
+			threshold_(threshold) {
+			update_sequence_point();
+		}
 
 		/// Adds time to the actor.
-		inline void operator += (const LocalTimeScale &rhs) {
+		///
+		/// @returns @c true if adding time caused a flush; @c false otherwise.
+		forceinline bool operator += (LocalTimeScale rhs) {
 			time_since_update_ += rhs;
-			if(time_since_update_ >= threshold_) {
-				time_since_update_ -= threshold_;
-				task_queue_.enqueue([this] () {
-					object_.run_for(threshold_);
-				});
-			}
+			time_since_dispatch_ += rhs;
 			is_flushed_ = false;
+
+			if constexpr (has_sequence_points<T>::value) {
+				time_until_event_ -= rhs;
+				if(time_until_event_ <= LocalTimeScale(0)) {
+					time_overrun_ = time_until_event_;
+					flush();
+					update_sequence_point();
+					return true;
+				}
+			}
+
+			if(time_since_dispatch_ >= threshold_) {
+				enqueue_time();
+				time_since_dispatch_ = LocalTimeScale(0);
+				if(has_enqueued_) task_queue_.perform();
+			}
+			return false;
 		}
 
 		/// Flushes all accumulated time and returns a pointer to the included object.
-		inline T *operator->() {
+		///
+		/// If this object provides sequence points, checks for changes to the next
+		/// sequence point upon deletion of the pointer.
+		[[nodiscard]] forceinline auto operator->() {
 			flush();
-			return &object_;
+			return std::unique_ptr<T, SequencePointAwareDeleter>(&object_, SequencePointAwareDeleter(this));
 		}
 
-		/// Returns a pointer to the included object without flushing time.
-		inline T *last_valid() {
+		/// Acts exactly as per the standard ->, but preserves constness.
+		///
+		/// Despite being const, this will flush the object and, if relevant, update the next sequence point.
+		[[nodiscard]] forceinline auto operator -> () const {
+			auto non_const_this = const_cast<AsyncJustInTimeActor<T, LocalTimeScale, TargetTimeScale> *>(this);
+			non_const_this->flush();
+			return std::unique_ptr<const T, SequencePointAwareDeleter>(&object_, SequencePointAwareDeleter(non_const_this));
+		}
+
+		/// @returns a pointer to the included object, without flushing time.
+		///
+		/// The object may currently be in use by the worker thread.
+		[[nodiscard]] forceinline T *last_valid() {
 			return &object_;
 		}
 
-		/// Flushes all accumulated time.
-		inline void flush() {
+		/// Enqueues @c action, which will be called with a reference to the included object, to be performed
+		/// asynchronously once all time accumulated so far has been supplied to the object.
+		template <typename Func> void post(Func &&action) {
+			enqueue_time();
+			if(!is_async_) {
+				action(object_);
+				return;
+			}
+
+			task_queue_.enqueue([this, action = std::forward<Func>(action)] {
+				action(object_);
+			});
+			has_enqueued_ = true;
+			is_flushed_ = false;
+		}
+
+		/// Flushes all accumulated time, blocking until the worker has completed all outstanding work.
+		///
+		/// This does not affect this actor's record of when the next sequence point will occur.
+		void flush() {
 			if(!is_flushed_) {
-				task_queue_.flush();
-				object_.run_for(time_since_update_.template flush<TargetTimeScale>());
+				if(has_enqueued_) {
+					task_queue_.flush();
+					has_enqueued_ = false;
+				}
+
+				const auto duration = time_since_update_.template flush<TargetTimeScale>();
+				if(duration > TargetTimeScale(0)) {
+					Profiling::Scope<T> profiling_scope(duration.as_integral());
+					object_.run_for(duration);
+				}
+				time_since_dispatch_ = LocalTimeScale(0);
 				is_flushed_ = true;
 			}
 		}
 
+		/// @returns a number in the range [-max, 0] indicating the offset of the most recent sequence
+		/// point from the final time at the end of the += that triggered the sequence point.
+		[[nodiscard]] forceinline LocalTimeScale last_sequence_point_overrun() {
+			return time_overrun_;
+		}
+
+		/// @returns the amount of time that may be added via += before this actor will flush implicitly,
+		/// or @c LocalTimeScale::max() if the included object doesn't provide sequence points.
+		[[nodiscard]] forceinline LocalTimeScale time_until_implicit_flush() const {
+			if constexpr (has_sequence_points<T>::value) {
+				return time_until_event_;
+			} else {
+				return LocalTimeScale::max();
+			}
+		}
+
+		/// Updates this template's record of the next sequence point.
+		void update_sequence_point() {
+			if constexpr (has_sequence_points<T>::value) {
+				const auto time = object_.get_next_sequence_point();
+				time_until_event_ = (time == TargetTimeScale::max()) ? LocalTimeScale::max() : LocalTimeScale(time);
+				assert(time_until_event_ > LocalTimeScale(0));
+			}
+		}
+
 	private:
 		T object_;
-		LocalTimeScale time_since_update_;
-		TargetTimeScale threshold_;
+		LocalTimeScale time_since_update_, time_since_dispatch_, time_until_event_, time_overrun_;
+		const LocalTimeScale threshold_;
+		const bool is_async_ = std::thread::hardware_concurrency() > 1;
 		bool is_flushed_ = true;
-		Concurrency::AsyncTaskQueue<true> task_queue_;
+		bool has_enqueued_ = false;
+
+		forceinline void enqueue_time() {
+			const auto duration = time_since_update_.template flush<TargetTimeScale>();
+			if(duration <= TargetTimeScale(0)) {
+				return;
+			}
+
+			if(!is_async_) {
+				Profiling::Scope<T> profiling_scope(duration.as_integral());
+				object_.run_for(duration);
+				return;
+			}
+
+			task_queue_.enqueue([this, duration] {
+				Profiling::Scope<T> profiling_scope(duration.as_integral());
+				object_.run_for(duration);
+			});
+			has_enqueued_ = true;
+		}
+
+		// Declared last so as to be destroyed first, completing any outstanding work while object_ remains.
+		Concurrency::AsyncTaskQueue<false> task_queue_;
 };
 
 #endif /* JustInTime_h */
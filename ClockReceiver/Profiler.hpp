@@ -0,0 +1,176 @@
+//
+//  Profiler.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Profiler_hpp
+#define Profiler_hpp
+
+#include "TimeTypes.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+/*!
+	Provides opt-in attribution of host time and emulated cycles to individual components.
+
+	Instrumentation points declare a Profiling::Scope<Component> for the duration of the work they
+	wish to attribute. Scopes are compiled out entirely unless profiling is enabled, which by default
+	it is only if CLK_PROFILE is defined; any individual site may instead pass an explicit @c true
+	or @c false as the second template parameter.
+
+	Scopes nest: time spent within an inner scope is included in its parent's inclusive total but
+	excluded from its parent's exclusive total. So e.g. a CPU's exclusive time excludes any
+	just-in-time catch-up of the components on its bus.
+*/
+namespace Profiling {
+
+#ifdef CLK_PROFILE
+constexpr bool Enabled = true;
+#else
+constexpr bool Enabled = false;
+#endif
+
+/// Totals for a single component; updated atomically as components may run on different threads.
+struct Counter {
+	Counter(const std::string &name) : name(name) {}
+
+	const std::string name;
+	std::atomic<uint64_t> calls = 0;
+	std::atomic<uint64_t> cycles = 0;
+	std::atomic<uint64_t> inclusive_nanos = 0;
+	std::atomic<uint64_t> exclusive_nanos = 0;
+};
+
+/// A snapshot of a Counter.
+struct Record {
+	std::string name;
+	uint64_t calls = 0;
+	uint64_t cycles = 0;
+	Time::Seconds inclusive = 0.0;
+	Time::Seconds exclusive = 0.0;
+};
+using Report = std::vector<Record>;
+
+/*!
+	Owns all counters. Counters are never destroyed, so references to them may be cached indefinitely.
+*/
+class Registry {
+	public:
+		static Registry &shared() {
+			static Registry registry;
+			return registry;
+		}
+
+		/// @returns The counter with the name @c name, creating it if necessary.
+		Counter &counter(const std::string &name) {
+			std::lock_guard lock(mutex_);
+			for(auto &counter: counters_) {
+				if(counter.name == name) return counter;
+			}
+			return counters_.emplace_back(name);
+		}
+
+		/// @returns A snapshot of every counter that has recorded at least one call.
+		Report report() const {
+			std::lock_guard lock(mutex_);
+			Report report;
+			for(const auto &counter: counters_) {
+				if(!counter.calls) continue;
+				report.push_back(Record{
+					counter.name,
+					counter.calls,
+					counter.cycles,
+					Time::seconds(Time::Nanos(counter.inclusive_nanos.load())),
+					Time::seconds(Time::Nanos(counter.exclusive_nanos.load())),
+				});
+			}
+			return report;
+		}
+
+		/// Zeroes all counters.
+		void reset() {
+			std::lock_guard lock(mutex_);
+			for(auto &counter: counters_) {
+				counter.calls = counter.cycles = counter.inclusive_nanos = counter.exclusive_nanos = 0;
+			}
+		}
+
+	private:
+		mutable std::mutex mutex_;
+		std::deque<Counter> counters_;
+};
+
+/// @returns The counter for components of type @c Component, named for that type.
+template <typename Component> Counter &counter_for() {
+	static Counter &counter = [] () -> Counter & {
+		const char *const name = typeid(Component).name();
+#ifdef __GNUC__
+		int status;
+		const std::unique_ptr<char, decltype(&std::free)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), &std::free);
+		if(!status) {
+			return Registry::shared().counter(demangled.get());
+		}
+#endif
+		return Registry::shared().counter(name);
+	}();
+	return counter;
+}
+
+/// Tracks the innermost active scope on each thread, for exclusive timing.
+struct ScopeBase {
+	static inline thread_local ScopeBase *current = nullptr;
+	Time::Nanos children = 0;
+};
+
+/*!
+	Attributes the host time from construction to destruction, and the supplied number
+	of emulated cycles, to @c Component. A no-op unless @c enabled.
+*/
+template <typename Component, bool enabled = Enabled> class Scope {
+	public:
+		Scope(int64_t = 0) {}
+};
+
+template <typename Component> class Scope<Component, true>: public ScopeBase {
+	public:
+		Scope(int64_t cycles = 0) :
+			counter_(counter_for<Component>()),
+			parent_(current),
+			start_(Time::nanos_now()) {
+			current = this;
+			counter_.calls.fetch_add(1, std::memory_order_relaxed);
+			counter_.cycles.fetch_add(uint64_t(cycles), std::memory_order_relaxed);
+		}
+
+		~Scope() {
+			const Time::Nanos elapsed = Time::nanos_now() - start_;
+			counter_.inclusive_nanos.fetch_add(uint64_t(elapsed), std::memory_order_relaxed);
+			counter_.exclusive_nanos.fetch_add(uint64_t(elapsed - children), std::memory_order_relaxed);
+			if(parent_) parent_->children += elapsed;
+			current = parent_;
+		}
+
+	private:
+		Counter &counter_;
+		ScopeBase *const parent_;
+		const Time::Nanos start_;
+};
+
+}
+
+#endif /* Profiler_hpp */
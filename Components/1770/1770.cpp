@@ -12,6 +12,7 @@
 
 #define LOG_PREFIX "[WD FDC] "
 #include "../../Outputs/Log.hpp"
+#include "../../Outputs/Logger.hpp"
 
 using namespace WD;
 
@@ -29,7 +30,7 @@ void WD1770::write(int address, uint8_t value) {
 			if((value&0xf0) == 0xd0) {
 				if(value == 0xd0) {
 					// Force interrupt **immediately**.
-					LOG("Force interrupt immediately");
+					LOGF(Log::Source::WDFDC, "Force interrupt immediately");
 					posit_event(int(Event1770::ForceInterrupt));
 				} else {
 					ERROR("!!!TODO: force interrupt!!!");
@@ -103,10 +104,10 @@ uint8_t WD1770::read(int address) {
 			return status;
 		}
 		case 1:
-			LOG("Returned track " << int(track_));
+			LOGF(Log::Source::WDFDC, "Returned track %d", track_);
 			return track_;
 		case 2:
-			LOG("Returned sector " << int(sector_));
+			LOGF(Log::Source::WDFDC, "Returned sector %d", sector_);
 			return sector_;
 		case 3:
 			update_status([] (Status &status) {
@@ -131,7 +132,8 @@ void WD1770::run_for(const Cycles cycles) {
 }
 
 #define WAIT_FOR_EVENT(mask)	resume_point_ = __LINE__; interesting_event_mask_ = int(mask); return; case __LINE__:
-#define WAIT_FOR_TIME(ms)		resume_point_ = __LINE__; delay_time_ = ms * 8000; WAIT_FOR_EVENT(Event1770::Timer);
+// All timed waits are mechanical — for stepping or head settling — so are collapsed if fast mechanics are enabled.
+#define WAIT_FOR_TIME(ms)		resume_point_ = __LINE__; delay_time_ = get_is_fast_mechanics_enabled() ? 1 : ms * 8000; WAIT_FOR_EVENT(Event1770::Timer);
 #define WAIT_FOR_BYTES(count)	resume_point_ = __LINE__; distance_into_section_ = 0; WAIT_FOR_EVENT(Event::Token); if(get_latest_token().type == Token::Byte) distance_into_section_++; if(distance_into_section_ < count) { interesting_event_mask_ = int(Event::Token); return; }
 #define BEGIN_SECTION()	switch(resume_point_) { default:
 #define END_SECTION()	(void)0; }
@@ -153,9 +155,11 @@ void WD1770::run_for(const Cycles cycles) {
 
 #define SPIN_UP()	\
 		set_motor_on(true);	\
-		index_hole_count_ = 0;	\
-		index_hole_count_target_ = 6;	\
-		WAIT_FOR_EVENT(Event1770::IndexHoleTarget);	\
+		if(!get_is_fast_mechanics_enabled()) {	\
+			index_hole_count_ = 0;	\
+			index_hole_count_target_ = 6;	\
+			WAIT_FOR_EVENT(Event1770::IndexHoleTarget);	\
+		}	\
 		status_.spin_up = true;
 
 // +--------+----------+-------------------------+
@@ -212,7 +216,7 @@ void WD1770::posit_event(int new_event_type) {
 	// Wait for a new command, branch to the appropriate handler.
 	case 0:
 	wait_for_command:
-		LOG("Idle...");
+		LOGF(Log::Source::WDFDC, "Idle...");
 		set_data_mode(DataMode::Scanning);
 		index_hole_count_ = 0;
 
@@ -229,7 +233,7 @@ void WD1770::posit_event(int new_event_type) {
 			status.track_zero = false;	// Always reset by a non-type 1; so reset regardless and set properly later.
 		});
 
-		LOG("Starting " << PADHEX(2) << int(command_));
+		LOGF(Log::Source::WDFDC, "Starting %02x", command_);
 
 		if(!(command_ & 0x80)) goto begin_type_1;
 		if(!(command_ & 0x40)) goto begin_type_2;
@@ -259,7 +263,7 @@ void WD1770::posit_event(int new_event_type) {
 			status.data_request = false;
 		});
 
-		LOG("Step/Seek/Restore with track " << int(track_) << " data " << int(data_));
+		LOGF(Log::Source::WDFDC, "Step/Seek/Restore with track %d data %d", track_, data_);
 		if(!has_motor_on_line() && !has_head_load_line()) goto test_type1_type;
 
 		if(has_motor_on_line()) goto begin_type1_spin_up;
@@ -339,7 +343,7 @@ void WD1770::posit_event(int new_event_type) {
 		READ_ID();
 
 		if(index_hole_count_ == 6) {
-			LOG("Nothing found to verify");
+			LOGF(Log::Source::WDFDC, "Nothing found to verify");
 			update_status([] (Status &status) {
 				status.seek_error = true;
 			});
@@ -357,7 +361,7 @@ void WD1770::posit_event(int new_event_type) {
 			}
 
 			if(header_[0] == track_) {
-				LOG("Reached track " << std::dec << int(track_));
+				LOGF(Log::Source::WDFDC, "Reached track %d", track_);
 				update_status([] (Status &status) {
 					status.crc_error = false;
 				});
@@ -406,6 +410,12 @@ void WD1770::posit_event(int new_event_type) {
 
 	begin_type2_spin_up:
 		if(get_drive().get_motor_on()) goto test_type2_delay;
+		if(get_is_fast_sector_access_enabled() && !(command_&0x20)) {
+			// There's no need to wait for the disk to come up to speed if it isn't going to be read in real time.
+			set_motor_on(true);
+			status_.spin_up = true;
+			goto test_type2_delay;
+		}
 		// Perform spin up.
 		SPIN_UP();
 
@@ -424,13 +434,14 @@ void WD1770::posit_event(int new_event_type) {
 
 		distance_into_section_ = 0;
 		set_data_mode(DataMode::Scanning);
+		if(get_is_fast_sector_access_enabled() && !(command_&0x20)) goto type2_fast_read_data;
 
 	type2_get_header:
 		WAIT_FOR_EVENT(int(Event::IndexHole) | int(Event::Token));
 		READ_ID();
 
 		if(index_hole_count_ == 5) {
-			LOG("Failed to find sector " << std::dec << int(sector_));
+			LOGF(Log::Source::WDFDC, "Failed to find sector %d", sector_);
 			update_status([] (Status &status) {
 				status.record_not_found = true;
 			});
@@ -440,12 +451,12 @@ void WD1770::posit_event(int new_event_type) {
 			distance_into_section_ = 0;
 			set_data_mode(DataMode::Scanning);
 
-			LOG("Considering " << std::dec << int(header_[0]) << "/" << int(header_[2]));
+			LOGF(Log::Source::WDFDC, "Considering %d/%d", header_[0], header_[2]);
 			if(		header_[0] == track_ && header_[2] == sector_ &&
 					(has_motor_on_line() || !(command_&0x02) || ((command_&0x08) >> 3) == header_[1])) {
-				LOG("Found " << std::dec << int(header_[0]) << "/" << int(header_[2]));
+				LOGF(Log::Source::WDFDC, "Found %d/%d", header_[0], header_[2]);
 				if(get_crc_generator().get_value()) {
-					LOG("CRC error; back to searching");
+					LOGF(Log::Source::WDFDC, "CRC error; back to searching");
 					update_status([] (Status &status) {
 						status.crc_error = true;
 					});
@@ -503,18 +514,18 @@ void WD1770::posit_event(int new_event_type) {
 			set_data_mode(DataMode::Scanning);
 
 			if(get_crc_generator().get_value()) {
-				LOG("CRC error; terminating");
+				LOGF(Log::Source::WDFDC, "CRC error; terminating");
 				update_status([] (Status &status) {
 					status.crc_error = true;
 				});
 				goto wait_for_command;
 			}
 
-			LOG("Finished reading sector " << std::dec << int(sector_));
+			LOGF(Log::Source::WDFDC, "Finished reading sector %d", sector_);
 
 			if(command_ & 0x10) {
 				sector_++;
-				LOG("Advancing to search for sector " << std::dec << int(sector_));
+				LOGF(Log::Source::WDFDC, "Advancing to search for sector %d", sector_);
 				goto test_type2_write_protection;
 			}
 			goto wait_for_command;
@@ -522,6 +533,48 @@ void WD1770::posit_event(int new_event_type) {
 		goto type2_check_crc;
 
 
+	// Fast sector access: supply the contents of the sector as quickly as the host will take them,
+	// with the same outcomes as the real-time path but no wait for the disk to rotate.
+	type2_fast_read_data:
+		if(!find_fast_sector()) {
+			LOGF(Log::Source::WDFDC, "Failed to find sector %d", sector_);
+			update_status([] (Status &status) {
+				status.record_not_found = true;
+			});
+			goto wait_for_command;
+		}
+		distance_into_section_ = 0;
+
+	type2_fast_read_byte:
+		data_ = fast_sector_contents_[size_t(distance_into_section_)];
+		update_status([] (Status &status) {
+			status.data_request = true;
+		});
+		++distance_into_section_;
+
+	type2_fast_await_byte_read:
+		delay_time_ = 1;
+		WAIT_FOR_EVENT(Event1770::Timer);
+		if(status_.data_request) goto type2_fast_await_byte_read;
+		if(size_t(distance_into_section_) < fast_sector_contents_.size()) goto type2_fast_read_byte;
+
+		if(fast_sector_has_crc_error_) {
+			LOGF(Log::Source::WDFDC, "CRC error; terminating");
+			update_status([] (Status &status) {
+				status.crc_error = true;
+			});
+			goto wait_for_command;
+		}
+
+		LOGF(Log::Source::WDFDC, "Finished reading sector %d", sector_);
+		if(command_ & 0x10) {
+			sector_++;
+			LOGF(Log::Source::WDFDC, "Advancing to search for sector %d", sector_);
+			goto test_type2_write_protection;
+		}
+		goto wait_for_command;
+
+
 	type2_write_data:
 		WAIT_FOR_BYTES(2);
 		update_status([] (Status &status) {
@@ -598,7 +651,7 @@ void WD1770::posit_event(int new_event_type) {
 			sector_++;
 			goto test_type2_write_protection;
 		}
-		LOG("Wrote sector " << std::dec << int(sector_));
+		LOGF(Log::Source::WDFDC, "Wrote sector %d", sector_);
 		goto wait_for_command;
 
 
@@ -807,6 +860,31 @@ void WD1770::posit_event(int new_event_type) {
 	END_SECTION()
 }
 
+bool WD1770::find_fast_sector() {
+	// Apply the same tests as the real-time search; sectors with header CRC errors
+	// would never be accepted by that, so are ignored here.
+	for(const auto &pair: get_track_sectors()) {
+		const auto &sector = pair.second;
+		if(
+			sector.has_header_crc_error ||
+			sector.samples.empty() ||
+			sector.address.track != track_ ||
+			sector.address.sector != sector_ ||
+			!(has_motor_on_line() || !(command_&0x02) || ((command_&0x08) >> 3) == sector.address.side)
+		) continue;
+
+		fast_sector_contents_ = sector.samples.front();
+		fast_sector_contents_.resize(size_t(128 << (sector.size&3)));
+		fast_sector_has_crc_error_ = sector.has_data_crc_error;
+		update_status([&sector] (Status &status) {
+			status.crc_error = false;
+			status.record_type = sector.is_deleted;
+		});
+		return true;
+	}
+	return false;
+}
+
 void WD1770::update_status(std::function<void(Status &)> updater) {
 	const Status old_status = status_;
 
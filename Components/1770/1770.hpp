@@ -36,6 +36,15 @@ class WD1770: public Storage::Disk::MFMController {
 		/// Sets the value of the double-density input; when @c is_double_density is @c true, reads and writes double-density format data.
 		using Storage::Disk::MFMController::set_is_double_density;
 
+		/// Enables or disables fast sector access, in which read sector commands are satisfied immediately from
+		/// the sectors on the current track rather than in real time. Writes are unaffected.
+		using Storage::Disk::MFMController::set_is_fast_sector_access_enabled;
+		using Storage::Disk::MFMController::get_is_fast_sector_access_enabled;
+
+		/// Enables or disables fast mechanics, in which step rates, head settling and spin-up take minimal time.
+		using Storage::Disk::MFMController::set_is_fast_mechanics_enabled;
+		using Storage::Disk::MFMController::get_is_fast_mechanics_enabled;
+
 		/// Writes @c value to the register at @c address. Only the low two bits of the address are decoded.
 		void write(int address, uint8_t value);
 
@@ -127,12 +136,20 @@ class WD1770: public Storage::Disk::MFMController {
 		};
 		void posit_event(int type);
 		int interesting_event_mask_;
+		bool is_listening() const final {
+			return interesting_event_mask_ & int(Event::Token);
+		}
 		int resume_point_ = 0;
 		Cycles::IntType delay_time_ = 0;
 
 		// ID buffer
 		uint8_t header_[6];
 
+		// Fast sector access: the contents of the sector being read.
+		std::vector<uint8_t> fast_sector_contents_;
+		bool fast_sector_has_crc_error_ = false;
+		bool find_fast_sector();
+
 		// 1793 head-loading logic
 		bool head_is_loaded_ = false;
 
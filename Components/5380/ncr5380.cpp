@@ -8,12 +8,7 @@
 
 #include "ncr5380.hpp"
 
-#ifndef NDEBUG
-#define NDEBUG
-#endif
-#define LOG_PREFIX "[5380] "
-
-#include "../../Outputs/Log.hpp"
+#include "../../Outputs/Logger.hpp"
 
 // TODO:
 //
@@ -38,16 +33,19 @@ NCR5380::NCR5380(SCSI::Bus &bus, int clock_rate) :
 void NCR5380::write(int address, uint8_t value, bool) {
 	switch(address & 7) {
 		case 0:
-			LOG("[0] Set current SCSI bus state to " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[0] Set current SCSI bus state to %02x", value);
 
 			data_bus_ = value;
 			if(dma_request_ && dma_operation_ == DMAOperation::Send) {
-				dma_acknowledge(value);
+				// The target will sample the data lines as they are left at the end of this write.
+				if(!complete_dma_transfer(assert_data_bus_ ? value : 0x00)) {
+					dma_acknowledge(value);
+				}
 			}
 		break;
 
 		case 1: {
-			LOG("[1] Initiator command register set: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[1] Initiator command register set: %02x", value);
 			initiator_command_ = value;
 
 			bus_output_ &= ~(Line::Reset | Line::Acknowledge | Line::Busy | Line::SelectTarget | Line::Attention);
@@ -63,7 +61,7 @@ void NCR5380::write(int address, uint8_t value, bool) {
 		} break;
 
 		case 2:
-			LOG("[2] Set mode: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[2] Set mode: %02x", value);
 			mode_ = value;
 
 			// bit 7: 1 = use block mode DMA mode (if DMA mode is also enabled)
@@ -104,27 +102,27 @@ void NCR5380::write(int address, uint8_t value, bool) {
 		break;
 
 		case 3: {
-			LOG("[3] Set target command: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[3] Set target command: %02x", value);
 			target_command_ = value;
 			update_control_output();
 		} break;
 
 		case 4:
-			LOG("[4] Set select enabled: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[4] Set select enabled: %02x", value);
 		break;
 
 		case 5:
-			LOG("[5] Start DMA send: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[5] Start DMA send: %02x", value);
 			dma_operation_ = DMAOperation::Send;
 		break;
 
 		case 6:
-			LOG("[6] Start DMA target receive: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[6] Start DMA target receive: %02x", value);
 			dma_operation_ = DMAOperation::TargetReceive;
 		break;
 
 		case 7:
-			LOG("[7] Start DMA initiator receive: " << PADHEX(2) << int(value));
+			LOGF(Log::Source::NCR5380, "[7] Start DMA initiator receive: %02x", value);
 			dma_operation_ = DMAOperation::InitiatorReceive;
 		break;
 	}
@@ -148,7 +146,7 @@ void NCR5380::write(int address, uint8_t value, bool) {
 uint8_t NCR5380::read(int address, bool) {
 	switch(address & 7) {
 		case 0:
-			LOG("[0] Get current SCSI bus state: " << PADHEX(2) << (bus_.get_state() & 0xff));
+			LOGF(Log::Source::NCR5380, "[0] Get current SCSI bus state: %02x", bus_.get_state() & 0xff);
 
 			if(dma_request_ && dma_operation_ == DMAOperation::InitiatorReceive) {
 				return dma_acknowledge();
@@ -156,7 +154,7 @@ uint8_t NCR5380::read(int address, bool) {
 		return uint8_t(bus_.get_state());
 
 		case 1:
-			LOG("[1] Initiator command register get: " << (arbitration_in_progress_ ? 'p' : '-') <<  (lost_arbitration_ ? 'l' : '-'));
+			LOGF(Log::Source::NCR5380, "[1] Initiator command register get: %c%c", arbitration_in_progress_ ? 'p' : '-', lost_arbitration_ ? 'l' : '-');
 		return
 			// Bits repeated as they were set.
 			(initiator_command_ & ~0x60) |
@@ -168,11 +166,11 @@ uint8_t NCR5380::read(int address, bool) {
 			(lost_arbitration_ ? 0x20 : 0x00);
 
 		case 2:
-			LOG("[2] Get mode");
+			LOGF(Log::Source::NCR5380, "[2] Get mode");
 		return mode_;
 
 		case 3:
-			LOG("[3] Get target command");
+			LOGF(Log::Source::NCR5380, "[3] Get target command");
 		return target_command_;
 
 		case 4: {
@@ -186,7 +184,7 @@ uint8_t NCR5380::read(int address, bool) {
 				((bus_state & Line::Input)			? 0x04 : 0x00) |
 				((bus_state & Line::SelectTarget)	? 0x02 : 0x00) |
 				((bus_state & Line::Parity)			? 0x01 : 0x00);
-			LOG("[4] Get current bus state: " << PADHEX(2) << int(result));
+			LOGF(Log::Source::NCR5380, "[4] Get current bus state: %02x", result);
 			return result;
 		}
 
@@ -201,16 +199,16 @@ uint8_t NCR5380::read(int address, bool) {
 				/* b2 = busy error */
 				((bus_state & Line::Attention) ? 0x02 : 0x00) |
 				((bus_state & Line::Acknowledge) ? 0x01 : 0x00);
-			LOG("[5] Get bus and status: " << PADHEX(2) << int(result));
+			LOGF(Log::Source::NCR5380, "[5] Get bus and status: %02x", result);
 			return result;
 		}
 
 		case 6:
-			LOG("[6] Get input data");
+			LOGF(Log::Source::NCR5380, "[6] Get input data");
 		return 0xff;
 
 		case 7:
-			LOG("[7] Reset parity/interrupt");
+			LOGF(Log::Source::NCR5380, "[7] Reset parity/interrupt");
 			irq_ = false;
 		return 0xff;
 	}
@@ -350,6 +348,9 @@ bool NCR5380::dma_request() {
 
 uint8_t NCR5380::dma_acknowledge() {
 	const uint8_t bus_state = uint8_t(bus_.get_state());
+	if(complete_dma_transfer(bus_state)) {
+		return bus_state;
+	}
 
 	dma_acknowledge_ = true;
 	dma_request_ = false;
@@ -362,12 +363,49 @@ uint8_t NCR5380::dma_acknowledge() {
 void NCR5380::dma_acknowledge(uint8_t value) {
 	data_bus_ = value;
 
+	// Put the new byte onto the data lines before it can be sampled.
+	if(assert_data_bus_) {
+		bus_output_ = (bus_output_ & ~SCSI::Line::Data) | data_bus_;
+		bus_.set_device_output(device_id_, bus_output_);
+	}
+
+	if(complete_dma_transfer(uint8_t(bus_.get_state()))) {
+		return;
+	}
+
 	dma_acknowledge_ = true;
 	dma_request_ = false;
 	update_control_output();
 	bus_.set_device_output(device_id_, bus_output_);
 }
 
+bool NCR5380::complete_dma_transfer(uint8_t data) {
+	// Pseudo-DMA fast path: if this is an initiator in DMA mode that is about to acknowledge a byte
+	// currently requested by the target, offer the target the chance to complete that byte and request
+	// the next immediately, rather than stepping through each edge of the REQ/ACK handshake.
+	if(
+		state_ != ExecutionState::PerformingDMA ||
+		(mode_ & 0x40) ||
+		(initiator_command_ & 0x10) ||
+		test_mode_ ||
+		dma_acknowledge_ ||
+		(bus_.get_state() & (Line::Request | Line::Acknowledge)) != Line::Request
+	) {
+		return false;
+	}
+
+	if(!bus_.acknowledge_data(data)) {
+		return false;
+	}
+
+	// Request is still active, so the DMA request stands exactly as it would
+	// once the target's next request had been observed.
+	dma_request_ =
+		!phase_mismatch_ ||
+		(dma_operation_ != DMAOperation::InitiatorReceive);
+	return true;
+}
+
 bool NCR5380::phase_matches() const {
 	const auto bus_state = bus_.get_state();
 	return
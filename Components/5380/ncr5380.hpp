@@ -84,6 +84,7 @@ class NCR5380 final: public SCSI::Bus::Observer {
 
 		void scsi_bus_did_change(SCSI::Bus *, SCSI::BusState new_state, double time_since_change) final;
 		bool phase_matches() const;
+		bool complete_dma_transfer(uint8_t data);
 };
 
 }
@@ -114,12 +114,21 @@ template <class BusHandlerT> class MOS6522: public MOS6522Storage {
 		/// @returns @c true if the IRQ line is currently active; @c false otherwise.
 		bool get_interrupt_line() const;
 
+		/// @returns The time until the next timer underflow, or other observable change, if nothing
+		/// else intervenes; @c HalfCycles::max() if there is no such event pending.
+		HalfCycles get_next_sequence_point() const;
+
 		/// Updates the port handler to the current time and then requests that it flush.
 		void flush();
 
 	private:
 		void do_phase1();
 		void do_phase2();
+
+		bool is_only_counting() const;
+		int cycles_until_underflow(int timer) const;
+		int quiet_cycles() const;
+		void skip_cycles(int cycles);
 		void shift_in();
 		void shift_out();
 
@@ -8,6 +8,9 @@
 
 #include "../../../Outputs/Log.hpp"
 
+#include <algorithm>
+#include <limits>
+
 // As-yet unimplemented (incomplete list):
 //
 //	PB6 count-down mode for timer 2.
@@ -384,6 +387,79 @@ template <typename T> void MOS6522<T>::evaluate_port_b_output() {
 		registers_.data_direction[1] | timer_control_bit);
 }
 
+/*!
+	@returns @c true if nothing other than the timer counts will change from one cycle to the next,
+	until a timer underflows; @c false if there is a reload pending or anything else occurs on every cycle.
+*/
+template <typename T> bool MOS6522<T>::is_only_counting() const {
+	return
+		!registers_.timer_needs_reload &&
+		registers_.next_timer[0] < 0 && registers_.next_timer[1] < 0 &&
+		handshake_modes_[1] != HandshakeMode::Pulse &&
+		(handshake_modes_[0] != HandshakeMode::Pulse || control_outputs_[0].lines[1] == LineState::On) &&
+		shift_mode() != ShiftMode::InUnderPhase2 && shift_mode() != ShiftMode::OutUnderPhase2;
+}
+
+/*!
+	@returns The number of whole cycles, starting from a phase 1, before the phase 1 at which @c timer will
+	signal underflow; @c std::numeric_limits<int>::max() if it won't.
+*/
+template <typename T> int MOS6522<T>::cycles_until_underflow(int timer) const {
+	if(!timer_is_running_[timer]) return std::numeric_limits<int>::max();
+
+	// Underflow is signalled at the first phase 1 after the count has passed from 0 to 0xffff.
+	if(registers_.timer[timer] == 0xffff && !registers_.last_timer[timer]) return 0;
+	if(timer && !timer2_clock_decrement()) return std::numeric_limits<int>::max();
+	return registers_.timer[timer] + 1;
+}
+
+/*!
+	@returns The number of whole cycles, starting from a phase 1, that can be skipped via @c skip_cycles
+	because nothing will happen other than timer counting; @c std::numeric_limits<int>::max() if unbounded.
+*/
+template <typename T> int MOS6522<T>::quiet_cycles() const {
+	if(!is_only_counting()) return 0;
+	return std::min(cycles_until_underflow(0), cycles_until_underflow(1));
+}
+
+/*!
+	Advances by @c cycles whole cycles, starting from a phase 1, with exactly the same effect as calling
+	@c do_phase1 and @c do_phase2 that many times. @c cycles must be non-zero and no greater than @c quiet_cycles().
+*/
+template <typename T> void MOS6522<T>::skip_cycles(int cycles) {
+	time_since_bus_handler_call_ += HalfCycles(cycles * 2);
+
+	registers_.last_timer[0] = uint16_t(registers_.timer[0] - (cycles - 1));
+	registers_.timer[0] = uint16_t(registers_.timer[0] - cycles);
+
+	const int timer2_decrement = timer2_clock_decrement();
+	registers_.last_timer[1] = uint16_t(registers_.timer[1] - timer2_decrement * (cycles - 1));
+	registers_.timer[1] = uint16_t(registers_.timer[1] - timer2_decrement * cycles);
+}
+
+template <typename T> HalfCycles MOS6522<T>::get_next_sequence_point() const {
+	if(!is_phase2_) {
+		// An underflow after n quiet cycles is signalled during the phase 1 that follows.
+		const int cycles = quiet_cycles();
+		if(cycles == std::numeric_limits<int>::max()) return HalfCycles::max();
+		return HalfCycles(cycles * 2 + 1);
+	}
+
+	// Between phase 1 and phase 2: a running timer that is currently at n will underflow at the
+	// coming phase 2 if n is 0, or after a further n cycles otherwise, and signal at the next phase 1.
+	if(!is_only_counting()) return HalfCycles(1);
+
+	int cycles = std::numeric_limits<int>::max();
+	if(timer_is_running_[0]) {
+		cycles = registers_.timer[0];
+	}
+	if(timer_is_running_[1] && timer2_clock_decrement()) {
+		cycles = std::min(cycles, int(registers_.timer[1]));
+	}
+	if(cycles == std::numeric_limits<int>::max()) return HalfCycles::max();
+	return HalfCycles(cycles * 2 + 2);
+}
+
 /*! Runs for a specified number of half cycles. */
 template <typename T> void MOS6522<T>::run_for(const HalfCycles half_cycles) {
 	auto number_of_half_cycles = half_cycles.as_integral();
@@ -395,6 +471,17 @@ template <typename T> void MOS6522<T>::run_for(const HalfCycles half_cycles) {
 	}
 
 	while(number_of_half_cycles >= 2) {
+		// Jump over any period in which only the timers change; a single cycle is
+		// cheaper to run than to analyse.
+		if(number_of_half_cycles >= 4) {
+			const auto cycles = std::min<decltype(number_of_half_cycles)>(quiet_cycles(), number_of_half_cycles >> 1);
+			if(cycles) {
+				skip_cycles(int(cycles));
+				number_of_half_cycles -= cycles * 2;
+				continue;
+			}
+		}
+
 		do_phase1();
 		do_phase2();
 		number_of_half_cycles -= 2;
@@ -416,9 +503,20 @@ template <typename T> void MOS6522<T>::flush() {
 /*! Runs for a specified number of cycles. */
 template <typename T> void MOS6522<T>::run_for(const Cycles cycles) {
 	auto number_of_cycles = cycles.as_integral();
-	while(number_of_cycles--) {
+	while(number_of_cycles) {
+		// As above: jump over any period in which only the timers change.
+		if(number_of_cycles > 1) {
+			const auto quiet = std::min<decltype(number_of_cycles)>(quiet_cycles(), number_of_cycles);
+			if(quiet) {
+				skip_cycles(int(quiet));
+				number_of_cycles -= quiet;
+				continue;
+			}
+		}
+
 		do_phase1();
 		do_phase2();
+		--number_of_cycles;
 	}
 }
 
@@ -58,6 +58,10 @@ template <typename PortHandlerT, Personality personality> class MOS6526:
 		/// Pulses Phi2 to advance by the specified number of half cycles.
 		void run_for(const HalfCycles half_cycles);
 
+		/// @returns The time until the next change in interrupt state, if nothing else intervenes;
+		/// @c HalfCycles::max() if there is no such event pending.
+		HalfCycles get_next_sequence_point() const;
+
 		/// Pulses the TOD input the specified number of times.
 		void advance_tod(int count);
 
@@ -82,6 +86,7 @@ template <typename PortHandlerT, Personality personality> class MOS6526:
 		void update_interrupts();
 		void posit_interrupt(uint8_t mask);
 		void advance_counters(int);
+		int quiet_ticks() const;
 
 		bool serial_line_did_produce_bit(Serial::Line<true> *line, int bit) final;
 };
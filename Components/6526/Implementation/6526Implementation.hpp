@@ -9,6 +9,7 @@
 #ifndef _526Implementation_h
 #define _526Implementation_h
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 
@@ -189,12 +190,40 @@ uint8_t MOS6526<BusHandlerT, personality>::read(int address) {
 	return 0xff;
 }
 
+template <typename BusHandlerT, Personality personality>
+int MOS6526<BusHandlerT, personality>::quiet_ticks() const {
+	if(pending_ || cnt_edge_) return 0;
+	return std::min(counter_[0].template quiet_ticks<false>(), counter_[1].template quiet_ticks<true>());
+}
+
+template <typename BusHandlerT, Personality personality>
+HalfCycles MOS6526<BusHandlerT, personality>::get_next_sequence_point() const {
+	const int quiet = quiet_ticks();
+	if(quiet == std::numeric_limits<int>::max()) return HalfCycles::max();
+
+	// Any interrupt will be signalled in the tick after the quiet period.
+	return HalfCycles((quiet + 1) * 2) - half_divider_;
+}
+
 template <typename BusHandlerT, Personality personality>
 void MOS6526<BusHandlerT, personality>::run_for(const HalfCycles half_cycles) {
 	half_divider_ += half_cycles;
 	int sub = half_divider_.divide_cycles().template as<int>();
 
-	while(sub--) {
+	while(sub) {
+		// Jump over any period in which the counters are doing nothing other than counting;
+		// a single tick is cheaper to perform than to analyse.
+		if(sub > 1) {
+			const int quiet = std::min(sub, quiet_ticks());
+			if(quiet) {
+				counter_[0].skip(quiet);
+				counter_[1].skip(quiet);
+				sub -= quiet;
+				continue;
+			}
+		}
+		--sub;
+
 		pending_ <<= 1;
 		if(pending_ & InterruptNow) {
 			interrupt_state_ |= 0x80;
@@ -10,6 +10,7 @@
 #define _526Storage_h
 
 #include <array>
+#include <limits>
 
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 
@@ -306,6 +307,32 @@ struct MOS6526Storage {
 			return should_reload;
 		}
 
+		/// @returns The number of calls to @c advance, with neither a chained input nor a CNT edge, that would
+		/// do nothing other than count down, without reloading; @c std::numeric_limits<int>::max() if that's unbounded.
+		template <bool is_counter_2> int quiet_ticks() const {
+			// Nothing must be pending other than the steady state implied by the control register.
+			if(control & 0x10) return 0;
+			if(pending & (ReloadInOne | ReloadNow | TestInputInOne)) return 0;
+
+			const int one_shot = (control & 0x08) ? (OneShotInOne | OneShotNow) : 0;
+			if((pending & (OneShotInOne | OneShotNow)) != one_shot) return 0;
+
+			const bool counts_phi2 = is_counter_2 ? !(control & 0x60) : !(control & 0x20);
+			const int clock = (counts_phi2 && (control & 1)) ? (ApplyClockInTwo | ApplyClockInOne | ApplyClockNow) : 0;
+			if((pending & (ApplyClockInTwo | ApplyClockInOne | ApplyClockNow)) != clock) return 0;
+
+			// If counting, the tick that takes the value to zero will reload.
+			if(!clock) return std::numeric_limits<int>::max();
+			return uint16_t(value - 1);
+		}
+
+		/// Performs @c ticks calls to @c advance, which must be no more than @c quiet_ticks().
+		void skip(int ticks) {
+			if(pending & ApplyClockNow) {
+				value = uint16_t(value - ticks);
+			}
+		}
+
 		private:
 			int pending = 0;
 
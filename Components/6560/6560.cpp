@@ -8,6 +8,7 @@
 
 #include "6560.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace MOS::MOS6560;
@@ -105,30 +106,60 @@ static uint8_t noise_pattern[] = {
 // testing against 0x80. The effect should be the same: loading with 0x7f means an output update every cycle, loading with 0x7e
 // means every second cycle, etc.
 
+std::size_t AudioGenerator::samples_until_update() const {
+	// Each channel updates upon the increment that takes its counter to 0x80 << shift.
+	return std::min({
+		(0x80u << 2) - counters_[0],
+		(0x80u << 1) - counters_[1],
+		(0x80u << 0) - counters_[2],
+		(0x80u << 1) - counters_[3],
+	});
+}
+
+int16_t AudioGenerator::level() const {
+	// this sums the output of all three sounds channels plus a DC offset for volume;
+	// TODO: what's the real ratio of this stuff?
+	return int16_t(
+		(shift_registers_[0]&1) +
+		(shift_registers_[1]&1) +
+		(shift_registers_[2]&1) +
+		((noise_pattern[shift_registers_[3] >> 3] >> (shift_registers_[3]&7))&(control_registers_[3] >> 7)&1)
+	) * volume_ + (volume_ >> 4);
+}
+
 void AudioGenerator::get_samples(std::size_t number_of_samples, int16_t *target) {
-	for(unsigned int c = 0; c < number_of_samples; ++c) {
+	while(number_of_samples) {
+		// Output is constant up until the next sample in which a channel updates, so can be
+		// written as a single run.
+		const std::size_t run = std::min(number_of_samples, samples_until_update() - 1);
+		std::fill_n(target, run, level());
+		for(auto &counter: counters_) counter += unsigned(run);
+		target += run;
+		number_of_samples -= run;
+		if(!number_of_samples) break;
+
 		update(0, 2, shift);
 		update(1, 1, shift);
 		update(2, 0, shift);
 		update(3, 1, increment);
-
-		// this sums the output of all three sounds channels plus a DC offset for volume;
-		// TODO: what's the real ratio of this stuff?
-		target[c] = int16_t(
-			(shift_registers_[0]&1) +
-			(shift_registers_[1]&1) +
-			(shift_registers_[2]&1) +
-			((noise_pattern[shift_registers_[3] >> 3] >> (shift_registers_[3]&7))&(control_registers_[3] >> 7)&1)
-		) * volume_ + (volume_ >> 4);
+		*target = level();
+		++target;
+		--number_of_samples;
 	}
 }
 
 void AudioGenerator::skip_samples(std::size_t number_of_samples) {
-	for(unsigned int c = 0; c < number_of_samples; ++c) {
+	while(number_of_samples) {
+		const std::size_t run = std::min(number_of_samples, samples_until_update() - 1);
+		for(auto &counter: counters_) counter += unsigned(run);
+		number_of_samples -= run;
+		if(!number_of_samples) break;
+
 		update(0, 2, shift);
 		update(1, 1, shift);
 		update(2, 0, shift);
 		update(3, 1, increment);
+		--number_of_samples;
 	}
 }
 
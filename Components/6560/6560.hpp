@@ -15,6 +15,8 @@
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 
+#include <algorithm>
+
 namespace MOS {
 namespace MOS6560 {
 
@@ -40,6 +42,12 @@ class AudioGenerator: public ::Outputs::Speaker::SampleSource {
 		uint8_t control_registers_[4] = {0, 0, 0, 0};
 		int16_t volume_ = 0;
 		int16_t range_multiplier_ = 1;
+
+		/// @returns The number of samples from now until the next in which any channel updates, including that one.
+		std::size_t samples_until_update() const;
+
+		/// @returns The current output level.
+		int16_t level() const;
 };
 
 struct BusHandler {
@@ -174,7 +182,19 @@ template <class BusHandler> class MOS6560 {
 			cycles_since_speaker_update_ += cycles;
 
 			auto number_of_cycles = cycles.as_integral();
-			while(number_of_cycles--) {
+			while(number_of_cycles) {
+				// Skip directly over any stretch of sync, colour burst or border in which nothing
+				// other than the horizontal counter will change.
+				const int quiet_cycles = int(std::min(decltype(number_of_cycles)(quiet_cycles_ahead()), number_of_cycles));
+				if(quiet_cycles > 1) {
+					horizontal_counter_ += quiet_cycles;
+					if(pixel_line_cycle_ >= 0) pixel_line_cycle_ += quiet_cycles;
+					cycles_in_state_ += quiet_cycles;
+					number_of_cycles -= quiet_cycles;
+					continue;
+				}
+				--number_of_cycles;
+
 				// keep an old copy of the vertical count because that test is a cycle later than the actual changes
 				int previous_vertical_counter = vertical_counter_;
 
@@ -248,32 +268,17 @@ template <class BusHandler> class MOS6560 {
 
 				fetch_address &= 0x3fff;
 
-				uint8_t pixel_data;
-				uint8_t colour_data;
-				bus_handler_.perform_read(fetch_address, &pixel_data, &colour_data);
-
 				// TODO: there should be a further two-cycle delay on pixels being output; the reverse bit should
 				// divide the byte it is set for 3:1 and then continue as usual.
+				this_state_ = state_at(horizontal_counter_);
 
-				// determine output state; colour burst and sync timing are currently a guess
-				if(horizontal_counter_ > timing_.cycles_per_line-4) this_state_ = State::ColourBurst;
-				else if(horizontal_counter_ > timing_.cycles_per_line-7) this_state_ = State::Sync;
-				else {
-					this_state_ = (column_counter_ >= 0 && column_counter_ < columns_this_line_*2) ? State::Pixels : State::Border;
+				// Fetched data is used only while outputting pixels.
+				uint8_t pixel_data = 0xff;
+				uint8_t colour_data = 0xff;
+				if(this_state_ == State::Pixels) {
+					bus_handler_.perform_read(fetch_address, &pixel_data, &colour_data);
 				}
 
-				// apply vertical sync
-				if(
-					(vertical_counter_ < 3 && is_odd_frame()) ||
-					(registers_.interlaced &&
-						(
-							(vertical_counter_ == 0 && horizontal_counter_ > 32) ||
-							(vertical_counter_ == 1) || (vertical_counter_ == 2) ||
-							(vertical_counter_ == 3 && horizontal_counter_ <= 32)
-						)
-					))
-					this_state_ = State::Sync;
-
 				// update the CRT
 				if(this_state_ != output_state_) {
 					switch(output_state_) {
@@ -433,7 +438,7 @@ template <class BusHandler> class MOS6560 {
 		BusHandler &bus_handler_;
 		Outputs::CRT::CRT crt_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		AudioGenerator audio_generator_;
 		Outputs::Speaker::PullLowpass<AudioGenerator> speaker_;
 
@@ -485,6 +490,62 @@ template <class BusHandler> class MOS6560 {
 			return is_odd_frame_ || !registers_.interlaced;
 		}
 
+		/// @returns The output state for a cycle at @c horizontal_counter on the current line, given the current column.
+		State state_at(int horizontal_counter) const {
+			// determine output state; colour burst and sync timing are currently a guess
+			State state;
+			if(horizontal_counter > timing_.cycles_per_line-4) state = State::ColourBurst;
+			else if(horizontal_counter > timing_.cycles_per_line-7) state = State::Sync;
+			else {
+				state = (column_counter_ >= 0 && column_counter_ < columns_this_line_*2) ? State::Pixels : State::Border;
+			}
+
+			// apply vertical sync
+			if(
+				(vertical_counter_ < 3 && is_odd_frame()) ||
+				(registers_.interlaced &&
+					(
+						(vertical_counter_ == 0 && horizontal_counter > 32) ||
+						(vertical_counter_ == 1) || (vertical_counter_ == 2) ||
+						(vertical_counter_ == 3 && horizontal_counter <= 32)
+					)
+				))
+				state = State::Sync;
+
+			return state;
+		}
+
+		/*!
+			@returns The number of upcoming cycles during which the only changes will be to the horizontal counter,
+				the pixel line cycle counter and the length of the current output state; 0 if the next cycle has
+				any other effect.
+		*/
+		int quiet_cycles_ahead() const {
+			// Pixels, and the cycles that lead into or set up pixels, always take the full path.
+			if(column_counter_ >= 0 && column_counter_ < columns_this_line_*2) return 0;
+			if(pixel_line_cycle_ >= 0 && pixel_line_cycle_ < 3) return 0;
+			if(pixel_line_cycle_ < 0 && horizontal_drawing_latch_) return 0;
+			if(!vertical_drawing_latch_ && registers_.first_row_location == (vertical_counter_ >> 1)) return 0;
+
+			// Stop before the end of the line, before any change in output state and before the horizontal
+			// drawing latch could be set.
+			const int next = horizontal_counter_ + 1;
+			int limit = timing_.cycles_per_line;
+			const auto limit_to = [&](int boundary) {
+				if(boundary > next) limit = std::min(limit, boundary);
+			};
+			limit_to(timing_.cycles_per_line - 6);
+			limit_to(timing_.cycles_per_line - 3);
+			if(registers_.interlaced) limit_to(33);
+			if(vertical_drawing_latch_ && !horizontal_drawing_latch_) {
+				if(registers_.first_column_location == next) return 0;
+				limit_to(registers_.first_column_location);
+			}
+
+			if(state_at(next) != output_state_) return 0;
+			return limit - next;
+		}
+
 		// latches dictating start and length of drawing
 		bool vertical_drawing_latch_ = false, horizontal_drawing_latch_ = false;
 		int rows_this_field_ = 0, columns_this_line_ = 0;
@@ -11,6 +11,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 
@@ -41,6 +42,14 @@ class BusHandler {
 			having to wait until the next cycle has begun.
 		*/
 		void perform_bus_cycle_phase2(const BusState &) {}
+
+		/*!
+			Performs @c length complete bus cycles during which nothing changes other than the refresh address,
+			which begins at the value in the supplied state and increments by one per cycle, modulo 0x4000.
+			This is exactly equivalent to the equivalent number of calls to @c perform_bus_cycle_phase1 and
+			@c perform_bus_cycle_phase2 but allows the handler to process an entire run at once.
+		*/
+		void perform_bus_cycle_span(const BusState &, [[maybe_unused]] int length) {}
 };
 
 enum Personality {
@@ -112,7 +121,18 @@ template <class T> class CRTC6845 {
 
 		void run_for(Cycles cycles) {
 			auto cyles_remaining = cycles.as_integral();
-			while(cyles_remaining--) {
+			while(cyles_remaining) {
+				// If a run of characters is upcoming in which only the refresh address will change,
+				// announce it in one go.
+				const int span = span_length();
+				if(span > 1) {
+					const int length = int(std::min(decltype(cyles_remaining)(span), cyles_remaining));
+					perform_bus_cycle_span(length);
+					cyles_remaining -= length;
+					continue;
+				}
+				--cyles_remaining;
+
 				// check for end of visible characters
 				if(character_counter_ == registers_[1]) {
 					// TODO: consider skew in character_is_visible_. Or maybe defer until perform_bus_cycle?
@@ -165,6 +185,33 @@ template <class T> class CRTC6845 {
 		}
 
 	private:
+		/*!
+			@returns The number of upcoming cycles, starting from now, during which neither sync, display enable
+				nor any counter other than the character counter and refresh address will change.
+		*/
+		inline int span_length() const {
+			// Horizontal sync changes state every cycle, and display enable lags any change in visibility
+			// by up to the skew.
+			if(bus_state_.hsync) return 0;
+			if((character_is_visible_shifter_ & 7) != (character_is_visible_ ? 7 : 0)) return 0;
+
+			// Otherwise the next event is the earliest of: the end of visible characters, the end of the
+			// line, or the start of horizontal sync, which is tested after the counter is incremented.
+			return std::min({
+				int(uint8_t(registers_[1] - character_counter_)),
+				int(uint8_t(registers_[0] - character_counter_)),
+				int(uint8_t(registers_[2] - character_counter_ - 1)),
+			});
+		}
+
+		inline void perform_bus_cycle_span(int length) {
+			bus_state_.display_enable = (int(character_is_visible_shifter_) & display_skew_mask_) && line_is_visible_;
+			bus_handler_.perform_bus_cycle_span(bus_state_, length);
+
+			bus_state_.refresh_address = (bus_state_.refresh_address + length) & 0x3fff;
+			character_counter_ = uint8_t(character_counter_ + length);
+		}
+
 		inline void perform_bus_cycle_phase1() {
 			// Skew theory of operation: keep a history of the last three states, and apply whichever is selected.
 			character_is_visible_shifter_ = (character_is_visible_shifter_ << 1) | unsigned(character_is_visible_);
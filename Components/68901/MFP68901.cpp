@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 #ifndef NDEBUG
 #define NDEBUG
@@ -21,14 +22,9 @@
 using namespace Motorola::MFP68901;
 
 ClockingHint::Preference MFP68901::preferred_clocking() const {
-	// Rule applied: if any timer is actively running and permitted to produce an
-	// interrupt, request real-time running.
-	return
-		(timers_[0].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerA) ||
-		(timers_[1].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerB) ||
-		(timers_[2].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerC) ||
-		(timers_[3].mode >= TimerMode::Delay && interrupt_enable_&Interrupt::TimerD)
-			? ClockingHint::Preference::RealTime : ClockingHint::Preference::JustInTime;
+	// Running timers that are permitted to produce an interrupt are announced via
+	// get_next_sequence_point, so there's no need ever to request real-time running.
+	return ClockingHint::Preference::JustInTime;
 }
 
 uint8_t MFP68901::read(int address) {
@@ -208,7 +204,29 @@ void MFP68901::run_for(HalfCycles time) {
 }
 
 HalfCycles MFP68901::get_next_sequence_point() {
-	return HalfCycles::max();
+	// The next sequence point is the soonest that any running timer that is
+	// permitted to produce an unmasked interrupt will reach zero.
+	static constexpr int timer_interrupts[] = {Interrupt::TimerA, Interrupt::TimerB, Interrupt::TimerC, Interrupt::TimerD};
+
+	int cycles = std::numeric_limits<int>::max();
+	for(int c = 0; c < 4; ++c) {
+		// Timers that cannot currently affect the interrupt line needn't be considered: any change in
+		// enable or mask, or any read of the pending bits, will cause the MFP to be brought up to date first.
+		if(timers_[c].mode < TimerMode::Delay || !(interrupt_enable_ & interrupt_mask_ & timer_interrupts[c])) continue;
+
+		// A value of 0 underflows to 255 so implies a further 256 decrements; run_for applies the nth
+		// decrement once the prescale count has advanced to n times the prescale, but can't do so in
+		// fewer than one cycle. Cf. run_for and decrement_timer.
+		const int decrements = timers_[c].value ? timers_[c].value : 256;
+		cycles = std::min(cycles, std::max(decrements * timers_[c].prescale - timers_[c].prescale_count, 1));
+	}
+
+	if(cycles == std::numeric_limits<int>::max()) {
+		return HalfCycles::max();
+	}
+
+	// Allow for any half cycle already banked.
+	return HalfCycles(int64_t(cycles) * 2 - cycles_left_.as_integral());
 }
 
 // MARK: - Timers
@@ -262,23 +280,34 @@ void MFP68901::set_timer_event_input(int channel, bool value) {
 }
 
 void MFP68901::decrement_timer(int timer, int amount) {
-	while(amount--) {
-		--timers_[timer].value;
-		if(timers_[timer].value < 1) {
-			switch(timer) {
-				case 0: begin_interrupts(Interrupt::TimerA);	break;
-				case 1: begin_interrupts(Interrupt::TimerB);	break;
-				case 2: begin_interrupts(Interrupt::TimerC);	break;
-				case 3: begin_interrupts(Interrupt::TimerD);	break;
-			}
+	Timer &subject = timers_[timer];
 
-			// Re: reloading when in event counting mode; I found the data sheet thoroughly unclear on
-			// this, but it appears empirically to be correct. See e.g. Pompey Pirates menu 27.
-			if(timers_[timer].mode == TimerMode::Delay || timers_[timer].mode == TimerMode::EventCount) {
-				timers_[timer].value += timers_[timer].reload_value;	// TODO: properly.
-			}
-		}
+	// A value of 0 underflows to 255 so implies a further 256 decrements before the next interrupt.
+	const int decrements_to_zero = subject.value ? subject.value : 256;
+	if(amount < decrements_to_zero) {
+		subject.value = uint8_t(subject.value - amount);
+		return;
 	}
+
+	// At least one interrupt will occur. Since nothing else can change between successive
+	// expiries of this timer, signalling it once is equivalent to signalling it each time.
+	switch(timer) {
+		case 0: begin_interrupts(Interrupt::TimerA);	break;
+		case 1: begin_interrupts(Interrupt::TimerB);	break;
+		case 2: begin_interrupts(Interrupt::TimerC);	break;
+		case 3: begin_interrupts(Interrupt::TimerD);	break;
+	}
+
+	// Re: reloading when in event counting mode; I found the data sheet thoroughly unclear on
+	// this, but it appears empirically to be correct. See e.g. Pompey Pirates menu 27.
+	//
+	// Otherwise the timer just continues from 0; in either case every subsequent expiry
+	// returns it to the same value so the remaining decrements can be applied modulo
+	// the resulting period.
+	const uint8_t expired_value =
+		(subject.mode == TimerMode::Delay || subject.mode == TimerMode::EventCount) ? subject.reload_value : 0;	// TODO: properly.
+	const int period = expired_value ? expired_value : 256;
+	subject.value = uint8_t(expired_value - (amount - decrements_to_zero) % period);
 }
 
 // MARK: - GPIP
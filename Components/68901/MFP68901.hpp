@@ -40,7 +40,7 @@ class MFP68901: public ClockingHint::Source {
 		/// at which the interrupt line _might_ change. This object conforms to ClockingHint::Source
 		/// so that mechanism can also be used to reduce the quantity of calls into this class.
 		///
-		/// @discussion TODO, alas.
+		/// @discussion Only timer interrupts are predicted; all other changes follow from calls into this class.
 		HalfCycles get_next_sequence_point();
 
 		/// Sets the current level of either of the timer event inputs — TAI and TBI in datasheet terms.
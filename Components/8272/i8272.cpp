@@ -10,6 +10,8 @@
 
 #include "../../Outputs/Log.hpp"
 
+#include <algorithm>
+
 using namespace Intel::i8272;
 
 #define SetDataRequest()				(main_status_ |= 0x80)
@@ -115,6 +117,9 @@ void i8272::run_for(Cycles cycles) {
 				drives_[c].step_rate_counter += cycles.as_integral();
 				auto steps = drives_[c].step_rate_counter / (8000 * step_rate_time_);
 				drives_[c].step_rate_counter %= (8000 * step_rate_time_);
+
+				// With fast mechanics, complete the seek immediately; no drive has anywhere near 256 tracks.
+				if(get_is_fast_mechanics_enabled()) steps = 256;
 				while(steps--) {
 					// Perform a step.
 					int direction = (drives_[c].target_head_position < drives_[c].head_position) ? -1 : 1;
@@ -249,7 +254,7 @@ uint8_t i8272::read(int address) {
 #define LOAD_HEAD()	\
 	if(!drives_[active_drive_].head_is_loaded[active_head_]) {	\
 		drives_[active_drive_].head_is_loaded[active_head_] = true;	\
-		WAIT_FOR_TIME(head_load_time_);	\
+		WAIT_FOR_TIME((get_is_fast_mechanics_enabled() ? 0 : head_load_time_));	\
 	} else {	\
 		if(drives_[active_drive_].head_unload_delay[active_head_] > 0) {	\
 			drives_[active_drive_].head_unload_delay[active_head_] = 0;	\
@@ -384,6 +389,12 @@ void i8272::posit_event(int event_type) {
 	// and searches for a sector that meets those criteria. If one is found, inspects the instruction in use and
 	// jumps to an appropriate handler.
 	read_write_find_header:
+			switch(command_[0] & 0x1f) {
+				case CommandReadData:
+				case CommandReadDeletedData:
+					if(get_is_fast_sector_access_enabled()) goto fast_read_data;
+				break;
+			}
 
 		// Sets a maximum index hole limit of 2 then performs a find header/read header loop, continuing either until
 		// the index hole limit is breached or a sector is found with a cylinder, head, sector and size equal to the
@@ -517,6 +528,51 @@ void i8272::posit_event(int event_type) {
 		// For a final result phase, post the standard ST0, ST1, ST2, C, H, R, N
 			goto post_st012chrn;
 
+	// Performs the read data or read deleted data command with fast sector access: each sector is found
+	// directly in those decoded from the current track, and its bytes are supplied as quickly as the
+	// processor will take them. Outcomes are as per the real-time path, other than that there's no
+	// possibility of overrun.
+	fast_read_data:
+			if(!find_fast_sector()) {
+				SetNoData();
+				goto abort;
+			}
+
+			ClearControlMark();
+			if(fast_sector_is_deleted_ != ((command_[0] & 0x1f) == CommandReadDeletedData)) {
+				if(!(command_[0]&0x20)) {
+					// SK is not set; set the error flag but read this sector before finishing.
+					SetControlMark();
+				} else {
+					// SK is set; skip this sector.
+					if(sector_ == command_[6]) goto post_st012chrn;
+					sector_++;
+					goto fast_read_data;
+				}
+			}
+
+			distance_into_section_ = 0;
+		fast_read_data_get_byte:
+			result_stack_.push_back(fast_sector_contents_[size_t(distance_into_section_)]);
+			distance_into_section_++;
+			SetDataRequest();
+			SetDataDirectionToProcessor();
+			WAIT_FOR_EVENT(Event8272::ResultEmpty);
+			ResetDataRequest();
+			if(size_t(distance_into_section_) < fast_sector_contents_.size()) goto fast_read_data_get_byte;
+
+			if(fast_sector_has_crc_error_) {
+				SetDataError();
+				SetDataFieldDataError();
+				goto abort;
+			}
+
+			if(sector_ != command_[6] && !ControlMark()) {
+				sector_++;
+				goto fast_read_data;
+			}
+			goto post_st012chrn;
+
 	write_data:
 			LOG(PADHEX(2) << "Write [deleted] data ["
 				<< int(command_[2]) << " "
@@ -879,6 +935,29 @@ void i8272::posit_event(int event_type) {
 	END_SECTION()
 }
 
+bool i8272::find_fast_sector() {
+	for(const auto &pair: get_track_sectors()) {
+		const auto &sector = pair.second;
+		if(
+			sector.samples.empty() ||
+			sector.address.track != cylinder_ ||
+			sector.address.side != head_ ||
+			sector.address.sector != sector_ ||
+			sector.size != size_
+		) continue;
+
+		// As per the real-time path, a header CRC error is flagged but doesn't prevent reading.
+		if(sector.has_header_crc_error) SetDataError();
+
+		fast_sector_contents_ = sector.samples.front();
+		fast_sector_contents_.resize(size_t(128) << std::min(int(size_), 7));
+		fast_sector_has_crc_error_ = sector.has_data_crc_error;
+		fast_sector_is_deleted_ = sector.is_deleted;
+		return true;
+	}
+	return false;
+}
+
 bool i8272::seek_is_satisfied(int drive) {
 	return	(drives_[drive].target_head_position == drives_[drive].head_position) ||
 			(drives_[drive].target_head_position == -1 && get_drive().get_is_track_zero());
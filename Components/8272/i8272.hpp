@@ -42,6 +42,15 @@ class i8272 : public Storage::Disk::MFMController {
 
 		ClockingHint::Preference preferred_clocking() const final;
 
+		/// Enables or disables fast sector access, in which read data commands are satisfied immediately from
+		/// the sectors on the current track rather than in real time. Writes are unaffected.
+		using Storage::Disk::MFMController::set_is_fast_sector_access_enabled;
+		using Storage::Disk::MFMController::get_is_fast_sector_access_enabled;
+
+		/// Enables or disables fast mechanics, in which seeks and head loading take minimal time.
+		using Storage::Disk::MFMController::set_is_fast_mechanics_enabled;
+		using Storage::Disk::MFMController::get_is_fast_mechanics_enabled;
+
 	protected:
 		virtual void select_drive(int number) = 0;
 
@@ -126,6 +135,12 @@ class i8272 : public Storage::Disk::MFMController {
 		// Internal registers.
 		uint8_t cylinder_ = 0, head_ = 0, sector_ = 0, size_ = 0;
 
+		// Fast sector access: the contents of the sector being read.
+		std::vector<uint8_t> fast_sector_contents_;
+		bool fast_sector_has_crc_error_ = false;
+		bool fast_sector_is_deleted_ = false;
+		bool find_fast_sector();
+
 		// Master switch on not performing any work.
 		bool is_sleeping_ = false;
 };
@@ -26,9 +26,11 @@ constexpr unsigned int CRTCyclesDivider = 4;
 
 template <Personality personality>
 Base<personality>::Base() :
-	crt_(CRTCyclesPerLine, CRTCyclesDivider, Outputs::Display::Type::NTSC60, Outputs::Display::InputDataType::Red8Green8Blue8) {
-	// Unimaginatively, this class just passes RGB through to the shader. Investigation is needed
-	// into whether there's a more natural form. It feels unlikely given the diversity of chips modelled.
+	crt_(CRTCyclesPerLine, CRTCyclesDivider, Outputs::Display::Type::NTSC60, input_data_type) {
+	// Sega VDPs pass RGB through to the shader; everything else supplies indices into the fixed palette.
+	if constexpr (!is_sega_vdp(personality)) {
+		crt_.set_palette(palette.data(), palette.size());
+	}
 
 	if constexpr (is_sega_vdp(personality)) {
 		mode_timing_.line_interrupt_position = 64;
@@ -420,14 +422,18 @@ void TMS9918<personality>::run_for(const HalfCycles cycles) {
 						if(!this->asked_for_write_area_) {
 							this->asked_for_write_area_ = true;
 
-							this->pixel_origin_ = this->pixel_target_ = reinterpret_cast<uint32_t *>(
+							this->pixel_origin_ = this->pixel_target_ = reinterpret_cast<typename Base<personality>::PixelType *>(
 								this->crt_.begin_data(line_buffer.pixel_count)
 							);
 						}
 
 						if(this->pixel_target_) {
 							switch(line_buffer.line_mode) {
-								case LineMode::SMS:			draw(draw_sms(relative_start, relative_end, cram_value), Clock::TMSPixel);	break;
+								case LineMode::SMS:
+									if constexpr (is_sega_vdp(personality)) {
+										draw(draw_sms(relative_start, relative_end, cram_value), Clock::TMSPixel);
+									}
+								break;
 								case LineMode::Character:	draw(draw_tms_character(relative_start, relative_end), Clock::TMSPixel);	break;
 								case LineMode::Text:		draw(draw_tms_text(relative_start, relative_end), Clock::TMSPixel);			break;
 
@@ -507,9 +513,13 @@ void Base<personality>::output_border(int cycles, [[maybe_unused]] uint32_t cram
 	// If the border colour is 0, that can be communicated
 	// more efficiently as an explicit blank.
 	if(border_colour) {
-		uint32_t *const pixel_target = reinterpret_cast<uint32_t *>(crt_.begin_data(1));
+		PixelType *const pixel_target = reinterpret_cast<PixelType *>(crt_.begin_data(1));
 		if(pixel_target) {
-			*pixel_target = border_colour;
+			if constexpr (is_sega_vdp(personality)) {
+				*pixel_target = border_colour;
+			} else {
+				*pixel_target = pixel_for(background_colour_);
+			}
 		}
 		crt_.output_level(cycles);
 	} else {
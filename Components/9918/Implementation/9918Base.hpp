@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace TI {
@@ -155,6 +156,21 @@ template <Personality personality> struct Base {
 		palette_pack(255, 255, 255)
 	};
 
+	// VDPs other than Sega's have only the fixed palette above, so output indices into it and let the scan target
+	// apply the palette; Sega VDPs have a programmable palette that may change at any time, so output RGB.
+	static constexpr Outputs::Display::InputDataType input_data_type =
+		is_sega_vdp(personality) ? Outputs::Display::InputDataType::Red8Green8Blue8 : Outputs::Display::InputDataType::Palette8;
+	using PixelType = std::conditional_t<is_sega_vdp(personality), uint32_t, uint8_t>;
+
+	/// @returns The output pixel that represents entry @c index of the fixed palette.
+	static constexpr PixelType pixel_for(int index) {
+		if constexpr (is_sega_vdp(personality)) {
+			return palette[size_t(index)];
+		} else {
+			return PixelType(index);
+		}
+	}
+
 	Outputs::CRT::CRT crt_;
 	TVStandard tv_standard_ = TVStandard::NTSC;
 
@@ -386,7 +402,7 @@ template <Personality personality> struct Base {
 	void output_border(int cycles, uint32_t cram_dot);
 
 	// Output serialisation state.
-	uint32_t *pixel_target_ = nullptr, *pixel_origin_ = nullptr;
+	PixelType *pixel_target_ = nullptr, *pixel_origin_ = nullptr;
 	bool asked_for_write_area_ = false;
 
 	// Output serialisers.
@@ -9,6 +9,28 @@
 #ifndef Draw_hpp
 #define Draw_hpp
 
+/// @returns A table that expands a byte of pattern data into eight pixels at once, with the bit for pixel n of
+/// each byte being placed at bit 0 of byte n of the result. Pixels are taken from most-significant bit to least,
+/// unless @c is_reversed is @c true.
+constexpr std::array<uint64_t, 256> pattern_expansion_table(bool is_reversed) {
+	std::array<uint64_t, 256> table{};
+	for(int source = 0; source < 256; source++) {
+		for(int bit = 0; bit < 8; bit++) {
+			if(source & (is_reversed ? (1 << bit) : (0x80 >> bit))) {
+				table[size_t(source)] |= uint64_t(1) << (bit << 3);
+			}
+		}
+	}
+	return table;
+}
+
+struct PatternExpansion {
+	static constexpr auto forward = pattern_expansion_table(false);
+
+	/// Used for horizontally-flipped Master System tiles.
+	static constexpr auto reversed = pattern_expansion_table(true);
+};
+
 // MARK: - TMS9918
 
 template <Personality personality>
@@ -19,40 +41,31 @@ void Base<personality>::draw_tms_character(int start, int end) {
 	const int pixels_left = end - start;
 	if(this->screen_mode_ == ScreenMode::MultiColour) {
 		for(int c = start; c < end; ++c) {
-			pixel_target_[c] = palette[
+			pixel_target_[c] = pixel_for(
 				(line_buffer.patterns[c >> 3][0] >> (((c & 4)^4))) & 15
-			];
+			);
 		}
 	} else {
-		const int shift = start & 7;
 		int byte_column = start >> 3;
-
-		int length = std::min(pixels_left, 8 - shift);
-
-		int pattern = Numeric::bit_reverse(line_buffer.patterns[byte_column][0]) >> shift;
-		uint8_t colour = line_buffer.patterns[byte_column][1];
-		uint32_t colours[2] = {
-			palette[(colour & 15) ? (colour & 15) : background_colour_],
-			palette[(colour >> 4) ? (colour >> 4) : background_colour_]
-		};
-
+		int pixel = start & 7;
 		int background_pixels_left = pixels_left;
-		while(true) {
-			background_pixels_left -= length;
+		while(background_pixels_left) {
+			const int length = std::min(8 - pixel, background_pixels_left);
+			const uint64_t pattern = PatternExpansion::forward[line_buffer.patterns[byte_column][0]];
+			const uint8_t colour = line_buffer.patterns[byte_column][1];
+			const PixelType colours[2] = {
+				pixel_for((colour & 15) ? (colour & 15) : background_colour_),
+				pixel_for((colour >> 4) ? (colour >> 4) : background_colour_)
+			};
+
 			for(int c = 0; c < length; ++c) {
-				pixel_target_[c] = colours[pattern&0x01];
-				pattern >>= 1;
+				pixel_target_[c] = colours[(pattern >> ((pixel + c) << 3)) & 1];
 			}
 			pixel_target_ += length;
 
-			if(!background_pixels_left) break;
-			length = std::min(8, background_pixels_left);
-			byte_column++;
-
-			pattern = Numeric::bit_reverse(line_buffer.patterns[byte_column][0]);
-			colour = line_buffer.patterns[byte_column][1];
-			colours[0] = palette[(colour & 15) ? (colour & 15) : background_colour_];
-			colours[1] = palette[(colour >> 4) ? (colour >> 4) : background_colour_];
+			background_pixels_left -= length;
+			pixel = 0;
+			++byte_column;
 		}
 	}
 
@@ -72,7 +85,7 @@ void Base<personality>::draw_tms_character(int start, int end) {
 		int sprite_collision = 0;
 		memset(&sprite_buffer[start], 0, size_t(end - start)*sizeof(sprite_buffer[0]));
 
-		constexpr uint32_t sprite_colour_selection_masks[2] = {0x00000000, 0xffffffff};
+		constexpr PixelType sprite_colour_selection_masks[2] = {0, PixelType(~0)};
 		constexpr int colour_masks[16] = {0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
 
 		// Draw all sprites into the sprite buffer.
@@ -93,7 +106,7 @@ void Base<personality>::draw_tms_character(int start, int end) {
 					sprite_colour &= colour_masks[sprite.image[2]&15];
 					pixel_origin_[c] =
 						(pixel_origin_[c] & sprite_colour_selection_masks[sprite_colour^1]) |
-						(palette[sprite.image[2]&15] & sprite_colour_selection_masks[sprite_colour]);
+						(pixel_for(sprite.image[2]&15) & sprite_colour_selection_masks[sprite_colour]);
 
 					sprite.shift_position += shift_advance;
 				}
@@ -107,7 +120,7 @@ void Base<personality>::draw_tms_character(int start, int end) {
 template <Personality personality>
 void Base<personality>::draw_tms_text(int start, int end) {
 	LineBuffer &line_buffer = line_buffers_[read_pointer_.row];
-	const uint32_t colours[2] = { palette[background_colour_], palette[text_colour_] };
+	const PixelType colours[2] = { pixel_for(background_colour_), pixel_for(text_colour_) };
 
 	const int shift = start % 6;
 	int byte_column = start / 6;
@@ -153,58 +166,37 @@ void Base<personality>::draw_sms(int start, int end, uint32_t cram_dot) {
 	}
 
 
-	uint32_t pattern;
-	uint8_t *const pattern_index = reinterpret_cast<uint8_t *>(&pattern);
-
 	/*
 		Add background tiles; these will fill the colour_buffer with values in which
 		the low five bits are a palette index, and bit six is set if this tile has
 		priority over sprites.
 	*/
 	if(tile_start < end) {
-		const int shift = tile_start & 7;
 		int byte_column = tile_start >> 3;
+		int pixel = tile_start & 7;
 		int pixels_left = tile_end - tile_start;
-		int length = std::min(pixels_left, 8 - shift);
+		while(pixels_left) {
+			const int length = std::min(8 - pixel, pixels_left);
+
+			// Expand all four planes at once, giving eight four-bit colours, one per byte.
+			const uint64_t *const expansion =
+				(line_buffer.names[byte_column].flags&2) ? PatternExpansion::reversed.data() : PatternExpansion::forward.data();
+			const uint8_t *const planes = line_buffer.patterns[byte_column];
+			const uint64_t colours =
+				(expansion[planes[3]] << 3) |
+				(expansion[planes[2]] << 2) |
+				(expansion[planes[1]] << 1) |
+				expansion[planes[0]];
 
-		pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
-		if(line_buffer.names[byte_column].flags&2)
-			pattern >>= shift;
-		else
-			pattern <<= shift;
-
-		while(true) {
 			const int palette_offset = (line_buffer.names[byte_column].flags&0x18) << 1;
-			if(line_buffer.names[byte_column].flags&2) {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x01) << 3) |
-						((pattern_index[2] & 0x01) << 2) |
-						((pattern_index[1] & 0x01) << 1) |
-						((pattern_index[0] & 0x01) << 0) |
-						palette_offset;
-					++tile_offset;
-					pattern >>= 1;
-				}
-			} else {
-				for(int c = 0; c < length; ++c) {
-					colour_buffer[tile_offset] =
-						((pattern_index[3] & 0x80) >> 4) |
-						((pattern_index[2] & 0x80) >> 5) |
-						((pattern_index[1] & 0x80) >> 6) |
-						((pattern_index[0] & 0x80) >> 7) |
-						palette_offset;
-					++tile_offset;
-					pattern <<= 1;
-				}
+			for(int c = 0; c < length; ++c) {
+				colour_buffer[tile_offset + c] = int((colours >> ((pixel + c) << 3)) & 0xf) | palette_offset;
 			}
+			tile_offset += length;
 
 			pixels_left -= length;
-			if(!pixels_left) break;
-
-			length = std::min(8, pixels_left);
-			byte_column++;
-			pattern = *reinterpret_cast<const uint32_t *>(line_buffer.patterns[byte_column]);
+			pixel = 0;
+			++byte_column;
 		}
 	}
 
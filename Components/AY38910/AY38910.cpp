@@ -6,6 +6,7 @@
 //  Copyright 2016 Thomas Harte. All rights reserved.
 //
 
+#include <algorithm>
 #include <cmath>
 
 #include "AY38910.hpp"
@@ -123,6 +124,27 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	}
 
 	while(c < number_of_samples) {
+		// Between counter events the output is constant, and every counter just decrements.
+		// So if that's going to be true for at least one full step, fill as many as possible in one go.
+		const int steps_to_event = std::min({tone_counters_[0], tone_counters_[1], tone_counters_[2], noise_counter_, envelope_divider_});
+		const std::size_t steps = std::min(std::size_t(steps_to_event), (number_of_samples - c) >> 2);
+		if(steps) {
+			tone_counters_[0] -= int(steps);
+			tone_counters_[1] -= int(steps);
+			tone_counters_[2] -= int(steps);
+			noise_counter_ -= int(steps);
+			envelope_divider_ -= int(steps);
+
+			if constexpr (is_stereo) {
+				std::fill_n(&reinterpret_cast<uint32_t *>(target)[c], steps << 2, output_volume_);
+			} else {
+				std::fill_n(&target[c], steps << 2, int16_t(output_volume_));
+			}
+			c += steps << 2;
+			master_divider_ += int(steps << 2);
+			continue;
+		}
+
 #define step_channel(c) \
 	if(tone_counters_[c]) tone_counters_[c]--;\
 	else {\
@@ -209,7 +209,15 @@ struct State: public Reflection::StructImpl<State> {
 		}
 	}
 
-	template <typename AY> void apply(AY &target) {
+	template <typename AY> State(const AY &source) : State() {
+		// Capture emulator-thread state.
+		for(int c = 0; c < 16; c++) {
+			registers[c] = source.registers_[c];
+		}
+		selected_register = uint8_t(source.selected_register_);
+	}
+
+	template <typename AY> void apply(AY &target) const {
 		// Establish emulator-thread state
 		for(uint8_t c = 0; c < 16; c++) {
 			target.select_register(c);
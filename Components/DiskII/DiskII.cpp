@@ -8,6 +8,7 @@
 
 #include "DiskII.hpp"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -82,45 +83,52 @@ void DiskII::run_for(const Cycles cycles) {
 	if(preferred_clocking() == ClockingHint::Preference::None) return;
 
 	auto integer_cycles = cycles.as_integral();
-	while(integer_cycles--) {
-		const int address = (state_ & 0xf0) | inputs_ | ((shift_register_&0x80) >> 6);
-		if(flux_duration_) {
-			--flux_duration_;
-			if(!flux_duration_) inputs_ |= input_flux;
+	while(integer_cycles) {
+		// While reading, and once any flux pulse has expired, the sequencer's inputs can change only upon
+		// a drive event. So step the sequencer through the whole run of cycles until the next such event,
+		// then bring the drives up to date in one go.
+		Cycles::IntType batch = 1;
+		if(!(inputs_ & input_mode) && !flux_duration_) {
+			batch = integer_cycles;
+			if(!drive_is_sleeping_[0]) batch = std::min(batch, drives_[0].cycles_until_next_change());
+			if(!drive_is_sleeping_[1]) batch = std::min(batch, drives_[1].cycles_until_next_change());
 		}
-		state_ = state_machine_[size_t(address)];
-		switch(state_ & 0xf) {
-			default:	shift_register_ = 0;										break;	// clear
-			case 0x8:																break;	// nop
-
-			case 0x9:	shift_register_ = uint8_t(shift_register_ << 1);			break;	// shift left, bringing in a zero
-			case 0xd:	shift_register_ = uint8_t((shift_register_ << 1) | 1);		break;	// shift left, bringing in a one
-
-			case 0xa:	// shift right, bringing in write protected status
-				shift_register_ = (shift_register_ >> 1) | (is_write_protected() ? 0x80 : 0x00);
-
-				// If the controller is in the sense write protect loop but the register will never change,
-				// short circuit further work and return now.
-				if(shift_register_ == (is_write_protected() ? 0xff : 0x00)) {
-					if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(integer_cycles));
-					if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(integer_cycles));
-					decide_clocking_preference();
-					return;
-				}
-			break;
-			case 0xb:	shift_register_ = data_input_;								break;	// load data register from data bus
-		}
-
-		// Currently writing?
-		if(inputs_&input_mode) {
-			// state_ & 0x80 should be the current level sent to the disk;
-			// therefore transitions in that bit should become flux transitions
-			drives_[active_drive_].write_bit(!!((state_ ^ address) & 0x80));
+		integer_cycles -= batch;
+
+		for(auto remaining = batch; remaining; --remaining) {
+			const int address = (state_ & 0xf0) | inputs_ | ((shift_register_&0x80) >> 6);
+			const uint8_t prior_shift_register = shift_register_;
+			if(flux_duration_) {
+				--flux_duration_;
+				if(!flux_duration_) inputs_ |= input_flux;
+			}
+			state_ = state_machine_[size_t(address)];
+			switch(state_ & 0xf) {
+				default:	shift_register_ = 0;										break;	// clear
+				case 0x8:																break;	// nop
+
+				case 0x9:	shift_register_ = uint8_t(shift_register_ << 1);			break;	// shift left, bringing in a zero
+				case 0xd:	shift_register_ = uint8_t((shift_register_ << 1) | 1);		break;	// shift left, bringing in a one
+
+				case 0xa:	shift_register_ = (shift_register_ >> 1) | (is_write_protected() ? 0x80 : 0x00);	break;	// shift right, bringing in write protected status
+				case 0xb:	shift_register_ = data_input_;								break;	// load data register from data bus
+			}
+
+			// Currently writing?
+			if(inputs_&input_mode) {
+				// state_ & 0x80 should be the current level sent to the disk;
+				// therefore transitions in that bit should become flux transitions
+				drives_[active_drive_].write_bit(!!((state_ ^ address) & 0x80));
+			}
+
+			// With its inputs fixed for the remainder of the batch, a sequencer that has returned to the
+			// same state and shift register contents will remain there.
+			if(shift_register_ == prior_shift_register && (state_ & 0xf0) == (address & 0xf0)) break;
 		}
 
 		// TODO: surely there's a less heavyweight solution than inline updates?
-		if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(1));
-		if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(1));
+		if(!drive_is_sleeping_[0]) drives_[0].run_for(Cycles(batch));
+		if(!drive_is_sleeping_[1]) drives_[1].run_for(Cycles(batch));
 	}
 
 	// Per comp.sys.apple2.programmer there is a delay between the controller
@@ -157,9 +165,11 @@ void DiskII::decide_clocking_preference() {
 	}
 
 	// If in sense-write-protect mode, clocking is just-in-time if the shift register hasn't yet filled with the value that
-	// corresponds to the current write protect status. Otherwise it is none.
+	// corresponds to the current write protect status, or if a drive is running. Otherwise it is none.
 	if((inputs_ & ~input_flux) == input_command) {
-		clocking_preference_ = (shift_register_ == (is_write_protected() ? 0xff : 0x00)) ? ClockingHint::Preference::None : ClockingHint::Preference::JustInTime;
+		clocking_preference_ =
+			(drive_is_sleeping_[0] && drive_is_sleeping_[1] && shift_register_ == (is_write_protected() ? 0xff : 0x00))
+				? ClockingHint::Preference::None : ClockingHint::Preference::JustInTime;
 	}
 
 	// Announce a change if there was one.
@@ -8,6 +8,8 @@
 
 #include "IWM.hpp"
 
+#include <algorithm>
+
 #ifndef NDEBUG
 #define NDEBUG
 #endif
@@ -256,8 +258,17 @@ void IWM::run_for(const Cycles cycles) {
 			const auto error_margin = Cycles(bit_length_.as_integral() >> 1);
 
 			if(drive_is_rotating_[active_drive_]) {
-				while(integer_cycles--) {
-					drives_[active_drive_]->run_for(Cycles(1));
+				while(integer_cycles) {
+					// Run the drive for as long as it can go without posting an event, but no further than
+					// the end of the current bit window; that's equivalent to running it cycle by cycle
+					// provided that any event is seen to occur before the final cycle has been counted.
+					auto run_length = std::min(integer_cycles, drives_[active_drive_]->cycles_until_next_change());
+					const auto cycles_until_window_end = (bit_length_ + error_margin - cycles_since_shift_).as_integral();
+					if(cycles_until_window_end > 0) run_length = std::min(run_length, cycles_until_window_end);
+					integer_cycles -= run_length;
+
+					cycles_since_shift_ += Cycles(run_length - 1);
+					drives_[active_drive_]->run_for(Cycles(run_length));
 					++cycles_since_shift_;
 					if(cycles_since_shift_ == bit_length_ + error_margin) {
 //						LOG("Shifting 0 at " << std::dec << cycles_since_shift_.as_integral());
@@ -8,6 +8,7 @@
 
 #include "KonamiSCC.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 using namespace Konami;
@@ -33,6 +34,21 @@ void SCC::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
+		// Output can change only when a tone counter wraps, so fill directly up to the next wrap where possible.
+		int steps = int((number_of_samples - c) >> 3);
+		for(const auto &channel: channels_) {
+			steps = std::min(steps, channel.tone_counter);
+		}
+		if(steps) {
+			for(auto &channel: channels_) {
+				channel.tone_counter -= steps;
+			}
+			std::fill_n(&target[c], steps << 3, transient_output_level_);
+			c += size_t(steps << 3);
+			master_divider_ += steps << 3;
+			continue;
+		}
+
 		for(int channel = 0; channel < 5; ++channel) {
 			if(channels_[channel].tone_counter) channels_[channel].tone_counter--;
 			else {
@@ -26,8 +26,8 @@ template <int precision> class PhaseGenerator {
 			Advances the phase generator a single step, given the current state of the low-frequency oscillator, @c oscillator.
 		*/
 		void update(const LowFrequencyOscillator &oscillator) {
-			constexpr int vibrato_shifts[4] = {3, 1, 0, 1};
-			constexpr int vibrato_signs[2] = {1, -1};
+			static constexpr int vibrato_shifts[4] = {3, 1, 0, 1};
+			static constexpr int vibrato_signs[2] = {1, -1};
 
 			// Get just the top three bits of the period_.
 			const int top_freq = period_ >> (precision - 3);
@@ -63,7 +63,7 @@ template <int precision> class PhaseGenerator {
 			plus the degree of feedback to apply
 		*/
 		void apply_feedback(LogSign first, LogSign second, int level) {
-			constexpr int masks[] = {0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+			static constexpr int masks[] = {0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
 			phase_ += ((second.level(precision) + first.level(precision)) >> (8 - level)) & masks[level];
 		}
 
@@ -74,7 +74,7 @@ template <int precision> class PhaseGenerator {
 		void set_multiple(int multiple) {
 			// This encodes the MUL -> multiple table given on page 12,
 			// multiplied by two.
-			constexpr int multipliers[] = {
+			static constexpr int multipliers[] = {
 				1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30
 			};
 			assert(multiple < 16);
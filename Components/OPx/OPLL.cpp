@@ -8,6 +8,7 @@
 
 #include "OPLL.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace Yamaha::OPL;
@@ -285,13 +286,15 @@ void OPLL::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	const int update_period = 72 / audio_divider_;
 	const int channel_output_period = 4 / audio_divider_;
 
-	// TODO: the conditional below is terrible. Fix.
-	while(number_of_samples--) {
+	while(number_of_samples) {
 		if(!audio_offset_) update_all_channels();
 
-		*target = output_levels_[audio_offset_ / channel_output_period];
-		++target;
-		audio_offset_ = (audio_offset_ + 1) % update_period;
+		// Output the current channel's level for whatever remains of its time slot.
+		const std::size_t run = std::min(number_of_samples, std::size_t(channel_output_period - (audio_offset_ % channel_output_period)));
+		std::fill_n(target, run, output_levels_[audio_offset_ / channel_output_period]);
+		target += run;
+		number_of_samples -= run;
+		audio_offset_ = (audio_offset_ + int(run)) % update_period;
 	}
 }
 
@@ -8,6 +8,7 @@
 
 #include "SN76489.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -108,6 +109,28 @@ void SN76489::get_samples(std::size_t number_of_samples, std::int16_t *target) {
 	}
 
 	while(c < number_of_samples) {
+		// Between counter events the output is constant, and every counter just decrements.
+		// So if that's going to be true for at least one full step, fill as many as possible in one go.
+		int steps_to_event = std::min({channels_[0].counter, channels_[1].counter, channels_[2].counter});
+		if(channels_[3].divider != 0xffff) {
+			steps_to_event = std::min(steps_to_event, int(channels_[3].counter));
+		}
+		const std::size_t steps = std::min(std::size_t(steps_to_event), (number_of_samples - c) / std::size_t(master_divider_period_));
+		if(steps) {
+			for(int channel = 0; channel < 3; channel++) {
+				channels_[channel].counter -= uint16_t(steps);
+			}
+			if(channels_[3].divider != 0xffff) {
+				channels_[3].counter -= uint16_t(steps);
+			}
+
+			const std::size_t samples = steps * std::size_t(master_divider_period_);
+			std::fill_n(&target[c], samples, output_volume_);
+			c += samples;
+			master_divider_ += int(samples);
+			continue;
+		}
+
 		bool did_flip = false;
 
 #define step_channel(x, s) \
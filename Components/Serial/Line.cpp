@@ -15,42 +15,69 @@ using namespace Serial;
 
 template <bool include_clock>
 void Line<include_clock>::set_writer_clock_rate(HalfCycles clock_rate) {
+	// Forward any time that has passed at the old rate before switching.
+	if constexpr (!include_clock) {
+		if(write_cycles_since_delegate_call_) {
+			update_delegate(level_);
+		}
+	}
+	set_read_timing(read_delegate_bit_length_, clock_rate);
+}
+
+template <bool include_clock>
+void Line<include_clock>::set_read_timing(Storage::Time bit_length, HalfCycles clock_rate) {
+	if constexpr (!include_clock) {
+		// Any serialisation in progress continues in terms of absolute time,
+		// which is unaffected by a change in writer clock rate.
+		if(is_counting_half_cycles_) {
+			time_left_in_bit_ = Storage::Time(unsigned(half_cycles_left_in_bit_), unsigned(clock_rate_.as_integral() * 2));
+			is_counting_half_cycles_ = false;
+		}
+	}
+
+	read_delegate_bit_length_ = bit_length;
 	clock_rate_ = clock_rate;
+
+	if constexpr (!include_clock) {
+		read_delegate_bit_half_cycles_ = 0;
+		if(!read_delegate_ || clock_rate_ == HalfCycles(0)) return;
+
+		const auto bit_cycles = read_delegate_bit_length_ * unsigned(clock_rate_.as_integral());
+		if(!(bit_cycles.length % bit_cycles.clock_rate)) {
+			read_delegate_bit_half_cycles_ = HalfCycles::IntType(bit_cycles.length / bit_cycles.clock_rate) * 2;
+		}
+	}
 }
 
 template <bool include_clock>
 void Line<include_clock>::advance_writer(HalfCycles cycles) {
 	if(cycles == HalfCycles(0)) return;
 
-	const auto integral_cycles = cycles.as_integral();
+	auto integral_cycles = cycles.as_integral();
 	remaining_delays_ = std::max(remaining_delays_ - integral_cycles, Cycles::IntType(0));
-	if(events_.empty()) {
-		write_cycles_since_delegate_call_ += integral_cycles;
-		if(transmission_extra_) {
-			transmission_extra_ -= integral_cycles;
-			if(transmission_extra_ <= 0) {
-				transmission_extra_ = 0;
-				if constexpr (!include_clock) {
-					update_delegate(level_);
-				}
-			}
-		}
-	} else {
-		while(!events_.empty()) {
-			if(events_.front().delay <= integral_cycles) {
-				cycles -= events_.front().delay;
-				write_cycles_since_delegate_call_ += events_.front().delay;
+	if(!events_.empty()) {
+		while(next_event_ != events_.size()) {
+			auto &event = events_[next_event_];
+			if(event.delay <= integral_cycles) {
+				integral_cycles -= event.delay;
+				write_cycles_since_delegate_call_ += event.delay;
 				const auto old_level = level_;
 
-				auto iterator = events_.begin() + 1;
-				while(iterator != events_.end() && iterator->type != Event::Delay) {
-					level_ = iterator->type == Event::SetHigh;
+				++next_event_;
+				while(next_event_ != events_.size() && events_[next_event_].type != Event::Delay) {
+					level_ = events_[next_event_].type == Event::SetHigh;
 					if constexpr(include_clock) {
 						update_delegate(level_);
 					}
-					++iterator;
+					++next_event_;
+				}
+
+				// Consumed events are retained until all have been consumed, to avoid
+				// repeatedly shuffling the remainder down.
+				if(next_event_ == events_.size()) {
+					events_.clear();
+					next_event_ = 0;
 				}
-				events_.erase(events_.begin(), iterator);
 
 				if constexpr (!include_clock) {
 					if(old_level != level_) {
@@ -64,9 +91,21 @@ void Line<include_clock>::advance_writer(HalfCycles cycles) {
 					transmission_extra_ = minimum_write_cycles_for_read_delegate_bit();
 				}
 			} else {
-				events_.front().delay -= integral_cycles;
+				event.delay -= integral_cycles;
 				write_cycles_since_delegate_call_ += integral_cycles;
-				break;
+				return;
+			}
+		}
+	}
+
+	// Any time after the final event runs down the period allowed for the read delegate's final bit.
+	write_cycles_since_delegate_call_ += integral_cycles;
+	if(transmission_extra_ && integral_cycles) {
+		transmission_extra_ -= integral_cycles;
+		if(transmission_extra_ <= 0) {
+			transmission_extra_ = 0;
+			if constexpr (!include_clock) {
+				update_delegate(level_);
 			}
 		}
 	}
@@ -121,6 +160,7 @@ template <bool include_clock>
 void Line<include_clock>::reset_writing() {
 	remaining_delays_ = 0;
 	events_.clear();
+	next_event_ = 0;
 }
 
 template <bool include_clock>
@@ -133,8 +173,8 @@ void Line<include_clock>::set_read_delegate(ReadDelegate *delegate, Storage::Tim
 	read_delegate_ = delegate;
 	if constexpr (!include_clock) {
 		assert(bit_length > Storage::Time(0));
-		read_delegate_bit_length_ = bit_length;
-		read_delegate_bit_length_.simplify();
+		bit_length.simplify();
+		set_read_timing(bit_length, clock_rate_);
 		write_cycles_since_delegate_call_ = 0;
 	}
 }
@@ -153,17 +193,35 @@ void Line<include_clock>::update_delegate(bool level) {
 		// Deal with a transition out of waiting-for-zero mode by seeding time left
 		// in bit at half a bit.
 		if(read_delegate_phase_ == ReadDelegatePhase::WaitingForZero) {
-			time_left_in_bit_ = read_delegate_bit_length_;
-			time_left_in_bit_.clock_rate <<= 1;
+			is_counting_half_cycles_ = read_delegate_bit_half_cycles_ != 0;
+			if(is_counting_half_cycles_) {
+				half_cycles_left_in_bit_ = read_delegate_bit_half_cycles_ >> 1;
+			} else {
+				time_left_in_bit_ = read_delegate_bit_length_;
+				time_left_in_bit_.clock_rate <<= 1;
+			}
 			read_delegate_phase_ = ReadDelegatePhase::Serialising;
 		}
 
 		// Forward as many bits as occur.
-		Storage::Time time_left(cycles_to_forward, int(clock_rate_.as_integral()));
 		const int bit = level ? 1 : 0;
-		int bits = 0;
+		if(is_counting_half_cycles_) {
+			auto half_cycles_left = HalfCycles::IntType(cycles_to_forward) * 2;
+			while(half_cycles_left >= half_cycles_left_in_bit_) {
+				if(!read_delegate_->serial_line_did_produce_bit(this, bit)) {
+					read_delegate_phase_ = ReadDelegatePhase::WaitingForZero;
+					if(bit) return;
+				}
+
+				half_cycles_left -= half_cycles_left_in_bit_;
+				half_cycles_left_in_bit_ = read_delegate_bit_half_cycles_;
+			}
+			half_cycles_left_in_bit_ -= half_cycles_left;
+			return;
+		}
+
+		Storage::Time time_left(cycles_to_forward, int(clock_rate_.as_integral()));
 		while(time_left >= time_left_in_bit_) {
-			++bits;
 			if(!read_delegate_->serial_line_did_produce_bit(this, bit)) {
 				read_delegate_phase_ = ReadDelegatePhase::WaitingForZero;
 				if(bit) return;
@@ -115,6 +115,7 @@ template <bool include_clock> class Line {
 			int delay;
 		};
 		std::vector<Event> events_;
+		size_t next_event_ = 0;		// Events before this index have been consumed; the vector is cleared once all have been.
 		HalfCycles::IntType remaining_delays_ = 0;
 		HalfCycles::IntType transmission_extra_ = 0;
 		bool level_ = true;
@@ -123,6 +124,14 @@ template <bool include_clock> class Line {
 		ReadDelegate *read_delegate_ = nullptr;
 		Storage::Time read_delegate_bit_length_, time_left_in_bit_;
 		int write_cycles_since_delegate_call_ = 0;
+
+		// If the read delegate's bit length is a whole number of writer cycles then bits are timed in integral
+		// half-cycles rather than via Storage::Time. Which is in use is decided at the start of each serialisation.
+		HalfCycles::IntType read_delegate_bit_half_cycles_ = 0;		// 0 if the bit length isn't a whole number of cycles.
+		HalfCycles::IntType half_cycles_left_in_bit_ = 0;
+		bool is_counting_half_cycles_ = false;
+		void set_read_timing(Storage::Time bit_length, HalfCycles clock_rate);
+
 		enum class ReadDelegatePhase {
 			WaitingForZero,
 			Serialising
@@ -12,9 +12,13 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <optional>
 #include <thread>
 #include <vector>
 
+#include "SPSCTaskBuffer.hpp"
+#include "ThreadPlacement.hpp"
+#include "WorkStealingPool.hpp"
 #include "../ClockReceiver/TimeTypes.hpp"
 
 namespace Concurrency {
@@ -54,7 +58,10 @@ template <> struct TaskQueueStorage<void> {
 	at the cost of thread synchronisation.
 
 	If @c perform_automatically is false, functions will be queued up but not dispatched
-	until a call to perform().
+	until a call to perform(). Such queues must be fed by only a single thread at a time; in return
+	small functions are stored in a lock-free, fixed-capacity buffer without allocation. Larger functions,
+	or any that arrive while that buffer is full, fall back upon a mutex-guarded list. Ordering is
+	preserved regardless.
 
 	If a @c Performer type is supplied then a public member, @c performer will be constructed
 	with the arguments supplied to TaskQueue's constructor. That instance will receive calls of the
@@ -64,11 +71,26 @@ template <> struct TaskQueueStorage<void> {
 	@note Even if @c perform_automatically is true, actions may be batched, when a long-running
 	action occupies the asynchronous thread for long enough. So it is not true that @c perform will be
 	called once per action.
+
+	If a WorkStealingPool is attached to the constructing thread then no thread is created; actions
+	are instead performed, still serially, by whichever of the pool's workers is available.
+	Otherwise a ThreadRole may be supplied as the first constructor argument, and the queue's thread
+	will adopt that role's placement.
 */
 template <bool perform_automatically, bool start_immediately = true, typename Performer = void> class AsyncTaskQueue: public TaskQueueStorage<Performer> {
 	public:
 		template <typename... Args> AsyncTaskQueue(Args&&... args) :
-			TaskQueueStorage<Performer>(std::forward<Args>(args)...) {
+			TaskQueueStorage<Performer>(std::forward<Args>(args)...),
+			pool_(WorkStealingPool::attached_pool()) {
+			if constexpr (start_immediately) {
+				start();
+			}
+		}
+
+		template <typename... Args> AsyncTaskQueue(ThreadRole role, Args&&... args) :
+			TaskQueueStorage<Performer>(std::forward<Args>(args)...),
+			pool_(WorkStealingPool::attached_pool()),
+			role_(role) {
 			if constexpr (start_immediately) {
 				start();
 			}
@@ -84,20 +106,50 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		/// If this TaskQueue has a @c Performer then the action will be performed
 		/// on the same thread as the performer, after the performer has been updated
 		/// to 'now'.
-		void enqueue(const std::function<void(void)> &post_action) {
+		template <typename Func> void enqueue(Func &&post_action) {
+			if constexpr (!perform_automatically && Buffer::template fits<Func>) {
+				// Once anything has spilled, further actions go to the same place until
+				// the consumer has caught up, to preserve ordering.
+				if(!has_spilled_.load(std::memory_order_acquire) && buffer_.push(std::forward<Func>(post_action))) {
+					return;
+				}
+			}
+
 			std::lock_guard guard(condition_mutex_);
-			actions_.push_back(post_action);
+			actions_.emplace_back(std::forward<Func>(post_action));
 
 			if constexpr (perform_automatically) {
-				condition_.notify_all();
+				if(pool_) {
+					schedule_on_pool();
+				} else {
+					condition_.notify_all();
+				}
+			} else {
+				has_spilled_.store(true, std::memory_order_release);
 			}
 		}
 
 		/// Causes any enqueued actions that are not yet scheduled to be scheduled.
 		void perform() {
-			if(actions_.empty()) {
+			if(pool_) {
+				std::lock_guard guard(condition_mutex_);
+				if(!has_pending()) {
+					return;
+				}
+				perform_requested_ = true;
+				schedule_on_pool();
 				return;
 			}
+
+			if(!has_pending()) {
+				return;
+			}
+
+			// Take the mutex only momentarily, to ensure that the worker is either already
+			// waiting or has yet to test for pending work.
+			{
+				std::lock_guard guard(condition_mutex_);
+			}
 			condition_.notify_all();
 		}
 
@@ -106,6 +158,15 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		///
 		/// The queue cannot be restarted; this is a destructive action.
 		void stop() {
+			if(pool_) {
+				perform();
+				pool_->wait_until([this] { return !is_scheduled_; });
+
+				// Acquire the mutex once to ensure the final drain has fully released it.
+				std::lock_guard guard(condition_mutex_);
+				return;
+			}
+
 			if(thread_.joinable()) {
 				should_quit_ = true;
 				enqueue([] {});
@@ -120,28 +181,30 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		///
 		/// This is not guaranteed safely to restart a stopped queue.
 		void start() {
+			if(pool_) {
+				return;
+			}
+
 			thread_ = std::move(std::thread{
 				[this] {
-					ActionVector actions;
-
-					// Continue until told to quit.
-					while(!should_quit_) {
-						// Wait for new actions to be signalled, and grab them.
-						std::unique_lock lock(condition_mutex_);
-						while(actions_.empty()) {
-							condition_.wait(lock);
+					if(role_) {
+						ApplyThreadPlacement(*role_);
+					}
+
+					while(true) {
+						// Wait for new actions to be signalled.
+						{
+							std::unique_lock lock(condition_mutex_);
+							condition_.wait(lock, [this] { return has_pending(); });
 						}
-						std::swap(actions, actions_);
-						lock.unlock();
 
-						// Update to now (which is possibly a no-op).
-						TaskQueueStorage<Performer>::update();
+						perform_pending();
 
-						// Perform the actions and destroy them.
-						for(const auto &action: actions) {
-							action();
+						// Continue until told to quit, and nothing remains.
+						if(should_quit_) {
+							std::lock_guard guard(condition_mutex_);
+							if(!has_pending()) break;
 						}
-						actions.clear();
 					}
 				}
 			});
@@ -150,6 +213,16 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		/// Schedules any remaining unscheduled work, then blocks synchronously
 		/// until all scheduled work has been performed.
 		void flush() {
+			if(pool_) {
+				std::atomic<bool> has_run = false;
+				enqueue([&has_run] {
+					has_run = true;
+				});
+				perform();
+				pool_->wait_until([&has_run] { return bool(has_run); });
+				return;
+			}
+
 			std::mutex flush_mutex;
 			std::condition_variable flush_condition;
 			bool has_run = false;
@@ -178,6 +251,18 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		using ActionVector = std::vector<std::function<void(void)>>;
 		ActionVector actions_;
 
+		// Storage for small actions on queues that aren't performed automatically;
+		// has_spilled_ is set whenever actions_ is non-empty for such a queue.
+		struct NoBuffer {
+			template <typename Func> static constexpr bool fits = false;
+			size_t end() const { return 0; }
+			bool empty() const { return true; }
+			void perform_until(size_t) {}
+		};
+		using Buffer = std::conditional_t<perform_automatically, NoBuffer, SPSCTaskBuffer<512, 48>>;
+		Buffer buffer_;
+		std::atomic<bool> has_spilled_ = false;
+
 		// Necessary synchronisation parts.
 		std::atomic<bool> should_quit_ = false;
 		std::mutex condition_mutex_;
@@ -186,6 +271,66 @@ template <bool perform_automatically, bool start_immediately = true, typename Pe
 		// Ensure the thread isn't constructed until after the mutex
 		// and condition variable.
 		std::thread thread_;
+
+		// If this queue performs on a pool, a single drain task is scheduled at a time.
+		// Both flags are modified only while holding condition_mutex_.
+		WorkStealingPool *const pool_;
+		std::atomic<bool> is_scheduled_ = false;
+
+		// The role adopted by thread_, if any.
+		const std::optional<ThreadRole> role_{};
+		bool perform_requested_ = false;
+
+		/// @returns @c true if any actions are waiting; this is exact only if called with condition_mutex_ held.
+		bool has_pending() const {
+			if constexpr (perform_automatically) {
+				return !actions_.empty();
+			} else {
+				return !buffer_.empty() || has_spilled_.load(std::memory_order_acquire);
+			}
+		}
+
+		/// Performs all currently-pending actions; this should be called only by the consumer.
+		void perform_pending() {
+			// Anything in the buffer prior to its current end was enqueued before anything in actions_.
+			ActionVector actions;
+			size_t buffer_end;
+			{
+				std::lock_guard guard(condition_mutex_);
+				buffer_end = buffer_.end();
+				std::swap(actions, actions_);
+				has_spilled_.store(false, std::memory_order_release);
+				perform_requested_ = false;
+			}
+
+			// Update to now (which is possibly a no-op).
+			TaskQueueStorage<Performer>::update();
+
+			// Perform the actions and destroy them.
+			buffer_.perform_until(buffer_end);
+			for(const auto &action: actions) {
+				action();
+			}
+		}
+
+		void schedule_on_pool() {
+			if(is_scheduled_) return;
+			is_scheduled_ = true;
+			pool_->submit([this] { drain_on_pool(); });
+		}
+
+		void drain_on_pool() {
+			perform_pending();
+
+			// Reschedule if more work became due while performing; resubmitting
+			// rather than looping gives other tasks on this worker a turn.
+			std::lock_guard guard(condition_mutex_);
+			if(has_pending() && (perform_automatically || perform_requested_)) {
+				pool_->submit([this] { drain_on_pool(); });
+			} else {
+				is_scheduled_ = false;
+			}
+		}
 };
 
 }
@@ -0,0 +1,103 @@
+//
+//  SPSCRing.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SPSCRing_hpp
+#define SPSCRing_hpp
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace Concurrency {
+
+/*!
+	A lock-free, fixed-capacity ring of trivially-copyable values, for use by exactly one producer
+	thread and one consumer thread; e.g. to pass audio from an emulation thread to a realtime audio
+	callback without either ever waiting for the other.
+
+	Values are pushed in whole runs only, so a consumer that always reads and discards multiples of
+	some frame size will never see a partial frame provided that every push is also such a multiple.
+*/
+template <typename T, size_t capacity> class SPSCRing {
+	static_assert(!(capacity & (capacity - 1)), "Capacity must be a power of two");
+	static_assert(std::is_trivially_copyable_v<T>);
+
+	public:
+		// MARK: - Producer.
+
+		/*!
+			Appends all @c count values from @c data. This may be called only by the producer.
+
+			@returns @c true if the values were stored; @c false if there was insufficient space, in which case nothing is stored.
+		*/
+		bool push(const T *data, size_t count) {
+			const size_t write = write_.load(std::memory_order_relaxed);
+			if(capacity - (write - read_.load(std::memory_order_acquire)) < count) {
+				return false;
+			}
+
+			const size_t offset = write & (capacity - 1);
+			const size_t first_length = std::min(count, capacity - offset);
+			std::memcpy(&buffer_[offset], data, first_length * sizeof(T));
+			std::memcpy(&buffer_[0], &data[first_length], (count - first_length) * sizeof(T));
+
+			write_.store(write + count, std::memory_order_release);
+			return true;
+		}
+
+		// MARK: - Either thread.
+
+		/// @returns The number of values currently waiting to be read; from the producer this is an upper bound, from the consumer a lower bound.
+		size_t size() const {
+			const size_t read = read_.load(std::memory_order_acquire);
+			return write_.load(std::memory_order_acquire) - read;
+		}
+
+		// MARK: - Consumer.
+
+		/*!
+			Copies up to @c count of the oldest values to @c data and removes them. This may be called only by the consumer.
+
+			@returns The number of values copied.
+		*/
+		size_t pop(T *data, size_t count) {
+			const size_t read = read_.load(std::memory_order_relaxed);
+			count = std::min(count, write_.load(std::memory_order_acquire) - read);
+
+			const size_t offset = read & (capacity - 1);
+			const size_t first_length = std::min(count, capacity - offset);
+			std::memcpy(data, &buffer_[offset], first_length * sizeof(T));
+			std::memcpy(&data[first_length], &buffer_[0], (count - first_length) * sizeof(T));
+
+			read_.store(read + count, std::memory_order_release);
+			return count;
+		}
+
+		/// Discards the oldest values until no more than @c count remain. This may be called only by the consumer.
+		void discard_to(size_t count) {
+			const size_t read = read_.load(std::memory_order_relaxed);
+			const size_t write = write_.load(std::memory_order_acquire);
+			if(write - read > count) {
+				read_.store(write - count, std::memory_order_release);
+			}
+		}
+
+	private:
+		std::array<T, capacity> buffer_;
+
+		// Kept on separate cache lines, to avoid false sharing between producer and consumer.
+		alignas(64) std::atomic<size_t> write_ = 0;
+		alignas(64) std::atomic<size_t> read_ = 0;
+};
+
+}
+
+#endif /* SPSCRing_hpp */
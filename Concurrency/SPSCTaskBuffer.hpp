@@ -0,0 +1,113 @@
+//
+//  SPSCTaskBuffer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SPSCTaskBuffer_hpp
+#define SPSCTaskBuffer_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Concurrency {
+
+/*!
+	A lock-free, fixed-capacity ring of @c void(void) callables, for use by exactly one producer
+	thread and one consumer thread.
+
+	Callables are stored in place, without heap allocation, so only those no larger than
+	@c slot_size and with no more than fundamental alignment can be accepted; test via @c fits.
+*/
+template <size_t capacity, size_t slot_size> class SPSCTaskBuffer {
+	static_assert(!(capacity & (capacity - 1)), "Capacity must be a power of two");
+
+	public:
+		/// Indicates whether a callable of type @c Func can be stored by this buffer.
+		template <typename Func> static constexpr bool fits =
+			sizeof(std::decay_t<Func>) <= slot_size &&
+			alignof(std::decay_t<Func>) <= alignof(std::max_align_t);
+
+		~SPSCTaskBuffer() {
+			// Destroy, without performing, anything that remains.
+			size_t read = read_.load(std::memory_order_relaxed);
+			const size_t write = write_.load(std::memory_order_acquire);
+			while(read != write) {
+				Slot &slot = slots_[read & (capacity - 1)];
+				slot.perform(slot.storage, false);
+				++read;
+			}
+		}
+
+		// MARK: - Producer.
+
+		/*!
+			Attempts to append @c func. This may be called only by the producer.
+
+			@returns @c true if @c func was stored; @c false if the buffer is full, in which case @c func is untouched.
+		*/
+		template <typename Func> bool push(Func &&func) {
+			static_assert(fits<Func>);
+			using Stored = std::decay_t<Func>;
+
+			const size_t write = write_.load(std::memory_order_relaxed);
+			if(write - read_.load(std::memory_order_acquire) == capacity) {
+				return false;
+			}
+
+			Slot &slot = slots_[write & (capacity - 1)];
+			new (slot.storage) Stored(std::forward<Func>(func));
+			slot.perform = [] (void *storage, bool invoke) {
+				Stored *const stored = std::launder(reinterpret_cast<Stored *>(storage));
+				if(invoke) (*stored)();
+				stored->~Stored();
+			};
+
+			write_.store(write + 1, std::memory_order_release);
+			return true;
+		}
+
+		// MARK: - Consumer.
+
+		/// @returns An index marking the current end of the buffer, for use with @c perform_until.
+		size_t end() const {
+			return write_.load(std::memory_order_acquire);
+		}
+
+		/// @returns @c true if there is nothing waiting to be performed.
+		bool empty() const {
+			return read_.load(std::memory_order_acquire) == end();
+		}
+
+		/// Performs, in order, and then destroys every callable that was pushed prior to @c end being obtained.
+		void perform_until(size_t end) {
+			size_t read = read_.load(std::memory_order_relaxed);
+			while(read != end) {
+				Slot &slot = slots_[read & (capacity - 1)];
+				slot.perform(slot.storage, true);
+				++read;
+				read_.store(read, std::memory_order_release);
+			}
+		}
+
+	private:
+		struct Slot {
+			alignas(std::max_align_t) unsigned char storage[slot_size];
+			void (*perform)(void *, bool);
+		};
+		std::array<Slot, capacity> slots_;
+
+		// Kept on separate cache lines, to avoid false sharing between producer and consumer.
+		alignas(64) std::atomic<size_t> write_ = 0;
+		alignas(64) std::atomic<size_t> read_ = 0;
+};
+
+}
+
+#endif /* SPSCTaskBuffer_hpp */
@@ -0,0 +1,197 @@
+//
+//  ThreadPlacement.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ThreadPlacement_hpp
+#define ThreadPlacement_hpp
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <sys/qos.h>
+#endif
+
+namespace Concurrency {
+
+/// The purposes for which threads are created; each can be given its own placement.
+enum class ThreadRole {
+	/// Threads that run machines: WorkStealingPool workers and hosts' emulation threads.
+	Emulation,
+	/// Threads that generate or consume audio: speakers' task queues and hosts' audio callbacks.
+	Audio,
+	/// Threads that perform media updates, e.g. writing back disk tracks.
+	Storage,
+};
+
+enum class ThreadPriority {
+	Default,
+	/// Above normal; on Linux this is a negative nice value, which may require privileges.
+	Elevated,
+	/// Real-time scheduling where permitted, falling back to Elevated.
+	Realtime,
+};
+
+struct ThreadPlacement {
+	/// The cores that threads in this role may use; if empty then any.
+	std::vector<int> cores;
+	ThreadPriority priority = ThreadPriority::Default;
+};
+
+namespace Placement {
+
+constexpr size_t RoleCount = 3;
+
+struct Store {
+	std::mutex mutex;
+	std::array<ThreadPlacement, RoleCount> placements;
+};
+
+inline Store &store() {
+	static Store store;
+	return store;
+}
+
+}
+
+/// Sets the placement of all threads subsequently started in @c role; existing threads are unaffected,
+/// so this should be called before any machine is created.
+inline void SetThreadPlacement(ThreadRole role, const ThreadPlacement &placement) {
+	auto &store = Placement::store();
+	std::lock_guard lock(store.mutex);
+	store.placements[size_t(role)] = placement;
+}
+
+/// @returns The current placement for @c role.
+inline ThreadPlacement GetThreadPlacement(ThreadRole role) {
+	auto &store = Placement::store();
+	std::lock_guard lock(store.mutex);
+	return store.placements[size_t(role)];
+}
+
+/*!
+	Applies the placement for @c role to the calling thread, as far as the host permits;
+	anything not permitted is silently skipped.
+
+	If @c index is supplied then the thread is pinned to a single core from the role's set, selected
+	round-robin by index, so that each of a group of threads stays with its own caches.
+	Otherwise it may use any core in the set.
+*/
+inline void ApplyThreadPlacement(ThreadRole role, std::ptrdiff_t index = -1) {
+	const ThreadPlacement placement = GetThreadPlacement(role);
+
+#if defined(__linux__)
+	if(!placement.cores.empty()) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if(index >= 0) {
+			const int core = placement.cores[size_t(index) % placement.cores.size()];
+			if(core < CPU_SETSIZE) CPU_SET(core, &set);
+		} else {
+			for(const int core: placement.cores) {
+				if(core < CPU_SETSIZE) CPU_SET(core, &set);
+			}
+		}
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+
+	// Nice values are per thread on Linux, addressed by thread ID.
+	const auto elevate = [] {
+		setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), -10);
+	};
+	switch(placement.priority) {
+		case ThreadPriority::Default: break;
+		case ThreadPriority::Elevated:
+			elevate();
+		break;
+		case ThreadPriority::Realtime: {
+			sched_param parameters{};
+			parameters.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+			if(pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters)) {
+				elevate();
+			}
+		} break;
+	}
+#elif defined(__APPLE__)
+	// macOS offers no hard affinity; it does offer quality-of-service classes.
+	(void)index;
+	switch(placement.priority) {
+		case ThreadPriority::Default: break;
+		case ThreadPriority::Elevated:
+		case ThreadPriority::Realtime:
+			pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+		break;
+	}
+#else
+	(void)placement;
+	(void)index;
+#endif
+}
+
+/*!
+	Parses a comma-separated list of cores and core ranges, e.g. "0,2,4-7", into @c cores.
+
+	@returns @c true on success; @c false if @c list is malformed, in which case @c cores is unaltered.
+*/
+inline bool ParseCores(const std::string &list, std::vector<int> &cores) {
+	std::vector<int> result;
+	size_t position = 0;
+	while(position < list.size()) {
+		size_t end = list.find(',', position);
+		if(end == std::string::npos) end = list.size();
+		const std::string entry = list.substr(position, end - position);
+		position = end + 1;
+
+		const auto dash = entry.find('-');
+		try {
+			size_t used;
+			const int first = std::stoi(entry, &used);
+			if(used != (dash == std::string::npos ? entry.size() : dash) || first < 0) return false;
+			int last = first;
+			if(dash != std::string::npos) {
+				const std::string tail = entry.substr(dash + 1);
+				last = std::stoi(tail, &used);
+				if(used != tail.size() || last < first) return false;
+			}
+			for(int core = first; core <= last; ++core) {
+				result.push_back(core);
+			}
+		} catch(...) {
+			return false;
+		}
+	}
+
+	if(result.empty()) return false;
+	cores = std::move(result);
+	return true;
+}
+
+/*!
+	Parses @c name, one of "default", "elevated" or "realtime", into @c priority.
+
+	@returns @c true on success; @c false if @c name is unrecognised, in which case @c priority is unaltered.
+*/
+inline bool ParsePriority(const std::string &name, ThreadPriority &priority) {
+	if(name == "default")	{ priority = ThreadPriority::Default;	return true; }
+	if(name == "elevated")	{ priority = ThreadPriority::Elevated;	return true; }
+	if(name == "realtime")	{ priority = ThreadPriority::Realtime;	return true; }
+	return false;
+}
+
+}
+
+#endif /* ThreadPlacement_hpp */
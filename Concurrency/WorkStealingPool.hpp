@@ -0,0 +1,212 @@
+//
+//  WorkStealingPool.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef WorkStealingPool_hpp
+#define WorkStealingPool_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ThreadPlacement.hpp"
+
+namespace Concurrency {
+
+/*!
+	A fixed-size pool of worker threads, each with its own queue of tasks.
+
+	Tasks submitted from a worker are placed at the back of that worker's own queue and
+	are taken from the back by it; a worker that runs out of tasks steals from the front
+	of the other queues. Tasks submitted from any other thread are distributed round robin.
+
+	No guarantees are made about ordering; anything that needs serial execution should
+	use an AsyncTaskQueue, which will perform on a pool if one is attached at its construction.
+*/
+class WorkStealingPool {
+	public:
+		/// Creates a pool with @c threads workers; if @c threads is 0 then the pool is sized to the host.
+		/// Each worker adopts the placement for @c role, pinned to its own core if the role nominates any.
+		WorkStealingPool(size_t threads = 0, ThreadRole role = ThreadRole::Emulation) {
+			if(!threads) threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+			for(size_t c = 0; c < threads; ++c) {
+				workers_.emplace_back(std::make_unique<Worker>());
+			}
+			for(size_t c = 0; c < threads; ++c) {
+				threads_.emplace_back([this, c, role] {
+					ApplyThreadPlacement(role, std::ptrdiff_t(c));
+					run(c);
+				});
+			}
+		}
+
+		/// Performs all outstanding tasks, then stops all workers.
+		~WorkStealingPool() {
+			{
+				std::lock_guard lock(sleep_mutex_);
+				should_quit_ = true;
+			}
+			wake_.notify_all();
+			for(auto &thread: threads_) {
+				thread.join();
+			}
+		}
+
+		/// @returns The number of worker threads.
+		size_t size() const {
+			return workers_.size();
+		}
+
+		/// Schedules @c task to be performed on a worker thread at some point in the future.
+		void submit(std::function<void(void)> &&task) {
+			const size_t index = (worker_pool_ == this) ?
+				worker_index_ :
+				next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+			// Count the task before it becomes visible so that pending_ can't underflow;
+			// at worst a woken worker briefly finds nothing to take.
+			{
+				std::lock_guard lock(sleep_mutex_);
+				++pending_;
+			}
+
+			{
+				std::lock_guard lock(workers_[index]->mutex);
+				workers_[index]->tasks.push_back(std::move(task));
+			}
+			wake_.notify_one();
+		}
+
+		/*!
+			Blocks until @c predicate returns @c true. If called from one of this pool's workers then
+			other tasks are performed while waiting, so that a worker can safely wait upon work
+			that is itself queued on the pool.
+
+			@c predicate is re-evaluated at least whenever any task completes.
+		*/
+		template <typename Predicate> void wait_until(Predicate predicate) {
+			if(worker_pool_ == this) {
+				while(!predicate()) {
+					if(!perform_one(worker_index_)) {
+						std::this_thread::yield();
+					}
+				}
+				return;
+			}
+
+			std::unique_lock lock(completion_mutex_);
+			completion_.wait(lock, predicate);
+		}
+
+		/*!
+			@returns The pool that any AsyncTaskQueue created on the calling thread should perform on,
+			or @c nullptr if such queues should create threads of their own. This is the pool of which the
+			calling thread is a worker, if any, or otherwise the pool most recently attached via an
+			AttachmentScope that is still in effect.
+		*/
+		static WorkStealingPool *attached_pool() {
+			return worker_pool_ ? worker_pool_ : attached_pool_;
+		}
+
+		/// While in scope, causes attached_pool() to return the nominated pool on the current thread.
+		class AttachmentScope {
+			public:
+				AttachmentScope(WorkStealingPool *pool) : previous_(attached_pool_) {
+					attached_pool_ = pool;
+				}
+				~AttachmentScope() {
+					attached_pool_ = previous_;
+				}
+
+			private:
+				WorkStealingPool *const previous_;
+		};
+
+	private:
+		struct Worker {
+			std::mutex mutex;
+			std::deque<std::function<void(void)>> tasks;
+		};
+		std::vector<std::unique_ptr<Worker>> workers_;
+		std::vector<std::thread> threads_;
+		std::atomic<size_t> next_worker_ = 0;
+
+		// Guards pending_ and should_quit_, and is used by sleeping workers.
+		std::mutex sleep_mutex_;
+		std::condition_variable wake_;
+		size_t pending_ = 0;
+		bool should_quit_ = false;
+
+		// Used to wake any non-worker that is inside wait_until.
+		std::mutex completion_mutex_;
+		std::condition_variable completion_;
+
+		// The pool and index of the worker that is the current thread, if any.
+		static inline thread_local WorkStealingPool *worker_pool_ = nullptr;
+		static inline thread_local size_t worker_index_ = 0;
+		static inline thread_local WorkStealingPool *attached_pool_ = nullptr;
+
+		/// Takes a task from the back of worker @c index's queue or, failing that, from the front of any other.
+		/// @returns @c true if a task was obtained and performed; @c false otherwise.
+		bool perform_one(size_t index) {
+			std::function<void(void)> task;
+
+			for(size_t offset = 0; offset < workers_.size() && !task; ++offset) {
+				Worker &worker = *workers_[(index + offset) % workers_.size()];
+				std::lock_guard lock(worker.mutex);
+				if(worker.tasks.empty()) continue;
+
+				if(!offset) {
+					task = std::move(worker.tasks.back());
+					worker.tasks.pop_back();
+				} else {
+					task = std::move(worker.tasks.front());
+					worker.tasks.pop_front();
+				}
+			}
+			if(!task) return false;
+
+			{
+				std::lock_guard lock(sleep_mutex_);
+				--pending_;
+			}
+			task();
+
+			// Notify any external waiter; taking the lock ensures the notification
+			// can't fall between its test of the predicate and its wait.
+			{
+				std::lock_guard lock(completion_mutex_);
+			}
+			completion_.notify_all();
+			return true;
+		}
+
+		void run(size_t index) {
+			worker_pool_ = this;
+			worker_index_ = index;
+
+			while(true) {
+				if(perform_one(index)) continue;
+
+				std::unique_lock lock(sleep_mutex_);
+				if(!pending_ && should_quit_) break;
+				wake_.wait(lock, [this] { return pending_ || should_quit_; });
+				if(!pending_ && should_quit_) break;
+			}
+		}
+};
+
+}
+
+#endif /* WorkStealingPool_hpp */
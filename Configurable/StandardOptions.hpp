@@ -60,6 +60,39 @@ template <typename Owner> class QuickbootOption {
 		}
 };
 
+template <typename Owner> class FastCPUOption {
+	public:
+		bool fast_cpu;
+		FastCPUOption(bool fast_cpu) : fast_cpu(fast_cpu) {}
+
+	protected:
+		void declare_fast_cpu_option() {
+			static_cast<Owner *>(this)->declare(&fast_cpu, "fastcpu");
+		}
+};
+
+template <typename Owner> class FastDiskOption {
+	public:
+		bool fast_disk;
+		FastDiskOption(bool fast_disk) : fast_disk(fast_disk) {}
+
+	protected:
+		void declare_fast_disk_option() {
+			static_cast<Owner *>(this)->declare(&fast_disk, "fastdisk");
+		}
+};
+
+template <typename Owner> class FastMechanicsOption {
+	public:
+		bool fast_mechanics;
+		FastMechanicsOption(bool fast_mechanics) : fast_mechanics(fast_mechanics) {}
+
+	protected:
+		void declare_fast_mechanics_option() {
+			static_cast<Owner *>(this)->declare(&fast_mechanics, "fastmechanics");
+		}
+};
+
 }
 
 #endif /* StandardOptions_hpp */
@@ -11,13 +11,13 @@
 
 #include "../Numeric/Sizes.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
-#include <list>
-#include <map>
-#include <queue>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace InstructionSet {
 
@@ -29,6 +29,12 @@ namespace InstructionSet {
 	costs sit behind using the C ABI for calling. Since there'll always be exactly one parameter, being the specific executor,
 	hopefully the calling costs are acceptable.
 
+	Performers are cached as segments, each running from an entry point up to the first instruction that unconditionally
+	branches, and are retained until the memory they were decoded from is modified. Memory is divided into pages for that
+	purpose; specific executors should call @c note_write upon every write that could hit code, and @c invalidate_all upon
+	any wholesale change to memory. A write into the segment currently being executed takes effect from the
+	next instruction.
+
 	Intended usage is for specific executors to subclass from this and declare it a friend.
 
 	TODO: determine promises re: interruption, amongst other things.
@@ -50,20 +56,22 @@ template <
 		using PerformerIndex = typename MinIntTypeValue<max_performer_count>::type;
 		using ProgramCounterType = typename MinIntTypeValue<max_address>::type;
 
+		CachingExecutor() : page_flags_((max_address >> PageShift) + 1) {}
+
 		// MARK: - Parser call-ins.
 
 		void announce_overflow(ProgramCounterType) {
-			/*
-				Should be impossible for now; this is intended to provide information
-				when page caching.
-			*/
+			// The instruction at this address runs beyond max_address and so can't be cached;
+			// the segment under construction will end immediately before it.
+			building_->overflowed = true;
 		}
-		void announce_instruction(ProgramCounterType, InstructionType instruction) {
+		void announce_instruction(ProgramCounterType address, InstructionType instruction) {
 			// Dutifully map the instruction to a performer and keep it.
-			program_.push_back(static_cast<Executor *>(this)->action_for(instruction));
+			building_->performers.push_back(static_cast<Executor *>(this)->action_for(instruction));
+			building_->last_address = address;
 
 			if constexpr (retain_instructions) {
-				// TODO.
+				building_->instructions.push_back(instruction);
 			}
 		}
 
@@ -84,19 +92,63 @@ template <
 			// previously-parsed content.
 			has_branched_ = true;
 			program_counter_ = address;
-
-			// Temporary implementation: just interpret.
-			program_.clear();
 			program_index_ = 0;
+
+			// Discard anything that has been written over since the last branch.
+			if(!dirty_pages_.empty()) {
+				purge_dirty_pages();
+			}
+
+			// Use a cached segment if there is one; otherwise parse anew.
+			const auto existing = segments_.find(address);
+			if(existing != segments_.end()) {
+				current_ = &existing->second;
+				return;
+			}
+
+			building_ = current_ = &segments_[address];
+			building_->last_address = address;
 			static_cast<Executor *>(this)->parse(address, ProgramCounterType(max_address));
 
-//			const auto page = find_page(address);
-//			const auto entry = page->entry_points.find(address);
-//			if(entry == page->entry_points.end()) {
-//				// Requested segment wasn't found; check whether it was
-//				// within the recently translated list and otherwise
-//				// translate it.
-//			}
+			// Record the pages that this segment was decoded from, allowing for the final
+			// instruction to run on beyond its start address.
+			building_->first_page = size_t(std::min(uint64_t(address), max_address) >> PageShift);
+			building_->last_page = size_t(std::min(uint64_t(building_->last_address) + MaxInstructionLength - 1, max_address) >> PageShift);
+			for(size_t page = building_->first_page; page <= building_->last_page; page++) {
+				page_flags_[page] |= PageHasCode;
+				page_entries_[page].push_back(address);
+			}
+		}
+
+		/*!
+			Indicates that @c address has been written to, invalidating any cached performers
+			decoded from it. This is cheap if no code is cached from the page containing @c address.
+		*/
+		inline void note_write(ProgramCounterType address) {
+			const auto page = size_t(address >> PageShift);
+			if(page_flags_[page] != PageHasCode) return;
+
+			page_flags_[page] |= PageIsDirty;
+			dirty_pages_.push_back(page);
+
+			// If this write potentially modifies the code currently being run, re-decode from
+			// the next instruction.
+			if(current_ && page >= current_->first_page && page <= current_->last_page) {
+				has_branched_ = needs_resync_ = true;
+			}
+		}
+
+		/*!
+			Discards all cached performers, e.g. because memory has been wholesale replaced.
+			A call to @c set_program_counter is required before anything further is run.
+		*/
+		void invalidate_all() {
+			segments_.clear();
+			page_entries_.clear();
+			dirty_pages_.clear();
+			std::fill(page_flags_.begin(), page_flags_.end(), 0);
+			current_ = nullptr;
+			needs_resync_ = false;
 		}
 
 		/*!
@@ -106,16 +158,24 @@ template <
 		*/
 		void set_is_stopped(bool) {}
 
+		/*!
+			@returns The instruction that corresponds to the performer currently being run.
+			This is available only if @c retain_instructions is @c true.
+		*/
+		const InstructionType &instruction() const {
+			static_assert(retain_instructions);
+			return current_->instructions[program_index_ - 1];
+		}
+
 		/*!
 			Executes up to the next branch.
 		*/
 		void run_to_branch() {
+			if(needs_resync_) resync();
+
 			has_branched_ = false;
-			for(auto index: program_) {
-				const auto performer = performers_[index];
-				(static_cast<Executor *>(this)->*performer)();
-				if(has_branched_) break;
-			}
+			Executor *const executor = static_cast<Executor *>(this);
+			while(!has_branched_ && perform_next(executor));
 		}
 
 		/*!
@@ -126,14 +186,16 @@ template <
 		void run_for(int duration) {
 			remaining_duration_ += duration;
 
+			Executor *const executor = static_cast<Executor *>(this);
 			while(remaining_duration_ > 0) {
+				if(needs_resync_) resync();
+
 				has_branched_ = false;
-				Executor *const executor = static_cast<Executor *>(this);
 				while(remaining_duration_ > 0 && !has_branched_) {
-					const auto performer = performers_[program_[program_index_]];
-					++program_index_;
-
-					(executor->*performer)();
+					if(!perform_next(executor)) {
+						// Nothing further could be decoded; there's no way to proceed.
+						remaining_duration_ = 0;
+					}
 				}
 			}
 		}
@@ -146,53 +208,90 @@ template <
 			remaining_duration_ -= duration;
 		}
 
+		/*!
+			@returns The amount of time left to run in the current call to @c run_for.
+		*/
+		inline int remaining_duration() const {
+			return remaining_duration_;
+		}
+
 	private:
 		bool has_branched_ = false;
+		bool needs_resync_ = false;
 		int remaining_duration_ = 0;
-		std::vector<PerformerIndex> program_;
-		size_t program_index_ = 0;
-
-		/* TODO: almost below here can be shoved off into an LRUCache object, or similar. */
-
-//		static constexpr size_t max_cached_pages = 64;
 
-//		struct Page {
-//			std::map<ProgramCounterType, PerformerIndex> entry_points;
-
-			// TODO: can I statically these two? Should I?
-//			std::vector<PerformerIndex> actions_;
-//			std::vector<typename std::enable_if<!std::is_same<InstructionType, void>::value, InstructionType>::type> instructions_;
-//		};
-//		std::array<Page, max_cached_pages> pages_;
-
-		// Maps from page numbers to pages.
-//		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
-
-		// Maintains an LRU of recently-used pages in case of a need for reuse.
-//		std::list<ProgramCounterType> touched_pages_;
+		// Pages are 1kb; instructions are assumed to be no longer than 16 bytes for
+		// the purposes of determining which pages a segment was decoded from.
+		static constexpr int PageShift = 10;
+		static constexpr uint64_t MaxInstructionLength = 16;
+
+		struct NoInstructions {};
+		struct Segment {
+			std::vector<PerformerIndex> performers;
+			std::conditional_t<retain_instructions, std::vector<InstructionType>, NoInstructions> instructions;
+
+			ProgramCounterType last_address;
+			size_t first_page = 0, last_page = 0;
+			bool overflowed = false;
+		};
+
+		// All cached segments, by entry point; unordered_map guarantees that pointers to its
+		// values remain valid until erased, and segments are erased only within set_program_counter
+		// or invalidate_all.
+		std::unordered_map<ProgramCounterType, Segment> segments_;
+		Segment *current_ = nullptr;
+		Segment *building_ = nullptr;
+		size_t program_index_ = 0;
 
-		/*!
-			Finds or creates the page that contains @c address.
-		*/
-/*		Page *find_page(ProgramCounterType address) {
-			// TODO: are 1kb pages always appropriate? Is 64 the correct amount to keep?
-			const auto page_address = ProgramCounterType(address >> 10);
+		// Per-page flags, and a list of the entry points of all segments decoded from each page.
+		static constexpr uint8_t PageHasCode = 1;
+		static constexpr uint8_t PageIsDirty = 2;
+		std::vector<uint8_t> page_flags_;
+		std::unordered_map<size_t, std::vector<ProgramCounterType>> page_entries_;
+		std::vector<size_t> dirty_pages_;
+
+		/// Performs the next performer in the current segment, if there is one, moving on
+		/// to a new segment as required.
+		///
+		/// @returns @c false if there is nothing that can be performed.
+		inline bool perform_next(Executor *executor) {
+			if(program_index_ == current_->performers.size()) {
+				// The current segment ended without branching, which implies overflow.
+				// Attempt to continue from the current program counter.
+				set_program_counter(program_counter_);
+				if(current_->performers.empty()) return false;
+			}
 
-			auto page = cached_pages_.find(page_address);
-			if(page == cached_pages_.end()) {
-				// Page wasn't found; either allocate a new one or
-				// reuse one that already exists.
-				if(cached_pages_.size() == max_cached_pages) {
+			const auto performer = performers_[current_->performers[program_index_]];
+			++program_index_;
+			(executor->*performer)();
+			return true;
+		}
 
-				} else {
+		void resync() {
+			needs_resync_ = false;
+			set_program_counter(program_counter_);
+		}
 
+		void purge_dirty_pages() {
+			for(const auto page: dirty_pages_) {
+				const auto entries = page_entries_.find(page);
+				if(entries != page_entries_.end()) {
+					for(const auto entry: entries->second) {
+						const auto segment = segments_.find(entry);
+						if(segment == segments_.end()) continue;
+
+						// Other pages' lists may retain this entry point; that's harmless
+						// as it'll merely fail to be found if encountered again.
+						if(&segment->second == current_) current_ = nullptr;
+						segments_.erase(segment);
+					}
+					page_entries_.erase(entries);
 				}
-			} else {
-				// Page was found; LRU shuffle it.
+				page_flags_[page] = 0;
 			}
-
-			return nullptr;
-		}*/
+			dirty_pages_.clear();
+		}
 };
 
 }
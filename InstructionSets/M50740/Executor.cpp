@@ -47,6 +47,7 @@ void Executor::set_rom(const std::vector<uint8_t> &rom) {
 	// Copy into place, and reset.
 	const auto length = std::min(size_t(0x1000), rom.size());
 	memcpy(&memory_[0x2000 - length], rom.data(), length);
+	invalidate_all();
 	reset();
 }
 
@@ -99,6 +100,7 @@ uint8_t Executor::read(uint16_t address) {
 		case 0xe4: case 0xe8: {
 			const int port = port_remap[(address - 0xe0) >> 1];
 			const uint8_t input = port_handler_.get_port_input(port);
+			idle_loop_.reads_ports = true;
 
 			// In the direction registers, a 0 indicates input, a 1 indicates output.
 			return (input &~ port_directions_[port]) | (port_outputs_[port] & port_directions_[port]);
@@ -108,15 +110,16 @@ uint8_t Executor::read(uint16_t address) {
 		case 0xe5: case 0xe9:
 		return port_directions_[port_remap[(address - 0xe0) >> 1]];
 
-		// Timers.
-		case 0xf9:	return prescalers_[0].value;
-		case 0xfa:	return timers_[0].value;
-		case 0xfb:	return timers_[1].value;
-		case 0xfc:	return prescalers_[1].value;
-		case 0xfd:	return timers_[2].value;
-
-		case 0xfe:	return interrupt_control_;
-		case 0xff:	return timer_control_;
+		// Timers; current values change continuously, so can't be part of an idle loop, but
+		// flags change only upon underflow.
+		case 0xf9:	idle_loop_.is_candidate = false;	return prescalers_[0].value;
+		case 0xfa:	idle_loop_.is_candidate = false;	return timers_[0].value;
+		case 0xfb:	idle_loop_.is_candidate = false;	return timers_[1].value;
+		case 0xfc:	idle_loop_.is_candidate = false;	return prescalers_[1].value;
+		case 0xfd:	idle_loop_.is_candidate = false;	return timers_[2].value;
+
+		case 0xfe:	idle_loop_.reads_timer_flags = true;	return interrupt_control_;
+		case 0xff:	idle_loop_.reads_timer_flags = true;	return timer_control_;
 	}
 }
 
@@ -128,9 +131,12 @@ void Executor::set_port_output(int port) {
 void Executor::write(uint16_t address, uint8_t value) {
 	address &= 0x1fff;
 
-	// RAM writes are easy.
+	// RAM writes are easy. Those that don't change anything, e.g. stacking the same return
+	// address as last time, don't disqualify an idle loop.
 	if(address < 0x60) {
+		idle_loop_.is_candidate &= memory_[address] == value;
 		memory_[address] = value;
+		note_write(address);
 		return;
 	}
 
@@ -142,6 +148,7 @@ void Executor::write(uint16_t address, uint8_t value) {
 
 	// Push time to the port handler.
 	port_handler_.run_ports_for(cycles_since_port_handler_.flush<Cycles>());
+	idle_loop_.is_candidate = false;
 
 	switch(address) {
 		default:
@@ -429,7 +436,7 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 						if constexpr (operation >= Operation::BBS0 && operation <= Operation::BBS7) {
 							constexpr uint8_t mask = 1 << (int(operation) - int(Operation::BBS0));
 							if(value & mask) {
-								set_program_counter(uint16_t(address));
+								branch(uint16_t(address));
 								subtract_duration(2);
 							}
 						}
@@ -439,7 +446,7 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 						if constexpr (operation >= Operation::BBC0 && operation <= Operation::BBC7) {
 							constexpr uint8_t mask = 1 << (int(operation) - int(Operation::BBC0));
 							if(!(value & mask)) {
-								set_program_counter(uint16_t(address));
+								branch(uint16_t(address));
 								subtract_duration(2);
 							}
 						}
@@ -487,7 +494,7 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 	// Check for a branch; those don't go through the memory accesses below.
 	switch(operation) {
 		case Operation::BRA: case Operation::JMP:
-			set_program_counter(uint16_t(address));
+			branch(uint16_t(address));
 		return;
 
 		case Operation::JSR: {
@@ -498,7 +505,7 @@ template <Operation operation, AddressingMode addressing_mode> void Executor::pe
 			set_program_counter(uint16_t(address));
 		} return;
 
-#define Bcc(c)	if(c) { set_program_counter(uint16_t(address)); subtract_duration(2); } return
+#define Bcc(c)	if(c) { branch(uint16_t(address)); subtract_duration(2); } return
 		case Operation::BPL:	Bcc(!(negative_result_&0x80));
 		case Operation::BMI:	Bcc(negative_result_&0x80);
 		case Operation::BEQ:	Bcc(!zero_result_);
@@ -783,7 +790,12 @@ inline void Executor::subtract_duration(int duration) {
 
 	// Update count for potential port accesses.
 	cycles_since_port_handler_ += Cycles(duration);
+	idle_loop_.duration += duration;
 
+	update_timers(duration);
+}
+
+inline void Executor::update_timers(int duration) {
 	// Update timer 1 and 2 prescaler.
 	constexpr int t12_divider = 4;		// A divide by 4 has already been applied before counting instruction lengths; therefore
 										// this additional divide by 4 produces the correct net divide by 16.
@@ -820,14 +832,103 @@ inline void Executor::subtract_duration(int duration) {
 	}
 }
 
+bool Executor::timer_flags_are_stable_for(int duration) {
+	// Timers are updated in constant time regardless of duration, so just try it and then
+	// restore the original state. Flags are only ever set by time, so if they're the same at
+	// the end of the period then they were the same throughout.
+	const int timer_divider = timer_divider_;
+	Timer timers[3], prescalers[2];
+	std::copy(std::begin(timers_), std::end(timers_), std::begin(timers));
+	std::copy(std::begin(prescalers_), std::end(prescalers_), std::begin(prescalers));
+	const uint8_t interrupt_control = interrupt_control_, timer_control = timer_control_;
+
+	update_timers(duration);
+	const bool is_stable = interrupt_control == interrupt_control_ && timer_control == timer_control_;
+
+	timer_divider_ = timer_divider;
+	std::copy(std::begin(timers), std::end(timers), std::begin(timers_));
+	std::copy(std::begin(prescalers), std::end(prescalers), std::begin(prescalers_));
+	interrupt_control_ = interrupt_control;
+	timer_control_ = timer_control;
+
+	return is_stable;
+}
+
+// MARK: - Idle loop detection.
+
+inline void Executor::branch(uint16_t address) {
+	// Only backward branches can close a loop.
+	if(address < program_counter_) {
+		skip_idle_loop(address);
+	}
+	set_program_counter(address);
+}
+
+void Executor::skip_idle_loop(uint16_t address) {
+	// If this is a repeat of the previous backward branch, with the same register contents,
+	// and nothing in between either modified anything or read anything that might have
+	// changed, then the next iteration will be identical. So will every one after that,
+	// at least until the timer flags change.
+	if(
+		idle_loop_.is_candidate &&
+		idle_loop_.source == program_counter_ &&
+		idle_loop_.address == address &&
+		idle_loop_.a == a_ && idle_loop_.x == x_ && idle_loop_.y == y_ && idle_loop_.s == s_ &&
+		idle_loop_.flags == flags() &&
+		(!idle_loop_.reads_timer_flags || (
+			idle_loop_.interrupt_control == interrupt_control_ && idle_loop_.timer_control == timer_control_
+		)) &&
+		idle_loop_.duration > 0 &&
+		(!idle_loop_.reads_ports || port_handler_.get_port_inputs_are_static())
+	) {
+		const int duration = idle_loop_.duration;
+		int iterations = remaining_duration() / duration;
+
+		// If the loop is watching the timer flags, find the number of iterations that
+		// can pass without any change; the loop is at least three cycles long so there
+		// are never more than a few million to search.
+		if(idle_loop_.reads_timer_flags && iterations && !timer_flags_are_stable_for(iterations * duration)) {
+			int stable = 0;
+			while(stable + 1 < iterations) {
+				const int midpoint = (stable + iterations) >> 1;
+				if(timer_flags_are_stable_for(midpoint * duration)) {
+					stable = midpoint;
+				} else {
+					iterations = midpoint;
+				}
+			}
+			iterations = stable;
+		}
+
+		if(iterations) {
+			subtract_duration(iterations * duration);
+		}
+	}
+
+	// Take a new snapshot.
+	idle_loop_.source = program_counter_;
+	idle_loop_.address = address;
+	idle_loop_.a = a_;
+	idle_loop_.x = x_;
+	idle_loop_.y = y_;
+	idle_loop_.s = s_;
+	idle_loop_.flags = flags();
+	idle_loop_.interrupt_control = interrupt_control_;
+	idle_loop_.timer_control = timer_control_;
+	idle_loop_.duration = 0;
+	idle_loop_.is_candidate = true;
+	idle_loop_.reads_ports = idle_loop_.reads_timer_flags = false;
+}
+
 inline int Executor::update_timer(Timer &timer, int count) {
 	const int next_value = timer.value - count;
 	if(next_value < 0) {
-		// Determine how many reloads were required to get above zero.
+		// Determine how many reloads were required to get above zero; this is arranged so that
+		// the result is the same whether time is applied in one step or many.
 		const int reload_value = timer.reload_value ? timer.reload_value : 256;
-		const int underflow_count = 1 - next_value / reload_value;
-		timer.value = uint8_t((next_value % reload_value) + timer.reload_value);
-		return underflow_count;
+		const int overrun = -next_value - 1;
+		timer.value = uint8_t(reload_value - 1 - (overrun % reload_value));
+		return 1 + overrun / reload_value;
 	}
 	timer.value = uint8_t(next_value);
 	return 0;
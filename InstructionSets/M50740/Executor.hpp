@@ -28,6 +28,12 @@ struct PortHandler {
 	virtual void run_ports_for(Cycles) = 0;
 	virtual void set_port_output(int port, uint8_t value) = 0;
 	virtual uint8_t get_port_input(int port) = 0;
+
+	/// @returns @c true if port inputs can currently change only in response to port output;
+	/// @c false if they may also change with the passage of time.
+	virtual bool get_port_inputs_are_static() {
+		return false;
+	}
 };
 
 /*!
@@ -35,6 +41,11 @@ struct PortHandler {
 
 		* the instruction stream cannot run across any of the specialised IO addresses; and
 		* timing is correct to whole-opcode boundaries only.
+
+	Idle loops are detected and skipped: if an iteration of a loop leaves registers and memory
+	exactly as it found them, and read nothing that might have changed in the meantime, then
+	all further iterations will be identical up to whichever comes first of the next change
+	in the timer flags or the end of the current run.
 */
 class Executor: public CachingExecutor {
 	public:
@@ -151,6 +162,8 @@ class Executor: public CachingExecutor {
 		int timer_divider_ = 0;
 		Timer timers_[3], prescalers_[2];
 		inline int update_timer(Timer &timer, int count);
+		inline void update_timers(int duration);
+		bool timer_flags_are_stable_for(int duration);
 
 		// Interrupt and timer  control.
 		uint8_t interrupt_control_ = 0, timer_control_ = 0;
@@ -172,6 +185,23 @@ class Executor: public CachingExecutor {
 		Cycles cycles_since_port_handler_;
 		PortHandler &port_handler_;
 		inline void subtract_duration(int duration);
+
+		// MARK: - Idle loop detection.
+
+		/// A snapshot of state at the most recent backward branch, and a record
+		/// of what has happened since.
+		struct IdleLoop {
+			uint16_t source = 0, address = 0;
+			uint8_t a = 0, x = 0, y = 0, s = 0, flags = 0;
+			uint8_t interrupt_control = 0, timer_control = 0;
+			int duration = 0;
+
+			bool is_candidate = false;
+			bool reads_ports = false;
+			bool reads_timer_flags = false;
+		} idle_loop_;
+		inline void branch(uint16_t address);
+		void skip_idle_loop(uint16_t address);
 };
 
 }
@@ -13,6 +13,9 @@
 #include "Model.hpp"
 #include "../../Numeric/Sizes.hpp"
 
+#include <array>
+#include <memory>
+
 namespace InstructionSet {
 namespace M68k {
 
@@ -115,6 +118,37 @@ template <Model model> class Predecoder {
 		static constexpr Operation operation(OpT op);
 };
 
+/*!
+	Provides the same decoding as Predecoder, but by lookup into a table of all 65536 potential
+	instruction words. The table is built upon first use and shared by all instances for the same
+	model, so decoding subsequently costs only a single indexed load.
+*/
+template <Model model> class CachingPredecoder {
+	public:
+		CachingPredecoder() : table_(table()) {}
+
+		Preinstruction decode(uint16_t instruction) const {
+			return table_[instruction];
+		}
+
+	private:
+		using Table = std::array<Preinstruction, 65536>;
+		const Table &table_;
+
+		static const Table &table() {
+			// The table is built on the heap as it's rather large to risk on a thread's stack.
+			static const std::unique_ptr<const Table> table = [] {
+				auto table = std::make_unique<Table>();
+				Predecoder<model> decoder;
+				for(size_t c = 0; c < table->size(); c++) {
+					(*table)[c] = decoder.decode(uint16_t(c));
+				}
+				return table;
+			}();
+			return *table;
+		}
+};
+
 }
 }
 
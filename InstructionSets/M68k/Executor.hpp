@@ -81,7 +81,10 @@ template <Model model, typename BusHandler> class Executor {
 		/// Sets the current input interrupt level.
 		void set_interrupt_level(int);
 
-		// State for the executor is just the register set.
+		/// @returns @c true if a STOP has been executed and no interrupt has yet been accepted; @c false otherwise.
+		bool is_stopped() const;
+
+		// State for the executor is just the register set; setting state also ends any STOP.
 		RegisterSet get_state();
 		void set_state(const RegisterSet &);
 
@@ -152,7 +155,7 @@ template <Model model, typename BusHandler> class Executor {
 
 			private:
 				BusHandler &bus_handler_;
-				Predecoder<model> decoder_;
+				CachingPredecoder<model> decoder_;
 
 				struct EffectiveAddress {
 					CPU::SlicedInt32 value;
@@ -53,10 +53,15 @@ void Executor<model, BusHandler>::signal_bus_error(FunctionCode code, uint32_t a
 
 template <Model model, typename BusHandler>
 void Executor<model, BusHandler>::set_interrupt_level(int level) {
-	state_.interrupt_input_ = level;
+	state_.interrupt_input = level;
 	state_.stopped &= !state_.status.would_accept_interrupt(level);
 }
 
+template <Model model, typename BusHandler>
+bool Executor<model, BusHandler>::is_stopped() const {
+	return state_.stopped;
+}
+
 template <Model model, typename BusHandler>
 void Executor<model, BusHandler>::run_for_instructions(int count) {
 	if(state_.stopped) return;
@@ -137,6 +142,8 @@ void Executor<model, BusHandler>::set_state(const RegisterSet &state) {
 	state_.stack_pointers[0].l = state.user_stack_pointer;
 	state_.stack_pointers[1].l = state.supervisor_stack_pointer;
 	sp = state_.stack_pointers[state_.active_stack_pointer];
+
+	state_.stopped = false;
 }
 
 #undef Dn
@@ -8,11 +8,15 @@
 
 #include "Decoder.hpp"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 using namespace InstructionSet::PowerPC;
 
 namespace {
 
-template <Model model, bool validate_reserved_bits, Operation operation> Instruction instruction(uint32_t opcode, bool is_supervisor = false) {
+template <Model model, bool validate_reserved_bits> Instruction instruction(Operation operation, uint32_t opcode, bool is_supervisor = false) {
 	// If validation isn't required, there's nothing to do here.
 	if constexpr (!validate_reserved_bits) {
 		return Instruction(operation, opcode, is_supervisor);
@@ -21,6 +25,8 @@ template <Model model, bool validate_reserved_bits, Operation operation> Instruc
 	// Otherwise, validation depends on operation
 	// (and, in principle, processor model).
 	switch(operation) {
+		default: break;
+
 		case Operation::absx:		case Operation::clcs:
 		case Operation::nabsx:
 		case Operation::addmex:		case Operation::addzex:
@@ -240,10 +246,8 @@ template <Model model, bool validate_reserved_bits, Operation operation> Instruc
 	return Instruction(operation, opcode, is_supervisor);
 }
 
-}
-
 template <Model model, bool validate_reserved_bits>
-Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
+Instruction decode_exhaustively(uint32_t opcode) {
 	// Quick bluffer's guide to PowerPC instruction encoding:
 	//
 	// There is a six-bit field at the very top of the instruction.
@@ -263,16 +267,16 @@ Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
 	// currently check the value of reserved bits. That may need to change
 	// if/when I add support for extended instruction sets.
 
-#define Bind(mask, operation)				case mask: return instruction<model, validate_reserved_bits, Operation::operation>(opcode);
-#define BindSupervisor(mask, operation)		case mask: return instruction<model, validate_reserved_bits, Operation::operation>(opcode, true);
+#define Bind(mask, operation)				case mask: return instruction<model, validate_reserved_bits>(Operation::operation, opcode);
+#define BindSupervisor(mask, operation)		case mask: return instruction<model, validate_reserved_bits>(Operation::operation, opcode, true);
 #define BindConditional(condition, mask, operation)	\
 	case mask: \
-		if(condition(model)) return instruction<model, validate_reserved_bits, Operation::operation>(opcode);	\
-	return instruction<model, validate_reserved_bits, Operation::operation>(opcode);
+		if(condition(model)) return instruction<model, validate_reserved_bits>(Operation::operation, opcode);	\
+	return instruction<model, validate_reserved_bits>(Operation::operation, opcode);
 #define BindSupervisorConditional(condition, mask, operation)	\
 	case mask: \
-		if(condition(model)) return instruction<model, validate_reserved_bits, Operation::operation>(opcode, true);	\
-	return instruction<model, validate_reserved_bits, Operation::operation>(opcode);
+		if(condition(model)) return instruction<model, validate_reserved_bits>(Operation::operation, opcode, true);	\
+	return instruction<model, validate_reserved_bits>(Operation::operation, opcode);
 
 #define Six(x)			(unsigned(x) << 26)
 #define SixTen(x, y)	(Six(x) | ((y) << 1))
@@ -295,7 +299,7 @@ Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
 				case 0: case 1: case 2: case 3: case 4: case 5:
 				case 8: case 9: case 10: case 11: case 12: case 13:
 				case 16: case 17: case 18: case 19: case 20:
-				return instruction<model, validate_reserved_bits, Operation::bcx>(opcode);
+				return instruction<model, validate_reserved_bits>(Operation::bcx, opcode);
 
 				default: return Instruction(opcode);
 			}
@@ -553,19 +557,19 @@ Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
 	if(is64bit(model)) {
 		switch(opcode & 0b111111'00000'00000'00000'000000'111'00) {
 			default: break;
-			case 0b011110'00000'00000'00000'000000'000'00:	return instruction<model, validate_reserved_bits, Operation::rldiclx>(opcode);
-			case 0b011110'00000'00000'00000'000000'001'00:	return instruction<model, validate_reserved_bits, Operation::rldicrx>(opcode);
-			case 0b011110'00000'00000'00000'000000'010'00:	return instruction<model, validate_reserved_bits, Operation::rldicx>(opcode);
-			case 0b011110'00000'00000'00000'000000'011'00:	return instruction<model, validate_reserved_bits, Operation::rldimix>(opcode);
+			case 0b011110'00000'00000'00000'000000'000'00:	return instruction<model, validate_reserved_bits>(Operation::rldiclx, opcode);
+			case 0b011110'00000'00000'00000'000000'001'00:	return instruction<model, validate_reserved_bits>(Operation::rldicrx, opcode);
+			case 0b011110'00000'00000'00000'000000'010'00:	return instruction<model, validate_reserved_bits>(Operation::rldicx, opcode);
+			case 0b011110'00000'00000'00000'000000'011'00:	return instruction<model, validate_reserved_bits>(Operation::rldimix, opcode);
 		}
 	}
 
 	// stwcx. and stdcx.
 	switch(opcode & 0b111111'0000'0000'0000'0000'111111111'1) {
 		default: break;
-		case 0b011111'0000'0000'0000'0000'010010110'1:	return instruction<model, validate_reserved_bits, Operation::stwcx_>(opcode);
+		case 0b011111'0000'0000'0000'0000'010010110'1:	return instruction<model, validate_reserved_bits>(Operation::stwcx_, opcode);
 		case 0b011111'0000'0000'0000'0000'011010110'1:
-			if(is64bit(model)) return instruction<model, validate_reserved_bits, Operation::stdcx_>(opcode);
+			if(is64bit(model)) return instruction<model, validate_reserved_bits>(Operation::stdcx_, opcode);
 		return Instruction(opcode);
 	}
 
@@ -573,17 +577,17 @@ Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
 	if(is64bit(model)) {
 		switch(opcode & 0b111111'00'00000000'00000000'000000'11) {
 			default: break;
-			case 0b111010'00'00000000'00000000'000000'00:	return instruction<model, validate_reserved_bits, Operation::ld>(opcode);
-			case 0b111010'00'00000000'00000000'000000'01:	return instruction<model, validate_reserved_bits, Operation::ldu>(opcode);
-			case 0b111010'00'00000000'00000000'000000'10:	return instruction<model, validate_reserved_bits, Operation::lwa>(opcode);
-			case 0b111110'00'00000000'00000000'000000'00:	return instruction<model, validate_reserved_bits, Operation::std>(opcode);
-			case 0b111110'00'00000000'00000000'000000'01:	return instruction<model, validate_reserved_bits, Operation::stdu>(opcode);
+			case 0b111010'00'00000000'00000000'000000'00:	return instruction<model, validate_reserved_bits>(Operation::ld, opcode);
+			case 0b111010'00'00000000'00000000'000000'01:	return instruction<model, validate_reserved_bits>(Operation::ldu, opcode);
+			case 0b111010'00'00000000'00000000'000000'10:	return instruction<model, validate_reserved_bits>(Operation::lwa, opcode);
+			case 0b111110'00'00000000'00000000'000000'00:	return instruction<model, validate_reserved_bits>(Operation::std, opcode);
+			case 0b111110'00'00000000'00000000'000000'01:	return instruction<model, validate_reserved_bits>(Operation::stdu, opcode);
 		}
 	}
 
 	// sc
 	if((opcode & 0b111111'00'00000000'00000000'000000'1'0) == 0b010001'00'00000000'00000000'000000'1'0) {
-		return instruction<model, validate_reserved_bits, Operation::sc>(opcode);
+		return instruction<model, validate_reserved_bits>(Operation::sc, opcode);
 	}
 
 #undef Six
@@ -595,6 +599,94 @@ Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
 	return Instruction(opcode);
 }
 
+/*!
+	A two-level lookup of operation by primary opcode and then, if necessary, by extended opcode, generated
+	from decode_exhaustively.
+
+	The extended level is indexed by the low eleven bits of an opcode: the ten-bit extended opcode plus the
+	Rc bit, as the latter distinguishes stwcx. and stdcx. from their neighbours, and ld, ldu and lwa from one another.
+
+	Only bcx depends on any other field; its primary opcode is therefore marked as requiring exhaustive decoding.
+*/
+template <Model model> class DecodingTable {
+	public:
+		struct Entry {
+			Operation operation = Operation::Undefined;
+			bool is_supervisor = false;
+			bool requires_exhaustive_decoding = false;
+		};
+
+		DecodingTable() {
+			for(uint32_t primary = 0; primary < 64; primary++) {
+				// Decode all extended opcodes.
+				std::array<Entry, 2048> extended;
+				for(uint32_t c = 0; c < 2048; c++) {
+					const auto instruction = decode_exhaustively<model, false>((primary << 26) | c);
+					extended[c].operation = instruction.operation;
+					extended[c].is_supervisor = instruction.is_supervisor;
+				}
+
+				// bcx also depends on its BO field.
+				if(primary == 0b010000) {
+					primaries_[primary].entry.requires_exhaustive_decoding = true;
+					continue;
+				}
+
+				// Use a second-level table only if this primary opcode doesn't uniquely determine an outcome.
+				const bool is_uniform = std::all_of(extended.begin(), extended.end(), [&](const Entry &entry) {
+					return entry.operation == extended[0].operation && entry.is_supervisor == extended[0].is_supervisor;
+				});
+				if(is_uniform) {
+					primaries_[primary].entry = extended[0];
+				} else {
+					primaries_[primary].extended = int(extended_.size());
+					extended_.push_back(extended);
+				}
+			}
+		}
+
+		const Entry &find(uint32_t opcode) const {
+			const Primary &primary = primaries_[opcode >> 26];
+			if(primary.extended < 0) return primary.entry;
+			return extended_[size_t(primary.extended)][opcode & 2047];
+		}
+
+	private:
+		struct Primary {
+			Entry entry;
+			int extended = -1;
+		};
+		std::array<Primary, 64> primaries_;
+		std::vector<std::array<Entry, 2048>> extended_;
+};
+
+/// @returns The decoding table for @c model, which is shared regardless of reserved-bit validation.
+template <Model model> const DecodingTable<model> &decoding_table() {
+	static const DecodingTable<model> table;
+	return table;
+}
+
+}
+
+template <Model model, bool validate_reserved_bits>
+Instruction Decoder<model, validate_reserved_bits>::decode(uint32_t opcode) {
+	const auto &entry = decoding_table<model>().find(opcode);
+	if(entry.requires_exhaustive_decoding) {
+		return decode_exhaustively<model, validate_reserved_bits>(opcode);
+	}
+	if(entry.operation == Operation::Undefined) {
+		return Instruction(opcode);
+	}
+	return instruction<model, validate_reserved_bits>(entry.operation, opcode, entry.is_supervisor);
+}
+
+template <Model model, bool validate_reserved_bits>
+void Decoder<model, validate_reserved_bits>::decode(const uint32_t *source, size_t count, Instruction *destination) {
+	for(size_t c = 0; c < count; c++) {
+		destination[c] = decode(source[c]);
+	}
+}
+
 template struct InstructionSet::PowerPC::Decoder<InstructionSet::PowerPC::Model::MPC601, true>;
 template struct InstructionSet::PowerPC::Decoder<InstructionSet::PowerPC::Model::MPC603, true>;
 template struct InstructionSet::PowerPC::Decoder<InstructionSet::PowerPC::Model::MPC620, true>;
@@ -11,6 +11,8 @@
 
 #include "Instruction.hpp"
 
+#include <cstddef>
+
 namespace InstructionSet {
 namespace PowerPC {
 
@@ -45,9 +47,15 @@ constexpr bool is601(Model model) {
 	Otherwise does no inspection of reserved bits.
 
 	TODO: determine what specific models of PowerPC do re: reserved bits.
+
+	Decoding is by table lookup on primary and, where necessary, extended opcode. The table is
+	built on first use.
 */
 template <Model model, bool validate_reserved_bits = false> struct Decoder {
 	Instruction decode(uint32_t opcode);
+
+	/// Decodes @c count consecutive opcodes from @c source into @c destination.
+	void decode(const uint32_t *source, size_t count, Instruction *destination);
 };
 
 }
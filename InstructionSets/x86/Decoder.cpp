@@ -9,6 +9,7 @@
 #include "Decoder.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <utility>
 
@@ -959,6 +960,61 @@ std::pair<int, typename Decoder<model>::InstructionT> Decoder<model>::decode(con
 	return std::make_pair(0, InstructionT());
 }
 
+namespace {
+
+/// A table, indexed by operation, of those operations that terminate a basic block.
+constexpr auto basic_block_terminators = [] {
+	std::array<bool, 256> terminators{};
+	for(const auto operation: {
+		Operation::Invalid,
+		Operation::HLT,
+
+		Operation::JO,	Operation::JNO,	Operation::JB,	Operation::JNB,
+		Operation::JE,	Operation::JNE,	Operation::JBE,	Operation::JNBE,
+		Operation::JS,	Operation::JNS,	Operation::JP,	Operation::JNP,
+		Operation::JL,	Operation::JNL,	Operation::JLE,	Operation::JNLE,
+		Operation::JPCX,
+		Operation::LOOP, Operation::LOOPE, Operation::LOOPNE,
+
+		Operation::CALLfar,	Operation::CALLrel,	Operation::CALLabs,
+		Operation::JMPfar,	Operation::JMPrel,	Operation::JMPabs,
+		Operation::RETfar,	Operation::RETnear,	Operation::IRET,
+		Operation::INT,		Operation::INTO,
+	}) {
+		terminators[size_t(operation)] = true;
+	}
+	return terminators;
+}();
+
+}
+
+template <Model model> bool Decoder<model>::ends_basic_block(Operation operation) {
+	return basic_block_terminators[size_t(operation)];
+}
+
+template <Model model>
+std::pair<size_t, size_t> Decoder<model>::decode_range(const uint8_t *source, size_t length, InstructionT *destination, size_t capacity) {
+	assert(phase_ == Phase::Instruction && !consumed_);
+
+	size_t offset = 0, count = 0;
+	while(count < capacity && offset < length) {
+		// Supply everything that remains, so that each instruction is decoded in a single pass.
+		const auto [size, instruction] = decode(source + offset, length - offset);
+		if(size <= 0) {
+			reset_parsing();
+			break;
+		}
+
+		offset += size_t(size);
+		destination[count] = instruction;
+		++count;
+
+		if(ends_basic_block(instruction.operation)) break;
+	}
+
+	return std::make_pair(offset, count);
+}
+
 template <Model model> void Decoder<model>::set_32bit_protected_mode(bool enabled) {
 	if constexpr (!is_32bit(model)) {
 		assert(!enabled);
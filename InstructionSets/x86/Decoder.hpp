@@ -47,6 +47,26 @@ template <Model model> class Decoder {
 		*/
 		std::pair<int, InstructionT> decode(const uint8_t *source, size_t length);
 
+		/*!
+			Decodes the basic block that begins at @c source, i.e. consecutive instructions up to and including
+			the first that may transfer control elsewhere — any jump, call, return, loop or software interrupt,
+			plus HLT and anything invalid.
+
+			Decoding also stops if @c capacity instructions have been written to @c destination, or if
+			the final instruction would extend beyond @c length bytes. Any incomplete final instruction is
+			discarded, leaving the decoder ready to begin a new instruction.
+
+			This should be called only between instructions, i.e. not while a call to @c decode awaits
+			further bytes.
+
+			@returns The number of bytes consumed and the number of instructions written to @c destination,
+				in that order.
+		*/
+		std::pair<size_t, size_t> decode_range(const uint8_t *source, size_t length, InstructionT *destination, size_t capacity);
+
+		/// @returns @c true if @c operation might transfer control other than to the next instruction in sequence.
+		static bool ends_basic_block(Operation operation);
+
 		/*!
 			Enables or disables 32-bit protected mode. Meaningful only if the @c Model supports it.
 		*/
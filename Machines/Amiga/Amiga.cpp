@@ -11,7 +11,7 @@
 #include "../../Activity/Source.hpp"
 #include "../MachineTypes.hpp"
 
-#include "../../Processors/68000Mk2/68000Mk2.hpp"
+#include "../../Processors/68000Mk2/SwitchableProcessor.hpp"
 
 #include "../../Analyser/Static/Amiga/Target.hpp"
 
@@ -42,6 +42,7 @@ namespace Amiga {
 class ConcreteMachine:
 	public Activity::Source,
 	public CPU::MC68000Mk2::BusHandler,
+	public Configurable::Device,
 	public MachineTypes::AudioProducer,
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
@@ -177,7 +178,7 @@ class ConcreteMachine:
 		}
 
 	private:
-		CPU::MC68000Mk2::Processor<ConcreteMachine, true, true> mc68000_;
+		CPU::MC68000Mk2::SwitchableProcessor<ConcreteMachine, true, true> mc68000_;
 
 		// MARK: - Memory map.
 
@@ -193,6 +194,21 @@ class ConcreteMachine:
 			chipset_.set_activity_observer(observer);
 		}
 
+		// MARK: - Configuration options.
+
+		std::unique_ptr<Reflection::Struct> get_options() final {
+			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
+			options->fast_cpu = fast_cpu_;
+			return options;
+		}
+
+		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
+			const auto options = dynamic_cast<Options *>(str.get());
+			fast_cpu_ = options->fast_cpu;
+			mc68000_.set_fast_mode(fast_cpu_);
+		}
+		bool fast_cpu_ = false;
+
 		// MARK: - MachineTypes::AudioProducer.
 
 		Outputs::Speaker::Speaker *get_speaker() final {
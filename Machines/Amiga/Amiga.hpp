@@ -10,6 +10,8 @@
 #define Amiga_hpp
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Configurable/Configurable.hpp"
+#include "../../Configurable/StandardOptions.hpp"
 #include "../ROMMachine.hpp"
 
 namespace Amiga {
@@ -20,6 +22,16 @@ class Machine {
 
 		/// Creates and returns an Amiga.
 		static Machine *Amiga(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
+
+		class Options: public Reflection::StructImpl<Options>, public Configurable::FastCPUOption<Options> {
+			friend Configurable::FastCPUOption<Options>;
+			public:
+				Options(Configurable::OptionsType) : Configurable::FastCPUOption<Options>(false) {
+					if(needs_declare()) {
+						declare_fast_cpu_option();
+					}
+				}
+		};
 };
 
 }
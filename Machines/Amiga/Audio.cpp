@@ -13,7 +13,9 @@
 #define LOG_PREFIX "[Audio] "
 #include "../../Outputs/Log.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <tuple>
 
 using namespace Amiga;
@@ -34,21 +36,25 @@ Audio::Audio(Chipset &chipset, uint16_t *ram, size_t word_size, float output_rat
 
 void Audio::set_length(int channel, uint16_t length) {
 	assert(channel >= 0 && channel < 4);
+	catch_up();
 	channels_[channel].length = length;
 }
 
 void Audio::set_period(int channel, uint16_t period) {
 	assert(channel >= 0 && channel < 4);
+	catch_up();
 	channels_[channel].period = period;
 }
 
 void Audio::set_volume(int channel, uint16_t volume) {
 	assert(channel >= 0 && channel < 4);
+	catch_up();
 	channels_[channel].volume = (volume & 0x40) ? 64 : (volume & 0x3f);
 }
 
 template <bool is_external> void Audio::set_data(int channel, uint16_t data) {
 	assert(channel >= 0 && channel < 4);
+	catch_up();
 	channels_[channel].wants_data = false;
 	channels_[channel].data = data;
 
@@ -64,6 +70,7 @@ template void Audio::set_data<false>(int, uint16_t);
 template void Audio::set_data<true>(int, uint16_t);
 
 void Audio::set_channel_enables(uint16_t enables) {
+	catch_up();
 	channels_[0].dma_enabled = enables & 1;
 	channels_[1].dma_enabled = enables & 2;
 	channels_[2].dma_enabled = enables & 4;
@@ -71,6 +78,7 @@ void Audio::set_channel_enables(uint16_t enables) {
 }
 
 void Audio::set_modulation_flags(uint16_t flags) {
+	catch_up();
 	channels_[3].attach_period = flags & 0x80;
 	channels_[2].attach_period = flags & 0x40;
 	channels_[1].attach_period = flags & 0x20;
@@ -83,6 +91,7 @@ void Audio::set_modulation_flags(uint16_t flags) {
 }
 
 void Audio::set_interrupt_requests(uint16_t requests) {
+	catch_up();
 	channels_[0].interrupt_pending = requests & uint16_t(InterruptFlag::AudioChannel0);
 	channels_[1].interrupt_pending = requests & uint16_t(InterruptFlag::AudioChannel1);
 	channels_[2].interrupt_pending = requests & uint16_t(InterruptFlag::AudioChannel2);
@@ -91,6 +100,14 @@ void Audio::set_interrupt_requests(uint16_t requests) {
 
 // MARK: - DMA and mixing.
 
+void Audio::catch_up() {
+	for(auto &channel: channels_) {
+		channel.skip_outputs(skipped_outputs_);
+	}
+	skipped_outputs_ = 0;
+	quiet_outputs_ = 0;
+}
+
 bool Audio::advance_dma(int channel) {
 	if(!channels_[channel].wants_data) {
 		return false;
@@ -124,9 +141,27 @@ void Audio::output() {
 		nullptr,
 	};
 
-	for(int c = 0; c < 4; c++) {
-		if(channels_[c].output(modulands[c])) {
-			posit_interrupt(interrupts[c]);
+	for(auto &channel: channels_) {
+		channel.update_output_phase();
+	}
+
+	// Run the state machines only if one of them might do something other than count down its period.
+	if(quiet_outputs_) {
+		--quiet_outputs_;
+		++skipped_outputs_;
+	} else {
+		catch_up();
+
+		for(int c = 0; c < 4; c++) {
+			if(channels_[c].output(modulands[c])) {
+				posit_interrupt(interrupts[c]);
+			}
+		}
+
+		// Posting an interrupt may have fed back into channel state, so look for quiet only once all are done.
+		quiet_outputs_ = std::numeric_limits<int>::max();
+		for(const auto &channel: channels_) {
+			quiet_outputs_ = std::min(quiet_outputs_, channel.quiet_outputs());
 		}
 	}
 
@@ -654,6 +689,22 @@ template <> bool Audio::Channel::output<Audio::Channel::State::PlayingLow>(Chann
 //
 
 bool Audio::Channel::output(Channel *moduland) {
+	switch(state) {
+		case State::Disabled:			return output<State::Disabled>(moduland);
+		case State::WaitingForDummyDMA:	return output<State::WaitingForDummyDMA>(moduland);
+		case State::WaitingForDMA:		return output<State::WaitingForDMA>(moduland);
+		case State::PlayingHigh:		return output<State::PlayingHigh>(moduland);
+		case State::PlayingLow:			return output<State::PlayingLow>(moduland);
+
+		default:
+			assert(false);
+		break;
+	}
+
+	return false;
+}
+
+void Audio::Channel::update_output_phase() {
 	// Update pulse-width modulation.
 	output_phase = output_phase + 1;
 	if(output_phase == 64) {
@@ -661,18 +712,33 @@ bool Audio::Channel::output(Channel *moduland) {
 	} else {
 		output_enabled &= output_phase != volume_latch;
 	}
+}
 
+int Audio::Channel::quiet_outputs() const {
 	switch(state) {
-		case State::Disabled:			return output<State::Disabled>(moduland);
-		case State::WaitingForDummyDMA:	return output<State::WaitingForDummyDMA>(moduland);
-		case State::WaitingForDMA:		return output<State::WaitingForDMA>(moduland);
-		case State::PlayingHigh:		return output<State::PlayingHigh>(moduland);
-		case State::PlayingLow:			return output<State::PlayingLow>(moduland);
+		case State::Disabled:
+			return (dma_enabled || (!wants_data && !interrupt_pending)) ? 0 : std::numeric_limits<int>::max();
+
+		case State::WaitingForDummyDMA:
+		case State::WaitingForDMA:
+			return (!dma_enabled || !wants_data) ? 0 : std::numeric_limits<int>::max();
+
+		// Both playing states transition upon the output that finds a period counter of 1,
+		// having decremented it in PlayingLow or not in PlayingHigh; a counter of 0 wraps around.
+		case State::PlayingHigh:
+		case State::PlayingLow:
+			return uint16_t(period_counter - 1);
 
 		default:
 			assert(false);
 		break;
 	}
 
-	return false;
+	return 0;
+}
+
+void Audio::Channel::skip_outputs(int count) {
+	if(state == State::PlayingHigh || state == State::PlayingLow) {
+		period_counter = uint16_t(period_counter - count);
+	}
 }
@@ -116,6 +116,16 @@ class Audio: public DMADevice<4> {
 			/// @returns @c true if an interrupt should be posted; @c false otherwise.
 			bool output(Channel *moduland);
 
+			/// @returns The number of subsequent calls to @c output that would do nothing other than
+			/// count down the period, in the absence of any external change of state.
+			int quiet_outputs() const;
+
+			/// Applies the effect of @c count calls to @c output, which must all have been quiet.
+			void skip_outputs(int count);
+
+			/// Advances pulse-width modulation by one output.
+			void update_output_phase();
+
 			/// Applies dynamic logic for @c state, mostly testing for potential state transitions.
 			/// @param moduland The channel to modulate, if modulation is enabled.
 			/// @returns @c true if an interrupt should be posted; @c false otherwise.
@@ -147,9 +157,15 @@ class Audio: public DMADevice<4> {
 			}
 		} channels_[4];
 
+		// The number of upcoming outputs for which every channel's state machine is known to be quiet,
+		// and the number of those that have been skipped; any external change of state ends the quiet period.
+		int quiet_outputs_ = 0;
+		int skipped_outputs_ = 0;
+		void catch_up();
+
 		// Transient output state, and its destination.
 		Outputs::Speaker::PushLowpass<true> speaker_;
-		Concurrency::AsyncTaskQueue<true> queue_;
+		Concurrency::AsyncTaskQueue<true> queue_{Concurrency::ThreadRole::Audio};
 
 		using AudioBuffer = std::array<int16_t, 4096>;
 		static constexpr int BufferCount = 3;
@@ -9,6 +9,13 @@
 #include "Bitplanes.hpp"
 #include "Chipset.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define USE_NEON_BITPLANES
+#endif
+
 using namespace Amiga;
 
 namespace {
@@ -49,6 +56,42 @@ void BitplaneShifter::set(const BitplaneData &previous, const BitplaneData &next
 	//
 	// ... and assume a suitably adjusted palette is in use elsewhere.
 	// This makes dual playfields very easy to separate.
+	//
+	// In either case the result is a planar-to-chunky transpose of the whole 16-pixel group,
+	// with byte n of data_ being the pixel derived from bit n of each plane.
+#if defined(__SSE2__)
+	// Broadcast the low byte of each plane across the low half of a vector and its high byte
+	// across the high half, test each byte against the bit that belongs to it and OR
+	// the appropriate output bit wherever that test passes.
+	const __m128i bits = _mm_set_epi8(
+		char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+		char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01
+	);
+	constexpr int order[] = {0, 2, 4, 1, 3, 5};
+	__m128i result = _mm_setzero_si128();
+	for(int c = 0; c < 6; c++) {
+		const uint16_t plane = planes[order[c]];
+		const __m128i broadcast = _mm_unpacklo_epi64(
+			_mm_set1_epi8(char(plane)),
+			_mm_set1_epi8(char(plane >> 8))
+		);
+		const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(broadcast, bits), bits);
+		result = _mm_or_si128(result, _mm_and_si128(set, _mm_set1_epi8(char(1 << c))));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(data_.data()), result);
+#elif defined(USE_NEON_BITPLANES)
+	// As per the SSE path above.
+	static constexpr uint8_t bit_values[] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+	const uint8x16_t bits = vcombine_u8(vld1_u8(bit_values), vld1_u8(bit_values));
+	constexpr int order[] = {0, 2, 4, 1, 3, 5};
+	uint8x16_t result = vdupq_n_u8(0);
+	for(int c = 0; c < 6; c++) {
+		const uint16_t plane = planes[order[c]];
+		const uint8x16_t broadcast = vcombine_u8(vdup_n_u8(uint8_t(plane)), vdup_n_u8(uint8_t(plane >> 8)));
+		result = vorrq_u8(result, vandq_u8(vtstq_u8(broadcast, bits), vdupq_n_u8(uint8_t(1 << c))));
+	}
+	vst1q_u8(reinterpret_cast<uint8_t *>(data_.data()), result);
+#else
 	data_[0] =
 		(expand_bitplane_byte(uint8_t(planes[0])) << 0) |
 		(expand_bitplane_byte(uint8_t(planes[2])) << 1) |
@@ -64,6 +107,7 @@ void BitplaneShifter::set(const BitplaneData &previous, const BitplaneData &next
 		(expand_bitplane_byte(uint8_t(planes[1] >> 8)) << 3) |
 		(expand_bitplane_byte(uint8_t(planes[3] >> 8)) << 4) |
 		(expand_bitplane_byte(uint8_t(planes[5] >> 8)) << 5);
+#endif
 }
 
 // MARK: - Bitplanes.
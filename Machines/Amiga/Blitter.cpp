@@ -10,14 +10,12 @@
 
 #include "Minterms.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <optional>
 
-#ifndef NDEBUG
-#define NDEBUG
-#endif
-
-#define LOG_PREFIX "[Blitter] "
-#include "../../Outputs/Log.hpp"
+#include "../../Outputs/Logger.hpp"
 
 using namespace Amiga;
 
@@ -126,22 +124,22 @@ void Blitter<record_bus>::set_control(int index, uint16_t value) {
 		inclusive_fill_ = !exclusive_fill_ && (value & 0x0008);	// Exclusive fill takes precedence. Probably? TODO: verify.
 		fill_carry_ = (value & 0x0004);
 	} else {
-		minterms_ = value & 0xff;
+		set_minterms(value);
 		sequencer_.set_control(value >> 8);
 	}
 	shifts_[index] = value >> 12;
-	LOG("Set control " << index << " to " << PADHEX(4) << value);
+	LOGF(Log::Source::AmigaBlitter, "Set control %d to %04x", index, value);
 }
 
 template <bool record_bus>
 void Blitter<record_bus>::set_first_word_mask(uint16_t value) {
-	LOG("Set first word mask: " << PADHEX(4) << value);
+	LOGF(Log::Source::AmigaBlitter, "Set first word mask: %04x", value);
 	a_mask_[0] = value;
 }
 
 template <bool record_bus>
 void Blitter<record_bus>::set_last_word_mask(uint16_t value) {
-	LOG("Set last word mask: " << PADHEX(4) << value);
+	LOGF(Log::Source::AmigaBlitter, "Set last word mask: %04x", value);
 	a_mask_[1] = value;
 }
 
@@ -153,7 +151,7 @@ void Blitter<record_bus>::set_size(uint16_t value) {
 	if(!width_) width_ = 0x40;
 	height_ = value >> 6;
 	if(!height_) height_ = 1024;
-	LOG("Set size to " << std::dec << width_ << ", " << height_);
+	LOGF(Log::Source::AmigaBlitter, "Set size to %d, %d", width_, height_);
 
 	// Current assumption: writing this register informs the
 	// blitter that it should treat itself as about to start a new line.
@@ -161,24 +159,25 @@ void Blitter<record_bus>::set_size(uint16_t value) {
 
 template <bool record_bus>
 void Blitter<record_bus>::set_minterms(uint16_t value) {
-	LOG("Set minterms " << PADHEX(4) << value);
+	LOGF(Log::Source::AmigaBlitter, "Set minterms %04x", value);
 	minterms_ = value & 0xff;
+	minterm_ = minterm_function<uint16_t>(minterms_);
 }
 
 //template <bool record_bus>
 //void Blitter<record_bus>::set_vertical_size([[maybe_unused]] uint16_t value) {
-//	LOG("Set vertical size " << PADHEX(4) << value);
+//	LOGF(Log::Source::AmigaBlitter, "Set vertical size %04x", value);
 //	// TODO. This is ECS only, I think. Ditto set_horizontal_size.
 //}
 //
 //template <bool record_bus>
 //void Blitter<record_bus>::set_horizontal_size([[maybe_unused]] uint16_t value) {
-//	LOG("Set horizontal size " << PADHEX(4) << value);
+//	LOGF(Log::Source::AmigaBlitter, "Set horizontal size %04x", value);
 //}
 
 template <bool record_bus>
 void Blitter<record_bus>::set_data(int channel, uint16_t value) {
-	LOG("Set data " << channel << " to " << PADHEX(4) << value);
+	LOGF(Log::Source::AmigaBlitter, "Set data %d to %04x", channel, value);
 
 	// Ugh, backed myself into a corner. TODO: clean.
 	switch(channel) {
@@ -193,7 +192,7 @@ template <bool record_bus>
 uint16_t Blitter<record_bus>::get_status() {
 	const uint16_t result =
 		(not_zero_flag_ ? 0x0000 : 0x2000) | (height_ ? 0x4000 : 0x0000);
-	LOG("Returned status of " << result);
+	LOGF(Log::Source::AmigaBlitter, "Returned status of %04x", result);
 	return result;
 }
 
@@ -233,6 +232,149 @@ void Blitter<record_bus>::add_modulos() {
 	pointer_[3] += modulos_[3] * sequencer_.channel_enabled<3>() * direction_;
 }
 
+template <bool record_bus>
+uint16_t Blitter<record_bus>::fill(uint16_t output) {
+	// Use the fill tables nibble-by-nibble to figure out the filled word.
+	uint16_t fill_output = 0;
+	int ongoing_carry = fill_carry_;
+	const int type_mask = exclusive_fill_ ? (1 << 5) : 0;
+	for(int c = 0; c < 16; c += 4) {
+		const int total_index = (output & 0xf) | (ongoing_carry << 4) | type_mask;
+		fill_output |= ((fill_values[total_index >> 3] >> ((total_index & 7) * 4)) & 0xf) << c;
+		ongoing_carry = (fill_carries[total_index >> 5] >> (total_index & 31)) & 1;
+		output >>= 4;
+	}
+
+	fill_carry_ = ongoing_carry;
+	return fill_output;
+}
+
+template <bool record_bus>
+bool Blitter<record_bus>::can_blit_rectangle() const {
+	if(line_mode_ || busy_ || !sequencer_.channel_enabled<3>()) {
+		return false;
+	}
+
+	// Determine the range of words touched by channel, if that range doesn't
+	// wrap around the end of RAM; return std::nullopt otherwise.
+	const auto range = [&](int channel) -> std::optional<std::pair<int64_t, int64_t>> {
+		const int64_t stride = int64_t(width_) + int32_t(modulos_[channel]);
+		const int64_t first_row = std::min(int64_t(0), stride * (height_ - 1));
+		const int64_t last_row = std::max(int64_t(0), stride * (height_ - 1));
+
+		const int64_t start = pointer_[channel] & ram_mask_;
+		const auto result = (direction_ == 1) ?
+			std::make_pair(start + first_row, start + last_row + width_ - 1) :
+			std::make_pair(start - last_row - width_ + 1, start - first_row);
+		if(result.first < 0 || result.second > ram_mask_) {
+			return std::nullopt;
+		}
+		return result;
+	};
+
+	// Output can be written immediately rather than via the pipeline provided that no source
+	// would later read anything written. That's true if their ranges don't overlap, or if a
+	// source reads every word immediately before it is written and no word is visited twice.
+	const auto destination = range(3);
+	if(!destination) return false;
+
+	const int64_t destination_stride = int64_t(width_) + int32_t(modulos_[3]);
+	const bool destination_is_unique = height_ == 1 || std::abs(destination_stride) >= width_;
+
+	const bool enabled[] = {
+		sequencer_.channel_enabled<0>(),
+		sequencer_.channel_enabled<1>(),
+		sequencer_.channel_enabled<2>(),
+	};
+	for(int channel = 0; channel < 3; channel++) {
+		if(!enabled[channel]) continue;
+		if(
+			destination_is_unique &&
+			(pointer_[channel] & ram_mask_) == (pointer_[3] & ram_mask_) &&
+			modulos_[channel] == modulos_[3]
+		) continue;
+
+		const auto source = range(channel);
+		if(!source || (source->first <= destination->second && destination->first <= source->second)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <bool record_bus>
+void Blitter<record_bus>::blit_rectangle() {
+	const auto minterm = minterm_function<uint64_t>(minterms_);
+	const bool enabled[] = {
+		sequencer_.channel_enabled<0>(),
+		sequencer_.channel_enabled<1>(),
+		sequencer_.channel_enabled<2>(),
+	};
+	const bool fills = exclusive_fill_ || inclusive_fill_;
+
+	const auto next_input = [&](int channel, uint16_t &data) {
+		if(enabled[channel]) {
+			data = ram_[pointer_[channel] & ram_mask_];
+			pointer_[channel] += direction_;
+		}
+		return data;
+	};
+
+	a32_ = 0;
+	b32_ = 0;
+	not_zero_flag_ = false;
+
+	for(int y = 0; y < height_; y++) {
+		if(y) add_modulos();
+
+		// Output is calculated four words at a time, with each word occupying sixteen
+		// bits of a 64-bit lane; the final group of a line may be only partially used.
+		for(int x = 0; x < width_; x += 4) {
+			const int count = std::min(4, width_ - x);
+			uint64_t a = 0, b = 0, c = 0;
+
+			for(int word = 0; word < count; word++) {
+				uint16_t a_mask = 0xffff;
+				if(!(x + word)) a_mask &= a_mask_[0];
+				if(x + word == width_ - 1) a_mask &= a_mask_[1];
+
+				a32_ = (a32_ << 16) | (next_input(0, a_data_) & a_mask);
+				b32_ = (b32_ << 16) | next_input(1, b_data_);
+
+				uint16_t shifted_a, shifted_b;
+				if(!one_dot_) {
+					shifted_a = uint16_t(a32_ >> shifts_[0]);
+					shifted_b = uint16_t(b32_ >> shifts_[1]);
+				} else {
+					shifted_a = uint16_t((a32_ << shifts_[0]) | (a32_ >> (32 - shifts_[0])));
+					shifted_b = uint16_t((b32_ << shifts_[1]) | (b32_ >> (32 - shifts_[1])));
+				}
+
+				a |= uint64_t(shifted_a) << (word * 16);
+				b |= uint64_t(shifted_b) << (word * 16);
+				c |= uint64_t(next_input(2, c_data_)) << (word * 16);
+			}
+
+			const uint64_t output = minterm(a, b, c);
+			for(int word = 0; word < count; word++) {
+				uint16_t value = uint16_t(output >> (word * 16));
+				if(fills) {
+					value = fill(value);
+				}
+				not_zero_flag_ |= value;
+
+				ram_[pointer_[3] & ram_mask_] = value;
+				pointer_[3] += direction_;
+			}
+		}
+	}
+	add_modulos();
+
+	posit_interrupt(InterruptFlag::Blitter);
+	height_ = 0;
+}
+
 template <bool record_bus>
 template <bool complete_immediately>
 bool Blitter<record_bus>::advance_dma() {
@@ -255,6 +397,13 @@ bool Blitter<record_bus>::advance_dma() {
 		if(width_ == 8 && height_ == 32) {
 			printf("Accelerating %d x %d\n", width_, height_);
 
+			// Where possible, perform the entire blit in bulk rather than stepping through
+			// each slot; recorded transactions always come from the slot-by-slot version.
+			if(!record_bus && can_blit_rectangle()) {
+				blit_rectangle();
+				return true;
+			}
+
 			while(get_status() & 0x4000) {
 				advance_dma<false>();
 			}
@@ -344,7 +493,7 @@ bool Blitter<record_bus>::advance_dma() {
 			}
 
 			const uint16_t output =
-				apply_minterm<uint16_t>(a_data_ >> shifts_[0], b_data_, c_data_, minterms_);
+				minterm_(uint16_t(a_data_ >> shifts_[0]), b_data_, c_data_);
 			ram_[pointer_[3] & ram_mask_] = output;
 			not_zero_flag_ |= output;
 			draw_ &= !one_dot_;
@@ -517,26 +666,13 @@ bool Blitter<record_bus>::advance_dma() {
 		}
 
 		uint16_t output =
-			apply_minterm<uint16_t>(
+			minterm_(
 				a,
 				b,
-				c_data_,
-				minterms_);
+				c_data_);
 
 		if(exclusive_fill_ || inclusive_fill_) {
-			// Use the fill tables nibble-by-nibble to figure out the filled word.
-			uint16_t fill_output = 0;
-			int ongoing_carry = fill_carry_;
-			const int type_mask = exclusive_fill_ ? (1 << 5) : 0;
-			for(int c = 0; c < 16; c += 4) {
-				const int total_index = (output & 0xf) | (ongoing_carry << 4) | type_mask;
-				fill_output |= ((fill_values[total_index >> 3] >> ((total_index & 7) * 4)) & 0xf) << c;
-				ongoing_carry = (fill_carries[total_index >> 5] >> (total_index & 31)) & 1;
-				output >>= 4;
-			}
-
-			output = fill_output;
-			fill_carry_ = ongoing_carry;
+			output = fill(output);
 		}
 
 		not_zero_flag_ |= output;
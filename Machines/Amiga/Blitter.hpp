@@ -17,6 +17,7 @@
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "BlitterSequencer.hpp"
 #include "DMADevice.hpp"
+#include "Minterms.hpp"
 
 namespace Amiga {
 
@@ -104,6 +105,7 @@ template <bool record_bus = false> class Blitter: public DMADevice<4, 4> {
 		bool fill_carry_ = false;
 
 		uint8_t minterms_ = 0;
+		MintermFunction<uint16_t> minterm_ = minterm_function<uint16_t>(0);
 		uint32_t a32_ = 0, b32_ = 0;
 		uint16_t a_data_ = 0, b_data_ = 0, c_data_ = 0;
 
@@ -125,7 +127,17 @@ template <bool record_bus = false> class Blitter: public DMADevice<4, 4> {
 		bool has_c_data_ = false;
 
 		void add_modulos();
+		uint16_t fill(uint16_t);
 		std::vector<Transaction> transactions_;
+
+		/// @returns @c true if the blit that is about to begin can be performed by @c blit_rectangle,
+		/// i.e. it is a copy-mode blit with no overlap between output and input that would make the
+		/// timing of writes relative to reads significant.
+		bool can_blit_rectangle() const;
+
+		/// Performs an entire copy-mode blit at once, with results equivalent to those that would be
+		/// achieved by repeated calls to @c advance_dma<false>.
+		void blit_rectangle();
 };
 
 }
@@ -104,7 +104,7 @@ class BlitterSequencer {
 			return std::make_pair(next, loop_);
 		}
 
-		template <int channel> bool channel_enabled() {
+		template <int channel> bool channel_enabled() const {
 			return control_ & (8 >> channel);
 		}
 
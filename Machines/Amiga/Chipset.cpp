@@ -23,6 +23,60 @@ using namespace Amiga;
 
 #define DMA_CONSTRUCT *this, reinterpret_cast<uint16_t *>(map.chip_ram.data()), map.chip_ram.size() >> 1
 
+namespace {
+
+/// Maps each nibble of TwoSpriteShifter output, i.e. one pixel from each of a pair of unattached
+/// sprites, to the colour that results: an offset into the pair's four colours, or zero for none.
+/// The first sprite of the pair has priority.
+constexpr std::array<uint8_t, 16> unattached_sprite_colours = [] {
+	std::array<uint8_t, 16> colours{};
+	for(int nibble = 0; nibble < 16; nibble++) {
+		colours[size_t(nibble)] = uint8_t((nibble >> 2) ? (nibble >> 2) : (nibble & 3));
+	}
+	return colours;
+}();
+
+/// Maps each byte of TwoSpriteShifter output to a two-bit mask of which of its two pixels
+/// are present for collision purposes — bit 1 for the left, bit 0 for the right — considering
+/// either the first sprite only ([0]) or both ([1]).
+constexpr std::array<std::array<uint8_t, 256>, 2> sprite_collision_masks = [] {
+	std::array<std::array<uint8_t, 256>, 2> masks{};
+	for(int data = 0; data < 256; data++) {
+		for(int both = 0; both < 2; both++) {
+			int mask = data | (data >> 1);
+			if(both) mask |= (data >> 2) | (data >> 3);
+			masks[size_t(both)][size_t(data)] = uint8_t((mask & 0x01) | ((mask & 0x10) >> 3));
+		}
+	}
+	return masks;
+}();
+
+/// Maps a six-bit set of the objects present at a single pixel — sprite pairs 0–3 in bits 0–3,
+/// then the even and odd playfields — to the resulting CLXDAT bits, other than that for
+/// playfield-to-playfield collisions.
+constexpr std::array<uint16_t, 64> pixel_collisions = [] {
+	constexpr int Even = 4, Odd = 5;
+	constexpr std::pair<int, int> pairs[] = {
+		{Even, 0}, {Even, 1}, {Even, 2}, {Even, 3},		// 0x0002 to 0x0010.
+		{Odd, 0}, {Odd, 1}, {Odd, 2}, {Odd, 3},			// 0x0020 to 0x0100.
+		{0, 1}, {0, 2}, {0, 3},							// 0x0200 to 0x0800.
+		{1, 2}, {1, 3},									// 0x1000 and 0x2000.
+		{2, 3},											// 0x4000.
+	};
+
+	std::array<uint16_t, 64> collisions{};
+	for(int present = 0; present < 64; present++) {
+		for(size_t c = 0; c < std::size(pairs); c++) {
+			if((present >> pairs[c].first) & (present >> pairs[c].second) & 1) {
+				collisions[size_t(present)] |= uint16_t(0x0002 << c);
+			}
+		}
+	}
+	return collisions;
+}();
+
+}
+
 Chipset::Chipset(MemoryMap &map, int input_clock_rate) :
 	blitter_(DMA_CONSTRUCT),
 	sprites_{
@@ -170,120 +224,7 @@ void Chipset::output_pixels(int cycles_until_sync) {
 		}
 	}
 
-	// This will store flags to indicate presence or absence of sprite pixels for the four shifters.
-	int collision_masks[4] = {0, 0, 0, 0};
-
-	// If there are sprites visible, bother to figure out the playfield masks here.
-	if(sprite_shifters_[0].get() | sprite_shifters_[1].get() | sprite_shifters_[2].get() | sprite_shifters_[3].get()) {
-		// The playfield value is arranged as:
-		//
-		//	pixel = [0 0 b5 b3 b1 b4 b2 b0]
-		//	full value = [pixel] [pixel] [pixel] [pixel]
-		//
-		// i.e. the odd pixel mask is:
-		//	b0 = bits 3, 4, 5;
-		//	b1 = bits 11, 12, 13;
-		//	b2 = bits 19, 20, 21;
-		//	b3 = bits 27, 28, 29.
-		//
-		// ... and the even pixel mask is the other set.
-
-		// Ensure that b0, b8, b16, b24 are the complete mask state of the even playfields,
-		// and b3, b11, b19, b27 are the complete mask state of the odd playfields.
-		const uint32_t merged_playfield = playfield | (playfield >> 1) | (playfield >> 2);
-
-		// Collect b0, b8, b16 and b24 as b0, b1, b2, b3 (and give no regard to the other bits).
-		uint32_t playfield_even_pixel_mask = merged_playfield & 0x01010101;
-		playfield_even_pixel_mask |= playfield_even_pixel_mask >> 7;
-		playfield_even_pixel_mask |= playfield_even_pixel_mask >> 14;
-
-		// Collect b3, b11, b19 and b27 as b0, b1, b2, b3 (and give no regard to the other bits).
-		uint32_t playfield_odd_pixel_mask = (merged_playfield >> 3) & 0x01010101;
-		playfield_odd_pixel_mask |= playfield_odd_pixel_mask >> 7;
-		playfield_odd_pixel_mask |= playfield_odd_pixel_mask >> 14;
-
-		// If only a single playfield is in use, treat the mask as playing
-		// into the priority selected for the even bitfields.
-		if(!dual_playfields_) {
-			playfield_even_pixel_mask |= playfield_odd_pixel_mask;
-			playfield_odd_pixel_mask = 0;
-		}
-
-		// Draw sprites.
-		int index = int(sprite_shifters_.size());
-		for(auto shifter = sprite_shifters_.rbegin(); shifter != sprite_shifters_.rend(); ++shifter) {
-			// Update the index, and skip this shifter entirely if it's empty.
-			--index;
-			const uint8_t data = shifter->get();
-			if(!data) continue;
-
-			// Determine the collision mask.
-			collision_masks[index] = data | (data >> 1);
-			if(collisions_flags_ & (0x1000 << index)) {
-				collision_masks[index] |= (data >> 2) | (data >> 3);
-			}
-			collision_masks[index] = (collision_masks[index] & 0x01) | ((collision_masks[index] & 0x10) >> 3);
-
-			// Get the specific pixel mask;
-			//
-			// Playfield priority meanings:
-			//
-			//	4: behind all sprites;
-			//	3: in front of sprites 6 & 7, behind all others;
-			//	2: in front of 4, 5, 6 & 7; behind all others;
-			//	1: in front of 2, 3, 4, 5, 6, & 7; behind 0 & 1;
-			//	0: in front of all sprites.
-			//
-			// i.e. the playfield is in front of the two sprites in shifter n
-			// if and only if it has a priority of n or less.
-			const auto pixel_mask =
-				(
-					((odd_priority_ <= index) ? playfield_odd_pixel_mask : 0) |
-					((even_priority_ <= index) ? playfield_even_pixel_mask : 0)
-				);
-
-			// Output pixels, if a buffer exists and only where the pixel
-			// mask allows. TODO: try to find a less branchy version of the below.
-			const auto base = (index << 2) + 16;
-			if(pixels_) {
-				if(sprites_[size_t((index << 1) + 1)].attached) {
-					// Left pixel.
-					if(data >> 4) {
-						if(!(pixel_mask & 0x8)) pixels_[0] = palette_[16 + (data >> 4)];
-						if(!(pixel_mask & 0x4)) pixels_[1] = palette_[16 + (data >> 4)];
-					}
-
-					// Right pixel.
-					if(data & 15) {
-						if(!(pixel_mask & 0x2)) pixels_[2] = palette_[16 + (data & 15)];
-						if(!(pixel_mask & 0x1)) pixels_[3] = palette_[16 + (data & 15)];
-					}
-				} else {
-					// Left pixel.
-					if((data >> 4) & 3) {
-						if(!(pixel_mask & 0x8)) pixels_[0] = palette_[base + ((data >> 4)&3)];
-						if(!(pixel_mask & 0x4)) pixels_[1] = palette_[base + ((data >> 4)&3)];
-					}
-					if(data >> 6) {
-						if(!(pixel_mask & 0x8)) pixels_[0] = palette_[base + (data >> 6)];
-						if(!(pixel_mask & 0x4)) pixels_[1] = palette_[base + (data >> 6)];
-					}
-
-					// Right pixel.
-					if(data & 3) {
-						if(!(pixel_mask & 0x2)) pixels_[2] = palette_[base + (data & 3)];
-						if(!(pixel_mask & 0x1)) pixels_[3] = palette_[base + (data & 3)];
-					}
-					if((data >> 2) & 3) {
-						if(!(pixel_mask & 0x2)) pixels_[2] = palette_[base + ((data >> 2)&3)];
-						if(!(pixel_mask & 0x1)) pixels_[3] = palette_[base + ((data >> 2)&3)];
-					}
-				}
-			}
-		}
-	}
-
-	// Compute playfield collision mask and populate collisions register.
+	// Compute the playfield collision masks.
 	const uint32_t playfield_collisions = (playfield & playfield_collision_mask_) ^ playfield_collision_complement_;
 	int playfield_collisions_mask =
 		(playfield_collisions | (playfield_collisions >> 1) | (playfield_collisions >> 2)) & 0x09090909;
@@ -293,29 +234,93 @@ void Chipset::output_pixels(int cycles_until_sync) {
 		playfield_collisions_mask,
 		playfield_collisions_mask >> 3
 	};
+	if(playfield_collision_masks[0] & playfield_collision_masks[1]) {
+		collisions_ |= 0x0001;
+	}
 
-	// TODO: as below, but without conditionals...
-	collisions_ |=
-		((collision_masks[2] & collision_masks[3]) ? 0x4000 : 0x0000) |
-
-		((collision_masks[1] & collision_masks[3]) ? 0x2000 : 0x0000) |
-		((collision_masks[1] & collision_masks[2]) ? 0x1000 : 0x0000) |
-
-		((collision_masks[0] & collision_masks[3]) ? 0x0800 : 0x0000) |
-		((collision_masks[0] & collision_masks[2]) ? 0x0400 : 0x0000) |
-		((collision_masks[0] & collision_masks[1]) ? 0x0200 : 0x0000) |
+	// Everything else involves sprites, so is moot if there aren't any here.
+	if(!(sprite_shifters_[0].get() | sprite_shifters_[1].get() | sprite_shifters_[2].get() | sprite_shifters_[3].get())) {
+		if(pixels_) {
+			pixels_ += 4;
+		}
+		return;
+	}
 
-		((playfield_collision_masks[1] & collision_masks[3]) ? 0x0100 : 0x0000) |
-		((playfield_collision_masks[1] & collision_masks[2]) ? 0x0080 : 0x0000) |
-		((playfield_collision_masks[1] & collision_masks[1]) ? 0x0040 : 0x0000) |
-		((playfield_collision_masks[1] & collision_masks[0]) ? 0x0020 : 0x0000) |
+	// The playfield value is arranged as:
+	//
+	//	pixel = [0 0 b5 b3 b1 b4 b2 b0]
+	//	full value = [pixel] [pixel] [pixel] [pixel]
+	//
+	// i.e. the odd pixel mask is:
+	//	b0 = bits 3, 4, 5;
+	//	b1 = bits 11, 12, 13;
+	//	b2 = bits 19, 20, 21;
+	//	b3 = bits 27, 28, 29.
+	//
+	// ... and the even pixel mask is the other set.
+
+	// Ensure that b0, b8, b16, b24 are the complete mask state of the even playfields,
+	// and b3, b11, b19, b27 are the complete mask state of the odd playfields.
+	const uint32_t merged_playfield = playfield | (playfield >> 1) | (playfield >> 2);
+
+	// Collect b0, b8, b16 and b24 as b0, b1, b2, b3 (and give no regard to the other bits).
+	uint32_t playfield_even_pixel_mask = merged_playfield & 0x01010101;
+	playfield_even_pixel_mask |= playfield_even_pixel_mask >> 7;
+	playfield_even_pixel_mask |= playfield_even_pixel_mask >> 14;
+
+	// Collect b3, b11, b19 and b27 as b0, b1, b2, b3 (and give no regard to the other bits).
+	uint32_t playfield_odd_pixel_mask = (merged_playfield >> 3) & 0x01010101;
+	playfield_odd_pixel_mask |= playfield_odd_pixel_mask >> 7;
+	playfield_odd_pixel_mask |= playfield_odd_pixel_mask >> 14;
+
+	// If only a single playfield is in use, treat the mask as playing
+	// into the priority selected for the even bitfields.
+	if(!dual_playfields_) {
+		playfield_even_pixel_mask |= playfield_odd_pixel_mask;
+		playfield_odd_pixel_mask = 0;
+	}
 
-		((playfield_collision_masks[0] & collision_masks[3]) ? 0x0010 : 0x0000) |
-		((playfield_collision_masks[0] & collision_masks[2]) ? 0x0008 : 0x0000) |
-		((playfield_collision_masks[0] & collision_masks[1]) ? 0x0004 : 0x0000) |
-		((playfield_collision_masks[0] & collision_masks[0]) ? 0x0002 : 0x0000) |
+	// Draw sprites, from lowest to highest priority, and collect the set of objects
+	// present at each of the two pixels for collision purposes: sprite pairs in b0–b3,
+	// the even playfield in b4 and the odd in b5.
+	int present[2] = {
+		((playfield_collision_masks[0] & 1) << 4) | ((playfield_collision_masks[1] & 1) << 5),
+		((playfield_collision_masks[0] & 2) << 3) | ((playfield_collision_masks[1] & 2) << 4),
+	};
+	for(int index = int(sprite_shifters_.size()) - 1; index >= 0; --index) {
+		const uint8_t data = sprite_shifters_[size_t(index)].get();
+		if(!data) continue;
+
+		const uint8_t collision_mask = sprite_collision_masks[(collisions_flags_ >> (12 + index)) & 1][data];
+		present[0] |= (collision_mask & 1) << index;
+		present[1] |= (collision_mask >> 1) << index;
+
+		if(!pixels_) continue;
+
+		// The playfield is in front of the sprites in shifter n if and only if its priority
+		// is n or less; playfield_in_front_ has been populated accordingly.
+		const auto pixel_mask =
+			(playfield_odd_pixel_mask & playfield_in_front_[size_t(index)].odd) |
+			(playfield_even_pixel_mask & playfield_in_front_[size_t(index)].even);
+
+		// Output pixels only where the pixel mask allows.
+		const bool attached = sprites_[size_t((index << 1) + 1)].attached;
+		const int base = attached ? 16 : (index << 2) + 16;
+		const int left = attached ? data >> 4 : unattached_sprite_colours[data >> 4];
+		const int right = attached ? data & 15 : unattached_sprite_colours[data & 15];
+
+		if(left) {
+			if(!(pixel_mask & 0x8)) pixels_[0] = palette_[base + left];
+			if(!(pixel_mask & 0x4)) pixels_[1] = palette_[base + left];
+		}
+		if(right) {
+			if(!(pixel_mask & 0x2)) pixels_[2] = palette_[base + right];
+			if(!(pixel_mask & 0x1)) pixels_[3] = palette_[base + right];
+		}
+	}
 
-		((playfield_collision_masks[0] & playfield_collision_masks[1]) ? 0x0001 : 0x0000);
+	// Populate the collisions register.
+	collisions_ |= pixel_collisions[size_t(present[0])] | pixel_collisions[size_t(present[1])];
 
 	// Advance pixel pointer (if applicable).
 	if(pixels_) {
@@ -349,10 +354,10 @@ template <int cycle> void Chipset::output() {
 	// Advance audio.
 	audio_.output();
 
-	// Trigger any sprite loads encountered.
+	// Trigger any sprite loads encountered; most slots of most lines have no visible sprites to consider.
 	constexpr auto dcycle = cycle << 1;
 	static_assert(std::tuple_size<decltype(sprites_)>::value % 2 == 0);
-	for(size_t c = 0; c < sprites_.size(); c += 2) {
+	for(size_t c = 0; visible_sprites_ && c < sprites_.size(); c += 2) {
 		if( sprites_[c].visible &&
 			dcycle <= sprites_[c].h_start &&
 			dcycle+2 > sprites_[c].h_start) {
@@ -627,7 +632,9 @@ template <int cycle, bool stop_if_cpu> bool Chipset::perform_cycle() {
 				constexpr auto sprite_id = (cycle - 0x16) >> 2;
 				static_assert(sprite_id >= 0 && sprite_id < std::tuple_size<decltype(sprites_)>::value);
 
-				if(sprites_[sprite_id].advance_dma((~cycle&2) >> 1, y_, y_ == vertical_blank_height_)) {
+				const bool did_fetch = sprites_[sprite_id].advance_dma((~cycle&2) >> 1, y_, y_ == vertical_blank_height_);
+				update_sprite_visibility(sprite_id);
+				if(did_fetch) {
 					return false;
 				}
 			}
@@ -637,7 +644,8 @@ template <int cycle, bool stop_if_cpu> bool Chipset::perform_cycle() {
 		// is just possibly to pass to the Copper.
 		constexpr auto CopperEnabled = DMAFlag::AllBelow | DMAFlag::Copper;
 		if((dma_control_ & CopperEnabled) == CopperEnabled) {
-			if(copper_.advance_dma(uint16_t(((y_ & 0xff) << 8) | cycle), blitter_.get_status())) {
+			const auto position = uint16_t(((y_ & 0xff) << 8) | cycle);
+			if(!copper_.is_idle_at(position) && copper_.advance_dma(position, blitter_.get_status())) {
 				return false;
 			}
 		} else {
@@ -805,6 +813,13 @@ template <bool stop_on_cpu> Chipset::Changes Chipset::run(HalfCycles length) {
 	return changes;
 }
 
+void Chipset::update_sprite_visibility(size_t index) {
+	visible_sprites_ = uint8_t(
+		(visible_sprites_ & ~(1 << index)) |
+		(sprites_[index].visible << index)
+	);
+}
+
 void Chipset::post_bitplanes(const BitplaneData &data) {
 	// For now this retains the storage that'll be used when I switch to
 	// deferred loading, but continues to act as if the Amiga were barrel
@@ -993,11 +1008,22 @@ void Chipset::write(uint32_t address, uint16_t value, bool allow_conversion) {
 			odd_delay_ = value & 0x0f;
 			even_delay_ = (value >> 4) & 0x0f;
 		break;
-		case 0x104:	// BPLCON2
-			odd_priority_ = value & 7;				// i.e. "Playfield 1"; planes 1, 3 and 5.
-			even_priority_ = (value >> 3) & 7;		// i.e. "Playfield 2"; planes 2, 4 and 6.
+		case 0x104: {	// BPLCON2
+			// Playfield priority meanings:
+			//
+			//	4: behind all sprites;
+			//	3: in front of sprites 6 & 7, behind all others;
+			//	2: in front of 4, 5, 6 & 7; behind all others;
+			//	1: in front of 2, 3, 4, 5, 6, & 7; behind 0 & 1;
+			//	0: in front of all sprites.
+			const int odd_priority = value & 7;				// i.e. "Playfield 1"; planes 1, 3 and 5.
+			const int even_priority = (value >> 3) & 7;		// i.e. "Playfield 2"; planes 2, 4 and 6.
+			for(int c = 0; c < 4; c++) {
+				playfield_in_front_[size_t(c)].odd = odd_priority <= c ? ~0u : 0u;
+				playfield_in_front_[size_t(c)].even = even_priority <= c ? ~0u : 0u;
+			}
 			even_over_odd_ = value & 0x40;
-		break;
+		} break;
 
 		case 0x106:		// BPLCON3 (ECS)
 			LOG("TODO: Bitplane control; " << PADHEX(4) << value << " to " << PADHEX(8) << address);
@@ -1075,8 +1101,8 @@ void Chipset::write(uint32_t address, uint16_t value, bool allow_conversion) {
 		case pointer + 0:	sprites_[index].set_pointer<0, 16>(value);		break;	\
 		case pointer + 2:	sprites_[index].set_pointer<0, 0>(value);		break;	\
 		case position + 0:	sprites_[index].set_start_position(value);		break;	\
-		case position + 2:	sprites_[index].set_stop_and_control(value);	break;	\
-		case position + 4:	sprites_[index].set_image_data(0, value);		break;	\
+		case position + 2:	sprites_[index].set_stop_and_control(value);	update_sprite_visibility(index);	break;	\
+		case position + 4:	sprites_[index].set_image_data(0, value);		update_sprite_visibility(index);	break;	\
 		case position + 6:	sprites_[index].set_image_data(1, value);		break;
 
 		Sprite(0, 0x120, 0x140);
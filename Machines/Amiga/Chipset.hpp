@@ -144,6 +144,8 @@ class Chipset: private ClockingHint::Observer {
 		// MARK: - Sprites and collision flags.
 
 		std::array<Sprite, 8> sprites_;
+		uint8_t visible_sprites_ = 0;	// Bit n is set if sprites_[n].visible.
+		void update_sprite_visibility(size_t index);
 		std::array<TwoSpriteShifter, 4> sprite_shifters_;
 		uint16_t collisions_ = 0, collisions_flags_= 0;
 
@@ -188,7 +190,12 @@ class Chipset: private ClockingHint::Observer {
 		BitplaneData next_bitplanes_, previous_bitplanes_;
 		bool has_next_bitplanes_ = false;
 
-		int odd_priority_ = 0, even_priority_ = 0;
+		// For each sprite pair, masks that retain the odd and even playfields' pixels only if
+		// they are in front of that pair, per BPLCON2. Both playfields are in front at reset.
+		struct PlayfieldPriority {
+			uint32_t odd = ~0u, even = ~0u;
+		};
+		std::array<PlayfieldPriority, 4> playfield_in_front_;
 		bool even_over_odd_ = false;
 		bool hold_and_modify_ = false;
 		bool dual_playfields_ = false;
@@ -329,6 +336,7 @@ class Chipset: private ClockingHint::Observer {
 
 				void run_for(Cycles duration) {
 					Storage::Disk::Controller::run_for(duration);
+					flush_input_bits();
 				}
 
 				bool insert(const std::shared_ptr<Storage::Disk::Disk> &disk, size_t drive);
@@ -348,6 +356,14 @@ class Chipset: private ClockingHint::Observer {
 
 				uint16_t data_ = 0;
 				int bit_count_ = 0;
+
+				// Bits received from the PLL are gathered here and processed a word at a time,
+				// at the latest at the end of each run_for; nothing outside the controller can
+				// observe the difference before then.
+				void flush_input_bits();
+				static constexpr int MaxPendingBits = 48;
+				uint64_t pending_bits_ = 0;
+				int pending_bit_count_ = 0;
 				uint16_t sync_word_ = 0x4489;	// TODO: confirm or deny guess.
 				bool sync_with_word_ = false;
 
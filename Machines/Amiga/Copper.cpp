@@ -87,6 +87,7 @@ bool Copper::advance_dma(uint16_t position, uint16_t blitter_status) {
 			if(satisfies_raster(position, blitter_status, instruction_)) {
 				LOG("Unblocked waiting for " << PADHEX(4) << instruction_[0] << " at " << PADHEX(4) << position << " with mask " << PADHEX(4) << (instruction_[1] & 0x7ffe));
 				state_ = State::FetchFirstWord;
+				wake_position_ = 0;
 			}
 		return false;
 
@@ -114,7 +115,7 @@ bool Copper::advance_dma(uint16_t position, uint16_t blitter_status) {
 					instruction_[0] &= 0x1fe;
 					if((instruction_[0] < 0x10) || (instruction_[0] < 0x20 && !(control_&1))) {
 						LOG("Invalid MOVE to " << PADHEX(4) << instruction_[0] << "; stopping");
-						state_ = State::Stopped;
+						stop();
 						break;
 					}
 
@@ -133,6 +134,10 @@ bool Copper::advance_dma(uint16_t position, uint16_t blitter_status) {
 				// $FFDF,$FFFE seems to suggest evaluation will happen
 				// in the next cycle rather than this one.
 				state_ = State::Waiting;
+
+				// Masking can only reduce the position being compared, so the raster
+				// test can't be satisfied before the beam reaches the masked target.
+				wake_position_ = instruction_[0] & (0x8000 | (instruction_[1] & 0x7ffe));
 				break;
 			}
 
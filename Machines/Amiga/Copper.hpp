@@ -22,10 +22,18 @@ class Copper: public DMADevice<2> {
 		/// @returns @c true if the slot was used; @c false otherwise.
 		bool advance_dma(uint16_t position, uint16_t blitter_status);
 
+		/// @returns @c true if the Copper is certain not to use a DMA slot at @c position, i.e. if it
+		/// is stopped or is waiting for a later beam position. Slots for which this is @c true needn't be
+		/// offered via @c advance_dma.
+		bool is_idle_at(uint16_t position) const {
+			return position < wake_position_;
+		}
+
 		/// Forces a reload of address @c id (i.e. 0 or 1) and restarts the Copper.
 		template <int id> void reload() {
 			address_ = pointer_[id];
 			state_ = State::FetchFirstWord;
+			wake_position_ = 0;
 		}
 
 		/// Sets the Copper control word.
@@ -36,6 +44,7 @@ class Copper: public DMADevice<2> {
 		/// Forces the Copper into the stopped state.
 		void stop() {
 			state_ = State::Stopped;
+			wake_position_ = NeverWakes;
 		}
 
 	private:
@@ -47,6 +56,10 @@ class Copper: public DMADevice<2> {
 		} state_ = State::Stopped;
 		bool skip_next_ = false;
 		uint16_t instruction_[2]{};
+
+		// The earliest beam position at which the Copper might have work to do.
+		static constexpr uint32_t NeverWakes = 0x1'0000;
+		uint32_t wake_position_ = NeverWakes;
 };
 
 }
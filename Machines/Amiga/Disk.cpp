@@ -8,6 +8,10 @@
 
 #include "Chipset.hpp"
 
+#include "../../Numeric/LeadingZeros.hpp"
+
+#include <algorithm>
+
 #ifndef NDEBUG
 #define NDEBUG
 #endif
@@ -92,21 +96,59 @@ Chipset::DiskController::DiskController(Cycles clock_rate, Chipset &chipset, Dis
 }
 
 void Chipset::DiskController::process_input_bit(int value) {
-	data_ = uint16_t((data_ << 1) | value);
-	++bit_count_;
+	pending_bits_ = (pending_bits_ << 1) | uint64_t(value);
+	if(++pending_bit_count_ == MaxPendingBits) {
+		flush_input_bits();
+	}
+}
 
-	const bool sync_matches = data_ == sync_word_;
-	if(sync_matches) {
-		chipset_.posit_interrupt(InterruptFlag::DiskSyncMatch);
+void Chipset::DiskController::flush_input_bits() {
+	const int count = pending_bit_count_;
+	if(!count) return;
+	pending_bit_count_ = 0;
+
+	// Append the new bits to those already in the shift register; bit j of matches is
+	// then set if the 16 bits from j upward equal the sync word, i.e. if the sync word
+	// would have been spotted upon receipt of the bit at j.
+	const uint64_t stream = (uint64_t(data_) << count) | pending_bits_;
+	uint64_t matches = (uint64_t(1) << count) - 1;
+	for(int bit = 0; bit < 16; bit++) {
+		const uint64_t shifted = stream >> bit;
+		matches &= (sync_word_ & (1 << bit)) ? shifted : ~shifted;
+	}
 
-		if(sync_with_word_) {
-			bit_count_ = 0;
+	// Step from one event to the next — either a sync match or the end of a word —
+	// rather than bit by bit.
+	int remaining = count;
+	while(true) {
+		const int to_word = 16 - (bit_count_ & 15);
+		const uint64_t upcoming = matches & ((uint64_t(1) << remaining) - 1);
+		const int to_match = upcoming ? remaining - (63 - Numeric::leading_zeros(upcoming)) : remaining + 1;
+		const int step = std::min(to_word, to_match);
+		if(step > remaining) {
+			bit_count_ += remaining;
+			break;
 		}
-	}
 
-	if(!(bit_count_ & 15)) {
-		disk_dma_.enqueue(data_, sync_matches);
+		remaining -= step;
+		bit_count_ += step;
+		data_ = uint16_t(stream >> remaining);
+
+		const bool sync_matches = step == to_match;
+		if(sync_matches) {
+			chipset_.posit_interrupt(InterruptFlag::DiskSyncMatch);
+
+			if(sync_with_word_) {
+				bit_count_ = 0;
+			}
+		}
+
+		if(!(bit_count_ & 15)) {
+			disk_dma_.enqueue(data_, sync_matches);
+		}
 	}
+
+	data_ = uint16_t(stream);
 }
 
 void Chipset::DiskController::set_sync_word(uint16_t value) {
@@ -139,6 +181,7 @@ void Chipset::DiskController::process_index_hole() {
 	cia_.set_flag_input(false);
 
 	// Resync word output. Experimental!!
+	flush_input_bits();
 	bit_count_ = 0;
 }
 
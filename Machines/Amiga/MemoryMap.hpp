@@ -10,6 +10,7 @@
 #define MemoryMap_hpp
 
 #include "../../Analyser/Static/Amiga/Target.hpp"
+#include "../Utility/LargeMemory.hpp"
 
 #include <array>
 #include <cassert>
@@ -25,7 +26,7 @@ class MemoryMap {
 
 	public:
 		std::array<uint8_t, 512*1024> kickstart{0xff};
-		std::vector<uint8_t> chip_ram{};
+		Memory::LargeVector<uint8_t> chip_ram{};
 
 		struct MemoryRegion {
 			uint8_t *contents = nullptr;
@@ -172,7 +173,7 @@ class MemoryMap {
 		}
 
 	private:
-		std::vector<uint8_t> fast_ram_{};
+		Memory::LargeVector<uint8_t> fast_ram_{};
 		uint8_t fast_ram_size_ = 0;
 
 		bool fast_autoconf_visible_ = true;
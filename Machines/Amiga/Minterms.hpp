@@ -9,6 +9,10 @@
 #ifndef Minterms_hpp
 #define Minterms_hpp
 
+#include <array>
+#include <cstddef>
+#include <utility>
+
 namespace Amiga {
 
 /// @returns the result of applying the Amiga-format @c minterm to inputs @c a, @c b and @c c.
@@ -382,6 +386,29 @@ template <typename IntT> IntT apply_minterm(IntT a, IntT b, IntT c, int minterm)
 	return 0;
 }
 
+template <typename IntT> using MintermFunction = IntT (*)(IntT, IntT, IntT);
+
+namespace Minterms {
+
+template <typename IntT, int minterm> IntT apply(IntT a, IntT b, IntT c) {
+	return apply_minterm<IntT>(a, b, c, minterm);
+}
+
+template <typename IntT, size_t... minterms>
+constexpr std::array<MintermFunction<IntT>, 256> table(std::index_sequence<minterms...>) {
+	return {&apply<IntT, int(minterms)>...};
+}
+
+template <typename IntT> constexpr auto functions = table<IntT>(std::make_index_sequence<256>());
+
+}
+
+/// @returns a function equivalent to @c apply_minterm with the Amiga-format @c minterm, specialised
+/// so as to avoid selecting an implementation upon every call.
+template <typename IntT> MintermFunction<IntT> minterm_function(int minterm) {
+	return Minterms::functions<IntT>[size_t(minterm & 0xff)];
+}
+
 }
 
 #endif /* Minterms_hpp */
@@ -34,6 +34,7 @@
 
 #include "../../Numeric/CRC.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -156,7 +157,7 @@ class AYDeferrer {
 		}
 
 	private:
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		GI::AY38910::AY38910<true> ay_;
 		Outputs::Speaker::PullLowpass<GI::AY38910::AY38910<true>> speaker_;
 		HalfCycles cycles_since_update_;
@@ -213,87 +214,35 @@ class CRTCBusHandler {
 			} else {
 				output_mode = OutputMode::Border;
 			}
+			set_output_mode(output_mode);
 
-			// If a transition between sync/border/pixels just occurred, flush whatever was
-			// in progress to the CRT and reset counting.
-			if(output_mode != previous_output_mode_) {
-				if(cycles_) {
-					switch(previous_output_mode_) {
-						default:
-						case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
-						case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
-						case OutputMode::Border:		output_border(cycles_);							break;
-						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
-						case OutputMode::Pixels:
-							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-							pixel_pointer_ = pixel_data_ = nullptr;
-						break;
-					}
-				}
-
-				cycles_ = 0;
-				previous_output_mode_ = output_mode;
-			}
-
+			// collect some more pixels if output is ongoing, or else just
 			// increment cycles since state changed
-			cycles_++;
-
-			// collect some more pixels if output is ongoing
 			if(previous_output_mode_ == OutputMode::Pixels) {
-				if(!pixel_data_) {
-					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
-				}
-				if(pixel_pointer_) {
-					// the CPC shuffles output lines as:
-					//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
-					// ... so form the real access address.
-					const uint16_t address =
-						uint16_t(
-							((state.refresh_address & 0x3ff) << 1) |
-							((state.row_address & 0x7) << 11) |
-							((state.refresh_address & 0x3000) << 2)
-						);
-
-					// Fetch two bytes and translate into pixels. Guaranteed: the mode can change only at
-					// hsync, so there's no risk of pixel_pointer_ overrunning 320 output pixels without
-					// exactly reaching 320 output pixels.
-					switch(mode_) {
-						case 0:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode0_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode0_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-						case 1:
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[0] = mode1_output_[ram_[address]];
-							reinterpret_cast<uint32_t *>(pixel_pointer_)[1] = mode1_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint32_t);
-						break;
-
-						case 2:
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[0] = mode2_output_[ram_[address]];
-							reinterpret_cast<uint64_t *>(pixel_pointer_)[1] = mode2_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint64_t);
-						break;
-
-						case 3:
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[0] = mode3_output_[ram_[address]];
-							reinterpret_cast<uint16_t *>(pixel_pointer_)[1] = mode3_output_[ram_[address+1]];
-							pixel_pointer_ += 2 * sizeof(uint16_t);
-						break;
-
-					}
+				output_pixels(state.refresh_address, state.row_address, 1);
+			} else {
+				cycles_++;
+			}
+		}
 
-					// Flush the current buffer pixel if full; the CRTC allows many different display
-					// widths so it's not necessarily possible to predict the correct number in advance
-					// and using the upper bound could lead to inefficient behaviour.
-					if(pixel_pointer_ == pixel_data_ + 320) {
-						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-						pixel_pointer_ = pixel_data_ = nullptr;
-						cycles_ = 0;
-					}
-				}
+		/*!
+			The CRTC entry function for a run of bus cycles in which only the refresh address changes.
+			Horizontal sync is necessarily inactive throughout, so output is either vertical sync, pixels or border.
+		*/
+		void perform_bus_cycle_span(const Motorola::CRTC::BusState &state, int length) {
+			cycles_into_hsync_ = 0;
+			if(state.vsync) {
+				set_output_mode(OutputMode::Sync);
+			} else if(state.display_enable) {
+				set_output_mode(OutputMode::Pixels);
+				output_pixels(state.refresh_address, state.row_address, length);
+				return;
+			} else {
+				set_output_mode(OutputMode::Border);
 			}
+			cycles_ += length;
+
+			// Sync state is constant across the span, so there are no edges for phase 2 to observe.
 		}
 
 		/*!
@@ -383,6 +332,112 @@ class CRTCBusHandler {
 		}
 
 	private:
+		enum class OutputMode {
+			Sync,
+			Blank,
+			ColourBurst,
+			Border,
+			Pixels
+		};
+
+		/*!
+			If @c output_mode differs from the previous output mode, flushes whatever was in progress
+			to the CRT and resets counting.
+		*/
+		forceinline void set_output_mode(OutputMode output_mode) {
+			if(output_mode == previous_output_mode_) return;
+
+			if(cycles_) {
+				switch(previous_output_mode_) {
+					default:
+					case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
+					case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
+					case OutputMode::Border:		output_border(cycles_);							break;
+					case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
+					case OutputMode::Pixels:
+						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+						pixel_pointer_ = pixel_data_ = nullptr;
+					break;
+				}
+			}
+
+			cycles_ = 0;
+			previous_output_mode_ = output_mode;
+		}
+
+		/*!
+			Fetches and serialises @c length characters of pixels, beginning from @c refresh_address.
+		*/
+		forceinline void output_pixels(uint16_t refresh_address, uint16_t row_address, int length) {
+			while(length) {
+				if(!pixel_data_) {
+					pixel_pointer_ = pixel_data_ = crt_.begin_data(320, 8);
+				}
+				if(!pixel_pointer_) {
+					// No buffer is available, so just keep time.
+					cycles_++;
+					refresh_address = (refresh_address + 1) & 0x3fff;
+					--length;
+					continue;
+				}
+
+				// Translate as many characters as will fit in the current buffer. Guaranteed: the mode can
+				// change only at hsync, so there's no risk of pixel_pointer_ overrunning 320 output pixels
+				// without exactly reaching 320 output pixels.
+				int count;
+				switch(mode_) {
+					default:
+					case 0:	count = expand_pixels(mode0_output_, refresh_address, row_address, length);	break;
+					case 1:	count = expand_pixels(mode1_output_, refresh_address, row_address, length);	break;
+					case 2:	count = expand_pixels(mode2_output_, refresh_address, row_address, length);	break;
+					case 3:	count = expand_pixels(mode3_output_, refresh_address, row_address, length);	break;
+				}
+				cycles_ += count;
+				length -= count;
+
+				// Flush the current buffer pixel if full; the CRTC allows many different display
+				// widths so it's not necessarily possible to predict the correct number in advance
+				// and using the upper bound could lead to inefficient behaviour.
+				if(pixel_pointer_ == pixel_data_ + 320) {
+					crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+					pixel_pointer_ = pixel_data_ = nullptr;
+					cycles_ = 0;
+				}
+			}
+		}
+
+		/*!
+			Fetches two bytes per character and translates them into pixels via @c table, for up to @c length characters
+			or until the current buffer is full, whichever is sooner.
+
+			@returns The number of characters output.
+		*/
+		template <typename TableT> forceinline int expand_pixels(const TableT &table, uint16_t &refresh_address, uint16_t row_address, int length) {
+			using PixelsT = typename TableT::value_type;
+			auto target = reinterpret_cast<PixelsT *>(pixel_pointer_);
+			const int count = std::min(length, int((pixel_data_ + 320 - pixel_pointer_) / ptrdiff_t(2 * sizeof(PixelsT))));
+
+			// the CPC shuffles output lines as:
+			//	MA13 MA12	RA2 RA1 RA0		MA9 MA8 MA7 MA6 MA5 MA4 MA3 MA2 MA1 MA0		CCLK
+			// ... so form the real access address.
+			const uint16_t row_bits = uint16_t((row_address & 0x7) << 11);
+			for(int c = 0; c < count; c++) {
+				const uint16_t address =
+					uint16_t(
+						((refresh_address & 0x3ff) << 1) |
+						row_bits |
+						((refresh_address & 0x3000) << 2)
+					);
+				target[0] = table[ram_[address]];
+				target[1] = table[ram_[address+1]];
+				target += 2;
+				refresh_address = (refresh_address + 1) & 0x3fff;
+			}
+
+			pixel_pointer_ = reinterpret_cast<uint8_t *>(target);
+			return count;
+		}
+
 		void output_border(int length) {
 			assert(length >= 0);
 
@@ -550,13 +605,7 @@ class CRTCBusHandler {
 			return mapping[colour];
 		}
 
-		enum class OutputMode {
-			Sync,
-			Blank,
-			ColourBurst,
-			Border,
-			Pixels
-		} previous_output_mode_ = OutputMode::Sync;
+		OutputMode previous_output_mode_ = OutputMode::Sync;
 		int cycles_ = 0;
 
 		bool was_hsync_ = false, was_vsync_ = false;
@@ -890,9 +939,21 @@ template <bool has_fdc> class ConcreteMachine:
 			switch(cycle.operation) {
 				case CPU::Z80::PartialMachineCycle::ReadOpcode:
 
-					// TODO: just capturing byte reads as below doesn't seem to do that much in terms of acceleration;
-					// I'm not immediately clear whether that's just because the machine still has to sit through
-					// pilot tone in real time, or just that almost no software uses the ROM loader.
+					// Capture whole-record reads via the firmware jumpblock, provided it hasn't been
+					// repointed; this skips the pilot tone as well as the data.
+					if(
+						use_fast_tape_hack_ &&
+						address == cas_read_address &&
+						read_pointers_[cas_read_address >> 14][cas_read_address & 16383] == 0xcf &&
+						read_tape_record()
+					) {
+						// RET.
+						*cycle.value = 0xc9;
+						break;
+					}
+
+					// Byte reads are captured separately, for software that enters the firmware's tape
+					// routines other than via CAS READ.
 					if(use_fast_tape_hack_ && address == tape_read_byte_address && read_pointers_[0] == roms_[ROMType::OS].data()) {
 						using Parser = Storage::Tape::ZXSpectrum::Parser;
 						Parser parser(Parser::MachineType::AmstradCPC);
@@ -1111,6 +1172,7 @@ template <bool has_fdc> class ConcreteMachine:
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final {
 			fdc_is_sleeping_ = fdc_.preferred_clocking() == ClockingHint::Preference::None;
 			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
+			set_is_loading(!tape_player_is_sleeping_);
 		}
 
 		// MARK: - Keyboard
@@ -1155,6 +1217,8 @@ template <bool has_fdc> class ConcreteMachine:
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = allow_fast_tape_hack_;
+			options->fast_disk = has_fdc && fdc_.get_is_fast_sector_access_enabled();
+			options->fast_mechanics = has_fdc && fdc_.get_is_fast_mechanics_enabled();
 			return options;
 		}
 
@@ -1163,6 +1227,10 @@ template <bool has_fdc> class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 			allow_fast_tape_hack_ = options->quickload;
 			set_use_fast_tape_hack();
+			if constexpr (has_fdc) {
+				fdc_.set_is_fast_sector_access_enabled(options->fast_disk);
+				fdc_.set_is_fast_mechanics_enabled(options->fast_mechanics);
+			}
 		}
 
 		// MARK: - Joysticks
@@ -1246,6 +1314,77 @@ template <bool has_fdc> class ConcreteMachine:
 		static constexpr uint16_t tape_speed_value_address = has_fdc ? 0xb1e7 : 0xbc8f;
 		static constexpr uint16_t tape_crc_address = has_fdc ? 0xb1eb : 0xb8d3;
 		CRC::CCITT tape_crc_;
+
+		// CAS READ's jumpblock entry, which is a RST 1 to the ROM routine unless something has repointed it.
+		static constexpr uint16_t cas_read_address = 0xbca1;
+
+		/*!
+			Performs a CAS READ: finds the next record on the tape with the sync character in A and copies
+			DE bytes of it to HL onwards, as the firmware would.
+
+			@returns @c true if a record was found and passed its CRC checks, in which case registers have been
+				set as per a successful CAS READ; @c false otherwise, in which case the tape is unmoved.
+		*/
+		bool read_tape_record() {
+			const auto tape = tape_player_.get_tape();
+			const uint64_t prior_offset = tape->get_offset();
+
+			const uint8_t sync = uint8_t(z80_.get_value_of_register(CPU::Z80::Register::A));
+			uint16_t target = z80_.get_value_of_register(CPU::Z80::Register::HL);
+			size_t length = z80_.get_value_of_register(CPU::Z80::Register::DE);
+			if(!length) length = 65536;
+
+			using Parser = Storage::Tape::ZXSpectrum::Parser;
+			Parser parser(Parser::MachineType::AmstradCPC);
+
+			// Skip any records with a different sync character, as the firmware would.
+			while(true) {
+				const auto block = parser.find_block(tape);
+				if(!block) {
+					tape->set_offset(prior_offset);
+					return false;
+				}
+				if(block->type == sync) break;
+			}
+
+			// Records are stored as 256-byte segments, each followed by the inverse of its CRC, high byte first.
+			std::vector<uint8_t> contents;
+			contents.reserve(length);
+			while(contents.size() < length) {
+				tape_crc_.reset();
+
+				std::array<uint8_t, 258> segment;
+				for(auto &byte: segment) {
+					const auto next = parser.get_byte(tape);
+					if(!next) {
+						tape->set_offset(prior_offset);
+						return false;
+					}
+					byte = *next;
+				}
+				for(size_t c = 0; c < 256; c++) {
+					tape_crc_.add(segment[c]);
+				}
+				if(uint16_t(~((segment[256] << 8) | segment[257])) != tape_crc_.get_value()) {
+					tape->set_offset(prior_offset);
+					return false;
+				}
+
+				const size_t to_copy = std::min(size_t(256), length - contents.size());
+				contents.insert(contents.end(), segment.begin(), segment.begin() + long(to_copy));
+			}
+
+			for(const auto byte: contents) {
+				write_pointers_[target >> 14][target & 16383] = byte;
+				++target;
+			}
+			tape_player_.complete_pulse();
+
+			// Success is indicated by carry set, zero reset.
+			z80_.set_value_of_register(CPU::Z80::Register::Flags, CPU::Z80::Flag::Carry);
+			return true;
+		}
+
 		bool use_fast_tape_hack_ = false;
 		bool allow_fast_tape_hack_ = false;
 		void set_use_fast_tape_hack() {
@@ -32,18 +32,26 @@ class Machine {
 		class Options:
 			public Reflection::StructImpl<Options>,
 			public Configurable::DisplayOption<Options>,
-			public Configurable::QuickloadOption<Options>
+			public Configurable::QuickloadOption<Options>,
+			public Configurable::FastDiskOption<Options>,
+			public Configurable::FastMechanicsOption<Options>
 		{
 			friend Configurable::DisplayOption<Options>;
 			friend Configurable::QuickloadOption<Options>;
+			friend Configurable::FastDiskOption<Options>;
+			friend Configurable::FastMechanicsOption<Options>;
 			public:
 				Options(Configurable::OptionsType type) :
 					Configurable::DisplayOption<Options>(Configurable::Display::RGB),
-					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly)
+					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly),
+					Configurable::FastDiskOption<Options>(false),
+					Configurable::FastMechanicsOption<Options>(false)
 				{
 					if(needs_declare()) {
 						declare_display_option();
 						declare_quickload_option();
+						declare_fast_disk_option();
+						declare_fast_mechanics_option();
 						limit_enum(&output, Configurable::Display::RGB, Configurable::Display::CompositeColour, -1);
 					}
 				}
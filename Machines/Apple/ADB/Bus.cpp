@@ -69,6 +69,10 @@ void Bus::set_device_output(size_t device_id, bool output) {
 
 		time_in_state_ = HalfCycles(0);
 	}
+
+	// Devices begin and end their output only via calls to set_device_output, or in
+	// response to the events posted above.
+	update_clocking_observer();
 }
 
 void Bus::shift(unsigned int value) {
@@ -101,6 +105,13 @@ bool Bus::get_state() const {
 	return bus_state_.all();
 }
 
+ClockingHint::Preference Bus::preferred_clocking() const {
+	for(auto device: devices_) {
+		if(device->is_advancing()) return ClockingHint::Preference::RealTime;
+	}
+	return ClockingHint::Preference::None;
+}
+
 size_t Bus::add_device() {
 	const size_t id = next_device_id_;
 	++next_device_id_;
@@ -10,6 +10,7 @@
 #define Bus_hpp
 
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../ClockReceiver/ClockingHintSource.hpp"
 
 #include <bitset>
 #include <cstddef>
@@ -93,8 +94,12 @@ inline Command decode_command(uint8_t code) {
 		* reactive devices, which use @c add_device(Device*) and then merely react to
 		@c adb_bus_did_observe_event and @c advance_state in order to
 		update @c set_device_output.
+
+	The bus prefers real-time clocking only while a reactive device is in the process of
+	changing its output; at all other times the data line can change only upon a call to
+	@c set_device_output.
 */
-class Bus {
+class Bus: public ClockingHint::Source {
 	public:
 		Bus(HalfCycles clock_speed);
 
@@ -138,12 +143,21 @@ class Bus {
 			/// to reevaluate its current level. It cannot reliably be used to track the timing between
 			/// observed events.
 			virtual void advance_state(double microseconds, bool current_level) = 0;
+
+			/// @returns @c true if this device may change its output upon a call to @c advance_state;
+			/// @c false otherwise.
+			virtual bool is_advancing() const {
+				return true;
+			}
 		};
 		/*!
 			Adds a device.
 		*/
 		size_t add_device(Device *);
 
+		// ClockingHint::Source.
+		ClockingHint::Preference preferred_clocking() const final;
+
 	private:
 		HalfCycles time_in_state_;
 		mutable HalfCycles time_since_get_state_;
@@ -33,8 +33,8 @@ void ReactiveDevice::advance_state(double microseconds, bool current_level) {
 		if(microseconds_at_bit_ < 240.0) {
 			bus_.set_device_output(device_id_, false);
 		} else {
-			bus_.set_device_output(device_id_, true);
 			phase_ = Phase::AwaitingAttention;
+			bus_.set_device_output(device_id_, true);
 		}
 		return;
 	}
@@ -77,8 +77,8 @@ void ReactiveDevice::advance_state(double microseconds, bool current_level) {
 	// Check for end-of-transmission.
 	const int response_bit_length = int(response_.size() * 8);
 	if(bit_offset_ >= 1 + response_bit_length) {
-		bus_.set_device_output(device_id_, true);
 		response_.clear();
+		bus_.set_device_output(device_id_, true);
 		return;
 	}
 
@@ -98,6 +98,11 @@ void ReactiveDevice::advance_state(double microseconds, bool current_level) {
 	bus_.set_device_output(device_id_, microseconds_at_bit_ > low_periods[bit]);
 }
 
+bool ReactiveDevice::is_advancing() const {
+	// Output changes only while posting a service request or a response.
+	return phase_ == Phase::ServiceRequestPending || !response_.empty();
+}
+
 void ReactiveDevice::adb_bus_did_observe_event(Bus::Event event, uint8_t value) {
 	if(phase_ == Phase::AwaitingAttention) {
 		if(event != Bus::Event::Attention) return;
@@ -32,6 +32,7 @@ class ReactiveDevice: public Bus::Device {
 	private:
 		void advance_state(double microseconds, bool current_level) override;
 		void adb_bus_did_observe_event(Bus::Event event, uint8_t value) override;
+		bool is_advancing() const override;
 
 	private:
 		Bus &bus_;
@@ -107,7 +107,7 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 		uint8_t ram_[65536], aux_ram_[65536];
 		std::vector<uint8_t> rom_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		Audio::Toggle audio_toggle_;
 		Outputs::Speaker::PullLowpass<Audio::Toggle> speaker_;
 		Cycles cycles_since_audio_update_;
@@ -248,28 +248,36 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 			}
 
 			if constexpr (bool(type & PagingType::Main)) {
+				// Software that uses 80STORE toggles PAGE2 constantly to reach alternate columns of the
+				// text screen, so repage only those regions that have actually changed.
 				const auto state = auxiliary_switches_.main_state();
 
-				page(0x02, 0x04,
-					state.base.read ? &aux_ram_[0x0200] : &ram_[0x0200],
-					state.base.write ? &aux_ram_[0x0200] : &ram_[0x0200]);
-				page(0x08, 0x20,
-					state.base.read ? &aux_ram_[0x0800] : &ram_[0x0800],
-					state.base.write ? &aux_ram_[0x0800] : &ram_[0x0800]);
-				page(0x40, 0xc0,
-					state.base.read ? &aux_ram_[0x4000] : &ram_[0x4000],
-					state.base.write ? &aux_ram_[0x4000] : &ram_[0x4000]);
-
-				page(0x04, 0x08,
-					state.region_04_08.read ? &aux_ram_[0x0400] : &ram_[0x0400],
-					state.region_04_08.write ? &aux_ram_[0x0400] : &ram_[0x0400]);
-
-				page(0x20, 0x40,
-					state.region_20_40.read ? &aux_ram_[0x2000] : &ram_[0x2000],
-					state.region_20_40.write ? &aux_ram_[0x2000] : &ram_[0x2000]);
+				if(!main_is_paged_ || state.base != paged_main_state_.base) {
+					page_main_region(0x02, 0x04, state.base);
+					page_main_region(0x08, 0x20, state.base);
+					page_main_region(0x40, 0xc0, state.base);
+				}
+				if(!main_is_paged_ || state.region_04_08 != paged_main_state_.region_04_08) {
+					page_main_region(0x04, 0x08, state.region_04_08);
+				}
+				if(!main_is_paged_ || state.region_20_40 != paged_main_state_.region_20_40) {
+					page_main_region(0x20, 0x40, state.region_20_40);
+				}
+
+				paged_main_state_ = state;
+				main_is_paged_ = true;
 			}
 		}
 
+		using MainState = typename AuxiliaryMemorySwitches<ConcreteMachine>::MainState;
+		MainState paged_main_state_;
+		bool main_is_paged_ = false;
+		void page_main_region(int start, int end, const typename MainState::Region &region) {
+			page(start, end,
+				region.read ? &aux_ram_[start << 8] : &ram_[start << 8],
+				region.write ? &aux_ram_[start << 8] : &ram_[start << 8]);
+		}
+
 		// MARK: - Keyboard and typing.
 
 		struct Keyboard: public Inputs::Keyboard {
@@ -574,7 +582,8 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 					if(write_pages_[address >> 8]) write_pages_[address >> 8][address & 0xff] = *value;
 				}
 
-				if(is_iie()) {
+				// Only accesses within $C300–$CFFF, which will be to ROM, affect the auxiliary switches here.
+				if(is_iie() && (address & 0xf000) == 0xc000) {
 					auxiliary_switches_.access(address, isReadOperation(operation));
 				}
 			} else {
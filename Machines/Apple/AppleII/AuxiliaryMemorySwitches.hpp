@@ -39,6 +39,10 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 				bool read = false;
 				/// @c true indicates auxiliary memory should be written to; @c false indicates main.
 				bool write = false;
+
+				bool operator != (const Region &rhs) const {
+					return read != rhs.read || write != rhs.write;
+				}
 			};
 
 			/// Describes banking state in the ranges $0200–$03FF, $0800–$1FFF and $4000–$BFFF.
@@ -49,10 +53,7 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 			Region region_20_40;
 
 			bool operator != (const MainState &rhs) const {
-				return
-					base.read != rhs.base.read || base.write != rhs.base.write ||
-					region_04_08.read != rhs.region_04_08.read || region_04_08.write != rhs.region_04_08.write ||
-					region_20_40.read != rhs.region_20_40.read || region_20_40.write != rhs.region_20_40.write;
+				return base != rhs.base || region_04_08 != rhs.region_04_08 || region_20_40 != rhs.region_20_40;
 			}
 		};
 
@@ -100,9 +101,13 @@ template <typename Machine> class AuxiliaryMemorySwitches {
 		/// in $C054 to $C058, or in the range $C300 to $CFFF. Safe to call for any [16-bit] address.
 		void access(uint16_t address, bool is_read) {
 			if(address >= 0xc300 && address < 0xd000) {
-				switches_.internal_C8_rom |= ((address >> 8) == 0xc3) && !switches_.slot_C3_rom;
-				switches_.internal_C8_rom &= (address != 0xcfff);
-				set_card_paging();
+				const bool internal_C8_rom =
+					(switches_.internal_C8_rom || (((address >> 8) == 0xc3) && !switches_.slot_C3_rom)) &&
+					(address != 0xcfff);
+				if(internal_C8_rom != switches_.internal_C8_rom) {
+					switches_.internal_C8_rom = internal_C8_rom;
+					set_card_paging();
+				}
 				return;
 			}
 
@@ -8,8 +8,66 @@
 
 #include "Video.hpp"
 
+#include <array>
+#include <cstring>
+
 using namespace Apple::II::Video;
 
+namespace {
+
+// Output for each video mode is generated by table lookup; each table maps a source byte, nibble or
+// character pattern to the output it produces, which is a single level per 14Mhz sample.
+
+template <size_t count, size_t length, typename GeneratorT>
+constexpr std::array<std::array<uint8_t, length>, count> make_pixel_table(GeneratorT generator) {
+	std::array<std::array<uint8_t, length>, count> table{};
+	for(size_t index = 0; index < count; ++index) {
+		for(size_t sample = 0; sample < length; ++sample) {
+			table[index][sample] = uint8_t(generator(int(index), int(sample)));
+		}
+	}
+	return table;
+}
+
+/// Indexed by the low seven bits of a character pattern; the character ROM is output MSB to LSB
+/// rather than LSB to MSB, with each pixel lasting two samples.
+constexpr auto text_pixels = make_pixel_table<128, 14>([](int pattern, int sample) {
+	return pattern & (0x40 >> (sample >> 1));
+});
+
+/// As per text_pixels, but with each pixel lasting a single sample.
+constexpr auto half_text_pixels = make_pixel_table<128, 7>([](int pattern, int sample) {
+	return pattern & (0x40 >> sample);
+});
+
+/// Indexed by [column parity][colour nibble]; the colour code is shifted out on a loop, that loop having to
+/// account for whether the output window is starting at the beginning of a colour cycle or halfway through.
+constexpr auto low_resolution_pixels = make_pixel_table<32, 14>([](int index, int sample) {
+	const int phase = (index & 0x10) ? 2 : 0;
+	return index & 0xf & (1 << ((sample + phase) & 3));
+});
+
+/// Indexed by colour nibble.
+constexpr auto fat_low_resolution_pixels = make_pixel_table<16, 14>([](int nibble, int sample) {
+	return nibble & (1 << ((sample >> 1) & 3));
+});
+
+/// Indexed by a source byte with the delay bit possibly masked off; the first sample of
+/// delayed bytes is left as zero, to be replaced by the previous output level.
+constexpr auto high_resolution_pixels = make_pixel_table<256, 14>([](int source, int sample) {
+	if(source & 0x80) {
+		return sample ? source & (1 << ((sample - 1) >> 1)) : 0;
+	}
+	return source & (1 << (sample >> 1));
+});
+
+/// Indexed by the low seven bits of a source byte, with each pixel lasting a single sample.
+constexpr auto half_high_resolution_pixels = make_pixel_table<128, 7>([](int source, int sample) {
+	return source & (1 << sample);
+});
+
+}
+
 VideoBase::VideoBase(bool is_iie, std::function<void(Cycles)> &&target) :
 	VideoSwitches<Cycles>(is_iie, Cycles(2), std::move(target)),
 	crt_(910, 1, Outputs::Display::Type::NTSC60, Outputs::Display::InputDataType::Luminance1),
@@ -83,15 +141,9 @@ void VideoBase::output_text(uint8_t *target, const uint8_t *const source, size_t
 		const std::size_t character_address = size_t(character << 3) + pixel_row;
 		const uint8_t character_pattern = character_rom_[character_address] ^ xor_mask;
 
-		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = target[1] = character_pattern & 0x40;
-		target[2] = target[3] = character_pattern & 0x20;
-		target[4] = target[5] = character_pattern & 0x10;
-		target[6] = target[7] = character_pattern & 0x08;
-		target[8] = target[9] = character_pattern & 0x04;
-		target[10] = target[11] = character_pattern & 0x02;
-		target[12] = target[13] = character_pattern & 0x01;
-		graphics_carry_ = character_pattern & 0x01;
+		const auto &pixels = text_pixels[character_pattern & 0x7f];
+		std::memcpy(target, pixels.data(), 14);
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
@@ -116,22 +168,10 @@ void VideoBase::output_double_text(uint8_t *target, const uint8_t *const source,
 			)
 		};
 
-		// The character ROM is output MSB to LSB rather than LSB to MSB.
-		target[0] = character_patterns[0] & 0x40;
-		target[1] = character_patterns[0] & 0x20;
-		target[2] = character_patterns[0] & 0x10;
-		target[3] = character_patterns[0] & 0x08;
-		target[4] = character_patterns[0] & 0x04;
-		target[5] = character_patterns[0] & 0x02;
-		target[6] = character_patterns[0] & 0x01;
-		target[7] = character_patterns[1] & 0x40;
-		target[8] = character_patterns[1] & 0x20;
-		target[9] = character_patterns[1] & 0x10;
-		target[10] = character_patterns[1] & 0x08;
-		target[11] = character_patterns[1] & 0x04;
-		target[12] = character_patterns[1] & 0x02;
-		target[13] = character_patterns[1] & 0x01;
-		graphics_carry_ = character_patterns[1] & 0x01;
+		const auto &pixels = half_text_pixels[character_patterns[1] & 0x7f];
+		std::memcpy(target, half_text_pixels[character_patterns[0] & 0x7f].data(), 7);
+		std::memcpy(target + 7, pixels.data(), 7);
+		graphics_carry_ = pixels[6];
 		target += 14;
 	}
 }
@@ -141,19 +181,9 @@ void VideoBase::output_low_resolution(uint8_t *target, const uint8_t *const sour
 	for(size_t c = 0; c < length; ++c) {
 		// Low-resolution graphics mode shifts the colour code on a loop, but has to account for whether this
 		// 14-sample output window is starting at the beginning of a colour cycle or halfway through.
-		if((column + int(c))&1) {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 4;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 8;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 1;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 2;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = target[8] = target[12] = (source[c] >> row_shift) & 1;
-			target[1] = target[5] = target[9] = target[13] = (source[c] >> row_shift) & 2;
-			target[2] = target[6] = target[10] = (source[c] >> row_shift) & 4;
-			target[3] = target[7] = target[11] = (source[c] >> row_shift) & 8;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		const auto &pixels = low_resolution_pixels[(((column + int(c)) & 1) << 4) | ((source[c] >> row_shift) & 0xf)];
+		std::memcpy(target, pixels.data(), 14);
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
@@ -163,11 +193,9 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 	for(size_t c = 0; c < length; ++c) {
 		// Fat low-resolution mode appears not to do anything to try to make odd and
 		// even columns compatible.
-		target[0] = target[1] = target[8] = target[9] = (source[c] >> row_shift) & 1;
-		target[2] = target[3] = target[10] = target[11] = (source[c] >> row_shift) & 2;
-		target[4] = target[5] = target[12] = target[13] = (source[c] >> row_shift) & 4;
-		target[6] = target[7] = (source[c] >> row_shift) & 8;
-		graphics_carry_ = (source[c] >> row_shift) & 4;
+		const auto &pixels = fat_low_resolution_pixels[(source[c] >> row_shift) & 0xf];
+		std::memcpy(target, pixels.data(), 14);
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
@@ -175,29 +203,13 @@ void VideoBase::output_fat_low_resolution(uint8_t *target, const uint8_t *const
 void VideoBase::output_double_low_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length, int column, int row) const {
 	const int row_shift = row&4;
 	for(size_t c = 0; c < length; ++c) {
-		if((column + int(c))&1) {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 4;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 8;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 1;
-			target[3] = (auxiliary_source[c] >> row_shift) & 2;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 8;
-			target[9] = target[13] = (source[c] >> row_shift) & 1;
-			target[10] = (source[c] >> row_shift) & 2;
-			target[7] = target[11] = (source[c] >> row_shift) & 4;
-			graphics_carry_ = (source[c] >> row_shift) & 8;
-		} else {
-			target[0] = target[4] = (auxiliary_source[c] >> row_shift) & 1;
-			target[1] = target[5] = (auxiliary_source[c] >> row_shift) & 2;
-			target[2] = target[6] = (auxiliary_source[c] >> row_shift) & 4;
-			target[3] = (auxiliary_source[c] >> row_shift) & 8;
-
-			target[8] = target[12] = (source[c] >> row_shift) & 2;
-			target[9] = target[13] = (source[c] >> row_shift) & 4;
-			target[10] = (source[c] >> row_shift) & 8;
-			target[7] = target[11] = (source[c] >> row_shift) & 1;
-			graphics_carry_ = (source[c] >> row_shift) & 2;
-		}
+		// Each half of the window follows the same pattern as the first half of a
+		// regular low-resolution window.
+		const int phase = ((column + int(c)) & 1) << 4;
+		const auto &pixels = low_resolution_pixels[phase | ((source[c] >> row_shift) & 0xf)];
+		std::memcpy(target, low_resolution_pixels[phase | ((auxiliary_source[c] >> row_shift) & 0xf)].data(), 7);
+		std::memcpy(target + 7, pixels.data(), 7);
+		graphics_carry_ = pixels[1];	// i.e. the same bit of the main nibble as carries in regular low resolution.
 		target += 14;
 	}
 }
@@ -208,47 +220,23 @@ void VideoBase::output_high_resolution(uint8_t *target, const uint8_t *const sou
 		// If there is a delay, the previous output level is held to bridge the gap.
 		// Delays may be ignored on a IIe if Annunciator 3 is set; that's the state that
 		// high_resolution_mask_ models.
+		const auto &pixels = high_resolution_pixels[source[c] & (high_resolution_mask_ | 0x7f)];
+		std::memcpy(target, pixels.data(), 14);
 		if(source[c] & high_resolution_mask_ & 0x80) {
 			target[0] = graphics_carry_;
-			target[1] = target[2] = source[c] & 0x01;
-			target[3] = target[4] = source[c] & 0x02;
-			target[5] = target[6] = source[c] & 0x04;
-			target[7] = target[8] = source[c] & 0x08;
-			target[9] = target[10] = source[c] & 0x10;
-			target[11] = target[12] = source[c] & 0x20;
-			target[13] = source[c] & 0x40;
-		} else {
-			target[0] = target[1] = source[c] & 0x01;
-			target[2] = target[3] = source[c] & 0x02;
-			target[4] = target[5] = source[c] & 0x04;
-			target[6] = target[7] = source[c] & 0x08;
-			target[8] = target[9] = source[c] & 0x10;
-			target[10] = target[11] = source[c] & 0x20;
-			target[12] = target[13] = source[c] & 0x40;
 		}
-		graphics_carry_ = source[c] & 0x40;
+		graphics_carry_ = pixels[13];
 		target += 14;
 	}
 }
 
 void VideoBase::output_double_high_resolution(uint8_t *target, const uint8_t *const source, const uint8_t *const auxiliary_source, size_t length) const {
 	for(size_t c = 0; c < length; ++c) {
-		target[0] = auxiliary_source[c] & 0x01;
-		target[1] = auxiliary_source[c] & 0x02;
-		target[2] = auxiliary_source[c] & 0x04;
-		target[3] = auxiliary_source[c] & 0x08;
-		target[4] = auxiliary_source[c] & 0x10;
-		target[5] = auxiliary_source[c] & 0x20;
-		target[6] = auxiliary_source[c] & 0x40;
-		target[7] = source[c] & 0x01;
-		target[8] = source[c] & 0x02;
-		target[9] = source[c] & 0x04;
-		target[10] = source[c] & 0x08;
-		target[11] = source[c] & 0x10;
-		target[12] = source[c] & 0x20;
-		target[13] = source[c] & 0x40;
-
-		graphics_carry_ = auxiliary_source[c] & 0x40;
+		const auto &auxiliary_pixels = half_high_resolution_pixels[auxiliary_source[c] & 0x7f];
+		std::memcpy(target, auxiliary_pixels.data(), 7);
+		std::memcpy(target + 7, half_high_resolution_pixels[source[c] & 0x7f].data(), 7);
+
+		graphics_carry_ = auxiliary_pixels[6];
 		target += 14;
 	}
 }
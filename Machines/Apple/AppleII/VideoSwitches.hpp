@@ -293,7 +293,7 @@ template <typename TimeUnit> class VideoSwitches {
 	private:
 		// Maintain a DeferredQueue for delayed mode switches.
 		const TimeUnit delay_;
-		DeferredQueuePerformer<TimeUnit> deferrer_;
+		DeferredQueuePerformer<TimeUnit, InlineDeferredQueue<TimeUnit>> deferrer_;
 
 		struct Switches {
 			bool alternative_character_set = false;
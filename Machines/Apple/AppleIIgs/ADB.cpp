@@ -281,6 +281,12 @@ uint8_t GLU::get_port_input(int port) {
 	return 0xff;
 }
 
+bool GLU::get_port_inputs_are_static() {
+	// The only input that varies other than in response to the microcontroller
+	// is the ADB data line, which won't while no device is transmitting.
+	return bus_.preferred_clocking() == ClockingHint::Preference::None;
+}
+
 void GLU::run_ports_for(Cycles cycles) {
 	bus_.run_for(cycles);
 }
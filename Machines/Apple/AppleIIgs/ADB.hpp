@@ -62,6 +62,7 @@ class GLU: public InstructionSet::M50740::PortHandler {
 		void run_ports_for(Cycles) override;
 		void set_port_output(int port, uint8_t value) override;
 		uint8_t get_port_input(int port) override;
+		bool get_port_inputs_are_static() override;
 
 		uint8_t registers_[16]{};
 
@@ -32,6 +32,7 @@
 #include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 
 #include "../../Utility/MemoryFuzzer.hpp"
+#include "../../Utility/LargeMemory.hpp"
 
 #include "../../../ClockReceiver/JustInTime.hpp"
 
@@ -189,6 +190,7 @@ class ConcreteMachine:
 	public Activity::Source,
 	public Apple::IIgs::Machine,
 	public MachineTypes::AudioProducer,
+	public MachineTypes::BusTraceable,
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
@@ -373,6 +375,15 @@ class ConcreteMachine:
 			return true;
 		}
 
+		// MARK: BusTraceable
+		CPU::BusTrace::Bus traced_bus() const final {
+			return CPU::BusTrace::Bus::WDC65816;
+		}
+
+		void set_bus_trace(CPU::BusTrace *trace) final {
+			m65816_.set_bus_trace(trace);
+		}
+
 		// MARK: Activity::Source
 		void set_activity_observer(Activity::Observer *observer) final {
 			drives35_[0].set_activity_observer(observer, "First 3.5\" Drive", true);
@@ -959,7 +970,12 @@ class ConcreteMachine:
 
 					// Use a very broad test for flushing video: any write to $e0 or $e1, or any write that is shadowed.
 					// TODO: at least restrict the e0/e1 test to possible video buffers!
-					if((address >= 0xe0'0400 && address < 0xe1'a000) || is_shadowed) {
+					//
+					// No flush is necessary though if the video won't fetch anything before it is next flushed anyway.
+					if(
+						((address >= 0xe0'0400 && address < 0xe1'a000) || is_shadowed) &&
+						video_.last_valid()->may_fetch_before_sequence_point()
+					) {
 						video_.flush();
 					}
 
@@ -1135,7 +1151,7 @@ class ConcreteMachine:
 
 		// MARK: - Memory storage.
 
-		std::vector<uint8_t> ram_;
+		Memory::LargeVector<uint8_t> ram_;
 		std::vector<uint8_t> rom_;
 		uint8_t c037_ = 0;
 
@@ -1151,7 +1167,7 @@ class ConcreteMachine:
 		Apple::Disk::DiskIIDrive drives525_[2];
 
 		// The audio parts.
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		Apple::IIgs::Sound::GLU sound_glu_;
 		Audio::Toggle audio_toggle_;
 		using AudioSource = Outputs::Speaker::CompoundSource<Apple::IIgs::Sound::GLU, Audio::Toggle>;
@@ -15,6 +15,7 @@
 
 #include "../AppleII/LanguageCardSwitches.hpp"
 #include "../AppleII/AuxiliaryMemorySwitches.hpp"
+#include "../../Utility/LargeMemory.hpp"
 
 namespace Apple {
 namespace IIgs {
@@ -30,7 +31,7 @@ class MemoryMap {
 			setup_shadow_maps(is_rom03);
 		}
 
-		void set_storage(std::vector<uint8_t> &ram, std::vector<uint8_t> &rom) {
+		void set_storage(Memory::LargeVector<uint8_t> &ram, std::vector<uint8_t> &rom) {
 			// Keep a pointer for later; also note the proper RAM offset.
 			ram_base = ram.data();
 			shadow_base[0] = ram_base;						// i.e. all unshadowed writes go to where they've already gone (to make a no-op).
@@ -180,6 +181,7 @@ class MemoryMap {
 
 			// Set shadowing as working from banks 0 and 1 (forever).
 			shadow_banks[0] = true;
+			update_shadowed_pages();
 
 			// TODO: set 1Mhz flags.
 
@@ -213,6 +215,7 @@ class MemoryMap {
 			for(size_t c = 0x01; c < 0x40; c++) {
 				shadow_banks[c] = speed_register_ & 0x10;
 			}
+			update_shadowed_pages();
 		}
 
 		void set_state_register(uint8_t value) {
@@ -545,6 +548,16 @@ class MemoryMap {
 					shadow_pages |= shadow_superhighres;
 				}
 			}
+
+			update_shadowed_pages();
+		}
+
+		// Recomputes shadowed_pages from shadow_pages and shadow_banks; this must be
+		// called whenever either of those changes.
+		void update_shadowed_pages() {
+			for(size_t c = 0; c < shadowed_pages.size(); c++) {
+				shadowed_pages[c] = shadow_pages[c & 127] & shadow_banks[c >> 7];
+			}
 		}
 
 		void print_state() {
@@ -635,6 +648,11 @@ class MemoryMap {
 		// each is a potential source of shadowing.
 		std::bitset<128> shadow_pages{}, shadow_banks{};
 
+		// Shadowed_pages: divides the whole 16mb of memory into 1kb chunks and includes a flag to indicate whether
+		// each is shadowed, i.e. the combination of shadow_pages and shadow_banks above, so that a write need
+		// perform only a single lookup.
+		std::bitset<16384> shadowed_pages{};
+
 		std::array<Region, 40> regions;	// An assert above ensures that this is large enough; there's no
 										// doctrinal reason for it to be whatever size it is now, just
 										// adjust as required.
@@ -664,7 +682,7 @@ class MemoryMap {
 #else
 
 #define IsShadowed(map, region, address)	\
-	(map.shadow_pages[(address >> 10) & 127] & map.shadow_banks[address >> 17])
+	(map.shadowed_pages[address >> 10])
 
 #define MemoryMapWrite(map, region, address, value) \
 	if(region.write) {	\
@@ -8,6 +8,8 @@
 
 #include "Sound.hpp"
 
+#include "../../../Numeric/LeadingZeros.hpp"
+
 #include <cassert>
 #include <cstdio>
 #include <numeric>
@@ -37,7 +39,7 @@ void GLU::set_data(uint8_t data) {
 		write.time = pending_store_write_time_;
 		pending_stores_[pending_store_write_].store(write, std::memory_order::memory_order_release);
 
-		pending_store_write_ = (pending_store_write_ + 1) % (StoreBufferSize - 1);
+		pending_store_write_ = (pending_store_write_ + 1) & (StoreBufferSize - 1);
 	} else {
 		// Register access.
 		const auto address = address_;	// To make sure I don't inadvertently 'capture' address_.
@@ -68,6 +70,7 @@ void GLU::EnsoniqState::set_register(uint16_t address, uint8_t value) {
 		break;
 		case 0x80:
 			oscillators[address & 0x1f].address = value;
+			oscillators[address & 0x1f].update_table();
 		break;
 		case 0xa0: {
 			oscillators[address & 0x1f].control = value;
@@ -82,6 +85,7 @@ void GLU::EnsoniqState::set_register(uint16_t address, uint8_t value) {
 
 			// The most-significant bit that should be used is 16 + (value & 7).
 			oscillators[address & 0x1f].overflow_mask = ~(0xffffff >> (7 - (value & 7)));
+			oscillators[address & 0x1f].update_table();
 		break;
 
 		default:
@@ -259,18 +263,31 @@ void GLU::skip_audio(EnsoniqState &state, size_t number_of_samples) {
 void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 	auto next_store = pending_stores_[pending_store_read_].load(std::memory_order::memory_order_acquire);
 	uint8_t next_amplitude = 255;
+
+	// Keep a mask of oscillators that are both in use and running, so that halted
+	// oscillators cost nothing. Only this loop can start or halt an oscillator
+	// until it returns.
+	const uint32_t oscillators_in_use = remote_.oscillator_count == 32 ? 0xffff'ffff : (1u << remote_.oscillator_count) - 1;
+	uint32_t running = 0;
+	for(int c = 0; c < remote_.oscillator_count; c++) {
+		running |= (~remote_.oscillators[c].control & 1) << c;
+	}
+
 	for(size_t sample = 0; sample < number_of_samples; sample++) {
 
 		// TODO: there's a bit of a hack here where it is assumed that the input clock has been
 		// divided in advance. Real hardware divides by 8, I think?
 
-		// Seed output as 0.
+		// Seed output as 0; amplitude modulation doesn't carry from one sample to the next.
 		int output = 0;
+		next_amplitude = 255;
 
-		// Apply phase updates to all enabled oscillators.
-		for(int c = 0; c < remote_.oscillator_count; c++) {
-			// Don't do anything for halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+		// Apply phase updates to all running oscillators, in ascending order.
+		uint32_t pending = running;
+		while(pending) {
+			const uint32_t bit = pending & (~pending + 1);
+			const int c = 63 - Numeric::leading_zeros(bit);
+			pending ^= bit;
 
 			remote_.oscillators[c].position += remote_.oscillators[c].velocity;
 
@@ -278,7 +295,6 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 			switch(remote_.oscillators[c].control & 6) {
 				case 0:	// Free-run mode; don't truncate the position at all, in case the
 						// accumulator bits in use changes.
-					output += remote_.oscillators[c].output(remote_.ram_);
 				break;
 
 				case 2:	// One-shot mode; check for end of run. Otherwise update sample.
@@ -311,16 +327,30 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 						remote_.oscillators[c].control |= 1;
 						remote_.oscillators[c].position = 0;
 						remote_.oscillators[c^1].control &= ~1;
+
+						// The partner runs from now on if in use; if it follows this oscillator
+						// then it also runs for this sample.
+						const uint32_t partner = (1u << (c^1)) & oscillators_in_use;
+						running |= partner;
+						if((c^1) > c) pending |= partner;
 					}
 				break;
 			}
 
 			// Don't add output for newly-halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+			if(remote_.oscillators[c].control&1) {
+				running &= ~bit;
+				continue;
+			}
 
 			// Append new output.
 			output += (remote_.oscillators[c].output(remote_.ram_) * next_amplitude) / 255;
 			next_amplitude = 255;
+
+			// Output may have halted the oscillator.
+			if(remote_.oscillators[c].control&1) {
+				running &= ~bit;
+			}
 		}
 
 		// Maximum total output was 32 channels times a 16-bit range. Map that down.
@@ -329,31 +359,36 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 
 		// Apply any RAM writes that interleave here.
 		++pending_store_read_time_;
-		if(!next_store.enabled) continue;
-		if(next_store.time != pending_store_read_time_) continue;
-		remote_.ram_[next_store.address] = next_store.value;
-		next_store.enabled = false;
-		pending_stores_[pending_store_read_].store(next_store, std::memory_order::memory_order_relaxed);
-		pending_store_read_ = (pending_store_read_ + 1) & (StoreBufferSize - 1);
+		while(next_store.enabled && next_store.time <= pending_store_read_time_) {
+			remote_.ram_[next_store.address] = next_store.value;
+			next_store.enabled = false;
+			pending_stores_[pending_store_read_].store(next_store, std::memory_order::memory_order_relaxed);
+			pending_store_read_ = (pending_store_read_ + 1) & (StoreBufferSize - 1);
+			next_store = pending_stores_[pending_store_read_].load(std::memory_order::memory_order_acquire);
+		}
 	}
 }
 
-uint8_t GLU::EnsoniqState::Oscillator::sample(uint8_t *ram) {
+void GLU::EnsoniqState::Oscillator::update_table() {
 	// Determines how many you'd have to shift a 16-bit pointer to the right for,
 	// in order to hit only the position-supplied bits.
 	const int pointer_shift = 8 - ((table_size >> 3) & 7);
 
 	// Table size mask should be 0x8000 for the largest table size, and 0xff00 for
 	// the smallest.
-	const uint16_t table_size_mask = 0xffff >> pointer_shift;
+	table_mask = 0xffff >> pointer_shift;
 
 	// The pointer should use (at most) 15 bits; starting with bit 1 for resolution 0
 	// and starting at bit 8 for resolution 7.
-	const uint16_t table_pointer = uint16_t(position >> ((table_size&7) + pointer_shift));
+	table_shift = (table_size&7) + pointer_shift;
 
 	// The full pointer is composed of the bits of the programmed address not touched by
 	// the table pointer, plus the table pointer.
-	const uint16_t sample_address = ((address << 8) & ~table_size_mask) | (table_pointer & table_size_mask);
+	table_base = (address << 8) & ~table_mask;
+}
+
+uint8_t GLU::EnsoniqState::Oscillator::sample(uint8_t *ram) {
+	const uint16_t sample_address = table_base | (uint16_t(position >> table_shift) & table_mask);
 
 	// Ignored here: bit 6 should select between RAM banks. But for now this is IIgs-centric,
 	// and that has only one bank of RAM.
@@ -67,25 +67,29 @@ class GLU: public Outputs::Speaker::SampleSource {
 		// Maintain state both 'locally' (i.e. on the emulation thread) and
 		// 'remotely' (i.e. on the audio thread).
 		struct EnsoniqState {
-			uint8_t ram_[65536];
+			uint8_t ram_[65536]{};
 			struct Oscillator {
-				uint32_t position;
+				uint32_t position = 0;
 
 				// Programmer-set values.
-				uint16_t velocity;
-				uint8_t volume;
-				uint8_t address;
-				uint8_t control;
-				uint8_t table_size;
+				uint16_t velocity = 0;
+				uint8_t volume = 0;
+				uint8_t address = 0;
+				uint8_t control = 0;
+				uint8_t table_size = 0;
 
 				// Derived state.
-				uint32_t overflow_mask;			// If a non-zero bit gets anywhere into the overflow mask, this channel
+				uint32_t overflow_mask = 0;		// If a non-zero bit gets anywhere into the overflow mask, this channel
 												// has wrapped around. It's a function of table_size.
+				int table_shift = 8;			// The shift from position to table pointer, the mask applied to the table
+				uint16_t table_mask = 0x00ff;	// pointer and the fixed part of each sample address, per address and
+				uint16_t table_base = 0x0000;	// table_size; see update_table.
 				bool interrupt_request = false;	// Will be non-zero if this channel would request an interrupt, were
 												// it currently enabled to do so.
 
 				uint8_t sample(uint8_t *ram);
 				int16_t output(uint8_t *ram);
+				void update_table();
 			} oscillators[32];
 
 			// Some of these aren't actually needed on both threads.
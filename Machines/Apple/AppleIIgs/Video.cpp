@@ -8,6 +8,12 @@
 
 #include "Video.hpp"
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 using namespace Apple::IIgs::Video;
 
 namespace {
@@ -76,6 +82,7 @@ constexpr int right_border_ticks = 8;
 
 constexpr int start_of_left_border = blank_ticks;
 constexpr int start_of_pixels = start_of_left_border + left_border_ticks;
+constexpr int start_of_fetch = start_of_pixels - 1;	// The pixel buffer is allocated, and the first fetch made, a column early.
 constexpr int start_of_right_border = start_of_pixels + pixel_ticks;
 constexpr int start_of_sync = start_of_right_border + right_border_ticks;
 constexpr int sync_period = CyclesPerLine - start_of_sync*CyclesPerTick;
@@ -197,13 +204,19 @@ Cycles Video::get_next_sequence_point() const {
 
 	constexpr int sequence_point_offset = (blank_ticks + left_border_ticks) * CyclesPerTick;
 
+	// The start of fetching is also a sequence point, though it has no effect on interrupts,
+	// so that RAM can be modified without flushing while fetching is known not to occur.
+	// See may_fetch_before_sequence_point.
+	constexpr int fetch_offset = start_of_fetch * CyclesPerTick;
+
 	// Seed as the distance to the next row 0.
-	int result = CyclesPerLine + sequence_point_offset - cycles_into_row + (Lines - row - 1)*CyclesPerLine;
+	int result = CyclesPerLine + fetch_offset - cycles_into_row + (Lines - row - 1)*CyclesPerLine;
 
 	// Replace with the start of the next line, if closer.
 	if(row <= 200) {
+		if(cycles_into_row < fetch_offset) return Cycles(fetch_offset - cycles_into_row);
 		if(cycles_into_row < sequence_point_offset) return Cycles(sequence_point_offset - cycles_into_row);
-		if(row < 200) result = CyclesPerLine + sequence_point_offset - cycles_into_row;
+		if(row < 200) result = CyclesPerLine + fetch_offset - cycles_into_row;
 	}
 
 	// Replace with the next Mega II interrupt point if those are enabled and it is sooner.
@@ -217,6 +230,14 @@ Cycles Video::get_next_sequence_point() const {
 	return Cycles(result);
 }
 
+bool Video::may_fetch_before_sequence_point() const {
+	// Fetching occurs only from the start of fetch to the right border of the first 200 rows, and
+	// the start of fetch is always a sequence point.
+	const int row = cycles_into_frame_ / CyclesPerLine;
+	const int column = (cycles_into_frame_ % CyclesPerLine) / CyclesPerTick;
+	return row < 200 && column >= start_of_fetch && column < start_of_right_border;
+}
+
 void Video::output_row(int row, int start, int end) {
 
 	// Deal with vertical sync.
@@ -241,7 +262,7 @@ void Video::output_row(int row, int start, int end) {
 
 	// The pixel buffer will actually be allocated a column early, to allow double high/low res to start
 	// half a column before everything else.
-	constexpr int pixel_buffer_allocation = start_of_pixels - 1;
+	constexpr int pixel_buffer_allocation = start_of_fetch;
 
 	// Possibly output border, pixels, border, if this is a pixel line.
 	if(row < 192 + ((new_video_&0x80) >> 4)) {	// i.e. 192 lines for classic Apple II video, 200 for IIgs video.
@@ -602,25 +623,105 @@ uint16_t *Video::output_double_text(uint16_t *target, int start, int end, int ro
 
 uint16_t *Video::output_super_high_res(uint16_t *target, int start, int end, int row) const {
 	const int row_address = row * 160 + 0x12000;
+	const uint8_t *source = &ram_[row_address + start * 4];
+	const uint8_t *const source_end = &ram_[row_address + end * 4];
+
+	// Fill mode is handled as a separate pass. The palette_zero_ writes ensure that palette colour 0
+	// is replaced by whatever was last output.
+	if(line_control_ & 0x20) {
+		if(line_control_ & 0x80) {
+			while(source != source_end) {
+				*palette_zero_[3] = target[0] = palette_[0x8 + ((*source >> 6) & 0x3)];
+				*palette_zero_[0] = target[1] = palette_[0xc + ((*source >> 4) & 0x3)];
+				*palette_zero_[1] = target[2] = palette_[0x0 + ((*source >> 2) & 0x3)];
+				*palette_zero_[2] = target[3] = palette_[0x4 + ((*source >> 0) & 0x3)];
+				target += 4;
+				++source;
+			}
+		} else {
+			while(source != source_end) {
+				*palette_zero_[0] = target[0] = palette_[(*source >> 4) & 0xf];
+				*palette_zero_[0] = target[1] = palette_[*source & 0xf];
+				target += 2;
+				++source;
+			}
+		}
+		return target;
+	}
 
-	// The palette_zero_ writes ensure that palette colour 0 is replaced by whatever was last output,
-	// if fill mode is enabled. Otherwise they go to throwaway storage.
 	if(line_control_ & 0x80) {
-		for(int c = start * 4; c < end * 4; c++) {
-			const uint8_t source = ram_[row_address + c];
-			*palette_zero_[3] = target[0] = palette_[0x8 + ((source >> 6) & 0x3)];
-			*palette_zero_[0] = target[1] = palette_[0xc + ((source >> 4) & 0x3)];
-			*palette_zero_[1] = target[2] = palette_[0x0 + ((source >> 2) & 0x3)];
-			*palette_zero_[2] = target[3] = palette_[0x4 + ((source >> 0) & 0x3)];
+		while(source != source_end) {
+			target[0] = palette_[0x8 + ((*source >> 6) & 0x3)];
+			target[1] = palette_[0xc + ((*source >> 4) & 0x3)];
+			target[2] = palette_[0x0 + ((*source >> 2) & 0x3)];
+			target[3] = palette_[0x4 + ((*source >> 0) & 0x3)];
 			target += 4;
+			++source;
 		}
-	} else {
-		for(int c = start * 4; c < end * 4; c++) {
-			const uint8_t source = ram_[row_address + c];
-			*palette_zero_[0] = target[0] = palette_[(source >> 4) & 0xf];
-			*palette_zero_[0] = target[1] = palette_[source & 0xf];
-			target += 2;
+		return target;
+	}
+
+	// In 320 mode each nibble is a palette index, so a vector table lookup can map sixteen of them
+	// at a time: split the palette into separate tables of low and high bytes, look up both for
+	// each nibble, and interleave the results.
+#if defined(__SSSE3__)
+	const __m128i entries[2] = {
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(&palette_[0])),
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(&palette_[8])),
+	};
+	const __m128i byte_mask = _mm_set1_epi16(0xff);
+	const __m128i low_bytes = _mm_packus_epi16(_mm_and_si128(entries[0], byte_mask), _mm_and_si128(entries[1], byte_mask));
+	const __m128i high_bytes = _mm_packus_epi16(_mm_srli_epi16(entries[0], 8), _mm_srli_epi16(entries[1], 8));
+	const __m128i nibble_mask = _mm_set1_epi8(0xf);
+
+	while(source_end - source >= 16) {
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source));
+		const __m128i high_nibbles = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+		const __m128i low_nibbles = _mm_and_si128(bytes, nibble_mask);
+
+		const __m128i indices[2] = {
+			_mm_unpacklo_epi8(high_nibbles, low_nibbles),
+			_mm_unpackhi_epi8(high_nibbles, low_nibbles),
+		};
+		for(int c = 0; c < 2; c++) {
+			const __m128i low = _mm_shuffle_epi8(low_bytes, indices[c]);
+			const __m128i high = _mm_shuffle_epi8(high_bytes, indices[c]);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(target), _mm_unpacklo_epi8(low, high));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(target + 8), _mm_unpackhi_epi8(low, high));
+			target += 16;
 		}
+		source += 16;
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	const uint8x16x2_t palette = vld2q_u8(reinterpret_cast<const uint8_t *>(palette_));
+	const uint8x16_t nibble_mask = vdupq_n_u8(0xf);
+
+	while(source_end - source >= 16) {
+		const uint8x16_t bytes = vld1q_u8(source);
+		const uint8x16_t high_nibbles = vshrq_n_u8(bytes, 4);
+		const uint8x16_t low_nibbles = vandq_u8(bytes, nibble_mask);
+
+		const uint8x16_t indices[2] = {
+			vzip1q_u8(high_nibbles, low_nibbles),
+			vzip2q_u8(high_nibbles, low_nibbles),
+		};
+		for(int c = 0; c < 2; c++) {
+			const uint8x16x2_t pixels = {{
+				vqtbl1q_u8(palette.val[0], indices[c]),
+				vqtbl1q_u8(palette.val[1], indices[c]),
+			}};
+			vst2q_u8(reinterpret_cast<uint8_t *>(target), pixels);
+			target += 16;
+		}
+		source += 16;
+	}
+#endif
+
+	while(source != source_end) {
+		target[0] = palette_[(*source >> 4) & 0xf];
+		target[1] = palette_[*source & 0xf];
+		target += 2;
+		++source;
 	}
 
 	return target;
@@ -64,6 +64,10 @@ class Video: public Apple::II::VideoSwitches<Cycles> {
 		/// Determines the period until video might autonomously update its interrupt lines.
 		Cycles get_next_sequence_point() const;
 
+		/// @returns @c true if the video might read from RAM before its next sequence point; @c false if
+		/// RAM can be modified until then without first bringing video output up to date.
+		bool may_fetch_before_sequence_point() const;
+
 		/// Sets the Mega II interrupt enable state — 1/4-second and VBL interrupts are
 		/// generated here.
 		void set_megaii_interrupts_enabled(uint8_t);
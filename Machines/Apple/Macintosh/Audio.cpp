@@ -8,6 +8,8 @@
 
 #include "Audio.hpp"
 
+#include <algorithm>
+
 using namespace Apple::Macintosh;
 
 namespace {
@@ -29,6 +31,19 @@ void Audio::post_sample(uint8_t sample) {
 	sample_queue_.write_pointer = (sample_queue_.write_pointer + 1) % sample_queue_.buffer.size();
 }
 
+void Audio::post_samples(const uint8_t *samples, size_t count) {
+	// Fill the buffer in at most two spans, either side of the point at which it wraps around.
+	while(count) {
+		const size_t span = std::min(count, sample_queue_.buffer.size() - sample_queue_.write_pointer);
+		for(size_t c = 0; c < span; c++) {
+			sample_queue_.buffer[sample_queue_.write_pointer + c].store(samples[c], std::memory_order::memory_order_relaxed);
+		}
+		samples += span;
+		count -= span;
+		sample_queue_.write_pointer = (sample_queue_.write_pointer + span) % sample_queue_.buffer.size();
+	}
+}
+
 void Audio::set_volume(int volume) {
 	// Do nothing if the volume hasn't changed.
 	if(posted_volume_ == volume) return;
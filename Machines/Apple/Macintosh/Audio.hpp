@@ -38,6 +38,12 @@ class Audio: public ::Outputs::Speaker::SampleSource {
 		*/
 		void post_sample(uint8_t sample);
 
+		/*!
+			Adds @c count newly-collected samples to the queue, as if by
+			@c count calls to @c post_sample.
+		*/
+		void post_samples(const uint8_t *samples, size_t count);
+
 		/*!
 			Macintosh audio also separately receives an output volume
 			level, in the range 0 to 7.
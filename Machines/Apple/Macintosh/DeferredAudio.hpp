@@ -16,7 +16,7 @@ namespace Apple {
 namespace Macintosh {
 
 struct DeferredAudio {
-	Concurrency::AsyncTaskQueue<false> queue;
+	Concurrency::AsyncTaskQueue<false> queue{Concurrency::ThreadRole::Audio};
 	Audio audio;
 	Outputs::Speaker::PullLowpass<Audio> speaker;
 	HalfCycles time_since_update;
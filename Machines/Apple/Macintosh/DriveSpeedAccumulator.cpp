@@ -77,3 +77,11 @@ void DriveSpeedAccumulator::post_sample(uint8_t sample) {
 		sample_total_ = 0;
 	}
 }
+
+void DriveSpeedAccumulator::post_samples(const uint8_t *samples, size_t count) {
+	if(!delegate_) return;
+
+	for(size_t c = 0; c < count; c++) {
+		post_sample(samples[c]);
+	}
+}
@@ -23,6 +23,11 @@ class DriveSpeedAccumulator {
 		*/
 		void post_sample(uint8_t sample);
 
+		/*!
+			Accepts @c count fetched motor control values, as if by @c count calls to @c post_sample.
+		*/
+		void post_samples(const uint8_t *samples, size_t count);
+
 		struct Delegate {
 			virtual void drive_speed_accumulator_set_drive_speed(DriveSpeedAccumulator *, float speed) = 0;
 		};
@@ -34,9 +34,8 @@
 #include "../../../Components/AppleClock/AppleClock.hpp"
 #include "../../../Components/DiskII/IWM.hpp"
 #include "../../../Components/DiskII/MacintoshDoubleDensityDrive.hpp"
-#include "../../../Processors/68000/68000.hpp"
 
-#include "../../../Processors/68000Mk2/68000Mk2.hpp"
+#include "../../../Processors/68000Mk2/SwitchableProcessor.hpp"
 
 #include "../../../Storage/MassStorage/SCSI/SCSI.hpp"
 #include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
@@ -365,6 +364,38 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			return delay;
 		}
 
+		static constexpr bool has_plain_memory = true;
+
+		uint8_t *plain_memory(const Microcycle &cycle, int, HalfCycles pending, HalfCycles &delay) {
+			// The relevant moment is the end of the data-select microcycle; leave anything that might
+			// cross a video event to perform_bus_operation, so that video_is_outputting is exact.
+			const HalfCycles offset = pending + HalfCycles(8);
+			if(time_since_video_update_ + offset >= time_until_video_event_) return nullptr;
+
+			const auto address = cycle.host_endian_byte_address();
+			if(address >= 0xe0'0000) return nullptr;
+
+			switch(memory_map_[address >> 17]) {
+				default: return nullptr;
+
+				case BusDevice::RAM: {
+					// Video and audio are fetched from the final $d900 bytes of memory; as per perform_bus_operation.
+					if(address > ram_mask_ - 0xd900) return nullptr;
+
+					const int ram_subcycle = (ram_subcycle_ + offset.as<int>()) & 15;
+					delay = HalfCycles(0);
+					if(video_.is_outputting(time_since_video_update_ + offset) && ram_subcycle < 8) {
+						delay = HalfCycles(8 - ram_subcycle);
+					}
+				} return &ram_[address];
+
+				case BusDevice::ROM:
+					if(!(cycle.operation & Microcycle::Read)) return nullptr;
+					delay = HalfCycles(0);
+				return &rom_[address & rom_mask_];
+			}
+		}
+
 		void flush_output(int) {
 			// Flush the video before the audio queue; in a Mac the
 			// video is responsible for providing part of the
@@ -505,6 +536,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->quickboot = quickboot_;
+			options->fast_cpu = fast_cpu_;
 			return options;
 		}
 
@@ -515,6 +547,9 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			const auto options = dynamic_cast<Options *>(str.get());
 			quickboot_ = options->quickboot;
 
+			fast_cpu_ = options->fast_cpu;
+			mc68000_.set_fast_mode(fast_cpu_);
+
 			using Model = Analyser::Static::Macintosh::Target::Model;
 			const bool is_plus_rom = model == Model::Mac512ke || model == Model::MacPlus;
 			if(quickboot_ && is_plus_rom) {
@@ -529,6 +564,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 	private:
 		bool quickboot_ = false;
+		bool fast_cpu_ = false;
 
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final {
 			scsi_bus_is_clocked_ = scsi_bus_.preferred_clocking() != ClockingHint::Preference::None;
@@ -748,7 +784,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 				Inputs::QuadratureMouse &mouse_;
 		};
 
-		CPU::MC68000Mk2::Processor<ConcreteMachine, true, true> mc68000_;
+		CPU::MC68000Mk2::SwitchableProcessor<ConcreteMachine, true, true> mc68000_;
 
 		DriveSpeedAccumulator drive_speed_accumulator_;
 		IWMActor iwm_;
@@ -24,13 +24,20 @@ class Machine {
 		/// Creates and returns a Macintosh.
 		static Machine *Macintosh(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
 
-		class Options: public Reflection::StructImpl<Options>, public Configurable::QuickbootOption<Options> {
+		class Options:
+			public Reflection::StructImpl<Options>,
+			public Configurable::QuickbootOption<Options>,
+			public Configurable::FastCPUOption<Options>
+		{
 			friend Configurable::QuickbootOption<Options>;
+			friend Configurable::FastCPUOption<Options>;
 			public:
 				Options(Configurable::OptionsType type) :
-					Configurable::QuickbootOption<Options>(type == Configurable::OptionsType::UserFriendly) {
+					Configurable::QuickbootOption<Options>(type == Configurable::OptionsType::UserFriendly),
+					Configurable::FastCPUOption<Options>(false) {
 					if(needs_declare()) {
 						declare_quickboot_option();
+						declare_fast_cpu_option();
 					}
 				}
 		};
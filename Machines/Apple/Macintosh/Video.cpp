@@ -9,6 +9,7 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <iterator>
 
 using namespace Apple::Macintosh;
 
@@ -90,51 +91,60 @@ void Video::run_for(HalfCycles duration) {
 		const int final_word = int((pixel_start + cycles_left_in_line).as_integral()) >> 4;
 
 		if(first_word != final_word) {
-			if(line < 342) {
-				// If there are any pixels left to output, do so.
-				if(first_word < 32) {
-					const int final_pixel_word = std::min(final_word, 32);
-
-					if(!first_word) {
-						pixel_buffer_ = reinterpret_cast<uint64_t *>(crt_.begin_data(512, 8));
-					}
+			using Segment = Outputs::CRT::CRT::Segment;
 
-					if(pixel_buffer_) {
-						for(int c = first_word; c < final_pixel_word; ++c) {
-							const uint16_t pixels = ram_[video_base + video_address_] ^ 0xffff;
-							++video_address_;
+			if(line < 342) {
+				if(!first_word && final_word == 44) {
+					// This is an entire line, so expand all of its pixels in one go and post
+					// them, the border and sync to the CRT as a single batch.
+					pixel_buffer_ = reinterpret_cast<uint64_t *>(crt_.begin_data(512, 8));
+					output_pixels(video_base, 32);
+
+					const Segment segments[] = {
+						{Segment::Type::Data, 512, 512},
+						{Segment::Type::Blank, (sync_start - 32) * 16},
+						{Segment::Type::Sync, (sync_end - sync_start) * 16},
+						{Segment::Type::Blank, (44 - sync_end) * 16},
+					};
+					crt_.output_segments(segments, std::size(segments));
+					pixel_buffer_ = nullptr;
+				} else {
+					// If there are any pixels left to output, do so.
+					if(first_word < 32) {
+						const int final_pixel_word = std::min(final_word, 32);
 
-							const uint64_t low_pixels = (pixels & 0xff) * 0x0101010101010101;
-							const uint64_t high_pixels = (pixels >> 8) * 0x0101010101010101;
+						if(!first_word) {
+							pixel_buffer_ = reinterpret_cast<uint64_t *>(crt_.begin_data(512, 8));
+						}
+						output_pixels(video_base, final_pixel_word - first_word);
 
-							pixel_buffer_[0] = high_pixels & PixelMask;
-							pixel_buffer_[1] = low_pixels & PixelMask;
-							pixel_buffer_ += 2;
+						if(final_pixel_word == 32) {
+							crt_.output_data(512);
+							pixel_buffer_ = nullptr;
 						}
-					} else {
-						video_address_ += size_t(final_pixel_word - first_word);
 					}
 
-					if(final_pixel_word == 32) {
-						crt_.output_data(512);
-						pixel_buffer_ = nullptr;
-					}
+					if(first_word < sync_start && final_word >= sync_start)	crt_.output_blank((sync_start - 32) * 16);
+					if(first_word < sync_end && final_word >= sync_end)		crt_.output_sync((sync_end - sync_start) * 16);
+					if(final_word == 44)									crt_.output_blank((44 - sync_end) * 16);
 				}
-
-				if(first_word < sync_start && final_word >= sync_start)	crt_.output_blank((sync_start - 32) * 16);
-				if(first_word < sync_end && final_word >= sync_end)		crt_.output_sync((sync_end - sync_start) * 16);
-				if(final_word == 44)									crt_.output_blank((44 - sync_end) * 16);
 			} else if(final_word == 44) {
 				if(line >= 353 && line < 356) {
 					/* Output a sync line. */
-					crt_.output_sync(sync_start * 16);
-					crt_.output_blank((sync_end - sync_start) * 16);
-					crt_.output_sync((44 - sync_end) * 16);
+					const Segment segments[] = {
+						{Segment::Type::Sync, sync_start * 16},
+						{Segment::Type::Blank, (sync_end - sync_start) * 16},
+						{Segment::Type::Sync, (44 - sync_end) * 16},
+					};
+					crt_.output_segments(segments, std::size(segments));
 				} else {
 					/* Output a blank line. */
-					crt_.output_blank(sync_start * 16);
-					crt_.output_sync((sync_end - sync_start) * 16);
-					crt_.output_blank((44 - sync_end) * 16);
+					const Segment segments[] = {
+						{Segment::Type::Blank, sync_start * 16},
+						{Segment::Type::Sync, (sync_end - sync_start) * 16},
+						{Segment::Type::Blank, (44 - sync_end) * 16},
+					};
+					crt_.output_segments(segments, std::size(segments));
 				}
 			}
 
@@ -142,8 +152,9 @@ void Video::run_for(HalfCycles duration) {
 			if(final_word == 44) {
 				const uint16_t audio_word = ram_[audio_address_ + audio_base];
 				++audio_address_;
-				audio_.audio.post_sample(audio_word >> 8);
-				drive_speed_accumulator_.post_sample(audio_word & 0xff);
+				audio_samples_[sample_count_] = uint8_t(audio_word >> 8);
+				drive_speed_samples_[sample_count_] = uint8_t(audio_word);
+				++sample_count_;
 			}
 		}
 
@@ -161,8 +172,40 @@ void Video::run_for(HalfCycles duration) {
 				for a 512K Macintosh, add $60000 to these values."
 			*/
 			audio_address_ = 0;
+			post_samples();
 		}
 	}
+
+	post_samples();
+}
+
+void Video::post_samples() {
+	if(!sample_count_) return;
+	audio_.audio.post_samples(audio_samples_, sample_count_);
+	drive_speed_accumulator_.post_samples(drive_speed_samples_, sample_count_);
+	sample_count_ = 0;
+}
+
+void Video::output_pixels(size_t video_base, int words) {
+	if(!pixel_buffer_) {
+		video_address_ += size_t(words);
+		return;
+	}
+
+	// Each byte expands to eight one-byte pixels by replicating it across a
+	// 64-bit word and then masking off a different bit in each byte.
+	const uint16_t *const source = &ram_[video_base + video_address_];
+	for(int c = 0; c < words; ++c) {
+		const uint16_t pixels = source[c] ^ 0xffff;
+
+		const uint64_t low_pixels = (pixels & 0xff) * 0x0101010101010101;
+		const uint64_t high_pixels = (pixels >> 8) * 0x0101010101010101;
+
+		pixel_buffer_[0] = high_pixels & PixelMask;
+		pixel_buffer_[1] = low_pixels & PixelMask;
+		pixel_buffer_ += 2;
+	}
+	video_address_ += size_t(words);
 }
 
 bool Video::vsync() {
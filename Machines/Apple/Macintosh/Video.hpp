@@ -96,8 +96,18 @@ class Video {
 		size_t video_address_ = 0;
 		size_t audio_address_ = 0;
 
+		// Audio and drive-speed bytes fetched since they were last posted onwards; these are
+		// collected for up to a frame at a time and then posted together.
+		uint8_t audio_samples_[number_of_lines];
+		uint8_t drive_speed_samples_[number_of_lines];
+		size_t sample_count_ = 0;
+		void post_samples();
+
 		uint64_t *pixel_buffer_ = nullptr;
 
+		/// Expands the next @c words words of video memory into @c pixel_buffer_, if allocated, advancing @c video_address_.
+		void output_pixels(size_t video_base, int words);
+
 		bool use_alternate_screen_buffer_ = false;
 		bool use_alternate_audio_buffer_ = false;
 };
@@ -14,41 +14,33 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class Atari16k: public BusExtender {
+class Atari16k: public PagedBusExtender<Atari16k> {
 	public:
-		Atari16k(uint8_t *rom_base, std::size_t rom_size) :
-			BusExtender(rom_base, rom_size),
-			rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari16k(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1ff6, 0x1ffa);
+		}
 
-			if(address >= 0x1ff6 && address <= 0x1ff9) rom_ptr_ = rom_base_ + (address - 0x1ff6) * 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address >= 0x1ff6 && address <= 0x1ff9) page_4k(rom_base_ + (address - 0x1ff6) * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 		}
-
-	private:
-		uint8_t *rom_ptr_;
 };
 
-class Atari16kSuperChip: public BusExtender {
+class Atari16kSuperChip: public PagedBusExtender<Atari16kSuperChip> {
 	public:
-		Atari16kSuperChip(uint8_t *rom_base, std::size_t rom_size) :
-			BusExtender(rom_base, rom_size),
-			rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari16kSuperChip(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1000, 0x1100);
+			set_hotspots(0x1ff6, 0x1ffa);
+		}
 
-			if(address >= 0x1ff6 && address <= 0x1ff9) rom_ptr_ = rom_base_ + (address - 0x1ff6) * 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address >= 0x1ff6 && address <= 0x1ff9) page_4k(rom_base_ + (address - 0x1ff6) * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 
 			if(address < 0x1080) ram_[address & 0x7f] = *value;
@@ -56,7 +48,6 @@ class Atari16kSuperChip: public BusExtender {
 		}
 
 	private:
-		uint8_t *rom_ptr_;
 		uint8_t ram_[128];
 };
 
@@ -14,37 +14,33 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class Atari32k: public BusExtender {
+class Atari32k: public PagedBusExtender<Atari32k> {
 	public:
-		Atari32k(uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size), rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari32k(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1ff4, 0x1ffc);
+		}
 
-			if(address >= 0x1ff4 && address <= 0x1ffb) rom_ptr_ = rom_base_ + (address - 0x1ff4) * 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address >= 0x1ff4 && address <= 0x1ffb) page_4k(rom_base_ + (address - 0x1ff4) * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 		}
-
-	private:
-		uint8_t *rom_ptr_;
 };
 
-class Atari32kSuperChip: public BusExtender {
+class Atari32kSuperChip: public PagedBusExtender<Atari32kSuperChip> {
 	public:
-		Atari32kSuperChip(uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size), rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari32kSuperChip(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1000, 0x1100);
+			set_hotspots(0x1ff4, 0x1ffc);
+		}
 
-			if(address >= 0x1ff4 && address <= 0x1ffb) rom_ptr_ = rom_base_ + (address - 0x1ff4) * 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address >= 0x1ff4 && address <= 0x1ffb) page_4k(rom_base_ + (address - 0x1ff4) * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 
 			if(address < 0x1080) ram_[address & 0x7f] = *value;
@@ -52,7 +48,6 @@ class Atari32kSuperChip: public BusExtender {
 		}
 
 	private:
-		uint8_t *rom_ptr_;
 		uint8_t ram_[128];
 };
 
@@ -14,39 +14,35 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class Atari8k: public BusExtender {
+class Atari8k: public PagedBusExtender<Atari8k> {
 	public:
-		Atari8k(uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size), rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari8k(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1ff8, 0x1ffa);
+		}
 
-			if(address == 0x1ff8) rom_ptr_ = rom_base_;
-			else if(address == 0x1ff9) rom_ptr_ = rom_base_ + 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address == 0x1ff8) page_4k(rom_base_);
+			else if(address == 0x1ff9) page_4k(rom_base_ + 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 		}
-
-	private:
-		uint8_t *rom_ptr_;
 };
 
-class Atari8kSuperChip: public BusExtender {
+class Atari8kSuperChip: public PagedBusExtender<Atari8kSuperChip> {
 	public:
-		Atari8kSuperChip(uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size), rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		Atari8kSuperChip(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1000, 0x1100);
+			set_hotspots(0x1ff8, 0x1ffa);
+		}
 
-			if(address == 0x1ff8) rom_ptr_ = rom_base_;
-			if(address == 0x1ff9) rom_ptr_ = rom_base_ + 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address == 0x1ff8) page_4k(rom_base_);
+			if(address == 0x1ff9) page_4k(rom_base_ + 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 
 			if(address < 0x1080) ram_[address & 0x7f] = *value;
@@ -54,7 +50,6 @@ class Atari8kSuperChip: public BusExtender {
 		}
 
 	private:
-		uint8_t *rom_ptr_;
 		uint8_t ram_[128];
 };
 
@@ -14,18 +14,18 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class CBSRAMPlus: public BusExtender {
+class CBSRAMPlus: public PagedBusExtender<CBSRAMPlus> {
 	public:
-		CBSRAMPlus(uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size), rom_ptr_(rom_base) {}
-
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+		CBSRAMPlus(const uint8_t *rom_base, std::size_t rom_size) : PagedBusExtender(rom_base, rom_size) {
+			set_hotspots(0x1000, 0x1200);
+			set_hotspots(0x1ff8, 0x1ffb);
+		}
 
-			if(address >= 0x1ff8 && address <= 0x1ffa) rom_ptr_ = rom_base_ + (address - 0x1ff8) * 4096;
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(address >= 0x1ff8 && address <= 0x1ffa) page_4k(rom_base_ + (address - 0x1ff8) * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 
 			if(address < 0x1100) ram_[address & 0xff] = *value;
@@ -33,7 +33,6 @@ class CBSRAMPlus: public BusExtender {
 		}
 
 	private:
-		uint8_t *rom_ptr_;
 		uint8_t ram_[256];
 };
 
@@ -11,21 +11,86 @@
 
 #include "../../../../Processors/6502/6502.hpp"
 #include "../Bus.hpp"
+#include "../../../Utility/SharedROM.hpp"
 
 namespace Atari2600 {
 namespace Cartridge {
 
 class BusExtender: public CPU::MOS6502::BusHandler {
 	public:
-		BusExtender(uint8_t *rom_base, std::size_t rom_size) : rom_base_(rom_base), rom_size_(rom_size) {}
+		BusExtender(const uint8_t *rom_base, std::size_t rom_size) : rom_base_(rom_base), rom_size_(rom_size) {}
 
 		void advance_cycles(int) {}
 
 	protected:
-		uint8_t *rom_base_;
+		const uint8_t *rom_base_;
 		std::size_t rom_size_;
 };
 
+/*!
+	A bus extender for cartridges that page ROM into the 4kb cartridge area in 1kb slices, and which otherwise
+	respond only to a limited set of addresses — their hotspots.
+
+	Any access to the cartridge area other than at a hotspot is serviced directly from the current paging,
+	without involving the derived class. Hotspot accesses are instead passed to T::perform_hotspot_operation
+	with the address masked to 13 bits, which should perform the entire access.
+*/
+template <typename T> class PagedBusExtender: public BusExtender {
+	public:
+		PagedBusExtender(const uint8_t *rom_base, std::size_t rom_size) : BusExtender(rom_base, rom_size) {
+			page_4k(rom_base);
+		}
+
+		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			if(!(address & 0x1000)) return;
+
+			if(hotspots_[(address & 0xfff) >> 3] & (1 << (address & 7))) {
+				static_cast<T *>(this)->perform_hotspot_operation(operation, address & 0x1fff, value);
+			} else if(isReadOperation(operation)) {
+				*value = paged_rom(address);
+			}
+		}
+
+	protected:
+		/// Marks or unmarks the addresses [@c begin, @c end) as hotspots.
+		void set_hotspots(uint16_t begin, uint16_t end, bool is_hotspot = true) {
+			for(uint16_t address = begin; address < end; address++) {
+				const auto mask = uint8_t(1 << (address & 7));
+				if(is_hotspot) {
+					hotspots_[(address & 0xfff) >> 3] |= mask;
+				} else {
+					hotspots_[(address & 0xfff) >> 3] &= ~mask;
+				}
+			}
+		}
+
+		/// Pages @c source into the 1kb slice @c slice.
+		void page_1k(int slice, const uint8_t *source) {
+			pages_[slice] = source;
+		}
+
+		/// Pages @c source into the lower (@c half = 0) or upper (@c half = 1) 2kb of the cartridge area.
+		void page_2k(int half, const uint8_t *source) {
+			pages_[half << 1] = source;
+			pages_[(half << 1) + 1] = source + 1024;
+		}
+
+		/// Pages @c source into the entire cartridge area.
+		void page_4k(const uint8_t *source) {
+			page_2k(0, source);
+			page_2k(1, source + 2048);
+		}
+
+		/// @returns The ROM currently visible at @c address.
+		uint8_t paged_rom(uint16_t address) const {
+			return pages_[(address >> 10) & 3][address & 1023];
+		}
+
+	private:
+		const uint8_t *pages_[4];
+		uint8_t hotspots_[512]{};
+};
+
 template<class T> class Cartridge:
 	public CPU::MOS6502::BusHandler,
 	public Bus {
@@ -33,8 +98,8 @@ template<class T> class Cartridge:
 	public:
 		Cartridge(const std::vector<uint8_t> &rom) :
 			m6502_(*this),
-			rom_(rom),
-			bus_extender_(rom_.data(), rom.size()) {
+			rom_(ROM::share(rom)),
+			bus_extender_(rom_->data(), rom_->size()) {
 			// The above works because bus_extender_ is declared after rom_ in the instance storage list;
 			// consider doing something less fragile.
 		}
@@ -205,7 +270,7 @@ template<class T> class Cartridge:
 
 	protected:
 		CPU::MOS6502::Processor<CPU::MOS6502::Personality::P6502, Cartridge<T>, true> m6502_;
-		std::vector<uint8_t> rom_;
+		ROM::SharedImage rom_;
 
 	private:
 		T bus_extender_;
@@ -14,23 +14,30 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class MNetwork: public BusExtender {
+class MNetwork: public PagedBusExtender<MNetwork> {
 	public:
-		MNetwork(uint8_t *rom_base, std::size_t rom_size) :
-			BusExtender(rom_base, rom_size) {
+		MNetwork(const uint8_t *rom_base, std::size_t rom_size) :
+			PagedBusExtender(rom_base, rom_size) {
 			rom_ptr_[0] = rom_base + rom_size_ - 4096;
 			rom_ptr_[1] = rom_ptr_[0] + 2048;
+			page_4k(rom_ptr_[0]);
 			high_ram_ptr_ = high_ram_;
-		}
 
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
+			// The RAM areas, and the paging registers. The lower 2kb also becomes a hotspot
+			// while RAM is paged there.
+			set_hotspots(0x1800, 0x1a00);
+			set_hotspots(0x1fe0, 0x1fe8);
+			set_hotspots(0x1ff8, 0x1ffc);
+		}
 
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
 			if(address >= 0x1fe0 && address <= 0x1fe6) {
 				rom_ptr_[0] = rom_base_ + (address - 0x1fe0) * 2048;
+				page_2k(0, rom_ptr_[0]);
+				set_hotspots(0x1000, 0x1800, false);
 			} else if(address == 0x1fe7) {
 				rom_ptr_[0] = nullptr;
+				set_hotspots(0x1000, 0x1800);
 			} else if(address >= 0x1ff8 && address <= 0x1ffb) {
 				int offset = (address - 0x1ff8) * 256;
 				high_ram_ptr_ = &high_ram_[offset];
@@ -58,7 +65,7 @@ class MNetwork: public BusExtender {
 		}
 
 	private:
-		uint8_t *rom_ptr_[2];
+		const uint8_t *rom_ptr_[2];
 		uint8_t *high_ram_ptr_;
 		uint8_t low_ram_[1024], high_ram_[1024];
 };
@@ -14,30 +14,24 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class MegaBoy: public BusExtender {
+class MegaBoy: public PagedBusExtender<MegaBoy> {
 	public:
-		MegaBoy(uint8_t *rom_base, std::size_t rom_size) :
-			BusExtender(rom_base, rom_size),
-			rom_ptr_(rom_base),
+		MegaBoy(const uint8_t *rom_base, std::size_t rom_size) :
+			PagedBusExtender(rom_base, rom_size),
 			current_page_(0) {
+			set_hotspots(0x1ff0, 0x1ff1);
 		}
 
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
-
-			if(address == 0x1ff0) {
-				current_page_ = (current_page_ + 1) & 15;
-				rom_ptr_ = rom_base_ + current_page_ * 4096;
-			}
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
+			current_page_ = (current_page_ + 1) & 15;
+			page_4k(rom_base_ + current_page_ * 4096);
 
 			if(isReadOperation(operation)) {
-				*value = rom_ptr_[address & 4095];
+				*value = paged_rom(address);
 			}
 		}
 
 	private:
-		uint8_t *rom_ptr_;
 		uint8_t current_page_;
 };
 
@@ -12,20 +12,20 @@
 namespace Atari2600 {
 namespace Cartridge {
 
-class Pitfall2: public BusExtender {
+class Pitfall2: public PagedBusExtender<Pitfall2> {
 	public:
-		Pitfall2(uint8_t *rom_base, std::size_t rom_size) :
-			BusExtender(rom_base, rom_size),
-			rom_ptr_(rom_base) {}
+		Pitfall2(const uint8_t *rom_base, std::size_t rom_size) :
+			PagedBusExtender(rom_base, rom_size) {
+			// The DPC's registers, and the paging addresses.
+			set_hotspots(0x1000, 0x1080);
+			set_hotspots(0x1ff8, 0x1ffa);
+		}
 
 		void advance_cycles(int cycles) {
 			cycles_since_audio_update_ += cycles;
 		}
 
-		void perform_bus_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
-			address &= 0x1fff;
-			if(!(address & 0x1000)) return;
-
+		void perform_hotspot_operation(CPU::MOS6502::BusOperation operation, uint16_t address, uint8_t *value) {
 			switch(address) {
 
 // MARK: - Reads
@@ -77,14 +77,14 @@ class Pitfall2: public BusExtender {
 
 // MARK: - Paging
 
-				case 0x1ff8: rom_ptr_ = rom_base_;			break;
-				case 0x1ff9: rom_ptr_ = rom_base_ + 4096;	break;
+				case 0x1ff8: page_4k(rom_base_);			break;
+				case 0x1ff9: page_4k(rom_base_ + 4096);		break;
 
 // MARK: - Business as usual
 
 				default:
 					if(isReadOperation(operation)) {
-						*value = rom_ptr_[address & 4095];
+						*value = paged_rom(address);
 					}
 				break;
 			}
@@ -118,7 +118,6 @@ class Pitfall2: public BusExtender {
 		uint16_t featcher_address_[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 		uint8_t top_[8], bottom_[8], mask_[8] = {0, 0, 0, 0, 0, 0, 0, 0};
 		uint8_t random_number_generator_ = 0;
-		uint8_t *rom_ptr_;
 		uint8_t audio_channel_[3];
 		Cycles cycles_since_audio_update_ = 0;
 };
@@ -8,6 +8,7 @@
 
 #include "TIA.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -420,33 +421,38 @@ void TIA::output_for_cycles(int number_of_cycles) {
 	draw_missile(missile_[1], player_[1], uint8_t(CollisionType::Missile1), output_cursor, horizontal_counter_);
 	draw_object<Ball>(ball_, uint8_t(CollisionType::Ball), output_cursor, horizontal_counter_);
 
-	// convert to television signals
+	// convert to television signals; the sync, blank and burst periods are gathered so as to be
+	// posted to the CRT in a single batch
+	using Segment = Outputs::CRT::CRT::Segment;
+	Segment segments[5];
+	size_t segment_count = 0;
 
-#define Period(function, target)	\
+#define Period(segment_type, target)	\
 	if(output_cursor < target) { \
 		if(horizontal_counter_ <= target) { \
-			crt_.function((horizontal_counter_ - output_cursor) * 2); \
+			segments[segment_count++] = Segment{Segment::Type::segment_type, (horizontal_counter_ - output_cursor) * 2}; \
+			crt_.output_segments(segments, segment_count); \
 			horizontal_counter_ %= cycles_per_line; \
 			return; \
 		} else { \
-			crt_.function((target - output_cursor) * 2); \
+			segments[segment_count++] = Segment{Segment::Type::segment_type, (target - output_cursor) * 2}; \
 			output_cursor = target; \
 		} \
 	}
 
 	switch(output_mode_) {
 		default:
-			Period(output_blank, 16)
-			Period(output_sync, 32)
-			Period(output_default_colour_burst, 48)
-			Period(output_blank, 68)
+			Period(Blank, 16)
+			Period(Sync, 32)
+			Period(DefaultColourBurst, 48)
+			Period(Blank, 68)
 		break;
 		case sync_flag:
 		case sync_flag | blank_flag:
-			Period(output_sync, 16)
-			Period(output_blank, 32)
-			Period(output_default_colour_burst, 48)
-			Period(output_sync, 228)
+			Period(Sync, 16)
+			Period(Blank, 32)
+			Period(DefaultColourBurst, 48)
+			Period(Sync, 228)
 		break;
 	}
 
@@ -454,15 +460,18 @@ void TIA::output_for_cycles(int number_of_cycles) {
 
 	if(output_mode_ & blank_flag) {
 		if(pixel_target_) {
+			crt_.output_segments(segments, segment_count);
+			segment_count = 0;
+
 			output_pixels(pixels_start_location_, output_cursor);
-			const int data_length = int(output_cursor - pixels_start_location_);
-			crt_.output_data(data_length * 2, size_t(data_length));
-			pixel_target_ = nullptr;
-			pixels_start_location_ = 0;
+			flush_pixels(output_cursor);
 		}
 		int duration = std::min(228, horizontal_counter_) - output_cursor;
-		crt_.output_blank(duration * 2);
+		segments[segment_count++] = Segment{Segment::Type::Blank, duration * 2};
+		crt_.output_segments(segments, segment_count);
 	} else {
+		crt_.output_segments(segments, segment_count);
+
 		if(!pixels_start_location_) {
 			pixels_start_location_ = output_cursor;
 			pixel_target_ = reinterpret_cast<uint16_t *>(crt_.begin_data(160));
@@ -478,10 +487,7 @@ void TIA::output_for_cycles(int number_of_cycles) {
 		}
 
 		if(horizontal_counter_ == cycles_per_line) {
-			const int data_length = int(output_cursor - pixels_start_location_);
-			crt_.output_data(data_length * 2, size_t(data_length));
-			pixel_target_ = nullptr;
-			pixels_start_location_ = 0;
+			flush_pixels(output_cursor);
 		}
 	}
 
@@ -526,6 +532,24 @@ void TIA::output_pixels(int start, int end) {
 	}
 }
 
+void TIA::flush_pixels(int end) {
+	const int data_length = int(end - pixels_start_location_);
+
+	// A line of a single colour, such as is common in borders and empty playfields,
+	// can be posted as a level rather than as a full run of identical samples.
+	if(
+		pixel_target_ && data_length &&
+		std::all_of(pixel_target_ + 1, pixel_target_ + data_length, [first = pixel_target_[0]](uint16_t pixel) { return pixel == first; })
+	) {
+		crt_.output_level(data_length * 2);
+	} else {
+		crt_.output_data(data_length * 2, size_t(data_length));
+	}
+
+	pixel_target_ = nullptr;
+	pixels_start_location_ = 0;
+}
+
 void TIA::output_line() {
 	switch(output_mode_) {
 		default:
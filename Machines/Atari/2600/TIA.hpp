@@ -310,6 +310,7 @@ class TIA {
 		int pixels_start_location_ = 0;
 		uint16_t *pixel_target_ = nullptr;
 		inline void output_pixels(int start, int end);
+		inline void flush_pixels(int end);
 };
 
 }
@@ -8,6 +8,9 @@
 
 #include "TIASound.hpp"
 
+#include <algorithm>
+#include <limits>
+
 using namespace Atari2600;
 
 Atari2600::TIASound::TIASound(Concurrency::AsyncTaskQueue<false> &audio_queue) :
@@ -40,90 +43,148 @@ void Atari2600::TIASound::set_control(int channel, uint8_t control) {
 #define advance_poly5(c) poly5_counter_[channel] = (poly5_counter_[channel] >> 1) | (((poly5_counter_[channel] << 4) ^ (poly5_counter_[channel] << 2))&0x010)
 #define advance_poly9(c) poly9_counter_[channel] = (poly9_counter_[channel] >> 1) | (((poly9_counter_[channel] << 4) ^ (poly9_counter_[channel] << 8))&0x100)
 
-void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *target) {
-	for(unsigned int c = 0; c < number_of_samples; c++) {
-		target[c] = 0;
-		for(int channel = 0; channel < 2; channel++) {
-			divider_counter_[channel] ++;
-			int divider_value = divider_counter_[channel] / (38 / CPUTicksPerAudioTick);
-			int level = 0;
-			switch(control_[channel]) {
-				case 0x0: case 0xb:	// constant 1
-					level = 1;
-				break;
-
-				case 0x4: case 0x5:	// div2 tone
-					level = (divider_value / (divider_[channel]+1))&1;
-				break;
-
-				case 0xc: case 0xd:	// div6 tone
-					level = (divider_value / ((divider_[channel]+1)*3))&1;
-				break;
-
-				case 0x6: case 0xa:	// div31 tone
-					level = (divider_value / (divider_[channel]+1))%30 <= 18;
-				break;
-
-				case 0xe:			// div93 tone
-					level = (divider_value / ((divider_[channel]+1)*3))%30 <= 18;
-				break;
-
-				case 0x1:			// 4-bit poly
-					level = poly4_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly4(channel);
-					}
-				break;
-
-				case 0x2:			// 4-bit poly div31
-					level = poly4_counter_[channel]&1;
-					if(divider_value%(30*(divider_[channel]+1)) == 18) {
-						advance_poly4(channel);
-					}
-				break;
-
-				case 0x3:			// 5/4-bit poly
-					level = output_state_[channel];
-					if(divider_value == divider_[channel]+1) {
-						if(poly5_counter_[channel]&1) {
-							output_state_[channel] = poly4_counter_[channel]&1;
-							advance_poly4(channel);
-						}
-						advance_poly5(channel);
-					}
-				break;
-
-				case 0x7: case 0x9:	// 5-bit poly
-					level = poly5_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly5(channel);
-					}
-				break;
-
-				case 0xf:			// 5-bit poly div6
-					level = poly5_counter_[channel]&1;
-					if(divider_value == (divider_[channel]+1)*3) {
-						divider_counter_[channel] = 0;
-						advance_poly5(channel);
-					}
-				break;
-
-				case 0x8:			// 9-bit poly
-					level = poly9_counter_[channel]&1;
-					if(divider_value == divider_[channel]+1) {
-						divider_counter_[channel] = 0;
-						advance_poly9(channel);
-					}
-				break;
+int Atari2600::TIASound::step_channel(int channel) {
+	divider_counter_[channel] ++;
+	int divider_value = divider_counter_[channel] / DividerTicks;
+	int level = 0;
+	switch(control_[channel]) {
+		case 0x0: case 0xb:	// constant 1
+			level = 1;
+		break;
+
+		case 0x4: case 0x5:	// div2 tone
+			level = (divider_value / (divider_[channel]+1))&1;
+		break;
+
+		case 0xc: case 0xd:	// div6 tone
+			level = (divider_value / ((divider_[channel]+1)*3))&1;
+		break;
+
+		case 0x6: case 0xa:	// div31 tone
+			level = (divider_value / (divider_[channel]+1))%30 <= 18;
+		break;
+
+		case 0xe:			// div93 tone
+			level = (divider_value / ((divider_[channel]+1)*3))%30 <= 18;
+		break;
+
+		case 0x1:			// 4-bit poly
+			level = poly4_counter_[channel]&1;
+			if(divider_value == divider_[channel]+1) {
+				divider_counter_[channel] = 0;
+				advance_poly4(channel);
+			}
+		break;
+
+		case 0x2:			// 4-bit poly div31
+			level = poly4_counter_[channel]&1;
+			if(divider_value%(30*(divider_[channel]+1)) == 18) {
+				advance_poly4(channel);
+			}
+		break;
+
+		case 0x3:			// 5/4-bit poly
+			level = output_state_[channel];
+			if(divider_value == divider_[channel]+1) {
+				if(poly5_counter_[channel]&1) {
+					output_state_[channel] = poly4_counter_[channel]&1;
+					advance_poly4(channel);
+				}
+				advance_poly5(channel);
 			}
+		break;
 
-			target[c] += (volume_[channel] * per_channel_volume_ * level) >> 4;
+		case 0x7: case 0x9:	// 5-bit poly
+			level = poly5_counter_[channel]&1;
+			if(divider_value == divider_[channel]+1) {
+				divider_counter_[channel] = 0;
+				advance_poly5(channel);
+			}
+		break;
+
+		case 0xf:			// 5-bit poly div6
+			level = poly5_counter_[channel]&1;
+			if(divider_value == (divider_[channel]+1)*3) {
+				divider_counter_[channel] = 0;
+				advance_poly5(channel);
+			}
+		break;
+
+		case 0x8:			// 9-bit poly
+			level = poly9_counter_[channel]&1;
+			if(divider_value == divider_[channel]+1) {
+				divider_counter_[channel] = 0;
+				advance_poly9(channel);
+			}
+		break;
+	}
+
+	return level;
+}
+
+std::size_t Atari2600::TIASound::stable_samples(int channel) const {
+	constexpr auto forever = std::numeric_limits<std::size_t>::max();
+
+	// Returns the number of samples before the first at which the
+	// divider value will become a multiple of @c period.
+	const auto until_multiple = [this, channel](int period) {
+		const int next_divider_value = (((divider_counter_[channel] + 1) / DividerTicks) / period + 1) * period;
+		return std::size_t(next_divider_value * DividerTicks - 1 - divider_counter_[channel]);
+	};
+
+	// Returns the number of samples before the first at which the divider value
+	// will be @c value, 0 if it is currently that value and forever if it has been passed.
+	const auto until_value = [this, channel](int value) {
+		const int next_counter = divider_counter_[channel] + 1;
+		if(next_counter < value * DividerTicks) return std::size_t(value * DividerTicks - next_counter);
+		return next_counter / DividerTicks == value ? 0 : forever;
+	};
+
+	const int period = divider_[channel] + 1;
+	switch(control_[channel]) {
+		default:
+		case 0x0: case 0xb:	return forever;
+
+		case 0x4: case 0x5:
+		case 0x6: case 0xa:	return until_multiple(period);
+
+		case 0xc: case 0xd:
+		case 0xe:			return until_multiple(period * 3);
+
+		case 0x1: case 0x3:
+		case 0x7: case 0x9:
+		case 0x8:			return until_value(period);
+
+		case 0xf:			return until_value(period * 3);
+
+		case 0x2: {
+			const int poly_period = 30 * period;
+			const int divider_value = (divider_counter_[channel] + 1) / DividerTicks;
+			const int offset = (18 + poly_period - divider_value % poly_period) % poly_period;
+			if(!offset) return 0;
+			return std::size_t((divider_value + offset) * DividerTicks - 1 - divider_counter_[channel]);
 		}
 	}
 }
 
+void Atari2600::TIASound::get_samples(std::size_t number_of_samples, int16_t *target) {
+	std::size_t c = 0;
+	while(c < number_of_samples) {
+		// Both channels hold their levels and all other state for as long as neither divider
+		// reaches a value that causes a change; output a sample as normal, then extend it by that long.
+		const std::size_t run = std::clamp(std::min(stable_samples(0), stable_samples(1)), std::size_t(1), number_of_samples - c);
+
+		int16_t level = 0;
+		for(int channel = 0; channel < 2; channel++) {
+			level += (volume_[channel] * per_channel_volume_ * step_channel(channel)) >> 4;
+			divider_counter_[channel] += int(run - 1);
+		}
+
+		std::fill_n(&target[c], run, level);
+		c += run;
+	}
+}
+
 void Atari2600::TIASound::set_sample_volume_range(std::int16_t range) {
 	per_channel_volume_ = range / 2;
 }
@@ -45,6 +45,15 @@ class TIASound: public Outputs::Speaker::SampleSource {
 
 		int divider_counter_[2];
 		int16_t per_channel_volume_ = 0;
+
+		static constexpr int DividerTicks = 38 / CPUTicksPerAudioTick;
+
+		/// Advances @c channel by one sample, returning its level for that sample.
+		int step_channel(int channel);
+
+		/// @returns The number of samples that @c channel can advance by without changing its
+		/// output level or any other state besides its divider counter.
+		std::size_t stable_samples(int channel) const;
 };
 
 }
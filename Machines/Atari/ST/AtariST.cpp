@@ -13,7 +13,7 @@
 
 //#define LOG_TRACE
 //bool should_log = false;
-#include "../../../Processors/68000Mk2/68000Mk2.hpp"
+#include "../../../Processors/68000Mk2/SwitchableProcessor.hpp"
 
 #include "../../../Components/AY38910/AY38910.hpp"
 #include "../../../Components/68901/MFP68901.hpp"
@@ -34,6 +34,7 @@
 
 #include "../../Utility/MemoryPacker.hpp"
 #include "../../Utility/MemoryFuzzer.hpp"
+#include "../../Utility/LargeMemory.hpp"
 
 #include "../../../Analyser/Static/AtariST/Target.hpp"
 
@@ -49,6 +50,7 @@ class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::AudioProducer,
+	public MachineTypes::BusTraceable,
 	public MachineTypes::MouseMachine,
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
@@ -66,6 +68,7 @@ class ConcreteMachine:
 			mc68000_(*this),
 			keyboard_acia_(Cycles(500000)),
 			midi_acia_(Cycles(500000)),
+			peripherals_(keyboard_acia_, midi_acia_, mfp_),
 			ay_(GI::AY38910::Personality::YM2149F, audio_queue_),
 			speaker_(ay_),
 			ikbd_(keyboard_acia_->transmit, keyboard_acia_->receive) {
@@ -97,7 +100,8 @@ class ConcreteMachine:
 			if(!request.validate(roms)) {
 				throw ROMMachine::Error::MissingROMs;
 			}
-			Memory::PackBigEndian16(roms.find(rom_name)->second, rom_);
+			rom_ = std::move(roms.find(rom_name)->second);
+			Memory::PackBigEndian16(rom_);
 
 			// Set up basic memory map.
 			memory_map_[0] = BusDevice::MostlyRAM;
@@ -166,9 +170,7 @@ class ConcreteMachine:
 
 		void run_for(const Cycles cycles) final {
 			// Give the keyboard an opportunity to consume any events.
-			if(!keyboard_needs_clock_) {
-				ikbd_.run_for(HalfCycles(0));
-			}
+			ikbd_.process_inputs();
 
 			mc68000_.run_for(cycles);
 		}
@@ -201,6 +203,7 @@ class ConcreteMachine:
 					return HalfCycles(0);
 				} else {
 					if(cycle.operation & Microcycle::SelectByte) {
+						peripherals_.commit();
 						const int interrupt = mfp_->acknowledge_interrupt();
 						if(interrupt != Motorola::MFP68901::MFP68901::NoAcknowledgement) {
 							cycle.value->b = uint8_t(interrupt);
@@ -380,6 +383,7 @@ class ConcreteMachine:
 						case 0xfa38:	case 0xfa3a:	case 0xfa3c:	case 0xfa3e:
 							if(!cycle.data_select_active()) return delay;
 
+							peripherals_.commit();
 							if(cycle.operation & Microcycle::Read) {
 								cycle.set_value8_low(mfp_->read(int(address >> 1)));
 							} else {
@@ -393,6 +397,7 @@ class ConcreteMachine:
 							mc68000_.set_is_peripheral_address(!cycle.data_select_active());
 							if(!cycle.data_select_active()) return delay;
 
+							peripherals_.commit();
 							const auto acia_ = (address & 4) ? &midi_acia_ : &keyboard_acia_;
 							if(cycle.operation & Microcycle::Read) {
 								cycle.set_value8_high((*acia_)->read(int(address >> 1)));
@@ -430,11 +435,23 @@ class ConcreteMachine:
 			return HalfCycles(0);
 		}
 
+		static constexpr bool has_plain_memory = true;
+
+		template <typename Microcycle> uint8_t *plain_memory(const Microcycle &cycle, int, HalfCycles, HalfCycles &delay) {
+			// Only ROM reads are completed directly. Video and DMA may touch any part of RAM as time
+			// advances, so RAM accesses are left to perform_bus_operation in order to stay in step with them.
+			if(!(cycle.operation & Microcycle::Read)) return nullptr;
+
+			const auto address = cycle.host_endian_byte_address();
+			if(memory_map_[address >> 16] != BusDevice::ROM) return nullptr;
+
+			delay = HalfCycles(0);
+			return &rom_[address - rom_start_];
+		}
+
 		void flush_output(int outputs) final {
 			dma_.flush();
-			mfp_.flush();
-			keyboard_acia_.flush();
-			midi_acia_.flush();
+			peripherals_.flush();
 
 			if(outputs & Output::Video) {
 				video_.flush();
@@ -449,27 +466,33 @@ class ConcreteMachine:
 		forceinline void advance_time(HalfCycles length) {
 			// Advance the relevant counters.
 			cycles_since_audio_update_ += length;
-			mfp_ += length;
+			peripherals_ += length;
 			if(dma_clocking_preference_ != ClockingHint::Preference::None)
 				dma_ += length;
-			keyboard_acia_ += length;
-			midi_acia_ += length;
 			bus_phase_ += length;
 
-			// Don't even count time for the keyboard unless it has requested it.
+			// Don't even count time for the keyboard unless it has requested it, and then
+			// update it only as each byte completes.
 			if(keyboard_needs_clock_) {
 				cycles_since_ikbd_update_ += length;
-				ikbd_.run_for(cycles_since_ikbd_update_.divide(HalfCycles(512)));
+				if(cycles_since_ikbd_update_ >= ikbd_byte_time_) {
+					ikbd_.run_for(cycles_since_ikbd_update_.divide(HalfCycles(512)));
+					ikbd_byte_time_ = ikbd_.next_byte_time() * 512;
+				}
 			}
 
 			// Flush anything that needs real-time updating.
-			if(!may_defer_acias_) {
-				keyboard_acia_.flush();
-				midi_acia_.flush();
-			}
+			if(!may_defer_acias_ || mfp_is_realtime_) {
+				peripherals_.commit();
+
+				if(!may_defer_acias_) {
+					keyboard_acia_.flush();
+					midi_acia_.flush();
+				}
 
-			if(mfp_is_realtime_) {
-				mfp_.flush();
+				if(mfp_is_realtime_) {
+					mfp_.flush();
+				}
 			}
 
 			if(dma_clocking_preference_ == ClockingHint::Preference::RealTime) {
@@ -481,6 +504,7 @@ class ConcreteMachine:
 				length -= video_.cycles_until_implicit_flush();
 				video_ += video_.cycles_until_implicit_flush();
 
+				peripherals_.commit();
 				mfp_->set_timer_event_input(1, video_->display_enabled());
 				update_interrupt_input();
 			}
@@ -492,7 +516,7 @@ class ConcreteMachine:
 			speaker_.run_for(audio_queue_, cycles_since_audio_update_.divide_cycles(Cycles(4)));
 		}
 
-		CPU::MC68000Mk2::Processor<ConcreteMachine, true, true> mc68000_;
+		CPU::MC68000Mk2::SwitchableProcessor<ConcreteMachine, true, true> mc68000_;
 		HalfCycles bus_phase_;
 
 		JustInTimeActor<Video> video_;
@@ -502,17 +526,25 @@ class ConcreteMachine:
 		JustInTimeActor<Motorola::ACIA::ACIA, HalfCycles, 16> keyboard_acia_;
 		JustInTimeActor<Motorola::ACIA::ACIA, HalfCycles, 16> midi_acia_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		// The ACIAs and MFP are clocked as a group, receiving time only when the MFP reaches a sequence
+		// point or upon commit(), which must precede any other use of them. The ACIAs are listed first
+		// since the MFP's interrupt handling may inspect them.
+		JustInTimeGroup<HalfCycles,
+			JustInTimeActor<Motorola::ACIA::ACIA, HalfCycles, 16>,
+			JustInTimeActor<Motorola::ACIA::ACIA, HalfCycles, 16>,
+			JustInTimeActor<Motorola::MFP68901::MFP68901, HalfCycles, 819200, 2673749>> peripherals_;
+
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		GI::AY38910::AY38910<false> ay_;
 		Outputs::Speaker::PullLowpass<GI::AY38910::AY38910<false>> speaker_;
 		HalfCycles cycles_since_audio_update_;
 
 		JustInTimeActor<DMAController> dma_;
 
-		HalfCycles cycles_since_ikbd_update_;
+		HalfCycles cycles_since_ikbd_update_, ikbd_byte_time_;
 		IntelligentKeyboard ikbd_;
 
-		std::vector<uint8_t> ram_;
+		Memory::LargeVector<uint8_t> ram_;
 		std::vector<uint8_t> rom_;
 		uint32_t rom_start_ = 0;
 
@@ -546,6 +578,11 @@ class ConcreteMachine:
 				(keyboard_acia_.last_valid()->preferred_clocking() != ClockingHint::Preference::RealTime) &&
 				(midi_acia_.last_valid()->preferred_clocking() != ClockingHint::Preference::RealTime);
 			keyboard_needs_clock_ = ikbd_.preferred_clocking() != ClockingHint::Preference::None;
+			if(keyboard_needs_clock_) {
+				ikbd_byte_time_ = ikbd_.next_byte_time() * 512;
+			} else {
+				cycles_since_ikbd_update_ = HalfCycles(0);
+			}
 			mfp_is_realtime_ = mfp_.last_valid()->preferred_clocking() == ClockingHint::Preference::RealTime;
 			dma_clocking_preference_ = dma_.last_valid()->preferred_clocking();
 		}
@@ -577,6 +614,7 @@ class ConcreteMachine:
 					GPIP 1: RS-232 carrier detect
 					GPIP 0: centronics busy
 			*/
+			peripherals_.commit();
 			mfp_->set_port_input(
 				0x80 |	// b7: Monochrome monitor detect (0 = is monochrome).
 				0x40 |	// b6: RS-232 ring indicator.
@@ -610,6 +648,7 @@ class ConcreteMachine:
 			previous_vsync_ = vsync;
 			previous_hsync_ = hsync;
 
+			peripherals_.commit();
 			if(mfp_->get_interrupt_line()) {
 				mc68000_.set_interrupt_level(6);
 			} else if(video_interrupts_pending_ & 4) {
@@ -669,9 +708,25 @@ class ConcreteMachine:
 				++c;
 				if(c == 2) break;
 			}
+
+			c = 0;
+			for(const auto &device: media.mass_storage_devices) {
+				dma_->set_hard_disk(device, c);
+				++c;
+				if(c == 8) break;
+			}
 			return true;
 		}
 
+		// MARK: - BusTraceable.
+		CPU::BusTrace::Bus traced_bus() const final {
+			return CPU::BusTrace::Bus::MC68000;
+		}
+
+		void set_bus_trace(CPU::BusTrace *trace) final {
+			mc68000_.set_bus_trace(trace);
+		}
+
 		// MARK: - Activity Source
 		void set_activity_observer(Activity::Observer *observer) final {
 			dma_->set_activity_observer(observer);
@@ -687,13 +742,21 @@ class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->fast_cpu = fast_cpu_;
+			options->fast_mechanics = dma_->get_is_fast_mechanics_enabled();
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+
+			fast_cpu_ = options->fast_cpu;
+			mc68000_.set_fast_mode(fast_cpu_);
+
+			dma_->set_is_fast_mechanics_enabled(options->fast_mechanics);
 		}
+		bool fast_cpu_ = false;
 };
 
 }
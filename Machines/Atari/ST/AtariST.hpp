@@ -25,13 +25,25 @@ class Machine {
 
 		static Machine *AtariST(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
 
-		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options> {
+		class Options:
+			public Reflection::StructImpl<Options>,
+			public Configurable::DisplayOption<Options>,
+			public Configurable::FastCPUOption<Options>,
+			public Configurable::FastMechanicsOption<Options>
+		{
 			friend Configurable::DisplayOption<Options>;
+			friend Configurable::FastCPUOption<Options>;
+			friend Configurable::FastMechanicsOption<Options>;
 			public:
-				Options(Configurable::OptionsType type) : Configurable::DisplayOption<Options>(
-					type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour)  {
+				Options(Configurable::OptionsType type) :
+					Configurable::DisplayOption<Options>(
+						type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour),
+					Configurable::FastCPUOption<Options>(false),
+					Configurable::FastMechanicsOption<Options>(false) {
 					if(needs_declare()) {
 						declare_display_option();
+						declare_fast_cpu_option();
+						declare_fast_mechanics_option();
 						limit_enum(&output, Configurable::Display::RGB, Configurable::Display::CompositeColour, -1);
 					}
 				}
@@ -11,6 +11,7 @@
 #define LOG_PREFIX "[DMA] "
 #include "../../../Outputs/Log.hpp"
 
+#include <algorithm>
 #include <cstdio>
 
 using namespace Atari::ST;
@@ -43,7 +44,10 @@ uint16_t DMAController::read(int address) {
 															// only when a sector is complete.
 			} else {
 				if(control_ & Control::CPUTarget) {
-					return 0xffff;
+					// Reading the status of a hard disk controller also releases its interrupt request.
+					acsi_interrupt_ = false;
+					update_interrupt_line();
+					return 0xff00 | acsi_status_;
 				} else {
 					return 0xff00 | fdc_.read(control_ >> 1);
 				}
@@ -76,7 +80,7 @@ void DMAController::write(int address, uint16_t value) {
 				// TODO: if this is a write-mode DMA operation, try to fill both buffers, ASAP.
 			} else {
 				if(control_ & Control::CPUTarget) {
-					// TODO: HDC.
+					write_acsi_command(uint8_t(value));
 				} else {
 					fdc_.write(control_ >> 1, uint8_t(value));
 				}
@@ -134,13 +138,19 @@ void DMAController::run_for(HalfCycles duration) {
 	fdc_.run_for(duration.flush<Cycles>());
 }
 
-void DMAController::wd1770_did_change_output(WD::WD1770 *) {
-	// Check for a change in interrupt state.
+void DMAController::update_interrupt_line() {
+	// The FDC and hard disk interrupt requests are wired together.
 	const bool old_interrupt_line = interrupt_line_;
-	interrupt_line_ = fdc_.get_interrupt_request_line();
+	interrupt_line_ = fdc_interrupt_line_ || acsi_interrupt_;
 	if(delegate_ && interrupt_line_ != old_interrupt_line) {
 		delegate_->dma_controller_did_change_output(this);
 	}
+}
+
+void DMAController::wd1770_did_change_output(WD::WD1770 *) {
+	// Check for a change in interrupt state.
+	fdc_interrupt_line_ = fdc_.get_interrupt_request_line();
+	update_interrupt_line();
 
 	// Check for a change in DRQ state, if it's the FDC that is currently being watched.
 	if(byte_count_ && fdc_.get_data_request_line() && (control_ & Control::DRQSource)) {
@@ -184,6 +194,10 @@ int DMAController::bus_grant(uint16_t *ram, size_t size) {
 	if(delegate_) delegate_->dma_controller_did_change_output(this);
 
 	size <<= 1;	// Convert to bytes.
+	if(acsi_transfer_ != ACSITransfer::None) {
+		return acsi_bus_grant(ram, size);
+	}
+
 	if(control_ & Control::Direction) {
 		// TODO: writes.
 		return 0;
@@ -235,6 +249,247 @@ int DMAController::bus_grant(uint16_t *ram, size_t size) {
 	}
 }
 
+// MARK: - ACSI.
+
+void DMAController::set_hard_disk(std::shared_ptr<Storage::MassStorage::MassStorageDevice> device, size_t target) {
+	hard_disks_[target & 7] = device;
+}
+
+void DMAController::write_acsi_command(uint8_t value) {
+	// Any write releases the interrupt request; it'll be reasserted if the byte is accepted.
+	acsi_interrupt_ = false;
+
+	// A1 is low only for the first byte of a command, which selects the target in its top three bits.
+	if(!(control_ & 2)) {
+		acsi_command_length_ = 0;
+	}
+	if(acsi_command_length_ == sizeof(acsi_command_)) {
+		update_interrupt_line();
+		return;
+	}
+	acsi_command_[acsi_command_length_++] = value;
+
+	// Targets that aren't present never respond.
+	const auto &device = hard_disks_[acsi_command_[0] >> 5];
+	if(!device) {
+		update_interrupt_line();
+		return;
+	}
+
+	// Commands are six bytes long, with the opcode in the low five bits of the first; an
+	// opcode of 0x1f indicates an ICD-style extended command, which is followed by a complete
+	// SCSI command of a length implied by its group.
+	uint8_t opcode = acsi_command_[0] & 0x1f;
+	const uint8_t *command = acsi_command_;
+	int length = 6;
+	if(opcode == 0x1f) {
+		length = 2;
+		if(acsi_command_length_ > 1) {
+			opcode = acsi_command_[1];
+			command = &acsi_command_[1];
+			switch(opcode >> 5) {
+				case 0:		length = 1 + 6;		break;
+				case 5:		length = 1 + 12;	break;
+				default:	length = 1 + 10;	break;
+			}
+		}
+	}
+
+	if(acsi_command_length_ < length) {
+		// Acknowledge this byte and await the next.
+		acsi_interrupt_ = true;
+		update_interrupt_line();
+		return;
+	}
+
+	acsi_command_length_ = 0;
+	execute_acsi_command(*device, opcode, command);
+}
+
+void DMAController::execute_acsi_command(Storage::MassStorage::MassStorageDevice &device, uint8_t opcode, const uint8_t *command) {
+	// Sense keys and additional sense codes.
+	constexpr uint8_t IllegalRequest = 0x05;
+	constexpr uint8_t InvalidCommand = 0x20;
+	constexpr uint8_t InvalidAddress = 0x21;
+
+	const auto big_endian = [&](int offset, int length) {
+		uint32_t result = 0;
+		for(int c = 0; c < length; c++) result = (result << 8) | command[offset + c];
+		return result;
+	};
+	const auto set_data = [&](std::initializer_list<uint8_t> data, size_t allocation) {
+		acsi_data_.assign(data);
+		acsi_data_.resize(std::min(acsi_data_.size(), allocation));
+		acsi_device_ = &device;
+		begin_acsi_transfer(ACSITransfer::ReadData);
+	};
+
+	switch(opcode) {
+		default:
+			LOG("Unsupported ACSI command " << PADHEX(2) << int(opcode));
+			complete_acsi_command(IllegalRequest, InvalidCommand);
+		break;
+
+		case 0x00:	// Test unit ready.
+		case 0x0b:	// Seek.
+		case 0x1b:	// Start/stop unit.
+			complete_acsi_command();
+		break;
+
+		case 0x03: {	// Request sense.
+			// An allocation of four bytes or fewer implies the original, non-extended sense format.
+			const size_t allocation = command[4] ? command[4] : 4;
+			const uint8_t address_valid = acsi_sense_address_ ? 0x80 : 0x00;
+			if(allocation <= 4) {
+				set_data({
+					uint8_t(address_valid | acsi_additional_sense_),
+					uint8_t(acsi_sense_address_ >> 16),
+					uint8_t(acsi_sense_address_ >> 8),
+					uint8_t(acsi_sense_address_),
+				}, allocation);
+			} else {
+				set_data({
+					uint8_t(address_valid | 0x70), 0x00, acsi_sense_key_,
+					uint8_t(acsi_sense_address_ >> 24), uint8_t(acsi_sense_address_ >> 16),
+					uint8_t(acsi_sense_address_ >> 8), uint8_t(acsi_sense_address_),
+					10, 0x00, 0x00, 0x00, 0x00,
+					acsi_additional_sense_, 0x00, 0x00, 0x00, 0x00, 0x00,
+				}, allocation);
+			}
+		} break;
+
+		case 0x08:	// Read (6).
+		case 0x0a:	// Write (6).
+		case 0x28:	// Read (10).
+		case 0x2a: {	// Write (10).
+			const bool is_short = opcode < 0x20;
+			acsi_address_ = is_short ? big_endian(1, 3) & 0x1fffff : big_endian(2, 4);
+			acsi_block_count_ = is_short ? (command[4] ? command[4] : 256) : big_endian(7, 2);
+
+			if(acsi_address_ + uint64_t(acsi_block_count_) > device.get_number_of_blocks()) {
+				complete_acsi_command(IllegalRequest, InvalidAddress, acsi_address_);
+				break;
+			}
+			acsi_device_ = &device;
+			begin_acsi_transfer((opcode & 2) ? ACSITransfer::WriteBlocks : ACSITransfer::ReadBlocks);
+		} break;
+
+		case 0x12:	// Inquiry.
+			set_data({
+				0x00,	// Direct-access device.
+				0x00,	// Not removable.
+				0x01,	// SCSI-1.
+				0x00,
+				31,		// Additional length.
+				0x00, 0x00, 0x00,
+				'C', 'L', 'K', ' ', ' ', ' ', ' ', ' ',
+				'A', 'C', 'S', 'I', ' ', 'H', 'a', 'r', 'd', ' ', 'D', 'i', 's', 'k', ' ', ' ',
+				'1', '.', '0', ' ',
+			}, command[4]);
+		break;
+
+		case 0x1a: {	// Mode sense (6).
+			const auto blocks = uint32_t(device.get_number_of_blocks());
+			const auto block_size = uint32_t(device.get_block_size());
+			set_data({
+				11, 0x00, 0x00, 8,	// Header: data length, medium type, device-specific parameter, descriptor length.
+				0x00, uint8_t(blocks >> 16), uint8_t(blocks >> 8), uint8_t(blocks),
+				0x00, uint8_t(block_size >> 16), uint8_t(block_size >> 8), uint8_t(block_size),
+			}, command[4]);
+		} break;
+
+		case 0x25: {	// Read capacity.
+			const auto last_block = uint32_t(device.get_number_of_blocks() - 1);
+			const auto block_size = uint32_t(device.get_block_size());
+			set_data({
+				uint8_t(last_block >> 24), uint8_t(last_block >> 16), uint8_t(last_block >> 8), uint8_t(last_block),
+				uint8_t(block_size >> 24), uint8_t(block_size >> 16), uint8_t(block_size >> 8), uint8_t(block_size),
+			}, 8);
+		} break;
+	}
+}
+
+void DMAController::begin_acsi_transfer(ACSITransfer transfer) {
+	acsi_transfer_ = transfer;
+	bus_request_line_ = true;
+	if(delegate_) delegate_->dma_controller_did_change_output(this);
+}
+
+void DMAController::complete_acsi_command(uint8_t sense_key, uint8_t additional_sense, uint32_t address) {
+	acsi_status_ = sense_key ? 0x02 : 0x00;	// i.e. check condition or good.
+	acsi_sense_key_ = sense_key;
+	acsi_additional_sense_ = additional_sense;
+	acsi_sense_address_ = address;
+
+	acsi_transfer_ = ACSITransfer::None;
+	acsi_device_ = nullptr;
+	acsi_interrupt_ = true;
+	update_interrupt_line();
+}
+
+int DMAController::acsi_bus_grant(uint16_t *ram, size_t size) {
+	// Data is moved a word at a time, advancing the DMA address and reducing the byte count.
+	const auto to_ram = [&](const uint8_t *source, size_t length) {
+		for(size_t c = 0; c < length; c += 2) {
+			if(size_t(address_) < size) {
+				ram[address_ >> 1] = uint16_t((source[c] << 8) | source[c + 1]);
+			}
+			address_ += 2;
+		}
+		byte_count_ = std::max(byte_count_ - int(length), 0);
+		return int(length >> 1);
+	};
+	const auto from_ram = [&](uint8_t *target, size_t length) {
+		for(size_t c = 0; c < length; c += 2) {
+			const uint16_t value = size_t(address_) < size ? ram[address_ >> 1] : 0xffff;
+			target[c] = uint8_t(value >> 8);
+			target[c + 1] = uint8_t(value);
+			address_ += 2;
+		}
+		byte_count_ = std::max(byte_count_ - int(length), 0);
+		return int(length >> 1);
+	};
+
+	int words = 0;
+	switch(acsi_transfer_) {
+		case ACSITransfer::None: break;
+
+		case ACSITransfer::ReadData:
+			// Data is always moved in complete sixteen-byte bursts.
+			acsi_data_.resize((acsi_data_.size() + 15) & ~size_t(15));
+			if(byte_count_) {
+				words += to_ram(acsi_data_.data(), acsi_data_.size());
+			}
+		break;
+
+		case ACSITransfer::ReadBlocks:
+		case ACSITransfer::WriteBlocks: {
+			// Transfer whole blocks for as long as the DMA sector count permits.
+			const size_t block_size = acsi_device_->get_block_size();
+			acsi_data_.resize(block_size);
+			while(acsi_block_count_ && byte_count_) {
+				if(acsi_transfer_ == ACSITransfer::ReadBlocks) {
+					// Copy straight from the device's storage where it permits that.
+					if(const auto contents = acsi_device_->block_contents(acsi_address_)) {
+						words += to_ram(contents, block_size);
+					} else {
+						acsi_data_ = acsi_device_->get_block(acsi_address_);
+						words += to_ram(acsi_data_.data(), block_size);
+					}
+				} else {
+					words += from_ram(acsi_data_.data(), block_size);
+					acsi_device_->set_block_contents(acsi_address_, acsi_data_.data());
+				}
+				++acsi_address_;
+				--acsi_block_count_;
+			}
+		} break;
+	}
+
+	complete_acsi_command();
+	return words;
+}
+
 void DMAController::set_delegate(Delegate *delegate) {
 	delegate_ = delegate;
 }
@@ -258,3 +513,11 @@ ClockingHint::Preference DMAController::preferred_clocking() const {
 void DMAController::set_activity_observer(Activity::Observer *observer) {
 	fdc_.set_activity_observer(observer);
 }
+
+void DMAController::set_is_fast_mechanics_enabled(bool enabled) {
+	fdc_.set_is_fast_mechanics_enabled(enabled);
+}
+
+bool DMAController::get_is_fast_mechanics_enabled() const {
+	return fdc_.get_is_fast_mechanics_enabled();
+}
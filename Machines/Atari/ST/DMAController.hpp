@@ -9,13 +9,16 @@
 #ifndef DMAController_hpp
 #define DMAController_hpp
 
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../ClockReceiver/ClockingHintSource.hpp"
 #include "../../../Components/1770/1770.hpp"
 #include "../../../Activity/Source.hpp"
+#include "../../../Storage/MassStorage/MassStorageDevice.hpp"
 
 namespace Atari {
 namespace ST {
@@ -42,6 +45,9 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 		void set_floppy_drive_selection(bool drive1, bool drive2, bool side2);
 		void set_floppy_disk(std::shared_ptr<Storage::Disk::Disk> disk, size_t drive);
 
+		/// Attaches @c device as the ACSI hard disk with ID @c target, in the range [0, 7].
+		void set_hard_disk(std::shared_ptr<Storage::MassStorage::MassStorageDevice> device, size_t target);
+
 		struct Delegate {
 			virtual void dma_controller_did_change_output(DMAController *) = 0;
 		};
@@ -49,6 +55,10 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 
 		void set_activity_observer(Activity::Observer *observer);
 
+		/// Enables or disables fast mechanics on the floppy disk controller; see @c WD::WD1770.
+		void set_is_fast_mechanics_enabled(bool);
+		bool get_is_fast_mechanics_enabled() const;
+
 		// ClockingHint::Source.
 		ClockingHint::Preference preferred_clocking() const final;
 
@@ -94,6 +104,7 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 
 		Delegate *delegate_ = nullptr;
 		bool interrupt_line_ = false;
+		bool fdc_interrupt_line_ = false;
 		bool bus_request_line_ = false;
 
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final;
@@ -108,6 +119,36 @@ class DMAController: public WD::WD1770::Delegate, public ClockingHint::Source, p
 		bool error_ = false;
 		int address_ = 0;
 		int byte_count_ = 0;
+
+		// MARK: - ACSI.
+
+		// The hard disk controllers are modelled as completing each command instantly; data is
+		// moved to or from RAM a whole block at a time upon the next bus grant.
+		std::array<std::shared_ptr<Storage::MassStorage::MassStorageDevice>, 8> hard_disks_;
+		uint8_t acsi_command_[12];
+		int acsi_command_length_ = 0;
+		bool acsi_interrupt_ = false;
+		uint8_t acsi_status_ = 0;
+
+		// Sense data for the most recent failure, if any, in SCSI terms.
+		uint8_t acsi_sense_key_ = 0;
+		uint8_t acsi_additional_sense_ = 0;
+		uint32_t acsi_sense_address_ = 0;
+
+		enum class ACSITransfer {
+			None, ReadBlocks, WriteBlocks, ReadData
+		} acsi_transfer_ = ACSITransfer::None;
+		Storage::MassStorage::MassStorageDevice *acsi_device_ = nullptr;
+		uint32_t acsi_address_ = 0;
+		uint32_t acsi_block_count_ = 0;
+		std::vector<uint8_t> acsi_data_;
+
+		void write_acsi_command(uint8_t);
+		void execute_acsi_command(Storage::MassStorage::MassStorageDevice &, uint8_t opcode, const uint8_t *command);
+		void begin_acsi_transfer(ACSITransfer);
+		void complete_acsi_command(uint8_t sense_key = 0, uint8_t additional_sense = 0, uint32_t address = 0);
+		int acsi_bus_grant(uint16_t *ram, size_t size);
+		void update_interrupt_line();
 };
 
 }
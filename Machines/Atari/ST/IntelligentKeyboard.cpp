@@ -20,8 +20,8 @@ IntelligentKeyboard::IntelligentKeyboard(Serial::Line<false> &input, Serial::Lin
 	output_line_.set_writer_clock_rate(15625);
 
 	// Add two joysticks into the mix.
-	joysticks_.emplace_back(new Joystick);
-	joysticks_.emplace_back(new Joystick);
+	joysticks_.emplace_back(new Joystick(has_input_));
+	joysticks_.emplace_back(new Joystick(has_input_));
 }
 
 bool IntelligentKeyboard::serial_line_did_produce_bit(Serial::Line<false> *, int bit) {
@@ -45,8 +45,43 @@ ClockingHint::Preference IntelligentKeyboard::preferred_clocking() const {
 }
 
 void IntelligentKeyboard::run_for(HalfCycles duration) {
-	// Take this opportunity to check for joystick, mouse and keyboard events,
-	// which will have been received asynchronously.
+	output_line_.advance_writer(duration);
+
+	// Once the final byte has been delivered, time is no longer required.
+	if(!output_line_.transmission_data_time_remaining()) {
+		update_clocking_observer();
+	}
+}
+
+HalfCycles IntelligentKeyboard::next_byte_time() const {
+	// Each byte is ten bits of two clocks each, every bit being preceded by its delay.
+	// A receiver is posted bits only upon a level change, so each byte is complete
+	// upon the start bit that follows it or, for the final byte, once the line has
+	// allowed for the receiver's final sample.
+	constexpr HalfCycles::IntType bit_length = 2, byte_length = bit_length * 10;
+	const auto remaining = output_line_.write_data_time_remaining().as_integral();
+	if(!remaining) {
+		return output_line_.transmission_data_time_remaining();
+	}
+
+	// If this byte's start bit is yet to come, the previous byte completes with it.
+	const auto in_byte = ((remaining - 1) % byte_length) + 1;
+	if(in_byte > byte_length - bit_length) {
+		return HalfCycles(in_byte - byte_length + bit_length);
+	}
+
+	// Otherwise this byte completes with the next's start bit, if there is a next.
+	if(remaining > in_byte) {
+		return HalfCycles(in_byte + bit_length);
+	}
+	return HalfCycles(remaining);
+}
+
+void IntelligentKeyboard::process_inputs() {
+	// Check for joystick, mouse and keyboard events, which will have been received
+	// asynchronously, but only if any have been posted.
+	if(!has_input_.exchange(false)) return;
+
 	const int captured_movement[2] = { mouse_movement_[0].load(), mouse_movement_[1].load() };
 	switch(mouse_mode_) {
 		case MouseMode::Relative: {
@@ -137,8 +172,6 @@ void IntelligentKeyboard::run_for(HalfCycles duration) {
 			}
 		}
 	}
-
-	output_line_.advance_writer(duration);
 }
 
 void IntelligentKeyboard::output_bytes(std::initializer_list<uint8_t> values) {
@@ -354,6 +387,7 @@ void IntelligentKeyboard::set_key_state(Key key, bool is_pressed) {
 	} else {
 		key_queue_.push_back(0x80 | uint8_t(key));
 	}
+	has_input_ = true;
 }
 
 uint16_t IntelligentKeyboard::KeyboardMapper::mapped_key_for_key(Inputs::Keyboard::Key key) const {
@@ -422,6 +456,7 @@ uint16_t IntelligentKeyboard::KeyboardMapper::mapped_key_for_key(Inputs::Keyboar
 void IntelligentKeyboard::move(int x, int y) {
 	mouse_movement_[0] += x;
 	mouse_movement_[1] += y;
+	has_input_ = true;
 }
 
 int IntelligentKeyboard::get_number_of_buttons() {
@@ -440,10 +475,12 @@ void IntelligentKeyboard::set_button_pressed(int index, bool is_pressed) {
 		mouse_button_state_ &= ~mask;
 		mouse_button_events_ |= event_mask << 1;
 	}
+	has_input_ = true;
 }
 
 void IntelligentKeyboard::reset_all_buttons() {
 	mouse_button_state_ = 0;
+	has_input_ = true;
 }
 
 // MARK: - Joystick Output
@@ -51,6 +51,10 @@ static_assert(uint16_t(Key::KeypadEnter) == 0x72, "KeypadEnter should have key c
 /*!
 	A receiver for the Atari ST's "intelligent keyboard" commands, which actually cover
 	keyboard input and output and mouse handling.
+
+	The keyboard is event driven: commands are decoded as they arrive from the ACIA, host input
+	is inspected only once something has been posted, and time is required only while there are
+	bytes still to transmit, during which the owner need advance it only at the ends of bytes.
 */
 class IntelligentKeyboard:
 	public Serial::Line<false>::ReadDelegate,
@@ -59,8 +63,17 @@ class IntelligentKeyboard:
 	public:
 		IntelligentKeyboard(Serial::Line<false> &input, Serial::Line<false> &output);
 		ClockingHint::Preference preferred_clocking() const final;
+
+		/// Advances serial output by @c duration, which is in units of the keyboard's 15625Hz clock.
 		void run_for(HalfCycles duration);
 
+		/// @returns The amount of time, in units of the keyboard's clock, until the next byte has been completely
+		/// 	transmitted; output may be advanced lazily up to then without affecting the receiving ACIA.
+		HalfCycles next_byte_time() const;
+
+		/// Converts any host input that has been posted since the last call into output.
+		void process_inputs();
+
 		void set_key_state(Key key, bool is_pressed);
 		class KeyboardMapper: public MachineTypes::MappedKeyboardMachine::KeyboardMapper {
 			uint16_t mapped_key_for_key(Inputs::Keyboard::Key key) const final;
@@ -71,6 +84,9 @@ class IntelligentKeyboard:
 		}
 
 	private:
+		// Set whenever the host posts input; cleared when it is processed.
+		std::atomic<bool> has_input_{false};
+
 		// MARK: - Key queue.
 		std::mutex key_queue_mutex_;
 		std::vector<uint8_t> key_queue_;
@@ -153,14 +169,14 @@ class IntelligentKeyboard:
 
 		class Joystick: public Inputs::ConcreteJoystick {
 			public:
-				Joystick() :
+				Joystick(std::atomic<bool> &has_input) :
 					ConcreteJoystick({
 						Input(Input::Up),
 						Input(Input::Down),
 						Input(Input::Left),
 						Input(Input::Right),
 						Input(Input::Fire, 0),
-					}) {}
+					}), has_input_(has_input) {}
 
 				void did_set_input(const Input &input, bool is_active) final {
 					uint8_t mask = 0;
@@ -174,6 +190,7 @@ class IntelligentKeyboard:
 					}
 
 					if(is_active) state_ |= mask; else state_ &= ~mask;
+					has_input_ = true;
 				}
 
 				uint8_t get_state() {
@@ -192,6 +209,7 @@ class IntelligentKeyboard:
 			private:
 				uint8_t state_ = 0x00;
 				uint8_t returned_state_ = 0x00;
+				std::atomic<bool> &has_input_;
 		};
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 };
@@ -11,7 +11,9 @@
 #include "../../../Outputs/Log.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <utility>
 
 #define CYCLE(x)	((x) * 2)
 
@@ -646,6 +648,39 @@ namespace {
 #else
 	constexpr int upper = 1;
 #endif
+
+/// Expands a byte into eight, each being 0 or 1, with the most significant bit of the source becoming the least significant byte of the result.
+constexpr uint64_t spread_byte(int source) {
+	uint64_t result = 0;
+	for(int c = 0; c < 8; c++) {
+		result |= uint64_t((source >> (7 - c)) & 1) << (c * 8);
+	}
+	return result;
+}
+
+template <size_t... bytes> constexpr std::array<uint64_t, 256> spread_byte_table(std::index_sequence<bytes...>) {
+	return {spread_byte(int(bytes))...};
+}
+constexpr auto spread_bytes = spread_byte_table(std::make_index_sequence<256>());
+
+/// Converts sixteen pixels of planar data, supplied as one word per plane with the least significant plane first,
+/// into per-pixel indices, leftmost pixel first.
+template <int plane_count, typename... WordsT> void planar_to_chunky(uint8_t *indices, WordsT... words) {
+	static_assert(sizeof...(WordsT) == plane_count);
+	const uint16_t planes[] = {words...};
+
+	uint64_t left = 0, right = 0;
+	for(int plane = 0; plane < plane_count; plane++) {
+		left |= spread_bytes[planes[plane] >> 8] << plane;
+		right |= spread_bytes[planes[plane] & 0xff] << plane;
+	}
+
+	for(int c = 0; c < 8; c++) {
+		indices[c] = uint8_t(left >> (c * 8));
+		indices[c + 8] = uint8_t(right >> (c * 8));
+	}
+}
+
 }
 
 void Video::VideoStream::shift(int duration) {
@@ -693,46 +728,63 @@ void Video::VideoStream::output_pixels(int duration) {
 		int pixels_to_draw = std::min(allocation_size - pixel_pointer_, pixels);
 		pixels -= pixels_to_draw;
 
-		switch(bpp_) {
-			case OutputBpp::One:
-				while(pixels_to_draw--) {
-					pixel_buffer_[pixel_pointer_] = ((output_shifter_ >> 63) & 1) * 0xffff;
-					output_shifter_ <<= 1;
+		// Convert up to sixteen pixels at a time, those being the most that the top word
+		// of each plane supplies. Register writes always cause output up to the point of the
+		// write, so the palette and mode are constant throughout.
+		while(pixels_to_draw) {
+			const int count = std::min(pixels_to_draw, 16);
+			pixels_to_draw -= count;
+
+			uint8_t indices[16];
+			const uint16_t top_word = uint16_t(output_shifter_ >> 48);
+			switch(bpp_) {
+				case OutputBpp::One:
+					planar_to_chunky<1>(indices, top_word);
+					for(int c = 0; c < count; c++) {
+						pixel_buffer_[pixel_pointer_ + c] = uint16_t(indices[c] * 0xffff);
+					}
+
+					output_shifter_ <<= count;
+				break;
+
+				case OutputBpp::Two: {
+					planar_to_chunky<2>(indices, top_word, uint16_t(output_shifter_ >> 32));
+					for(int c = 0; c < count; c++) {
+						pixel_buffer_[pixel_pointer_ + c] = palette_[indices[c]];
+					}
+
+					// The top two words shift to the left, their least significant bits
+					// being fed from the most significant bits of the bottom two words.
+					const uint64_t planes[2] = {
+						((output_shifter_ >> 32) & 0xffff'0000) | ((output_shifter_ >> 16) & 0xffff),
+						((output_shifter_ >> 16) & 0xffff'0000) | (output_shifter_ & 0xffff),
+					};
+					const uint64_t shifted[2] = {
+						(planes[0] << count) & 0xffff'ffff,
+						(planes[1] << count) & 0xffff'ffff,
+					};
+					output_shifter_ =
+						((shifted[0] >> 16) << 48) | ((shifted[1] >> 16) << 32) |
+						((shifted[0] & 0xffff) << 16) | (shifted[1] & 0xffff);
+				} break;
+
+				case OutputBpp::Four:
+					planar_to_chunky<4>(
+						indices,
+						top_word,
+						uint16_t(output_shifter_ >> 32),
+						uint16_t(output_shifter_ >> 16),
+						uint16_t(output_shifter_)
+					);
+					for(int c = 0; c < count; c++) {
+						pixel_buffer_[pixel_pointer_ + c] = palette_[indices[c]];
+					}
+
+					output_shifter_ = (output_shifter_ << count) & (uint64_t(uint16_t(0xffff << count)) * 0x0001'0001'0001'0001);
+				break;
+			}
 
-					++pixel_pointer_;
-				}
-			break;
-
-			case OutputBpp::Two:
-				while(pixels_to_draw--) {
-					pixel_buffer_[pixel_pointer_] = palette_[
-						((output_shifter_ >> 63) & 1) |
-						((output_shifter_ >> 46) & 2)
-					];
-					// This ensures that the top two words shift one to the left;
-					// their least significant bits are fed from the most significant bits
-					// of the bottom two words, respectively.
-					shifter_halves_[upper] = (shifter_halves_[upper] << 1) & 0xfffefffe;
-					shifter_halves_[upper] |= (shifter_halves_[upper^1] & 0x80008000) >> 15;
-					shifter_halves_[upper^1] = (shifter_halves_[upper^1] << 1) & 0xfffefffe;
-
-					++pixel_pointer_;
-				}
-			break;
-
-			case OutputBpp::Four:
-				while(pixels_to_draw--) {
-					pixel_buffer_[pixel_pointer_] = palette_[
-						((output_shifter_ >> 63) & 1) |
-						((output_shifter_ >> 46) & 2) |
-						((output_shifter_ >> 29) & 4) |
-						((output_shifter_ >> 12) & 8)
-					];
-					output_shifter_ = (output_shifter_ << 1) & 0xfffefffefffefffe;
-
-					++pixel_pointer_;
-				}
-			break;
+			pixel_pointer_ += count;
 		}
 
 		// Check whether the limit has been reached.
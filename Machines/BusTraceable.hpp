@@ -0,0 +1,30 @@
+//
+//  BusTraceable.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef BusTraceable_hpp
+#define BusTraceable_hpp
+
+#include "../Processors/BusTrace.hpp"
+
+namespace MachineTypes {
+
+/*!
+	A BusTraceable machine can record every bus cycle of its primary processor to a CPU::BusTrace.
+*/
+struct BusTraceable {
+	/// @returns The type of bus that this machine's primary processor has, for supply to CPU::BusTrace.
+	virtual CPU::BusTrace::Bus traced_bus() const = 0;
+
+	/// Nominates @c trace to receive a record of every subsequent bus cycle, or ends tracing if @c trace
+	/// is @c nullptr. The trace must remain valid until tracing has ended.
+	virtual void set_bus_trace(CPU::BusTrace *trace) = 0;
+};
+
+}
+
+#endif /* BusTraceable_hpp */
@@ -26,6 +26,8 @@
 
 #include "../../Analyser/Dynamic/ConfidenceCounter.hpp"
 
+#include <algorithm>
+
 namespace {
 constexpr int sn76489_divider = 2;
 }
@@ -117,6 +119,7 @@ class ConcreteMachine:
 	public:
 		ConcreteMachine(const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher) :
 			z80_(*this),
+			vdp_(HalfCycles(4096)),
 			sn76489_(TI::SN76489::Personality::SN76489, audio_queue_, sn76489_divider),
 			ay_(GI::AY38910::Personality::AY38910, audio_queue_),
 			mixer_(sn76489_, ay_),
@@ -164,6 +167,8 @@ class ConcreteMachine:
 
 			// ColecoVisions have composite output only.
 			vdp_->set_display_type(Outputs::Display::DisplayType::CompositeColour);
+
+			update_fast_memory();
 		}
 
 		~ConcreteMachine() {
@@ -238,6 +243,7 @@ class ConcreteMachine:
 						} else if(address >= 0x8000 && address <= cartridge_address_limit_) {
 							if(is_megacart_ && address >= 0xffc0) {
 								page_megacart(address);
+								update_fast_memory();
 							}
 							*cycle.value = cartridge_pages_[(address >> 14)&1][address&0x3fff];
 						} else {
@@ -254,6 +260,7 @@ class ConcreteMachine:
 							ram_[address & 1023] = *cycle.value;
 						} else if(is_megacart_ && address >= 0xffc0) {
 							page_megacart(address);
+							update_fast_memory();
 						}
 					break;
 
@@ -300,8 +307,14 @@ class ConcreteMachine:
 							break;
 
 							case 5:
-								vdp_->write(address, *cycle.value);
-								z80_.set_non_maskable_interrupt_line(vdp_->get_interrupt_line());
+								if(!(address & 1)) {
+									vdp_.post([address, value = *cycle.value] (auto &vdp) {
+										vdp.write(address, value);
+									});
+								} else {
+									vdp_->write(address, *cycle.value);
+									z80_.set_non_maskable_interrupt_line(vdp_->get_interrupt_line());
+								}
 							break;
 
 							case 7:
@@ -315,6 +328,7 @@ class ConcreteMachine:
 									default: break;
 									case 0x7f:
 										super_game_module_.replace_bios = !((*cycle.value)&0x2);
+										update_fast_memory();
 									break;
 									case 0x50:
 										// Set AY address.
@@ -328,6 +342,7 @@ class ConcreteMachine:
 									break;
 									case 0x53:
 										super_game_module_.replace_ram = !!((*cycle.value)&0x1);
+										update_fast_memory();
 									break;
 								}
 							break;
@@ -338,9 +353,46 @@ class ConcreteMachine:
 				}
 			}
 
+			fast_memory_.time_available = vdp_.time_until_implicit_flush();
 			return penalty;
 		}
 
+		// Other than the Z80's wait line being held during SN76489 writes, which are output cycles,
+		// and an extra cycle on every M1, memory accesses are uniform; the only other timing-dependent
+		// component is the VDP, which limits how far the Z80 may proceed without notice via its sequence points.
+		static constexpr bool has_fast_memory = true;
+
+		CPU::Z80::FastMemory &fast_memory() {
+			return fast_memory_;
+		}
+
+		void advance_time(HalfCycles duration) {
+			if(vdp_ += duration) {
+				z80_.set_non_maskable_interrupt_line(vdp_->get_interrupt_line());
+			}
+			time_since_sn76489_update_ += duration;
+			fast_memory_.time_available = vdp_.time_until_implicit_flush();
+		}
+
+		// Only the Z80 can change the contents of the fast memory pages and only the VDP can generate an
+		// interrupt, so a loop that reads only from those pages can be skipped until just before the VDP
+		// next needs attention.
+		static constexpr bool skips_idle_loops = true;
+
+		HalfCycles skip_idle_loop(const CPU::Z80::IdleLoop &loop, HalfCycles limit) {
+			for(int c = 0; c < loop.read_count; c++) {
+				if(!fast_memory_.read[loop.reads[c] >> CPU::Z80::FastMemory::PageShift]) {
+					return HalfCycles(0);
+				}
+			}
+
+			const HalfCycles duration = loop.whole_iterations(std::min(limit, vdp_.time_until_implicit_flush() - HalfCycles(1)));
+			if(duration > HalfCycles(0)) {
+				advance_time(duration);
+			}
+			return duration;
+		}
+
 		void flush_output(int outputs) final {
 			if(outputs & Output::Video) {
 				vdp_.flush();
@@ -373,14 +425,47 @@ class ConcreteMachine:
 			const std::size_t selected_start = (size_t(address&63) << 14) % cartridge_.size();
 			cartridge_pages_[1] = &cartridge_[selected_start];
 		}
+		void update_fast_memory() {
+			constexpr int PageSize = 1 << CPU::Z80::FastMemory::PageShift;
+			auto &memory = fast_memory_;
+			std::fill(std::begin(memory.read), std::end(memory.read), nullptr);
+			std::fill(std::begin(memory.write), std::end(memory.write), nullptr);
+			memory.opcode_fetch_delay = HalfCycles(2);
+
+			// Accesses to the first page are left to perform_machine_cycle so that it can
+			// count opcode fetches from address 0.
+			for(int address = PageSize; address < 0x2000; address += PageSize) {
+				if(super_game_module_.replace_bios) {
+					memory.read[address / PageSize] = memory.write[address / PageSize] = &super_game_module_.ram[address];
+				} else {
+					memory.read[address / PageSize] = &bios_[size_t(address)];
+				}
+			}
+
+			for(int address = 0x2000; address < 0x8000; address += PageSize) {
+				if(super_game_module_.replace_ram) {
+					memory.read[address / PageSize] = memory.write[address / PageSize] = &super_game_module_.ram[address];
+				} else if(address >= 0x6000) {
+					memory.read[address / PageSize] = memory.write[address / PageSize] = ram_;
+				}
+			}
+
+			// Cartridge pages are read-only, and a megacart's final page contains its paging addresses.
+			if(cartridge_.empty()) return;
+			const int cartridge_end = is_megacart_ ? 0xfc00 : cartridge_address_limit_ + 1;
+			for(int address = 0x8000; address + PageSize <= cartridge_end; address += PageSize) {
+				memory.read[address / PageSize] = &cartridge_pages_[(address >> 14) & 1][address & 0x3fff];
+			}
+		}
+
 		inline void update_audio() {
 			speaker_.run_for(audio_queue_, time_since_sn76489_update_.divide_cycles(Cycles(sn76489_divider)));
 		}
 
 		CPU::Z80::Processor<ConcreteMachine, false, false> z80_;
-		JustInTimeActor<TI::TMS::TMS9918<TI::TMS::Personality::TMS9918A>> vdp_;
+		AsyncJustInTimeActor<TI::TMS::TMS9918<TI::TMS::Personality::TMS9918A>> vdp_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		TI::SN76489 sn76489_;
 		GI::AY38910::AY38910<false> ay_;
 		Outputs::Speaker::CompoundSource<TI::SN76489, GI::AY38910::AY38910<false>> mixer_;
@@ -402,6 +487,7 @@ class ConcreteMachine:
 		bool joysticks_in_keypad_mode_ = false;
 
 		HalfCycles time_since_sn76489_update_;
+		CPU::Z80::FastMemory fast_memory_;
 
 		Analyser::Dynamic::ConfidenceCounter confidence_counter_;
 		int pc_zero_accesses_ = 0;
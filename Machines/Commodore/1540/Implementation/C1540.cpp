@@ -39,6 +39,7 @@ MachineBase::MachineBase(Personality personality, const ROM::Map &roms) :
 	serial_port_VIA_port_handler_->set_interrupt_delegate(this);
 	drive_VIA_port_handler_.set_interrupt_delegate(this);
 	drive_VIA_port_handler_.set_delegate(this);
+	serial_port_->set_delegate(this);
 
 	// set a bit rate
 	set_expected_bit_length(Storage::Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(3));
@@ -82,6 +83,9 @@ Cycles MachineBase::perform_bus_operation(CPU::MOS6502::BusOperation operation,
 			*value = ram_[address];
 		else
 			ram_[address] = *value;
+
+		// Code running from RAM is assumed to be doing something worthwhile.
+		if(operation == CPU::MOS6502::BusOperation::ReadOpcode) cycles_since_activity_ = 0;
 	} else if(address >= 0xc000) {
 		if(isReadOperation(operation)) {
 			*value = rom_[address & 0x3fff];
@@ -106,6 +110,10 @@ Cycles MachineBase::perform_bus_operation(CPU::MOS6502::BusOperation operation,
 
 void Machine::set_disk(std::shared_ptr<Storage::Disk::Disk> disk) {
 	get_drive().set_disk(disk);
+
+	// Give the DOS a chance to notice the change of disk.
+	cycles_since_activity_ = 0;
+	set_is_idle(false);
 }
 
 void Machine::run_for(const Cycles cycles) {
@@ -115,6 +123,43 @@ void Machine::run_for(const Cycles cycles) {
 	get_drive().set_motor_on(drive_motor);
 	if(drive_motor)
 		Storage::Disk::Controller::run_for(cycles);
+
+	update_idleness(cycles, drive_motor);
+}
+
+// MARK: - Idle detection
+
+void MachineBase::update_idleness(Cycles cycles, bool drive_motor) {
+	const int outputs =
+		drive_VIA_port_handler_.get_port_b_output() |
+		(serial_port_->get_output(::Commodore::Serial::Line::Clock) ? 0x100 : 0) |
+		(serial_port_->get_output(::Commodore::Serial::Line::Data) ? 0x200 : 0);
+
+	if(drive_motor || outputs != previous_outputs_) {
+		previous_outputs_ = outputs;
+		cycles_since_activity_ = 0;
+	} else if(cycles_since_activity_ < IdleThreshold) {
+		cycles_since_activity_ += cycles.as_integral();
+	}
+
+	set_is_idle(cycles_since_activity_ >= IdleThreshold);
+}
+
+void MachineBase::set_is_idle(bool is_idle) {
+	if(is_idle == is_idle_) return;
+	is_idle_ = is_idle;
+	update_clocking_observer();
+}
+
+ClockingHint::Preference MachineBase::preferred_clocking() const {
+	// The disk controller is clocked only while the motor is on, which precludes idleness,
+	// so there's no need to consult it.
+	return is_idle_ ? ClockingHint::Preference::None : ClockingHint::Preference::RealTime;
+}
+
+void MachineBase::serial_port_did_change_input(SerialPort *) {
+	cycles_since_activity_ = 0;
+	set_is_idle(false);
 }
 
 void MachineBase::set_activity_observer(Activity::Observer *observer) {
@@ -239,6 +284,10 @@ bool DriveVIA::get_motor_enabled() {
 	return drive_motor_;
 }
 
+uint8_t DriveVIA::get_port_b_output() {
+	return previous_port_b_output_;
+}
+
 void DriveVIA::set_control_line_output(MOS::MOS6522::Port port, MOS::MOS6522::Line line, bool value) {
 	if(port == MOS::MOS6522::Port::A && line == MOS::MOS6522::Line::Two) {
 		should_set_overflow_ = value;
@@ -284,6 +333,11 @@ void DriveVIA::set_activity_observer(Activity::Observer *observer) {
 void SerialPort::set_input(::Commodore::Serial::Line line, ::Commodore::Serial::LineLevel level) {
 	std::shared_ptr<SerialPortVIA> serialPortVIA = serial_port_VIA_.lock();
 	if(serialPortVIA) serialPortVIA->set_serial_line_state(line, bool(level));
+	if(delegate_) delegate_->serial_port_did_change_input(this);
+}
+
+void SerialPort::set_delegate(Delegate *delegate) {
+	delegate_ = delegate;
 }
 
 void SerialPort::set_serial_port_via(const std::shared_ptr<SerialPortVIA> &serialPortVIA) {
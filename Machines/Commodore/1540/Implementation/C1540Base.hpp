@@ -92,6 +92,7 @@ class DriveVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 		void set_data_input(uint8_t);
 		bool get_should_set_overflow();
 		bool get_motor_enabled();
+		uint8_t get_port_b_output();
 
 		void set_control_line_output(MOS::MOS6522::Port, MOS::MOS6522::Line, bool value);
 
@@ -113,17 +114,25 @@ class DriveVIA: public MOS::MOS6522::IRQDelegatePortHandler {
 */
 class SerialPort : public ::Commodore::Serial::Port {
 	public:
+		class Delegate {
+			public:
+				virtual void serial_port_did_change_input(SerialPort *) = 0;
+		};
+		void set_delegate(Delegate *);
+
 		void set_input(::Commodore::Serial::Line, ::Commodore::Serial::LineLevel);
 		void set_serial_port_via(const std::shared_ptr<SerialPortVIA> &);
 
 	private:
 		std::weak_ptr<SerialPortVIA> serial_port_VIA_;
+		Delegate *delegate_ = nullptr;
 };
 
 class MachineBase:
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
 	public DriveVIA::Delegate,
+	public SerialPort::Delegate,
 	public Storage::Disk::Controller {
 
 	public:
@@ -139,6 +148,15 @@ class MachineBase:
 		void drive_via_did_step_head(void *driveVIA, int direction);
 		void drive_via_did_set_data_density(void *driveVIA, int density);
 
+		// to satisfy SerialPort::Delegate
+		void serial_port_did_change_input(SerialPort *serial_port) final;
+
+		/*!
+			As per ClockingHint::Source; the drive will prefer no clocking while its CPU is idle,
+			which it will remain until there is a change on the serial bus or a disk is inserted.
+		*/
+		ClockingHint::Preference preferred_clocking() const override;
+
 		/// Attaches the activity observer to this C1540.
 		void set_activity_observer(Activity::Observer *observer);
 
@@ -158,6 +176,18 @@ class MachineBase:
 		int shift_register_ = 0, bit_window_offset_;
 		virtual void process_input_bit(int value);
 		virtual void process_index_hole();
+
+		/*
+			Idle detection: the drive is considered idle once it has spent IdleThreshold cycles with its motor off,
+			executing only from ROM and without any change in its outputs, at which point the DOS is waiting for
+			something to happen on the serial bus.
+		*/
+		static constexpr Cycles::IntType IdleThreshold = 500000;
+		Cycles::IntType cycles_since_activity_ = 0;
+		int previous_outputs_ = 0;
+		bool is_idle_ = false;
+		void update_idleness(Cycles cycles, bool drive_motor);
+		void set_is_idle(bool is_idle);
 };
 
 }
@@ -8,6 +8,8 @@
 
 #include "Keyboard.hpp"
 
+#include <iterator>
+
 using namespace Commodore::Vic20;
 
 uint16_t KeyboardMapper::mapped_key_for_key(Inputs::Keyboard::Key key) const {
@@ -153,3 +155,22 @@ const uint16_t *CharacterMapper::sequence_for_character(char character) const {
 
 	return table_lookup_sequence_for_character(key_sequences, character);
 }
+
+uint8_t Commodore::Vic20::petscii_for_character(char character) {
+	// PETSCII matches ASCII from space to Z, other than in lacking a backslash, caret and underscore;
+	// 0x5c, 0x5e and 0x5f are instead the pound sign, up arrow and left arrow. Lowercase letters map
+	// to their uppercase equivalents, being unshifted, and there are no codes beyond 0x5f without shift.
+	static constexpr uint8_t petscii[128] = {
+		/* NUL–SI */	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x00, 0x00,
+		/* DLE–US */	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		/* space–/ */	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+		/* 0–? */		0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f,
+		/* @–O */		0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+		/* P–_ */		0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x00, 0x5d, 0x00, 0x00,
+		/* `–o */		0x00, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f,
+		/* p–DEL */		0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x00, 0x00, 0x00, 0x00, 0x00,
+	};
+
+	const auto index = size_t(uint8_t(character));
+	return index < std::size(petscii) ? petscii[index] : 0;
+}
@@ -55,6 +55,9 @@ struct CharacterMapper: public ::Utility::CharacterMapper {
 	const uint16_t *sequence_for_character(char character) const final;
 };
 
+/// @returns The PETSCII code that the KERNAL would produce for @c character if typed, or @c 0 if there is none.
+uint8_t petscii_for_character(char character);
+
 }
 }
 
@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <string>
 
 namespace Commodore {
 namespace Vic20 {
@@ -364,6 +365,7 @@ class ConcreteMachine:
 
 				// give it a little warm up
 				c1540_->run_for(Cycles(2000000));
+				c1540_->set_clocking_hint_observer(this);
 			}
 
 			// Determine PAL/NTSC
@@ -614,8 +616,24 @@ class ConcreteMachine:
 					typer_.reset();
 				}
 			}
+
+			// 0xeb1e is the start of the KERNAL's keyboard scan, which runs at the start of every IRQ; take it
+			// as a convenient moment to move any pending text directly into the keyboard buffer.
+			if(!input_text_.empty() && address == 0xeb1e && operation == CPU::MOS6502::BusOperation::ReadOpcode) {
+				// The buffer is at 0x277, NDX (the number of characters in it) is at 0xc6 and
+				// XMAX (the buffer's current capacity) is at 0x289.
+				const uint8_t capacity = std::min(ram_[0x289], uint8_t(10));
+				std::size_t characters_written = 0;
+				while(characters_written < input_text_.size() && ram_[0xc6] < capacity) {
+					ram_[0x277 + ram_[0xc6]] = uint8_t(input_text_[characters_written]);
+					++ram_[0xc6];
+					++characters_written;
+				}
+				input_text_.erase(0, characters_written);
+			}
+
 			if(!tape_is_sleeping_ && !hold_tape_) tape_->run_for(Cycles(1));
-			if(c1540_) c1540_->run_for(Cycles(1));
+			if(!c1540_is_sleeping_) c1540_->run_for(Cycles(1));
 
 			return Cycles(1);
 		}
@@ -659,11 +677,15 @@ class ConcreteMachine:
 		}
 
 		void type_string(const std::string &string) final {
-			Utility::TypeRecipient<CharacterMapper>::add_typer(string);
+			for(const char c: string) {
+				if(const uint8_t code = petscii_for_character(c)) {
+					input_text_.push_back(char(code));
+				}
+			}
 		}
 
 		bool can_type(char c) const final {
-			return Utility::TypeRecipient<CharacterMapper>::can_type(c);
+			return petscii_for_character(c);
 		}
 
 		void tape_did_change_input(Storage::Tape::BinaryTapePlayer *tape) final {
@@ -690,8 +712,14 @@ class ConcreteMachine:
 			set_use_fast_tape();
 		}
 
-		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference clocking) final {
+		void set_component_prefers_clocking(ClockingHint::Source *component, ClockingHint::Preference clocking) final {
+			if(c1540_ && component == c1540_.get()) {
+				c1540_is_sleeping_ = clocking == ClockingHint::Preference::None;
+				return;
+			}
+
 			tape_is_sleeping_ = clocking == ClockingHint::Preference::None;
+			set_is_loading(!tape_is_sleeping_);
 			set_use_fast_tape();
 		}
 
@@ -713,6 +741,9 @@ class ConcreteMachine:
 		std::vector<uint8_t> rom_;
 		uint16_t rom_address_, rom_length_;
 		uint8_t ram_[0x10000];
+
+		// Text that has been typed but not yet placed in the keyboard buffer, in PETSCII.
+		std::string input_text_;
 		uint8_t colour_ram_[0x0400];
 
 		uint8_t *processor_read_memory_map_[64];
@@ -753,6 +784,7 @@ class ConcreteMachine:
 
 		// Disk
 		std::shared_ptr<::Commodore::C1540::Machine> c1540_;
+		bool c1540_is_sleeping_ = true;	// i.e. also true if there is no C1540.
 };
 
 }
@@ -41,6 +41,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 	public MachineTypes::TimedMachine,
 	public MachineTypes::ScanProducer,
 	public MachineTypes::AudioProducer,
+	public MachineTypes::BusTraceable,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public Configurable::Device,
@@ -252,6 +253,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 							tape_.set_is_enabled((*value & 6) != 6);
 							tape_.set_is_in_input_mode((*value & 6) == 0);
 							tape_.set_is_running((*value & 0x40) ? true : false);
+							set_is_loading((*value & 0x40) && tape_.has_tape());
 
 							caps_led_state_ = !!(*value & 0x80);
 							if(activity_observer_)
@@ -596,6 +598,8 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = allow_fast_tape_hack_;
+			options->fast_disk = plus3_ && plus3_->get_is_fast_sector_access_enabled();
+			options->fast_mechanics = plus3_ && plus3_->get_is_fast_mechanics_enabled();
 			return options;
 		}
 
@@ -605,6 +609,19 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 			allow_fast_tape_hack_ = options->quickload;
 			set_use_fast_tape_hack();
+			if(plus3_) {
+				plus3_->set_is_fast_sector_access_enabled(options->fast_disk);
+				plus3_->set_is_fast_mechanics_enabled(options->fast_mechanics);
+			}
+		}
+
+		// MARK: - BusTraceable.
+		CPU::BusTrace::Bus traced_bus() const final {
+			return CPU::BusTrace::Bus::MOS6502;
+		}
+
+		void set_bus_trace(CPU::BusTrace *trace) final {
+			m6502_.set_bus_trace(trace);
 		}
 
 		// MARK: - Activity Source
@@ -770,7 +787,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 		// Outputs
 		JustInTimeActor<VideoOutput, Cycles> video_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		SoundGenerator sound_generator_;
 		Outputs::Speaker::PullLowpass<SoundGenerator> speaker_;
 
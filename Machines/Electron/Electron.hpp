@@ -32,16 +32,22 @@ class Machine {
 		static Machine *Electron(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
 
 		/// Defines the runtime options available for an Electron.
-		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options>, public Configurable::QuickloadOption<Options> {
+		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options>, public Configurable::QuickloadOption<Options>, public Configurable::FastDiskOption<Options>, public Configurable::FastMechanicsOption<Options> {
 			friend Configurable::DisplayOption<Options>;
 			friend Configurable::QuickloadOption<Options>;
+			friend Configurable::FastDiskOption<Options>;
+			friend Configurable::FastMechanicsOption<Options>;
 			public:
 				Options(Configurable::OptionsType type) :
 					Configurable::DisplayOption<Options>(type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour),
-					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly) {
+					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly),
+					Configurable::FastDiskOption<Options>(false),
+					Configurable::FastMechanicsOption<Options>(false) {
 					if(needs_declare()) {
 						declare_display_option();
 						declare_quickload_option();
+						declare_fast_disk_option();
+						declare_fast_mechanics_option();
 						limit_enum(&output, Configurable::Display::RGB, Configurable::Display::CompositeColour, Configurable::Display::CompositeMonochrome, -1);
 					}
 				}
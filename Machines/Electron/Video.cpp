@@ -19,6 +19,7 @@ namespace {
 	constexpr int cycles_per_line = 128;
 	constexpr int lines_per_frame = 625;
 	constexpr int cycles_per_frame = lines_per_frame * cycles_per_line;
+	static_assert(cycles_per_frame == VideoOutput::CyclesPerFrame);
 	constexpr int crt_cycles_multiplier = 8;
 	constexpr int crt_cycles_per_line = crt_cycles_multiplier * cycles_per_line;
 
@@ -34,6 +35,30 @@ namespace {
 	constexpr int real_time_clock_interrupt_2 = 56704;
 	constexpr int display_end_interrupt_1 = (first_graphics_line + display_end_interrupt_line)*cycles_per_line;
 	constexpr int display_end_interrupt_2 = (first_graphics_line + field_divider_line + display_end_interrupt_line)*cycles_per_line;
+
+	/// For every position in the frame, the number of cycles until the CPU may next access RAM. RAM is
+	/// available only on every other cycle and, in Modes 0–3, not at all while pixels are being fetched.
+	struct RAMDelays {
+		uint8_t bitmapped_modes[cycles_per_frame];	// i.e. Modes 0–3.
+		uint8_t other_modes[cycles_per_frame];
+
+		RAMDelays() {
+			for(int position = 0; position < cycles_per_frame; position++) {
+				const uint8_t alignment = uint8_t(1 + (position&1));
+				other_modes[position] = alignment;
+
+				const int current_column = graphics_column(position + (position&1));
+				const int current_line = graphics_line(position);
+				bitmapped_modes[position] =
+					(current_column < 80 && current_line < 256) ? uint8_t(alignment + 80 - current_column) : alignment;
+			}
+		}
+	};
+
+	const RAMDelays &ram_delays() {
+		static const RAMDelays delays;
+		return delays;
+	}
 }
 
 // MARK: - Lifecycle
@@ -45,6 +70,7 @@ VideoOutput::VideoOutput(uint8_t *memory) :
 		Outputs::Display::Type::PAL50,
 		Outputs::Display::InputDataType::Red1Green1Blue1) {
 	memset(palette_, 0xf, sizeof(palette_));
+	ram_delays_ = ram_delays().other_modes;
 	setup_screen_map();
 	setup_base_address();
 
@@ -108,6 +134,10 @@ void VideoOutput::output_pixels(int number_of_cycles) {
 	if(is_blank_line_) {
 		crt_.output_blank(number_of_cycles * crt_cycles_multiplier);
 	} else {
+		if(palette_tables_need_update_) {
+			update_palette_tables();
+		}
+
 		int divider = 1;
 		switch(screen_mode_) {
 			case 0: case 3: divider = 1; break;
@@ -290,6 +320,7 @@ void VideoOutput::write(int address, uint8_t value) {
 			if(new_screen_mode == 7) new_screen_mode = 4;
 			if(new_screen_mode != screen_mode_) {
 				screen_mode_ = new_screen_mode;
+				ram_delays_ = screen_mode_ < 4 ? ram_delays().bitmapped_modes : ram_delays().other_modes;
 				setup_base_address();
 			}
 		}
@@ -322,38 +353,9 @@ void VideoOutput::write(int address, uint8_t value) {
 				palette_[registers[index][1]]	= (palette_[registers[index][1]]&5)	| ((colour >> 1)&2);
 			}
 
-			// regenerate all palette tables for now
-			for(int byte = 0; byte < 256; byte++) {
-				uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-				target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
-				target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
-				target[0] = palette_[(byte&0x80) >> 4];
-				target[1] = palette_[(byte&0x40) >> 3];
-				target[2] = palette_[(byte&0x20) >> 2];
-				target[3] = palette_[(byte&0x10) >> 1];
-				target[4] = palette_[(byte&0x08) >> 0];
-				target[5] = palette_[(byte&0x04) << 1];
-				target[6] = palette_[(byte&0x02) << 2];
-				target[7] = palette_[(byte&0x01) << 3];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
-
-				target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
-				target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
-				target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
-			}
+			// Regenerate the palette tables only when next they're needed, as several registers are
+			// usually written in succession.
+			palette_tables_need_update_ = true;
 		}
 		break;
 	}
@@ -398,44 +400,30 @@ Electron::Interrupt VideoOutput::get_interrupts() {
 
 // MARK: - RAM timing and access information
 
-unsigned int VideoOutput::get_cycles_until_next_ram_availability(int from_time) {
-	unsigned int result = 0;
-	int position = (output_position_ + from_time) % cycles_per_frame;
-
-	// Apply the standard cost of aligning to the available 1Mhz of RAM bandwidth.
-	result += 1 + (position&1);
-
-	// In Modes 0-3 there is also a complete block on any access while pixels are being fetched.
-	if(screen_mode_ < 4) {
-		const int current_column = graphics_column(position + (position&1));
-		int current_line = graphics_line(position);
-		if(current_column < 80 && current_line < 256) {
-			// Mode 3 is a further special case: in 'every ten line block', the final two aren't painted,
-			// so the CPU is allowed access. But the offset of the ten-line blocks depends on when the
-			// user switched into Mode 3, so that needs to be calculated relative to current output.
-			if(screen_mode_ == 3) {
-				// Get the line the display was on.
-				int output_position_line = graphics_line(output_position_);
-
-				int implied_row;
-				if(current_line >= output_position_line) {
-					// Get the number of lines since then if still in the same frame.
-					int lines_since_output_position = current_line - output_position_line;
-
-					// Therefore get the character row at the proposed time, modulo 10.
-					implied_row = (current_character_row_ + lines_since_output_position) % 10;
-				} else {
-					// If the frame has rolled over, the implied row is just related to the current line.
-					implied_row = current_line % 10;
-				}
-
-				// Mode 3 ends after 250 lines, not the usual 256.
-				if(implied_row < 8 && current_line < 250) result += unsigned(80 - current_column);
-			}
-			else result += unsigned(80 - current_column);
-		}
+unsigned int VideoOutput::mode3_ram_delay(int position, unsigned int delay) {
+	// In 'every ten line block', the final two aren't painted, so the CPU is allowed access.
+	// But the offset of the ten-line blocks depends on when the user switched into Mode 3,
+	// so that needs to be calculated relative to current output.
+	const int current_line = graphics_line(position);
+	const int output_position_line = graphics_line(output_position_);
+
+	int implied_row;
+	if(current_line >= output_position_line) {
+		// Get the number of lines since then if still in the same frame.
+		int lines_since_output_position = current_line - output_position_line;
+
+		// Therefore get the character row at the proposed time, modulo 10.
+		implied_row = (current_character_row_ + lines_since_output_position) % 10;
+	} else {
+		// If the frame has rolled over, the implied row is just related to the current line.
+		implied_row = current_line % 10;
 	}
-	return result;
+
+	// Mode 3 ends after 250 lines, not the usual 256.
+	if(implied_row < 8 && current_line < 250) {
+		return delay;
+	}
+	return unsigned(1 + (position&1));
 }
 
 VideoOutput::Range VideoOutput::get_memory_access_range() {
@@ -500,3 +488,38 @@ void VideoOutput::emplace_pixel_line() {
 	screen_map_.emplace_back(DrawAction::Pixels, 80);
 	screen_map_.emplace_back(DrawAction::Blank, 48 - first_graphics_cycle);
 }
+
+void VideoOutput::update_palette_tables() {
+	for(int byte = 0; byte < 256; byte++) {
+		uint8_t *target = reinterpret_cast<uint8_t *>(&palette_tables_.forty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+		target[2] = palette_[((byte&0x20) >> 2) | ((byte&0x02) >> 0)];
+		target[3] = palette_[((byte&0x10) >> 1) | ((byte&0x01) << 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty1bpp[byte]);
+		target[0] = palette_[(byte&0x80) >> 4];
+		target[1] = palette_[(byte&0x40) >> 3];
+		target[2] = palette_[(byte&0x20) >> 2];
+		target[3] = palette_[(byte&0x10) >> 1];
+		target[4] = palette_[(byte&0x08) >> 0];
+		target[5] = palette_[(byte&0x04) << 1];
+		target[6] = palette_[(byte&0x02) << 2];
+		target[7] = palette_[(byte&0x01) << 3];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.forty2bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x08) >> 2)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x04) >> 1)];
+
+		target = reinterpret_cast<uint8_t *>(&palette_tables_.eighty4bpp[byte]);
+		target[0] = palette_[((byte&0x80) >> 4) | ((byte&0x20) >> 3) | ((byte&0x08) >> 2) | ((byte&0x02) >> 1)];
+		target[1] = palette_[((byte&0x40) >> 3) | ((byte&0x10) >> 2) | ((byte&0x04) >> 1) | ((byte&0x01) >> 0)];
+	}
+	palette_tables_need_update_ = false;
+}
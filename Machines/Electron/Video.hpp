@@ -68,11 +68,22 @@ class VideoOutput {
 		*/
 		Electron::Interrupt get_interrupts();
 
+		static constexpr int CyclesPerFrame = 625 * 128;
+
 		/*!
 			@returns the number of cycles after (final cycle of last run_for batch + @c from_time)
 			before the video circuits will allow the CPU to access RAM.
 		*/
-		unsigned int get_cycles_until_next_ram_availability(int from_time);
+		unsigned int get_cycles_until_next_ram_availability(int from_time) {
+			const int position = (output_position_ + from_time) % CyclesPerFrame;
+			const unsigned int delay = ram_delays_[position];
+
+			// Only Mode 3 needs further thought, and then only while pixels are being fetched.
+			if(screen_mode_ != 3 || delay == unsigned(1 + (position&1))) {
+				return delay;
+			}
+			return mode3_ram_delay(position, delay);
+		}
 
 		struct Range {
 			uint16_t low_address, high_address;
@@ -87,11 +98,14 @@ class VideoOutput {
 		inline void end_pixel_line();
 		inline void output_pixels(int number_of_cycles);
 		inline void setup_base_address();
+		void update_palette_tables();
+		unsigned int mode3_ram_delay(int position, unsigned int delay);
 
 		int output_position_ = 0;
 
 		uint8_t palette_[16];
 		uint8_t screen_mode_ = 6;
+		const uint8_t *ram_delays_ = nullptr;	// Per position in the frame; selected by screen mode.
 		uint16_t screen_mode_base_address_ = 0;
 		uint16_t start_screen_address_ = 0;
 
@@ -103,6 +117,7 @@ class VideoOutput {
 			uint32_t eighty2bpp[256];
 			uint16_t eighty4bpp[256];
 		} palette_tables_;
+		bool palette_tables_need_update_ = true;
 
 		// Display generation.
 		uint16_t start_line_address_ = 0;
@@ -8,6 +8,9 @@
 
 #include "Dave.hpp"
 
+#include <algorithm>
+#include <limits>
+
 using namespace Enterprise::Dave;
 
 // MARK: - Audio generator
@@ -68,6 +71,56 @@ void Audio::set_sample_volume_range(int16_t range) {
 	});
 }
 
+int Audio::quiet_steps() const {
+	// Steps are quiet only if nothing is mid-transition and no ring modulation is in effect;
+	// ring-modulated outputs may alternate even while their inputs are static.
+	const auto is_settled = [](int output) {
+		return (output & 3) == 0 || (output & 3) == 3;
+	};
+	if(!is_settled(noise_.output) || noise_.ring_modulate || noise_.final_output != (noise_.output & 1)) {
+		return 0;
+	}
+
+	int steps = std::numeric_limits<int>::max();
+	for(const auto &channel: channels_) {
+		if(!is_settled(channel.output) || channel.ring_modulate) {
+			return 0;
+		}
+		if(channel.sync) {
+			// Sync holds output low.
+			if(channel.output & 1) return 0;
+		} else {
+			steps = std::min(steps, int(channel.count));
+		}
+	}
+
+	// Noise otherwise ticks only upon tone channel transitions.
+	if(noise_.frequency == Noise::Frequency::DivideByFour) {
+		steps = std::min(steps, noise_.count);
+	}
+	return steps;
+}
+
+void Audio::skip_steps(int steps) {
+	// Outputs are settled, so their recent histories are unaffected.
+	for(auto &channel: channels_) {
+		if(!channel.sync) {
+			channel.count = uint16_t(channel.count - steps);
+		}
+	}
+	if(noise_.frequency == Noise::Frequency::DivideByFour) {
+		noise_.count -= steps;
+	}
+
+	// The free-running polynomials advance regardless; their current states are
+	// recorded once below by the step that ends this period.
+	while(steps--) {
+		poly4_.next();
+		poly5_.next();
+		poly7_.next();
+	}
+}
+
 void Audio::update_channel(int c) {
 	auto output = channels_[c].output & 1;
 	channels_[c].output <<= 1;
@@ -137,10 +190,26 @@ void Audio::get_samples(std::size_t number_of_samples, int16_t *target) {
 			++c;
 		}
 
+		// If the buffer ended part-way through a step, resume the same step next time.
+		if(global_divider_) {
+			break;
+		}
+
 		global_divider_ = global_divider_reload_;
 		if(!global_divider_) {
 			global_divider_ = global_divider_reload_;
 		}
+
+		// If output can't change for a while, fill directly to the next step at which it might.
+		if(global_divider_) {
+			const int steps = std::min(quiet_steps(), int((number_of_samples - c) / global_divider_));
+			if(steps) {
+				skip_steps(steps);
+				std::fill_n(&target_frames[c], steps * global_divider_, output_level);
+				c += size_t(steps * global_divider_);
+			}
+		}
+
 		poly_state_[int(Channel::Distortion::FourBit)] = poly4_.next();
 		poly_state_[int(Channel::Distortion::FiveBit)] = poly5_.next();
 		poly_state_[int(Channel::Distortion::SevenBit)] = poly7_.next();
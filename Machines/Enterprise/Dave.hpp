@@ -46,7 +46,7 @@ class Audio: public Outputs::Speaker::SampleSource {
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
 
 		// Global divider (i.e. 8MHz/12Mhz switch).
-		uint8_t global_divider_;
+		uint8_t global_divider_ = 0;
 		uint8_t global_divider_reload_ = 2;
 
 		// Tone channels.
@@ -98,6 +98,12 @@ class Audio: public Outputs::Speaker::SampleSource {
 		} noise_;
 		void update_noise();
 
+		/// @returns The number of upcoming steps that are certain to leave all outputs unchanged.
+		int quiet_steps() const;
+
+		/// Applies @c steps steps, all of which must be quiet.
+		void skip_steps(int steps);
+
 		bool use_direct_output_[2]{};
 
 		// Global volume, per SampleSource obligations.
@@ -115,7 +121,7 @@ class Audio: public Outputs::Speaker::SampleSource {
 		Numeric::LFSRv<0x12000> poly17_;
 
 		// Current state of the active polynomials.
-		uint8_t poly_state_[4];
+		uint8_t poly_state_[4]{};
 };
 
 /*!
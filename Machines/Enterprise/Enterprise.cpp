@@ -212,6 +212,9 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 			// Seed key state.
 			clear_all_keys();
 
+			// Unpopulated areas read as 0xff.
+			unpopulated_.fill(0xff);
+
 			// Take a reasonable guess at the initial memory configuration:
 			// put EXOS into the first bank since this is a Z80 and therefore
 			// starts from address 0; the third instruction in EXOS is a jump
@@ -277,9 +280,7 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 				// For non-video pauses, insert during the initial part of the bus cycle.
 				case PartialMachineCycle::ReadStart:
 				case PartialMachineCycle::WriteStart:
-					if(!is_video_[address >> 14] && wait_mode_ == WaitMode::OnAllAccesses) {
-						penalty = dave_delay_;
-					}
+					penalty = access_delay_[address >> 14];
 				break;
 				case PartialMachineCycle::ReadOpcodeStart: {
 					if(is_video_[address >> 14]) {
@@ -288,8 +289,8 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 						const auto delay_time = nick_.time_since_flush(HalfCycles(2));
 						const auto delay = nick_.last_valid()->get_time_until_z80_slot(delay_time);
 						penalty = nick_.back_map(delay, delay_time);
-					} else if(wait_mode_ != WaitMode::None) {
-						penalty = dave_delay_;
+					} else {
+						penalty = opcode_delay_[address >> 14];
 					}
 				} break;
 
@@ -449,6 +450,7 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 							// Dave delays (i.e. those affecting memory areas not associated with Nick)
 							// are one cycle in 8Mhz mode, two cycles in 12Mhz mode.
 							dave_delay_ = HalfCycles(2 + ((*cycle.value)&2));
+							update_delays();
 
 							[[fallthrough]];
 
@@ -522,17 +524,11 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 
 				case PartialMachineCycle::Read:
 				case PartialMachineCycle::ReadOpcode:
-					if(read_pointers_[address >> 14]) {
-						*cycle.value = read_pointers_[address >> 14][address];
-					} else {
-						*cycle.value = 0xff;
-					}
+					*cycle.value = read_pointers_[address >> 14][address];
 				break;
 
 				case PartialMachineCycle::Write:
-					if(write_pointers_[address >> 14]) {
-						write_pointers_[address >> 14][address] = *cycle.value;
-					}
+					write_pointers_[address >> 14][address] = *cycle.value;
 				break;
 			}
 
@@ -558,17 +554,22 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 		std::array<uint8_t, 32 * 1024> epdos_rom_;
 		const uint8_t min_ram_slot_;
 
+		// Every slot always has a read and a write pointer, so that accesses need not be
+		// tested; unpopulated areas read from a page of 0xffs, and writes to anything
+		// other than RAM go to a page that is never read.
 		const uint8_t *read_pointers_[4] = {nullptr, nullptr, nullptr, nullptr};
 		uint8_t *write_pointers_[4] = {nullptr, nullptr, nullptr, nullptr};
 		uint8_t pages_[4] = {0x80, 0x80, 0x80, 0x80};
+		std::array<uint8_t, 16 * 1024> unpopulated_;
+		std::array<uint8_t, 16 * 1024> discarded_writes_;
 
 		template <size_t slot> void page(uint8_t offset) {
 			pages_[slot] = offset;
 
 #define Map(location, source)												\
 	if(offset >= location && offset < location + source.size() / 0x4000) {	\
-		page<slot>(&source[(offset - location) * 0x4000], nullptr);			\
 		is_video_[slot] = false;											\
+		page<slot>(&source[(offset - location) * 0x4000], nullptr);			\
 		return;																\
 	}
 
@@ -591,12 +592,14 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 				return;
 			}
 
-			page<slot>(nullptr, nullptr);
+			is_video_[slot] = false;
+			page<slot>(unpopulated_.data(), nullptr);
 		}
 
 		template <size_t slot> void page(const uint8_t *read, uint8_t *write) {
-			read_pointers_[slot] = read ? read - (slot * 0x4000) : nullptr;
-			write_pointers_[slot] = write ? write - (slot * 0x4000) : nullptr;
+			read_pointers_[slot] = read - (slot * 0x4000);
+			write_pointers_[slot] = (write ? write : discarded_writes_.data()) - (slot * 0x4000);
+			update_delays();
 		}
 
 		// MARK: - Memory Timing
@@ -609,6 +612,16 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 		} wait_mode_ = WaitMode::OnAllAccesses;
 		bool is_video_[4]{};
 
+		// Dave's delays for each slot, for opcode fetches and for other accesses respectively;
+		// these are zero for the video area, which is instead timed by Nick.
+		HalfCycles opcode_delay_[4], access_delay_[4];
+		void update_delays() {
+			for(size_t slot = 0; slot < 4; slot++) {
+				opcode_delay_[slot] = (!is_video_[slot] && wait_mode_ != WaitMode::None) ? dave_delay_ : HalfCycles(0);
+				access_delay_[slot] = (!is_video_[slot] && wait_mode_ == WaitMode::OnAllAccesses) ? dave_delay_ : HalfCycles(0);
+			}
+		}
+
 		// MARK: - ScanProducer
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) override {
 			nick_.last_valid()->set_scan_target(scan_target);
@@ -705,7 +718,7 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 		bool previous_nick_interrupt_line_ = false;
 		// Cf. timing guesses above.
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		Dave::Audio dave_audio_;
 		Outputs::Speaker::PullLowpass<Dave::Audio> speaker_;
 		HalfCycles time_since_audio_update_;
@@ -734,12 +747,14 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
+			options->fast_mechanics = has_disk_controller && exdos_.get_is_fast_mechanics_enabled();
 			return options;
 		}
 
 		void set_options(const std::unique_ptr<Reflection::Struct> &str) final {
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
+			if constexpr (has_disk_controller) exdos_.set_is_fast_mechanics_enabled(options->fast_mechanics);
 		}
 };
 
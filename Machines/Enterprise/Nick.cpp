@@ -8,7 +8,15 @@
 
 #include "Nick.hpp"
 
+#include <array>
 #include <cstdio>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace  {
 
@@ -42,6 +50,93 @@ uint16_t mapped_colour(uint8_t source) {
 	return *reinterpret_cast<const uint16_t *>(parts);
 }
 
+const std::array<uint16_t, 256> mapped_colours = [] {
+	std::array<uint16_t, 256> colours{};
+	for(int c = 0; c < 256; c++) {
+		colours[size_t(c)] = mapped_colour(uint8_t(c));
+	}
+	return colours;
+}();
+
+/// @returns The palette index of pixel @c pixel within the byte @c x at the bit depth @c bpp,
+/// ignoring any use of alternative palettes.
+template <int bpp> constexpr uint8_t pixel_index(int x, int pixel) {
+	switch(bpp) {
+		default:
+		case 1:
+			return uint8_t((x >> (7 - pixel)) & 1);
+
+		case 2:
+			x <<= pixel;
+			return uint8_t(((x & 0x80) >> 7) | ((x & 0x08) >> 2));
+
+		case 4:
+			x <<= pixel;
+			return uint8_t(((x & 0x02) << 2) | ((x & 0x20) >> 3) | ((x & 0x08) >> 2) | ((x & 0x80) >> 7));
+	}
+}
+
+/// Provides, for every possible byte, the palette indices of the pixels that it describes at depth @c bpp.
+template <int bpp> constexpr std::array<std::array<uint8_t, 8 / bpp>, 256> make_index_table() {
+	std::array<std::array<uint8_t, 8 / bpp>, 256> table{};
+	for(int x = 0; x < 256; x++) {
+		for(int pixel = 0; pixel < 8 / bpp; pixel++) {
+			table[size_t(x)][size_t(pixel)] = pixel_index<bpp>(x, pixel);
+		}
+	}
+	return table;
+}
+
+constexpr auto indices1bpp = make_index_table<1>();
+constexpr auto indices2bpp = make_index_table<2>();
+constexpr auto indices4bpp = make_index_table<4>();
+
+/// Writes the colours in @c palette that correspond to each of the @c count palette indices at @c indices to @c target.
+void map_indices(uint16_t *target, const uint8_t *indices, int count, const uint16_t *palette) {
+	const uint8_t *const end = indices + count;
+
+	// Split the palette into separate tables of low and high bytes, look up both for
+	// sixteen indices at a time, and interleave the results.
+#if defined(__SSSE3__)
+	const __m128i entries[2] = {
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(&palette[0])),
+		_mm_loadu_si128(reinterpret_cast<const __m128i *>(&palette[8])),
+	};
+	const __m128i byte_mask = _mm_set1_epi16(0xff);
+	const __m128i low_bytes = _mm_packus_epi16(_mm_and_si128(entries[0], byte_mask), _mm_and_si128(entries[1], byte_mask));
+	const __m128i high_bytes = _mm_packus_epi16(_mm_srli_epi16(entries[0], 8), _mm_srli_epi16(entries[1], 8));
+
+	while(end - indices >= 16) {
+		const __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i *>(indices));
+		const __m128i low = _mm_shuffle_epi8(low_bytes, source);
+		const __m128i high = _mm_shuffle_epi8(high_bytes, source);
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target), _mm_unpacklo_epi8(low, high));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target + 8), _mm_unpackhi_epi8(low, high));
+		target += 16;
+		indices += 16;
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	const uint8x16x2_t bytes = vld2q_u8(reinterpret_cast<const uint8_t *>(palette));
+
+	while(end - indices >= 16) {
+		const uint8x16_t source = vld1q_u8(indices);
+		const uint8x16x2_t pixels = {{
+			vqtbl1q_u8(bytes.val[0], source),
+			vqtbl1q_u8(bytes.val[1], source),
+		}};
+		vst2q_u8(reinterpret_cast<uint8_t *>(target), pixels);
+		target += 16;
+		indices += 16;
+	}
+#endif
+
+	while(indices != end) {
+		*target = palette[*indices];
+		++target;
+		++indices;
+	}
+}
+
 }
 
 using namespace Enterprise;
@@ -502,56 +597,55 @@ Outputs::Display::DisplayType Nick::get_display_type() const {
 
 // MARK: - Specific pixel outputters.
 
-#define output1bpp(x)	\
-	target[0] = palette[(x & 0x80) >> 7];	\
-	target[1] = palette[(x & 0x40) >> 6];	\
-	target[2] = palette[(x & 0x20) >> 5];	\
-	target[3] = palette[(x & 0x10) >> 4];	\
-	target[4] = palette[(x & 0x08) >> 3];	\
-	target[5] = palette[(x & 0x04) >> 2];	\
-	target[6] = palette[(x & 0x02) >> 1];	\
-	target[7] = palette[(x & 0x01) >> 0];	\
-	target += 8
+// Each of the following appends the palette indices of the pixels in x to those at index.
+// The 1bpp outputter also applies a palette offset, allowing for ALTIND and MSBALT/LSBALT.
+
+#define output1bpp(x, offset)	{	\
+	uint64_t row;	\
+	memcpy(&row, indices1bpp[x].data(), sizeof(row));	\
+	row |= uint64_t(offset) * 0x0101'0101'0101'0101;	\
+	memcpy(index, &row, sizeof(row));	\
+	index += 8;	\
+}
 
 #define output2bpp(x)	\
-	target[0] = palette_[((x & 0x80) >> 7) | ((x & 0x08) >> 2)];	\
-	target[1] = palette_[((x & 0x40) >> 6) | ((x & 0x04) >> 1)];	\
-	target[2] = palette_[((x & 0x20) >> 5) | ((x & 0x02) >> 0)];	\
-	target[3] = palette_[((x & 0x10) >> 4) | ((x & 0x01) << 1)];	\
-	target += 4
+	memcpy(index, indices2bpp[x].data(), 4);	\
+	index += 4
 
 #define output4bpp(x)	\
-	target[0] = palette_[((x & 0x02) << 2) | ((x & 0x20) >> 3) | ((x & 0x08) >> 2) | ((x & 0x80) >> 7)];	\
-	target[1] = palette_[((x & 0x01) << 3) | ((x & 0x10) >> 2) | ((x & 0x04) >> 1) | ((x & 0x40) >> 6)];	\
-	target += 2
+	memcpy(index, indices4bpp[x].data(), 2);	\
+	index += 2
 
 #define output8bpp(x)	\
-	target[0] = mapped_colour(x);	\
+	target[0] = mapped_colours[x];	\
 	++target
 
 template <int bpp, bool is_lpixel> void Nick::output_pixel(uint16_t *target, int columns) const {
 	static_assert(bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8);
 
-	int index = 0;
+	uint8_t indices[allocation_size];
+	uint8_t *index = indices;
+
+	int address = 0;
 	for(int c = 0; c < columns; c++) {
 		uint8_t pixels[2] = {
-			ram_[(line_data_pointer_[0] + index) & 0xffff],
-			ram_[(line_data_pointer_[0] + index + 1) & 0xffff]
+			ram_[(line_data_pointer_[0] + address) & 0xffff],
+			ram_[(line_data_pointer_[0] + address + 1) & 0xffff]
 		};
-		index += is_lpixel ? 1 : 2;
+		address += is_lpixel ? 1 : 2;
 		last_read_ = pixels[1];
 
 		switch(bpp) {
 			default:
 			case 1: {
-				const uint16_t *palette = alt_ind_palettes[((pixels[0] >> 6) & 0x02) | (pixels[0]&1)];
+				auto offset = alt_ind_palettes[((pixels[0] >> 6) & 0x02) | (pixels[0]&1)] - palette_;
 				pixels[0] &= two_colour_mask_;
-				output1bpp(pixels[0]);
+				output1bpp(pixels[0], offset);
 
 				if constexpr (!is_lpixel) {
-					palette = alt_ind_palettes[((pixels[1] >> 6) & 0x02) | (pixels[1]&1)];
+					offset = alt_ind_palettes[((pixels[1] >> 6) & 0x02) | (pixels[1]&1)] - palette_;
 					pixels[1] &= two_colour_mask_;
-					output1bpp(pixels[1]);
+					output1bpp(pixels[1], offset);
 				}
 			} break;
 
@@ -577,11 +671,19 @@ template <int bpp, bool is_lpixel> void Nick::output_pixel(uint16_t *target, int
 			break;
 		}
 	}
+
+	// 8bpp output is written directly to target, leaving no indices to map.
+	if constexpr (bpp != 8) {
+		map_indices(target, indices, int(index - indices), palette_);
+	}
 }
 
 template <int bpp, int index_bits> void Nick::output_character(uint16_t *target, int columns) const {
 	static_assert(bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8);
 
+	uint8_t indices[allocation_size];
+	uint8_t *index = indices;
+
 	for(int c = 0; c < columns; c++) {
 		const uint8_t character = ram_[(line_data_pointer_[0] + c) & 0xffff];
 		const uint8_t pixels = ram_[(
@@ -595,32 +697,47 @@ template <int bpp, int index_bits> void Nick::output_character(uint16_t *target,
 				assert(false);
 			break;
 
-			case 1: {
+			case 1:
 				// This applies ALTIND0 and ALTIND1.
-				const uint16_t *palette = alt_ind_palettes[character >> 6];
-				output1bpp(pixels);
-			} break;
+				output1bpp(pixels, alt_ind_palettes[character >> 6] - palette_);
+			break;
 
 			case 2:		output2bpp(pixels);		break;
 			case 4:		output4bpp(pixels);		break;
 			case 8:		output8bpp(pixels);		break;
 		}
 	}
+
+	if constexpr (bpp != 8) {
+		map_indices(target, indices, int(index - indices), palette_);
+	}
 }
 
 template <int bpp> void Nick::output_attributed(uint16_t *target, int columns) const {
 	static_assert(bpp == 1 || bpp == 2 || bpp == 4 || bpp == 8);
 
+	uint8_t indices[allocation_size];
+	uint8_t *index = indices;
+
 	for(int c = 0; c < columns; c++) {
 		const uint8_t pixels = ram_[(line_data_pointer_[1] + c) & 0xffff];
 		const uint8_t attributes = ram_[(line_data_pointer_[0] + c) & 0xffff];
 		last_read_ = pixels;
 
-		const uint16_t palette[2] = {
-			palette_[attributes >> 4], palette_[attributes & 0x0f]
-		};
-		output1bpp(pixels);
+		// Select between the two colours given by the attributes eight pixels at a time,
+		// with each pixel's index occupying a byte.
+		uint64_t mask;
+		memcpy(&mask, indices1bpp[pixels].data(), sizeof(mask));
+		mask *= 0xff;
+
+		const uint64_t selection =
+			(~mask & (uint64_t(attributes >> 4) * 0x0101'0101'0101'0101)) |
+			(mask & (uint64_t(attributes & 0x0f) * 0x0101'0101'0101'0101));
+		memcpy(index, &selection, sizeof(selection));
+		index += 8;
 	}
+
+	map_indices(target, indices, int(index - indices), palette_);
 }
 
 #undef output1bpp
@@ -51,7 +51,9 @@ class KonamiWithSCCROMSlotHandler: public MemorySlotHandler {
 				break;
 				case 0x13:
 					if(scc_is_visible_) {
-						if(pc_is_outside_bios) confidence_counter_.add_hit();
+						// Only an SCC-specific paging write can have made the SCC visible, so a subsequent write
+						// to its registers settles the question.
+						if(pc_is_outside_bios) confidence_counter_.add_definitive(true);
 						scc_.write(address, value);
 					} else {
 						if(pc_is_outside_bios) confidence_counter_.add_miss();
@@ -154,6 +154,7 @@ class ConcreteMachine:
 	public:
 		ConcreteMachine(const Target &target, const ROMMachine::ROMFetcher &rom_fetcher):
 			z80_(*this),
+			vdp_(HalfCycles(4096)),
 			i8255_(i8255_port_handler_),
 			ay_(GI::AY38910::Personality::AY38910, audio_queue_),
 			audio_toggle_(audio_queue_),
@@ -354,7 +355,7 @@ class ConcreteMachine:
 				const auto &segment = media.cartridges.front()->get_segments().front();
 				auto &slot = cartridge_slot();
 
-				slot.set_source(segment.data);
+				slot.set_source(ROM::share(segment.data));
 				slot.map(0, uint16_t(segment.start_address), std::min(segment.data.size(), 65536 - segment.start_address));
 
 				auto msx_cartridge = dynamic_cast<Analyser::Static::MSX::Cartridge *>(media.cartridges.front().get());
@@ -375,6 +376,9 @@ class ConcreteMachine:
 						break;
 					}
 				}
+
+				// Pick up the new mapping and handler if the cartridge slot is currently visible.
+				update_paging();
 			}
 
 			if(!media.tapes.empty()) {
@@ -430,13 +434,15 @@ class ConcreteMachine:
 			final_slot_ = &memory_slots_[primary >> 6];
 
 			for(int c = 0; c < 8; c += 2) {
-				const HandledSlot &slot = memory_slots_[primary & 3];
+				HandledSlot &slot = memory_slots_[primary & 3];
 				primary >>= 2;
 
 				read_pointers_[c] = slot.read_pointer(c);
 				write_pointers_[c] = slot.write_pointer(c);
 				read_pointers_[c+1] = slot.read_pointer(c+1);
 				write_pointers_[c+1] = slot.write_pointer(c+1);
+
+				handled_slots_[c] = handled_slots_[c+1] = slot.handler ? &slot : nullptr;
 			}
 			set_use_fast_tape();
 		}
@@ -540,9 +546,9 @@ class ConcreteMachine:
 						if(read_pointers_[address >> 13]) {
 							*cycle.value = read_pointers_[address >> 13][address & 8191];
 						} else {
-							const int slot_hit = (primary_slots_ >> ((address >> 14) * 2)) & 3;
-							memory_slots_[slot_hit].handler->run_for(memory_slots_[slot_hit].cycles_since_update.template flush<HalfCycles>());
-							*cycle.value = memory_slots_[slot_hit].handler->read(address);
+							HandledSlot &slot = *handled_slots_[address >> 13];
+							slot.handler->run_for(slot.cycles_since_update.template flush<HalfCycles>());
+							*cycle.value = slot.handler->read(address);
 						}
 					break;
 
@@ -553,11 +559,10 @@ class ConcreteMachine:
 							break;
 						}
 
-						const int slot_hit = (primary_slots_ >> ((address >> 14) * 2)) & 3;
-						if(memory_slots_[slot_hit].handler) {
+						if(HandledSlot *const slot = handled_slots_[address >> 13]) {
 							update_audio();
-							memory_slots_[slot_hit].handler->run_for(memory_slots_[slot_hit].cycles_since_update.template flush<HalfCycles>());
-							memory_slots_[slot_hit].handler->write(
+							slot->handler->run_for(slot->cycles_since_update.template flush<HalfCycles>());
+							slot->handler->write(
 								address,
 								*cycle.value,
 								read_pointers_[pc_address_ >> 13] != memory_slots_[0].read_pointer(pc_address_ >> 13));
@@ -600,7 +605,13 @@ class ConcreteMachine:
 					case CPU::Z80::PartialMachineCycle::Output: {
 						const int port = address & 0xff;
 						switch(port) {
-							case 0x98:	case 0x99:
+							case 0x98:
+								vdp_.post([address, value = *cycle.value] (auto &vdp) {
+									vdp.write(address, value);
+								});
+							break;
+
+							case 0x99:
 								vdp_->write(address, *cycle.value);
 								z80_.set_interrupt_line(vdp_->get_interrupt_line());
 							break;
@@ -737,6 +748,9 @@ class ConcreteMachine:
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = allow_fast_tape_;
+
+			const DiskROM *const handler = disk_handler();
+			options->fast_mechanics = handler && handler->get_is_fast_mechanics_enabled();
 			return options;
 		}
 
@@ -745,11 +759,17 @@ class ConcreteMachine:
 			set_video_signal_configurable(options->output);
 			allow_fast_tape_ = options->quickload;
 			set_use_fast_tape();
+
+			DiskROM *const handler = disk_handler();
+			if(handler) {
+				handler->set_is_fast_mechanics_enabled(options->fast_mechanics);
+			}
 		}
 
 		// MARK: - Sleeper
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) final {
 			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
+			set_is_loading(!tape_player_is_sleeping_);
 			set_use_fast_tape();
 		}
 
@@ -833,10 +853,10 @@ class ConcreteMachine:
 		}
 
 		CPU::Z80::Processor<ConcreteMachine, false, false> z80_;
-		JustInTimeActor<TI::TMS::TMS9918<vdp_model()>> vdp_;
+		AsyncJustInTimeActor<TI::TMS::TMS9918<vdp_model()>> vdp_;
 		Intel::i8255::i8255<i8255PortHandler> i8255_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		GI::AY38910::AY38910<false> ay_;
 		Audio::Toggle audio_toggle_;
 		Konami::SCC scc_;
@@ -886,6 +906,11 @@ class ConcreteMachine:
 		HandledSlot memory_slots_[4];
 		HandledSlot *final_slot_ = nullptr;
 
+		// For each 8kb chunk of the current address space, the primary slot that is paged in
+		// if it has a handler; nullptr otherwise. Reads of unmapped chunks and all writes to these
+		// chunks are routed to the handler; everything else is via read_pointers_ and write_pointers_.
+		HandledSlot *handled_slots_[8]{};
+
 		HalfCycles time_since_ay_update_;
 
 		uint8_t key_states_[16];
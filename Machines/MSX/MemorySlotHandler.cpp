@@ -47,6 +47,12 @@ uint8_t *MemorySlot::write_pointer(int segment) const {
 
 void MemorySlot::set_source(const std::vector<uint8_t> &source) {
 	source_ = source;
+	shared_source_.reset();
+}
+
+void MemorySlot::set_source(const ROM::SharedImage &source) {
+	source_.clear();
+	shared_source_ = source;
 }
 
 void MemorySlot::resize_source(std::size_t size) {
@@ -67,13 +73,18 @@ void MemorySlot::map(std::size_t source_address, uint16_t destination_address, s
 	assert(!(length & 8191));
 	assert(size_t(destination_address) + length <= 65536);
 
+	if constexpr (type == AccessType::ReadWrite) {
+		assert(!shared_source_);
+	}
+
+	const std::vector<uint8_t> &source = shared_source_ ? *shared_source_ : source_;
 	for(std::size_t c = 0; c < (length >> 13); ++c) {
-		source_address %= source_.size();
+		source_address %= source.size();
 
 		const int bank = int((destination_address >> 13) + c);
-		read_pointers_[bank] = &source_[source_address];
+		read_pointers_[bank] = &source[source_address];
 		if constexpr (type == AccessType::ReadWrite) {
-			write_pointers_[bank] = read_pointers_[bank];
+			write_pointers_[bank] = &source_[source_address];
 		}
 
 		source_address += 8192;
@@ -11,6 +11,7 @@
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../Analyser/Dynamic/ConfidenceCounter.hpp"
+#include "../Utility/SharedROM.hpp"
 
 #include <array>
 #include <cstddef>
@@ -48,6 +49,10 @@ class MemorySlot {
 		/// Copies an underlying source buffer.
 		void set_source(const std::vector<uint8_t> &source);
 
+		/// Uses @c source, which is immutable and may be shared with other machines, as the underlying
+		/// source buffer; it may be mapped only for reading.
+		void set_source(const ROM::SharedImage &source);
+
 		/// Sets the size of the underlying source buffer.
 		void resize_source(std::size_t);
 
@@ -82,7 +87,8 @@ class MemorySlot {
 
 	private:
 		std::vector<uint8_t> source_;
-		uint8_t *read_pointers_[8];
+		ROM::SharedImage shared_source_;
+		const uint8_t *read_pointers_[8];
 		uint8_t *write_pointers_[8];
 
 		MemorySlotChangeHandler &handler_;
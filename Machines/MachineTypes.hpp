@@ -15,10 +15,12 @@
 // so including all shouldn't be a huge burden.
 
 #include "AudioProducer.hpp"
+#include "BusTraceable.hpp"
 #include "JoystickMachine.hpp"
 #include "KeyboardMachine.hpp"
 #include "MediaTarget.hpp"
 #include "MouseMachine.hpp"
+#include "Profiled.hpp"
 #include "ScanProducer.hpp"
 #include "StateProducer.hpp"
 #include "TimedMachine.hpp"
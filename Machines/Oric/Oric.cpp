@@ -667,6 +667,12 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
 			options->output = get_video_signal_configurable();
 			options->quickload = use_fast_tape_hack_;
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		options->fast_mechanics = bd500_.get_is_fast_mechanics_enabled();		break;
+				case DiskInterface::Jasmin:		options->fast_mechanics = jasmin_.get_is_fast_mechanics_enabled();		break;
+				case DiskInterface::Microdisc:	options->fast_mechanics = microdisc_.get_is_fast_mechanics_enabled();	break;
+			}
 			return options;
 		}
 
@@ -674,6 +680,12 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			const auto options = dynamic_cast<Options *>(str.get());
 			set_video_signal_configurable(options->output);
 			set_use_fast_tape_hack(options->quickload);
+			switch(disk_interface) {
+				default: break;
+				case DiskInterface::BD500:		bd500_.set_is_fast_mechanics_enabled(options->fast_mechanics);		break;
+				case DiskInterface::Jasmin:		jasmin_.set_is_fast_mechanics_enabled(options->fast_mechanics);		break;
+				case DiskInterface::Microdisc:	microdisc_.set_is_fast_mechanics_enabled(options->fast_mechanics);	break;
+			}
 		}
 
 		void set_activity_observer(Activity::Observer *observer) final {
@@ -711,7 +723,7 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 		// Outputs
 		JustInTimeActor<VideoOutput, Cycles> video_;
 
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		GI::AY38910::AY38910<false> ay8910_;
 		Speaker speaker_;
 
@@ -28,16 +28,19 @@ class Machine {
 		/// Creates and returns an Oric.
 		static Machine *Oric(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher);
 
-		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options>, public Configurable::QuickloadOption<Options> {
+		class Options: public Reflection::StructImpl<Options>, public Configurable::DisplayOption<Options>, public Configurable::QuickloadOption<Options>, public Configurable::FastMechanicsOption<Options> {
 			friend Configurable::DisplayOption<Options>;
 			friend Configurable::QuickloadOption<Options>;
+			friend Configurable::FastMechanicsOption<Options>;
 			public:
 				Options(Configurable::OptionsType type) :
 					Configurable::DisplayOption<Options>(type == Configurable::OptionsType::UserFriendly ? Configurable::Display::RGB : Configurable::Display::CompositeColour),
-					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly) {
+					Configurable::QuickloadOption<Options>(type == Configurable::OptionsType::UserFriendly),
+					Configurable::FastMechanicsOption<Options>(false) {
 					if(needs_declare()) {
 						declare_display_option();
 						declare_quickload_option();
+						declare_fast_mechanics_option();
 					}
 				}
 		};
@@ -9,6 +9,8 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 
 //#define SUPPLY_COMPOSITE
 
@@ -21,6 +23,19 @@ namespace {
 	const unsigned int PAL60VSyncEndPosition = 238*64;
 	const unsigned int PAL50Period = 312*64;
 	const unsigned int PAL60Period = 262*64;
+
+	/// Maps each six-bit pattern to a mask in which byte n, in memory order, is 0xff if pixel n is set and 0x00 otherwise.
+	const std::array<uint64_t, 64> pixel_masks = [] {
+		std::array<uint64_t, 64> masks{};
+		for(int pattern = 0; pattern < 64; pattern++) {
+			uint8_t bytes[8]{};
+			for(int pixel = 0; pixel < 6; pixel++) {
+				bytes[pixel] = (pattern & (0x20 >> pixel)) ? 0xff : 0x00;
+			}
+			memcpy(&masks[size_t(pattern)], bytes, sizeof(bytes));
+		}
+		return masks;
+	}();
 }
 
 VideoOutput::VideoOutput(uint8_t *memory) :
@@ -173,16 +188,12 @@ void VideoOutput::run_for(const Cycles cycles) {
 
 				if(control_byte & 0x60) {
 					if(data_type_ == Outputs::Display::InputDataType::Red1Green1Blue1 && rgb_pixel_target_) {
-						const uint8_t colours[2] = {
-							uint8_t(paper_ ^ inverse_mask),
-							uint8_t(ink_ ^ inverse_mask)
-						};
-						rgb_pixel_target_[0] = colours[(pixels >> 5)&1];
-						rgb_pixel_target_[1] = colours[(pixels >> 4)&1];
-						rgb_pixel_target_[2] = colours[(pixels >> 3)&1];
-						rgb_pixel_target_[3] = colours[(pixels >> 2)&1];
-						rgb_pixel_target_[4] = colours[(pixels >> 1)&1];
-						rgb_pixel_target_[5] = colours[(pixels >> 0)&1];
+						// Select between paper and ink for all six pixels at once.
+						const uint64_t mask = pixel_masks[pixels & 0x3f];
+						const uint64_t row =
+							(~mask & (uint64_t(paper_ ^ inverse_mask) * 0x0101'0101'0101'0101)) |
+							(mask & (uint64_t(ink_ ^ inverse_mask) * 0x0101'0101'0101'0101));
+						memcpy(rgb_pixel_target_, &row, 6);
 					} else if(composite_pixel_target_) {
 						const uint32_t colours[2] = {
 							colour_forms_[paper_ ^ inverse_mask],
@@ -233,9 +244,7 @@ void VideoOutput::run_for(const Cycles cycles) {
 					}
 
 					if(data_type_ == Outputs::Display::InputDataType::Red1Green1Blue1 && rgb_pixel_target_) {
-						rgb_pixel_target_[0] = rgb_pixel_target_[1] =
-						rgb_pixel_target_[2] = rgb_pixel_target_[3] =
-						rgb_pixel_target_[4] = rgb_pixel_target_[5] = paper_ ^ inverse_mask;
+						memset(rgb_pixel_target_, paper_ ^ inverse_mask, 6);
 					} else if(composite_pixel_target_) {
 						composite_pixel_target_[0] = composite_pixel_target_[1] =
 						composite_pixel_target_[2] = composite_pixel_target_[3] =
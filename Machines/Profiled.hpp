@@ -0,0 +1,36 @@
+//
+//  Profiled.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Profiled_hpp
+#define Profiled_hpp
+
+#include "../ClockReceiver/Profiler.hpp"
+
+namespace MachineTypes {
+
+/*!
+	A Profiled machine can report how host time and emulated cycles have been divided between
+	its CPU, its just-in-time components, its audio sources and its CRT.
+
+	Reports are empty unless profiling was enabled at compile time; see Profiling::Enabled.
+*/
+struct Profiled {
+	/// @returns All time and cycles attributed since construction or the last call to @c reset_profile.
+	virtual Profiling::Report get_profile() const {
+		return Profiling::Registry::shared().report();
+	}
+
+	/// Zeroes all profiling totals.
+	virtual void reset_profile() {
+		Profiling::Registry::shared().reset();
+	}
+};
+
+}
+
+#endif /* Profiled_hpp */
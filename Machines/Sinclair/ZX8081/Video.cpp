@@ -9,6 +9,8 @@
 #include "Video.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 
 using namespace Sinclair::ZX8081;
 
@@ -20,6 +22,20 @@ namespace {
 */
 const std::size_t StandardAllocationSize = 320;
 
+/*!
+	Maps from a byte to its eight one-byte-per-pixel equivalents, most significant bit first, so that
+	each byte of display can be serialised with a single copy.
+*/
+constexpr auto pixels = [] {
+	std::array<std::array<uint8_t, 8>, 256> table{};
+	for(size_t byte = 0; byte < 256; byte++) {
+		for(size_t bit = 0; bit < 8; bit++) {
+			table[byte][bit] = (byte & (0x80 >> bit)) ? 0xff : 0x00;
+		}
+	}
+	return table;
+}();
+
 }
 
 Video::Video() :
@@ -97,11 +113,7 @@ void Video::output_byte(uint8_t byte) {
 		}
 
 		// Convert to one-byte-per-pixel where any non-zero value will act as white.
-		uint8_t mask = 0x80;
-		for(int c = 0; c < 8; c++) {
-			line_data_pointer_[c] = byte & mask;
-			mask >>= 1;
-		}
+		memcpy(line_data_pointer_, pixels[byte].data(), 8);
 		line_data_pointer_ += 8;
 	}
 }
@@ -15,6 +15,7 @@
 #include "../../../Reflection/Struct.hpp"
 
 #include <algorithm>
+#include <array>
 
 namespace Sinclair {
 namespace ZXSpectrum {
@@ -100,6 +101,23 @@ template <Timing timing> class Video {
 		// Interrupt should be held for 32 cycles.
 		static constexpr int interrupt_duration = 64;
 
+		// Provides the contention to apply, in half cycles, as a function of the number of whole cycles into the frame.
+		static constexpr auto get_contention_table() {
+			constexpr auto timings = get_timings();
+			constexpr int frame_length = timings.half_cycles_per_line * timings.lines_per_frame;
+
+			// Only the 192 lines of pixel fetching can be contended, so only those are populated.
+			std::array<uint8_t, size_t(frame_length >> 1)> table{};
+			for(int line = 0; line < 192; line++) {
+				for(int time_into_line = 0; time_into_line < timings.contention_duration; time_into_line += 2) {
+					const int delay_time = line * timings.half_cycles_per_line + time_into_line;
+					const int time_into_frame = (delay_time - timings.contention_leadin + frame_length) % frame_length;
+					table[size_t(time_into_frame >> 1)] = uint8_t(timings.delays[(time_into_line >> 1) & 7]);
+				}
+			}
+			return table;
+		}
+
 	public:
 		void run_for(HalfCycles duration) {
 			constexpr auto timings = get_timings();
@@ -206,17 +224,21 @@ template <Timing timing> class Video {
 						}
 					}
 
-					// Output the common tail to border and pixel lines: sync, blank, colour burst, border.
+					// Output the common tail to border and pixel lines: sync, blank, colour burst, border;
+					// these are posted to the CRT as a single batch.
+					using Segment = Outputs::CRT::CRT::Segment;
+					Segment segments[4];
+					size_t segment_count = 0;
 
 					if(offset >= sync_position && offset < sync_position + sync_length && end_offset > offset) {
 						const int sync_duration = std::min(sync_position + sync_length, end_offset) - offset;
-						crt_.output_sync(sync_duration);
+						segments[segment_count++] = Segment{Segment::Type::Sync, sync_duration};
 						offset += sync_duration;
 					}
 
 					if(offset >= sync_position + sync_length && offset < burst_position && end_offset > offset) {
 						const int blank_duration = std::min(burst_position, end_offset) - offset;
-						crt_.output_blank(blank_duration);
+						segments[segment_count++] = Segment{Segment::Type::Blank, blank_duration};
 						offset += blank_duration;
 					}
 
@@ -224,18 +246,22 @@ template <Timing timing> class Video {
 						const int burst_duration = std::min(burst_position + burst_length, end_offset) - offset;
 
 						if constexpr (timing >= Timing::OneTwoEightK) {
-							crt_.output_colour_burst(burst_duration, 116, is_alternate_line_);
+							segments[segment_count++] = Segment{Segment::Type::ColourBurst, burst_duration, 0, 116, is_alternate_line_};
 							// The colour burst phase above is an empirical guess. I need to research further.
 						} else {
-							crt_.output_default_colour_burst(burst_duration);
+							segments[segment_count++] = Segment{Segment::Type::DefaultColourBurst, burst_duration};
 						}
 						offset += burst_duration;
 					}
 
 					if(offset >= burst_position+burst_length && end_offset > offset) {
 						const int border_duration = end_offset - offset;
-						output_border(border_duration);
+						uint8_t *const colour_pointer = crt_.begin_data(1);
+						if(colour_pointer) *colour_pointer = border_colour_;
+						segments[segment_count++] = Segment{Segment::Type::Level, border_duration};
 					}
+
+					crt_.output_segments(segments, segment_count);
 				}
 
 				cycles_remaining -= cycles_this_line;
@@ -267,7 +293,7 @@ template <Timing timing> class Video {
 			return HalfCycles(timings.half_cycles_per_line * timings.lines_per_frame);
 		}
 
-		HalfCycles time_since_interrupt() {
+		HalfCycles time_since_interrupt() const {
 			const auto timings = get_timings();
 			if(time_into_frame_ >= timings.interrupt_time) {
 				return HalfCycles(time_into_frame_ - timings.interrupt_time);
@@ -347,21 +373,13 @@ template <Timing timing> class Video {
 			needs to be applied in @c offset half-cycles from now.
 		*/
 		HalfCycles access_delay(HalfCycles offset) const {
-			constexpr auto timings = get_timings();
-			const int delay_time = (time_into_frame_ + offset.as<int>() + timings.contention_leadin) % (timings.half_cycles_per_line * timings.lines_per_frame);
-			assert(!(delay_time&1));
-
-			// Check for a time within the no-contention window.
-			if(delay_time >= (191*timings.half_cycles_per_line + timings.contention_duration)) {
-				return 0;
-			}
-
-			const int time_into_line = delay_time % timings.half_cycles_per_line;
-			if(time_into_line >= timings.contention_duration) {
-				return 0;
-			}
+			static constexpr auto contention_table = get_contention_table();
+			constexpr int frame_length = int(contention_table.size() << 1);
+			int time_into_frame = time_into_frame_ + offset.as<int>();
+			if(time_into_frame >= frame_length) time_into_frame %= frame_length;
+			assert(!(time_into_frame&1));
 
-			return HalfCycles(timings.delays[(time_into_line >> 1) & 7]);
+			return HalfCycles(contention_table[size_t(time_into_frame >> 1)]);
 		}
 
 		/*!
@@ -483,7 +501,7 @@ struct State: public Reflection::StructImpl<State> {
 		half_cycles_since_interrupt = source.time_since_interrupt().template as<int>();
 	}
 
-	template <typename Video> void apply(Video &target) {
+	template <typename Video> void apply(Video &target) const {
 		target.set_border_colour(border_colour);
 		target.flash_mask_ = flash ? 0xff : 0x00;
 		target.flash_counter_ = flash_counter;
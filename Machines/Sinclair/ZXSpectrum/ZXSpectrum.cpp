@@ -124,10 +124,12 @@ template<Model model> class ConcreteMachine:
 	public CPU::Z80::BusHandler,
 	public Machine,
 	public MachineTypes::AudioProducer,
+	public MachineTypes::BusTraceable,
 	public MachineTypes::JoystickMachine,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::ScanProducer,
+	public MachineTypes::StateProducer,
 	public MachineTypes::TimedMachine,
 	public Utility::TypeRecipient<CharacterMapper> {
 	public:
@@ -175,13 +177,18 @@ template<Model model> class ConcreteMachine:
 			// Set up initial memory map.
 			update_memory_map();
 			set_video_address();
-			Memory::Fuzz(ram_);
+
+			// Randomise RAM as per power on, unless a state is about to overwrite all of it.
+			const auto state = dynamic_cast<const State *>(target.state.get());
+			if(!state || state->ram.size() < ram_in_use()) {
+				Memory::Fuzz(ram_);
+			}
 
 			// Insert media.
 			insert_media(target.media);
 
-			// Possibly depress the enter key.
-			if(target.should_hold_enter) {
+			// Possibly depress the enter key; there's no need if resuming from a state.
+			if(target.should_hold_enter && !target.state) {
 				// Hold it for five seconds, more or less.
 				duration_to_press_enter_ = Cycles(5 * clock_rate());
 				keyboard_.set_key_state(ZX::Keyboard::KeyEnter, true);
@@ -189,25 +196,7 @@ template<Model model> class ConcreteMachine:
 
 			// Install state if supplied.
 			if(target.state) {
-				const auto state = static_cast<State *>(target.state.get());
-				state->z80.apply(z80_);
-				state->video.apply(*video_.last_valid());
-				state->ay.apply(ay_);
-
-				// If this is a 48k or 16k machine, remap source data from its original
-				// linear form to whatever the banks end up being; otherwise copy as is.
-				if(model <= Model::FortyEightK) {
-					const size_t num_banks = std::min(size_t(48*1024), state->ram.size()) >> 14;
-					for(size_t c = 0; c < num_banks; c++) {
-						memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state->ram[c * 0x4000], 0x4000);
-					}
-				} else {
-					memcpy(ram_.data(), state->ram.data(), std::min(ram_.size(), state->ram.size()));
-
-					port1ffd_ = state->last_1ffd;
-					port7ffd_ = state->last_7ffd;
-					update_memory_map();
-				}
+				set_state(*target.state);
 			}
 		}
 
@@ -296,6 +285,59 @@ template<Model model> class ConcreteMachine:
 			return video_->get_display_type();
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() override {
+			auto state = std::make_unique<State>();
+			state->z80 = CPU::Z80::State(z80_);
+
+			video_.flush();
+			state->video = Video::State(*video_.last_valid());
+			state->ay = GI::AY38910::State(ay_);
+
+			// Store 48kb and 16kb machines as linear memory, per the constructor;
+			// otherwise store all banks in order.
+			if(model <= Model::FortyEightK) {
+				const size_t num_banks = model == Model::SixteenK ? 1 : 3;
+				state->ram.resize(num_banks * 0x4000);
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&state->ram[c * 0x4000], &read_pointers_[c + 1][(c+1) * 0x4000], 0x4000);
+				}
+			} else {
+				state->ram.assign(ram_.begin(), ram_.end());
+				state->last_1ffd = port1ffd_;
+				state->last_7ffd = port7ffd_;
+			}
+
+			return state;
+		}
+
+		void set_state(const Reflection::Struct &source) override {
+			const auto state = dynamic_cast<const State *>(&source);
+			if(!state) return;
+
+			state->z80.apply(z80_);
+
+			video_.flush();
+			state->video.apply(*video_.last_valid());
+			state->ay.apply(ay_);
+
+			// If this is a 48k or 16k machine, remap source data from its original
+			// linear form to whatever the banks end up being; otherwise copy as is.
+			if(model <= Model::FortyEightK) {
+				const size_t num_banks = std::min(size_t(48*1024), state->ram.size()) >> 14;
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state->ram[c * 0x4000], 0x4000);
+				}
+			} else {
+				memcpy(ram_.data(), state->ram.data(), std::min(ram_.size(), state->ram.size()));
+
+				port1ffd_ = state->last_1ffd;
+				port7ffd_ = state->last_7ffd;
+				update_memory_map();
+			}
+		}
+
 		// MARK: - BusHandler.
 
 		forceinline HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
@@ -700,6 +742,7 @@ template<Model model> class ConcreteMachine:
 
 		void set_component_prefers_clocking(ClockingHint::Source *, ClockingHint::Preference) override {
 			tape_player_is_sleeping_ = tape_player_.preferred_clocking() == ClockingHint::Preference::None;
+			set_is_loading(!tape_player_is_sleeping_);
 		}
 
 		// MARK: - Tape control.
@@ -743,6 +786,15 @@ template<Model model> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		// MARK: - BusTraceable.
+		CPU::BusTrace::Bus traced_bus() const final {
+			return CPU::BusTrace::Bus::Z80;
+		}
+
+		void set_bus_trace(CPU::BusTrace *trace) final {
+			z80_.set_bus_trace(trace);
+		}
+
 		// MARK: - Activity Source.
 		void set_activity_observer(Activity::Observer *observer) override {
 			if constexpr (model == Model::Plus3) fdc_->set_activity_observer(observer);
@@ -756,6 +808,15 @@ template<Model model> class ConcreteMachine:
 		std::array<uint8_t, 64*1024> rom_;
 		std::array<uint8_t, 128*1024> ram_;
 
+		/// @returns The number of bytes of RAM that this model can access, which is also the amount captured by a State.
+		static constexpr size_t ram_in_use() {
+			switch(model) {
+				case Model::SixteenK:		return 16*1024;
+				case Model::FortyEightK:	return 48*1024;
+				default:					return 128*1024;
+			}
+		}
+
 		std::array<uint8_t, 16*1024> scratch_;
 		const uint8_t *read_pointers_[4];
 		uint8_t *write_pointers_[4];
@@ -849,7 +910,7 @@ template<Model model> class ConcreteMachine:
 		}
 
 		// MARK: - Audio.
-		Concurrency::AsyncTaskQueue<false> audio_queue_;
+		Concurrency::AsyncTaskQueue<false> audio_queue_{Concurrency::ThreadRole::Audio};
 		GI::AY38910::AY38910<false> ay_;
 		Audio::Toggle audio_toggle_;
 		Outputs::Speaker::CompoundSource<GI::AY38910::AY38910<false>, Audio::Toggle> mixer_;
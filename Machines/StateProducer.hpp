@@ -14,11 +14,20 @@
 
 namespace MachineTypes {
 
+/*!
+	A StateProducer is able to capture its complete current state, such that a machine
+	constructed from an otherwise-identical target with that state installed as its
+	@c Analyser::Static::Target::state will resume from the same point.
+
+	States are Reflection::Structs and can therefore be written to and read from BSON
+	via @c serialise and @c deserialise.
+*/
 struct StateProducer {
-	// TODO.
-//	virtual bool get_state(Analyser::Static::State *, [[maybe_unused]] bool advance_to_simple = false) {
-//		return false;
-//	}
+	/// @returns A capture of the machine's current state, or @c nullptr if one cannot be produced.
+	virtual std::unique_ptr<Reflection::Struct> get_state() = 0;
+
+	/// Returns the machine to @c state, which should have been obtained from @c get_state.
+	virtual void set_state(const Reflection::Struct &state) = 0;
 };
 
 };
@@ -10,12 +10,16 @@
 #define TimedMachine_h
 
 #include "../ClockReceiver/ClockReceiver.hpp"
+#include "../ClockReceiver/Profiler.hpp"
 #include "../ClockReceiver/TimeTypes.hpp"
 
 #include "AudioProducer.hpp"
+#include "Profiled.hpp"
 #include "ScanProducer.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 namespace MachineTypes {
 
@@ -23,14 +27,54 @@ namespace MachineTypes {
 	A timed machine is any which requires the owner to provide time-based updates,
 	i.e. run_for(<some number of seconds>)-type calls.
 
+	Time spent within run_for is attributed to TimedMachine for the purposes of Profiled, so
+	that its inclusive total is the whole cost of emulation.
 */
-class TimedMachine {
+class TimedMachine: public Profiled {
 	public:
 		/// Runs the machine for @c duration seconds.
 		virtual void run_for(Time::Seconds duration) {
-			const double cycles = (duration * clock_rate_ * speed_multiplier_) + clock_conversion_error_;
+			const double cycles = (duration * clock_rate_ * effective_speed_multiplier()) + clock_conversion_error_;
 			clock_conversion_error_ = std::fmod(cycles, 1.0);
+
+			Profiling::Scope<TimedMachine> profiling_scope(static_cast<int64_t>(cycles));
 			run_for(Cycles(int(cycles)));
+			cycles_run_ += uint64_t(cycles);
+		}
+
+		/*!
+			Runs the machine for up to @c duration seconds as per run_for, but in short steps between
+			which the host clock is compared with @c deadline; no further steps are begun once it has passed.
+			At least one step is always run, to guarantee progress.
+
+			@returns The portion of @c duration that was run; a caller can carry the remainder forward
+			rather than overrunning its own deadline.
+		*/
+		Time::Seconds run_until_deadline(Time::Seconds duration, Time::Nanos deadline) {
+			Time::Seconds completed = 0.0;
+			while(completed < duration) {
+				const Time::Seconds step = std::min(duration - completed, DeadlineStep);
+				run_for(step);
+				completed += step;
+
+				if(Time::nanos_now() >= deadline) break;
+			}
+			return completed;
+		}
+
+		/*!
+			Runs the machine for exactly @c cycles, irrespective of any speed multiplier. This allows
+			a host to place events at a precise point in emulated time, e.g. to replay recorded input.
+		*/
+		void run_for_exactly(Cycles cycles) {
+			Profiling::Scope<TimedMachine> profiling_scope(cycles.as_integral());
+			run_for(cycles);
+			cycles_run_ += uint64_t(cycles.as_integral());
+		}
+
+		/// @returns The total number of cycles for which this machine has so far been run.
+		uint64_t get_cycles_run() const {
+			return cycles_run_;
 		}
 
 		/*!
@@ -44,14 +88,7 @@ class TimedMachine {
 			}
 
 			speed_multiplier_ = multiplier;
-
-			auto audio_producer = dynamic_cast<AudioProducer *>(this);
-			if(!audio_producer) return;
-
-			auto speaker = audio_producer->get_speaker();
-			if(speaker) {
-				speaker->set_input_rate_multiplier(float(multiplier));
-			}
+			update_speaker_rate();
 		}
 
 		/*!
@@ -61,6 +98,23 @@ class TimedMachine {
 			return speed_multiplier_;
 		}
 
+		/*!
+			Sets a further multiplier that applies on top of the speed multiplier whenever the machine
+			indicates that it is loading from slow media, e.g. while a tape is playing. This allows
+			custom loaders, which no quickload trap can recognise, to complete more quickly.
+
+			The default is 1.0, i.e. no acceleration.
+		*/
+		virtual void set_loading_speed_multiplier(double multiplier) {
+			loading_speed_multiplier_ = multiplier;
+			update_speaker_rate();
+		}
+
+		/// @returns This machine's clock rate, in cycles per second, prior to any speed multiplier.
+		double get_clock_rate() const {
+			return clock_rate_;
+		}
+
 		/// @returns The confidence that this machine is running content it understands.
 		virtual float get_confidence() { return 0.5f; }
 		virtual std::string debug_type() { return ""; }
@@ -84,18 +138,45 @@ class TimedMachine {
 			clock_rate_ = clock_rate;
 		}
 
-		/// Gets this machine's clock rate.
-		double get_clock_rate() const {
-			return clock_rate_;
+		/// Indicates whether this machine is currently loading from slow media; while it is, the
+		/// loading speed multiplier applies. Takes effect from the next call to run_for(Seconds).
+		void set_is_loading(bool is_loading) {
+			if(is_loading_ == is_loading) {
+				return;
+			}
+
+			is_loading_ = is_loading;
+			update_speaker_rate();
 		}
 
 	private:
 		// Give the ScanProducer access to this machine's clock rate.
 		friend class ScanProducer;
 
+		// The granularity at which run_until_deadline checks the host clock; a machine can't leave
+		// run_for(Cycles) early, so this bounds the overrun.
+		static constexpr Time::Seconds DeadlineStep = 0.001;
+
 		double clock_rate_ = 1.0;
 		double clock_conversion_error_ = 0.0;
+		uint64_t cycles_run_ = 0;
 		double speed_multiplier_ = 1.0;
+		double loading_speed_multiplier_ = 1.0;
+		bool is_loading_ = false;
+
+		double effective_speed_multiplier() const {
+			return is_loading_ ? speed_multiplier_ * loading_speed_multiplier_ : speed_multiplier_;
+		}
+
+		void update_speaker_rate() {
+			auto audio_producer = dynamic_cast<AudioProducer *>(this);
+			if(!audio_producer) return;
+
+			auto speaker = audio_producer->get_speaker();
+			if(speaker) {
+				speaker->set_input_rate_multiplier(float(effective_speed_multiplier()));
+			}
+		}
 };
 
 }
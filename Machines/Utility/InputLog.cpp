@@ -0,0 +1,284 @@
+//
+//  InputLog.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "InputLog.hpp"
+
+#include <cmath>
+#include <cstring>
+
+using namespace Machine;
+
+namespace {
+
+constexpr char Signature[] = "CLKINPUT";
+constexpr uint32_t Version = 1;
+
+uint32_t float_bits(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+float bits_float(uint32_t bits) {
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+}
+
+// MARK: - Recorder.
+
+InputRecorder::InputRecorder(DynamicMachine &machine, const std::string &file_name) :
+	machine_(machine), file_(file_name, Storage::FileHolder::FileMode::Rewrite) {
+	file_.write(reinterpret_cast<const uint8_t *>(Signature), sizeof(Signature) - 1);
+	file_.put_le<uint32_t>(Version);
+}
+
+InputRecorder::~InputRecorder() {
+	begin_entry(InputLog::Entry::End);
+	file_.flush();
+}
+
+void InputRecorder::begin_entry(InputLog::Entry entry) {
+	file_.put_le<uint64_t>(machine_.timed_machine()->get_cycles_run());
+	file_.put8(uint8_t(entry));
+}
+
+void InputRecorder::put_string(const std::string &string) {
+	file_.put_le<uint32_t>(uint32_t(string.size()));
+	file_.write(reinterpret_cast<const uint8_t *>(string.data()), string.size());
+}
+
+bool InputRecorder::set_key_pressed(Inputs::Keyboard::Key key, char symbol, bool is_pressed) {
+	const auto keyboard_machine = machine_.keyboard_machine();
+	if(!keyboard_machine) return false;
+
+	begin_entry(is_pressed ? InputLog::Entry::KeyPressed : InputLog::Entry::KeyReleased);
+	file_.put_le<uint16_t>(uint16_t(key));
+	file_.put8(uint8_t(symbol));
+	return keyboard_machine->get_keyboard().set_key_pressed(key, symbol, is_pressed);
+}
+
+bool InputRecorder::apply_key(Inputs::Keyboard::Key key, char symbol, bool is_pressed, bool map_logically) {
+	const auto keyboard_machine = machine_.keyboard_machine();
+	if(!keyboard_machine) return false;
+
+	begin_entry(is_pressed ? InputLog::Entry::ApplyKeyPressed : InputLog::Entry::ApplyKeyReleased);
+	file_.put_le<uint16_t>(uint16_t(key));
+	file_.put8(uint8_t(symbol));
+	file_.put8(map_logically);
+	return keyboard_machine->apply_key(key, symbol, is_pressed, map_logically);
+}
+
+void InputRecorder::reset_all_keys() {
+	const auto keyboard_machine = machine_.keyboard_machine();
+	if(!keyboard_machine) return;
+
+	begin_entry(InputLog::Entry::ResetKeys);
+	keyboard_machine->get_keyboard().reset_all_keys();
+}
+
+void InputRecorder::type_string(const std::string &string) {
+	const auto keyboard_machine = machine_.keyboard_machine();
+	if(!keyboard_machine) return;
+
+	begin_entry(InputLog::Entry::TypeString);
+	put_string(string);
+	keyboard_machine->type_string(string);
+}
+
+void InputRecorder::put_joystick_input(size_t joystick, const Inputs::Joystick::Input &input) {
+	file_.put8(uint8_t(joystick));
+	file_.put8(uint8_t(input.type));
+	file_.put_le<uint32_t>(
+		input.type == Inputs::Joystick::Input::Key ? uint32_t(input.info.key.symbol) : uint32_t(input.info.control.index)
+	);
+}
+
+void InputRecorder::set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, bool is_active) {
+	const auto joystick_machine = machine_.joystick_machine();
+	if(!joystick_machine || joystick >= joystick_machine->get_joysticks().size()) return;
+
+	begin_entry(InputLog::Entry::JoystickDigital);
+	put_joystick_input(joystick, input);
+	file_.put8(is_active);
+	joystick_machine->get_joysticks()[joystick]->set_input(input, is_active);
+}
+
+void InputRecorder::set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, float value) {
+	const auto joystick_machine = machine_.joystick_machine();
+	if(!joystick_machine || joystick >= joystick_machine->get_joysticks().size()) return;
+
+	begin_entry(InputLog::Entry::JoystickAnalogue);
+	put_joystick_input(joystick, input);
+	file_.put_le<uint32_t>(float_bits(value));
+	joystick_machine->get_joysticks()[joystick]->set_input(input, value);
+}
+
+void InputRecorder::move_mouse(int x, int y) {
+	const auto mouse_machine = machine_.mouse_machine();
+	if(!mouse_machine) return;
+
+	begin_entry(InputLog::Entry::MouseMove);
+	file_.put_le<uint32_t>(uint32_t(x));
+	file_.put_le<uint32_t>(uint32_t(y));
+	mouse_machine->get_mouse().move(x, y);
+}
+
+void InputRecorder::set_mouse_button_pressed(int index, bool is_pressed) {
+	const auto mouse_machine = machine_.mouse_machine();
+	if(!mouse_machine) return;
+
+	begin_entry(InputLog::Entry::MouseButton);
+	file_.put8(uint8_t(index));
+	file_.put8(is_pressed);
+	mouse_machine->get_mouse().set_button_pressed(index, is_pressed);
+}
+
+bool InputRecorder::insert_media(const std::string &file_name, const Analyser::Static::Media &media) {
+	const auto media_target = machine_.media_target();
+	if(!media_target) return false;
+
+	begin_entry(InputLog::Entry::InsertMedia);
+	put_string(file_name);
+	return media_target->insert_media(media);
+}
+
+// MARK: - Player.
+
+InputPlayer::InputPlayer(DynamicMachine &machine, const std::string &file_name) :
+	machine_(machine), file_(file_name, Storage::FileHolder::FileMode::Read) {
+	if(!file_.check_signature(Signature) || file_.get_le<uint32_t>() != Version) {
+		throw Error::InvalidLog;
+	}
+	read_next();
+}
+
+void InputPlayer::read_next() {
+	next_cycle_ = file_.get_le<uint64_t>();
+	next_entry_ = InputLog::Entry(file_.get8());
+
+	// Treat a truncated log as ending here.
+	if(file_.eof()) {
+		next_entry_ = InputLog::Entry::End;
+	}
+}
+
+std::string InputPlayer::get_string() {
+	const auto length = file_.get_le<uint32_t>();
+	const auto bytes = file_.read(length);
+	return std::string(bytes.begin(), bytes.end());
+}
+
+bool InputPlayer::run_for(Time::Seconds duration) {
+	const auto timed_machine = machine_.timed_machine();
+
+	const double cycles = duration * timed_machine->get_clock_rate() + clock_conversion_error_;
+	clock_conversion_error_ = std::fmod(cycles, 1.0);
+	const uint64_t target = timed_machine->get_cycles_run() + uint64_t(cycles);
+
+	while(next_cycle_ <= target) {
+		const uint64_t now = timed_machine->get_cycles_run();
+		if(next_cycle_ > now) {
+			timed_machine->run_for_exactly(Cycles(Cycles::IntType(next_cycle_ - now)));
+		}
+		if(next_entry_ == InputLog::Entry::End) {
+			return false;
+		}
+		apply_next();
+		read_next();
+	}
+
+	const uint64_t now = timed_machine->get_cycles_run();
+	if(target > now) {
+		timed_machine->run_for_exactly(Cycles(Cycles::IntType(target - now)));
+	}
+	return true;
+}
+
+void InputPlayer::apply_next() {
+	using Entry = InputLog::Entry;
+	switch(next_entry_) {
+		case Entry::End: break;
+
+		case Entry::KeyPressed:
+		case Entry::KeyReleased:
+		case Entry::ApplyKeyPressed:
+		case Entry::ApplyKeyReleased: {
+			const auto key = Inputs::Keyboard::Key(file_.get_le<uint16_t>());
+			const char symbol = char(file_.get8());
+			const bool is_pressed = next_entry_ == Entry::KeyPressed || next_entry_ == Entry::ApplyKeyPressed;
+			const auto keyboard_machine = machine_.keyboard_machine();
+
+			if(next_entry_ == Entry::KeyPressed || next_entry_ == Entry::KeyReleased) {
+				if(keyboard_machine) keyboard_machine->get_keyboard().set_key_pressed(key, symbol, is_pressed);
+			} else {
+				const bool map_logically = file_.get8();
+				if(keyboard_machine) keyboard_machine->apply_key(key, symbol, is_pressed, map_logically);
+			}
+		} break;
+
+		case Entry::ResetKeys:
+			if(const auto keyboard_machine = machine_.keyboard_machine()) {
+				keyboard_machine->get_keyboard().reset_all_keys();
+			}
+		break;
+
+		case Entry::TypeString: {
+			const std::string string = get_string();
+			if(const auto keyboard_machine = machine_.keyboard_machine()) {
+				keyboard_machine->type_string(string);
+			}
+		} break;
+
+		case Entry::JoystickDigital:
+		case Entry::JoystickAnalogue: {
+			const size_t joystick = file_.get8();
+			const auto type = Inputs::Joystick::Input::Type(file_.get8());
+			const uint32_t info = file_.get_le<uint32_t>();
+			const Inputs::Joystick::Input input =
+				type == Inputs::Joystick::Input::Key ?
+					Inputs::Joystick::Input(wchar_t(info)) :
+					Inputs::Joystick::Input(type, size_t(info));
+
+			const auto joystick_machine = machine_.joystick_machine();
+			const bool has_joystick = joystick_machine && joystick < joystick_machine->get_joysticks().size();
+			if(next_entry_ == Entry::JoystickDigital) {
+				const bool is_active = file_.get8();
+				if(has_joystick) joystick_machine->get_joysticks()[joystick]->set_input(input, is_active);
+			} else {
+				const float value = bits_float(file_.get_le<uint32_t>());
+				if(has_joystick) joystick_machine->get_joysticks()[joystick]->set_input(input, value);
+			}
+		} break;
+
+		case Entry::MouseMove: {
+			const int x = int32_t(file_.get_le<uint32_t>());
+			const int y = int32_t(file_.get_le<uint32_t>());
+			if(const auto mouse_machine = machine_.mouse_machine()) {
+				mouse_machine->get_mouse().move(x, y);
+			}
+		} break;
+
+		case Entry::MouseButton: {
+			const int index = file_.get8();
+			const bool is_pressed = file_.get8();
+			if(const auto mouse_machine = machine_.mouse_machine()) {
+				mouse_machine->get_mouse().set_button_pressed(index, is_pressed);
+			}
+		} break;
+
+		case Entry::InsertMedia: {
+			const std::string file_name = get_string();
+			if(const auto media_target = machine_.media_target()) {
+				media_target->insert_media(Analyser::Static::CopyOnWrite(Analyser::Static::GetMedia(file_name)));
+			}
+		} break;
+	}
+}
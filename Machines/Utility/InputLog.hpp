@@ -0,0 +1,150 @@
+//
+//  InputLog.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InputLog_hpp
+#define InputLog_hpp
+
+#include "../DynamicMachine.hpp"
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Inputs/Joystick.hpp"
+#include "../../Inputs/Keyboard.hpp"
+#include "../../Storage/FileHolder.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace Machine {
+
+/*
+	An input log records every input applied to a machine, and every media change, alongside
+	the number of machine cycles that had elapsed when it was applied. Replaying a log against
+	the same initial machine therefore reproduces the original session exactly, independently of
+	host timing or speed.
+
+	Logs begin "CLKINPUT" and a 32-bit version number, then contain a sequence of entries, each
+	a 64-bit cycle count, a type byte and a type-specific payload. All values are little endian.
+	The final entry is of type End, marking the total length of the session.
+
+	Neither state restoration — e.g. rewinding or run-ahead — nor machines that are still being
+	selected amongst by multi-machine analysis are supported, as neither has a single, monotonic
+	count of cycles.
+*/
+namespace InputLog {
+
+enum class Entry: uint8_t {
+	End,
+	/// Payload: 16-bit Inputs::Keyboard::Key, symbol byte.
+	KeyPressed,
+	KeyReleased,
+	/// As KeyPressed and KeyReleased, but applied via KeyboardMachine::apply_key; payload also has a flag byte, set for logical mapping.
+	ApplyKeyPressed,
+	ApplyKeyReleased,
+	ResetKeys,
+	/// Payload: 32-bit length, then that many characters.
+	TypeString,
+	/// Payload: joystick index byte, Inputs::Joystick::Input::Type byte, 32-bit index or symbol, value byte.
+	JoystickDigital,
+	/// Payload: as per JoystickDigital but with a 32-bit IEEE 754 value.
+	JoystickAnalogue,
+	/// Payload: 32-bit signed x and y.
+	MouseMove,
+	/// Payload: button index byte, pressed byte.
+	MouseButton,
+	/// Payload: 32-bit length, then that many characters of file name.
+	InsertMedia,
+};
+
+}
+
+/*!
+	Applies inputs to a machine on behalf of a host while recording them to an input log.
+
+	The caller must ensure that the machine is not running during any call to this class,
+	so that each input is applied at a definite point in emulated time.
+*/
+class InputRecorder {
+	public:
+		/*!
+			Begins recording to @c file_name.
+
+			@throws Storage::FileHolder::Error if the file could not be opened.
+		*/
+		InputRecorder(DynamicMachine &machine, const std::string &file_name);
+
+		/// Completes the log with an End entry at the current time.
+		~InputRecorder();
+
+		// Keyboard inputs; these forward to the machine's keyboard and return its results.
+		bool set_key_pressed(Inputs::Keyboard::Key key, char symbol, bool is_pressed);
+		bool apply_key(Inputs::Keyboard::Key key, char symbol, bool is_pressed, bool map_logically);
+		void reset_all_keys();
+		void type_string(const std::string &);
+
+		// Joystick inputs.
+		void set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, bool is_active);
+		void set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, float value);
+
+		// Mouse inputs.
+		void move_mouse(int x, int y);
+		void set_mouse_button_pressed(int index, bool is_pressed);
+
+		/// Inserts @c media, which should have been obtained from @c file_name; replay will reload it from that file.
+		bool insert_media(const std::string &file_name, const Analyser::Static::Media &media);
+
+	private:
+		DynamicMachine &machine_;
+		Storage::FileHolder file_;
+
+		void begin_entry(InputLog::Entry);
+		void put_string(const std::string &);
+		void put_joystick_input(size_t joystick, const Inputs::Joystick::Input &input);
+};
+
+/*!
+	Replays an input log against a machine, which should be in the same initial state as the one
+	that was recorded. Media is reloaded from its original file name and inserted copy-on-write,
+	so that replays never modify it.
+*/
+class InputPlayer {
+	public:
+		enum class Error {
+			InvalidLog
+		};
+
+		/*!
+			Opens @c file_name for replay.
+
+			@throws Storage::FileHolder::Error if the file could not be opened; Error::InvalidLog if it isn't an input log.
+		*/
+		InputPlayer(DynamicMachine &machine, const std::string &file_name);
+
+		/*!
+			Runs the machine for @c duration, at its nominal clock rate, applying logged inputs at their proper times.
+
+			@returns @c true if the log extends beyond the new current time; @c false if the log has ended, in which
+				case the machine will have been run only up to its end.
+		*/
+		bool run_for(Time::Seconds duration);
+
+	private:
+		DynamicMachine &machine_;
+		Storage::FileHolder file_;
+		double clock_conversion_error_ = 0.0;
+
+		uint64_t next_cycle_ = 0;
+		InputLog::Entry next_entry_ = InputLog::Entry::End;
+
+		void read_next();
+		void apply_next();
+		std::string get_string();
+};
+
+}
+
+#endif /* InputLog_hpp */
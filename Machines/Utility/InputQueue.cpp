@@ -0,0 +1,174 @@
+//
+//  InputQueue.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "InputQueue.hpp"
+
+using namespace Machine;
+
+// MARK: - Producer.
+
+bool InputQueue::post(Event &event) {
+	event.timestamp = Time::nanos_now();
+	return events_.push(&event, 1);
+}
+
+void InputQueue::set_joystick_input(Event &event, size_t joystick, const Inputs::Joystick::Input &input) {
+	event.joystick = uint8_t(joystick);
+	event.input_type = input.type;
+	event.input_info = input.type == Inputs::Joystick::Input::Key ? uint32_t(input.info.key.symbol) : uint32_t(input.info.control.index);
+}
+
+bool InputQueue::set_key_pressed(Inputs::Keyboard::Key key, char symbol, bool is_pressed, const Inputs::Joystick::Input *joystick_fallback) {
+	Event event{};
+	event.type = Event::Type::Key;
+	event.key = key;
+	event.symbol = symbol;
+	event.is_active = is_pressed;
+	if(joystick_fallback) {
+		event.has_joystick_fallback = true;
+		set_joystick_input(event, 0, *joystick_fallback);
+	}
+	return post(event);
+}
+
+bool InputQueue::apply_key(Inputs::Keyboard::Key key, char symbol, bool is_pressed, bool map_logically, const Inputs::Joystick::Input *joystick_fallback) {
+	Event event{};
+	event.type = Event::Type::ApplyKey;
+	event.key = key;
+	event.symbol = symbol;
+	event.is_active = is_pressed;
+	event.map_logically = map_logically;
+	if(joystick_fallback) {
+		event.has_joystick_fallback = true;
+		set_joystick_input(event, 0, *joystick_fallback);
+	}
+	return post(event);
+}
+
+bool InputQueue::reset_all_keys() {
+	Event event{};
+	event.type = Event::Type::ResetKeys;
+	return post(event);
+}
+
+bool InputQueue::set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, bool is_active) {
+	Event event{};
+	event.type = Event::Type::JoystickDigital;
+	event.is_active = is_active;
+	set_joystick_input(event, joystick, input);
+	return post(event);
+}
+
+bool InputQueue::set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, float value) {
+	Event event{};
+	event.type = Event::Type::JoystickAnalogue;
+	event.value = value;
+	set_joystick_input(event, joystick, input);
+	return post(event);
+}
+
+bool InputQueue::move_mouse(int x, int y) {
+	Event event{};
+	event.type = Event::Type::MouseMove;
+	event.x = x;
+	event.y = y;
+	return post(event);
+}
+
+bool InputQueue::set_mouse_button_pressed(int index, bool is_pressed) {
+	Event event{};
+	event.type = Event::Type::MouseButton;
+	event.x = index;
+	event.is_active = is_pressed;
+	return post(event);
+}
+
+// MARK: - Consumer.
+
+void InputQueue::discard() {
+	has_pending_ = false;
+	events_.discard_to(0);
+}
+
+void InputQueue::apply(const Event &event, DynamicMachine &machine, InputRecorder *recorder) {
+	const auto joystick_input = [&event] {
+		return event.input_type == Inputs::Joystick::Input::Key ?
+			Inputs::Joystick::Input(wchar_t(event.input_info)) :
+			Inputs::Joystick::Input(event.input_type, size_t(event.input_info));
+	};
+	const auto set_joystick_input = [&](auto value) {
+		const auto joystick_machine = machine.joystick_machine();
+		if(!joystick_machine || event.joystick >= joystick_machine->get_joysticks().size()) return;
+
+		if(recorder) {
+			recorder->set_joystick_input(event.joystick, joystick_input(), value);
+		} else {
+			joystick_machine->get_joysticks()[event.joystick]->set_input(joystick_input(), value);
+		}
+	};
+
+	switch(event.type) {
+		case Event::Type::Key:
+		case Event::Type::ApplyKey: {
+			bool was_handled = false;
+			if(const auto keyboard_machine = machine.keyboard_machine()) {
+				if(event.type == Event::Type::Key) {
+					was_handled = recorder ?
+						recorder->set_key_pressed(event.key, event.symbol, event.is_active) :
+						keyboard_machine->get_keyboard().set_key_pressed(event.key, event.symbol, event.is_active);
+				} else {
+					was_handled = recorder ?
+						recorder->apply_key(event.key, event.symbol, event.is_active, event.map_logically) :
+						keyboard_machine->apply_key(event.key, event.symbol, event.is_active, event.map_logically);
+				}
+			}
+
+			if(!was_handled && event.has_joystick_fallback) {
+				set_joystick_input(event.is_active);
+			}
+		} break;
+
+		case Event::Type::ResetKeys:
+			if(const auto keyboard_machine = machine.keyboard_machine()) {
+				if(recorder) {
+					recorder->reset_all_keys();
+				} else {
+					keyboard_machine->get_keyboard().reset_all_keys();
+				}
+			}
+		break;
+
+		case Event::Type::JoystickDigital:
+			set_joystick_input(event.is_active);
+		break;
+
+		case Event::Type::JoystickAnalogue:
+			set_joystick_input(event.value);
+		break;
+
+		case Event::Type::MouseMove:
+			if(const auto mouse_machine = machine.mouse_machine()) {
+				if(recorder) {
+					recorder->move_mouse(event.x, event.y);
+				} else {
+					mouse_machine->get_mouse().move(event.x, event.y);
+				}
+			}
+		break;
+
+		case Event::Type::MouseButton:
+			if(const auto mouse_machine = machine.mouse_machine()) {
+				if(recorder) {
+					recorder->set_mouse_button_pressed(event.x, event.is_active);
+				} else {
+					mouse_machine->get_mouse().set_button_pressed(event.x, event.is_active);
+				}
+			}
+		break;
+	}
+}
@@ -0,0 +1,137 @@
+//
+//  InputQueue.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef InputQueue_hpp
+#define InputQueue_hpp
+
+#include "InputLog.hpp"
+#include "../DynamicMachine.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Concurrency/SPSCRing.hpp"
+#include "../../Inputs/Joystick.hpp"
+#include "../../Inputs/Keyboard.hpp"
+
+#include <cstdint>
+
+namespace Machine {
+
+/*!
+	Carries keyboard, joystick and mouse input from a host's UI thread to its emulation thread without
+	either waiting for the other, so that input never has to wait for the machine lock to become free.
+
+	Each input is stamped with the host time at which it was posted. The emulation thread then calls
+	@c apply_until while running the machine, which supplies the time of each input in turn so that the
+	host can run the machine up to that moment before it is applied. So inputs take effect at the point in
+	emulated time corresponding to when they occurred, independently of how the host happens to divide
+	up its calls to run the machine; if an InputRecorder is in use then that point is also what is logged.
+
+	Inputs that can't be represented in a fixed-size form — typed strings and media — should still be
+	applied directly, with the machine lock held.
+
+	Methods are grouped as to whether they may be called by the producer, i.e. the UI thread, or by the
+	consumer, i.e. whichever thread is holding the machine lock.
+*/
+class InputQueue {
+	public:
+		// MARK: - Producer.
+		//
+		// Each of these returns @c true if the input was queued; @c false if the queue is full, in which
+		// case the input is lost.
+
+		/*!
+			Posts a key press or release, to be applied via Keyboard::set_key_pressed. If @c joystick_fallback
+			is supplied then that joystick input is applied instead if the machine has no keyboard, or its
+			keyboard doesn't handle @c key.
+		*/
+		bool set_key_pressed(Inputs::Keyboard::Key key, char symbol, bool is_pressed, const Inputs::Joystick::Input *joystick_fallback = nullptr);
+
+		/// As per @c set_key_pressed, but to be applied via KeyboardMachine::apply_key.
+		bool apply_key(Inputs::Keyboard::Key key, char symbol, bool is_pressed, bool map_logically, const Inputs::Joystick::Input *joystick_fallback = nullptr);
+
+		bool reset_all_keys();
+
+		bool set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, bool is_active);
+		bool set_joystick_input(size_t joystick, const Inputs::Joystick::Input &input, float value);
+
+		bool move_mouse(int x, int y);
+		bool set_mouse_button_pressed(int index, bool is_pressed);
+
+		// MARK: - Consumer.
+
+		/*!
+			Applies, in order, every input posted no later than @c end.
+
+			Before each is applied @c advance is called with the host time, in Time::Nanos, at which it
+			was posted; it should run the machine up to that time if it hasn't already reached it.
+
+			@param recorder If non-null, all input is applied via the recorder so that it is also logged.
+		*/
+		template <typename AdvanceT> void apply_until(Time::Nanos end, DynamicMachine &machine, InputRecorder *recorder, AdvanceT &&advance) {
+			while(true) {
+				if(!has_pending_) {
+					if(!events_.pop(&pending_, 1)) return;
+					has_pending_ = true;
+				}
+				if(pending_.timestamp > end) return;
+
+				advance(pending_.timestamp);
+				apply(pending_, machine, recorder);
+				has_pending_ = false;
+			}
+		}
+
+		/// Discards all queued input, e.g. because the machine has been replaced.
+		void discard();
+
+	private:
+		struct Event {
+			enum class Type: uint8_t {
+				Key,
+				ApplyKey,
+				ResetKeys,
+				JoystickDigital,
+				JoystickAnalogue,
+				MouseMove,
+				MouseButton,
+			};
+
+			Time::Nanos timestamp;
+			Type type;
+
+			// Keys.
+			Inputs::Keyboard::Key key;
+			char symbol;
+			bool map_logically;
+			bool has_joystick_fallback;
+
+			// Key presses, digital joystick inputs and mouse buttons.
+			bool is_active;
+
+			// Joystick inputs, including any key fallback; Inputs::Joystick::Input isn't assignable so is stored by parts.
+			uint8_t joystick;
+			Inputs::Joystick::Input::Type input_type;
+			uint32_t input_info;
+			float value;
+
+			// Mouse inputs; x is also the index of a mouse button.
+			int x, y;
+		};
+		Concurrency::SPSCRing<Event, 1024> events_;
+
+		// Used only by the consumer.
+		Event pending_;
+		bool has_pending_ = false;
+
+		bool post(Event &event);
+		static void set_joystick_input(Event &event, size_t joystick, const Inputs::Joystick::Input &input);
+		static void apply(const Event &event, DynamicMachine &machine, InputRecorder *recorder);
+};
+
+}
+
+#endif /* InputQueue_hpp */
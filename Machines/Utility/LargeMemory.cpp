@@ -0,0 +1,85 @@
+//
+//  LargeMemory.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "LargeMemory.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define HAS_MMAP
+#endif
+
+namespace {
+
+// The size of a huge page on all current x86 and common ARM Linux configurations; anything smaller
+// than this gains nothing from being mapped directly so is instead allocated normally.
+constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+constexpr std::size_t round_up(std::size_t size, std::size_t granularity) {
+	return (size + granularity - 1) & ~(granularity - 1);
+}
+
+}
+
+void *Memory::AllocateLarge(std::size_t size) {
+#ifdef HAS_MMAP
+	if(size >= HugePageSize) {
+		const std::size_t rounded = round_up(size, HugePageSize);
+
+#ifdef MAP_HUGETLB
+		// Use explicit huge pages if any have been reserved.
+		void *const huge = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if(huge != MAP_FAILED) {
+			return huge;
+		}
+#endif
+
+		// Otherwise map a little extra so that a huge-page-aligned region can be cut out of it,
+		// and return the excess.
+		const std::size_t span = rounded + HugePageSize;
+		void *const mapping = mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if(mapping == MAP_FAILED) {
+			throw std::bad_alloc();
+		}
+
+		uint8_t *const base = static_cast<uint8_t *>(mapping);
+		uint8_t *const aligned = reinterpret_cast<uint8_t *>(round_up(reinterpret_cast<uintptr_t>(base), HugePageSize));
+		if(aligned != base) {
+			munmap(base, std::size_t(aligned - base));
+		}
+		if(aligned + rounded != base + span) {
+			munmap(aligned + rounded, std::size_t(base + span - (aligned + rounded)));
+		}
+
+#ifdef MADV_HUGEPAGE
+		// Advisory only; failure just means regular pages.
+		madvise(aligned, rounded, MADV_HUGEPAGE);
+#endif
+		return aligned;
+	}
+#endif
+
+	void *const result = std::calloc(size ? size : 1, 1);
+	if(!result) {
+		throw std::bad_alloc();
+	}
+	return result;
+}
+
+void Memory::FreeLarge(void *pointer, std::size_t size) {
+#ifdef HAS_MMAP
+	if(size >= HugePageSize) {
+		munmap(pointer, round_up(size, HugePageSize));
+		return;
+	}
+#endif
+
+	std::free(pointer);
+}
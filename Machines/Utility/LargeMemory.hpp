@@ -0,0 +1,55 @@
+//
+//  LargeMemory.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef LargeMemory_hpp
+#define LargeMemory_hpp
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace Memory {
+
+/*!
+	Allocates @c size bytes of zero-filled storage directly from the host's virtual memory system,
+	preferring huge pages so that an emulated RAM of a few megabytes occupies only a handful of
+	TLB entries. Explicit huge pages are used if the host has any reserved, transparent huge pages
+	are requested otherwise, and if neither is available then regular pages are used.
+
+	@throws std::bad_alloc if no storage could be allocated.
+*/
+void *AllocateLarge(std::size_t size);
+
+/// Releases storage previously obtained from AllocateLarge; @c size must be as was requested.
+void FreeLarge(void *pointer, std::size_t size);
+
+/// A standard allocator that obtains storage via AllocateLarge.
+template <typename T> struct LargeAllocator {
+	using value_type = T;
+
+	LargeAllocator() = default;
+	template <typename U> LargeAllocator(const LargeAllocator<U> &) noexcept {}
+
+	T *allocate(std::size_t n) {
+		return static_cast<T *>(AllocateLarge(n * sizeof(T)));
+	}
+
+	void deallocate(T *pointer, std::size_t n) noexcept {
+		FreeLarge(pointer, n * sizeof(T));
+	}
+
+	template <typename U> bool operator ==(const LargeAllocator<U> &) const noexcept { return true; }
+	template <typename U> bool operator !=(const LargeAllocator<U> &) const noexcept { return false; }
+};
+
+/// A vector suitable for storing an emulated RAM of a megabyte or more.
+template <typename T> using LargeVector = std::vector<T, LargeAllocator<T>>;
+
+}
+
+#endif /* LargeMemory_hpp */
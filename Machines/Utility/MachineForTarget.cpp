@@ -9,6 +9,7 @@
 #include "MachineForTarget.hpp"
 
 #include <algorithm>
+#include <mutex>
 
 // Sources for runtime options and machines.
 #include "../Amiga/Amiga.hpp"
@@ -92,6 +93,33 @@ Machine::DynamicMachine *Machine::MachineForTarget(const Analyser::Static::Targe
 	return machine;
 }
 
+Machine::DynamicMachine *Machine::Clone(DynamicMachine &machine, const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
+	const auto state_producer = machine.state_producer();
+	auto state = state_producer ? state_producer->get_state() : nullptr;
+	if(!state) {
+		error = Error::StateUnavailable;
+		return nullptr;
+	}
+
+	// Obtain a fresh target for the same machine and copy across all declared options via serialisation.
+	auto targets = TargetsByMachineName(false);
+	const auto fresh_target = targets.find(LongNameForTargetMachine(target.machine));
+	if(fresh_target == targets.end()) {
+		error = Error::UnknownMachine;
+		return nullptr;
+	}
+	const auto source_options = dynamic_cast<const Reflection::Struct *>(&target);
+	const auto target_options = dynamic_cast<Reflection::Struct *>(fresh_target->second.get());
+	if(source_options && target_options) {
+		target_options->deserialise(source_options->serialise());
+	}
+
+	Analyser::Static::Target &clone_target = *fresh_target->second;
+	clone_target.media = Analyser::Static::Fork(target.media);
+	clone_target.state = std::move(state);
+	return MachineForTarget(&clone_target, rom_fetcher, error);
+}
+
 Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::TargetList &targets, const ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
 	// Zero targets implies no machine.
 	if(targets.empty()) {
@@ -101,15 +129,34 @@ Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::Targ
 
 	// If there's more than one target, get all the machines and combine them into a multimachine.
 	if(targets.size() > 1) {
+		// Construct all machines simultaneously, but fetch ROMs for only one at a time as
+		// fetchers needn't be thread safe.
+		std::mutex fetcher_mutex;
+		const ROMMachine::ROMFetcher serial_fetcher = [&fetcher_mutex, &rom_fetcher](const ROM::Request &request) {
+			std::lock_guard lock(fetcher_mutex);
+			return rom_fetcher(request);
+		};
+
+		std::vector<Error> errors(targets.size(), Error::None);
+		std::vector<std::future<Machine::DynamicMachine *>> constructions;
+		for(size_t c = 0; c < targets.size(); ++c) {
+			constructions.push_back(std::async(std::launch::async, [&targets, &serial_fetcher, &errors, c] {
+				return MachineForTarget(targets[c].get(), serial_fetcher, errors[c]);
+			}));
+		}
+
 		std::vector<std::unique_ptr<Machine::DynamicMachine>> machines;
-		for(const auto &target: targets) {
-			machines.emplace_back(MachineForTarget(target.get(), rom_fetcher, error));
+		for(auto &construction: constructions) {
+			machines.emplace_back(construction.get());
+		}
 
-			// Exit early if any errors have occurred.
-			if(error != Error::None) {
-				return nullptr;
-			}
+		// Fail if any errors occurred.
+		const auto failure = std::find_if(errors.begin(), errors.end(), [](Error error) { return error != Error::None; });
+		if(failure != errors.end()) {
+			error = *failure;
+			return nullptr;
 		}
+		error = Error::None;
 
 		// If a multimachine would just instantly collapse the list to a single machine, do
 		// so without the ongoing baggage of a multimachine.
@@ -124,6 +171,12 @@ Machine::DynamicMachine *Machine::MachineForTargets(const Analyser::Static::Targ
 	return MachineForTarget(targets.front().get(), rom_fetcher, error);
 }
 
+std::future<Machine::DynamicMachine *> Machine::MachineForTargetsAsync(const Analyser::Static::TargetList &targets, const ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
+	return std::async(std::launch::async, [&targets, &rom_fetcher, &error] {
+		return MachineForTargets(targets, rom_fetcher, error);
+	});
+}
+
 std::string Machine::ShortNameForTargetMachine(const Analyser::Machine machine) {
 	switch(machine) {
 		case Analyser::Machine::Amiga:			return "Amiga";
@@ -208,6 +261,7 @@ std::map<std::string, std::unique_ptr<Reflection::Struct>> Machine::AllOptionsBy
 #define Emplace(machine, class)	\
 	options.emplace(std::make_pair(LongNameForTargetMachine(Analyser::Machine::machine), std::make_unique<class::Options>(Configurable::OptionsType::UserFriendly)));
 
+	Emplace(Amiga, Amiga::Machine);
 	Emplace(AmstradCPC, AmstradCPC::Machine);
 	Emplace(AppleII, Apple::II::Machine);
 	Emplace(AtariST, Atari::ST::Machine);
@@ -15,6 +15,7 @@
 #include "../DynamicMachine.hpp"
 #include "../ROMMachine.hpp"
 
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -37,7 +38,8 @@ enum class Error {
 	UnknownError,
 	UnknownMachine,
 	MissingROM,
-	NoTargets
+	NoTargets,
+	StateUnavailable
 };
 
 /*!
@@ -47,12 +49,37 @@ enum class Error {
 */
 DynamicMachine *MachineForTargets(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error);
 
+/*!
+	Performs @c MachineForTargets on another thread, so that the caller can continue with any other
+	preparation while ROMs are fetched and the machine is constructed. @c error is set before the
+	result becomes available.
+
+	@c targets, @c rom_fetcher and @c error must remain valid until then; @c rom_fetcher will be called
+	on a thread other than the caller's.
+*/
+std::future<DynamicMachine *> MachineForTargetsAsync(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error);
+
 /*!
 	Allocates an instance of DynamicMaachine holding the machine described
 	by @c target. It is the caller's responsibility to delete the class when finished.
 */
 DynamicMachine *MachineForTarget(const Analyser::Static::Target *target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error);
 
+/*!
+	Allocates an independent copy of @c machine, which must have been created from @c target, in its current state —
+	so e.g. a machine that has already booted can be duplicated any number of times without repeating that work.
+
+	The copy is created from a fresh target with the same declared options as @c target, the current
+	state of @c machine and @c Analyser::Static::Fork of the media in @c target. So the copy's disks are
+	independent of @c machine's provided that @c machine was itself given copy-on-write media; the copy
+	has no tapes. Any option that is not a declared field of @c target, such as a loading command, is
+	not applied.
+
+	@c machine must not be running during this call. It is the caller's responsibility to delete the result
+	when finished; @c error will be StateUnavailable if @c machine is unable to provide its state.
+*/
+DynamicMachine *Clone(DynamicMachine &machine, const Analyser::Static::Target &target, const ROMMachine::ROMFetcher &rom_fetcher, Machine::Error &error);
+
 /*!
 	Returns a short string name for the machine identified by the target,
 	which is guaranteed not to have any spaces or other potentially
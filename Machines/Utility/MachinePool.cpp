@@ -0,0 +1,44 @@
+//
+//  MachinePool.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "MachinePool.hpp"
+
+#include <atomic>
+
+using namespace Machine;
+
+MachinePool::MachinePool(size_t threads) : pool_(threads) {}
+
+DynamicMachine *MachinePool::add(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error) {
+	Concurrency::WorkStealingPool::AttachmentScope scope(&pool_);
+
+	std::unique_ptr<DynamicMachine> machine(MachineForTargets(targets, rom_fetcher, error));
+	if(!machine) {
+		return nullptr;
+	}
+
+	machines_.push_back(std::move(machine));
+	return machines_.back().get();
+}
+
+void MachinePool::run_for(Time::Seconds duration, int output_flags) {
+	std::atomic<size_t> outstanding = machines_.size();
+
+	for(auto &machine: machines_) {
+		MachineTypes::TimedMachine *const timed_machine = machine->timed_machine();
+		pool_.submit([timed_machine, duration, output_flags, &outstanding] {
+			if(timed_machine) {
+				timed_machine->run_for(duration);
+				timed_machine->flush_output(output_flags);
+			}
+			--outstanding;
+		});
+	}
+
+	pool_.wait_until([&outstanding] { return !outstanding; });
+}
@@ -0,0 +1,68 @@
+//
+//  MachinePool.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MachinePool_hpp
+#define MachinePool_hpp
+
+#include "MachineForTarget.hpp"
+#include "../TimedMachine.hpp"
+#include "../../Concurrency/WorkStealingPool.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Owns a group of machines that are all run on a single WorkStealingPool, e.g. for batch
+	testing of many titles at once.
+
+	Each call to run_for advances every machine by the same amount of emulated time, performing
+	one task per machine on the pool. Any AsyncTaskQueue created by a machine during construction,
+	or subsequently while it runs, performs upon the same pool rather than on a thread of its own,
+	so the total number of threads is fixed regardless of machine count.
+*/
+class MachinePool {
+	public:
+		/// Creates a pool with @c threads workers; if @c threads is 0 then the pool is sized to the host.
+		MachinePool(size_t threads = 0);
+
+		/*!
+			Creates a machine as per Machine::MachineForTargets and adds it to the pool.
+
+			@returns The new machine, which remains owned by the pool, or @c nullptr if construction failed,
+			in which case @c error indicates the cause.
+		*/
+		DynamicMachine *add(const Analyser::Static::TargetList &targets, const ::ROMMachine::ROMFetcher &rom_fetcher, Error &error);
+
+		/// @returns The number of machines currently in the pool.
+		size_t size() const {
+			return machines_.size();
+		}
+
+		/// @returns The machine at @c index.
+		DynamicMachine *machine(size_t index) const {
+			return machines_[index].get();
+		}
+
+		/*!
+			Runs every machine for @c duration, then flushes the output nominated by @c output_flags,
+			blocking until all machines are done.
+		*/
+		void run_for(Time::Seconds duration, int output_flags = MachineTypes::TimedMachine::Output::All);
+
+	private:
+		// The pool is declared first so that it outlives all machines,
+		// whose queues may depend upon it.
+		Concurrency::WorkStealingPool pool_;
+		std::vector<std::unique_ptr<DynamicMachine>> machines_;
+};
+
+}
+
+#endif /* MachinePool_hpp */
@@ -8,21 +8,95 @@
 
 #include "MemoryFuzzer.hpp"
 
-#include <cstdlib>
+#include <atomic>
+#include <cstring>
+#include <random>
+
+namespace {
+
+std::atomic<bool> is_seeded = false;
+std::atomic<uint64_t> fuzz_seed = 0;
+
+uint64_t splitmix64(uint64_t &state) {
+	uint64_t result = (state += 0x9e3779b97f4a7c15);
+	result = (result ^ (result >> 30)) * 0xbf58476d1ce4e5b9;
+	result = (result ^ (result >> 27)) * 0x94d049bb133111eb;
+	return result ^ (result >> 31);
+}
+
+constexpr uint64_t rotl(uint64_t value, int shift) {
+	return (value << shift) | (value >> (64 - shift));
+}
+
+/// Four independent xoshiro256** generators, stored by state word rather than by generator so that
+/// each step is a sequence of identical operations on adjacent values, which compilers will vectorise.
+class Generator {
+	public:
+		static constexpr size_t Lanes = 4;
+		static constexpr size_t BlockSize = Lanes * sizeof(uint64_t);
+
+		Generator(uint64_t seed) {
+			for(size_t lane = 0; lane < Lanes; ++lane) {
+				for(size_t word = 0; word < 4; ++word) {
+					state_[word][lane] = splitmix64(seed);
+				}
+			}
+		}
+
+		/// Writes BlockSize bytes to @c target.
+		void next(uint8_t *target) {
+			uint64_t output[Lanes];
+			for(size_t lane = 0; lane < Lanes; ++lane) {
+				output[lane] = rotl(state_[1][lane] * 5, 7) * 9;
+
+				const uint64_t t = state_[1][lane] << 17;
+				state_[2][lane] ^= state_[0][lane];
+				state_[3][lane] ^= state_[1][lane];
+				state_[1][lane] ^= state_[2][lane];
+				state_[0][lane] ^= state_[3][lane];
+				state_[2][lane] ^= t;
+				state_[3][lane] = rotl(state_[3][lane], 45);
+			}
+			memcpy(target, output, BlockSize);
+		}
+
+		void fill(uint8_t *buffer, std::size_t size) {
+			while(size >= BlockSize) {
+				next(buffer);
+				buffer += BlockSize;
+				size -= BlockSize;
+			}
+			if(size) {
+				uint8_t tail[BlockSize];
+				next(tail);
+				memcpy(buffer, tail, size);
+			}
+		}
+
+	private:
+		uint64_t state_[4][Lanes];
+};
+
+}
 
 void Memory::Fuzz(uint8_t *buffer, std::size_t size) {
-	const unsigned int divider = (unsigned(RAND_MAX) + 1) / 256;
-	unsigned int shift = 1, value = 1;
-	while(value < divider) {
-		value <<= 1;
-		++shift;
+	if(is_seeded) {
+		Generator generator(fuzz_seed ^ (uint64_t(size) * 0xd6e8feb86659fd93));
+		generator.fill(buffer, size);
+		return;
 	}
 
-	for(size_t c = 0; c < size; c++) {
-		buffer[c] = uint8_t(std::rand() >> shift);
-	}
+	thread_local Generator generator(
+		(uint64_t(std::random_device()()) << 32) ^ std::random_device()()
+	);
+	generator.fill(buffer, size);
 }
 
 void Memory::Fuzz(uint16_t *buffer, std::size_t size) {
 	Fuzz(reinterpret_cast<uint8_t *>(buffer), size * sizeof(uint16_t));
 }
+
+void Memory::SetFuzzSeed(std::optional<uint64_t> seed) {
+	fuzz_seed = seed.value_or(0);
+	is_seeded = seed.has_value();
+}
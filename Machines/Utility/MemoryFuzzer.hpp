@@ -11,6 +11,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <optional>
 #include <vector>
 
 namespace Memory {
@@ -26,6 +27,13 @@ template <typename T> void Fuzz(T &buffer) {
 	Fuzz(reinterpret_cast<uint8_t *>(buffer.data()), buffer.size() * sizeof(typename T::value_type));
 }
 
+/*!
+	If @c seed has a value then all subsequent fuzzing is deterministic: the bytes produced by each call
+	depend only on the seed and on the size of the buffer, so are reproducible regardless of the order in
+	which, or threads upon which, machines are constructed. Otherwise fuzzing is unpredictable, as by default.
+*/
+void SetFuzzSeed(std::optional<uint64_t> seed);
+
 }
 
 #endif /* MemoryFuzzer_hpp */
@@ -9,15 +9,57 @@
 #include "MemoryPacker.hpp"
 
 #include <cstddef>
+#include <cstring>
 
-void Memory::PackBigEndian16(const std::vector<uint8_t> &source, uint16_t *target) {
-	for(size_t c = 0; c < source.size(); c += 2) {
-		target[c >> 1] = uint16_t(source[c] << 8) | uint16_t(source[c+1]);
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+/// Copies @c size bytes from @c source to @c target, exchanging each pair of bytes on little-endian hosts.
+/// @c source and @c target may be identical, but mustn't otherwise overlap.
+void pack(const uint8_t *source, uint8_t *target, size_t size) {
+	size &= ~size_t(1);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	if(source != target) {
+		memmove(target, source, size);
+	}
+	return;
+#else
+	size_t c = 0;
+
+#if defined(__SSSE3__)
+	const __m128i swap = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+	for(; c + 16 <= size; c += 16) {
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[c]));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(&target[c]), _mm_shuffle_epi8(bytes, swap));
+	}
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+	for(; c + 16 <= size; c += 16) {
+		vst1q_u8(&target[c], vrev16q_u8(vld1q_u8(&source[c])));
+	}
+#endif
+
+	for(; c < size; c += 2) {
+		const uint8_t high = source[c];
+		target[c] = source[c+1];
+		target[c+1] = high;
 	}
+#endif
+}
+
+}
+
+void Memory::PackBigEndian16(const std::vector<uint8_t> &source, uint16_t *target) {
+	pack(source.data(), reinterpret_cast<uint8_t *>(target), source.size());
 }
 
 void Memory::PackBigEndian16(const std::vector<uint8_t> &source, uint8_t *target) {
-	PackBigEndian16(source, reinterpret_cast<uint16_t *>(target));
+	pack(source.data(), target, source.size());
 }
 
 void Memory::PackBigEndian16(const std::vector<uint8_t> &source, std::vector<uint16_t> &target) {
@@ -29,3 +71,11 @@ void Memory::PackBigEndian16(const std::vector<uint8_t> &source, std::vector<uin
 	target.resize(source.size());
 	PackBigEndian16(source, target.data());
 }
+
+void Memory::PackBigEndian16(uint8_t *buffer, size_t size) {
+	pack(buffer, buffer, size);
+}
+
+void Memory::PackBigEndian16(std::vector<uint8_t> &buffer) {
+	pack(buffer.data(), buffer.data(), buffer.size());
+}
@@ -9,6 +9,7 @@
 #ifndef MemoryPacker_hpp
 #define MemoryPacker_hpp
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -42,5 +43,15 @@ void PackBigEndian16(const std::vector<uint8_t> &source, std::vector<uint16_t> &
 */
 void PackBigEndian16(const std::vector<uint8_t> &source, std::vector<uint8_t> &target);
 
+/*!
+	Converts the @c size bytes at @c buffer in place from big-endian 16-bit data to host-endian 16-bit data.
+*/
+void PackBigEndian16(uint8_t *buffer, size_t size);
+
+/*!
+	Converts the contents of @c buffer in place from big-endian 16-bit data to host-endian 16-bit data.
+*/
+void PackBigEndian16(std::vector<uint8_t> &buffer);
+
 }
 #endif /* MemoryPacker_hpp */
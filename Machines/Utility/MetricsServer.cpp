@@ -0,0 +1,153 @@
+//
+//  MetricsServer.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "MetricsServer.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_SOCKETS
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// macOS has no MSG_NOSIGNAL; SIGPIPE is instead suppressed per socket, via SO_NOSIGPIPE.
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+using namespace Machine;
+
+namespace {
+
+/// The longest that the server will wait before noticing that it has been asked to stop, in milliseconds.
+constexpr int poll_period = 100;
+
+}
+
+MetricsServer::MetricsServer(const std::string &address, Source source) : source_(std::move(source)) {
+#ifdef HAS_SOCKETS
+	if(!address.empty() && address[0] == '/') {
+		sockaddr_un name{};
+		if(address.size() >= sizeof(name.sun_path)) throw Error::CantCreate;
+		name.sun_family = AF_UNIX;
+		std::memcpy(name.sun_path, address.c_str(), address.size() + 1);
+
+		socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+		if(socket_ < 0) throw Error::CantCreate;
+
+		// Replace a stale socket left by a previous run, but nothing else.
+		struct stat existing;
+		if(!lstat(address.c_str(), &existing)) {
+			if(!S_ISSOCK(existing.st_mode) || unlink(address.c_str())) {
+				close(socket_);
+				throw Error::CantCreate;
+			}
+		}
+
+		if(bind(socket_, reinterpret_cast<sockaddr *>(&name), sizeof(name))) {
+			close(socket_);
+			throw Error::CantCreate;
+		}
+		socket_path_ = address;
+	} else {
+		char *end;
+		const long port = std::strtol(address.c_str(), &end, 10);
+		if(address.empty() || *end || port <= 0 || port > 65535) throw Error::CantCreate;
+
+		sockaddr_in name{};
+		name.sin_family = AF_INET;
+		name.sin_port = htons(uint16_t(port));
+		name.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		socket_ = socket(AF_INET, SOCK_STREAM, 0);
+		if(socket_ < 0) throw Error::CantCreate;
+
+		const int reuse = 1;
+		setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+		if(bind(socket_, reinterpret_cast<sockaddr *>(&name), sizeof(name))) {
+			close(socket_);
+			throw Error::CantCreate;
+		}
+	}
+
+	if(listen(socket_, 4)) {
+		close(socket_);
+		if(!socket_path_.empty()) unlink(socket_path_.c_str());
+		throw Error::CantCreate;
+	}
+
+	thread_ = std::thread([this] {
+		serve();
+	});
+#else
+	(void)address;
+	throw Error::CantCreate;
+#endif
+}
+
+MetricsServer::~MetricsServer() {
+#ifdef HAS_SOCKETS
+	is_running_ = false;
+	thread_.join();
+	close(socket_);
+	if(!socket_path_.empty()) unlink(socket_path_.c_str());
+#endif
+}
+
+void MetricsServer::serve() {
+#ifdef HAS_SOCKETS
+	while(is_running_) {
+		pollfd listener{socket_, POLLIN, 0};
+		if(poll(&listener, 1, poll_period) <= 0) continue;
+
+		const int connection = accept(socket_, nullptr, nullptr);
+		if(connection < 0) continue;
+#ifdef SO_NOSIGPIPE
+		const int no_sigpipe = 1;
+		setsockopt(connection, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+		// Read until the end of the request headers, giving up on slow or oversized requests.
+		// The request itself is otherwise ignored; all requests receive the same response.
+		std::string request;
+		char buffer[1024];
+		while(request.find("\r\n\r\n") == std::string::npos && request.find("\n\n") == std::string::npos && request.size() < 8192) {
+			pollfd reader{connection, POLLIN, 0};
+			if(poll(&reader, 1, poll_period * 10) <= 0) break;
+
+			const auto length = read(connection, buffer, sizeof(buffer));
+			if(length <= 0) break;
+			request.append(buffer, size_t(length));
+		}
+
+		const std::string body = source_();
+		std::string response =
+			"HTTP/1.0 200 OK\r\n"
+			"Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+			"Content-Length: " + std::to_string(body.size()) + "\r\n"
+			"Connection: close\r\n"
+			"\r\n";
+		response += body;
+
+		size_t written = 0;
+		while(written < response.size()) {
+			const auto length = send(connection, &response[written], response.size() - written, MSG_NOSIGNAL);
+			if(length <= 0) break;
+			written += size_t(length);
+		}
+		close(connection);
+	}
+#endif
+}
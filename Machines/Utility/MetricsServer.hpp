@@ -0,0 +1,60 @@
+//
+//  MetricsServer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MetricsServer_hpp
+#define MetricsServer_hpp
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace Machine {
+
+/*!
+	A minimal HTTP server, on a thread of its own, that answers every request with the text produced by
+	a nominated function — e.g. @c RuntimeMetrics::prometheus_text — for scraping by a monitoring system.
+
+	It listens either on a TCP port of the loopback interface or on a Unix domain socket, and serves one
+	connection at a time; it is intended for occasional polling, not for general use. It is available only
+	on POSIX hosts.
+*/
+class MetricsServer {
+	public:
+		enum class Error {
+			CantCreate
+		};
+
+		using Source = std::function<std::string()>;
+
+		/*!
+			Begins serving the output of @c source, which will be called on the server's thread.
+
+			@param address Either a port number, to listen on 127.0.0.1, or the path of a Unix domain socket,
+				which must begin with a slash. An existing socket at that path will be replaced; any other file will not.
+			@throws Error::CantCreate if the socket could not be created.
+		*/
+		MetricsServer(const std::string &address, Source source);
+
+		/// Stops serving, and removes any Unix domain socket.
+		~MetricsServer();
+
+	private:
+		const Source source_;
+		std::string socket_path_;
+		int socket_ = -1;
+
+		std::atomic<bool> is_running_ = true;
+		std::thread thread_;
+
+		void serve();
+};
+
+}
+
+#endif /* MetricsServer_hpp */
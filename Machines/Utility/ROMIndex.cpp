@@ -0,0 +1,311 @@
+//
+//  ROMIndex.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ROMIndex.hpp"
+
+#include "../../Numeric/CRC.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace ROM;
+
+/*
+	Index files are laid out as follows, with all fields being little endian:
+
+		8 bytes:	"CLKROMS1"
+		4 bytes:	number of files
+
+		per file:
+			4 bytes:	length of the file's path
+			the file's path
+			8 bytes:	size of the file
+			8 bytes:	modification time of the file, in seconds
+			4 bytes:	CRC32 of the file's contents, or 0 if its size doesn't match that of any known ROM
+*/
+
+namespace {
+
+constexpr char Signature[] = "CLKROMS1";
+constexpr size_t SignatureLength = sizeof(Signature) - 1;
+
+void put32(std::vector<uint8_t> &destination, uint32_t value) {
+	destination.push_back(uint8_t(value));
+	destination.push_back(uint8_t(value >> 8));
+	destination.push_back(uint8_t(value >> 16));
+	destination.push_back(uint8_t(value >> 24));
+}
+
+void put64(std::vector<uint8_t> &destination, uint64_t value) {
+	put32(destination, uint32_t(value));
+	put32(destination, uint32_t(value >> 32));
+}
+
+/// Reads sequential fields from an index file, noting any attempt to read beyond its end.
+struct Reader {
+	const std::vector<uint8_t> &data;
+	size_t offset = 0;
+	bool overran = false;
+
+	uint32_t get32() {
+		if(data.size() - offset < 4) {
+			overran = true;
+			return 0;
+		}
+		const uint8_t *const source = &data[offset];
+		offset += 4;
+		return uint32_t(source[0]) | (uint32_t(source[1]) << 8) | (uint32_t(source[2]) << 16) | (uint32_t(source[3]) << 24);
+	}
+
+	uint64_t get64() {
+		const uint64_t low = get32();
+		return low | (uint64_t(get32()) << 32);
+	}
+
+	std::string get_string(size_t length) {
+		if(data.size() - offset < length) {
+			overran = true;
+			return {};
+		}
+		offset += length;
+		return std::string(data.begin() + long(offset - length), data.begin() + long(offset));
+	}
+};
+
+/// @returns The complete contents of @c file_name, or an empty vector if it can't be read.
+std::vector<uint8_t> contents(const std::string &file_name) {
+	std::vector<uint8_t> data;
+	FILE *const file = fopen(file_name.c_str(), "rb");
+	if(!file) return data;
+
+	uint8_t buffer[65536];
+	size_t length;
+	while((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		data.insert(data.end(), buffer, buffer + length);
+	}
+	fclose(file);
+	return data;
+}
+
+/// @returns The sizes of all known ROMs.
+const std::set<size_t> &rom_sizes() {
+	static const std::set<size_t> sizes = [] {
+		std::set<size_t> sizes;
+		for(const auto &description: ROM::all_descriptions()) {
+			sizes.insert(description.size);
+		}
+		return sizes;
+	}();
+	return sizes;
+}
+
+/// Images that have been read during this run, shared by all indices.
+struct Image {
+	uint64_t size;
+	int64_t modification_time;
+	std::shared_ptr<const std::vector<uint8_t>> data;
+};
+std::mutex images_mutex;
+std::map<std::string, Image> images;
+
+/// @returns The contents of @c file_name, which is expected to have the supplied size and modification time;
+///		@c nullptr if it can't be read or doesn't match that description.
+std::shared_ptr<const std::vector<uint8_t>> image(const std::string &file_name, uint64_t size, int64_t modification_time) {
+	std::lock_guard lock(images_mutex);
+
+	const auto existing = images.find(file_name);
+	if(existing != images.end() && existing->second.size == size && existing->second.modification_time == modification_time) {
+		return existing->second.data;
+	}
+
+	auto data = std::make_shared<const std::vector<uint8_t>>(contents(file_name));
+	if(data->size() != size) return nullptr;
+
+	images[file_name] = Image{size, modification_time, data};
+	return data;
+}
+
+}
+
+std::string Index::cache_directory_;
+
+void Index::set_cache_directory(const std::string &directory) {
+	cache_directory_ = directory;
+}
+
+Index::Index(const std::vector<std::string> &paths) : paths_(paths) {}
+
+std::string Index::index_file_name() const {
+	if(cache_directory_.empty()) return {};
+	return cache_directory_ + "/roms.index";
+}
+
+bool Index::load() {
+	const std::string file_name = index_file_name();
+	if(file_name.empty()) return false;
+
+	const auto data = contents(file_name);
+	if(data.size() < SignatureLength || memcmp(data.data(), Signature, SignatureLength)) return false;
+
+	Reader reader{data, SignatureLength};
+	std::map<std::string, Entry> entries;
+	const uint32_t count = reader.get32();
+	for(uint32_t c = 0; c < count && !reader.overran; ++c) {
+		const std::string path = reader.get_string(reader.get32());
+
+		Entry entry;
+		entry.size = reader.get64();
+		entry.modification_time = int64_t(reader.get64());
+		entry.crc32 = reader.get32();
+		entries.emplace(path, entry);
+	}
+	if(reader.overran) return false;
+
+	entries_ = std::move(entries);
+	return true;
+}
+
+void Index::store() const {
+	const std::string file_name = index_file_name();
+	if(file_name.empty()) return;
+
+	std::vector<uint8_t> file(Signature, Signature + SignatureLength);
+	put32(file, uint32_t(entries_.size()));
+	for(const auto &entry: entries_) {
+		put32(file, uint32_t(entry.first.size()));
+		file.insert(file.end(), entry.first.begin(), entry.first.end());
+		put64(file, entry.second.size);
+		put64(file, uint64_t(entry.second.modification_time));
+		put32(file, entry.second.crc32);
+	}
+
+	// Write to a temporary and then rename, so that a concurrent reader never sees a partial file.
+	const std::string temporary_name = file_name + ".tmp";
+	FILE *const output = fopen(temporary_name.c_str(), "wb");
+	if(output) {
+		const bool did_write = fwrite(file.data(), 1, file.size(), output) == file.size();
+		fclose(output);
+
+		if(!did_write || rename(temporary_name.c_str(), file_name.c_str())) {
+			remove(temporary_name.c_str());
+		}
+	}
+}
+
+void Index::rescan() {
+	if(!is_loaded_) {
+		load();
+		is_loaded_ = true;
+	}
+
+	std::map<std::string, Entry> entries;
+	bool did_change = false;
+	for(const auto &path: paths_) {
+		DIR *const machines = opendir(path.c_str());
+		if(!machines) continue;
+
+		while(const dirent *const machine = readdir(machines)) {
+			if(machine->d_name[0] == '.') continue;
+
+			const std::string machine_path = path + machine->d_name + "/";
+			DIR *const files = opendir(machine_path.c_str());
+			if(!files) continue;
+
+			while(const dirent *const file = readdir(files)) {
+				if(file->d_name[0] == '.') continue;
+
+				const std::string file_path = machine_path + file->d_name;
+				struct stat file_stats;
+				if(stat(file_path.c_str(), &file_stats) || !S_ISREG(file_stats.st_mode)) continue;
+
+				Entry entry;
+				entry.size = uint64_t(file_stats.st_size);
+				entry.modification_time = int64_t(file_stats.st_mtime);
+
+				// Reuse the existing CRC if this file is unchanged; otherwise calculate one if the
+				// file could be a ROM.
+				const auto existing = entries_.find(file_path);
+				if(
+					existing != entries_.end() &&
+					existing->second.size == entry.size &&
+					existing->second.modification_time == entry.modification_time
+				) {
+					entry.crc32 = existing->second.crc32;
+				} else {
+					did_change = true;
+					if(rom_sizes().count(size_t(entry.size))) {
+						const auto data = contents(file_path);
+						if(data.size() != entry.size) continue;
+						entry.crc32 = CRC::CRC32().compute_crc(data);
+					}
+				}
+
+				entries.emplace(file_path, entry);
+			}
+			closedir(files);
+		}
+		closedir(machines);
+	}
+
+	did_change |= entries.size() != entries_.size();
+	entries_ = std::move(entries);
+	if(did_change) store();
+}
+
+Map Index::find(const Request &request) {
+	rescan();
+	checked_paths_.clear();
+
+	Map results;
+	for(const auto &description: request.all_descriptions()) {
+		std::shared_ptr<const std::vector<uint8_t>> data;
+
+		// Prefer a file with one of the expected names.
+		std::vector<std::string> checked_paths;
+		for(const auto &file_name: description.file_names) {
+			for(const auto &path: paths_) {
+				const std::string file_path = path + description.machine_name + "/" + file_name;
+				checked_paths.push_back(file_path);
+
+				const auto entry = entries_.find(file_path);
+				if(entry != entries_.end()) {
+					data = image(file_path, entry->second.size, entry->second.modification_time);
+					if(data) break;
+				}
+			}
+			if(data) break;
+		}
+
+		// Otherwise look for any file with matching contents.
+		if(!data && !description.crc32s.empty()) {
+			for(const auto &entry: entries_) {
+				if(
+					entry.second.size != description.size ||
+					description.crc32s.find(entry.second.crc32) == description.crc32s.end()
+				) continue;
+
+				data = image(entry.first, entry.second.size, entry.second.modification_time);
+				if(data) break;
+			}
+		}
+
+		if(data) {
+			results[description.name] = *data;
+		} else {
+			std::copy(checked_paths.begin(), checked_paths.end(), std::back_inserter(checked_paths_));
+		}
+	}
+
+	return results;
+}
@@ -0,0 +1,76 @@
+//
+//  ROMIndex.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ROMIndex_hpp
+#define ROMIndex_hpp
+
+#include "ROMCatalogue.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ROM {
+
+/*!
+	Indexes the files within a set of ROM directories, each laid out as [path]/[machine name]/[file name],
+	so that ROMs can be located either by name or, failing that, by size and CRC anywhere within those
+	directories.
+
+	The size, modification time and CRC32 of each file are retained in an index file if a host has nominated
+	a directory via @c set_cache_directory. Each scan therefore rereads only those files that are new or that
+	have changed since they were last indexed.
+
+	Images are read from disk at most once per process, unless they subsequently change, and are then
+	shared by all indices.
+*/
+class Index {
+	public:
+		/// Nominates the directory in which the index should be stored; if empty, the index isn't retained between runs.
+		static void set_cache_directory(const std::string &directory);
+
+		/// Creates an index of @c paths, each of which should end in a path separator.
+		Index(const std::vector<std::string> &paths);
+
+		/// Brings the index up to date with the current contents of its directories, and stores it if anything has changed.
+		void rescan();
+
+		/*!
+			Rescans and then attempts to locate every ROM that @c request might use.
+
+			@returns All ROMs that were found.
+		*/
+		Map find(const Request &request);
+
+		/// @returns The locations at which ROMs were sought but not found during the most recent call to @c find.
+		const std::vector<std::string> &checked_paths() const {
+			return checked_paths_;
+		}
+
+	private:
+		static std::string cache_directory_;
+
+		struct Entry {
+			uint64_t size = 0;
+			int64_t modification_time = 0;
+			uint32_t crc32 = 0;
+		};
+		std::vector<std::string> paths_;
+		std::map<std::string, Entry> entries_;
+		std::vector<std::string> checked_paths_;
+		bool is_loaded_ = false;
+
+		bool load();
+		void store() const;
+		std::string index_file_name() const;
+};
+
+}
+
+#endif /* ROMIndex_hpp */
@@ -0,0 +1,59 @@
+//
+//  Rewinder.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Rewinder.hpp"
+
+using namespace Machine;
+
+Rewinder::Rewinder(MachineTypes::StateProducer &producer, size_t memory_budget) :
+	producer_(producer), memory_budget_(memory_budget) {}
+
+void Rewinder::capture() {
+	auto state = producer_.get_state();
+	if(!state) return;
+
+	scratch_.clear();
+	state->snapshot(scratch_);
+
+	// Record how to get from the new state back to the previous.
+	if(state_) {
+		deltas_.push_back(Reflection::snapshot_delta(scratch_, latest_));
+		delta_memory_ += deltas_.back().size();
+	}
+	std::swap(latest_, scratch_);
+	state_ = std::move(state);
+
+	// Discard the oldest history until within budget.
+	while(!deltas_.empty() && memory_used() > memory_budget_) {
+		delta_memory_ -= deltas_.front().size();
+		deltas_.pop_front();
+	}
+}
+
+bool Rewinder::rewind() {
+	if(deltas_.empty()) return false;
+
+	const bool applied = Reflection::apply_snapshot_delta(latest_, deltas_.back());
+	delta_memory_ -= deltas_.back().size();
+	deltas_.pop_back();
+
+	if(!applied || !state_->restore(latest_)) {
+		clear();
+		return false;
+	}
+
+	producer_.set_state(*state_);
+	return true;
+}
+
+void Rewinder::clear() {
+	state_.reset();
+	latest_.clear();
+	deltas_.clear();
+	delta_memory_ = 0;
+}
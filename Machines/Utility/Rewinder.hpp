@@ -0,0 +1,74 @@
+//
+//  Rewinder.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Rewinder_hpp
+#define Rewinder_hpp
+
+#include "../StateProducer.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Keeps a history of the states of a machine, captured whenever @c capture is called,
+	so that the machine can subsequently be stepped backwards through them.
+
+	The most recent capture is kept as a complete snapshot; each earlier capture is kept only
+	as a delta against its successor. So stepping back costs a single delta application, and a
+	bounded memory budget is maintained by discarding the oldest deltas.
+
+	Callers are responsible for thread safety; the machine must not be running during calls to
+	@c capture or @c rewind.
+*/
+class Rewinder {
+	public:
+		/// Creates a rewinder for @c producer that will use no more than approximately @c memory_budget bytes.
+		Rewinder(MachineTypes::StateProducer &producer, size_t memory_budget);
+
+		/// Captures the machine's current state, discarding old history if necessary.
+		void capture();
+
+		/// Returns the machine to the state captured prior to the most recent, and discards the most recent.
+		/// @returns @c true if the machine was rewound; @c false if there was no earlier state.
+		bool rewind();
+
+		/// Discards all history.
+		void clear();
+
+		/// @returns The number of states that the machine can currently be rewound by.
+		size_t size() const {
+			return deltas_.size();
+		}
+
+		/// @returns The number of bytes currently used for history.
+		size_t memory_used() const {
+			return latest_.size() + delta_memory_;
+		}
+
+	private:
+		MachineTypes::StateProducer &producer_;
+		const size_t memory_budget_;
+
+		// The most recent state, both as a struct of the producer's type and as a snapshot.
+		std::unique_ptr<Reflection::Struct> state_;
+		std::vector<uint8_t> latest_;
+
+		// Deltas from each state to the one before it, oldest first.
+		std::deque<std::vector<uint8_t>> deltas_;
+		size_t delta_memory_ = 0;
+
+		std::vector<uint8_t> scratch_;
+};
+
+}
+
+#endif /* Rewinder_hpp */
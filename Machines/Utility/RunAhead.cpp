@@ -0,0 +1,169 @@
+//
+//  RunAhead.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "RunAhead.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace Machine;
+
+RunAhead::RunAhead(DynamicMachine &machine, Outputs::Display::ScanTarget *scan_target, Outputs::Speaker::Speaker::Delegate *audio_delegate, float audio_output_rate, bool audio_is_stereo) :
+	machine_(machine), producer_(*machine.state_producer()) {
+	video_gate_.target = scan_target;
+	machine_.scan_producer()->set_scan_target(&video_gate_);
+
+	const auto audio_producer = machine_.audio_producer();
+	speaker_ = audio_producer ? audio_producer->get_speaker() : nullptr;
+	if(speaker_ && audio_delegate) {
+		audio_gate_.delegate = audio_delegate;
+		audio_gate_.output_rate = audio_output_rate;
+		audio_gate_.channels = audio_is_stereo ? 2 : 1;
+		speaker_->set_delegate(&audio_gate_);
+	}
+}
+
+RunAhead::~RunAhead() {
+	machine_.scan_producer()->set_scan_target(video_gate_.target);
+	if(speaker_ && audio_gate_.delegate) {
+		speaker_->set_delegate(audio_gate_.delegate);
+	}
+}
+
+void RunAhead::run_for(Time::Seconds duration) {
+	audio_gate_.schedule(duration, true);
+	machine_.timed_machine()->run_for(duration);
+}
+
+void RunAhead::present() {
+	const auto timed_machine = machine_.timed_machine();
+	timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+
+	if(!frames_) {
+		return;
+	}
+
+	// Capture the true timeline.
+	auto state = producer_.get_state();
+	if(!state) return;
+	snapshot_.clear();
+	state->snapshot(snapshot_);
+
+	// Run ahead, with video enabled only for the final frame.
+	const Time::Seconds frame_duration = machine_.scan_producer()->get_scan_status().field_duration;
+	const Time::Seconds ahead_duration = frame_duration * frames_;
+	audio_gate_.schedule(ahead_duration, false);
+
+	if(frames_ > 1) {
+		timed_machine->run_for(ahead_duration - frame_duration);
+	}
+	video_gate_.is_enabled = true;
+	timed_machine->run_for(frame_duration);
+	timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+	video_gate_.is_enabled = false;
+
+	// Return to the true timeline.
+	if(state->restore(snapshot_)) {
+		producer_.set_state(*state);
+	}
+}
+
+// MARK: - VideoGate.
+
+void RunAhead::VideoGate::set_modals(Modals modals) {
+	target->set_modals(modals);
+}
+
+void RunAhead::VideoGate::set_palette(const uint32_t *palette, size_t length) {
+	target->set_palette(palette, length);
+}
+
+Outputs::Display::ScanTarget::Scan *RunAhead::VideoGate::begin_scan() {
+	return is_forwarding_ ? target->begin_scan() : &scan_;
+}
+
+void RunAhead::VideoGate::end_scan() {
+	if(is_forwarding_) target->end_scan();
+}
+
+uint8_t *RunAhead::VideoGate::begin_data(size_t required_length, size_t required_alignment) {
+	// Frames that won't be shown get no storage, so that the machine can skip pixel generation entirely.
+	is_forwarding_ = is_enabled;
+	return is_forwarding_ ? target->begin_data(required_length, required_alignment) : nullptr;
+}
+
+void RunAhead::VideoGate::end_data(size_t actual_length) {
+	if(is_forwarding_) target->end_data(actual_length);
+}
+
+bool RunAhead::VideoGate::is_discarding_data() const {
+	return !is_enabled || target->is_discarding_data();
+}
+
+void RunAhead::VideoGate::will_change_owner() {
+	target->will_change_owner();
+}
+
+void RunAhead::VideoGate::submit() {
+	if(is_forwarding_) target->submit();
+}
+
+void RunAhead::VideoGate::announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) {
+	if(is_forwarding_) target->announce(event, is_visible, location, composite_amplitude);
+}
+
+// MARK: - AudioGate.
+
+void RunAhead::AudioGate::schedule(Time::Seconds duration, bool pass) {
+	std::lock_guard lock(mutex_);
+	const double samples = duration * double(output_rate);
+
+	if(!schedule_.empty() && schedule_.back().pass == pass) {
+		schedule_.back().samples += samples;
+	} else {
+		schedule_.push_back({samples, pass});
+	}
+}
+
+void RunAhead::AudioGate::speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) {
+	output_.clear();
+
+	{
+		std::lock_guard lock(mutex_);
+
+		size_t cursor = 0;
+		while(cursor < buffer.size()) {
+			// Audio beyond the end of the schedule must be from the true timeline.
+			if(schedule_.empty()) {
+				std::copy(buffer.begin() + ptrdiff_t(cursor), buffer.end(), std::back_inserter(output_));
+				break;
+			}
+
+			// Periods are measured in sample frames, which are split across channels.
+			auto &period = schedule_.front();
+			const size_t length = std::min(buffer.size() - cursor, size_t(std::max(period.samples, 1.0)) * channels);
+			if(period.pass) {
+				std::copy(buffer.begin() + ptrdiff_t(cursor), buffer.begin() + ptrdiff_t(cursor + length), std::back_inserter(output_));
+			}
+
+			cursor += length;
+			period.samples -= double(length / channels);
+			if(period.samples < 1.0) {
+				schedule_.pop_front();
+			}
+		}
+	}
+
+	if(!output_.empty()) {
+		delegate->speaker_did_complete_samples(speaker, output_);
+	}
+}
+
+void RunAhead::AudioGate::speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) {
+	delegate->speaker_did_change_input_clock(speaker);
+}
@@ -0,0 +1,117 @@
+//
+//  RunAhead.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RunAhead_hpp
+#define RunAhead_hpp
+
+#include "../DynamicMachine.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Outputs/ScanTarget.hpp"
+#include "../../Outputs/Speaker/Speaker.hpp"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Implements run-ahead, reducing perceived input latency.
+
+	The machine is installed with a scan target and speaker delegate provided by this class, which
+	forward to those supplied. Time spent in @c run_for is then the true timeline and produces audio
+	but no video. Each call to @c present captures the machine's state, runs it a number of frames
+	further ahead with video enabled and audio suppressed, and then restores the captured state.
+
+	So what's displayed is the outcome of current input a few frames hence, which is a substitute
+	for lower latency if, as is common, the running software does not act upon input until the
+	frame after receiving it.
+
+	Components that are not included in a machine's state, such as the CRT, are not restored.
+*/
+class RunAhead {
+	public:
+		/*!
+			Creates a RunAhead for @c machine, which must offer a StateProducer.
+
+			@param scan_target The target for video output.
+			@param audio_delegate The delegate for audio output, if any.
+			@param audio_output_rate The rate, in samples per second, at which the speaker has been asked to output.
+			@param audio_is_stereo Indicates whether the speaker has been asked for stereo output.
+		*/
+		RunAhead(DynamicMachine &machine, Outputs::Display::ScanTarget *scan_target, Outputs::Speaker::Speaker::Delegate *audio_delegate, float audio_output_rate, bool audio_is_stereo);
+		~RunAhead();
+
+		/// Sets the number of frames by which to run ahead; 0 disables run-ahead.
+		void set_frames(int frames) {
+			frames_ = frames;
+		}
+
+		/// Runs the machine for @c duration along its true timeline.
+		void run_for(Time::Seconds duration);
+
+		/// Runs ahead, presenting the final frame, and then returns the machine to its current state.
+		void present();
+
+	private:
+		DynamicMachine &machine_;
+		MachineTypes::StateProducer &producer_;
+		int frames_ = 1;
+		std::vector<uint8_t> snapshot_;
+
+		/// Forwards to another scan target only while enabled; changes in enablement
+		/// take effect at the next piece of data, so that scans and data don't mismatch.
+		struct VideoGate: public Outputs::Display::ScanTarget {
+			Outputs::Display::ScanTarget *target;
+			bool is_enabled = false;
+
+			void set_modals(Modals) final;
+			void set_palette(const uint32_t *palette, size_t length) final;
+			Scan *begin_scan() final;
+			void end_scan() final;
+			uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+			void end_data(size_t actual_length) final;
+			bool is_discarding_data() const final;
+			void will_change_owner() final;
+			void submit() final;
+			void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final;
+
+			private:
+				bool is_forwarding_ = false;
+				Scan scan_;
+		} video_gate_;
+
+		/// Forwards audio to another delegate according to a schedule of periods to pass or to drop.
+		/// Audio arrives asynchronously but in order, so this is sample-accurate regardless of thread timing.
+		struct AudioGate: public Outputs::Speaker::Speaker::Delegate {
+			Outputs::Speaker::Speaker::Delegate *delegate = nullptr;
+			float output_rate = 0.0f;
+			size_t channels = 1;
+
+			/// Appends a period of @c duration in which audio should be passed if @c pass is @c true; dropped otherwise.
+			void schedule(Time::Seconds duration, bool pass);
+
+			void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final;
+			void speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) final;
+
+			private:
+				struct Period {
+					double samples;
+					bool pass;
+				};
+				std::mutex mutex_;
+				std::deque<Period> schedule_;
+				std::vector<int16_t> output_;
+		} audio_gate_;
+		Outputs::Speaker::Speaker *speaker_ = nullptr;
+};
+
+}
+
+#endif /* RunAhead_hpp */
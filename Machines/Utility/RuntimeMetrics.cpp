@@ -0,0 +1,158 @@
+//
+//  RuntimeMetrics.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "RuntimeMetrics.hpp"
+
+#include "../../Storage/Disk/Track/FluxCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace Machine;
+
+namespace {
+
+template <typename T> void add(std::atomic<T> &target, T value) {
+	T current = target.load(std::memory_order_relaxed);
+	while(!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed));
+}
+
+}
+
+void RuntimeMetrics::did_run(Time::Seconds emulated_duration, Time::Nanos interval, Time::Nanos run_time) {
+	add(emulated_seconds_, emulated_duration);
+	const Time::Nanos prior_wall_nanos = wall_nanos_.fetch_add(interval, std::memory_order_relaxed);
+
+	// Smooth the speed ratio with a time constant of about a second, weighting each sample by its interval;
+	// the first sample is taken as-is.
+	if(interval > 0) {
+		const double ratio = emulated_duration * 1e9 / double(interval);
+		const double weight = prior_wall_nanos ? 1.0 - std::exp(-double(interval) / 1e9) : 1.0;
+		const double previous = speed_ratio_.load(std::memory_order_relaxed);
+		speed_ratio_.store(previous + (ratio - previous) * weight, std::memory_order_relaxed);
+	}
+
+	const auto bucket = std::lower_bound(run_time_buckets.begin(), run_time_buckets.end(), run_time) - run_time_buckets.begin();
+	run_time_counts_[size_t(bucket)].fetch_add(1, std::memory_order_relaxed);
+	add(run_time_sum_, run_time);
+}
+
+void RuntimeMetrics::did_underrun_audio() {
+	audio_underruns_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::did_overrun_audio() {
+	audio_overruns_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RuntimeMetrics::set_display_metrics(const Outputs::Display::Metrics *metrics) {
+	display_metrics_ = metrics;
+}
+
+RuntimeMetrics::Snapshot RuntimeMetrics::snapshot() const {
+	Snapshot result;
+
+	result.speed_ratio = speed_ratio_.load(std::memory_order_relaxed);
+	result.emulated_seconds = emulated_seconds_.load(std::memory_order_relaxed);
+	result.wall_seconds = double(wall_nanos_.load(std::memory_order_relaxed)) / 1e9;
+
+	if(const auto display_metrics = display_metrics_.load()) {
+		result.frames_produced = display_metrics->total_frames_produced();
+		result.frames_drawn = display_metrics->total_frames_drawn();
+		result.frames_missed = display_metrics->total_frames_missed();
+	}
+
+	result.audio_underruns = audio_underruns_.load(std::memory_order_relaxed);
+	result.audio_overruns = audio_overruns_.load(std::memory_order_relaxed);
+
+	uint64_t total = 0;
+	for(size_t c = 0; c < run_time_counts_.size(); c++) {
+		total += run_time_counts_[c].load(std::memory_order_relaxed);
+		result.run_time_counts[c] = total;
+	}
+	result.run_time_count = total;
+	result.run_time_sum_seconds = double(run_time_sum_.load(std::memory_order_relaxed)) / 1e9;
+
+	result.track_cache_hits = Storage::Disk::FluxCache::total_hits();
+	result.track_cache_misses = Storage::Disk::FluxCache::total_misses();
+
+	return result;
+}
+
+std::string RuntimeMetrics::prometheus_text(const std::string &instance) const {
+	const Snapshot metrics = snapshot();
+	std::string result;
+
+	// Label values may contain any character other than a backslash, double quote or newline unescaped.
+	std::string label = "instance=\"";
+	for(const char c: instance) {
+		switch(c) {
+			case '\\':	label += "\\\\";	break;
+			case '"':	label += "\\\"";	break;
+			case '\n':	label += "\\n";		break;
+			default:	label += c;			break;
+		}
+	}
+	label += '"';
+
+	char buffer[64];
+	const auto put = [&] (const char *name, const char *extra_label, double value) {
+		result += name;
+		result += '{';
+		result += label;
+		if(extra_label) {
+			result += ',';
+			result += extra_label;
+		}
+		result += "} ";
+		std::snprintf(buffer, sizeof(buffer), "%.17g\n", value);
+		result += buffer;
+	};
+	const auto describe = [&] (const char *name, const char *type, const char *help) {
+		result += "# HELP ";
+		result += name;
+		result += ' ';
+		result += help;
+		result += "\n# TYPE ";
+		result += name;
+		result += ' ';
+		result += type;
+		result += '\n';
+	};
+	const auto single = [&] (const char *name, const char *type, const char *help, double value) {
+		describe(name, type, help);
+		put(name, nullptr, value);
+	};
+
+	single("clk_speed_ratio", "gauge", "Emulated time per unit of wall-clock time, smoothed over about a second.", metrics.speed_ratio);
+	single("clk_emulated_seconds_total", "counter", "Total emulated time.", metrics.emulated_seconds);
+	single("clk_wall_seconds_total", "counter", "Total wall-clock time over which the machine has been run.", metrics.wall_seconds);
+
+	single("clk_frames_produced_total", "counter", "Frames begun by the emulated machine.", double(metrics.frames_produced));
+	single("clk_frames_drawn_total", "counter", "Frames completely output by the host.", double(metrics.frames_drawn));
+	single("clk_frames_missed_total", "counter", "Frames incompletely output by the host.", double(metrics.frames_missed));
+
+	single("clk_audio_underruns_total", "counter", "Host audio callbacks that found insufficient audio.", double(metrics.audio_underruns));
+	single("clk_audio_overruns_total", "counter", "Occasions on which buffered audio was discarded.", double(metrics.audio_overruns));
+
+	describe("clk_run_for_seconds", "histogram", "Wall-clock time spent in each call to run the machine.");
+	for(size_t c = 0; c < run_time_buckets.size(); c++) {
+		char bucket[32];
+		std::snprintf(bucket, sizeof(bucket), "le=\"%g\"", double(run_time_buckets[c]) / 1e9);
+		put("clk_run_for_seconds_bucket", bucket, double(metrics.run_time_counts[c]));
+	}
+	put("clk_run_for_seconds_bucket", "le=\"+Inf\"", double(metrics.run_time_counts.back()));
+	put("clk_run_for_seconds_sum", nullptr, metrics.run_time_sum_seconds);
+	put("clk_run_for_seconds_count", nullptr, double(metrics.run_time_count));
+
+	single("clk_track_cache_hits_total", "counter", "Disk tracks supplied from the flux cache, across all instances in this process.", double(metrics.track_cache_hits));
+	single("clk_track_cache_misses_total", "counter", "Disk tracks sought in but absent from the flux cache, across all instances in this process.", double(metrics.track_cache_misses));
+
+	return result;
+}
@@ -0,0 +1,99 @@
+//
+//  RuntimeMetrics.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RuntimeMetrics_hpp
+#define RuntimeMetrics_hpp
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Outputs/DisplayMetrics.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Machine {
+
+/*!
+	Collects counters describing how well a single running machine is keeping up with real time,
+	for inspection from outside of the emulator — e.g. by a monitoring system scraping
+	@c prometheus_text via a @c MetricsServer.
+
+	The host should call @c did_run after each call that advances the machine, and @c did_underrun_audio
+	or @c did_overrun_audio whenever its audio callback finds too little audio or has to discard some.
+	All methods may be called from any thread; @c snapshot is not atomic across counters, but each counter
+	is individually consistent.
+*/
+class RuntimeMetrics {
+	public:
+		/// Upper bounds, in nanoseconds, of the buckets used to count @c run_for wall times; there is also an implicit +Inf bucket.
+		static constexpr std::array<Time::Nanos, 8> run_time_buckets = {
+			500'000, 1'000'000, 2'000'000, 4'000'000, 8'000'000, 16'000'000, 32'000'000, 64'000'000
+		};
+
+		struct Snapshot {
+			/// The ratio of emulated time to wall-clock time, smoothed over roughly the last second.
+			double speed_ratio = 0.0;
+			double emulated_seconds = 0.0;
+			double wall_seconds = 0.0;
+
+			uint64_t frames_produced = 0;
+			uint64_t frames_drawn = 0;
+			uint64_t frames_missed = 0;
+
+			uint64_t audio_underruns = 0;
+			uint64_t audio_overruns = 0;
+
+			/// Cumulative counts, per @c run_time_buckets and then +Inf.
+			std::array<uint64_t, run_time_buckets.size() + 1> run_time_counts{};
+			uint64_t run_time_count = 0;
+			double run_time_sum_seconds = 0.0;
+
+			uint64_t track_cache_hits = 0;
+			uint64_t track_cache_misses = 0;
+		};
+
+		/*!
+			Records that the machine was advanced by @c emulated_duration over a wall-clock interval of @c interval,
+			of which @c run_time was spent actually running it.
+		*/
+		void did_run(Time::Seconds emulated_duration, Time::Nanos interval, Time::Nanos run_time);
+
+		void did_underrun_audio();
+		void did_overrun_audio();
+
+		/// Nominates the source of frame counts, or @c nullptr for none; @c metrics must outlive this object.
+		void set_display_metrics(const Outputs::Display::Metrics *metrics);
+
+		/// @returns The current value of all metrics.
+		Snapshot snapshot() const;
+
+		/*!
+			@returns The current value of all metrics in the Prometheus text exposition format, with each
+				labelled as belonging to @c instance.
+		*/
+		std::string prometheus_text(const std::string &instance) const;
+
+	private:
+		std::atomic<double> speed_ratio_ = 0.0;
+		std::atomic<double> emulated_seconds_ = 0.0;
+		std::atomic<Time::Nanos> wall_nanos_ = 0;
+
+		std::atomic<uint64_t> audio_underruns_ = 0;
+		std::atomic<uint64_t> audio_overruns_ = 0;
+
+		// Non-cumulative; accumulated in snapshot().
+		std::array<std::atomic<uint64_t>, run_time_buckets.size() + 1> run_time_counts_{};
+		std::atomic<Time::Nanos> run_time_sum_ = 0;
+
+		std::atomic<const Outputs::Display::Metrics *> display_metrics_ = nullptr;
+};
+
+}
+
+#endif /* RuntimeMetrics_hpp */
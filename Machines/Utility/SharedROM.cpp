@@ -0,0 +1,52 @@
+//
+//  SharedROM.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "SharedROM.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+std::mutex images_mutex;
+
+// All images that have been shared, keyed by a hash of their contents; each entry
+// is retained only until the final user of its image has released it.
+std::unordered_multimap<uint64_t, std::weak_ptr<const std::vector<uint8_t>>> images;
+
+/// @returns A 64-bit FNV-1a hash of @c data.
+uint64_t hash(const std::vector<uint8_t> &data) {
+	uint64_t hash = 14695981039346656037ull;
+	for(const auto byte: data) {
+		hash = (hash ^ byte) * 1099511628211ull;
+	}
+	return hash;
+}
+
+}
+
+ROM::SharedImage ROM::share(const std::vector<uint8_t> &data) {
+	const uint64_t key = hash(data);
+	std::lock_guard lock(images_mutex);
+
+	// Look for an existing image, discarding any that are no longer in use along the way.
+	auto range = images.equal_range(key);
+	for(auto candidate = range.first; candidate != range.second;) {
+		auto image = candidate->second.lock();
+		if(!image) {
+			candidate = images.erase(candidate);
+			continue;
+		}
+		if(*image == data) return image;
+		++candidate;
+	}
+
+	auto image = std::make_shared<const std::vector<uint8_t>>(data);
+	images.emplace(key, image);
+	return image;
+}
@@ -0,0 +1,33 @@
+//
+//  SharedROM.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SharedROM_hpp
+#define SharedROM_hpp
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ROM {
+
+/// An immutable ROM image, which may be in use by several machines at once.
+using SharedImage = std::shared_ptr<const std::vector<uint8_t>>;
+
+/*!
+	@returns An immutable image with the same contents as @c data. If any other image with identical
+	contents is currently in use anywhere within this process then that image is returned; otherwise
+	a new one is created, for return to future callers while it remains in use.
+
+	So machines that point their memory maps directly at shared images, rather than at copies, can
+	be instantiated many times over with only a single copy of each ROM.
+*/
+SharedImage share(const std::vector<uint8_t> &data);
+
+}
+
+#endif /* SharedROM_hpp */
@@ -39,6 +39,9 @@ template<typename T> class TypedDynamicMachine: public ::Machine::DynamicMachine
 		Provide(MachineTypes::KeyboardMachine, keyboard_machine)
 		Provide(MachineTypes::MouseMachine, mouse_machine)
 		Provide(MachineTypes::MediaTarget, media_target)
+		Provide(MachineTypes::StateProducer, state_producer)
+		Provide(MachineTypes::Profiled, profiled)
+		Provide(MachineTypes::BusTraceable, bus_traceable)
 
 #undef Provide
 
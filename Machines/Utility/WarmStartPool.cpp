@@ -0,0 +1,115 @@
+//
+//  WarmStartPool.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "WarmStartPool.hpp"
+
+#include "../../Outputs/ScanTarget.hpp"
+
+#include <algorithm>
+
+using namespace Machine;
+
+WarmStartPool::WarmStartPool(const ROMMachine::ROMFetcher &rom_fetcher, size_t spares) :
+	rom_fetcher_([this, rom_fetcher](const ROM::Request &request) {
+		std::lock_guard lock(rom_fetcher_mutex_);
+		return rom_fetcher(request);
+	}),
+	spares_(spares) {}
+
+WarmStartPool::~WarmStartPool() {
+	queue_.stop();
+}
+
+bool WarmStartPool::add_template(const std::string &name, std::unique_ptr<Analyser::Static::Target> target, Time::Seconds boot_duration, Error &error) {
+	auto new_template = std::make_shared<Template>();
+	target->media = Analyser::Static::CopyOnWrite(target->media);
+	new_template->target = std::move(target);
+
+	new_template->machine = std::unique_ptr<DynamicMachine>(MachineForTarget(new_template->target.get(), rom_fetcher_, error));
+	if(!new_template->machine) {
+		return false;
+	}
+	if(!new_template->machine->state_producer()) {
+		error = Error::StateUnavailable;
+		return false;
+	}
+
+	// Boot, in short slices to keep cycle counts well within range, without producing any output.
+	DynamicMachine &machine = *new_template->machine;
+	machine.scan_producer()->set_scan_target(&Outputs::Display::NullScanTarget::singleton);
+	const auto timed_machine = machine.timed_machine();
+	while(boot_duration > 0.0) {
+		const Time::Seconds slice = std::min(boot_duration, 0.1);
+		timed_machine->run_for(slice);
+		boot_duration -= slice;
+	}
+	timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+
+	templates_[name] = new_template;
+	queue_.enqueue([this, new_template] {
+		refill(*new_template);
+	});
+	return true;
+}
+
+std::unique_ptr<DynamicMachine> WarmStartPool::acquire(const std::string &name, const Analyser::Static::Media &media, Error &error) {
+	const auto source = templates_.find(name);
+	if(source == templates_.end()) {
+		error = Error::UnknownMachine;
+		return nullptr;
+	}
+	const std::shared_ptr<Template> &machine_template = source->second;
+
+	// Take a prepared clone if there is one; otherwise create one now.
+	std::unique_ptr<DynamicMachine> machine;
+	{
+		std::lock_guard lock(machine_template->spares_mutex);
+		if(!machine_template->spares.empty()) {
+			machine = std::move(machine_template->spares.back());
+			machine_template->spares.pop_back();
+		}
+	}
+	if(machine) {
+		error = Error::None;
+	} else {
+		machine = clone(*machine_template, error);
+		if(!machine) return nullptr;
+	}
+
+	queue_.enqueue([this, machine_template] {
+		refill(*machine_template);
+	});
+
+	if(!media.empty()) {
+		if(const auto media_target = machine->media_target()) {
+			media_target->insert_media(media);
+		}
+	}
+	return machine;
+}
+
+std::unique_ptr<DynamicMachine> WarmStartPool::clone(Template &source, Error &error) {
+	std::lock_guard lock(source.machine_mutex);
+	return std::unique_ptr<DynamicMachine>(Clone(*source.machine, *source.target, rom_fetcher_, error));
+}
+
+void WarmStartPool::refill(Template &source) {
+	while(true) {
+		{
+			std::lock_guard lock(source.spares_mutex);
+			if(source.spares.size() >= spares_) return;
+		}
+
+		Error error;
+		auto machine = clone(source, error);
+		if(!machine) return;
+
+		std::lock_guard lock(source.spares_mutex);
+		source.spares.push_back(std::move(machine));
+	}
+}
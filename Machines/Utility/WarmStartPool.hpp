@@ -0,0 +1,89 @@
+//
+//  WarmStartPool.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef WarmStartPool_hpp
+#define WarmStartPool_hpp
+
+#include "MachineForTarget.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Concurrency/AsyncTaskQueue.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Keeps a set of named, already-booted machine configurations — e.g. a particular machine sitting at
+	its BASIC prompt — from which new sessions can be started without waiting for a boot.
+
+	Each template is created by constructing a machine and running it for a nominated period. That machine
+	then serves only as the source for @c Machine::Clone; a number of clones of each template are prepared
+	on a background thread and handed out upon request, being replaced as they are taken. So obtaining a
+	machine usually costs only the insertion of its media.
+
+	Only machines that are StateProducers can be used as templates. Media supplied with a template's target
+	is made copy-on-write, and each machine obtained has its own fork of it.
+
+	All public methods should be called from the same thread. The ROM fetcher will be called from both that
+	thread and the background thread, but never from both at once.
+*/
+class WarmStartPool {
+	public:
+		/// Creates a pool that will keep @c spares clones of each template ready at all times.
+		WarmStartPool(const ROMMachine::ROMFetcher &rom_fetcher, size_t spares = 1);
+		~WarmStartPool();
+
+		/*!
+			Creates a machine from @c target, runs it for @c boot_duration and retains it as the template @c name,
+			replacing any existing template of that name.
+
+			@returns @c true on success; @c false otherwise, in which case @c error indicates the cause.
+		*/
+		bool add_template(const std::string &name, std::unique_ptr<Analyser::Static::Target> target, Time::Seconds boot_duration, Error &error);
+
+		/*!
+			Obtains a new machine in the state of template @c name, inserting @c media if it is non-empty. Media is inserted
+			as supplied, so should be copy-on-write if it is also in use elsewhere.
+
+			@returns The machine, which is owned by the caller, or @c nullptr if it couldn't be created, in which case @c error
+				indicates the cause.
+		*/
+		std::unique_ptr<DynamicMachine> acquire(const std::string &name, const Analyser::Static::Media &media, Error &error);
+
+	private:
+		struct Template {
+			std::unique_ptr<Analyser::Static::Target> target;
+			std::unique_ptr<DynamicMachine> machine;
+
+			// Guards the template machine, which is cloned on both threads.
+			std::mutex machine_mutex;
+
+			std::mutex spares_mutex;
+			std::vector<std::unique_ptr<DynamicMachine>> spares;
+		};
+
+		std::unique_ptr<DynamicMachine> clone(Template &, Error &);
+		void refill(Template &);
+
+		ROMMachine::ROMFetcher rom_fetcher_;
+		std::mutex rom_fetcher_mutex_;
+		const size_t spares_;
+
+		std::map<std::string, std::shared_ptr<Template>> templates_;
+
+		// Declared last so that it is destroyed, completing all work, before everything else.
+		Concurrency::AsyncTaskQueue<true> queue_;
+};
+
+}
+
+#endif /* WarmStartPool_hpp */
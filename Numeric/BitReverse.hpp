@@ -6,57 +6,73 @@
 //  Copyright © 2023 Thomas Harte. All rights reserved.
 //
 
-#ifndef BitReverse_hpp
-#define BitReverse_hpp
+#ifndef Numeric_BitReverse_hpp
+#define Numeric_BitReverse_hpp
 
+#include "ConstantEvaluation.hpp"
+
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
+#if defined(__aarch64__) && defined(__ARM_ACLE)
+#include <arm_acle.h>
+#define HAS_RBIT
+#endif
+
 namespace Numeric {
 
-/// @returns @c source with the order of its bits reversed. E.g. if @c IntT is @c uint8_t then
-/// the reverse of bit pattern abcd efgh is hgfd dcba.
-template <typename IntT> constexpr IntT bit_reverse(IntT source);
-
-// The single-byte specialisation uses a lookup table.
-template<> constexpr uint8_t bit_reverse<uint8_t>(uint8_t source) {
-    struct ReverseTable {
-		static constexpr std::array<uint8_t, 256> reverse_table() {
-			std::array<uint8_t, 256> map{};
-			for(std::size_t c = 0; c < 256; ++c) {
-				map[c] = uint8_t(
-					((c & 0x80) >> 7) |
-					((c & 0x40) >> 5) |
-					((c & 0x20) >> 3) |
-					((c & 0x10) >> 1) |
-					((c & 0x08) << 1) |
-					((c & 0x04) << 3) |
-					((c & 0x02) << 5) |
-					((c & 0x01) << 7)
-				);
-			}
-			return map;
-		}
-    };
+namespace BitReverse {
+
+constexpr std::array<uint8_t, 256> reverse_table() {
+	std::array<uint8_t, 256> map{};
+	for(std::size_t c = 0; c < 256; ++c) {
+		map[c] = uint8_t(
+			((c & 0x80) >> 7) |
+			((c & 0x40) >> 5) |
+			((c & 0x20) >> 3) |
+			((c & 0x10) >> 1) |
+			((c & 0x08) << 1) |
+			((c & 0x04) << 3) |
+			((c & 0x02) << 5) |
+			((c & 0x01) << 7)
+		);
+	}
+	return map;
+}
+
+inline constexpr std::array<uint8_t, 256> table = reverse_table();
 
-	const std::array<uint8_t, 256> map = ReverseTable::reverse_table();
-	return map[source];
 }
 
-// All other versions just call the byte-level reverse the appropriate number of times.
+/// @returns @c source with the order of its bits reversed. E.g. if @c IntT is @c uint8_t then
+/// the reverse of bit pattern abcd efgh is hgfd dcba.
+///
+/// On AArch64 this uses the RBIT instruction when evaluated at runtime; otherwise
+/// it reverses each byte via a lookup table.
 template <typename IntT> constexpr IntT bit_reverse(IntT source) {
-	IntT result;
+	static_assert(sizeof(IntT) <= 8);
 
-	uint8_t *src = reinterpret_cast<uint8_t *>(&source);
-	uint8_t *dest = reinterpret_cast<uint8_t *>(&result) + sizeof(result) - 1;
-	for(size_t c = 0; c < sizeof(source); c++) {
-		*dest = bit_reverse(*src);
-		++src;
-		--dest;
+#ifdef HAS_RBIT
+	if(!is_constant_evaluated()) {
+		if constexpr (sizeof(IntT) == 8) {
+			return IntT(__rbitll(uint64_t(source)));
+		} else {
+			return IntT(__rbit(uint32_t(source)) >> (32 - 8*sizeof(IntT)));
+		}
 	}
+#endif
 
+	IntT result = 0;
+	for(size_t c = 0; c < sizeof(source); c++) {
+		result = IntT((result << 8) | BitReverse::table[uint8_t(source)]);
+		source = IntT(source >> 8);
+	}
 	return result;
 }
 
 }
 
-#endif /* BitReverse_hpp */
+#undef HAS_RBIT
+
+#endif /* Numeric_BitReverse_hpp */
@@ -9,6 +9,14 @@
 #ifndef BitSpread_hpp
 #define BitSpread_hpp
 
+#include "ConstantEvaluation.hpp"
+
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 namespace Numeric {
 
 /// @returns The bits of @c input with a 0 bit inserted between each and
@@ -16,6 +24,12 @@ namespace Numeric {
 ///
 /// i.e. if @c input is abcdefgh then the result is 0a0b0c0d0e0f0g0h
 constexpr uint16_t spread_bits(uint8_t input) {
+#if defined(__BMI2__)
+	if(!is_constant_evaluated()) {
+		return uint16_t(_pdep_u32(input, 0x5555));
+	}
+#endif
+
 	uint16_t result = uint16_t(input);				// 0000 0000 abcd efgh
 	result = (result | (result << 4)) & 0x0f0f;		// 0000 abcd 0000 efgh
 	result = (result | (result << 2)) & 0x3333;		// 00ab 00cd 00ef 00gh
@@ -26,6 +40,12 @@ constexpr uint16_t spread_bits(uint8_t input) {
 /// @c abcd @c efgh @c ijkl @c mnop, returns the byte value @c bdfhjlnp
 /// i.e. every other bit is retained, keeping the least-significant bit in place.
 constexpr uint8_t unspread_bits(uint16_t input) {
+#if defined(__BMI2__)
+	if(!is_constant_evaluated()) {
+		return uint8_t(_pext_u32(input, 0x5555));
+	}
+#endif
+
 	input &= 0x5555;								// 0a0b 0c0d 0e0f 0g0h
 	input = (input | (input >> 1)) & 0x3333;		// 00ab 00cd 00ef 00gh
 	input = (input | (input >> 2)) & 0x0f0f;		// 0000 abcd 0000 efgh
@@ -9,7 +9,10 @@
 #ifndef CRC_hpp
 #define CRC_hpp
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 
 namespace CRC {
@@ -26,6 +29,13 @@ constexpr uint8_t reverse_byte(uint8_t byte) {
 		((byte & 0x01) ? 0x80 : 0x00);
 }
 
+/// A lookup table of @c reverse_byte for all possible inputs.
+constexpr std::array<uint8_t, 256> reversed_bytes = [] {
+	std::array<uint8_t, 256> table{};
+	for(int c = 0; c < 256; c++) table[size_t(c)] = reverse_byte(uint8_t(c));
+	return table;
+}();
+
 /*! Provides a class capable of generating a CRC from source data. */
 template <typename IntType, IntType reset_value, IntType output_xor, bool reflect_input, bool reflect_output> class Generator {
 	public:
@@ -41,7 +51,15 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 					IntType exclusive_or = (shift_value&top_bit) ? polynomial : 0;
 					shift_value = IntType(shift_value << 1) ^ exclusive_or;
 				}
-				xor_table[c] = shift_value;
+				xor_table[0][c] = shift_value;
+			}
+
+			// Derive the slice tables: xor_table[n][c] is the effect of c followed by n zero bytes.
+			for(std::size_t n = 1; n < slices; n++) {
+				for(int c = 0; c < 256; c++) {
+					const IntType previous = xor_table[n-1][c];
+					xor_table[n][c] = IntType(IntType(previous << 8) ^ xor_table[0][previous >> multibyte_shift]);
+				}
 			}
 		}
 
@@ -51,7 +69,31 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 		/// Updates the CRC to include @c byte.
 		void add(uint8_t byte) {
 			if constexpr (reflect_input) byte = reverse_byte(byte);
-			value_ = IntType((value_ << 8) ^ xor_table[(value_ >> multibyte_shift) ^ byte]);
+			value_ = IntType((value_ << 8) ^ xor_table[0][(value_ >> multibyte_shift) ^ byte]);
+		}
+
+		/// Updates the CRC to include the @c size bytes at @c data, processing them eight at a time where possible.
+		void add(const uint8_t *data, std::size_t size) {
+			while(size >= slices) {
+				// Merge the current value into the leading bytes; every byte then contributes independently,
+				// according to the number of bytes that follow it.
+				IntType result = 0;
+				for(std::size_t c = 0; c < sizeof(IntType); c++) {
+					result ^= xor_table[slices - 1 - c][input(data[c]) ^ uint8_t(value_ >> (multibyte_shift - c*8))];
+				}
+				for(std::size_t c = sizeof(IntType); c < slices; c++) {
+					result ^= xor_table[slices - 1 - c][input(data[c])];
+				}
+				value_ = result;
+
+				data += slices;
+				size -= slices;
+			}
+
+			while(size--) {
+				add(*data);
+				++data;
+			}
 		}
 
 		/// @returns The current value of the CRC.
@@ -82,6 +124,27 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 			return compute_crc(data.begin(), data.end());
 		}
 
+		/*!
+			A compound for:
+
+				reset()
+				[add all @c size bytes from @c data]
+				get_value()
+		*/
+		IntType compute_crc(const uint8_t *data, std::size_t size) {
+			reset();
+			add(data, size);
+			return get_value();
+		}
+
+		IntType compute_crc(const std::vector<uint8_t> &data) {
+			return compute_crc(data.data(), data.size());
+		}
+
+		template <std::size_t size> IntType compute_crc(const std::array<uint8_t, size> &data) {
+			return compute_crc(data.data(), data.size());
+		}
+
 		/*!
 			A compound for:
 
@@ -90,6 +153,10 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 				get_value()
 		*/
 		template <typename Iterator> IntType compute_crc(Iterator begin, Iterator end) {
+			if constexpr (std::is_pointer_v<Iterator> && sizeof(*begin) == 1) {
+				return compute_crc(reinterpret_cast<const uint8_t *>(begin), std::size_t(end - begin));
+			}
+
 			reset();
 			while(begin != end) {
 				add(*begin);
@@ -100,7 +167,13 @@ template <typename IntType, IntType reset_value, IntType output_xor, bool reflec
 
 	private:
 		static constexpr int multibyte_shift = (sizeof(IntType) * 8) - 8;
-		IntType xor_table[256];
+		static constexpr std::size_t slices = 8;
+		static constexpr uint8_t input(uint8_t byte) {
+			if constexpr (reflect_input) return reversed_bytes[byte];
+			return byte;
+		}
+		static_assert(sizeof(IntType) <= slices);
+		IntType xor_table[slices][256];
 		IntType value_;
 };
 
@@ -0,0 +1,42 @@
+//
+//  ConstantEvaluation.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ConstantEvaluation_hpp
+#define ConstantEvaluation_hpp
+
+namespace Numeric {
+
+/// A C++17 stand-in for @c std::is_constant_evaluated, allowing constexpr functions to use
+/// intrinsics when called at runtime while remaining usable in constant expressions.
+///
+/// @returns @c false if the caller is being evaluated at runtime; @c true if it is being evaluated
+/// at compile time or if the compiler offers no means to tell, so that callers fall back upon
+/// their portable implementations.
+constexpr bool is_constant_evaluated() {
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+	return __builtin_is_constant_evaluated();
+#define HAS_CONSTANT_EVALUATION_TEST
+#endif
+#endif
+
+#if !defined(HAS_CONSTANT_EVALUATION_TEST) && defined(_MSC_VER) && _MSC_VER >= 1925
+	return __builtin_is_constant_evaluated();
+#define HAS_CONSTANT_EVALUATION_TEST
+#endif
+
+#ifndef HAS_CONSTANT_EVALUATION_TEST
+	return true;
+#endif
+}
+
+#undef HAS_CONSTANT_EVALUATION_TEST
+
+}
+
+#endif /* ConstantEvaluation_hpp */
@@ -0,0 +1,45 @@
+//
+//  LeadingZeros.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef LeadingZeros_hpp
+#define LeadingZeros_hpp
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Numeric {
+
+/// @returns The number of zero bits above the most-significant set bit of @c input,
+/// i.e. 64 if @c input is zero and 0 if its top bit is set.
+inline int leading_zeros(uint64_t input) {
+	if(!input) return 64;
+
+#if defined(__GNUC__)
+	return __builtin_clzll(input);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, input);
+	return 63 - int(index);
+#else
+	int count = 0;
+	for(int shift = 32; shift; shift >>= 1) {
+		if(!(input >> (64 - shift))) {
+			count += shift;
+			input <<= shift;
+		}
+	}
+	return count;
+#endif
+}
+
+}
+
+#endif /* LeadingZeros_hpp */
@@ -0,0 +1,70 @@
+//
+//  AllocationCounter.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// The replacement operators live in this file alone so that no caller can see both the call to
+// std::malloc and that to std::free, which would otherwise provoke mismatched allocation warnings.
+//
+// Array and nothrow forms are not replaced; their default implementations forward to those below.
+
+namespace {
+
+std::atomic<size_t> allocations = 0;
+std::atomic<size_t> allocated_bytes = 0;
+
+void *allocate(std::size_t size, std::size_t alignment) {
+	++allocations;
+	allocated_bytes += size;
+
+	if(!size) size = 1;
+	void *result;
+	if(alignment <= alignof(std::max_align_t)) {
+		result = std::malloc(size);
+	} else {
+		// aligned_alloc requires the size to be a multiple of the alignment.
+		result = std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+	}
+
+	if(!result) throw std::bad_alloc();
+	return result;
+}
+
+}
+
+Benchmark::AllocationCount Benchmark::allocation_count() {
+	return AllocationCount{allocations, allocated_bytes};
+}
+
+void *operator new(std::size_t size) {
+	return allocate(size, 0);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+	return allocate(size, std::size_t(alignment));
+}
+
+void operator delete(void *pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+	std::free(pointer);
+}
@@ -0,0 +1,27 @@
+//
+//  AllocationCounter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef AllocationCounter_hpp
+#define AllocationCounter_hpp
+
+#include <cstddef>
+
+namespace Benchmark {
+
+/// A running total of heap allocations made via any form of global operator new.
+struct AllocationCount {
+	size_t allocations = 0;
+	size_t bytes = 0;
+};
+
+/// @returns The total number of heap allocations made so far.
+AllocationCount allocation_count();
+
+}
+
+#endif /* AllocationCounter_hpp */
@@ -0,0 +1,254 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/MachineTypes.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Outputs/ScanTarget.hpp"
+
+#include "AllocationCounter.hpp"
+
+/*
+	A headless benchmark: constructs each machine that is meaningful without media, runs it for
+	a fixed period of emulated time with output directed to null targets, and reports throughput.
+
+	Run with --help for options.
+*/
+
+namespace {
+
+// MARK: - Arguments.
+
+struct Arguments {
+	std::map<std::string, std::string> selections;
+
+	Arguments(int argc, char *argv[]) {
+		for(int c = 1; c < argc; c++) {
+			const char *const argument = argv[c];
+			if(strncmp(argument, "--", 2)) continue;
+
+			const char *const equals = strchr(argument, '=');
+			if(equals) {
+				selections[std::string(argument + 2, equals)] = equals + 1;
+			} else {
+				selections[argument + 2] = "";
+			}
+		}
+	}
+
+	bool has(const std::string &name) const {
+		return selections.find(name) != selections.end();
+	}
+
+	std::string get(const std::string &name, const std::string &fallback) const {
+		const auto selection = selections.find(name);
+		return selection == selections.end() ? fallback : selection->second;
+	}
+};
+
+// MARK: - ROM loading.
+
+/// Seeks ROMs in each of @c paths, with the same per-machine layout as ROMImages.
+ROMMachine::ROMFetcher rom_fetcher(const std::vector<std::string> &paths) {
+	return [paths] (const ROM::Request &roms) -> ROM::Map {
+		ROM::Map results;
+		for(const auto &description: roms.all_descriptions()) {
+			for(const auto &file_name: description.file_names) {
+				for(const auto &path: paths) {
+					const std::string local_path = path + description.machine_name + "/" + file_name;
+					FILE *const file = std::fopen(local_path.c_str(), "rb");
+					if(!file) continue;
+
+					std::vector<uint8_t> data;
+					std::fseek(file, 0, SEEK_END);
+					data.resize(size_t(std::ftell(file)));
+					std::fseek(file, 0, SEEK_SET);
+					const size_t read = std::fread(data.data(), 1, data.size(), file);
+					std::fclose(file);
+
+					if(read == data.size()) {
+						results[description.name] = std::move(data);
+						break;
+					}
+				}
+				if(results.find(description.name) != results.end()) break;
+			}
+		}
+		return results;
+	};
+}
+
+// MARK: - Null outputs.
+
+/// Discards all audio.
+struct NullSpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &) final {}
+};
+NullSpeakerDelegate null_speaker_delegate;
+
+// MARK: - Benchmarking.
+
+struct Result {
+	std::string machine;
+	Time::Seconds emulated = 0.0;
+	Time::Seconds host = 0.0;
+	double clock_rate = 0.0;
+	size_t allocations = 0;
+	size_t allocated_bytes = 0;
+	Profiling::Report profile;
+};
+
+/// Runs @c machine for @c seconds of emulated time, after a one-second warm up, and measures the cost.
+Result benchmark(Machine::DynamicMachine &machine, Time::Seconds seconds) {
+	machine.scan_producer()->set_scan_target(&Outputs::Display::NullScanTarget::singleton);
+
+	// Generate audio as if it were going to be played, as that is part of the normal workload.
+	const auto audio_producer = machine.audio_producer();
+	const auto speaker = audio_producer ? audio_producer->get_speaker() : nullptr;
+	if(speaker) {
+		speaker->set_output_rate(44100, 1024, speaker->get_is_stereo());
+		speaker->set_delegate(&null_speaker_delegate);
+	}
+
+	// Run in fiftieths of a second, approximating the granularity of a real host.
+	const auto timed_machine = machine.timed_machine();
+	constexpr Time::Seconds slice = 1.0 / 50.0;
+	const auto run = [timed_machine] (Time::Seconds duration) {
+		for(Time::Seconds elapsed = 0.0; elapsed < duration; elapsed += slice) {
+			timed_machine->run_for(slice);
+		}
+		timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+	};
+	run(1.0);
+
+	const auto profiled = machine.profiled();
+	if(profiled) profiled->reset_profile();
+
+	Result result;
+	result.emulated = seconds;
+	result.clock_rate = timed_machine->get_clock_rate();
+
+	const auto start_count = Benchmark::allocation_count();
+	const Time::Nanos start = Time::nanos_now();
+	run(seconds);
+	result.host = Time::seconds(Time::nanos_now() - start);
+	const auto end_count = Benchmark::allocation_count();
+	result.allocations = end_count.allocations - start_count.allocations;
+	result.allocated_bytes = end_count.bytes - start_count.bytes;
+	if(profiled) result.profile = profiled->get_profile();
+
+	if(speaker) {
+		speaker->set_delegate(nullptr);
+	}
+	return result;
+}
+
+void print(const Result &result) {
+	std::cout << std::left << std::setw(20) << result.machine << std::right << std::fixed;
+	std::cout << std::setw(10) << std::setprecision(2) << (result.emulated / result.host) << "x";
+	std::cout << std::setw(10) << std::setprecision(2) << (result.clock_rate * result.emulated / result.host) / 1e6 << " MHz";
+	std::cout << std::setw(12) << std::setprecision(0) << double(result.allocations) / result.emulated << " allocs/s";
+	std::cout << std::setw(12) << std::setprecision(0) << double(result.allocated_bytes) / result.emulated << " bytes/s";
+	std::cout << std::endl;
+
+	// If profiling is available, also report the cycle rate achieved by each CPU core.
+	for(const auto &record: result.profile) {
+		if(record.name.rfind("CPU::", 0)) continue;
+		const auto template_start = record.name.find('<');
+		std::cout << "    " << std::left << std::setw(28) << record.name.substr(0, template_start) << std::right;
+		std::cout << std::setw(10) << std::setprecision(2) << double(record.cycles) / record.inclusive / 1e6 << " M/s inclusive";
+		std::cout << std::setw(10) << std::setprecision(2) << double(record.cycles) / record.exclusive / 1e6 << " M/s exclusive";
+		std::cout << std::endl;
+	}
+	std::cout << std::defaultfloat;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const Arguments arguments(argc, argv);
+	if(arguments.has("help")) {
+		std::cout << "Usage: clkbenchmark [--seconds={emulated seconds per machine, default 10}] [--machine={name}] [--rompath={path}]" << std::endl;
+		std::cout << "Runs every machine that can start without media, or just the one specified, and reports:" << std::endl;
+		std::cout << "\temulated seconds per host second; emulated clock cycles per host second; and heap allocations per emulated second." << std::endl;
+		std::cout << "If built with profile=1 then the clock rate of each CPU core is reported too, both including and excluding time spent in other components that it clocks." << std::endl;
+		std::cout << "Core rates are in each core's own unit of time, i.e. half-cycles for the Z80 and 68000." << std::endl;
+		std::cout << "ROMs are sought in ROMImages, /usr/local/share/CLK/, /usr/share/CLK/ and any --rompath, each arranged as per ROMImages." << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	const Time::Seconds seconds = std::strtod(arguments.get("seconds", "10").c_str(), nullptr);
+	if(seconds <= 0.0) {
+		std::cerr << "--seconds must be a positive number." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> paths = {
+		"../../ROMImages/",
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/",
+	};
+	if(arguments.has("rompath")) {
+		std::string path = arguments.get("rompath", "");
+		if(!path.empty() && path.back() != '/') path += '/';
+		paths.insert(paths.begin(), path);
+	}
+	const auto fetcher = rom_fetcher(paths);
+
+	const auto short_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, false);
+	const auto long_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, true);
+	auto targets = Machine::TargetsByMachineName(true);
+
+	const std::string requested_machine = arguments.get("machine", "");
+	bool found_machine = requested_machine.empty();
+	for(size_t c = 0; c < short_names.size(); c++) {
+		if(!requested_machine.empty() && !std::equal(
+			short_names[c].begin(), short_names[c].end(),
+			requested_machine.begin(), requested_machine.end(),
+			[](char a, char b) { return tolower(b) == tolower(a); })) {
+			continue;
+		}
+		found_machine = true;
+
+		auto &target = targets[long_names[c]];
+		if(!target) continue;
+
+		Analyser::Static::TargetList target_list;
+		target_list.push_back(std::move(target));
+
+		Machine::Error error;
+		std::unique_ptr<Machine::DynamicMachine> machine(Machine::MachineForTargets(target_list, fetcher, error));
+		if(!machine) {
+			std::cout << std::left << std::setw(20) << short_names[c] << std::right;
+			std::cout << (error == Machine::Error::MissingROM ? "skipped: missing ROMs" : "skipped: could not be created") << std::endl;
+			continue;
+		}
+
+		Result result = benchmark(*machine, seconds);
+		result.machine = short_names[c];
+		print(result);
+	}
+
+	if(!found_machine) {
+		std::cerr << "Unknown machine: " << requested_machine << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
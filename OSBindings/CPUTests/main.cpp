@@ -0,0 +1,675 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+#include "../../Processors/68000Mk2/68000Mk2.hpp"
+
+/*
+	A portable runner for the processor test suites that otherwise run only under XCTest:
+	ZEXDOC and ZEXALL on the Z80; Klaus Dormann's functional tests on the 6502 and 65C02;
+	Wolfgang Lorenz's suite on the 6502; and flamewing's BCD table on the 68000.
+
+	Each suite reports pass or failure plus the throughput achieved, so that the effect of
+	changes to a core can be measured on any platform.
+
+	Run with --help for options.
+*/
+
+namespace {
+
+// MARK: - Arguments.
+
+struct Arguments {
+	std::map<std::string, std::string> selections;
+
+	Arguments(int argc, char *argv[]) {
+		for(int c = 1; c < argc; c++) {
+			const char *const argument = argv[c];
+			if(strncmp(argument, "--", 2)) continue;
+
+			const char *const equals = strchr(argument, '=');
+			if(equals) {
+				selections[std::string(argument + 2, equals)] = equals + 1;
+			} else {
+				selections[argument + 2] = "";
+			}
+		}
+	}
+
+	bool has(const std::string &name) const {
+		return selections.find(name) != selections.end();
+	}
+
+	std::string get(const std::string &name, const std::string &fallback) const {
+		const auto selection = selections.find(name);
+		return selection == selections.end() ? fallback : selection->second;
+	}
+};
+
+std::string directory(std::string path) {
+	if(!path.empty() && path.back() != '/') path += '/';
+	return path;
+}
+
+/// @returns The entire contents of the file at @c path, or an empty vector if it couldn't be read.
+std::vector<uint8_t> contents_of(const std::string &path) {
+	std::vector<uint8_t> data;
+	FILE *const file = std::fopen(path.c_str(), "rb");
+	if(!file) return data;
+
+	std::fseek(file, 0, SEEK_END);
+	data.resize(size_t(std::ftell(file)));
+	std::fseek(file, 0, SEEK_SET);
+	if(std::fread(data.data(), 1, data.size(), file) != data.size()) {
+		data.clear();
+	}
+	std::fclose(file);
+	return data;
+}
+
+// MARK: - Results.
+
+struct Result {
+	enum class Outcome {
+		Passed, Failed, Skipped
+	} outcome = Outcome::Skipped;
+	std::string detail;
+
+	uint64_t instructions = 0;
+	uint64_t cycles = 0;
+	Time::Seconds host = 0.0;
+};
+
+Result skipped(const std::string &reason) {
+	Result result;
+	result.detail = reason;
+	return result;
+}
+
+/// Times @c run, which should return a result with everything but @c host populated.
+Result timed(const std::function<Result(void)> &run) {
+	const Time::Nanos start = Time::nanos_now();
+	Result result = run();
+	result.host = Time::seconds(Time::nanos_now() - start);
+	return result;
+}
+
+void print(const std::string &suite, const Result &result) {
+	std::cout << std::left << std::setw(16) << suite << std::right;
+	switch(result.outcome) {
+		case Result::Outcome::Skipped:
+			std::cout << "skipped: " << result.detail << std::endl;
+		return;
+		case Result::Outcome::Passed:	std::cout << "pass";	break;
+		case Result::Outcome::Failed:	std::cout << "FAIL";	break;
+	}
+
+	std::cout << std::fixed;
+	std::cout << std::setw(10) << std::setprecision(2) << double(result.instructions) / result.host / 1e6 << " MIPS";
+	std::cout << std::setw(10) << std::setprecision(2) << double(result.cycles) / result.host / 1e6 << " MHz";
+	std::cout << std::setw(10) << std::setprecision(2) << result.host << " s";
+	std::cout << std::defaultfloat << std::endl;
+
+	if(!result.detail.empty()) {
+		std::cout << "    " << result.detail << std::endl;
+	}
+}
+
+// MARK: - Z80: ZEXDOC and ZEXALL.
+
+/// Provides just enough of CP/M's BDOS to capture console output, and spots program exit.
+struct CPMTrapHandler: public CPU::AllRAMProcessor::TrapHandler {
+	CPMTrapHandler(CPU::Z80::AllRAMProcessor &z80, bool echo) : z80(z80), echo(echo) {}
+
+	CPU::Z80::AllRAMProcessor &z80;
+	const bool echo;
+	std::string output;
+	bool done = false;
+
+	void processor_did_trap(CPU::AllRAMProcessor &, uint16_t address) final {
+		if(!address) {
+			done = true;
+			return;
+		}
+
+		const size_t start = output.size();
+		switch(z80.get_value_of_register(CPU::Z80::Register::C)) {
+			case 0:
+				done = true;
+			break;
+			case 2: case 5:
+				output.push_back(char(z80.get_value_of_register(CPU::Z80::Register::E)));
+			break;
+			case 9: {
+				uint16_t pointer = z80.get_value_of_register(CPU::Z80::Register::DE);
+				while(true) {
+					uint8_t character;
+					z80.get_data_at_address(pointer++, 1, &character);
+					if(character == '$') break;
+					output.push_back(char(character));
+				}
+			} break;
+		}
+
+		if(echo) {
+			std::cout << output.substr(start) << std::flush;
+		}
+	}
+};
+
+Result zex(const std::string &path, bool echo) {
+	const auto program = contents_of(path);
+	if(program.empty()) return skipped(path + " not found");
+
+	return timed([&] {
+		std::unique_ptr<CPU::Z80::AllRAMProcessor> z80(CPU::Z80::AllRAMProcessor::Processor());
+		z80->reset_power_on();
+		CPMTrapHandler handler(*z80, echo);
+
+		// Install the program at the usual CP/M place, put a RET at the BDOS entry point with a
+		// high memtop after it, and make 0 — the warm boot vector — a trap that loops to itself.
+		z80->set_data_at_address(0x100, program.size(), program.data());
+		const uint8_t bdos[] = {0xc9, 0xff, 0xff};
+		z80->set_data_at_address(0x0005, sizeof(bdos), bdos);
+		const uint8_t warm_boot[] = {0xc3, 0x00, 0x00};
+		z80->set_data_at_address(0x0000, sizeof(warm_boot), warm_boot);
+
+		z80->set_trap_handler(&handler);
+		z80->add_trap_address(0x0005);
+		z80->add_trap_address(0x0000);
+		z80->set_value_of_register(CPU::Z80::Register::ProgramCounter, 0x100);
+
+		while(!handler.done) {
+			z80->run_for(Cycles(1'000'000));
+		}
+
+		Result result;
+		result.instructions = z80->get_opcode_fetches();
+		result.cycles = uint64_t(z80->get_timestamp().as_integral()) >> 1;
+
+		const auto error = handler.output.find("ERROR");
+		if(error != std::string::npos) {
+			result.outcome = Result::Outcome::Failed;
+			const auto line_start = handler.output.rfind('\n', error);
+			const auto line_end = handler.output.find_first_of("\r\n", error);
+			result.detail = handler.output.substr(
+				line_start == std::string::npos ? 0 : line_start + 1,
+				line_end == std::string::npos ? std::string::npos : line_end - line_start - 1);
+		} else if(handler.output.find("Tests complete") == std::string::npos) {
+			result.outcome = Result::Outcome::Failed;
+			result.detail = "exited without completing";
+		} else {
+			result.outcome = Result::Outcome::Passed;
+		}
+		return result;
+	});
+}
+
+// MARK: - 6502: Klaus Dormann.
+
+Result dormann(const std::string &path, CPU::MOS6502Esque::Type type, uint16_t success_address) {
+	const auto program = contents_of(path);
+	if(program.empty()) return skipped(path + " not found");
+
+	return timed([&] {
+		using Register = CPU::MOS6502::Register;
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor> mos6502(CPU::MOS6502::AllRAMProcessor::Processor(type));
+		mos6502->set_data_at_address(0, program.size(), program.data());
+		mos6502->set_value_of_register(Register::ProgramCounter, 0x400);
+
+		// Each failure, and success, is signalled by a branch or jump to itself; so
+		// run until the processor appears to be stuck.
+		uint16_t trap_address;
+		while(true) {
+			const auto prior_address = mos6502->get_value_of_register(Register::LastOperationAddress);
+			mos6502->run_for(Cycles(1000));
+			trap_address = mos6502->get_value_of_register(Register::LastOperationAddress);
+			if(trap_address != prior_address) continue;
+
+			mos6502->run_for(Cycles(7));
+			if(mos6502->get_value_of_register(Register::LastOperationAddress) == prior_address) break;
+		}
+
+		Result result;
+		result.instructions = mos6502->get_opcode_fetches();
+		result.cycles = uint64_t(mos6502->get_timestamp().as_integral()) >> 1;
+		if(trap_address == success_address) {
+			result.outcome = Result::Outcome::Passed;
+		} else {
+			result.outcome = Result::Outcome::Failed;
+
+			char detail[32];
+			snprintf(detail, sizeof(detail), "trapped at %04x", trap_address);
+			result.detail = detail;
+		}
+		return result;
+	});
+}
+
+// MARK: - 6502: Wolfgang Lorenz.
+
+/// Lists the Lorenz programs that test the processor alone; the CIA, memory-mapping and
+/// timing tests depend on the rest of a C64.
+const std::vector<std::string> &lorenz_tests() {
+	static const std::vector<std::string> tests = [] {
+		std::vector<std::string> tests = {
+			" start",
+			"taxn", "tayn", "txan", "tyan", "tsxn", "txsn",
+			"phan", "plan", "phpn", "plpn",
+			"inxn", "inyn", "dexn", "deyn", "incz", "inczx", "inca", "incax", "decz", "deczx", "deca", "decax",
+			"clcn", "secn", "cldn", "sedn", "clin", "sein", "clvn",
+			"brkn", "rtin", "jsrw", "rtsn", "jmpw", "jmpi",
+			"beqr", "bner", "bmir", "bplr", "bcsr", "bccr", "bvsr", "bvcr",
+			"alrb", "arrb", "sbxb", "shaay", "shaiy", "shxay", "shyax", "shsay",
+			"lxab", "aneb", "ancb", "lasay", "sbcb(eb)",
+		};
+
+		const auto add = [&tests] (const std::string &prefix, std::initializer_list<const char *> suffixes) {
+			for(const auto suffix: suffixes) {
+				tests.push_back(prefix + suffix);
+			}
+		};
+		add("lda", {"b", "z", "zx", "a", "ax", "ay", "ix", "iy"});
+		add("sta", {"z", "zx", "a", "ax", "ay", "ix", "iy"});
+		add("ldx", {"b", "z", "zy", "a", "ay"});
+		add("stx", {"z", "zy", "a"});
+		add("ldy", {"b", "z", "zx", "a", "ax"});
+		add("sty", {"z", "zx", "a"});
+		for(const auto shift: {"asl", "lsr", "rol", "ror"}) {
+			add(shift, {"n", "z", "zx", "a", "ax"});
+		}
+		for(const auto operation: {"and", "ora", "eor", "adc", "sbc", "cmp"}) {
+			add(operation, {"b", "z", "zx", "a", "ax", "ay", "ix", "iy"});
+		}
+		add("cpx", {"b", "z", "a"});
+		add("cpy", {"b", "z", "a"});
+		add("bit", {"z", "a"});
+		add("nop", {"n", "b", "z", "zx", "a", "ax"});
+		for(const auto operation: {"aso", "rla", "lse", "rra", "dcm", "ins"}) {
+			add(operation, {"z", "zx", "a", "ax", "ay", "ix", "iy"});
+		}
+		add("lax", {"z", "zy", "a", "ay", "ix", "iy"});
+		add("axs", {"z", "zy", "a", "ix"});
+		return tests;
+	}();
+	return tests;
+}
+
+/// Captures output via the KERNAL's CHROUT, fakes a key press for GETIN, and spots failure.
+struct KERNALTrapHandler: public CPU::AllRAMProcessor::TrapHandler {
+	KERNALTrapHandler(CPU::MOS6502::AllRAMProcessor &mos6502) : mos6502(mos6502) {}
+
+	CPU::MOS6502::AllRAMProcessor &mos6502;
+	std::string output;
+	bool failed = false;
+
+	void processor_did_trap(CPU::AllRAMProcessor &, uint16_t address) final {
+		switch(address) {
+			case 0xffd2: {
+				const uint8_t zero = 0;
+				mos6502.set_data_at_address(0x030c, 1, &zero);
+				output.push_back(char(mos6502.get_value_of_register(CPU::MOS6502::Register::A)));
+			} break;
+			case 0xffe4:
+				mos6502.set_value_of_register(CPU::MOS6502::Register::A, 0x03);
+			break;
+			default:
+				failed = true;
+			break;
+		}
+	}
+
+	/// @returns The captured output with PETSCII mapped to approximate ASCII.
+	std::string text() const {
+		std::string text;
+		for(const auto character: output) {
+			const auto code = uint8_t(character);
+			if(code == 0x0d) text.push_back(' ');
+			else if(code >= 0x41 && code <= 0x5a) text.push_back(char(code + 0x20));
+			else if(code >= 0xc1 && code <= 0xda) text.push_back(char(code - 0x80));
+			else if(code >= 0x20 && code < 0x60) text.push_back(char(code));
+		}
+		return text;
+	}
+};
+
+Result lorenz(const std::string &path, const std::vector<uint8_t> &kernal) {
+	if(kernal.size() != 8192) return skipped("C64 KERNAL kernal.901227-02.bin not found");
+	if(contents_of(path + " start").empty()) return skipped(path + " not found");
+
+	return timed([&] {
+		using Register = CPU::MOS6502::Register;
+		Result result;
+		result.outcome = Result::Outcome::Passed;
+
+		for(const auto &test: lorenz_tests()) {
+			const auto program = contents_of(path + test);
+			if(program.size() < 2) {
+				result.outcome = Result::Outcome::Failed;
+				result.detail = test + " not found";
+				break;
+			}
+
+			std::unique_ptr<CPU::MOS6502::AllRAMProcessor> mos6502(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502Esque::Type::T6502, true));
+			KERNALTrapHandler handler(*mos6502);
+			mos6502->set_trap_handler(&handler);
+
+			const auto poke = [&mos6502] (uint16_t address, std::initializer_list<uint8_t> values) {
+				mos6502->set_data_at_address(address, values.size(), values.begin());
+			};
+			mos6502->set_data_at_address(size_t(program[0] | (program[1] << 8)), program.size() - 2, &program[2]);
+			mos6502->set_data_at_address(0xe000, kernal.size(), kernal.data());
+
+			// Cf. http://www.softwolves.com/arkiv/cbm-hackers/7/7114.html for the steps being taken here.
+
+			// Signal in-border, set up NMI and IRQ vectors as defaults.
+			poke(0xd011, {0xff});
+			poke(0x0314, {0x31, 0xea, 0x66, 0xfe});
+
+			// Initialise memory locations as instructed.
+			poke(0x0002, {0x00});
+			poke(0xa002, {0x00, 0x80});
+			poke(0x01fe, {0xff, 0x7f});
+			poke(0xfffe, {0x48, 0xff});
+
+			// Place the Commodore's default IRQ handler.
+			poke(0xff48, {
+				0x48, 0x8a, 0x48, 0x98, 0x48, 0xba, 0xbd, 0x04, 0x01,
+				0x29, 0x10, 0xf0, 0x03, 0x6c, 0x16, 0x03, 0x6c, 0x14, 0x03
+			});
+
+			// Trap character output, keyboard scanning and the two failure exits; have each return immediately.
+			for(const uint16_t address: {0xffd2, 0xffe4, 0x8000, 0xa474}) {
+				mos6502->add_trap_address(address);
+				poke(address, {0x60});
+			}
+
+			// Commodore's load routine resides at $e16f; this is used to spot the end of a test.
+			poke(0xe16f, {0x4c, 0x6f, 0xe1});
+
+			mos6502->set_value_of_register(Register::ProgramCounter, 0x0801);
+			mos6502->set_value_of_register(Register::StackPointer, 0xfd);
+			mos6502->set_value_of_register(Register::Flags, 0x04);
+
+			// The last operation address is meaningful only once something has been executed.
+			do {
+				mos6502->run_for(Cycles(1000));
+			} while(
+				mos6502->get_value_of_register(Register::LastOperationAddress) != 0xe16f &&
+				!mos6502->is_jammed() &&
+				!handler.failed
+			);
+
+			result.instructions += mos6502->get_opcode_fetches();
+			result.cycles += uint64_t(mos6502->get_timestamp().as_integral()) >> 1;
+
+			if(handler.failed || mos6502->is_jammed()) {
+				result.outcome = Result::Outcome::Failed;
+				result.detail = test + ": " + (handler.failed ? handler.text() : "jammed");
+				break;
+			}
+		}
+		return result;
+	});
+}
+
+// MARK: - 68000: flamewing's BCD table.
+
+/*!
+	Runs a small program on a 68000 that applies ABCD, SBCD and NBCD to every combination of
+	operands and initial X and Z flags in the order of flamewing's table, storing the resulting
+	CCR and value of each.
+*/
+class BCDMachine: public CPU::MC68000Mk2::BusHandler {
+	public:
+		static constexpr uint32_t ProgramAddress = 0x1000;
+		static constexpr uint32_t FlagsAddress = 0x0f00;
+		static constexpr uint32_t OutputAddress = 0x10000;
+
+		BCDMachine() : m68000_(*this) {
+			// Initial CCRs, indexed as per flamewing: bit 1 => X and C; bit 0 => Z.
+			ram_[FlagsAddress >> 1] = 0x0004;
+			ram_[(FlagsAddress >> 1) + 1] = 0x1115;
+
+			// The inner sequence for the binary operations; the operation itself is at offset 8.
+			static constexpr uint16_t binary[] = {
+				0x7800,					// moveq #0, d4
+				0x7a00,					// moveq #0, d5
+				0x7c00,					// moveq #0, d6
+				0x7200,					// moveq #0, d1
+				0x1205,					// move.b d5, d1
+				0x1e32, 0x6000,			// move.b (0, a2, d6.w), d7
+				0x44c7,					// move d7, ccr
+				0x0000,					// [abcd/sbcd d4, d1]
+				0x40c2,					// move sr, d2
+				0x10c2,					// move.b d2, (a0)+
+				0x10c1,					// move.b d1, (a0)+
+				0x5246,					// addq.w #1, d6
+				0x0c46, 0x0004,			// cmpi.w #4, d6
+				0x66e6,					// bne.s [moveq #0, d1]
+				0x5245,					// addq.w #1, d5
+				0x0c45, 0x0100,			// cmpi.w #256, d5
+				0x66dc,					// bne.s [moveq #0, d6]
+				0x5244,					// addq.w #1, d4
+				0x0c44, 0x0100,			// cmpi.w #256, d4
+				0x66d2,					// bne.s [moveq #0, d5]
+			};
+			static constexpr uint16_t unary[] = {
+				0x7800,					// moveq #0, d4
+				0x7c00,					// moveq #0, d6
+				0x7200,					// moveq #0, d1
+				0x1204,					// move.b d4, d1
+				0x1e32, 0x6000,			// move.b (0, a2, d6.w), d7
+				0x44c7,					// move d7, ccr
+				0x4801,					// nbcd d1
+				0x40c2,					// move sr, d2
+				0x10c2,					// move.b d2, (a0)+
+				0x10c1,					// move.b d1, (a0)+
+				0x5246,					// addq.w #1, d6
+				0x0c46, 0x0004,			// cmpi.w #4, d6
+				0x66e6,					// bne.s [moveq #0, d1]
+				0x5244,					// addq.w #1, d4
+				0x0c44, 0x0100,			// cmpi.w #256, d4
+				0x66dc,					// bne.s [moveq #0, d6]
+			};
+
+			std::vector<uint16_t> program = {
+				0x41f9, uint16_t(OutputAddress >> 16), uint16_t(OutputAddress),	// lea OutputAddress, a0
+				0x45f9, uint16_t(FlagsAddress >> 16), uint16_t(FlagsAddress),	// lea FlagsAddress, a2
+			};
+			for(const uint16_t operation: {0xc304, 0x8304}) {	// abcd d4, d1; sbcd d4, d1
+				const size_t start = program.size();
+				program.insert(program.end(), std::begin(binary), std::end(binary));
+				program[start + 8] = operation;
+			}
+			program.insert(program.end(), std::begin(unary), std::end(unary));
+
+			halt_address_ = ProgramAddress + uint32_t(program.size() * 2);
+			program.push_back(0x60fe);	// bra.s *
+			std::copy(program.begin(), program.end(), &ram_[ProgramAddress >> 1]);
+
+			// Start in supervisor mode with interrupts masked.
+			auto registers = m68000_.get_state().registers;
+			registers.status = 0x2700;
+			registers.program_counter = ProgramAddress;
+			registers.supervisor_stack_pointer = ProgramAddress;
+			m68000_.decode_from_state(registers);
+		}
+
+		void run() {
+			while(!halted_) {
+				m68000_.run_for(HalfCycles(20'000));
+			}
+		}
+
+		HalfCycles perform_bus_operation(const CPU::MC68000Mk2::Microcycle &cycle, int) {
+			using Microcycle = CPU::MC68000Mk2::Microcycle;
+			duration_ += cycle.length;
+			if(!cycle.data_select_active()) return HalfCycles(0);
+
+			uint16_t &word = ram_[cycle.word_address() % ram_.size()];
+			switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+				default: break;
+
+				case Microcycle::SelectWord | Microcycle::Read:
+					cycle.value->w = word;
+				break;
+				case Microcycle::SelectByte | Microcycle::Read:
+					cycle.value->b = uint8_t(word >> cycle.byte_shift());
+				break;
+				case Microcycle::SelectWord:
+					word = cycle.value->w;
+				break;
+				case Microcycle::SelectByte:
+					word = uint16_t(
+						(cycle.value->b << cycle.byte_shift()) |
+						(word & cycle.untouched_byte_mask())
+					);
+				break;
+			}
+			return HalfCycles(0);
+		}
+
+		void will_perform(uint32_t address, uint16_t) {
+			++instructions_;
+			halted_ |= address == halt_address_;
+		}
+
+		uint8_t output(size_t offset) const {
+			const uint32_t address = OutputAddress + uint32_t(offset);
+			return uint8_t(ram_[address >> 1] >> ((address & 1) ? 0 : 8));
+		}
+
+		uint64_t instructions() const {
+			return instructions_;
+		}
+
+		uint64_t cycles() const {
+			return uint64_t(duration_.as_integral()) >> 1;
+		}
+
+	private:
+		CPU::MC68000Mk2::Processor<BCDMachine, true, true, true> m68000_;
+		std::vector<uint16_t> ram_ = std::vector<uint16_t>(1024*1024);
+		HalfCycles duration_;
+		uint64_t instructions_ = 0;
+		uint32_t halt_address_ = 0;
+		bool halted_ = false;
+};
+
+Result flamewing(const std::string &path) {
+	const auto table = contents_of(path);
+	if(table.empty()) return skipped(path + " not found");
+
+	return timed([&] {
+		const auto machine = std::make_unique<BCDMachine>();
+		machine->run();
+
+		Result result;
+		result.instructions = machine->instructions();
+		result.cycles = machine->cycles();
+		result.outcome = Result::Outcome::Passed;
+
+		for(size_t c = 0; c < table.size(); c++) {
+			if(machine->output(c) == table[c]) continue;
+
+			// Decode the test case from its position in the table.
+			const size_t test = c >> 1;
+			const size_t binary_tests = 256 * 256 * 4;
+			char detail[64];
+			if(test < binary_tests * 2) {
+				snprintf(detail, sizeof(detail), "%s %02zx, %02zx [%c%c]: %s %02x, expected %02x",
+					test < binary_tests ? "ABCD" : "SBCD",
+					(test >> 10) & 0xff, (test >> 2) & 0xff,
+					(test & 2) ? 'X' : '-', (test & 1) ? 'Z' : '-',
+					(c & 1) ? "value" : "ccr", machine->output(c), table[c]);
+			} else {
+				const size_t nbcd_test = test - binary_tests * 2;
+				snprintf(detail, sizeof(detail), "NBCD %02zx [%c%c]: %s %02x, expected %02x",
+					nbcd_test >> 2,
+					(nbcd_test & 2) ? 'X' : '-', (nbcd_test & 1) ? 'Z' : '-',
+					(c & 1) ? "value" : "ccr", machine->output(c), table[c]);
+			}
+
+			result.outcome = Result::Outcome::Failed;
+			result.detail = detail;
+			break;
+		}
+		return result;
+	});
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const Arguments arguments(argc, argv);
+	if(arguments.has("help")) {
+		std::cout << "Usage: clkcputests [--suite={name}] [--tests={path}] [--rompath={path}] [--verbose]" << std::endl;
+		std::cout << "Runs processor test suites and reports, for each: pass or failure; millions of instructions per host second; and emulated MHz." << std::endl;
+		std::cout << "Suites are: zexdoc, zexall, dormann6502, dormann65c02, lorenz and flamewing; all are run if none is specified." << std::endl;
+		std::cout << "Test programs are sought in --tests, by default the XCTest resources directory ../Mac/Clock SignalTests/." << std::endl;
+		std::cout << "The Lorenz suite also requires the C64 KERNAL, sought in ROMImages and any --rompath, arranged as per ROMImages." << std::endl;
+		std::cout << "Z80 instruction counts include each prefix byte separately. --verbose echoes ZEXDOC and ZEXALL output as it is produced." << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	const std::string tests = directory(arguments.get("tests", "../Mac/Clock SignalTests/"));
+	const bool verbose = arguments.has("verbose");
+
+	std::vector<uint8_t> kernal;
+	for(const auto &path: {directory(arguments.get("rompath", "")), std::string("../../ROMImages/")}) {
+		if(path.empty()) continue;
+		kernal = contents_of(path + "Commodore64/kernal.901227-02.bin");
+		if(!kernal.empty()) break;
+	}
+
+	const std::vector<std::pair<std::string, std::function<Result(void)>>> suites = {
+		{"zexdoc", [&] { return zex(tests + "Zexall/zexdoc.com", verbose); }},
+		{"zexall", [&] { return zex(tests + "Zexall/zexall.com", verbose); }},
+		{"dormann6502", [&] {
+			return dormann(tests + "Klaus Dormann/6502_functional_test.bin", CPU::MOS6502Esque::Type::T6502, 0x3399);
+		}},
+		{"dormann65c02", [&] {
+			return dormann(tests + "Klaus Dormann/65C02_extended_opcodes_test.bin", CPU::MOS6502Esque::Type::TWDC65C02, 0x24f1);
+		}},
+		{"lorenz", [&] { return lorenz(tests + "Wolfgang Lorenz 6502 test suite/", kernal); }},
+		{"flamewing", [&] { return flamewing(tests + "flamewing 68000 BCD tests/bcd-table.bin"); }},
+	};
+
+	const std::string requested_suite = arguments.get("suite", "");
+	bool found_suite = requested_suite.empty();
+	bool all_passed = true;
+	for(const auto &suite: suites) {
+		if(!requested_suite.empty() && suite.first != requested_suite) continue;
+		found_suite = true;
+
+		const Result result = suite.second();
+		print(suite.first, result);
+		all_passed &= result.outcome != Result::Outcome::Failed;
+	}
+
+	if(!found_suite) {
+		std::cerr << "Unknown suite: " << requested_suite << std::endl;
+		return EXIT_FAILURE;
+	}
+	return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,633 @@
+//
+//  main.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Concurrency/ThreadPlacement.hpp"
+#include "../../Concurrency/WorkStealingPool.hpp"
+#include "../../Machines/Utility/InputLog.hpp"
+#include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/Utility/MemoryFuzzer.hpp"
+#include "../../Machines/Utility/ROMIndex.hpp"
+#include "../../Machines/MachineTypes.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Outputs/FrameHasher.hpp"
+#include "../../Reflection/Struct.hpp"
+
+/*
+	A regression farm: runs every case listed in a manifest headlessly, as many at once as there are
+	workers, and reports the results as JSON and/or JUnit XML.
+
+	Each non-blank line of a manifest that doesn't begin with # describes one case, as a sequence
+	of fields separated by whitespace; fields that contain whitespace may be enclosed in double quotes.
+	The first field names the case; the rest are as per the SDL clksignal's command line:
+
+		name [file ...] [--new={machine}] [--{option}={value} ...]
+			[--frames={count}] [--seconds={emulated seconds}] [--replay-input={file}]
+			[--expected-hashes={file}]
+
+	All media is opened copy-on-write. Machine options are applied to the target and to the machine
+	exactly as by clksignal. At least one of --frames, --seconds and --replay-input is required;
+	a case ends when any of them is satisfied.
+
+	The hash of each frame is written to [output directory]/[name].hashes, as per Outputs/FrameHasher.hpp.
+	If --expected-hashes was supplied then those hashes must match the ones expected, for every frame
+	that was expected. Relative paths within a manifest are relative to the manifest.
+
+	Run with --help for options.
+*/
+
+namespace {
+
+// MARK: - Arguments.
+
+struct Arguments {
+	std::vector<std::string> file_names;
+	std::map<std::string, std::string> selections;
+
+	Arguments(int argc, char *argv[]) {
+		for(int c = 1; c < argc; c++) {
+			const char *const argument = argv[c];
+			if(strncmp(argument, "--", 2)) {
+				file_names.push_back(argument);
+				continue;
+			}
+
+			const char *const equals = strchr(argument, '=');
+			if(equals) {
+				selections[std::string(argument + 2, equals)] = equals + 1;
+			} else {
+				selections[argument + 2] = "";
+			}
+		}
+	}
+
+	bool has(const std::string &name) const {
+		return selections.find(name) != selections.end();
+	}
+
+	std::string get(const std::string &name, const std::string &fallback) const {
+		const auto selection = selections.find(name);
+		return selection == selections.end() ? fallback : selection->second;
+	}
+};
+
+// MARK: - Manifest.
+
+struct Case {
+	std::string name;
+	size_t line = 0;
+	std::vector<std::string> file_names;
+	std::map<std::string, std::string> selections;	// The empty string is stored for options without an = suffix.
+};
+
+/// @returns @c path, made relative to @c directory if it isn't already absolute.
+std::string resolve(const std::string &directory, const std::string &path) {
+	if(path.empty() || path[0] == '/') return path;
+	return directory + path;
+}
+
+/// Splits @c line into whitespace-separated fields, honouring double quotes.
+std::vector<std::string> fields(const std::string &line) {
+	std::vector<std::string> result;
+	std::string field;
+	bool is_quoted = false, has_field = false;
+	for(const char c: line) {
+		if(c == '"') {
+			is_quoted ^= true;
+			has_field = true;
+			continue;
+		}
+		if(!is_quoted && isspace(c)) {
+			if(has_field) result.push_back(std::move(field));
+			field.clear();
+			has_field = false;
+			continue;
+		}
+		field.push_back(c);
+		has_field = true;
+	}
+	if(has_field) result.push_back(std::move(field));
+	return result;
+}
+
+/// Reads the manifest @c file_name, reporting any errors to @c std::cerr.
+/// @returns @c true on success; @c false otherwise.
+bool read_manifest(const std::string &file_name, std::vector<Case> &cases) {
+	std::ifstream file(file_name);
+	if(!file) {
+		std::cerr << "Unable to open manifest " << file_name << std::endl;
+		return false;
+	}
+
+	const auto separator = file_name.rfind('/');
+	const std::string directory = separator == std::string::npos ? "" : file_name.substr(0, separator + 1);
+
+	// These options name files, so are resolved relative to the manifest.
+	static constexpr const char *file_options[] = {"replay-input", "expected-hashes"};
+
+	std::string line;
+	size_t line_number = 0;
+	bool is_valid = true;
+	while(std::getline(file, line)) {
+		++line_number;
+		const auto line_fields = fields(line);
+		if(line_fields.empty() || line_fields[0][0] == '#') continue;
+
+		Case next;
+		next.name = line_fields[0];
+		next.line = line_number;
+		for(auto field = line_fields.begin() + 1; field != line_fields.end(); ++field) {
+			if(field->compare(0, 2, "--")) {
+				next.file_names.push_back(resolve(directory, *field));
+				continue;
+			}
+
+			const auto equals = field->find('=');
+			const std::string name = field->substr(2, equals == std::string::npos ? std::string::npos : equals - 2);
+			std::string value = equals == std::string::npos ? "" : field->substr(equals + 1);
+			if(std::find(std::begin(file_options), std::end(file_options), name) != std::end(file_options)) {
+				value = resolve(directory, value);
+			}
+			next.selections[name] = value;
+		}
+
+		if(!next.selections.count("frames") && !next.selections.count("seconds") && !next.selections.count("replay-input")) {
+			std::cerr << file_name << ":" << line_number << ": " << next.name << " has no stop condition; use --frames, --seconds or --replay-input." << std::endl;
+			is_valid = false;
+		}
+		if(std::any_of(cases.begin(), cases.end(), [&next](const Case &existing) { return existing.name == next.name; })) {
+			std::cerr << file_name << ":" << line_number << ": " << next.name << " is a duplicate name." << std::endl;
+			is_valid = false;
+		}
+		cases.push_back(std::move(next));
+	}
+	return is_valid;
+}
+
+// MARK: - Running.
+
+enum class Status {
+	Passed,
+	Failed,
+	Error,
+	TimedOut,
+};
+
+const char *name(Status status) {
+	switch(status) {
+		case Status::Passed:	return "passed";
+		case Status::Failed:	return "failed";
+		case Status::Error:		return "error";
+		case Status::TimedOut:	return "timed out";
+	}
+	return "";
+}
+
+struct Result {
+	Status status = Status::Error;
+	std::string message;
+	Time::Seconds emulated = 0.0;
+	Time::Seconds host = 0.0;
+	uint64_t frames = 0;
+
+	/// Emulated seconds per host second.
+	double speed() const {
+		return host > 0.0 ? emulated / host : 0.0;
+	}
+};
+
+/// Applies all of @c selections to @c reflectable, as per clksignal.
+void apply(const std::map<std::string, std::string> &selections, Reflection::Struct *reflectable) {
+	if(!reflectable) return;
+	for(const auto &selection: selections) {
+		std::string property;
+		std::transform(selection.first.begin(), selection.first.end(), std::back_inserter(property), [](char c) { return c == '-' ? '_' : c; });
+
+		if(selection.second.empty()) {
+			Reflection::set<bool>(*reflectable, property, true);
+		} else {
+			Reflection::fuzzy_set(*reflectable, property, selection.second);
+		}
+	}
+}
+
+/// @returns The targets for @c test_case, as per clksignal: either --new or the first file that implies a machine.
+Analyser::Static::TargetList targets_for(const Case &test_case) {
+	Analyser::Static::TargetList targets;
+
+	const auto new_machine = test_case.selections.find("new");
+	if(new_machine != test_case.selections.end()) {
+		const auto short_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, false);
+		const auto long_names = Machine::AllMachines(Machine::Type::DoesntRequireMedia, true);
+		for(size_t c = 0; c < short_names.size(); c++) {
+			if(std::equal(
+				short_names[c].begin(), short_names[c].end(),
+				new_machine->second.begin(), new_machine->second.end(),
+				[](char a, char b) { return tolower(b) == tolower(a); })) {
+				auto targets_by_machine = Machine::TargetsByMachineName(false);
+				targets.push_back(std::move(targets_by_machine[long_names[c]]));
+				break;
+			}
+		}
+		return targets;
+	}
+
+	for(const auto &file_name: test_case.file_names) {
+		targets = Analyser::Static::GetTargets(file_name);
+		if(!targets.empty()) break;
+	}
+	return targets;
+}
+
+/// Compares the hashes in @c actual_file with those in @c expected_file.
+/// @returns An empty string if every expected frame was matched; a description of the first discrepancy otherwise.
+std::string compare_hashes(const std::string &actual_file, const std::string &expected_file) {
+	std::ifstream actual(actual_file), expected(expected_file);
+	if(!expected) return "unable to open expected hashes " + expected_file;
+	if(!actual) return "unable to reopen " + actual_file;
+
+	std::string actual_line, expected_line;
+	size_t frames = 0;
+	while(std::getline(expected, expected_line)) {
+		if(!std::getline(actual, actual_line)) {
+			return "ended after " + std::to_string(frames) + " frames; more were expected";
+		}
+		if(actual_line != expected_line) {
+			return "frame " + std::to_string(frames) + " differs: expected '" + expected_line + "', got '" + actual_line + "'";
+		}
+		++frames;
+	}
+	return "";
+}
+
+struct Farm {
+	std::vector<Case> cases;
+	std::vector<Result> results;
+	std::string output_directory;
+	Time::Seconds timeout = 600.0;
+
+	// Per-case progress, for the watchdog: the time at which each started, or 0 if not yet started,
+	// and whether each has finished.
+	std::unique_ptr<std::atomic<Time::Nanos>[]> start_times;
+	std::unique_ptr<std::atomic<bool>[]> is_finished;
+	std::atomic<size_t> completed = 0;
+
+	ROMMachine::ROMFetcher rom_fetcher;
+	std::mutex output_mutex;
+
+	void run(size_t index) {
+		start_times[index] = Time::nanos_now();
+		const Case &test_case = cases[index];
+		Result &result = results[index];
+
+		try {
+			perform(test_case, result);
+		} catch(...) {
+			result.status = Status::Error;
+			result.message = "an exception was thrown";
+		}
+
+		is_finished[index] = true;
+		const size_t count = ++completed;
+
+		std::lock_guard lock(output_mutex);
+		std::cout << "[" << count << "/" << cases.size() << "] " << test_case.name << ": " << name(result.status);
+		std::cout << std::fixed << std::setprecision(2) << " (" << result.speed() << "x)" << std::defaultfloat;
+		if(!result.message.empty()) std::cout << " — " << result.message;
+		std::cout << std::endl;
+	}
+
+	void perform(const Case &test_case, Result &result) {
+		const Time::Nanos start = Time::nanos_now();
+
+		auto targets = targets_for(test_case);
+		if(targets.empty()) {
+			result.message = "no target machine found";
+			return;
+		}
+		for(auto &target: targets) {
+			target->media = Analyser::Static::CopyOnWrite(target->media);
+			apply(test_case.selections, dynamic_cast<Reflection::Struct *>(target.get()));
+		}
+
+		// Construct the machine; it is constructed on this worker so any queues it creates will perform on the same pool.
+		Machine::Error error;
+		std::unique_ptr<Machine::DynamicMachine> machine(Machine::MachineForTargets(targets, rom_fetcher, error));
+		if(!machine) {
+			result.message = error == Machine::Error::MissingROM ? "missing ROMs" : "the machine could not be created";
+			return;
+		}
+
+		const auto configurable = machine->configurable_device();
+		if(configurable) {
+			const auto options = configurable->get_options();
+			apply(test_case.selections, options.get());
+			configurable->set_options(options);
+		}
+
+		// Parse stop conditions.
+		const auto number = [&test_case](const char *name) {
+			const auto selection = test_case.selections.find(name);
+			return selection == test_case.selections.end() ? 0.0 : std::strtod(selection->second.c_str(), nullptr);
+		};
+		const double frame_limit = number("frames");
+		const Time::Seconds seconds_limit = number("seconds");
+
+		// Hash all output; there's no other video or audio destination.
+		const std::string hashes_file = output_directory + test_case.name + ".hashes";
+		std::unique_ptr<Outputs::Display::FrameHasher> frame_hasher;
+		try {
+			frame_hasher = std::make_unique<Outputs::Display::FrameHasher>(hashes_file);
+		} catch(Storage::FileHolder::Error) {
+			result.message = "unable to open " + hashes_file;
+			return;
+		}
+		machine->scan_producer()->set_scan_target(frame_hasher.get());
+
+		const auto audio_producer = machine->audio_producer();
+		const auto speaker = audio_producer ? audio_producer->get_speaker() : nullptr;
+		if(speaker) {
+			speaker->set_output_rate(44100, 1024, speaker->get_is_stereo());
+			speaker->set_delegate(frame_hasher.get());
+		}
+
+		std::unique_ptr<Machine::InputPlayer> input_player;
+		const auto replay = test_case.selections.find("replay-input");
+		if(replay != test_case.selections.end()) {
+			try {
+				input_player = std::make_unique<Machine::InputPlayer>(*machine, replay->second);
+			} catch(Storage::FileHolder::Error) {
+				result.message = "unable to open " + replay->second;
+				return;
+			} catch(Machine::InputPlayer::Error) {
+				result.message = replay->second + " is not an input recording";
+				return;
+			}
+		}
+
+		// Run in slices of a hundredth of an emulated second, as per clksignal's headless mode,
+		// testing the stop conditions and the timeout after each.
+		const auto timed_machine = machine->timed_machine();
+		constexpr Time::Seconds slice = 0.01;
+		result.status = Status::Passed;
+		while(
+			(frame_limit == 0.0 || double(frame_hasher->frames()) < frame_limit) &&
+			(seconds_limit == 0.0 || result.emulated < seconds_limit)
+		) {
+			if(input_player) {
+				if(!input_player->run_for(slice)) break;
+			} else {
+				timed_machine->run_for(slice);
+			}
+			result.emulated += slice;
+
+			if(Time::seconds(Time::nanos_now() - start) > timeout) {
+				result.status = Status::TimedOut;
+				result.message = "exceeded " + std::to_string(int(timeout)) + " seconds";
+				break;
+			}
+		}
+		timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+		result.host = Time::seconds(Time::nanos_now() - start);
+		result.frames = frame_hasher->frames();
+
+		// Disconnect and close the hashes before comparing them.
+		if(speaker) speaker->set_delegate(nullptr);
+		machine->scan_producer()->set_scan_target(nullptr);
+		frame_hasher.reset();
+
+		const auto expected = test_case.selections.find("expected-hashes");
+		if(result.status == Status::Passed && expected != test_case.selections.end()) {
+			result.message = compare_hashes(hashes_file, expected->second);
+			if(!result.message.empty()) {
+				result.status = Status::Failed;
+			}
+		}
+	}
+};
+
+// MARK: - Reporting.
+
+std::string json_escape(const std::string &source) {
+	std::string result;
+	for(const char c: source) {
+		switch(c) {
+			case '"':	result += "\\\"";	break;
+			case '\\':	result += "\\\\";	break;
+			case '\n':	result += "\\n";	break;
+			case '\t':	result += "\\t";	break;
+			default:
+				if(uint8_t(c) < 0x20) {
+					char escape[7];
+					snprintf(escape, sizeof(escape), "\\u%04x", c);
+					result += escape;
+				} else {
+					result += c;
+				}
+			break;
+		}
+	}
+	return result;
+}
+
+std::string xml_escape(const std::string &source) {
+	std::string result;
+	for(const char c: source) {
+		switch(c) {
+			case '"':	result += "&quot;";	break;
+			case '&':	result += "&amp;";	break;
+			case '<':	result += "&lt;";	break;
+			case '>':	result += "&gt;";	break;
+			default:	result += c;		break;
+		}
+	}
+	return result;
+}
+
+void write_json(const std::string &file_name, const Farm &farm) {
+	std::ofstream file(file_name);
+	file << "[\n";
+	for(size_t c = 0; c < farm.cases.size(); c++) {
+		const auto &result = farm.results[c];
+		file << "\t{";
+		file << "\"name\": \"" << json_escape(farm.cases[c].name) << "\", ";
+		file << "\"status\": \"" << name(result.status) << "\", ";
+		file << "\"message\": \"" << json_escape(result.message) << "\", ";
+		file << "\"frames\": " << result.frames << ", ";
+		file << "\"emulated_seconds\": " << result.emulated << ", ";
+		file << "\"host_seconds\": " << result.host << ", ";
+		file << "\"speed\": " << result.speed();
+		file << "}" << (c + 1 < farm.cases.size() ? "," : "") << "\n";
+	}
+	file << "]\n";
+}
+
+void write_junit(const std::string &file_name, const Farm &farm) {
+	size_t failures = 0, errors = 0;
+	Time::Seconds total_time = 0.0;
+	for(const auto &result: farm.results) {
+		failures += result.status == Status::Failed;
+		errors += result.status == Status::Error || result.status == Status::TimedOut;
+		total_time += result.host;
+	}
+
+	std::ofstream file(file_name);
+	file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	file << "<testsuite name=\"clksignal-farm\" tests=\"" << farm.cases.size() << "\" failures=\"" << failures << "\" errors=\"" << errors << "\" time=\"" << total_time << "\">\n";
+	for(size_t c = 0; c < farm.cases.size(); c++) {
+		const auto &result = farm.results[c];
+		file << "\t<testcase classname=\"clksignal-farm\" name=\"" << xml_escape(farm.cases[c].name) << "\" time=\"" << result.host << "\">\n";
+		switch(result.status) {
+			case Status::Passed: break;
+			case Status::Failed:
+				file << "\t\t<failure message=\"" << xml_escape(result.message) << "\"/>\n";
+			break;
+			case Status::Error:
+			case Status::TimedOut:
+				file << "\t\t<error type=\"" << name(result.status) << "\" message=\"" << xml_escape(result.message) << "\"/>\n";
+			break;
+		}
+		file << "\t\t<system-out>" << result.frames << " frames; " << result.emulated << " emulated seconds; " << result.speed() << "x real time</system-out>\n";
+		file << "\t</testcase>\n";
+	}
+	file << "</testsuite>\n";
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	const Arguments arguments(argc, argv);
+	if(arguments.has("help") || arguments.file_names.size() != 1) {
+		std::cout << "Usage: clksignal-farm {manifest} [--json={file}] [--junit={file}] [--output={directory, default .}] [--threads={count}] [--timeout={host seconds per case, default 600}] [--fuzz-seed={number}] [--rompath={path}] [--emulation-cores={list, e.g. 0,2-3}] [--emulation-priority={default|elevated|realtime}]" << std::endl;
+		std::cout << "Runs every case in the manifest on a pool of workers, one machine per worker at a time, and reports the results." << std::endl;
+		std::cout << "Each line of a manifest is a case name followed by arguments as for clksignal: media, --new, machine options, --frames, --seconds and --replay-input, plus --expected-hashes={file} as written by --frame-hashes." << std::endl;
+		std::cout << "Frame hashes for each case are written to the output directory, which must exist." << std::endl;
+		std::cout << "A case that exceeds its timeout is stopped at the next hundredth of an emulated second; if any case remains stuck for twice its timeout then results so far are written and the farm exits." << std::endl;
+		std::cout << "Use --emulation-cores to pin each worker to one of the listed cores, and --emulation-priority to raise workers' priority where permitted; machines' audio and disk queues perform on the workers." << std::endl;
+		std::cout << "ROMs are sought in /usr/local/share/CLK/, /usr/share/CLK/ and any --rompath, each arranged as per ROMImages." << std::endl;
+		return arguments.has("help") ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	Farm farm;
+	if(!read_manifest(arguments.file_names[0], farm.cases)) {
+		return EXIT_FAILURE;
+	}
+	farm.results.resize(farm.cases.size());
+	farm.start_times = std::make_unique<std::atomic<Time::Nanos>[]>(farm.cases.size());
+	farm.is_finished = std::make_unique<std::atomic<bool>[]>(farm.cases.size());
+	for(size_t c = 0; c < farm.cases.size(); c++) {
+		farm.start_times[c] = 0;
+		farm.is_finished[c] = false;
+	}
+
+	farm.output_directory = arguments.get("output", ".");
+	if(farm.output_directory.back() != '/') farm.output_directory += '/';
+
+	farm.timeout = std::strtod(arguments.get("timeout", "600").c_str(), nullptr);
+	if(farm.timeout <= 0.0) {
+		std::cerr << "--timeout must be a positive number." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if(arguments.has("fuzz-seed")) {
+		Memory::SetFuzzSeed(std::strtoull(arguments.get("fuzz-seed", "0").c_str(), nullptr, 0));
+	}
+
+	// Place workers; this precedes creation of the pool so that all are affected.
+	// Machines' queues all perform on the pool, so no other thread role applies.
+	{
+		Concurrency::ThreadPlacement placement;
+		if(arguments.has("emulation-cores") && !Concurrency::ParseCores(arguments.get("emulation-cores", ""), placement.cores)) {
+			std::cerr << "Unable to parse --emulation-cores." << std::endl;
+			return EXIT_FAILURE;
+		}
+		if(arguments.has("emulation-priority") && !Concurrency::ParsePriority(arguments.get("emulation-priority", ""), placement.priority)) {
+			std::cerr << "Unrecognised --emulation-priority." << std::endl;
+			return EXIT_FAILURE;
+		}
+		Concurrency::SetThreadPlacement(Concurrency::ThreadRole::Emulation, placement);
+	}
+
+	// Share a single ROM index amongst all workers.
+	std::vector<std::string> rom_paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/",
+	};
+	if(arguments.has("rompath")) {
+		std::string path = arguments.get("rompath", "");
+		if(!path.empty() && path.back() != '/') path += '/';
+		rom_paths.push_back(path);
+	}
+	auto rom_index = std::make_shared<ROM::Index>(rom_paths);
+	auto rom_mutex = std::make_shared<std::mutex>();
+	farm.rom_fetcher = [rom_index, rom_mutex] (const ROM::Request &request) {
+		std::lock_guard lock(*rom_mutex);
+		return rom_index->find(request);
+	};
+
+	const auto write_results = [&] {
+		if(arguments.has("json")) write_json(arguments.get("json", ""), farm);
+		if(arguments.has("junit")) write_junit(arguments.get("junit", ""), farm);
+	};
+
+	// Submit all cases, then watch for any that are stuck.
+	const size_t threads = size_t(std::strtoul(arguments.get("threads", "0").c_str(), nullptr, 10));
+	Concurrency::WorkStealingPool pool(threads);
+	for(size_t c = 0; c < farm.cases.size(); c++) {
+		pool.submit([&farm, c] {
+			farm.run(c);
+		});
+	}
+
+	while(farm.completed < farm.cases.size()) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+		const Time::Nanos now = Time::nanos_now();
+		for(size_t c = 0; c < farm.cases.size(); c++) {
+			const Time::Nanos start = farm.start_times[c];
+			if(!start || farm.is_finished[c] || Time::seconds(now - start) < 2.0 * farm.timeout) continue;
+
+			// A worker can't be interrupted, so all that can be done is to report and exit.
+			std::lock_guard lock(farm.output_mutex);
+			for(size_t d = 0; d < farm.cases.size(); d++) {
+				if(farm.is_finished[d]) continue;
+				farm.results[d].status = farm.start_times[d] ? Status::TimedOut : Status::Error;
+				farm.results[d].message = farm.start_times[d] ? "stuck within a single slice" : "not run";
+			}
+			std::cerr << farm.cases[c].name << " is stuck; exiting." << std::endl;
+			write_results();
+			std::_Exit(EXIT_FAILURE);
+		}
+	}
+
+	write_results();
+
+	size_t passed = 0;
+	for(const auto &result: farm.results) {
+		passed += result.status == Status::Passed;
+	}
+	std::cout << passed << " of " << farm.cases.size() << " passed." << std::endl;
+	return passed == farm.cases.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,7 +15,7 @@
 #include <cmath>
 
 #include "BufferingScanTarget.hpp"
-#include "FIRFilter.hpp"
+#include "PipelineDescription.hpp"
 
 /*
 
@@ -129,6 +129,9 @@ struct Uniforms {
 constexpr size_t NumBufferedLines = 500;
 constexpr size_t NumBufferedScans = NumBufferedLines * 4;
 
+/// The maximum number of frame-buffer updates that may be in flight on the GPU at once; beyond this the CPU waits.
+constexpr long MaxFramesInFlight = 3;
+
 /// The shared resource options this app would most favour; applied as widely as possible.
 constexpr MTLResourceOptions SharedResourceOptionsStandard = MTLResourceCPUCacheModeWriteCombined | MTLResourceStorageModeShared;
 
@@ -149,37 +152,6 @@ constexpr MTLResourceOptions SharedResourceOptionsTexture = MTLResourceCPUCacheM
 		}	\
 	}
 
-/// @returns the proper 1d kernel to apply a box filter around a certain point a pixel density of @c radiansPerPixel and applying an
-///		angular limit of @c cutoff. The values returned will be the first eight of a fifteen-point filter that is symmetrical around its centre.
-std::array<float, 8> boxCoefficients(float radiansPerPixel, float cutoff) {
-	std::array<float, 8> filter;
-	float total = 0.0f;
-
-	for(size_t c = 0; c < 8; ++c) {
-		// This coefficient occupies the angular window [6.5-c, 7.5-c]*radiansPerPixel.
-		const float startAngle = (6.5f - float(c)) * radiansPerPixel;
-		const float endAngle = (7.5f - float(c)) * radiansPerPixel;
-
-		float coefficient = 0.0f;
-		if(endAngle < cutoff) {
-			coefficient = 1.0f;
-		} else if(startAngle >= cutoff) {
-			coefficient = 0.0f;
-		} else {
-			coefficient = (cutoff - startAngle) / radiansPerPixel;
-		}
-		total += 2.0f * coefficient;	// All but the centre coefficient will be used twice.
-		filter[c] = coefficient;
-	}
-	total = total - filter[7];			// As per above; ensure the centre coefficient is counted only once.
-
-	for(size_t c = 0; c < 8; ++c) {
-		filter[c] /= total;
-	}
-
-	return filter;
-}
-
 }
 
 using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
@@ -209,6 +181,13 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	size_t _bytesPerInputPixel;			// Determines per-pixel sizing within the write-area texture.
 	size_t _totalTextureBytes;			// Holds the total size of the write-area texture.
 
+	// Textures: palettes.
+	//
+	// Each row of the write area that holds Palette8 data is accompanied by a row of this texture, holding
+	// the palette that applies. So it is also written by the CPU and read by the GPU.
+	id<MTLTexture> _paletteTexture;
+	id<MTLBuffer> _paletteBuffer;		// The storage underlying the palette texture.
+
 	// Textures: the frame buffer.
 	//
 	// When inter-frame blending is in use, the frame buffer contains the most recent output.
@@ -263,10 +242,10 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	id<MTLComputePipelineState> _separatedLumaState;
 	NSUInteger _lineBufferPixelsPerLine;
 
-	size_t _lineOffsetBuffer;
-	id<MTLBuffer> _lineOffsetBuffers[NumBufferedLines];	// Allocating NumBufferedLines buffers ensures these can't possibly be exhausted;
-														// for this list to be exhausted there'd have to be more draw calls in flight than
-														// there are lines for them to operate upon.
+	id<MTLComputePipelineState> _clearState;
+
+	// Paces frame-buffer updates so that the CPU can run at most MaxFramesInFlight ahead of the GPU.
+	dispatch_semaphore_t _framesInFlight;
 
 	// The scan target in C++-world terms and the non-GPU storage for it.
 	BufferingScanTarget _scanTarget;
@@ -305,8 +284,26 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 			newBufferWithLength:BufferingScanTarget::WriteAreaWidth*BufferingScanTarget::WriteAreaHeight*4
 			options:SharedResourceOptionsTexture];
 
+		// Allocate a buffer for palettes; this never changes format so its texture can be created immediately.
+		constexpr NSUInteger paletteBytesPerRow = Outputs::Display::ScanTarget::PaletteSize * 4;
+		_paletteBuffer = [view.device
+			newBufferWithLength:paletteBytesPerRow*BufferingScanTarget::WriteAreaHeight
+			options:SharedResourceOptionsTexture];
+
+		MTLTextureDescriptor *const paletteTextureDescriptor = [MTLTextureDescriptor
+			texture2DDescriptorWithPixelFormat:MTLPixelFormatRGBA8Unorm
+			width:Outputs::Display::ScanTarget::PaletteSize
+			height:BufferingScanTarget::WriteAreaHeight
+			mipmapped:NO];
+		paletteTextureDescriptor.resourceOptions = SharedResourceOptionsTexture;
+		_paletteTexture = [_paletteBuffer
+			newTextureWithDescriptor:paletteTextureDescriptor
+			offset:0
+			bytesPerRow:paletteBytesPerRow];
+
 		// Install all that storage in the buffering scan target.
 		_scanTarget.set_write_area(reinterpret_cast<uint8_t *>(_writeAreaBuffer.contents));
+		_scanTarget.set_palette_area(reinterpret_cast<uint32_t *>(_paletteBuffer.contents));
 		_scanTarget.set_line_buffer(reinterpret_cast<BufferingScanTarget::Line *>(_linesBuffer.contents), _lineMetadataBuffer, NumBufferedLines);
 		_scanTarget.set_scan_buffer(reinterpret_cast<BufferingScanTarget::Scan *>(_scansBuffer.contents), NumBufferedScans);
 
@@ -333,12 +330,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		depthStencilDescriptor.frontFaceStencil.stencilFailureOperation = MTLStencilOperationReplace;
 		_clearStencilState = [view.device newDepthStencilStateWithDescriptor:depthStencilDescriptor];
 
-		// Allocate a large number of single-int buffers, for supplying offsets to the compute shaders.
-		// There's a ridiculous amount of overhead in this, but it avoids allocations during drawing,
-		// and a single int per instance is all I need.
-		for(size_t c = 0; c < NumBufferedLines; ++c) {
-			_lineOffsetBuffers[c] = [_view.device newBufferWithLength:sizeof(int) options:SharedResourceOptionsStandard];
-		}
+		// Generate the texture-clearing kernel once, rather than upon each use.
+		_clearState = [_view.device newComputePipelineStateWithFunction:[library newFunctionWithName:@"clearKernel"] error:nil];
+
+		// Allow up to MaxFramesInFlight frame-buffer updates to be queued before waiting for the GPU.
+		_framesInFlight = dispatch_semaphore_create(MaxFramesInFlight);
 
 		// Ensure the is-drawing flag is initially clear.
 		_isDrawing.clear();
@@ -462,15 +458,12 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 }
 
 - (void)clearTexture:(id<MTLTexture>)texture {
-	id<MTLLibrary> library = [_view.device newDefaultLibrary];
-
 	// Ensure finalised line texture is initially clear.
-	id<MTLComputePipelineState> clearPipeline = [_view.device newComputePipelineStateWithFunction:[library newFunctionWithName:@"clearKernel"] error:nil];
 	id<MTLCommandBuffer> commandBuffer = [_commandQueue commandBuffer];
 	id<MTLComputeCommandEncoder> computeEncoder = [commandBuffer computeCommandEncoder];
 
 	[computeEncoder setTexture:texture atIndex:0];
-	[self dispatchComputeCommandEncoder:computeEncoder pipelineState:clearPipeline width:texture.width height:texture.height offsetBuffer:[self bufferForOffset:0]];
+	[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_clearState width:texture.width height:texture.height offset:0];
 
 	[computeEncoder endEncoding];
 	[commandBuffer commit];
@@ -586,6 +579,9 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 }
 
 - (void)setModals:(const Outputs::Display::ScanTarget::Modals &)modals {
+	const float displayGamma = 2.2f;	// This is assumed.
+	const Outputs::Display::PipelineDescription pipeline(modals, displayGamma);
+
 	//
 	// Populate uniforms.
 	//
@@ -594,14 +590,14 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	uniforms()->lineWidth = 1.05f / modals.expected_vertical_lines;
 	[self setAspectRatio];
 
-	const auto toRGB = to_rgb_matrix(modals.composite_colour_space);
+	const auto &toRGB = pipeline.to_rgb;
 	uniforms()->toRGB = simd::float3x3(
 		simd::float3{toRGB[0], toRGB[1], toRGB[2]},
 		simd::float3{toRGB[3], toRGB[4], toRGB[5]},
 		simd::float3{toRGB[6], toRGB[7], toRGB[8]}
 	);
 
-	const auto fromRGB = from_rgb_matrix(modals.composite_colour_space);
+	const auto &fromRGB = pipeline.from_rgb;
 	uniforms()->fromRGB = simd::float3x3(
 		simd::float3{fromRGB[0], fromRGB[1], fromRGB[2]},
 		simd::float3{fromRGB[3], fromRGB[4], fromRGB[5]},
@@ -611,10 +607,8 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	// This is fixed for now; consider making it a function of frame rate and/or of whether frame syncing
 	// is ongoing (which would require a way to signal that to this scan target).
 	uniforms()->outputAlpha = __fp16(0.64f);
-	uniforms()->outputMultiplier = __fp16(modals.brightness);
-
-	const float displayGamma = 2.2f;	// This is assumed.
-	uniforms()->outputGamma = __fp16(displayGamma / modals.intended_gamma);
+	uniforms()->outputMultiplier = __fp16(pipeline.output_multiplier);
+	uniforms()->outputGamma = __fp16(pipeline.output_gamma);
 
 
 
@@ -664,16 +658,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	id<MTLLibrary> library = [_view.device newDefaultLibrary];
 	MTLRenderPipelineDescriptor *pipelineDescriptor = [[MTLRenderPipelineDescriptor alloc] init];
 
-	// Occasions when the composition buffer isn't required are slender: the output must be neither RGB nor composite monochrome.
-	const bool isComposition =
-		modals.display_type != Outputs::Display::DisplayType::RGB &&
-		modals.display_type != Outputs::Display::DisplayType::CompositeMonochrome;
-	const bool isSVideoOutput = modals.display_type == Outputs::Display::DisplayType::SVideo;
-
-	if(!isComposition) {
-		_pipeline = Pipeline::DirectToDisplay;
-	} else {
-		_pipeline = isSVideoOutput ? Pipeline::SVideo : Pipeline::CompositeColour;
+	const bool isSVideoOutput = pipeline.type == Outputs::Display::PipelineDescription::Type::SVideo;
+	switch(pipeline.type) {
+		case Outputs::Display::PipelineDescription::Type::DirectToDisplay:	_pipeline = Pipeline::DirectToDisplay;	break;
+		case Outputs::Display::PipelineDescription::Type::SVideo:			_pipeline = Pipeline::SVideo;			break;
+		case Outputs::Display::PipelineDescription::Type::CompositeColour:	_pipeline = Pipeline::CompositeColour;	break;
 	}
 
 	struct FragmentSamplerDictionary {
@@ -691,7 +680,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		/// Fragment shader that outputs directly as RGB, with gamma correction.
 		NSString *const directRGBWithGamma;
 	};
-	const FragmentSamplerDictionary samplerDictionary[8] = {
+	const FragmentSamplerDictionary samplerDictionary[9] = {
 		// Composite formats.
 		{@"compositeSampleLuminance1", 				nil,	@"sampleLuminance1",				@"sampleLuminance1",						@"sampleLuminance1",				@"sampleLuminance1"},
 		{@"compositeSampleLuminance8", 				nil,	@"sampleLuminance8", 				@"sampleLuminance8WithGamma",				@"sampleLuminance8", 				@"sampleLuminance8WithGamma"},
@@ -705,11 +694,14 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		{@"compositeSampleRed2Green2Blue2", @"svideoSampleRed2Green2Blue2", @"directCompositeSampleRed2Green2Blue2", @"directCompositeSampleRed2Green2Blue2WithGamma", @"sampleRed2Green2Blue2", @"sampleRed2Green2Blue2WithGamma"},
 		{@"compositeSampleRed4Green4Blue4", @"svideoSampleRed4Green4Blue4", @"directCompositeSampleRed4Green4Blue4", @"directCompositeSampleRed4Green4Blue4WithGamma", @"sampleRed4Green4Blue4", @"sampleRed4Green4Blue4WithGamma"},
 		{@"compositeSampleRed8Green8Blue8", @"svideoSampleRed8Green8Blue8", @"directCompositeSampleRed8Green8Blue8", @"directCompositeSampleRed8Green8Blue8WithGamma", @"sampleRed8Green8Blue8", @"sampleRed8Green8Blue8WithGamma"},
+
+		// Palette formats.
+		{@"compositeSamplePalette8", @"svideoSamplePalette8", @"directCompositeSamplePalette8", @"directCompositeSamplePalette8WithGamma", @"samplePalette8", @"samplePalette8WithGamma"},
 	};
 
 #ifndef NDEBUG
 	// Do a quick check that all the shaders named above are defined in the Metal code. I don't think this is possible at compile time.
-	for(int c = 0; c < 8; ++c) {
+	for(int c = 0; c < 9; ++c) {
 #define Test(x)	if(samplerDictionary[c].x)	assert([library newFunctionWithName:samplerDictionary[c].x]);
 		Test(compositionComposite);
 		Test(compositionSVideo);
@@ -721,85 +713,17 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	}
 #endif
 
-	uniforms()->cyclesMultiplier = 1.0f;
+	uniforms()->cyclesMultiplier = float(pipeline.cycles_multiplier);
 	if(_pipeline != Pipeline::DirectToDisplay) {
-		// Pick a suitable cycle multiplier.
-		const float minimumSize = 4.0f * float(modals.colour_cycle_numerator) / float(modals.colour_cycle_denominator);
-		while(uniforms()->cyclesMultiplier * modals.cycles_per_line < minimumSize) {
-			uniforms()->cyclesMultiplier += 1.0f;
-
-			if(uniforms()->cyclesMultiplier * modals.cycles_per_line > 2048) {
-				uniforms()->cyclesMultiplier -= 1.0f;
-				break;
-			}
-		}
-
-		// Create suitable filters.
-		_lineBufferPixelsPerLine = NSUInteger(modals.cycles_per_line) * NSUInteger(uniforms()->cyclesMultiplier);
-		const float colourCyclesPerLine = float(modals.colour_cycle_numerator) / float(modals.colour_cycle_denominator);
-
-		// Compute radians per pixel.
-		const float radiansPerPixel = (colourCyclesPerLine * 3.141592654f * 2.0f) / float(_lineBufferPixelsPerLine);
-
-		// Generate the chrominance filter.
-		{
-			simd::float3 firCoefficients[8];
-			const auto chromaCoefficients = boxCoefficients(radiansPerPixel, 3.141592654f * 2.0f);
-			_chromaKernelSize = 15;
-			for(size_t c = 0; c < 8; ++c) {
-				// Bit of a fix here: if the pipeline is for composite then assume that chroma separation wasn't
-				// perfect and deemphasise the colour.
-				firCoefficients[c].y = firCoefficients[c].z = (isSVideoOutput ? 2.0f : 1.25f) * chromaCoefficients[c];
-				firCoefficients[c].x = 0.0f;
-				if(fabsf(chromaCoefficients[c]) < 0.01f) {
-					_chromaKernelSize -= 2;
-				}
-			}
-			firCoefficients[7].x = 1.0f;
-
-			// Luminance will be very soft as a result of the separation phase; apply a sharpen filter to try to undo that.
-			//
-			// This is applied separately in order to partition three parts of the signal rather than two:
-			//
-			//	1) the luminance;
-			//	2) not the luminance:
-			//		2a) the chrominance; and
-			//		2b) some noise.
-			//
-			// There are real numerical hazards here given the low number of taps I am permitting to be used, so the sharpen
-			// filter below is just one that I found worked well. Since all numbers are fixed, the actual cutoff frequency is
-			// going to be a function of the input clock, which is a bit phoney but the best way to stay safe within the
-			// PCM sampling limits.
-			if(!isSVideoOutput) {
-				SignalProcessing::FIRFilter sharpenFilter(15, 1368, 60.0f, 227.5f);
-				const auto sharpen = sharpenFilter.get_coefficients();
-				size_t sharpenFilterSize = 15;
-				bool isStart = true;
-				for(size_t c = 0; c < 8; ++c) {
-					firCoefficients[c].x = sharpen[c];
-					if(fabsf(sharpen[c]) > 0.01f) isStart = false;
-					if(isStart) sharpenFilterSize -= 2;
-				}
-				_chromaKernelSize = std::max(_chromaKernelSize, sharpenFilterSize);
-			}
-
-			// Convert to half-size floats.
-			for(size_t c = 0; c < 8; ++c) {
-				uniforms()->chromaKernel[c] = firCoefficients[c];
-			}
-		}
-
-		// Generate the luminance separation filter and determine its required size.
-		{
-			auto *const filter = uniforms()->lumaKernel;
-			const auto coefficients = boxCoefficients(radiansPerPixel, 3.141592654f);
-			_lumaKernelSize = 15;
-			for(size_t c = 0; c < 8; ++c) {
-				filter[c] = __fp16(coefficients[c]);
-				if(fabsf(coefficients[c]) < 0.01f) {
-					_lumaKernelSize -= 2;
-				}
-			}
+		_lineBufferPixelsPerLine = NSUInteger(pipeline.line_buffer_pixels_per_line);
+
+		// Convert filters to half-size floats.
+		_chromaKernelSize = pipeline.chroma_kernel_size;
+		_lumaKernelSize = pipeline.luma_kernel_size;
+		for(size_t c = 0; c < 8; ++c) {
+			const auto &coefficients = pipeline.chroma_kernel[c];
+			uniforms()->chromaKernel[c] = simd::float3{coefficients[0], coefficients[1], coefficients[2]};
+			uniforms()->lumaKernel[c] = __fp16(pipeline.luma_kernel[c]);
 		}
 	}
 
@@ -866,6 +790,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 		[encoder setVertexBuffer:_linesBuffer offset:0 atIndex:0];
 	} else {
 		[encoder setFragmentTexture:_writeAreaTexture atIndex:0];
+		[encoder setFragmentTexture:_paletteTexture atIndex:1];
 		[encoder setVertexBuffer:_scansBuffer offset:0 atIndex:0];
 	}
 	[encoder setVertexBuffer:_uniformsBuffer offset:0 atIndex:1];
@@ -914,6 +839,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 
 	[encoder setFragmentBuffer:_uniformsBuffer offset:0 atIndex:0];
 	[encoder setFragmentTexture:_writeAreaTexture atIndex:0];
+	[encoder setFragmentTexture:_paletteTexture atIndex:1];
 
 #define OutputScans(start, size)	[encoder drawPrimitives:MTLPrimitiveTypeLine vertexStart:0 vertexCount:2 instanceCount:size baseInstance:start]
 	RangePerform(outputArea.start.scan, outputArea.end.scan, NumBufferedScans, OutputScans);
@@ -921,16 +847,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	[encoder endEncoding];
 }
 
-- (id<MTLBuffer>)bufferForOffset:(size_t)offset {
-	// Store and apply the offset.
-	const auto buffer = _lineOffsetBuffers[_lineOffsetBuffer];
-	*(reinterpret_cast<int *>(_lineOffsetBuffers[_lineOffsetBuffer].contents)) = int(offset);
-	_lineOffsetBuffer = (_lineOffsetBuffer + 1) % NumBufferedLines;
-	return buffer;
-}
-
-- (void)dispatchComputeCommandEncoder:(id<MTLComputeCommandEncoder>)encoder pipelineState:(id<MTLComputePipelineState>)pipelineState width:(NSUInteger)width height:(NSUInteger)height offsetBuffer:(id<MTLBuffer>)offsetBuffer {
-	[encoder setBuffer:offsetBuffer offset:0 atIndex:1];
+- (void)dispatchComputeCommandEncoder:(id<MTLComputeCommandEncoder>)encoder pipelineState:(id<MTLComputePipelineState>)pipelineState width:(NSUInteger)width height:(NSUInteger)height offset:(size_t)offset {
+	// The offset is small enough to be supplied inline, which Metal copies into the command buffer; no buffer
+	// need be allocated or kept alive for it.
+	const int lineOffset = int(offset);
+	[encoder setBytes:&lineOffset length:sizeof(lineOffset) atIndex:1];
 
 	// This follows the recommendations at https://developer.apple.com/documentation/metal/calculating_threadgroup_and_grid_sizes ;
 	// I currently have no independent opinion whatsoever.
@@ -960,6 +881,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 	@synchronized(self) {
 		if(!_frameBufferRenderPass) return;
 
+		// Don't get more than MaxFramesInFlight ahead of the GPU; scans and lines are written directly into
+		// shared buffers so there's nothing to copy, but an unbounded queue would only add latency.
+		dispatch_semaphore_wait(_framesInFlight, DISPATCH_TIME_FOREVER);
+		dispatch_semaphore_t framesInFlight = _framesInFlight;
+
 		const auto outputArea = _scanTarget.get_output_area();
 
 		if(outputArea.end.line != outputArea.start.line) {
@@ -971,6 +897,16 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 			RangePerform(writeAreaModificationStart, writeAreaModificationEnd, _totalTextureBytes, FlushRegion);
 #undef FlushRegion
 
+			// Palettes are modified only alongside the write area rows they accompany.
+			if(_scanTarget.modals().input_data_type == Outputs::Display::InputDataType::Palette8) {
+				constexpr size_t paletteBytesPerRow = Outputs::Display::ScanTarget::PaletteSize * 4;
+				const auto paletteModificationStart = size_t(outputArea.start.write_area_y) * paletteBytesPerRow;
+				const auto paletteModificationEnd = size_t(outputArea.end.write_area_y + 1) * paletteBytesPerRow;
+#define FlushRegion(start, size)	[_paletteBuffer didModifyRange:NSMakeRange(start, size)]
+				RangePerform(paletteModificationStart, paletteModificationEnd, paletteBytesPerRow * BufferingScanTarget::WriteAreaHeight, FlushRegion);
+#undef FlushRegion
+			}
+
 			// Obtain a source for render command encoders.
 			id<MTLCommandBuffer> commandBuffer = [_commandQueue commandBuffer];
 
@@ -1021,11 +957,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 						[computeEncoder setBuffer:_uniformsBuffer offset:0 atIndex:0];
 
 						if(outputArea.end.line > outputArea.start.line) {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offsetBuffer:[self bufferForOffset:outputArea.start.line]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offset:outputArea.start.line];
 						} else {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offsetBuffer:[self bufferForOffset:outputArea.start.line]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offset:outputArea.start.line];
 							if(outputArea.end.line) {
-								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line offsetBuffer:[self bufferForOffset:0]];
+								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line offset:0];
 							}
 						}
 
@@ -1037,16 +973,12 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 						[computeEncoder setTexture:_separatedLumaTexture atIndex:1];
 						[computeEncoder setBuffer:_uniformsBuffer offset:0 atIndex:0];
 
-						__unsafe_unretained id<MTLBuffer> offsetBuffers[2] = {nil, nil};
-						offsetBuffers[0] = [self bufferForOffset:outputArea.start.line];
-
 						if(outputArea.end.line > outputArea.start.line) {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offsetBuffer:offsetBuffers[0]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offset:outputArea.start.line];
 						} else {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offsetBuffer:offsetBuffers[0]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offset:outputArea.start.line];
 							if(outputArea.end.line) {
-								offsetBuffers[1] = [self bufferForOffset:0];
-								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:outputArea.end.line offsetBuffer:offsetBuffers[1]];
+								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_separatedLumaState width:_lineBufferPixelsPerLine height:outputArea.end.line offset:0];
 							}
 						}
 
@@ -1056,11 +988,11 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 						[computeEncoder setBuffer:_uniformsBuffer offset:0 atIndex:0];
 
 						if(outputArea.end.line > outputArea.start.line) {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offsetBuffer:offsetBuffers[0]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line - outputArea.start.line offset:outputArea.start.line];
 						} else {
-							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offsetBuffer:offsetBuffers[0]];
+							[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:NumBufferedLines - outputArea.start.line offset:outputArea.start.line];
 							if(outputArea.end.line) {
-								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line offsetBuffer:offsetBuffers[1]];
+								[self dispatchComputeCommandEncoder:computeEncoder pipelineState:_finalisedLineState width:_lineBufferPixelsPerLine height:outputArea.end.line offset:0];
 							}
 						}
 
@@ -1089,6 +1021,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 			// Add a callback to update the scan target buffer and commit the drawing.
 			[commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull) {
 				self->_scanTarget.complete_output_area(outputArea);
+				dispatch_semaphore_signal(framesInFlight);
 			}];
 			[commandBuffer commit];
 		} else {
@@ -1098,6 +1031,7 @@ using BufferingScanTarget = Outputs::Display::BufferingScanTarget;
 			id<MTLCommandBuffer> commandBuffer = [_commandQueue commandBuffer];
 			[commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> _Nonnull) {
 				self->_scanTarget.complete_output_area(outputArea);
+				dispatch_semaphore_signal(framesInFlight);
 			}];
 			[commandBuffer commit];
 
@@ -328,38 +328,45 @@ fragment half4 directCompositeSampleLuminance8Phase8WithGamma(SourceInterpolator
 }
 
 
-// All the RGB formats can produce RGB, composite or S-Video.
+// All the RGB formats can produce RGB, composite or S-Video. Each is also supplied with the
+// palette texture, though only Palette8 makes use of it.
 
-half3 convertRed8Green8Blue8(SourceInterpolator vert, texture2d<half> texture) {
+half3 convertRed8Green8Blue8(SourceInterpolator vert, texture2d<half> texture, texture2d<half>) {
 	return texture.sample(standardSampler, vert.textureCoordinates).rgb;
 }
 
-half3 convertRed4Green4Blue4(SourceInterpolator vert, texture2d<ushort> texture) {
+half3 convertRed4Green4Blue4(SourceInterpolator vert, texture2d<ushort> texture, texture2d<half>) {
 	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).rg;
 	return half3(sample.r&15, (sample.g >> 4)&15, sample.g&15) / 15.0f;
 }
 
-half3 convertRed2Green2Blue2(SourceInterpolator vert, texture2d<ushort> texture) {
+half3 convertRed2Green2Blue2(SourceInterpolator vert, texture2d<ushort> texture, texture2d<half>) {
 	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).r;
 	return half3((sample >> 4)&3, (sample >> 2)&3, sample&3) / 3.0f;
 }
 
-half3 convertRed1Green1Blue1(SourceInterpolator vert, texture2d<ushort> texture) {
+half3 convertRed1Green1Blue1(SourceInterpolator vert, texture2d<ushort> texture, texture2d<half>) {
 	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).r;
 	return clamp(half3(sample&4, sample&2, sample&1), half(0.0f), half(1.0f));
 }
 
+half3 convertPalette8(SourceInterpolator vert, texture2d<ushort> texture, texture2d<half> palette) {
+	// The palette for each row of the write area is in the same row of the palette texture.
+	const auto sample = texture.sample(standardSampler, vert.textureCoordinates).r;
+	return palette.read(uint2(sample, uint(vert.textureCoordinates.y))).rgb;
+}
+
 #define DeclareShaders(name, pixelType)	\
-	fragment half4 sample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
-		return half4(convert##name(vert, texture), uniforms.outputAlpha);	\
+	fragment half4 sample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+		return half4(convert##name(vert, texture, palette), uniforms.outputAlpha);	\
 	}	\
 	\
-	fragment half4 sample##name##WithGamma(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
-		return half4(pow(convert##name(vert, texture), uniforms.outputGamma), uniforms.outputAlpha);	\
+	fragment half4 sample##name##WithGamma(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+		return half4(pow(convert##name(vert, texture, palette), uniforms.outputGamma), uniforms.outputAlpha);	\
 	}	\
 	\
-	fragment half4 svideoSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
-		const auto colour = uniforms.fromRGB * convert##name(vert, texture);	\
+	fragment half4 svideoSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+		const auto colour = uniforms.fromRGB * convert##name(vert, texture, palette);	\
 		const half2 qam = quadrature(vert.colourPhase);	\
 		const half chroma = dot(colour.gb, qam);	\
 		return half4(	\
@@ -369,23 +376,23 @@ half3 convertRed1Green1Blue1(SourceInterpolator vert, texture2d<ushort> texture)
 		);	\
 	}	\
 	\
-	half composite##name(SourceInterpolator vert, texture2d<pixelType> texture, constant Uniforms &uniforms, half2 colourSubcarrier) {	\
-		const auto colour = uniforms.fromRGB * convert##name(vert, texture);	\
+	half composite##name(SourceInterpolator vert, texture2d<pixelType> texture, texture2d<half> palette, constant Uniforms &uniforms, half2 colourSubcarrier) {	\
+		const auto colour = uniforms.fromRGB * convert##name(vert, texture, palette);	\
 		return mix(colour.r, dot(colour.gb, colourSubcarrier), half(vert.colourAmplitude));	\
 	}	\
 	\
-	fragment half4 compositeSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+	fragment half4 compositeSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
 		const half2 colourSubcarrier = quadrature(vert.colourPhase);	\
-		return composite(composite##name(vert, texture, uniforms, colourSubcarrier), colourSubcarrier, vert.colourAmplitude);	\
+		return composite(composite##name(vert, texture, palette, uniforms, colourSubcarrier), colourSubcarrier, vert.colourAmplitude);	\
 	}	\
 	\
-	fragment half4 directCompositeSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
-		const half level = composite##name(vert, texture, uniforms, quadrature(vert.colourPhase)); 	\
+	fragment half4 directCompositeSample##name(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+		const half level = composite##name(vert, texture, palette, uniforms, quadrature(vert.colourPhase)); 	\
 		return half4(half3(level), uniforms.outputAlpha);	\
 	}	\
 	\
-	fragment half4 directCompositeSample##name##WithGamma(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
-		const half level = pow(composite##name(vert, texture, uniforms, quadrature(vert.colourPhase)), uniforms.outputGamma); 	\
+	fragment half4 directCompositeSample##name##WithGamma(SourceInterpolator vert [[stage_in]], texture2d<pixelType> texture [[texture(0)]], texture2d<half> palette [[texture(1)]], constant Uniforms &uniforms [[buffer(0)]]) {	\
+		const half level = pow(composite##name(vert, texture, palette, uniforms, quadrature(vert.colourPhase)), uniforms.outputGamma); 	\
 		return half4(half3(level), uniforms.outputAlpha);	\
 	}
 
@@ -393,6 +400,7 @@ DeclareShaders(Red8Green8Blue8, half)
 DeclareShaders(Red4Green4Blue4, ushort)
 DeclareShaders(Red2Green2Blue2, ushort)
 DeclareShaders(Red1Green1Blue1, ushort)
+DeclareShaders(Palette8, ushort)
 
 fragment half4 copyFragment(CopyInterpolator vert [[stage_in]], texture2d<half> texture [[texture(0)]]) {
 	return texture.sample(standardSampler, vert.textureCoordinates);
@@ -0,0 +1,116 @@
+//
+//  6502InstructionLevelTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/6502/AllRAM/6502AllRAM.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace {
+
+/// Records the address and time of every opcode fetch.
+struct FetchRecorder: public CPU::AllRAMProcessor::TrapHandler {
+	struct Fetch {
+		uint16_t address;
+		HalfCycles time;
+
+		bool operator ==(const Fetch &rhs) const {
+			return address == rhs.address && time == rhs.time;
+		}
+	};
+	std::vector<Fetch> fetches;
+
+	void processor_did_trap(CPU::AllRAMProcessor &processor, uint16_t address) final {
+		fetches.push_back(Fetch{address, processor.get_timestamp()});
+	}
+};
+
+/// An all-RAM 6502 with the functional test loaded and ready to run, recording its opcode fetches.
+struct FunctionalTest {
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor;
+	FetchRecorder recorder;
+
+	FunctionalTest(CPU::MOS6502Esque::Type type, NSData *test) :
+		processor(CPU::MOS6502::AllRAMProcessor::Processor(type)) {
+		processor->set_data_at_address(0, test.length, reinterpret_cast<const uint8_t *>(test.bytes));
+		processor->set_value_of_register(CPU::MOS6502Esque::Register::ProgramCounter, 0x400);
+
+		processor->set_trap_handler(&recorder);
+		for(int address = 0; address < 65536; address++) {
+			processor->add_trap_address(uint16_t(address));
+		}
+	}
+};
+
+}
+
+@interface InstructionLevel6502Tests : XCTestCase
+@end
+
+@implementation InstructionLevel6502Tests
+
+/// Runs Klaus Dormann's functional test on both the cycle-accurate and instruction-level 6502s, confirming that
+/// every opcode fetch occurs at the same address and time in each, and that both reach the test's success trap.
+- (void)testFunctionalTestInLockstep {
+	NSString *const path = [[NSBundle bundleForClass:[self class]] pathForResource:@"6502_functional_test" ofType:@"bin"];
+	NSData *const test = [NSData dataWithContentsOfFile:path];
+	XCTAssertNotNil(test);
+	if(!test) return;
+
+	FunctionalTest accurate(CPU::MOS6502Esque::Type::T6502, test);
+	FunctionalTest instruction_level(CPU::MOS6502Esque::Type::TInstructionLevel6502, test);
+
+	// Compare timing relative to the first fetch, since the two cores come out of reset differently.
+	std::optional<HalfCycles> accurate_origin, instruction_level_origin;
+
+	constexpr uint16_t success_address = 0x3399;
+	uint64_t compared = 0;
+	std::optional<uint16_t> previous_address;
+	while(true) {
+		accurate.processor->run_for(Cycles(10'000));
+		instruction_level.processor->run_for(Cycles(10'000));
+
+		auto &accurate_fetches = accurate.recorder.fetches;
+		auto &instruction_level_fetches = instruction_level.recorder.fetches;
+		if(!accurate_origin && !accurate_fetches.empty()) accurate_origin = accurate_fetches.front().time;
+		if(!instruction_level_origin && !instruction_level_fetches.empty()) instruction_level_origin = instruction_level_fetches.front().time;
+
+		const size_t count = std::min(accurate_fetches.size(), instruction_level_fetches.size());
+		for(size_t c = 0; c < count; c++) {
+			const auto &lhs = accurate_fetches[c];
+			const auto &rhs = instruction_level_fetches[c];
+			if(lhs.address != rhs.address || lhs.time - *accurate_origin != rhs.time - *instruction_level_origin) {
+				XCTFail(@"Fetch %llu differs: %04x at %d versus %04x at %d",
+					compared + c,
+					lhs.address, (lhs.time - *accurate_origin).as<int>(),
+					rhs.address, (rhs.time - *instruction_level_origin).as<int>());
+				return;
+			}
+
+			// The test ends in a tight loop at the success address, or elsewhere upon failure.
+			if(lhs.address == previous_address) {
+				XCTAssertEqual(lhs.address, success_address);
+				return;
+			}
+			previous_address = lhs.address;
+		}
+
+		compared += count;
+		accurate_fetches.erase(accurate_fetches.begin(), accurate_fetches.begin() + ptrdiff_t(count));
+		instruction_level_fetches.erase(instruction_level_fetches.begin(), instruction_level_fetches.begin() + ptrdiff_t(count));
+
+		XCTAssertFalse(instruction_level.processor->is_jammed());
+		if(instruction_level.processor->is_jammed()) return;
+	}
+}
+
+@end
@@ -0,0 +1,217 @@
+//
+//  6522QuietPeriodTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/6522/6522.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Records the times at which the interrupt line becomes active, and at which port B output changes.
+struct TimingPortHandler: public MOS::MOS6522::PortHandler {
+	int64_t time = 0;
+	std::vector<int64_t> interrupts;
+	std::vector<std::pair<int64_t, uint8_t>> port_b;
+
+	void run_for(HalfCycles duration) {
+		time += duration.as<int64_t>();
+	}
+
+	void set_port_output(MOS::MOS6522::Port port, uint8_t value, uint8_t) {
+		if(port == MOS::MOS6522::Port::B) port_b.emplace_back(time, value);
+	}
+
+	void set_interrupt_status(bool status) {
+		if(status) interrupts.push_back(time);
+	}
+};
+
+using VIA = MOS::MOS6522::MOS6522<TimingPortHandler>;
+
+/// Writes @c value to the counter of @c timer, which will be loaded at the next phase 2.
+void start_timer(VIA &via, int timer, uint16_t value) {
+	via.write(timer ? 0x8 : 0x4, uint8_t(value));
+	via.write(timer ? 0x9 : 0x5, uint8_t(value >> 8));
+}
+
+/// @returns The current count of timer 2; reading it clears any timer 2 interrupt.
+uint16_t timer2(VIA &via) {
+	return uint16_t(via.read(0x8) | (via.read(0x9) << 8));
+}
+
+}
+
+@interface MOS6522QuietPeriodTests : XCTestCase
+@end
+
+@implementation MOS6522QuietPeriodTests
+
+/// Tests that a skip ending exactly upon the underflow of timer 1 leaves it at 0xffff and the interrupt
+/// to be signalled at the next phase 1, and that a one-shot timer then counts silently through 0.
+- (void)testUnderflowAtEndOfSkip {
+	TimingPortHandler handler;
+	VIA via(handler);
+	via.write(0xe, 0xc0);	// Enable the timer 1 interrupt.
+	start_timer(via, 0, 1000);
+
+	// Complete the load cycle; timer 1 now holds 1000, and will reach 0xffff after a further 1001 cycles.
+	via.run_for(Cycles(1));
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(2003));
+
+	via.run_for(Cycles(1001));
+	XCTAssertFalse(via.get_interrupt_line());
+	XCTAssertEqual(via.read(0x5), 0xff);
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(1));
+
+	via.run_for(HalfCycles(1));
+	XCTAssert(via.get_interrupt_line());
+	XCTAssertEqual(handler.interrupts.size(), 1);
+	XCTAssertEqual(handler.interrupts.back(), 2 + 2002 + 1);
+
+	// Acknowledge; in one-shot mode the counter continues without signalling again.
+	XCTAssertEqual(via.read(0x4), 0xff);
+	XCTAssertFalse(via.get_interrupt_line());
+	via.run_for(HalfCycles(1));
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles::max());
+
+	via.run_for(Cycles(0x10000));
+	XCTAssertFalse(via.get_interrupt_line());
+	XCTAssertEqual(handler.interrupts.size(), 1);
+	XCTAssertEqual(via.read(0x5), 0xff);
+	XCTAssertEqual(via.read(0x4), 0xfe);
+}
+
+/// Tests that a skip timed in half cycles, ending half a cycle short of the signalling of a timer 2
+/// underflow, doesn't signal it; and that timer 2 signals only once.
+- (void)testUnderflowJustBeyondSkip {
+	TimingPortHandler handler;
+	VIA via(handler);
+	via.write(0xe, 0xa0);	// Enable the timer 2 interrupt.
+	start_timer(via, 1, 300);
+
+	via.run_for(HalfCycles(2 + 602));
+	XCTAssertFalse(via.get_interrupt_line());
+	via.run_for(HalfCycles(1));
+	XCTAssert(via.get_interrupt_line());
+	XCTAssertEqual(handler.interrupts.back(), 2 + 602 + 1);
+
+	// Timer 2 is one-shot; once acknowledged it shouldn't signal again.
+	XCTAssertEqual(timer2(via), 0xffff);
+	via.run_for(HalfCycles(1 + 2 * 0x20000));
+	XCTAssertFalse(via.get_interrupt_line());
+	XCTAssertEqual(handler.interrupts.size(), 1);
+}
+
+/// Tests that a free-running timer 1 reloads from its latch after each underflow, with the underflow
+/// visible via PB7 at every period of latch + 2 cycles, and that a one-shot timer toggles PB7 only once,
+/// all within single calls to run_for.
+- (void)testOneShotVersusFreeRunning {
+	for(const bool free_running: {false, true}) {
+		TimingPortHandler handler;
+		VIA via(handler);
+		via.write(0x2, 0x80);	// Make PB7 an output.
+		via.write(0xb, free_running ? 0xc0 : 0x80);	// Output timer 1 via PB7, in free-running mode or otherwise.
+		start_timer(via, 0, 500);
+		handler.port_b.clear();
+
+		via.run_for(Cycles(1 + 10 * 502));
+
+		if(free_running) {
+			XCTAssertEqual(handler.port_b.size(), 10);
+			for(size_t c = 0; c < handler.port_b.size(); c++) {
+				XCTAssertEqual(handler.port_b[c].first, int64_t(2 + 1002 + 1 + c * 2 * 502));
+			}
+			XCTAssertEqual(via.read(0x0) & 0x80, 0x00);
+
+			// Having just reloaded, timer 1 holds its latched value.
+			XCTAssertEqual(via.read(0x5), 0x01);
+			XCTAssertEqual(via.read(0x4), 0xf4);
+		} else {
+			XCTAssertEqual(handler.port_b.size(), 1);
+			XCTAssertEqual(handler.port_b[0].first, 2 + 1002 + 1);
+			XCTAssertEqual(via.read(0x0) & 0x80, 0x80);
+		}
+	}
+}
+
+/// Tests that timer 2, when set to count PB6 pulses rather than cycles, doesn't count during a skip and
+/// doesn't limit the sequence point, and that it resumes counting cycles when returned to timed mode.
+- (void)testPB6Counting {
+	TimingPortHandler handler;
+	VIA via(handler);
+	via.write(0xe, 0xe0);	// Enable both timer interrupts.
+	via.write(0xb, 0x20);	// Count PB6 pulses.
+	start_timer(via, 1, 10);
+	via.run_for(Cycles(1));
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles::max());
+
+	via.run_for(Cycles(100000));
+	XCTAssertFalse(via.get_interrupt_line());
+	XCTAssertEqual(timer2(via), 10);
+
+	// Timer 1 alone should determine the sequence point.
+	start_timer(via, 0, 300);
+	via.run_for(Cycles(1));
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(2 * 301 + 1));
+
+	// Return timer 2 to timed mode; it now underflows first.
+	via.write(0xb, 0x00);
+	XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(2 * 11 + 1));
+	via.run_for(Cycles(11));
+	XCTAssertFalse(via.get_interrupt_line());
+	via.run_for(HalfCycles(1));
+	XCTAssert(via.get_interrupt_line());
+	XCTAssertEqual(via.read(0xd) & 0x60, 0x20);
+}
+
+/// Tests that a shift register clocked by timer 2 shifts exactly once, upon underflow, during a skip;
+/// and that one clocked by phase 2 completes its shifts within a single run while timer 1 counts.
+- (void)testShiftRegisterDuringSkip {
+	{
+		TimingPortHandler handler;
+		VIA via(handler);
+		via.write(0xb, 0x14);	// Shift out under control of timer 2.
+		via.write(0xa, 0x81);
+		start_timer(via, 1, 50);
+		via.run_for(Cycles(1));
+		XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(2 * 51 + 1));
+
+		via.run_for(HalfCycles(2 * 51));
+		XCTAssertEqual(via.read(0xd) & 0x24, 0x00);
+		XCTAssertEqual(via.read(0xa), 0x81);
+		via.run_for(HalfCycles(1));
+		XCTAssertEqual(via.read(0xd) & 0x24, 0x20);
+		XCTAssertEqual(via.read(0xa), 0x02);
+
+		// Timer 2 is one-shot, so no further shifts should occur.
+		via.run_for(HalfCycles(1 + 2 * 0x20000));
+		XCTAssertEqual(via.read(0xd) & 0x24, 0x20);
+		XCTAssertEqual(via.read(0xa), 0x02);
+	}
+
+	{
+		TimingPortHandler handler;
+		VIA via(handler);
+		via.write(0xb, 0x18);	// Shift out under control of phase 2.
+		via.write(0xa, 0x81);
+		start_timer(via, 0, 100);
+		via.run_for(Cycles(1));
+		XCTAssertEqual(via.get_next_sequence_point(), HalfCycles(1));
+
+		via.run_for(Cycles(50));
+		XCTAssertEqual(via.read(0xd) & 0x44, 0x04);
+		XCTAssertEqual(via.read(0xa), 0x00);
+		XCTAssertEqual(via.read(0x5), 0x00);
+		XCTAssertEqual(via.read(0x4), 50);
+	}
+}
+
+@end
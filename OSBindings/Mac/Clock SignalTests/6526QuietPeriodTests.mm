@@ -0,0 +1,124 @@
+//
+//  6526QuietPeriodTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/6526/6526.hpp"
+
+namespace {
+
+struct NullPortHandler: public MOS::MOS6526::PortHandler {};
+using CIA = MOS::MOS6526::MOS6526<NullPortHandler, MOS::MOS6526::Personality::P8250>;
+
+/// @returns The current value of @c counter.
+uint16_t counter(CIA &cia, int counter) {
+	return uint16_t(cia.read(4 + counter * 2) | (cia.read(5 + counter * 2) << 8));
+}
+
+/// Runs @c cia for @c ticks E clock ticks, in a single call.
+void run_ticks(CIA &cia, int ticks) {
+	cia.run_for(HalfCycles(ticks * 2));
+}
+
+}
+
+@interface MOS6526QuietPeriodTests : XCTestCase
+@end
+
+@implementation MOS6526QuietPeriodTests
+
+/// Tests that timer B, counting timer A underflows, neither counts nor limits the sequence point during
+/// the periods between those underflows, and that it underflows after exactly reload + 1 of them even when
+/// all are within a single skipped run.
+- (void)testTimerBCountsTimerAUnderflows {
+	NullPortHandler handler;
+	CIA cia(handler);
+	cia.write(0xd, 0x82);	// Enable the timer B interrupt only.
+	cia.write(4, 99);		cia.write(5, 0);
+	cia.write(6, 4);		cia.write(7, 0);
+	cia.write(0xe, 0x11);	// Timer A: force load, start, continuous.
+	cia.write(0xf, 0x51);	// Timer B: force load, start, count timer A underflows.
+
+	// Timer A reloads at tick 102 and every 100 ticks thereafter; timer B counts two ticks later.
+	run_ticks(cia, 105);
+	XCTAssertEqual(counter(cia, 0), 97);
+	XCTAssertEqual(counter(cia, 1), 3);
+
+	// The sequence point is the tick at which timer A next reloads, i.e. tick 202, not anything
+	// implied by timer B's count.
+	XCTAssertEqual(cia.get_next_sequence_point(), HalfCycles(2 * 97));
+
+	// Timer B should reload upon the fifth timer A underflow, at tick 502, and signal an interrupt a tick later.
+	run_ticks(cia, 398);
+	XCTAssertFalse(cia.get_interrupt_line());
+	XCTAssertEqual(counter(cia, 1), 4);
+	run_ticks(cia, 1);
+	XCTAssert(cia.get_interrupt_line());
+	XCTAssertEqual(cia.read(0xd), 0x83);
+	XCTAssertFalse(cia.get_interrupt_line());
+
+	// Run through a further twenty timer B periods in one go.
+	run_ticks(cia, 20 * 500);
+	XCTAssert(cia.get_interrupt_line());
+	XCTAssertEqual(counter(cia, 0), 98);
+	XCTAssertEqual(counter(cia, 1), 4);
+
+	// Stop timer A; once its pipeline has drained, nothing further can happen and timer B holds.
+	cia.write(0xe, 0x00);
+	cia.read(0xd);
+	run_ticks(cia, 3);
+	XCTAssertEqual(cia.get_next_sequence_point(), HalfCycles::max());
+	const uint16_t timer_b = counter(cia, 1);
+	run_ticks(cia, 1'000'000);
+	XCTAssertEqual(counter(cia, 1), timer_b);
+	XCTAssertFalse(cia.get_interrupt_line());
+}
+
+/// Tests that a TOD alarm raised between skipped runs, with the alarm interrupt enabled, brings the sequence
+/// point forward to the next tick and is signalled exactly then; and that with the alarm interrupt
+/// masked the alarm is recorded without affecting the sequence point.
+- (void)testTODAlarmDuringSkip {
+	for(const bool enabled: {false, true}) {
+		NullPortHandler handler;
+		CIA cia(handler);
+		if(enabled) cia.write(0xd, 0x84);
+
+		// Set an alarm for a TOD of 100 and a current TOD of 0.
+		cia.write(0xf, 0x80);
+		cia.write(0xa, 0);	cia.write(0x9, 0);	cia.write(0x8, 100);
+		cia.write(0xf, 0x00);
+		cia.write(0xa, 0);	cia.write(0x9, 0);	cia.write(0x8, 0);
+
+		// Start timer A with a long period, which on the 8250 writing the high byte does, and leave the CIA
+		// half way through a tick.
+		cia.write(4, 0xff);	cia.write(5, 0xff);
+		cia.run_for(HalfCycles(21));
+		XCTAssertEqual(counter(cia, 0), 0xffff - 8);
+		const HalfCycles timer_a_point = HalfCycles(2 * (0xffff - 8)) - HalfCycles(1);
+		XCTAssertEqual(cia.get_next_sequence_point(), timer_a_point);
+
+		// Approach the alarm, then reach it.
+		cia.advance_tod(99);
+		XCTAssertEqual(cia.get_next_sequence_point(), timer_a_point);
+		cia.advance_tod(1);
+		XCTAssertEqual(cia.get_next_sequence_point(), (enabled ? HalfCycles(1) : timer_a_point));
+		XCTAssertFalse(cia.get_interrupt_line());
+
+		// The interrupt should be signalled at the next tick, regardless of the length of the run.
+		cia.run_for(HalfCycles(1));
+		XCTAssertEqual(cia.get_interrupt_line(), enabled);
+		run_ticks(cia, 10000);
+		XCTAssertEqual(cia.get_interrupt_line(), enabled);
+		XCTAssertEqual(cia.read(0xd), (enabled ? 0x84 : 0x04));
+
+		// Timer A should have counted throughout.
+		XCTAssertEqual(counter(cia, 0), 0xffff - 8 - 10001);
+	}
+}
+
+@end
@@ -0,0 +1,125 @@
+//
+//  65816SizeFlagTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "65816.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace {
+
+struct FlatBusHandler: public CPU::MOS6502Esque::BusHandler<uint32_t> {
+	std::array<uint8_t, 65536> ram{};
+	CPU::WDC65816::Processor<FlatBusHandler, false> processor;
+
+	FlatBusHandler(const std::vector<uint8_t> &program) : processor(*this) {
+		std::copy(program.begin(), program.end(), ram.begin() + 0x200);
+
+		processor.set_power_on(false);
+		processor.set_value_of_register(CPU::MOS6502Esque::Register::ProgramCounter, 0x200);
+		processor.set_value_of_register(CPU::MOS6502Esque::Register::StackPointer, 0x1ff);
+	}
+
+	Cycles perform_bus_operation(CPU::MOS6502Esque::BusOperation operation, uint32_t address, uint8_t *value) {
+		if(isReadOperation(operation)) {
+			*value = ram[address & 0xffff];
+		} else if(operation == CPU::MOS6502Esque::BusOperation::Write) {
+			ram[address & 0xffff] = *value;
+		}
+		return Cycles(1);
+	}
+
+	uint16_t value_of(CPU::MOS6502Esque::Register reg) const {
+		return processor.get_value_of_register(reg);
+	}
+};
+
+}
+
+@interface WDC65816SizeFlagTests : XCTestCase
+@end
+
+@implementation WDC65816SizeFlagTests
+
+/// Tests that immediate operands are sized according to the M and X flags as they are changed by REP, SEP,
+/// PLP and XCE, and that 8-bit loads leave the high byte of the accumulator intact.
+- (void)testImmediateSizesFollowFlags {
+	FlatBusHandler handler({
+		0x18, 0xfb,				// CLC; XCE		-> native mode.
+		0xc2, 0x30,				// REP #$30		-> 16-bit A and index.
+		0xa9, 0x34, 0x12,		// LDA #$1234
+		0xa2, 0x78, 0x56,		// LDX #$5678
+		0xe2, 0x20,				// SEP #$20		-> 8-bit A.
+		0xa9, 0x56,				// LDA #$56
+		0xa0, 0xbc, 0x9a,		// LDY #$9abc
+		0xe2, 0x10,				// SEP #$10		-> 8-bit index.
+		0xa2, 0x12,				// LDX #$12
+		0xc2, 0x20,				// REP #$20		-> 16-bit A.
+		0x08,					// PHP
+		0xe2, 0x30,				// SEP #$30
+		0x28,					// PLP			-> 16-bit A, 8-bit index.
+		0xa9, 0xef, 0xbe,		// LDA #$beef
+		0xa0, 0x34,				// LDY #$34
+		0x38, 0xfb,				// SEC; XCE		-> emulation mode, so 8-bit everything.
+		0xa9, 0x77,				// LDA #$77
+		0x80, 0xfe,				// BRA *
+	});
+	handler.processor.run_for(Cycles(200));
+
+	using Register = CPU::MOS6502Esque::Register;
+	XCTAssertEqual(handler.value_of(Register::A), 0xbe77);
+	XCTAssertEqual(handler.value_of(Register::X), 0x0012);
+	XCTAssertEqual(handler.value_of(Register::Y), 0x0034);
+	XCTAssertEqual(handler.value_of(Register::EmulationFlag), 1);
+}
+
+/// Tests that RTI in native mode applies the M and X flags that it pulls before the next instruction is decoded.
+- (void)testRTIAppliesPulledFlags {
+	FlatBusHandler handler({
+		0x18, 0xfb,				// CLC; XCE		-> native mode.
+		0xe2, 0x30,				// SEP #$30		-> 8-bit A and index.
+		0xa9, 0x00, 0x48,		// LDA #$00; PHA	-> program bank.
+		0xa9, 0x02, 0x48,		// LDA #$02; PHA	-> program counter high.
+		0xa9, 0x20, 0x48,		// LDA #$20; PHA	-> program counter low.
+		0xa9, 0x00, 0x48,		// LDA #$00; PHA	-> flags: 16-bit A and index.
+		0x40,					// RTI
+	});
+	const std::vector<uint8_t> target = {
+		0xa9, 0x21, 0x43,		// LDA #$4321
+		0xa2, 0x65, 0x87,		// LDX #$8765
+		0x80, 0xfe,				// BRA *
+	};
+	std::copy(target.begin(), target.end(), handler.ram.begin() + 0x220);
+	handler.processor.run_for(Cycles(200));
+
+	using Register = CPU::MOS6502Esque::Register;
+	XCTAssertEqual(handler.value_of(Register::A), 0x4321);
+	XCTAssertEqual(handler.value_of(Register::X), 0x8765);
+}
+
+/// Tests that flags set via the register interface take effect for decoding.
+- (void)testRegisterInterfaceSetsSizes {
+	FlatBusHandler handler({
+		0xa9, 0x34, 0x12,		// LDA #$1234
+		0xa2, 0x78, 0x56,		// LDX #$5678
+		0x80, 0xfe,				// BRA *
+	});
+
+	using Register = CPU::MOS6502Esque::Register;
+	handler.processor.set_value_of_register(Register::EmulationFlag, 0);
+	handler.processor.set_value_of_register(Register::Flags, 0x00);
+	handler.processor.run_for(Cycles(50));
+
+	XCTAssertEqual(handler.value_of(Register::A), 0x1234);
+	XCTAssertEqual(handler.value_of(Register::X), 0x5678);
+}
+
+@end
@@ -0,0 +1,154 @@
+//
+//  68000SwitchableTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/68000Mk2/SwitchableProcessor.hpp"
+
+#include <array>
+#include <vector>
+
+namespace {
+
+/// A switchable 68000 with 128kb of RAM, which counts the idle microcycles it observes while in fast mode.
+struct SwitchableRAM: public CPU::MC68000Mk2::BusHandler {
+	CPU::MC68000Mk2::SwitchableProcessor<SwitchableRAM, true, true, false> processor{*this};
+	std::array<uint16_t, 64*1024> ram{};
+	int fast_idles = 0;
+
+	/// Places @c program at 0x1000 and begins bus-accurate execution there, in supervisor mode with interrupts masked.
+	void set_program(const std::vector<uint16_t> &program) {
+		std::copy(program.begin(), program.end(), &ram[0x1000 >> 1]);
+
+		auto registers = processor.get_state().registers;
+		registers.status = 0x2700;
+		registers.program_counter = 0x1000;
+		registers.supervisor_stack_pointer = 0x800;
+		processor.decode_from_state(registers);
+	}
+
+	HalfCycles perform_bus_operation(const CPU::MC68000Mk2::Microcycle &cycle, int) {
+		using Microcycle = CPU::MC68000Mk2::Microcycle;
+		if(!cycle.operation && processor.is_fast_mode()) {
+			++fast_idles;
+		}
+
+		if(cycle.data_select_active()) {
+			const uint32_t word_address = cycle.word_address() % ram.size();
+			if(cycle.operation & Microcycle::InterruptAcknowledge) {
+				cycle.value->b = 10;
+			} else {
+				switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+					default: break;
+
+					case Microcycle::SelectWord | Microcycle::Read:
+						cycle.value->w = ram[word_address];
+					break;
+					case Microcycle::SelectByte | Microcycle::Read:
+						cycle.value->b = uint8_t(ram[word_address] >> cycle.byte_shift());
+					break;
+					case Microcycle::SelectWord:
+						ram[word_address] = cycle.value->w;
+					break;
+					case Microcycle::SelectByte:
+						ram[word_address] = uint16_t(
+							(cycle.value->b << cycle.byte_shift()) |
+							(ram[word_address] & cycle.untouched_byte_mask())
+						);
+					break;
+				}
+			}
+		}
+
+		return HalfCycles(0);
+	}
+};
+
+/// A loop of MOVEQs, each of which is satisfied entirely from the prefetch queue.
+std::vector<uint16_t> moveq_loop() {
+	std::vector<uint16_t> program;
+	for(uint16_t c = 0; c < 30; c++) {
+		const uint16_t reg = c < 8 ? c : 0;
+		program.push_back(uint16_t(0x7000 | (reg << 9) | c));	// MOVEQ #c, Dreg
+	}
+	program.push_back(0x60c2);	// BRA.s 0x1000
+	return program;
+}
+
+}
+
+@interface M68000SwitchableTests : XCTestCase
+@end
+
+@implementation M68000SwitchableTests
+
+/// Tests that an instruction that uses only the words handed over from the bus-accurate processor's
+/// prefetch queue, and therefore costs no bus time, is not mistaken for a STOP.
+- (void)testMOVEQAfterSwitch {
+	SwitchableRAM bus;
+	bus.set_program(moveq_loop());
+
+	bus.processor.set_fast_mode(true);
+	bus.processor.run_for(HalfCycles(200));
+	XCTAssert(bus.processor.is_fast_mode());
+	XCTAssertEqual(bus.fast_idles, 0);
+
+	// MOVEQ #1, D1 through MOVEQ #7, D7 should all have executed.
+	const auto registers = bus.processor.get_state().registers;
+	for(int c = 1; c < 8; c++) {
+		XCTAssertEqual(registers.data[c], uint32_t(c));
+	}
+}
+
+/// Tests that repeatedly switching in and out of fast mode, at arbitrary instruction boundaries
+/// within a sequence of MOVEQs, never idles the bus and never delays a switch.
+- (void)testRepeatedSwitches {
+	SwitchableRAM bus;
+	bus.set_program(moveq_loop());
+
+	int switches = 0;
+	for(int c = 0; c < 2000; c++) {
+		const bool fast = c & 1;
+		bus.processor.set_fast_mode(fast);
+
+		// Each MOVEQ takes four cycles in bus-accurate mode, so this spans several instruction boundaries.
+		bus.processor.run_for(HalfCycles(40 + (c * 7) % 64));
+		XCTAssertEqual(bus.processor.is_fast_mode(), fast, @"Switch %d was delayed", c);
+		switches += bus.processor.is_fast_mode() == fast;
+	}
+
+	XCTAssertEqual(bus.fast_idles, 0);
+	XCTAssertEqual(switches, 2000);
+}
+
+/// Tests that a STOP in fast mode idles the bus, holds off a return to bus-accurate mode, and is
+/// ended by an interrupt.
+- (void)testSTOP {
+	SwitchableRAM bus;
+	bus.set_program({
+		0x4e72, 0x2000,	// STOP #$2000
+	});
+	bus.ram[0x28 >> 1] = 0x0000;	// Vector 10 → 0x2000.
+	bus.ram[0x2a >> 1] = 0x2000;
+	bus.ram[0x2000 >> 1] = 0x60fe;	// BRA.s *
+
+	bus.processor.set_fast_mode(true);
+	bus.processor.run_for(HalfCycles(400));
+	XCTAssert(bus.processor.is_fast_mode());
+	XCTAssertGreaterThan(bus.fast_idles, 0);
+
+	bus.processor.set_fast_mode(false);
+	bus.processor.run_for(HalfCycles(400));
+	XCTAssert(bus.processor.is_fast_mode());
+
+	bus.processor.set_interrupt_level(7);
+	bus.processor.run_for(HalfCycles(400));
+	XCTAssertFalse(bus.processor.is_fast_mode());
+}
+
+@end
@@ -0,0 +1,353 @@
+//
+//  AmigaSpriteTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Amiga/Chipset.hpp"
+
+#include <array>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Collects every pixel output within the display window, i.e. excluding border, as palette indices.
+struct PixelCapture: public Outputs::Display::ScanTarget {
+	std::vector<int> pixels;
+	int unknown_colours = 0;
+
+	void set_modals(Modals) final {}
+
+	uint8_t *begin_data(size_t required_length, size_t) final {
+		area_.resize(required_length);
+		return reinterpret_cast<uint8_t *>(area_.data());
+	}
+
+	ScanTarget::Scan *begin_scan() final {
+		return &scan_;
+	}
+
+	void end_scan() final {
+		// Border is output as a single sample stretched across its duration.
+		const auto begin = scan_.end_points[0].data_offset, end = scan_.end_points[1].data_offset;
+		if(end - begin < 2) return;
+
+		for(auto offset = begin; offset < end; offset++) {
+			// Palette entry n has been set to colour n+1; the chipset stores colours big endian.
+			const auto bytes = reinterpret_cast<const uint8_t *>(&area_[offset]);
+			const int colour = (bytes[0] << 8) | bytes[1];
+			if(colour < 1 || colour > 32) ++unknown_colours;
+			pixels.push_back(colour - 1);
+		}
+	}
+
+	private:
+		ScanTarget::Scan scan_;
+		std::vector<uint16_t> area_;
+};
+
+/// A random arrangement of four low-resolution bitplanes and eight manually-driven sprites.
+struct Scene {
+	bool dual_playfields;
+	uint16_t priorities;		// i.e. BPLCON2.
+	uint16_t collision_control;	// i.e. CLXCON.
+	std::array<std::vector<uint16_t>, 4> planes;
+
+	struct Sprite {
+		bool armed;
+		uint16_t position, control;	// Including the attachment flag, if applicable.
+		uint16_t data, datb;
+	};
+	std::array<Sprite, 8> sprites;
+
+	Scene(std::mt19937 &random) {
+		dual_playfields = random() & 1;
+		priorities = uint16_t(random() & 0x7f);
+		collision_control = uint16_t(random());
+
+		for(auto &plane: planes) {
+			plane.resize(16384);
+			for(auto &word: plane) word = uint16_t(random() & random());
+		}
+
+		// Keep all sprites near one another, so that there's plenty of overlap. Positions are even
+		// because a load delayed by a pixel also clears the first pixel of the other sprite in the
+		// same shifter, so that single sprites rendered in isolation wouldn't compose.
+		//
+		// Make the sprites sparse in some scenes, so that collisions are occasional.
+		const int base = 0xa0 + int(random() % 0x80);
+		const bool sparse = random() & 1;
+		for(size_t c = 0; c < sprites.size(); c++) {
+			auto &sprite = sprites[c];
+			const int h_start = (base + int(random() % 48)) & ~1;
+			sprite.armed = random() % 4;
+			sprite.position = uint16_t(0x2000 | (h_start >> 1));
+			sprite.control = uint16_t(0xf000 | (h_start & 1) | ((c & 1) && (random() & 1) ? 0x80 : 0x00));
+			sprite.data = uint16_t(random() & (sparse ? random() & random() : 0xffff));
+			sprite.datb = uint16_t(random() & (sparse ? random() & random() : 0xffff));
+		}
+	}
+};
+
+/// The result of rendering a @c Scene, or some part of it.
+struct Frame {
+	std::vector<int> pixels;
+	int unknown_colours;
+
+	/// The number of pixels captured by the end of each line, and the collisions observed during that line.
+	std::vector<std::pair<size_t, uint16_t>> lines;
+};
+
+/// Renders a frame of @c scene, with the bitplanes included only if @c include_planes and sprites only
+/// if included in @c sprite_mask and armed. Attachment is honoured only if @c include_attachment.
+Frame render(const Scene &scene, bool dual_playfields, bool include_planes, int sprite_mask, bool include_attachment) {
+	auto map = std::make_unique<Amiga::MemoryMap>(
+		Analyser::Static::Amiga::Target::ChipRAM::FiveHundredAndTwelveKilobytes,
+		Analyser::Static::Amiga::Target::FastRAM::None);
+	auto chipset = std::make_unique<Amiga::Chipset>(*map, 7'093'790);
+	PixelCapture capture;
+	chipset->set_scan_target(&capture);
+
+	// Place plane n at 64kb * (n + 1).
+	if(include_planes) {
+		for(size_t plane = 0; plane < scene.planes.size(); plane++) {
+			for(size_t c = 0; c < scene.planes[plane].size(); c++) {
+				const size_t address = (plane + 1) * 65536 + c*2;
+				map->chip_ram[address] = uint8_t(scene.planes[plane][c] >> 8);
+				map->chip_ram[address + 1] = uint8_t(scene.planes[plane][c]);
+			}
+		}
+	}
+
+	using Microcycle = CPU::MC68000Mk2::Microcycle;
+	const auto access = [&](uint32_t address, uint16_t value, bool is_read) -> uint16_t {
+		CPU::SlicedInt16 data;
+		data.w = value;
+		Microcycle cycle(Microcycle::SelectWord | Microcycle::NewAddress | (is_read ? Microcycle::Read : 0));
+		cycle.address = &address;
+		cycle.value = &data;
+		chipset->perform(cycle);
+		return data.w;
+	};
+	const auto write = [&](uint32_t address, uint16_t value) {
+		access(0xdf'f000 | address, value, false);
+	};
+
+	// Palette entry n is colour n+1.
+	for(uint32_t c = 0; c < 32; c++) {
+		write(0x180 + c*2, uint16_t(c + 1));
+	}
+
+	// A standard 320x256 display, with four bitplanes.
+	write(0x08e, 0x2c81);	// DIWSTRT
+	write(0x090, 0x2cc1);	// DIWSTOP
+	write(0x092, 0x0038);	// DDFSTRT
+	write(0x094, 0x00d0);	// DDFSTOP
+	write(0x100, uint16_t(0x4200 | (dual_playfields ? 0x0400 : 0x0000)));	// BPLCON0
+	write(0x102, 0x0000);	// BPLCON1
+	write(0x104, scene.priorities);			// BPLCON2
+	write(0x108, 0x0000);	// BPL1MOD
+	write(0x10a, 0x0000);	// BPL2MOD
+	for(uint32_t plane = 0; plane < 4; plane++) {
+		write(0x0e0 + plane*4, uint16_t(plane + 1));	// BPLxPTH
+		write(0x0e2 + plane*4, 0x0000);				// BPLxPTL
+	}
+	write(0x098, scene.collision_control);	// CLXCON
+
+	// Sprites are driven manually, without DMA, so remain where they are placed for the whole frame.
+	// Attachment is a property of the odd sprite of a pair, whether or not that sprite is armed.
+	for(uint32_t c = 0; c < 8; c++) {
+		const auto &sprite = scene.sprites[c];
+		write(0x140 + c*8, sprite.position);
+		write(0x142 + c*8, include_attachment ? sprite.control : uint16_t(sprite.control & ~0x80));
+		if(!sprite.armed || !(sprite_mask & (1 << c))) continue;
+
+		write(0x146 + c*8, sprite.datb);
+		write(0x144 + c*8, sprite.data);	// i.e. arm.
+	}
+
+	write(0x096, 0x8300);	// DMACON: enable bitplane DMA only.
+
+	// Run for a frame a line at a time, offset so that each line's pixels have been posted
+	// by the time collisions are read.
+	Frame frame;
+	access(0xdf'f00e, 0, true);
+	chipset->run_for(HalfCycles(16 * 4));
+	for(int line = 0; line < 313; line++) {
+		chipset->run_for(HalfCycles(227 * 4));
+		frame.lines.emplace_back(capture.pixels.size(), access(0xdf'f00e, 0, true));
+	}
+
+	frame.pixels = std::move(capture.pixels);
+	frame.unknown_colours = capture.unknown_colours;
+	return frame;
+}
+
+/// Tallies of how often various things were observed while checking a scene.
+struct Tally {
+	int mismatches = 0;
+	int sprite_pixels = 0;
+	int hidden_sprite_pixels = 0;
+	int unexpected_colours = 0;
+	int collision_mismatches = 0;
+	int collision_changes = 0;
+};
+
+}
+
+@interface AmigaSpriteTests : XCTestCase
+@end
+
+@implementation AmigaSpriteTests
+
+/// Renders random scenes in full, and also with just the playfield or just a single sprite, and checks that the full
+/// rendering composes the others with appropriate priorities and produces the appropriate collision flags.
+- (void)testCompositionAndCollisions {
+	std::mt19937 random(0xa3194);
+	Tally tally;
+
+	for(int round = 0; round < 16; round++) {
+		const Scene scene(random);
+
+		const auto full = render(scene, scene.dual_playfields, true, 0xff, true);
+		const auto playfield = render(scene, scene.dual_playfields, true, 0x00, false);
+		const auto planes = render(scene, false, true, 0x00, false);
+		std::array<Frame, 8> sprites;
+		for(int c = 0; c < 8; c++) {
+			sprites[size_t(c)] = render(scene, false, false, 1 << c, false);
+		}
+
+		XCTAssertEqual(full.unknown_colours, 0);
+		XCTAssertEqual(full.pixels.size(), playfield.pixels.size());
+		XCTAssertEqual(full.pixels.size(), planes.pixels.size());
+		for(const auto &sprite: sprites) {
+			XCTAssertEqual(full.pixels.size(), sprite.pixels.size());
+		}
+		if(full.pixels.size() < 100000) {
+			XCTAssert(false, @"Insufficient pixels captured in round %d", round);
+			continue;
+		}
+
+		// In single-playfield mode, palette indices directly give the bitplanes; the planes
+		// with even indices from zero form one playfield, those with odd indices the other.
+		const int even_priority = (scene.priorities >> 3) & 7;
+		const int odd_priority = scene.priorities & 7;
+		uint16_t collisions = 0;
+		uint16_t previous_collisions = 0;
+		size_t line = 0, line_start = 0;
+		const auto end_lines = [&](size_t x) {
+			// Compare collisions at the end of each line, noting how often they differ between lines with pixels.
+			while(line < full.lines.size() && full.lines[line].first == x) {
+				if(full.lines[line].second != collisions) ++tally.collision_mismatches;
+				if(x != line_start) {
+					tally.collision_changes += collisions != previous_collisions;
+					previous_collisions = collisions;
+				}
+				collisions = 0;
+				line_start = x;
+				++line;
+			}
+		};
+
+		for(size_t x = 0; x < full.pixels.size(); x++) {
+			end_lines(x);
+
+			const int bitplanes = planes.pixels[x];
+			const bool even_present = bitplanes & 0x5;
+			const bool odd_present = bitplanes & 0xa;
+
+			int expected = playfield.pixels[x];
+			int collision_set = 0;
+
+			// Draw sprite pairs from lowest to highest priority.
+			for(int pair = 3; pair >= 0; pair--) {
+				// Get each sprite's two-bit value here.
+				int values[2];
+				for(int c = 0; c < 2; c++) {
+					const int index = sprites[size_t(pair*2 + c)].pixels[x];
+					values[c] = index ? index - 16 - pair*4 : 0;
+					if(values[c] < 0 || values[c] > 3) {
+						++tally.unexpected_colours;
+						values[c] = 0;
+					}
+				}
+
+				// The even sprite always participates in collisions; the odd only if enabled.
+				if(values[0] || (values[1] && (scene.collision_control & (0x1000 << pair)))) {
+					collision_set |= 1 << pair;
+				}
+
+				// Attached sprites form a four-bit colour; otherwise the odd sprite is drawn over the even.
+				int colour = 0;
+				if(scene.sprites[size_t(pair*2 + 1)].control & 0x80) {
+					const int value = (values[1] << 2) | values[0];
+					colour = value ? 16 + value : 0;
+				} else if(values[1] || values[0]) {
+					colour = 16 + pair*4 + (values[1] ? values[1] : values[0]);
+				}
+				if(!colour) continue;
+				++tally.sprite_pixels;
+
+				// A playfield is in front of a pair if its priority is no greater than the pair number.
+				// In single-playfield mode the even priority applies to everything.
+				const bool hidden = scene.dual_playfields ?
+					((even_priority <= pair && even_present) || (odd_priority <= pair && odd_present)) :
+					(even_priority <= pair && bitplanes);
+				if(hidden) {
+					++tally.hidden_sprite_pixels;
+				} else {
+					expected = colour;
+				}
+			}
+
+			if(expected != full.pixels[x]) {
+				++tally.mismatches;
+			}
+
+			// A playfield is present for collision purposes if any of its planes is either enabled and
+			// matching, or not enabled with a match value of zero.
+			bool playfields_present[2] = {false, false};
+			for(int plane = 0; plane < 6; plane++) {
+				const bool enabled = scene.collision_control & (0x40 << plane);
+				const bool match = scene.collision_control & (1 << plane);
+				const bool bit = (bitplanes >> plane) & 1;
+				playfields_present[plane & 1] |= enabled ? bit == match : !match;
+			}
+			if(playfields_present[0] && playfields_present[1]) collisions |= 0x0001;
+
+			// Then CLXDAT has playfield/sprite collisions for the even playfield in b1–b4, the odd in
+			// b5–b8 and sprite/sprite collisions in b9 onwards.
+			for(int pair = 0; pair < 4; pair++) {
+				if(!(collision_set & (1 << pair))) continue;
+				if(playfields_present[0]) collisions |= 0x0002 << pair;
+				if(playfields_present[1]) collisions |= 0x0020 << pair;
+			}
+			int bit = 0x0200;
+			for(int first = 0; first < 4; first++) {
+				for(int second = first + 1; second < 4; second++) {
+					if((collision_set & (1 << first)) && (collision_set & (1 << second))) collisions |= bit;
+					bit <<= 1;
+				}
+			}
+		}
+		end_lines(full.pixels.size());
+		XCTAssertEqual(line, full.lines.size());
+
+	}
+
+	XCTAssertEqual(tally.mismatches, 0);
+	XCTAssertEqual(tally.unexpected_colours, 0);
+	XCTAssertEqual(tally.collision_mismatches, 0);
+	XCTAssertGreaterThan(tally.collision_changes, 100);
+	XCTAssertGreaterThan(tally.sprite_pixels, 100000);
+	XCTAssertGreaterThan(tally.hidden_sprite_pixels, 10000);
+}
+
+@end
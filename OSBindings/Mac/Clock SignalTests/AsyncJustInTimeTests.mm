@@ -0,0 +1,207 @@
+//
+//  AsyncJustInTimeTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../ClockReceiver/JustInTime.hpp"
+#include "../../../Components/9918/9918.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// Records the time at which each write occurs, and whether any time was ever run on a thread other than the test's.
+struct Recorder {
+	struct Write {
+		int64_t time;
+		uint8_t value;
+
+		bool operator ==(const Write &rhs) const {
+			return time == rhs.time && value == rhs.value;
+		}
+	};
+
+	int64_t time = 0;
+	std::vector<Write> writes;
+	std::thread::id test_thread = std::this_thread::get_id();
+	bool ran_elsewhere = false;
+
+	void run_for(HalfCycles duration) {
+		time += duration.as<int64_t>();
+		ran_elsewhere |= std::this_thread::get_id() != test_thread;
+	}
+
+	void write(uint8_t value) {
+		writes.push_back(Write{time, value});
+	}
+
+	/// Provides a sequence point at every multiple of 1000.
+	HalfCycles get_next_sequence_point() const {
+		return HalfCycles(1000 - (time % 1000));
+	}
+};
+
+using VDP = TI::TMS::TMS9918<TI::TMS::Personality::TMS9918A>;
+
+/// Captures everything output by a VDP, and whether any of it was output on a thread other than the test's.
+struct OutputCapture: public Outputs::Display::ScanTarget {
+	std::vector<uint8_t> data;
+	std::vector<uint16_t> scans;
+	std::thread::id test_thread = std::this_thread::get_id();
+	std::atomic<bool> output_elsewhere = false;
+
+	void set_modals(Modals modals) final {
+		sample_size_ = Outputs::Display::size_for_data_type(modals.input_data_type);
+	}
+
+	uint8_t *begin_data(size_t required_length, size_t) final {
+		area_.assign(required_length * sample_size_, 0);
+		return area_.data();
+	}
+
+	void end_data(size_t actual_length) final {
+		data.insert(data.end(), area_.begin(), area_.begin() + ptrdiff_t(actual_length * sample_size_));
+	}
+
+	ScanTarget::Scan *begin_scan() final {
+		if(std::this_thread::get_id() != test_thread) output_elsewhere = true;
+		return &scan_;
+	}
+
+	void end_scan() final {
+		for(const auto &end_point: scan_.end_points) {
+			scans.insert(scans.end(), {end_point.x, end_point.y, end_point.data_offset, end_point.composite_angle, end_point.cycles_since_end_of_horizontal_retrace});
+		}
+		scans.push_back(scan_.composite_amplitude);
+	}
+
+	private:
+		ScanTarget::Scan scan_;
+		std::vector<uint8_t> area_;
+		size_t sample_size_ = 1;
+};
+
+}
+
+@interface AsyncJustInTimeTests : XCTestCase
+@end
+
+@implementation AsyncJustInTimeTests
+
+/// Tests that all dispatched time and posted actions are applied, in order, before any access via -> or
+/// the reaching of a sequence point.
+- (void)testFlushPrecedesAccess {
+	AsyncJustInTimeActor<Recorder> actor(HalfCycles(100));
+	JustInTimeActor<Recorder> reference;
+	reference.update_sequence_point();
+
+	std::mt19937 random(0xa5c);
+	int64_t time = 0;
+	for(int c = 0; c < 100000; c++) {
+		const auto duration = HalfCycles(int(random() % 300));
+		time += duration.as<int64_t>();
+		XCTAssertEqual(actor += duration, reference += duration);
+
+		const uint8_t value = uint8_t(random());
+		reference->write(value);
+		actor.post([value] (Recorder &recorder) {
+			recorder.write(value);
+		});
+
+		if(!(random() & 15)) {
+			XCTAssertEqual(actor->time, time);
+			XCTAssert(actor->writes == reference->writes, @"Writes differ at step %d", c);
+		}
+	}
+
+	XCTAssert(actor->writes == reference->writes);
+	if(std::thread::hardware_concurrency() > 1) {
+		XCTAssert(actor->ran_elsewhere);
+	}
+}
+
+/// Tests that a TMS9918A produces identical output and responses when run on a worker thread with
+/// posted data writes as when run synchronously, including reading back data that was posted.
+- (void)testTMS9918 {
+	// The VDP picks a random initial output position; give both the same one.
+	srand(0x9918);
+	AsyncJustInTimeActor<VDP> actor(HalfCycles(4096));
+	srand(0x9918);
+	JustInTimeActor<VDP> reference;
+	reference.update_sequence_point();
+	OutputCapture actor_output, reference_output;
+	actor->set_scan_target(&actor_output);
+	reference->set_scan_target(&reference_output);
+
+	// Enable the display and interrupts, in Graphics II mode.
+	for(auto value: {0x02, 0x80, 0xe0, 0x81, 0x0e, 0x82, 0xff, 0x83, 0x03, 0x84, 0x36, 0x85, 0x07, 0x86, 0x14, 0x87}) {
+		actor->write(1, uint8_t(value));
+		reference->write(1, uint8_t(value));
+	}
+
+	std::mt19937 random(0x9918);
+	int readbacks = 0, interrupts = 0;
+	for(int c = 0; c < 2000; c++) {
+		const auto advance = [&](int minimum, int limit) {
+			const auto duration = HalfCycles(minimum + int(random() % (limit - minimum)));
+			XCTAssertEqual(actor += duration, reference += duration);
+			XCTAssertEqual(actor->get_interrupt_line(), reference->get_interrupt_line());
+		};
+
+		// Post a run of data writes to a random address, each sufficiently far apart to find an access slot.
+		const uint16_t address = uint16_t(random() & 0x3fff);
+		std::vector<uint8_t> values(random() % 64);
+		for(auto &value: values) value = uint8_t(random());
+
+		for(auto value: {address & 0xff, 0x40 | (address >> 8)}) {
+			actor->write(1, uint8_t(value));
+			reference->write(1, uint8_t(value));
+		}
+		for(auto value: values) {
+			advance(1000, 1500);
+			actor.post([value] (VDP &vdp) {
+				vdp.write(0, value);
+			});
+			reference->write(0, value);
+		}
+		advance(1000, 1500);
+
+		// Read them back, synchronously.
+		for(auto value: {address & 0xff, address >> 8}) {
+			actor->write(1, uint8_t(value));
+			reference->write(1, uint8_t(value));
+		}
+		for(auto value: values) {
+			advance(1000, 1500);
+			const uint8_t actor_value = actor->read(0);
+			XCTAssertEqual(actor_value, reference->read(0));
+			XCTAssertEqual(actor_value, value, @"Posted write to %04x not read back", address);
+			++readbacks;
+		}
+
+		// Run for a while, allowing the final read-ahead to complete, and acknowledge any interrupt.
+		advance(1000, 20000);
+		interrupts += actor->get_interrupt_line();
+		XCTAssertEqual(actor->read(1), reference->read(1));
+	}
+
+	XCTAssert(actor_output.data == reference_output.data);
+	XCTAssert(actor_output.scans == reference_output.scans);
+	XCTAssertGreaterThan(actor_output.scans.size(), 100000);
+	XCTAssertGreaterThan(readbacks, 10000);
+	XCTAssertGreaterThan(interrupts, 100);
+	if(std::thread::hardware_concurrency() > 1) {
+		XCTAssert(actor_output.output_elsewhere);
+	}
+}
+
+@end
@@ -0,0 +1,282 @@
+//
+//  Atari2600CartridgeTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Atari/2600/Cartridges/Atari8k.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/Atari16k.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/Atari32k.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/CBSRAMPlus.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/MegaBoy.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/MNetwork.hpp"
+#include "../../../Machines/Atari/2600/Cartridges/ParkerBros.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/*
+	Reference models of each paging scheme, each providing:
+
+		int access(bool is_read, uint16_t address, uint8_t value)
+
+	which returns the value expected on the bus after the access, or -1 if that is
+	the content of RAM not yet seen, having pointed `unknown` at the relevant storage.
+	RAM content is otherwise tracked as observed.
+*/
+struct Model {
+	const std::vector<uint8_t> &rom;
+	int *unknown = nullptr;
+
+	Model(const std::vector<uint8_t> &rom) : rom(rom) {}
+
+	int read_ram(std::vector<int> &ram, size_t index) {
+		if(ram[index] < 0) unknown = &ram[index];
+		return ram[index];
+	}
+};
+
+/// Atari-style switching between 4kb banks by access to any of a contiguous run of hotspots,
+/// optionally with RAM whose write port begins the cartridge area and whose read port follows it.
+struct BankSwitchedModel: public Model {
+	const uint16_t first_hotspot;
+	const size_t banks;
+	std::vector<int> ram;
+	size_t bank = 0;
+
+	BankSwitchedModel(const std::vector<uint8_t> &rom, uint16_t first_hotspot, size_t banks, size_t ram_size) :
+		Model(rom), first_hotspot(first_hotspot), banks(banks), ram(ram_size, -1) {}
+
+	int access(bool is_read, uint16_t address, uint8_t value) {
+		address &= 0x1fff;
+		if(!(address & 0x1000)) return value;
+
+		if(address >= first_hotspot && address < first_hotspot + banks) bank = address - first_hotspot;
+		int result = is_read ? rom[bank*4096 + (address & 4095)] : value;
+
+		const size_t offset = address & 0xfff;
+		if(offset < ram.size()) {
+			ram[offset] = result;
+		} else if(offset < ram.size()*2 && is_read) {
+			result = read_ram(ram, offset - ram.size());
+		}
+		return result;
+	}
+};
+
+/// Advances through 4kb banks with each access to 0x1ff0.
+struct MegaBoyModel: public Model {
+	size_t bank = 0;
+	using Model::Model;
+
+	int access(bool is_read, uint16_t address, uint8_t value) {
+		address &= 0x1fff;
+		if(!(address & 0x1000)) return value;
+
+		if(address == 0x1ff0) bank = (bank + 1) & 15;
+		return is_read ? rom[bank*4096 + (address & 4095)] : value;
+	}
+};
+
+/// Selects any of eight 1kb banks into each of four slices.
+struct ParkerBrosModel: public Model {
+	size_t banks[4] = {4, 5, 6, 7};
+	using Model::Model;
+
+	int access(bool is_read, uint16_t address, uint8_t value) {
+		address &= 0x1fff;
+		if(!(address & 0x1000)) return value;
+
+		if(address >= 0x1fe0 && address < 0x1ff8) banks[(address >> 3) & 3] = address & 7;
+		return is_read ? rom[banks[(address >> 10) & 3]*1024 + (address & 1023)] : value;
+	}
+};
+
+/// Selects any of seven 2kb banks, or 1kb of RAM, into the lower half; the upper half has one of
+/// four 256-byte pages of RAM followed by the final 1.5kb of ROM.
+struct MNetworkModel: public Model {
+	int lower_bank;
+	size_t high_page = 0;
+	std::vector<int> low_ram = std::vector<int>(1024, -1), high_ram = std::vector<int>(1024, -1);
+
+	MNetworkModel(const std::vector<uint8_t> &rom) : Model(rom), lower_bank(int(rom.size() / 2048) - 2) {}
+
+	int access(bool is_read, uint16_t address, uint8_t value) {
+		address &= 0x1fff;
+		if(!(address & 0x1000)) return value;
+
+		if(address >= 0x1fe0 && address <= 0x1fe6) lower_bank = address - 0x1fe0;
+		else if(address == 0x1fe7) lower_bank = -1;
+		else if(address >= 0x1ff8 && address <= 0x1ffb) high_page = address - 0x1ff8;
+
+		if(address & 0x800) {
+			if(address < 0x1900) {
+				high_ram[high_page*256 + (address & 255)] = value;
+				return value;
+			}
+			if(!is_read) return value;
+			if(address < 0x1a00) return read_ram(high_ram, high_page*256 + (address & 255));
+			return rom[rom.size() - 2048 + (address & 2047)];
+		}
+
+		if(lower_bank >= 0) {
+			return is_read ? rom[size_t(lower_bank)*2048 + (address & 2047)] : value;
+		}
+		if(address < 0x1400) {
+			low_ram[address & 1023] = value;
+			return value;
+		}
+		return is_read ? read_ram(low_ram, address & 1023) : value;
+	}
+};
+
+struct Result {
+	int comparisons = 0;
+	int mismatches = 0;
+};
+
+/// Performs the same random sequence of accesses, biased towards the RAM and hotspot areas,
+/// upon both @c cartridge and @c model, comparing the results.
+template <typename CartridgeT, typename ModelT> Result compare(CartridgeT &cartridge, ModelT &model, uint32_t seed) {
+	Result result;
+	std::mt19937 random(seed);
+
+	for(int c = 0; c < 200000; c++) {
+		uint16_t address = uint16_t(random());
+		switch(random() & 3) {
+			case 0:	address = 0x1fe0 | (address & 0x1f);	break;
+			case 1:	address = 0x1000 | (address & 0x3ff);	break;
+			case 2:	address = 0x1800 | (address & 0x3ff);	break;
+			default: break;
+		}
+
+		const bool is_read = random() & 1;
+		const auto operation = is_read ?
+			((random() & 1) ? CPU::MOS6502::BusOperation::Read : CPU::MOS6502::BusOperation::ReadOpcode) :
+			CPU::MOS6502::BusOperation::Write;
+		uint8_t value = uint8_t(random());
+
+		const int expected = model.access(is_read, address, value);
+		cartridge.perform_bus_operation(operation, address, &value);
+
+		if(expected < 0) {
+			*model.unknown = value;
+		} else {
+			++result.comparisons;
+			if(expected != value) ++result.mismatches;
+		}
+	}
+	return result;
+}
+
+std::vector<uint8_t> random_rom(size_t size, uint32_t seed) {
+	std::mt19937 random(seed);
+	std::vector<uint8_t> rom(size);
+	for(auto &byte: rom) byte = uint8_t(random());
+	return rom;
+}
+
+}
+
+@interface Atari2600CartridgeTests : XCTestCase
+@end
+
+@implementation Atari2600CartridgeTests
+
+- (void)testAtari8k {
+	const auto rom = random_rom(8192, 1);
+	{
+		Atari2600::Cartridge::Atari8k cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff8, 2, 0);
+		const auto result = compare(cartridge, model, 1);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+	{
+		Atari2600::Cartridge::Atari8kSuperChip cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff8, 2, 128);
+		const auto result = compare(cartridge, model, 2);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+}
+
+- (void)testAtari16k {
+	const auto rom = random_rom(16384, 3);
+	{
+		Atari2600::Cartridge::Atari16k cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff6, 4, 0);
+		const auto result = compare(cartridge, model, 3);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+	{
+		Atari2600::Cartridge::Atari16kSuperChip cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff6, 4, 128);
+		const auto result = compare(cartridge, model, 4);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+}
+
+- (void)testAtari32k {
+	const auto rom = random_rom(32768, 5);
+	{
+		Atari2600::Cartridge::Atari32k cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff4, 8, 0);
+		const auto result = compare(cartridge, model, 5);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+	{
+		Atari2600::Cartridge::Atari32kSuperChip cartridge(rom.data(), rom.size());
+		BankSwitchedModel model(rom, 0x1ff4, 8, 128);
+		const auto result = compare(cartridge, model, 6);
+		XCTAssertEqual(result.mismatches, 0);
+		XCTAssertGreaterThan(result.comparisons, 100000);
+	}
+}
+
+- (void)testCBSRAMPlus {
+	const auto rom = random_rom(12288, 7);
+	Atari2600::Cartridge::CBSRAMPlus cartridge(rom.data(), rom.size());
+	BankSwitchedModel model(rom, 0x1ff8, 3, 256);
+	const auto result = compare(cartridge, model, 7);
+	XCTAssertEqual(result.mismatches, 0);
+	XCTAssertGreaterThan(result.comparisons, 100000);
+}
+
+- (void)testMegaBoy {
+	const auto rom = random_rom(65536, 8);
+	Atari2600::Cartridge::MegaBoy cartridge(rom.data(), rom.size());
+	MegaBoyModel model(rom);
+	const auto result = compare(cartridge, model, 8);
+	XCTAssertEqual(result.mismatches, 0);
+	XCTAssertGreaterThan(result.comparisons, 100000);
+}
+
+- (void)testParkerBros {
+	const auto rom = random_rom(8192, 9);
+	Atari2600::Cartridge::ParkerBros cartridge(rom.data(), rom.size());
+	ParkerBrosModel model(rom);
+	const auto result = compare(cartridge, model, 9);
+	XCTAssertEqual(result.mismatches, 0);
+	XCTAssertGreaterThan(result.comparisons, 100000);
+}
+
+- (void)testMNetwork {
+	const auto rom = random_rom(16384, 10);
+	Atari2600::Cartridge::MNetwork cartridge(rom.data(), rom.size());
+	MNetworkModel model(rom);
+	const auto result = compare(cartridge, model, 10);
+	XCTAssertEqual(result.mismatches, 0);
+	XCTAssertGreaterThan(result.comparisons, 100000);
+}
+
+@end
@@ -0,0 +1,163 @@
+//
+//  ContainerTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Container.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+
+namespace {
+
+/// A compressed file, and the CRC and size of its original contents.
+struct Compressed {
+	std::vector<uint8_t> data;
+	uint32_t crc32 = 0;
+	uint32_t size = 0;
+};
+
+/// Compresses @c count zero bytes, or @c contents if supplied, in the form indicated by @c window_bits as per zlib's @c deflateInit2.
+Compressed compress(size_t count, int window_bits, const std::vector<uint8_t> &contents = {}) {
+	Compressed result;
+	z_stream stream{};
+	deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, window_bits, 9, Z_DEFAULT_STRATEGY);
+
+	const std::vector<uint8_t> zeroes(1024 * 1024);
+	std::vector<uint8_t> output(1024 * 1024);
+	while(true) {
+		const std::vector<uint8_t> &input = contents.empty() ? zeroes : contents;
+		const size_t length = std::min(count, input.size());
+		count -= length;
+		result.crc32 = uint32_t(crc32(result.crc32, input.data(), uInt(length)));
+		result.size += uint32_t(length);
+
+		stream.next_in = const_cast<uint8_t *>(input.data());
+		stream.avail_in = uInt(length);
+		do {
+			stream.next_out = output.data();
+			stream.avail_out = uInt(output.size());
+			deflate(&stream, count ? Z_NO_FLUSH : Z_FINISH);
+			result.data.insert(result.data.end(), output.begin(), output.end() - stream.avail_out);
+		} while(!stream.avail_out);
+
+		if(!count) break;
+	}
+
+	deflateEnd(&stream);
+	return result;
+}
+
+void append16(std::vector<uint8_t> &target, uint16_t value) {
+	target.insert(target.end(), {uint8_t(value), uint8_t(value >> 8)});
+}
+
+void append32(std::vector<uint8_t> &target, uint32_t value) {
+	append16(target, uint16_t(value));
+	append16(target, uint16_t(value >> 16));
+}
+
+/// @returns A zip file containing only @c name, as described by @c file.
+std::vector<uint8_t> zip(const std::string &name, const Compressed &file) {
+	std::vector<uint8_t> zip;
+	append32(zip, 0x04034b50);
+	append16(zip, 20);					// Version needed.
+	append16(zip, 0);					// Flags.
+	append16(zip, 8);					// Method: deflated.
+	append32(zip, 0);					// Modification time and date.
+	append32(zip, file.crc32);
+	append32(zip, uint32_t(file.data.size()));
+	append32(zip, file.size);
+	append16(zip, uint16_t(name.size()));
+	append16(zip, 0);					// Extra field length.
+	zip.insert(zip.end(), name.begin(), name.end());
+	zip.insert(zip.end(), file.data.begin(), file.data.end());
+
+	const auto directory_offset = uint32_t(zip.size());
+	append32(zip, 0x02014b50);
+	append16(zip, 20);					// Version made by.
+	append16(zip, 20);					// Version needed.
+	append16(zip, 0);					// Flags.
+	append16(zip, 8);					// Method: deflated.
+	append32(zip, 0);					// Modification time and date.
+	append32(zip, file.crc32);
+	append32(zip, uint32_t(file.data.size()));
+	append32(zip, file.size);
+	append16(zip, uint16_t(name.size()));
+	append32(zip, 0);					// Extra field and comment lengths.
+	append32(zip, 0);					// Disk number and internal attributes.
+	append32(zip, 0);					// External attributes.
+	append32(zip, 0);					// Local header offset.
+	zip.insert(zip.end(), name.begin(), name.end());
+	const auto directory_size = uint32_t(zip.size()) - directory_offset;
+
+	append32(zip, 0x06054b50);
+	append32(zip, 0);					// Disk numbers.
+	append16(zip, 1);					// Entries on this disk.
+	append16(zip, 1);					// Entries in total.
+	append32(zip, directory_size);
+	append32(zip, directory_offset);
+	append16(zip, 0);					// Comment length.
+	return zip;
+}
+
+void write(const std::string &file_name, const std::vector<uint8_t> &contents) {
+	FILE *const file = fopen(file_name.c_str(), "wb");
+	fwrite(contents.data(), 1, contents.size(), file);
+	fclose(file);
+}
+
+/// Comfortably more than any file that Container will decompress, but with a compressed size of only around 300kb.
+constexpr size_t BombSize = 300 * 1024 * 1024;
+
+}
+
+@interface ContainerTests : XCTestCase
+@end
+
+@implementation ContainerTests
+
+/// Tests that ordinary files can be obtained from both gzip and zip archives.
+- (void)testContents {
+	const std::string directory = NSTemporaryDirectory().UTF8String;
+
+	std::vector<uint8_t> contents(200000);
+	for(size_t c = 0; c < contents.size(); c++) contents[c] = uint8_t((c * c) >> 3);
+
+	write(directory + "/ContainerTests.bin.gz", compress(contents.size(), 16 + MAX_WBITS, contents).data);
+	const auto gzip = Storage::Container::contents(directory + "/ContainerTests.bin.gz/ContainerTests.bin");
+	XCTAssert(gzip && *gzip == contents);
+
+	write(directory + "/ContainerTests.zip", zip("file.bin", compress(contents.size(), -MAX_WBITS, contents)));
+	const auto zipped = Storage::Container::contents(directory + "/ContainerTests.zip/file.bin");
+	XCTAssert(zipped && *zipped == contents);
+}
+
+/// Tests that a gzip file that would decompress to an excessive size, while being otherwise valid, is rejected.
+- (void)testGzipBomb {
+	const std::string directory = NSTemporaryDirectory().UTF8String;
+
+	write(directory + "/ContainerBomb.bin.gz", compress(BombSize, 16 + MAX_WBITS).data);
+	XCTAssert(Storage::Container::contents(directory + "/ContainerBomb.bin.gz/ContainerBomb.bin") == nullptr);
+}
+
+/// Tests that a zip file containing a file that would decompress to an excessive size, with an accurate
+/// size and CRC in its directory, is rejected.
+- (void)testZipBomb {
+	const std::string directory = NSTemporaryDirectory().UTF8String;
+
+	write(directory + "/ContainerBomb.zip", zip("bomb.bin", compress(BombSize, -MAX_WBITS)));
+	XCTAssertEqual(Storage::Container::members(directory + "/ContainerBomb.zip").size(), 1);
+	XCTAssert(Storage::Container::contents(directory + "/ContainerBomb.zip/bomb.bin") == nullptr);
+}
+
+@end
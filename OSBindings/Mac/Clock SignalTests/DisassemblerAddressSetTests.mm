@@ -0,0 +1,157 @@
+//
+//  DisassemblerAddressSetTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Analyser/Static/Disassembler/AddressSet.hpp"
+
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace Analyser::Static::Disassembler;
+
+namespace {
+
+/// @returns A random address, clustered so that neighbouring bits and whole words are exercised.
+uint16_t random_address(std::mt19937 &random) {
+	switch(random() % 3) {
+		default:	return uint16_t(random());
+		case 1:		return uint16_t(random() & 0x1ff);
+		case 2:		return uint16_t(0xff00 | (random() & 0xff));
+	}
+}
+
+std::vector<uint16_t> contents(const AddressSet &set) {
+	return std::vector<uint16_t>(set.begin(), set.end());
+}
+
+std::vector<std::pair<uint16_t, int>> contents(const AddressMap<int> &map) {
+	std::vector<std::pair<uint16_t, int>> result;
+	for(const auto &[address, value]: map) {
+		result.emplace_back(address, value);
+	}
+	return result;
+}
+
+std::vector<std::pair<uint16_t, int>> contents(const std::map<uint16_t, int> &map) {
+	return std::vector<std::pair<uint16_t, int>>(map.begin(), map.end());
+}
+
+}
+
+@interface DisassemblerAddressSetTests : XCTestCase
+@end
+
+@implementation DisassemblerAddressSetTests
+
+- (void)testSetMatchesStdSet {
+	std::mt19937 random(0xadd5);
+
+	for(int round = 0; round < 20; round++) {
+		AddressSet set;
+		std::set<uint16_t> reference;
+
+		const int inserts = int(random() % 4096);
+		for(int c = 0; c < inserts; c++) {
+			const auto address = random_address(random);
+			set.insert(address);
+			reference.insert(address);
+
+			const auto probe = random_address(random);
+			XCTAssertEqual(set.count(probe), reference.count(probe));
+			XCTAssertEqual(set.find(probe) == set.end(), reference.find(probe) == reference.end());
+			if(set.find(probe) != set.end()) {
+				XCTAssertEqual(*set.find(probe), probe);
+			}
+		}
+
+		XCTAssertEqual(set.size(), reference.size());
+		XCTAssertEqual(set.empty(), reference.empty());
+		XCTAssert(contents(set) == std::vector<uint16_t>(reference.begin(), reference.end()));
+	}
+}
+
+- (void)testSetExtremes {
+	AddressSet set;
+	XCTAssert(set.begin() == set.end());
+
+	set.insert(0xffff);
+	set.insert(0x0000);
+	set.insert(0x003f);
+	set.insert(0x0040);
+	XCTAssert(contents(set) == std::vector<uint16_t>({0x0000, 0x003f, 0x0040, 0xffff}));
+	XCTAssertEqual(set.size(), 4);
+
+	AddressSet full;
+	for(int address = 0; address < 65536; address++) {
+		full.insert(uint16_t(address));
+	}
+	XCTAssertEqual(full.size(), 65536);
+	XCTAssertEqual(contents(full).size(), 65536);
+}
+
+- (void)testMapMatchesStdMap {
+	std::mt19937 random(0xadd3);
+
+	for(int round = 0; round < 20; round++) {
+		AddressMap<int> map;
+		std::map<uint16_t, int> reference;
+
+		const int writes = int(random() % 4096);
+		for(int c = 0; c < writes; c++) {
+			const auto address = random_address(random);
+			const int value = int(random());
+			if(random() & 1) {
+				map[address] = value;
+				reference[address] = value;
+			} else {
+				map[address] += value;
+				reference[address] += value;
+			}
+
+			const auto probe = random_address(random);
+			XCTAssertEqual(map.count(probe), reference.count(probe));
+			const auto found = map.find(probe);
+			XCTAssertEqual(found == map.end(), reference.find(probe) == reference.end());
+			if(found != map.end()) {
+				XCTAssertEqual((*found).first, probe);
+				XCTAssertEqual((*found).second, reference[probe]);
+			}
+		}
+
+		XCTAssertEqual(map.size(), reference.size());
+		XCTAssert(contents(map) == contents(reference));
+
+		// Copies should be independent of the original; moves should preserve contents.
+		AddressMap<int> copy = map;
+		copy[random_address(random)] += 1;
+		XCTAssert(contents(map) == contents(reference));
+
+		AddressMap<int> moved = std::move(map);
+		XCTAssert(contents(moved) == contents(reference));
+
+		copy = moved;
+		XCTAssert(contents(copy) == contents(reference));
+	}
+}
+
+- (void)testEmptyMapCopy {
+	AddressMap<int> map;
+	AddressMap<int> copy = map;
+	XCTAssert(copy.empty());
+	XCTAssert(copy.begin() == copy.end());
+
+	copy[0x1234] = 5;
+	XCTAssertEqual(copy.size(), 1);
+	XCTAssert(map.empty());
+}
+
+@end
@@ -0,0 +1,198 @@
+//
+//  DiskIITests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/DiskII/DiskII.hpp"
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// A single-sided, write-protected disk on which every track is entirely 1s, i.e. has a flux
+/// transition every 4µs, or every 8 2/11ths cycles of a 2,045,454Hz Disk II.
+class UniformFluxDisk: public Storage::Disk::Disk {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final	{	return Storage::Disk::HeadPosition(35);	}
+		int get_head_count() final										{	return 1;		}
+		bool get_is_read_only() final									{	return true;	}
+		void flush_tracks() final										{}
+		void set_track_at_position(Storage::Disk::Track::Address, const std::shared_ptr<Storage::Disk::Track> &) final {}
+		bool tracks_differ(Storage::Disk::Track::Address lhs, Storage::Disk::Track::Address rhs) final {
+			return lhs != rhs;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address) final {
+			// Tracks carry their own read position, so each request gets a new one.
+			return std::make_shared<Storage::Disk::PCMTrack>(
+				Storage::Disk::PCMSegment(Storage::Time(1, 250000), std::vector<bool>(50000, true)));
+		}
+};
+
+constexpr int ClockRate = 2045454;
+constexpr float CyclesPerRevolution = float(ClockRate) / 5.0f;
+
+/// @returns A sequencer ROM, in Beneath Apple ProDOS order, that counts flux pulses modulo 7 while reading, with
+/// the count visible as the number of 1s in the shift register; and that, while sensing write protect, steps
+/// through its states in order, stopping at state 15 to shift right, bringing in the write-protect status.
+std::vector<uint8_t> pulse_counting_rom() {
+	std::vector<uint8_t> rom(256, 0x0a);
+	for(int address = 0; address < 256; address++) {
+		if((address & 0x0c) != 0x04) continue;
+		const int state = address >> 4;
+		rom[size_t(address)] = state < 15 ? uint8_t(((state + 1) << 4) | 0x8) : 0xfa;
+	}
+
+	// While reading, states 1–7 await the next pulse, states 8–14 await the end of the current one. State 0
+	// is used only at startup and so that the first byte can declare this ROM's order.
+	for(int count = 0; count < 7; count++) {
+		const int idle = 1 + count, pulse = 8 + count;
+		const int next_count = (count + 1) % 7;
+		for(int shift = 0; shift < 4; shift += 2) {
+			rom[size_t((idle << 4) | shift | 1)] = uint8_t((idle << 4) | 0x8);
+			rom[size_t((idle << 4) | shift)] = uint8_t(((8 + next_count) << 4) | (next_count ? 0xd : 0x0));
+			rom[size_t((pulse << 4) | shift)] = uint8_t((pulse << 4) | 0x8);
+			rom[size_t((pulse << 4) | shift | 1)] = uint8_t(((1 + count) << 4) | 0x8);
+		}
+	}
+	for(int address = 0; address < 4; address++) {
+		rom[size_t(address)] = 0x18;
+	}
+
+	// The above is indexed as state | Q7 | Q6 | shift register bit 7 | flux; Beneath Apple ProDOS order
+	// instead has the flux input at bit 4, and bits 4 and 5 of the state at bits 5 and 0.
+	std::vector<uint8_t> reordered(256);
+	for(size_t address = 0; address < 256; address++) {
+		reordered[
+			(address & 0xce) |
+			((address & 0x20) ? 0x01 : 0x00) |
+			((address & 0x10) ? 0x20 : 0x00) |
+			((address & 0x01) ? 0x10 : 0x00)
+		] = rom[address];
+	}
+	return reordered;
+}
+
+/// Selects read mode, if not already selected, and @returns the number of pulses counted so far, modulo 7.
+int pulse_count(Apple::DiskII &disk_ii) {
+	return __builtin_popcount(disk_ii.read_address(0xc));
+}
+
+/// @returns A Disk II with a @c UniformFluxDisk in drive 0, its motor on, in read mode.
+std::unique_ptr<Apple::DiskII> disk_ii() {
+	auto disk_ii = std::make_unique<Apple::DiskII>(ClockRate);
+	disk_ii->set_state_machine(pulse_counting_rom());
+	disk_ii->set_disk(std::make_shared<UniformFluxDisk>(), 0);
+	disk_ii->read_address(0x9);
+	disk_ii->read_address(0xe);
+	disk_ii->read_address(0xc);
+	return disk_ii;
+}
+
+}
+
+@interface DiskIITests : XCTestCase
+@end
+
+@implementation DiskIITests
+
+/// Tests that flux pulses are counted identically whether the Disk II is run in a single call, through which the
+/// sequencer is stepped in batches between drive events, or a cycle at a time; for every run length up to
+/// 256 cycles, so that runs end upon, within and between pulses, and for runs that span the index hole.
+- (void)testPulsesSeenWithinLongRuns {
+	auto stepped = disk_ii();
+	std::vector<int> counts(1, 0);
+	for(int c = 0; c < 256; c++) {
+		stepped->run_for(Cycles(1));
+		counts.push_back(pulse_count(*stepped));
+	}
+
+	// The flux input starts out active, which absorbs the first transition at cycle 4. Each later one, every
+	// 8 2/11ths cycles, should be counted a cycle after it occurs.
+	XCTAssertEqual(counts[2], 1);
+	XCTAssertEqual(counts[12], 1);
+	XCTAssertEqual(counts[13], 2);
+	XCTAssertEqual(counts[256], (2 + (256 - 13) * 11 / 90) % 7);
+
+	for(int length = 1; length <= 256; length++) {
+		auto bulk = disk_ii();
+		bulk->run_for(Cycles(length));
+		XCTAssertEqual(pulse_count(*bulk), counts[size_t(length)], @"Differs after %d cycles", length);
+	}
+
+	// Run to either side of the index hole, which is a drive event other than a flux transition.
+	int time = 256;
+	for(const int end: {int(CyclesPerRevolution) - 3, int(CyclesPerRevolution) + 17}) {
+		for(; time < end; time++) {
+			stepped->run_for(Cycles(1));
+		}
+		auto bulk = disk_ii();
+		bulk->run_for(Cycles(end));
+		XCTAssertEqual(pulse_count(*bulk), pulse_count(*stepped));
+		XCTAssertEqual(bulk->get_drive(0).get_index_pulse(), end > CyclesPerRevolution);
+	}
+}
+
+/// Tests that the sequencer advances through states that don't alter the shift register while sensing write protect,
+/// and that the disk continues to turn once the shift register has filled, however the Disk II is clocked.
+- (void)testSensingWriteProtect {
+	for(const bool stepped: {false, true}) {
+		auto disk_ii = ::disk_ii();
+		disk_ii->read_address(0xd);
+
+		const auto run_for = [&](int cycles) {
+			if(stepped) {
+				for(int c = 0; c < cycles; c++) {
+					disk_ii->run_for(Cycles(1));
+				}
+			} else {
+				disk_ii->run_for(Cycles(cycles));
+			}
+		};
+
+		// Fifteen cycles should pass before the first shift.
+		run_for(20);
+		XCTAssertEqual(disk_ii->read_address(0xe), 0xf8);
+
+		// Once the index pulse that began at startup has ended, sense until just after the index hole.
+		run_for(int(CyclesPerRevolution) / 2 - 20);
+		XCTAssertEqual(disk_ii->read_address(0xe), 0xff);
+		XCTAssertFalse(disk_ii->get_drive(0).get_index_pulse());
+
+		run_for(int(CyclesPerRevolution) / 2 + 100);
+		XCTAssertEqual(disk_ii->read_address(0xe), 0xff);
+		XCTAssert(disk_ii->get_drive(0).get_index_pulse());
+	}
+}
+
+/// Tests that after the motor is switched off the disk continues to turn for two further seconds, one being the
+/// delay applied by the Disk II and the other the drive's spin down, after which the Disk II no longer requires clocking.
+- (void)testMotorOff {
+	auto disk_ii = ::disk_ii();
+	disk_ii->run_for(Cycles(1000));
+	disk_ii->read_address(0x8);
+
+	disk_ii->run_for(Cycles(ClockRate));
+	XCTAssert(disk_ii->get_drive(0).get_motor_on());
+	disk_ii->run_for(Cycles(1));
+	XCTAssertFalse(disk_ii->get_drive(0).get_motor_on());
+
+	// Pulses should continue until the drive stops, a second after its motor input went inactive.
+	const int count = pulse_count(*disk_ii);
+	disk_ii->run_for(Cycles(ClockRate - 1));
+	XCTAssertNotEqual(pulse_count(*disk_ii), count);
+	XCTAssertEqual(disk_ii->preferred_clocking(), ClockingHint::Preference::JustInTime);
+
+	disk_ii->run_for(Cycles(1));
+	XCTAssertEqual(disk_ii->preferred_clocking(), ClockingHint::Preference::None);
+}
+
+@end
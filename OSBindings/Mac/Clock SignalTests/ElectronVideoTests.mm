@@ -0,0 +1,128 @@
+//
+//  ElectronVideoTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Electron/Video.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+// Frame geometry, as per Video.cpp.
+constexpr int first_graphics_line = 31;
+constexpr int first_graphics_cycle = 33;
+constexpr int field_divider_line = 312;
+
+int graphics_line(int position) {
+	return ((position >> 7) - first_graphics_line + field_divider_line) % field_divider_line;
+}
+
+int graphics_column(int position) {
+	return ((position & 127) - first_graphics_cycle + 128) & 127;
+}
+
+/// @returns The delay to align to the CPU's 1Mhz RAM slots from @c position.
+unsigned int alignment(int position) {
+	return unsigned(1 + (position & 1));
+}
+
+/// @returns The delay before RAM is available from @c position in a mode that fetches pixels on
+/// every line of the display area, i.e. Modes 0–2.
+unsigned int bitmapped_delay(int position) {
+	const int column = graphics_column(position + (position & 1));
+	const int line = graphics_line(position);
+	return (column < 80 && line < 256) ? alignment(position) + unsigned(80 - column) : alignment(position);
+}
+
+/// Tracks the Mode 3 character row at the current output position, which isn't otherwise exposed,
+/// by eliminating every candidate that is inconsistent with an observed delay.
+struct Mode3RowCandidates {
+	int output_line;
+	int candidates = 0x3ff;
+
+	Mode3RowCandidates(int output_position) : output_line(graphics_line(output_position)) {}
+
+	/// @returns @c true if @c delay is a possible result at @c position.
+	bool apply(int position, unsigned int delay) {
+		const int line = graphics_line(position);
+		const auto blocked = bitmapped_delay(position);
+
+		// Outside of the display area, or after wrapping into the next field, the result is fully determined.
+		if(blocked == alignment(position)) return delay == blocked;
+		if(line < output_line) {
+			return delay == ((line % 10 < 8 && line < 250) ? blocked : alignment(position));
+		}
+
+		// Otherwise it depends on the current character row.
+		for(int row = 0; row < 10; row++) {
+			const int implied_row = (row + line - output_line) % 10;
+			const auto expected = (implied_row < 8 && line < 250) ? blocked : alignment(position);
+			if(expected != delay) candidates &= ~(1 << row);
+		}
+		return candidates;
+	}
+};
+
+}
+
+@interface ElectronVideoTests : XCTestCase
+@end
+
+@implementation ElectronVideoTests
+
+/// Tests the CPU's RAM delays in all modes, from arbitrary output positions, with mode changes at arbitrary times.
+- (void)testRAMAvailability {
+	std::vector<uint8_t> memory(65536);
+	Electron::VideoOutput video(memory.data());
+
+	std::mt19937 random(0xe1ec);
+	int output_position = 0;
+	int mode = 6;
+	int blocked = 0, mode3_rounds = 0;
+
+	for(int round = 0; round < 3000; round++) {
+		if(random() & 1) {
+			mode = int(random() & 7);
+			video.write(0xfe07, uint8_t(mode << 3));
+			if(mode == 7) mode = 4;
+		}
+
+		const int cycles = int(random() % 8192);
+		video.run_for(Cycles(cycles));
+		output_position = (output_position + cycles) % Electron::VideoOutput::CyclesPerFrame;
+
+		Mode3RowCandidates rows(output_position);
+		mode3_rounds += mode == 3;
+
+		for(int c = 0; c < 256; c++) {
+			const int from_time = int(random() % (Electron::VideoOutput::CyclesPerFrame * 2));
+			const int position = (output_position + from_time) % Electron::VideoOutput::CyclesPerFrame;
+			const auto delay = video.get_cycles_until_next_ram_availability(from_time);
+			blocked += delay > 2;
+
+			switch(mode) {
+				case 0: case 1: case 2:
+					XCTAssertEqual(delay, bitmapped_delay(position), @"Mode %d delay differs at position %d", mode, position);
+				break;
+				case 3:
+					XCTAssert(rows.apply(position, delay), @"Mode 3 delay inconsistent at position %d", position);
+				break;
+				default:
+					XCTAssertEqual(delay, alignment(position), @"Mode %d delay differs at position %d", mode, position);
+				break;
+			}
+		}
+	}
+
+	XCTAssertGreaterThan(blocked, 100000);
+	XCTAssertGreaterThan(mode3_rounds, 100);
+}
+
+@end
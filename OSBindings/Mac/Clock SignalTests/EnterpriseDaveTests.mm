@@ -9,7 +9,10 @@
 #import <XCTest/XCTest.h>
 
 #include "../../../Machines/Enterprise/Dave.hpp"
+#include <cstdlib>
 #include <memory>
+#include <random>
+#include <vector>
 
 @interface EnterpriseDaveTests : XCTestCase
 @end
@@ -99,4 +102,59 @@
 	[self performTestExpectedInterrupts:250000.0/(962.0 * 2.0) mode:3];
 }
 
+/// Tests that audio output is the same whether it is requested in large blocks, which are filled in bulk
+/// while output is settled, or a frame at a time.
+- (void)testAudioBlockSizeInvariance {
+	Concurrency::AsyncTaskQueue<false> queue;
+
+	// Dave's polynomials start from random states, so seed identically for each instance.
+	srand(1);
+	Enterprise::Dave::Audio bulk(queue);
+	srand(1);
+	Enterprise::Dave::Audio stepped(queue);
+	bulk.set_sample_volume_range(32767);
+	stepped.set_sample_volume_range(32767);
+
+	std::mt19937 random(0xda7e);
+	std::vector<int16_t> bulk_samples, stepped_samples;
+	for(int round = 0; round < 200; round++) {
+		// Randomise some tone, noise and amplitude registers; only occasionally enable
+		// ring modulation or sync, so that there are settled periods to fill in bulk.
+		for(int c = 0; c < 4; c++) {
+			const uint16_t address = uint16_t(random() & 0xf);
+			uint8_t value = uint8_t(random());
+			if((address == 1 || address == 3 || address == 5 || address == 6) && (random() & 3)) {
+				value &= 0x7f;
+			}
+			if(address == 7 && (random() & 3)) {
+				value &= ~0x07;
+			}
+			bulk.write(address, value);
+			stepped.write(address, value);
+		}
+		if(!(round % 50)) {
+			const uint8_t divider = uint8_t(random());
+			bulk.write(31, divider);
+			stepped.write(31, divider);
+		}
+
+		const size_t length = 1 + random() % 4096;
+		queue.enqueue([&, length] {
+			const size_t offset = bulk_samples.size();
+			bulk_samples.resize(offset + length * 2);
+			stepped_samples.resize(offset + length * 2);
+
+			bulk.get_samples(length, &bulk_samples[offset]);
+			for(size_t c = 0; c < length; c++) {
+				stepped.get_samples(1, &stepped_samples[offset + c * 2]);
+			}
+		});
+		queue.perform();
+	}
+	queue.stop();
+
+	XCTAssertEqual(bulk_samples.size(), stepped_samples.size());
+	XCTAssert(bulk_samples == stepped_samples);
+}
+
 @end
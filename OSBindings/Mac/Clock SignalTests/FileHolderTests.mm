@@ -0,0 +1,93 @@
+//
+//  FileHolderTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/FileHolder.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+@interface FileHolderTests : XCTestCase
+@end
+
+@implementation FileHolderTests
+
+/// Tests that a file opened for reading only, and therefore mapped into memory, answers every read,
+/// seek, tell and eof exactly as does the same file opened for reading and writing, and therefore
+/// accessed via stdio.
+- (void)testMappedReadsMatchStdio {
+	NSString *const path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"FileHolderTests.bin"];
+	const std::string file_name = path.UTF8String;
+
+	std::mt19937 random(0xf11e);
+	for(const size_t size: {size_t(0), size_t(1), size_t(7), size_t(4096), size_t(65537)}) {
+		{
+			std::vector<uint8_t> contents(size);
+			for(auto &byte: contents) byte = uint8_t(random());
+
+			FILE *const file = fopen(file_name.c_str(), "wb");
+			fwrite(contents.data(), 1, contents.size(), file);
+			fclose(file);
+		}
+
+		Storage::FileHolder mapped(file_name, Storage::FileHolder::FileMode::Read);
+		Storage::FileHolder stdio(file_name, Storage::FileHolder::FileMode::ReadWrite);
+		XCTAssertFalse(stdio.get_is_known_read_only());
+
+		for(int c = 0; c < 20000; c++) {
+			switch(random() % 14) {
+				case 0:		XCTAssertEqual(mapped.get8(), stdio.get8());					break;
+				case 1:		XCTAssertEqual(mapped.get16le(), stdio.get16le());				break;
+				case 2:		XCTAssertEqual(mapped.get16be(), stdio.get16be());				break;
+				case 3:		XCTAssertEqual(mapped.get24le(), stdio.get24le());				break;
+				case 4:		XCTAssertEqual(mapped.get24be(), stdio.get24be());				break;
+				case 5:		XCTAssertEqual(mapped.get32le(), stdio.get32le());				break;
+				case 6:		XCTAssertEqual(mapped.get32be(), stdio.get32be());				break;
+				case 7:		XCTAssertEqual(mapped.get_le<uint64_t>(), stdio.get_le<uint64_t>());	break;
+				case 8:		XCTAssertEqual(mapped.get_be<uint64_t>(), stdio.get_be<uint64_t>());	break;
+
+				case 9: {
+					const size_t length = random() % 64;
+					XCTAssert(mapped.read(length) == stdio.read(length));
+				} break;
+
+				case 10: {
+					const bool lsb_first = random() & 1;
+					auto mapped_bits = mapped.get_bitstream(lsb_first);
+					auto stdio_bits = stdio.get_bitstream(lsb_first);
+					for(int bits = 0; bits < 4; bits++) {
+						const int count = 1 + int(random() % 8);
+						XCTAssertEqual(mapped_bits.get_bits(count), stdio_bits.get_bits(count));
+					}
+				} break;
+
+				case 11:
+				case 12: {
+					constexpr int whences[] = {SEEK_SET, SEEK_CUR, SEEK_END};
+					const int whence = whences[random() % 3];
+					const long offset = long(random() % (size + 32)) - 16 - (whence == SEEK_END ? long(size) : 0);
+					mapped.seek(offset, whence);
+					stdio.seek(offset, whence);
+				} break;
+
+				case 13:
+					XCTAssertEqual(mapped.eof(), stdio.eof());
+				break;
+			}
+
+			XCTAssertEqual(mapped.tell(), stdio.tell(), @"Position differs after %d operations on a file of size %zu", c, size);
+		}
+	}
+
+	remove(file_name.c_str());
+}
+
+@end
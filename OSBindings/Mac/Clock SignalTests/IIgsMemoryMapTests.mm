@@ -22,7 +22,7 @@ namespace {
 
 @implementation IIgsMemoryMapTests {
 	MemoryMap _memoryMap;
-	std::vector<uint8_t> _ram;
+	Memory::LargeVector<uint8_t> _ram;
 	std::vector<uint8_t> _rom;
 }
 
@@ -0,0 +1,213 @@
+//
+//  IIgsSoundTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Apple/AppleIIgs/Sound.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using GLU = Apple::IIgs::Sound::GLU;
+
+void write_register(GLU &glu, uint8_t address, uint8_t value) {
+	glu.set_control(0x00);
+	glu.set_address_low(address);
+	glu.set_address_high(0);
+	glu.set_data(value);
+}
+
+/// Writes @c count copies of @c value to sound RAM from @c address onwards, all timestamped to land after the next sample.
+void write_ram(GLU &glu, uint16_t address, int count, uint8_t value) {
+	glu.set_control(0x60);
+	glu.set_address_low(uint8_t(address));
+	glu.set_address_high(uint8_t(address >> 8));
+	for(int c = 0; c < count; c++) {
+		glu.set_data(value);
+	}
+}
+
+/// Sets @c oscillator to step through the 256-byte table at @c page at a rate of one byte per sample with a volume of 64,
+/// and then sets its control register to @c control.
+void set_oscillator(GLU &glu, uint8_t oscillator, uint8_t page, uint8_t control) {
+	write_register(glu, 0x00 + oscillator, 0x00);
+	write_register(glu, 0x20 + oscillator, 0x01);
+	write_register(glu, 0x40 + oscillator, 64);
+	write_register(glu, 0x80 + oscillator, page);
+	write_register(glu, 0xc0 + oscillator, 0x00);
+	write_register(glu, 0xa0 + oscillator, control);
+}
+
+/// With this volume range, an oscillator with a volume of 64 reading a sample of 0xc0 outputs 64.
+constexpr int16_t VolumeRange = 16384;
+
+/// Requests @c count samples from @c glu on the audio queue, after all previously-enqueued register writes,
+/// and @returns them.
+std::vector<int16_t> get_samples(Concurrency::AsyncTaskQueue<false> &queue, GLU &glu, size_t count) {
+	std::vector<int16_t> samples(count);
+	queue.enqueue([&] {
+		glu.get_samples(samples.size(), samples.data());
+	});
+	queue.flush();
+	return samples;
+}
+
+/// @returns @c true if @c samples[begin, end) are all equal to @c value.
+bool all_equal(const std::vector<int16_t> &samples, size_t begin, size_t end, int16_t value) {
+	return std::all_of(samples.begin() + ptrdiff_t(begin), samples.begin() + ptrdiff_t(end), [value](int16_t sample) {
+		return sample == value;
+	});
+}
+
+}
+
+@interface IIgsSoundTests : XCTestCase
+@end
+
+@implementation IIgsSoundTests
+
+/// Tests that all RAM writes that have fallen due land after a single sample, including once more writes have
+/// been made in total than the pending-write buffer can hold.
+- (void)testRAMWritesLandTogether {
+	Concurrency::AsyncTaskQueue<false> queue;
+	auto glu = std::make_unique<GLU>(queue);
+	glu->set_sample_volume_range(VolumeRange);
+
+	// Fill pages 0x00–0x4f in five batches, each of which should land after a single sample.
+	for(uint16_t address = 0; address < 0x5000; address += 0x1000) {
+		write_ram(*glu, address, 0x1000, 0xc0);
+		get_samples(queue, *glu, 1);
+	}
+
+	// Read the final page of the first batch, and the final page overall. Either would halt
+	// upon any zero.
+	write_register(*glu, 0xe1, 1 << 1);
+	set_oscillator(*glu, 0, 0x0f, 0x00);
+	set_oscillator(*glu, 1, 0x4f, 0x00);
+	const auto samples = get_samples(queue, *glu, 512);
+	XCTAssert(all_equal(samples, 0, 512, 128));
+	queue.stop();
+}
+
+/// Tests that oscillators drop out of a single call to get_samples exactly as they halt, whether by reaching
+/// the end of a one-shot table or by encountering a zero, and that a halted oscillator rejoins when restarted.
+- (void)testHaltingWithinBlock {
+	Concurrency::AsyncTaskQueue<false> queue;
+	auto glu = std::make_unique<GLU>(queue);
+	glu->set_sample_volume_range(VolumeRange);
+
+	// Page 0 holds a constant level; page 1 is the same except for a zero half way through.
+	write_ram(*glu, 0x0000, 0x200, 0xc0);
+	write_ram(*glu, 0x0180, 1, 0x00);
+	get_samples(queue, *glu, 1);
+
+	// Oscillator 0 is one-shot, oscillators 1 and 2 run freely.
+	write_register(*glu, 0xe1, 2 << 1);
+	set_oscillator(*glu, 0, 0, 0x02);
+	set_oscillator(*glu, 1, 1, 0x00);
+	set_oscillator(*glu, 2, 0, 0x00);
+
+	// Oscillator 1 should reach its zero on sample 127; a one-shot oscillator with a 256-byte table and
+	// the lowest resolution halts upon its accumulator reaching 0x20000, i.e. on sample 511.
+	auto samples = get_samples(queue, *glu, 1000);
+	XCTAssert(all_equal(samples, 0, 127, 192));
+	XCTAssert(all_equal(samples, 127, 511, 128));
+	XCTAssert(all_equal(samples, 511, 1000, 64));
+
+	// Restart oscillator 0, which was reset to the start of its table when it halted.
+	write_register(*glu, 0xa0, 0x02);
+	samples = get_samples(queue, *glu, 1000);
+	XCTAssert(all_equal(samples, 0, 511, 128));
+	XCTAssert(all_equal(samples, 511, 1000, 64));
+
+	// Restart oscillator 1, which should have remained upon its zero, so reaches it again after a whole table.
+	write_register(*glu, 0xa1, 0x00);
+	samples = get_samples(queue, *glu, 1000);
+	XCTAssert(all_equal(samples, 0, 255, 128));
+	XCTAssert(all_equal(samples, 255, 1000, 64));
+	queue.stop();
+}
+
+/// Tests that an odd oscillator in amplitude-modulation mode modulates only the oscillator above it, and only
+/// within the same sample.
+- (void)testAmplitudeModulation {
+	Concurrency::AsyncTaskQueue<false> queue;
+	auto glu = std::make_unique<GLU>(queue);
+	glu->set_sample_volume_range(VolumeRange);
+
+	// Page 0 holds a level of 64 at volume 64; page 1 an amplitude of 64.
+	write_ram(*glu, 0x0000, 0x100, 0xc0);
+	write_ram(*glu, 0x0100, 0x100, 0x40);
+	get_samples(queue, *glu, 1);
+
+	write_register(*glu, 0xe1, 2 << 1);
+	set_oscillator(*glu, 0, 0, 0x00);
+	set_oscillator(*glu, 1, 1, 0x04);
+	set_oscillator(*glu, 2, 0, 0x00);
+
+	// Oscillator 2 should be reduced to 64/255ths of its full output.
+	auto samples = get_samples(queue, *glu, 256);
+	XCTAssert(all_equal(samples, 0, 256, ((4096 + 4096 * 64 / 255) * VolumeRange) >> 20));
+
+	// With oscillator 2 halted, oscillator 0 should be unaffected.
+	write_register(*glu, 0xa2, 0x01);
+	samples = get_samples(queue, *glu, 256);
+	XCTAssert(all_equal(samples, 0, 256, 64));
+	queue.stop();
+}
+
+/// Tests that a swap from an even oscillator to the one above it is seamless: the partner
+/// contributes output from the same sample that the first oscillator halts.
+- (void)testSwapUpIsSeamless {
+	Concurrency::AsyncTaskQueue<false> queue;
+	auto glu = std::make_unique<GLU>(queue);
+	glu->set_sample_volume_range(32767);
+
+	// Page 0 holds a constant positive level, page 1 a constant negative one.
+	glu->set_control(0x60);
+	glu->set_address_low(0);
+	glu->set_address_high(0);
+	for(int c = 0; c < 512; c++) {
+		glu->run_for(Cycles(1));
+		glu->set_data(c < 256 ? 0xc0 : 0x40);
+	}
+
+	// Let the RAM writes land, while all oscillators run into zeroes and halt.
+	std::vector<int16_t> samples(1024);
+	queue.enqueue([&] {
+		glu->get_samples(samples.size(), samples.data());
+	});
+
+	// Use two oscillators in swap mode, each with a 256-byte table; start only the first.
+	write_register(*glu, 0xe1, 2);
+	for(uint8_t oscillator = 0; oscillator < 2; oscillator++) {
+		write_register(*glu, 0x00 + oscillator, 0x00);
+		write_register(*glu, 0x20 + oscillator, 0x10);
+		write_register(*glu, 0x40 + oscillator, 0xff);
+		write_register(*glu, 0x80 + oscillator, oscillator);
+		write_register(*glu, 0xc0 + oscillator, 0x00);
+		write_register(*glu, 0xa0 + oscillator, 0x06 | oscillator);
+	}
+	queue.enqueue([&] {
+		glu->get_samples(samples.size(), samples.data());
+	});
+	queue.stop();
+
+	// Output should go directly from positive to negative.
+	const auto first_negative = std::find_if(samples.begin(), samples.end(), [](int16_t sample) { return sample < 0; });
+	XCTAssert(first_negative != samples.end());
+	XCTAssert(first_negative != samples.begin());
+	if(first_negative == samples.end() || first_negative == samples.begin() || first_negative + 1 == samples.end()) return;
+	XCTAssertGreaterThan(*(first_negative - 1), 0);
+	XCTAssertLessThan(*(first_negative + 1), 0);
+}
+
+@end
@@ -0,0 +1,131 @@
+//
+//  IWMTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/DiskII/IWM.hpp"
+#include "../../../Components/DiskII/MacintoshDoubleDensityDrive.hpp"
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// A double-sided, 80-track disk in which every track holds a fixed pseudo-random flux pattern.
+///
+/// No more than two consecutive zeroes are permitted, as per GCR, so that the drive never
+/// reaches a long enough gap to start generating its own random transitions.
+class RandomFluxDisk: public Storage::Disk::Disk {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final	{	return Storage::Disk::HeadPosition(80);	}
+		int get_head_count() final										{	return 2;		}
+		bool get_is_read_only() final									{	return true;	}
+		void flush_tracks() final										{}
+		void set_track_at_position(Storage::Disk::Track::Address, const std::shared_ptr<Storage::Disk::Track> &) final {}
+		bool tracks_differ(Storage::Disk::Track::Address lhs, Storage::Disk::Track::Address rhs) final {
+			return lhs != rhs;
+		}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			// Tracks carry their own read position, so each request gets a new one.
+			auto &bits = tracks_[address];
+			if(bits.empty()) {
+				std::mt19937 random(unsigned(address.position.as_quarter() * 2 + address.head));
+				bits.resize(60000);
+				int zeroes = 0;
+				for(size_t c = 0; c < bits.size(); c++) {
+					bits[c] = zeroes == 2 || random() % 3;
+					zeroes = bits[c] ? 0 : zeroes + 1;
+				}
+			}
+			return std::make_shared<Storage::Disk::PCMTrack>(Storage::Disk::PCMSegment(Storage::Time(1, 500000), bits));
+		}
+
+	private:
+		std::map<Storage::Disk::Track::Address, std::vector<bool>> tracks_;
+};
+
+/// An IWM with an 800kb drive attached, holding @c disk and spinning.
+struct IWMAndDrive {
+	static constexpr int ClockRate = 7833600;
+	Apple::IWM iwm{ClockRate};
+	Apple::Macintosh::DoubleDensityDrive drive{ClockRate, true};
+
+	IWMAndDrive(const std::shared_ptr<Storage::Disk::Disk> &disk, uint8_t mode) {
+		drive.set_disk(disk);
+		iwm.set_drive(0, &drive);
+
+		// Set the mode register, then select read mode and enable the drive.
+		iwm.read(0xd);
+		iwm.write(0xf, mode);
+		iwm.read(0xe);
+		iwm.read(0xc);
+		iwm.read(0x9);
+		drive.set_motor_on(true);
+	}
+};
+
+}
+
+@interface IWMTests : XCTestCase
+@end
+
+@implementation IWMTests
+
+/// Tests that running the IWM for long periods produces exactly the same bytes as running it one cycle
+/// at a time, in each combination of the mode register's clock and bit-cell selections, and with random
+/// steps and head selections.
+///
+/// The drive is never disabled: the motor-off timer is applied only at the start of each call to
+/// run_for, so is deliberately not block-size invariant.
+- (void)testBlockSizeInvariance {
+	const auto disk = std::make_shared<RandomFluxDisk>();
+
+	for(unsigned seed = 0; seed < 4; seed++) {
+		std::mt19937 random(seed);
+
+		const uint8_t mode = uint8_t(seed << 3) | 0x04;
+		IWMAndDrive bulk(disk, mode), stepped(disk, mode);
+
+		int bytes = 0;
+		for(int c = 0; c < 20000; c++) {
+			// Perform an identical random step or head selection on both.
+			const int action = int(random() % 1000);
+			if(action < 2) {
+				const auto step = Storage::Disk::HeadPosition(action ? 1 : -1);
+				bulk.drive.step(step);
+				stepped.drive.step(step);
+			} else if(action < 3) {
+				const bool select = random() & 1;
+				bulk.iwm.set_select(select);
+				stepped.iwm.set_select(select);
+			}
+
+			const int length = 1 + int(random() % 2000);
+			bulk.iwm.run_for(Cycles(length));
+			for(int step = 0; step < length; step++) {
+				stepped.iwm.run_for(Cycles(1));
+			}
+
+			const uint8_t bulk_value = bulk.iwm.read(0xc);
+			const uint8_t stepped_value = stepped.iwm.read(0xc);
+			XCTAssertEqual(bulk_value, stepped_value, @"Data register differs after %d runs in mode %02x", c, mode);
+			if(bulk_value != stepped_value) return;
+			bytes += bulk_value >> 7;
+		}
+
+		// Sanity check: bytes should have been found.
+		XCTAssertGreaterThan(bytes, 1000);
+	}
+}
+
+@end
@@ -0,0 +1,109 @@
+//
+//  InlineDeferredQueueTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../ClockReceiver/DeferredQueue.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Records the time at which each action was performed, in performance order.
+struct Log {
+	std::vector<std::pair<int, int>> performed;	// (action, time)
+	int time = 0;
+};
+
+/// Advances @c queue one unit at a time until @c end, keeping @c log's time in step.
+template <typename QueueT> void run(QueueT &queue, Log &log, int end) {
+	while(log.time < end) {
+		++log.time;
+		queue.advance(1);
+	}
+}
+
+}
+
+@interface InlineDeferredQueueTests : XCTestCase
+@end
+
+@implementation InlineDeferredQueueTests
+
+- (void)testOrdering {
+	InlineDeferredQueue<int> queue;
+	Log log;
+
+	// Defer out of order, with some coincident times.
+	const int delays[] = {5, 3, 9, 3, 1, 5};
+	for(int c = 0; c < 6; c++) {
+		queue.defer(delays[c], [&log, c] { log.performed.emplace_back(c, log.time); });
+	}
+	XCTAssertEqual(queue.time_until_next_action(), 1);
+
+	run(queue, log, 10);
+	const std::vector<std::pair<int, int>> expected = {{4, 1}, {1, 3}, {3, 3}, {0, 5}, {5, 5}, {2, 9}};
+	XCTAssert(log.performed == expected);
+	XCTAssertEqual(queue.time_until_next_action(), -1);
+}
+
+- (void)testOverflow {
+	// Defer three times as many actions as there are slots, in reverse order of due time.
+	constexpr int count = 12;
+	InlineDeferredQueue<int, count / 3> queue;
+	Log log;
+	for(int c = 0; c < count; c++) {
+		queue.defer(count - c, [&log, c] { log.performed.emplace_back(c, log.time); });
+	}
+
+	// Nothing should have been performed early, and all should be performed on time.
+	XCTAssertTrue(log.performed.empty());
+	XCTAssertEqual(queue.time_until_next_action(), 1);
+
+	run(queue, log, count + 1);
+	XCTAssertEqual(log.performed.size(), count);
+	for(size_t c = 0; c < log.performed.size(); c++) {
+		XCTAssertEqual(log.performed[c].first, count - 1 - int(c));
+		XCTAssertEqual(log.performed[c].second, int(c) + 1);
+	}
+}
+
+- (void)testOverflowWithCoincidentTimes {
+	// Fill all slots and then some, all due at the same time; order of deferral should be retained.
+	InlineDeferredQueue<int, 2> queue;
+	Log log;
+	for(int c = 0; c < 5; c++) {
+		queue.defer(4, [&log, c] { log.performed.emplace_back(c, log.time); });
+	}
+
+	run(queue, log, 5);
+	const std::vector<std::pair<int, int>> expected = {{0, 4}, {1, 4}, {2, 4}, {3, 4}, {4, 4}};
+	XCTAssert(log.performed == expected);
+}
+
+- (void)testDeferralFromAction {
+	// An action deferred by another is timed from the moment that the first was due,
+	// even when the queue is advanced in a single step.
+	InlineDeferredQueue<int, 1> queue;
+	std::vector<int> performed;
+	queue.defer(3, [&] {
+		performed.push_back(0);
+		queue.defer(2, [&] { performed.push_back(1); });
+	});
+	queue.defer(4, [&] { performed.push_back(2); });
+
+	queue.advance(4);
+	XCTAssert(performed == std::vector<int>({0, 2}));
+	XCTAssertEqual(queue.time_until_next_action(), 1);
+
+	queue.advance(1);
+	XCTAssert(performed == std::vector<int>({0, 2, 1}));
+}
+
+@end
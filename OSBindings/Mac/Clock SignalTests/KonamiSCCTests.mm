@@ -0,0 +1,59 @@
+//
+//  KonamiSCCTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/KonamiSCC/KonamiSCC.hpp"
+
+#include <random>
+#include <vector>
+
+@interface KonamiSCCTests : XCTestCase
+@end
+
+@implementation KonamiSCCTests
+
+/// Tests that output is the same whether it is requested in large blocks, which are filled in bulk
+/// between tone-counter wraps, or a sample at a time.
+- (void)testBlockSizeInvariance {
+	Concurrency::AsyncTaskQueue<false> queue;
+	Konami::SCC bulk(queue), stepped(queue);
+	bulk.set_sample_volume_range(32767);
+	stepped.set_sample_volume_range(32767);
+
+	std::mt19937 random(0x5cc);
+	std::vector<int16_t> bulk_samples, stepped_samples;
+	for(int round = 0; round < 200; round++) {
+		// Randomise some waveform memory, periods, amplitudes and channel enables.
+		for(int c = 0; c < 16; c++) {
+			const uint8_t value = uint8_t(random());
+			const uint16_t address = (c < 12) ? uint16_t(random() & 0x7f) : uint16_t(0x80 + (random() % 0x10));
+			bulk.write(address, value);
+			stepped.write(address, value);
+		}
+
+		const size_t length = 1 + random() % 4096;
+		queue.enqueue([&, length] {
+			const size_t offset = bulk_samples.size();
+			bulk_samples.resize(offset + length);
+			stepped_samples.resize(offset + length);
+
+			bulk.get_samples(length, &bulk_samples[offset]);
+			for(size_t c = 0; c < length; c++) {
+				stepped.get_samples(1, &stepped_samples[offset + c]);
+			}
+		});
+		queue.perform();
+	}
+	queue.stop();
+
+	XCTAssertEqual(bulk_samples.size(), stepped_samples.size());
+	XCTAssert(bulk_samples == stepped_samples);
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  MFMDiskControllerTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/Controller/MFMDiskController.hpp"
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Constants.hpp"
+#include "../../../Storage/Disk/Encodings/MFM/Encoder.hpp"
+#include "../../../Storage/Disk/Track/TrackSerialiser.hpp"
+
+#include <map>
+#include <memory>
+
+namespace {
+
+/// A single-sided disk that holds whatever tracks are set upon it.
+class TestDisk: public Storage::Disk::Disk {
+	public:
+		Storage::Disk::HeadPosition get_maximum_head_position() final	{	return Storage::Disk::HeadPosition(1);	}
+		int get_head_count() final										{	return 1;		}
+		bool get_is_read_only() final									{	return false;	}
+		void flush_tracks() final										{}
+		bool tracks_differ(Storage::Disk::Track::Address, Storage::Disk::Track::Address) final	{	return true;	}
+
+		std::shared_ptr<Storage::Disk::Track> get_track_at_position(Storage::Disk::Track::Address address) final {
+			return tracks_[address];
+		}
+		void set_track_at_position(Storage::Disk::Track::Address address, const std::shared_ptr<Storage::Disk::Track> &track) final {
+			tracks_[address] = track;
+		}
+
+	private:
+		std::map<Storage::Disk::Track::Address, std::shared_ptr<Storage::Disk::Track>> tracks_;
+};
+
+/// Exposes the MFMController's decoded-sector cache.
+class TestController: public Storage::Disk::MFMController {
+	public:
+		TestController() : MFMController(Cycles(8000000)) {
+			emplace_drive(8000000, 300, 1);
+			set_drive(1);
+			set_is_double_density(true);
+			set_is_fast_sector_access_enabled(true);
+		}
+
+		using MFMController::get_drive;
+		using MFMController::get_track_sectors;
+
+	private:
+		void posit_event(int) final {}
+};
+
+/// @returns A track with a single 512-byte sector, filled with @c value.
+std::shared_ptr<Storage::Disk::Track> track_filled_with(uint8_t value) {
+	Storage::Encodings::MFM::Sector sector;
+	sector.address.sector = 1;
+	sector.size = 2;
+	sector.samples.emplace_back(512, value);
+	return Storage::Encodings::MFM::GetMFMTrackWithSectors(std::vector<const Storage::Encodings::MFM::Sector *>{&sector});
+}
+
+}
+
+@interface MFMDiskControllerTests : XCTestCase
+@end
+
+@implementation MFMDiskControllerTests
+
+- (void)testFastSectorsFollowWrites {
+	auto disk = std::make_shared<TestDisk>();
+	disk->set_track_at_position(Storage::Disk::Track::Address(0, Storage::Disk::HeadPosition(0)), track_filled_with(0x00));
+
+	TestController controller;
+	auto &drive = controller.get_drive();
+	drive.set_disk(disk);
+
+	// Check the original contents, then overwrite the whole sector twice. The first write replaces the
+	// original track with a higher-resolution copy; the second modifies that copy in place.
+	for(const uint8_t value: {0x00, 0x5a, 0xa5}) {
+		if(value) {
+			const auto segment = Storage::Disk::track_serialisation(*track_filled_with(value), Storage::Encodings::MFM::MFMBitLength);
+			drive.begin_writing(Storage::Time(1, 500000), false);
+			for(const bool bit: segment.data) {
+				drive.write_bit(bit);
+			}
+			drive.end_writing();
+		}
+
+		const auto &sectors = controller.get_track_sectors();
+		XCTAssertEqual(sectors.size(), 1);
+		if(sectors.size() != 1) return;
+
+		const auto &sector = sectors.begin()->second;
+		XCTAssertEqual(sector.samples.size(), 1);
+		XCTAssertEqual(sector.samples[0].size(), 512);
+		XCTAssertEqual(sector.samples[0][0], value, "Sector contents should be %02x after writing", value);
+		XCTAssertEqual(sector.samples[0][511], value, "Sector contents should be %02x after writing", value);
+	}
+}
+
+@end
@@ -0,0 +1,120 @@
+//
+//  MFP68901Tests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/68901/MFP68901.hpp"
+
+namespace {
+
+// Register addresses and bits used below; timer A is in the upper byte of the interrupt registers.
+constexpr int InterruptEnableA = 0x03;
+constexpr int InterruptPendingA = 0x05;
+constexpr int InterruptMaskA = 0x09;
+constexpr int TimerAControl = 0x0c;
+constexpr int TimerAData = 0x0f;
+constexpr uint8_t TimerAInterrupt = 0x20;
+
+constexpr uint8_t DelayPrescale4 = 0x01;
+constexpr uint8_t Reset = 0x10;
+
+}
+
+@interface MFP68901Tests : XCTestCase
+@end
+
+@implementation MFP68901Tests
+
+/// Tests that a timer that cannot currently produce an interrupt, being either not enabled or not
+/// unmasked, provides no sequence point but continues to count and, if enabled, to become pending.
+- (void)testMaskedTimerHasNoSequencePoint {
+	for(const bool enabled: {false, true}) {
+		Motorola::MFP68901::MFP68901 mfp;
+		mfp.write(TimerAData, 100);
+		mfp.write(TimerAControl, DelayPrescale4);
+		mfp.write(InterruptEnableA, enabled ? TimerAInterrupt : 0x00);
+		mfp.write(InterruptMaskA, enabled ? 0x00 : TimerAInterrupt);
+		XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles::max());
+
+		// 50,000 cycles is 12,501 decrements given that the first occurs after a single cycle;
+		// the timer expires repeatedly, ending one decrement into a period.
+		mfp.run_for(HalfCycles(100000));
+		XCTAssertEqual(mfp.read(TimerAData), 99);
+		XCTAssertEqual(mfp.read(InterruptPendingA), (enabled ? TimerAInterrupt : 0x00));
+		XCTAssertFalse(mfp.get_interrupt_line());
+		XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles::max());
+	}
+}
+
+/// Tests that unmasking a timer part way through its period provides a sequence point exactly
+/// at that timer's next expiry, at which the interrupt line becomes active.
+- (void)testUnmaskedMidPeriod {
+	Motorola::MFP68901::MFP68901 mfp;
+	mfp.write(TimerAData, 100);
+	mfp.write(TimerAControl, DelayPrescale4 | Reset);
+	mfp.write(InterruptEnableA, TimerAInterrupt);
+
+	// After 120 cycles the timer has been decremented 30 times, and is exactly between decrements.
+	mfp.run_for(HalfCycles(240));
+	XCTAssertEqual(mfp.read(TimerAData), 70);
+	XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles::max());
+
+	// Unmask, leaving a half-cycle banked; 70 decrements remain.
+	mfp.run_for(HalfCycles(1));
+	mfp.write(InterruptMaskA, TimerAInterrupt);
+	XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles(70 * 4 * 2 - 1));
+
+	mfp.run_for(HalfCycles(70 * 4 * 2 - 2));
+	XCTAssertFalse(mfp.get_interrupt_line());
+	XCTAssertEqual(mfp.read(TimerAData), 1);
+	XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles(1));
+
+	mfp.run_for(HalfCycles(1));
+	XCTAssert(mfp.get_interrupt_line());
+	XCTAssertEqual(mfp.read(TimerAData), 100);
+}
+
+/// Tests that a timer in delay mode with a data value of 0 counts through 256 decrements, expiring upon
+/// the one that returns it exactly to 0, whether started with or without a prescaler reset.
+- (void)testDelayModeReloadAtZero {
+	for(const bool reset: {false, true}) {
+		Motorola::MFP68901::MFP68901 mfp;
+		mfp.write(InterruptEnableA, TimerAInterrupt);
+		mfp.write(InterruptMaskA, TimerAInterrupt);
+		mfp.write(TimerAData, 0);
+		mfp.write(TimerAControl, DelayPrescale4 | (reset ? Reset : 0x00));
+
+		// Without a reset the prescaler is already due, so the first decrement occurs after one
+		// cycle and the final one after 1020; with a reset, every decrement takes four cycles.
+		const int cycles = reset ? 1024 : 1020;
+		XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles(cycles * 2));
+
+		mfp.run_for(HalfCycles((cycles - 1) * 2));
+		XCTAssertFalse(mfp.get_interrupt_line());
+		XCTAssertEqual(mfp.read(TimerAData), 1);
+
+		mfp.run_for(HalfCycles(2));
+		XCTAssert(mfp.get_interrupt_line());
+		XCTAssertEqual(mfp.read(TimerAData), 0);
+
+		// The next expiry is a full 256 decrements away.
+		mfp.acknowledge_interrupt();
+		XCTAssertFalse(mfp.get_interrupt_line());
+		XCTAssertEqual(mfp.get_next_sequence_point(), HalfCycles(256 * 4 * 2));
+		mfp.run_for(HalfCycles(255 * 4 * 2));
+		XCTAssertEqual(mfp.read(TimerAData), 1);
+		XCTAssertFalse(mfp.get_interrupt_line());
+
+		// Run through ten further whole periods in one go, ending five decrements into the next.
+		mfp.run_for(HalfCycles((1 + 10 * 256 + 5) * 4 * 2));
+		XCTAssertEqual(mfp.read(TimerAData), 251);
+		XCTAssert(mfp.get_interrupt_line());
+	}
+}
+
+@end
@@ -0,0 +1,186 @@
+//
+//  MOS6560Tests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/6560/6560.hpp"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Records the cycle span and samples of every scan, and the sequence of sync events.
+struct CapturingScanTarget: public Outputs::Display::ScanTarget {
+	struct Scan {
+		int start, end;
+		std::vector<uint8_t> samples;
+		bool operator ==(const Scan &rhs) const {
+			return start == rhs.start && end == rhs.end && samples == rhs.samples;
+		}
+	};
+	std::vector<Scan> scans;
+	std::vector<std::pair<Event, bool>> events;
+
+	void set_modals(Modals) final {}
+
+	uint8_t *begin_data(size_t required_length, size_t) final {
+		area_.resize(required_length * 2);
+		return area_.data();
+	}
+
+	ScanTarget::Scan *begin_scan() final {
+		return &scan_;
+	}
+
+	void end_scan() final {
+		scans.push_back(Scan{
+			scan_.end_points[0].cycles_since_end_of_horizontal_retrace,
+			scan_.end_points[1].cycles_since_end_of_horizontal_retrace,
+			std::vector<uint8_t>(
+				area_.begin() + scan_.end_points[0].data_offset * 2,
+				area_.begin() + scan_.end_points[1].data_offset * 2)
+		});
+	}
+
+	void announce(Event event, bool is_visible, const ScanTarget::Scan::EndPoint &, uint8_t) final {
+		events.emplace_back(event, is_visible);
+	}
+
+	private:
+		ScanTarget::Scan scan_;
+		std::vector<uint8_t> area_;
+};
+
+/// Supplies pseudo-random video and colour memory, recording every address fetched.
+struct RecordingBusHandler {
+	std::vector<uint16_t> addresses;
+
+	void perform_read(uint16_t address, uint8_t *pixel_data, uint8_t *colour_data) {
+		addresses.push_back(address);
+		*pixel_data = uint8_t((address * 0x9e37) >> 5);
+		*colour_data = uint8_t((address * 0x7f4b) >> 7);
+	}
+};
+
+}
+
+@interface MOS6560Tests : XCTestCase
+@end
+
+@implementation MOS6560Tests
+
+/// Tests that video output, memory fetches and the raster position are the same whether the 6560 is run
+/// for long periods, across which quiet stretches are skipped, or a cycle at a time.
+- (void)testVideoBlockSizeInvariance {
+	for(const auto mode: {MOS::MOS6560::OutputMode::PAL, MOS::MOS6560::OutputMode::NTSC}) {
+		RecordingBusHandler bulk_bus, stepped_bus;
+		CapturingScanTarget bulk_target, stepped_target;
+		MOS::MOS6560::MOS6560<RecordingBusHandler> bulk(bulk_bus), stepped(stepped_bus);
+		bulk.set_output_mode(mode);
+		stepped.set_output_mode(mode);
+		bulk.set_scan_target(&bulk_target);
+		stepped.set_scan_target(&stepped_target);
+
+		// Start from the Vic-20's usual display geometry.
+		constexpr uint8_t initial_registers[] = {0x0c, 0x26, 0x96, 0x2e, 0x00, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1b};
+		for(int c = 0; c < 16; c++) {
+			bulk.write(c, initial_registers[c]);
+			stepped.write(c, initial_registers[c]);
+		}
+
+		std::mt19937 random(0x6560);
+		for(int round = 0; round < 2000; round++) {
+			// Occasionally change the display geometry or colours.
+			if(!(random() % 8)) {
+				constexpr int video_registers[] = {0x0, 0x1, 0x2, 0x3, 0x5, 0xf};
+				const int address = video_registers[random() % 6];
+				const uint8_t value = uint8_t(random());
+				bulk.write(address, value);
+				stepped.write(address, value);
+			}
+
+			const int length = 1 + int(random() % 1000);
+			bulk.run_for(Cycles(length));
+			for(int c = 0; c < length; c++) {
+				stepped.run_for(Cycles(1));
+			}
+
+			XCTAssertEqual(bulk.read(3), stepped.read(3));
+			XCTAssertEqual(bulk.read(4), stepped.read(4));
+		}
+
+		XCTAssertGreaterThan(bulk_bus.addresses.size(), 10000);
+		XCTAssert(bulk_bus.addresses == stepped_bus.addresses);
+		XCTAssert(bulk_target.events == stepped_target.events);
+		XCTAssertGreaterThan(bulk_target.scans.size(), 1000);
+		XCTAssertEqual(bulk_target.scans.size(), stepped_target.scans.size());
+		XCTAssert(bulk_target.scans == stepped_target.scans);
+	}
+}
+
+/// Tests that audio is the same whether it is requested in large blocks, which are filled in runs between
+/// channel updates, or a sample at a time.
+- (void)testAudioBlockSizeInvariance {
+	Concurrency::AsyncTaskQueue<false> queue;
+	MOS::MOS6560::AudioGenerator bulk(queue), stepped(queue);
+	bulk.set_sample_volume_range(32767);
+	stepped.set_sample_volume_range(32767);
+
+	std::mt19937 random(0x6560);
+	std::vector<int16_t> bulk_samples, stepped_samples;
+	for(int round = 0; round < 500; round++) {
+		// Randomise a channel, or the volume.
+		const int target = int(random() % 5);
+		const uint8_t value = uint8_t(random());
+		if(target < 4) {
+			bulk.set_control(target, value);
+			stepped.set_control(target, value);
+		} else {
+			bulk.set_volume(value & 0xf);
+			stepped.set_volume(value & 0xf);
+		}
+
+		// Either capture or skip some samples.
+		const size_t length = 1 + random() % 4096;
+		const bool skip = !(random() % 4);
+		queue.enqueue([&, length, skip] {
+			if(skip) {
+				bulk.skip_samples(length);
+				for(size_t c = 0; c < length; c++) {
+					stepped.skip_samples(1);
+				}
+				return;
+			}
+
+			const size_t offset = bulk_samples.size();
+			bulk_samples.resize(offset + length);
+			stepped_samples.resize(offset + length);
+
+			bulk.get_samples(length, &bulk_samples[offset]);
+			for(size_t c = 0; c < length; c++) {
+				stepped.get_samples(1, &stepped_samples[offset + c]);
+			}
+		});
+		queue.perform();
+	}
+	queue.stop();
+
+	XCTAssertEqual(bulk_samples.size(), stepped_samples.size());
+	XCTAssert(bulk_samples == stepped_samples);
+
+	// Sanity check: the channels should actually have been toggling.
+	size_t changes = 0;
+	for(size_t c = 1; c < bulk_samples.size(); c++) {
+		changes += bulk_samples[c] != bulk_samples[c - 1];
+	}
+	XCTAssertGreaterThan(changes, 1000);
+}
+
+@end
@@ -8,9 +8,59 @@
 
 #import <XCTest/XCTest.h>
 
+#include <algorithm>
 #include <memory>
+#include <random>
+#include <utility>
+#include <vector>
 #include "../../../Machines/Apple/Macintosh/Video.hpp"
 
+namespace {
+
+/// Records the cycle span and samples of every scan, and the sequence of sync events.
+struct CapturingScanTarget: public Outputs::Display::ScanTarget {
+	struct Scan {
+		int start, end;
+		std::vector<uint8_t> samples;
+		bool operator ==(const Scan &rhs) const {
+			return start == rhs.start && end == rhs.end && samples == rhs.samples;
+		}
+	};
+	std::vector<Scan> scans;
+	std::vector<std::pair<Event, bool>> events;
+
+	void set_modals(Modals) final {}
+
+	uint8_t *begin_data(size_t required_length, size_t) final {
+		area_.resize(required_length);
+		return area_.data();
+	}
+
+	ScanTarget::Scan *begin_scan() final {
+		return &scan_;
+	}
+
+	void end_scan() final {
+		scans.push_back(Scan{
+			scan_.end_points[0].cycles_since_end_of_horizontal_retrace,
+			scan_.end_points[1].cycles_since_end_of_horizontal_retrace,
+			std::vector<uint8_t>(
+				area_.begin() + scan_.end_points[0].data_offset,
+				area_.begin() + scan_.end_points[1].data_offset)
+		});
+	}
+
+	void announce(Event event, bool is_visible, const ScanTarget::Scan::EndPoint &, uint8_t) final {
+		events.emplace_back(event, is_visible);
+	}
+
+	private:
+		ScanTarget::Scan scan_;
+		std::vector<uint8_t> area_;
+};
+
+}
+
 @interface MacintoshVideoTests : XCTestCase
 @end
 
@@ -44,4 +94,39 @@
 	}
 }
 
+/// Tests that output is the same whether video is run a whole line at a time, in which case each line is posted
+/// to the CRT as a single batch, or in arbitrary smaller pieces, in which case lines are posted piecewise.
+- (void)testBatchedLinesMatchPiecewiseOutput {
+	std::mt19937 random(0x3ac);
+	std::vector<uint16_t> ram(64*1024);
+	for(auto &word: ram) {
+		word = uint16_t(random());
+	}
+
+	CapturingScanTarget batched_target, piecewise_target;
+	auto batched = std::make_unique<Apple::Macintosh::Video>(_dummy_audio, _dummy_drive_speed_accumulator);
+	auto piecewise = std::make_unique<Apple::Macintosh::Video>(_dummy_audio, _dummy_drive_speed_accumulator);
+	batched->set_ram(ram.data(), ram.size() - 1);
+	piecewise->set_ram(ram.data(), ram.size() - 1);
+	batched->set_scan_target(&batched_target);
+	piecewise->set_scan_target(&piecewise_target);
+
+	// Run for three frames: 370 lines of 704 pixel clocks each.
+	constexpr int line_length = 704;
+	constexpr int frames = 3;
+	for(int line = 0; line < 370 * frames; line++) {
+		batched->run_for(HalfCycles(line_length));
+	}
+	int remaining = line_length * 370 * frames;
+	while(remaining) {
+		const int step = std::min(remaining, 1 + int(random() % 300));
+		piecewise->run_for(HalfCycles(step));
+		remaining -= step;
+	}
+
+	XCTAssertGreaterThan(batched_target.scans.size(), 342 * (frames - 1));
+	XCTAssert(batched_target.scans == piecewise_target.scans);
+	XCTAssert(batched_target.events == piecewise_target.events);
+}
+
 @end
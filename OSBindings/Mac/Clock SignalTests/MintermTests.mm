@@ -51,6 +51,9 @@ template <typename IntT> IntT slow_minterm(IntT a, IntT b, IntT c, uint8_t minte
 		const uint8_t fast = Amiga::apply_minterm(a, b, c, minterm);
 
 		XCTAssertEqual(slow, fast, "Mismatch found between naive and fast implementations for %02x", minterm);
+
+		const uint8_t specialised = Amiga::minterm_function<uint8_t>(minterm)(a, b, c);
+		XCTAssertEqual(slow, specialised, "Mismatch found between naive and specialised implementations for %02x", minterm);
 	}
 }
 
@@ -0,0 +1,197 @@
+//
+//  NCR5380PseudoDMATests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/5380/ncr5380.hpp"
+#include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr size_t BlockSize = 512;
+constexpr size_t BlockCount = 64;
+
+/// A RAM disk with distinct initial contents in every byte position.
+struct MemoryDevice: public Storage::MassStorage::MassStorageDevice {
+	std::vector<uint8_t> contents = std::vector<uint8_t>(BlockSize * BlockCount);
+
+	MemoryDevice() {
+		for(size_t c = 0; c < contents.size(); c++) contents[c] = uint8_t(c*7 + (c >> 9));
+	}
+
+	size_t get_block_size() final			{	return BlockSize;	}
+	size_t get_number_of_blocks() final		{	return BlockCount;	}
+	std::vector<uint8_t> get_block(size_t address) final {
+		return std::vector<uint8_t>(contents.begin() + ptrdiff_t(address * BlockSize), contents.begin() + ptrdiff_t((address + 1) * BlockSize));
+	}
+	void set_block(size_t address, const std::vector<uint8_t> &data) final {
+		std::copy(data.begin(), data.end(), contents.begin() + ptrdiff_t(address * BlockSize));
+	}
+};
+
+/// A 5380 and a hard disk on a shared bus, with a host that issues commands via PIO and then
+/// moves data via pseudo-DMA, either through the data registers as per the Macintosh or through
+/// DMA acknowledge accesses as per the Apple II SCSI card.
+struct Host {
+	const bool via_registers;
+	SCSI::Bus bus{HalfCycles(16000000)};
+	NCR::NCR5380::NCR5380 ncr{bus, 16000000};
+	SCSI::Target::Target<SCSI::DirectAccessDevice> disk{bus, 6};
+	std::shared_ptr<MemoryDevice> storage = std::make_shared<MemoryDevice>();
+
+	/// The number of DMA bytes for which a request was already present when the host came to look for it.
+	size_t immediate_requests = 0;
+
+	Host(bool via_registers) : via_registers(via_registers) {
+		disk->set_storage(storage);
+		ncr.write(2, 0x00);
+		ncr.write(3, 0x00);
+		ncr.write(1, 0x00);
+		step(10);
+	}
+
+	void step(int count = 1) {
+		while(count--) bus.run_for(HalfCycles(8));
+	}
+
+	bool wait_for_request(bool level) {
+		for(int c = 0; c < 100000; c++) {
+			if(bool(ncr.read(4) & 0x20) == level) return true;
+			step();
+		}
+		return false;
+	}
+
+	bool pio_out(uint8_t value) {
+		if(!wait_for_request(true)) return false;
+		ncr.write(0, value);
+		ncr.write(1, 0x11);
+		step();
+		if(!wait_for_request(false)) return false;
+		ncr.write(1, 0x01);
+		step();
+		return true;
+	}
+
+	bool pio_in(uint8_t &value) {
+		if(!wait_for_request(true)) return false;
+		value = ncr.read(0);
+		ncr.write(1, 0x10);
+		step();
+		if(!wait_for_request(false)) return false;
+		ncr.write(1, 0x00);
+		step();
+		return true;
+	}
+
+	/// Performs a complete six-byte command with a data phase of @c data.size() bytes, either
+	/// filling @c data if @c is_read or sending it otherwise.
+	///
+	/// @returns @c true if all phases completed with a GOOD status and COMMAND COMPLETE message.
+	bool command(const std::vector<uint8_t> &command, bool is_read, std::vector<uint8_t> &data) {
+		// Select the target.
+		ncr.write(0, 0x40);
+		ncr.write(1, 0x05);
+		step(10);
+		ncr.write(1, 0x01);
+		step(10);
+
+		// Command phase.
+		for(const auto byte: command) {
+			if(!pio_out(byte)) return false;
+		}
+
+		// Data phase, via DMA.
+		ncr.write(3, is_read ? 0x01 : 0x00);
+		ncr.write(2, 0x02);
+		ncr.write(is_read ? 7 : 5, 0x00);
+		if(!is_read) ncr.write(1, 0x01);
+		for(auto &byte: data) {
+			if(ncr.dma_request()) {
+				++immediate_requests;
+			} else {
+				int c = 0;
+				while(!ncr.dma_request()) {
+					step();
+					if(++c == 100000) return false;
+				}
+			}
+
+			if(via_registers) {
+				if(is_read) {
+					byte = ncr.read(0);
+				} else {
+					ncr.write(0, byte);
+				}
+			} else {
+				if(is_read) {
+					byte = ncr.dma_acknowledge();
+				} else {
+					ncr.dma_acknowledge(byte);
+				}
+			}
+			step();
+		}
+		step(10);
+		ncr.write(2, 0x00);
+		ncr.write(1, 0x00);
+
+		// Status and message phases.
+		uint8_t status, message;
+		ncr.write(3, 0x03);
+		step(10);
+		if(!pio_in(status)) return false;
+		ncr.write(3, 0x07);
+		if(!pio_in(message)) return false;
+		step(10);
+
+		return !status && !message;
+	}
+};
+
+}
+
+@interface NCR5380PseudoDMATests : XCTestCase
+@end
+
+@implementation NCR5380PseudoDMATests
+
+- (void)testTransfers {
+	for(const bool via_registers: {true, false}) {
+		Host host(via_registers);
+		auto expected = host.storage->contents;
+
+		for(uint8_t pass = 0; pass < 8; pass++) {
+			// Read eight blocks, which should match the disk exactly.
+			const uint8_t read_block = uint8_t(pass * 3);
+			std::vector<uint8_t> read(8 * BlockSize);
+			host.immediate_requests = 0;
+			XCTAssert(host.command({0x08, 0x00, 0x00, read_block, 8, 0x00}, true, read), @"Read %d should complete", pass);
+			XCTAssert(std::equal(read.begin(), read.end(), expected.begin() + ptrdiff_t(read_block * BlockSize)), @"Read %d should match disk contents", pass);
+
+			// Every byte beyond the first should have been requested as soon as its predecessor was acknowledged.
+			XCTAssertEqual(host.immediate_requests, read.size() - 1);
+
+			// Write four blocks, which should land on the disk without disturbing anything else.
+			const uint8_t write_block = uint8_t(40 + pass);
+			std::vector<uint8_t> write(4 * BlockSize);
+			for(size_t c = 0; c < write.size(); c++) write[c] = uint8_t(c ^ (pass * 0x35));
+			std::copy(write.begin(), write.end(), expected.begin() + ptrdiff_t(write_block * BlockSize));
+
+			host.immediate_requests = 0;
+			XCTAssert(host.command({0x0a, 0x00, 0x00, write_block, 4, 0x00}, false, write), @"Write %d should complete", pass);
+			XCTAssert(host.storage->contents == expected, @"Write %d should update disk contents", pass);
+			XCTAssertEqual(host.immediate_requests, write.size() - 1);
+		}
+	}
+}
+
+@end
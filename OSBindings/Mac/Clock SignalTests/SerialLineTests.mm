@@ -0,0 +1,97 @@
+//
+//  SerialLineTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Components/Serial/Line.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Receives 8N1 frames, recording each byte and whether its stop bit was correct.
+struct Receiver: public Serial::Line<false>::ReadDelegate {
+	std::vector<uint8_t> bytes;
+	bool stop_bits_valid = true;
+
+	bool serial_line_did_produce_bit(Serial::Line<false> *, int bit) final {
+		shift_ |= bit << bits_;
+		++bits_;
+		if(bits_ < 10) return true;
+
+		bytes.push_back(uint8_t(shift_ >> 1));
+		stop_bits_valid &= bool(shift_ & 0x200);
+		shift_ = bits_ = 0;
+		return false;
+	}
+
+	private:
+		int shift_ = 0, bits_ = 0;
+};
+
+}
+
+@interface SerialLineTests : XCTestCase
+@end
+
+@implementation SerialLineTests
+
+/// Sends random bytes at 9600 baud from a writer clocked at @c clock_rate, with @c cycles_per_bit
+/// writer cycles per bit, advancing the line by random amounts of up to @c max_step cycles. If
+/// @c change_rate is set then the writer clock rate is doubled and halved between bytes,
+/// while the reader is still sampling the final stop bit.
+- (void)sendWithClockRate:(int)clock_rate cyclesPerBit:(int)cycles_per_bit maxStep:(int)max_step changeRate:(bool)change_rate {
+	Serial::Line<false> line;
+	Receiver receiver;
+	line.set_writer_clock_rate(HalfCycles(clock_rate));
+	line.set_read_delegate(&receiver, Storage::Time(1, 9600));
+
+	std::mt19937 random(uint32_t(clock_rate + max_step));
+	std::vector<uint8_t> sent;
+	int rate_multiplier = 1;
+	for(int c = 0; c < 500; c++) {
+		const auto value = uint8_t(random());
+		sent.push_back(value);
+		line.write(HalfCycles(cycles_per_bit * rate_multiplier), 10, (value << 1) | 0x200);
+
+		while(line.write_data_time_remaining() > HalfCycles(0)) {
+			line.advance_writer(HalfCycles(1 + int(random() % unsigned(max_step))));
+		}
+
+		if(change_rate) {
+			rate_multiplier ^= 3;
+			line.set_writer_clock_rate(HalfCycles(clock_rate * rate_multiplier));
+		}
+
+		while(line.transmission_data_time_remaining() > HalfCycles(0)) {
+			line.advance_writer(HalfCycles(1 + int(random() % unsigned(max_step))));
+		}
+	}
+
+	XCTAssert(receiver.bytes == sent);
+	XCTAssert(receiver.stop_bits_valid);
+}
+
+- (void)testIntegralBitLengthSingleSteps {
+	[self sendWithClockRate:153600 cyclesPerBit:16 maxStep:1 changeRate:false];
+}
+
+- (void)testIntegralBitLength {
+	[self sendWithClockRate:153600 cyclesPerBit:16 maxStep:40 changeRate:false];
+}
+
+- (void)testFractionalBitLength {
+	[self sendWithClockRate:96100 cyclesPerBit:10 maxStep:25 changeRate:false];
+}
+
+- (void)testRateChanges {
+	[self sendWithClockRate:153600 cyclesPerBit:16 maxStep:5 changeRate:true];
+}
+
+@end
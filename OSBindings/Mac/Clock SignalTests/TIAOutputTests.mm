@@ -0,0 +1,157 @@
+//
+//  TIAOutputTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Atari/2600/TIA.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// Captures the TIA's output, reconstructing each line as a full 160 pixels regardless of
+/// whether it was supplied as data or as a level.
+class CapturingScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		struct Line {
+			std::vector<uint16_t> pixels;
+			int samples = 0;
+		};
+		std::vector<Line> lines;
+
+		void set_modals(Modals) final {}
+
+		uint8_t *begin_data(size_t required_length, size_t) final {
+			area_.resize(required_length);
+			return reinterpret_cast<uint8_t *>(area_.data());
+		}
+
+		Scan *begin_scan() final {
+			return &scan_;
+		}
+
+		void end_scan() final {
+			// Each pixel lasts two cycles; spread the scan's samples evenly over its pixels.
+			const int start = scan_.end_points[0].data_offset;
+			const int samples = scan_.end_points[1].data_offset - start;
+			const int pixels = (scan_.end_points[1].cycles_since_end_of_horizontal_retrace - scan_.end_points[0].cycles_since_end_of_horizontal_retrace) / 2;
+			for(int c = 0; c < pixels; c++) {
+				line_.pixels.push_back(area_[size_t(start + (c * samples) / pixels)]);
+			}
+			line_.samples += samples;
+		}
+
+		void announce(Event event, bool, const Scan::EndPoint &, uint8_t) final {
+			if(event == Event::BeginHorizontalRetrace) {
+				if(!line_.pixels.empty()) lines.push_back(std::move(line_));
+				line_ = Line();
+			}
+		}
+
+	private:
+		Scan scan_;
+		std::vector<uint16_t> area_;
+		Line line_;
+};
+
+/// Classifies a Luminance8Phase8 pixel by its luminance, per the colours set by @c TestTIA.
+int classify(uint16_t pixel) {
+	switch(pixel & 0xff) {
+		case 0:		return 0;	// Background.
+		case 255:	return 1;	// Playfield.
+		default:	return -1;
+	}
+}
+
+/// A TIA with the background and playfield set to distinguishable luminances, which captures its output.
+struct TestTIA {
+	Atari2600::TIA tia;
+	CapturingScanTarget target;
+
+	TestTIA() {
+		tia.set_scan_target(&target);
+		tia.set_background_colour(0x00);
+		tia.set_playfield_ball_colour(0x0e);
+
+		// Run for a few lines, to let the CRT settle.
+		tia.run_for(Cycles(228 * 8));
+	}
+
+	/// @returns The classified pixels of the next complete line.
+	std::vector<int> next_line() {
+		target.lines.clear();
+		tia.run_for(Cycles(228 * 2));
+
+		std::vector<int> result;
+		if(target.lines.empty()) return result;
+		for(const auto pixel: target.lines.back().pixels) {
+			result.push_back(classify(pixel));
+		}
+		return result;
+	}
+
+	/// @returns The number of samples supplied for the most recent complete line.
+	int samples() const {
+		return target.lines.empty() ? 0 : target.lines.back().samples;
+	}
+};
+
+}
+
+@interface TIAOutputTests : XCTestCase
+@end
+
+@implementation TIAOutputTests
+
+- (void)testBackgroundIsPostedAsLevel {
+	TestTIA test;
+
+	const auto line = test.next_line();
+	XCTAssertEqual(line.size(), 160);
+	XCTAssert(std::all_of(line.begin(), line.end(), [](int pixel) { return pixel == 0; }));
+	XCTAssertEqual(test.samples(), 1);
+}
+
+- (void)testUniformPlayfieldIsPostedAsLevel {
+	TestTIA test;
+	test.tia.set_playfield(0, 0xff);
+	test.tia.set_playfield(1, 0xff);
+	test.tia.set_playfield(2, 0xff);
+
+	const auto line = test.next_line();
+	XCTAssertEqual(line.size(), 160);
+	XCTAssert(std::all_of(line.begin(), line.end(), [](int pixel) { return pixel == 1; }));
+	XCTAssertEqual(test.samples(), 1);
+}
+
+- (void)testReflectedPlayfieldIsPostedAsData {
+	TestTIA test;
+	test.tia.set_playfield_control_and_ball_size(1);
+	test.tia.set_playfield(0, 0x10);
+	test.tia.set_playfield(1, 0xf0);
+	test.tia.set_playfield(2, 0x0e);
+
+	// Build the expected line: PF0 bits 4–7, PF1 bits 7–0 then PF2 bits 0–7, each bit
+	// covering four pixels, followed by the mirror image of the same.
+	std::vector<int> expected;
+	const auto add_bit = [&](uint8_t value, int bit) {
+		expected.insert(expected.end(), 4, (value >> bit) & 1);
+	};
+	for(int bit = 4; bit < 8; bit++) add_bit(0x10, bit);
+	for(int bit = 7; bit >= 0; bit--) add_bit(0xf0, bit);
+	for(int bit = 0; bit < 8; bit++) add_bit(0x0e, bit);
+	const std::vector<int> left = expected;
+	expected.insert(expected.end(), left.rbegin(), left.rend());
+
+	XCTAssert(test.next_line() == expected);
+	XCTAssertEqual(test.samples(), 160);
+}
+
+@end
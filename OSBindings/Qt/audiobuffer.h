@@ -1,12 +1,15 @@
 #ifndef AUDIOSOURCE_H
 #define AUDIOSOURCE_H
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
-#include <mutex>
 #include <vector>
 
 #include <QIODevice>
 
+#include "../../Concurrency/SPSCRing.hpp"
+
 /*!
  * \brief An intermediate recepticle for audio data.
  *
@@ -26,38 +29,33 @@ struct AudioBuffer: public QIODevice {
 		open(QIODevice::ReadOnly | QIODevice::Unbuffered);
 	}
 
+	// Called by the audio thread, which is the only reader.
 	void setDepth(size_t depth) {
-		std::lock_guard lock(mutex);
-		buffer.resize(depth);
+		this->depth = std::min(depth, capacity / 2);
 	}
 
 	// AudioBuffer-specific behaviour: always provide the latest data,
 	// even if that means skipping some.
 	qint64 readData(char *data, const qint64 maxlen) override {
-		if(!maxlen) {
+		if(!maxlen || !depth) {
 			return 0;
 		}
 
-		std::lock_guard lock(mutex);
-		if(readPointer == writePointer || buffer.empty()) return 0;
-
-		const size_t dataAvailable = std::min(writePointer - readPointer, size_t(maxlen));
-		size_t bytesToCopy = dataAvailable;
-		while(bytesToCopy) {
-			const size_t nextLength = std::min(buffer.size() - (readPointer % buffer.size()), bytesToCopy);
-			memcpy(data, &buffer[readPointer % buffer.size()], nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			readPointer += nextLength;
-		}
+		buffer.discard_to(2 * depth);
+		return qint64(buffer.pop(reinterpret_cast<uint8_t *>(data), size_t(maxlen)));
+	}
 
-		return qint64(dataAvailable);
+	// Provides the amount of data currently buffered, and the amount that would ideally be,
+	// for output rate control.
+	size_t fill() const {
+		return buffer.size();
+	}
+	size_t targetFill() const {
+		return depth;
 	}
 
 	qint64 bytesAvailable() const override {
-		std::lock_guard lock(mutex);
-		return qint64(writePointer - readPointer);
+		return qint64(std::min(buffer.size(), 2 * depth));
 	}
 
 	// Required to make QIODevice concrete; not used.
@@ -65,33 +63,17 @@ struct AudioBuffer: public QIODevice {
 		return 0;
 	}
 
-	// Posts a new set of source data. This buffer permits only the amount of data
-	// specified by @c setDepth to be enqueued into the future. Additional writes
-	// after the buffer is full will overwrite the newest data.
+	// Posts a new set of source data. This buffer retains at most twice the amount of data
+	// specified by @c setDepth, discarding the oldest when read. The buffer is
+	// lock-free, so neither this nor a read will ever wait for the other.
 	void write(const std::vector<int16_t> &source) {
-		std::lock_guard lock(mutex);
-		if(buffer.empty()) return;
-		const size_t sourceSize = source.size() * sizeof(int16_t);
-
-		size_t bytesToCopy = sourceSize;
-		auto data = reinterpret_cast<const uint8_t *>(source.data());
-		while(bytesToCopy) {
-			size_t nextLength = std::min(buffer.size() - (writePointer % buffer.size()), bytesToCopy);
-			memcpy(&buffer[writePointer % buffer.size()], data, nextLength);
-
-			bytesToCopy -= nextLength;
-			data += nextLength;
-			writePointer += nextLength;
-		}
-
-		readPointer = std::max(readPointer, writePointer - buffer.size());
+		buffer.push(reinterpret_cast<const uint8_t *>(source.data()), source.size() * sizeof(int16_t));
 	}
 
 	private:
-		mutable std::mutex mutex;
-		std::vector<uint8_t> buffer;
-		mutable size_t readPointer = 0;
-		size_t writePointer = 0;
+		static constexpr size_t capacity = 262144;
+		Concurrency::SPSCRing<uint8_t, capacity> buffer;
+		std::atomic<size_t> depth = 0;
 };
 
 #endif // AUDIOSOURCE_H
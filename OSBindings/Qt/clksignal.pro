@@ -16,6 +16,7 @@ LIBS += -lz
 linux {
 	QT += x11extras
 	LIBS += -lX11
+	LIBS += -lrt
 }
 
 # Add flags (i) to identify that this is a Qt build; and
@@ -110,12 +111,13 @@ SOURCES += \
 	$$SRC/Outputs/ScanTargets/*.cpp \
 	$$SRC/Outputs/OpenGL/*.cpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.cpp \
+	$$SRC/Outputs/Software/*.cpp \
+	$$SRC/Outputs/Speaker/*.cpp \
 \
+	$$SRC/Processors/BusTrace.cpp \
 	$$SRC/Processors/6502/Implementation/*.cpp \
 	$$SRC/Processors/6502/State/*.cpp \
 	$$SRC/Processors/65816/Implementation/*.cpp \
-	$$SRC/Processors/68000/Implementation/*.cpp \
-	$$SRC/Processors/68000/State/*.cpp \
 	$$SRC/Processors/Z80/Implementation/*.cpp \
 	$$SRC/Processors/Z80/State/*.cpp \
 \
@@ -248,9 +250,11 @@ HEADERS += \
 	$$SRC/Outputs/ScanTargets/*.hpp \
 	$$SRC/Outputs/OpenGL/*.hpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.hpp \
+	$$SRC/Outputs/Software/*.hpp \
 	$$SRC/Outputs/Speaker/*.hpp \
 	$$SRC/Outputs/Speaker/Implementation/*.hpp \
 \
+	$$SRC/Processors/BusTrace.hpp \
 	$$SRC/Processors/6502/*.hpp \
 	$$SRC/Processors/6502/Implementation/*.hpp \
 	$$SRC/Processors/6502/State/*.hpp \
@@ -258,9 +262,6 @@ HEADERS += \
 	$$SRC/Processors/6502Esque/Implementation/*.hpp \
 	$$SRC/Processors/65816/*.hpp \
 	$$SRC/Processors/65816/Implementation/*.hpp \
-	$$SRC/Processors/68000/*.hpp \
-	$$SRC/Processors/68000/Implementation/*.hpp \
-	$$SRC/Processors/68000/State/*.hpp \
 	$$SRC/Processors/Z80/*.hpp \
 	$$SRC/Processors/Z80/Implementation/*.hpp \
 	$$SRC/Processors/Z80/State/*.hpp \
@@ -11,6 +11,7 @@
 #include <cstdio>
 
 #include "../../Numeric/CRC.hpp"
+#include "../../Storage/Disk/Track/FluxCache.hpp"
 
 namespace {
 
@@ -55,6 +56,7 @@ MainWindow::MainWindow(const QString &fileName) {
 void MainWindow::deleteMachine() {
 	// Stop the timer; stopping this first ensures the machine won't attempt
 	// to write to the audioOutput while it is being shut down.
+	ui->openGLWidget->setVSyncDelegate(nullptr);
 	timer.reset();
 
 	// Shut down the scan target while it still has a context for cleanup.
@@ -108,6 +110,12 @@ void MainWindow::init() {
 	++mainWindowCount;
 	qApp->installEventFilter(this);
 
+	// Permit slow-to-decode disk images to keep their decoded tracks between runs.
+	const QString cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	if(!cacheDirectory.isEmpty() && QDir().mkpath(cacheDirectory)) {
+		Storage::Disk::FluxCache::set_cache_directory(cacheDirectory.toStdString());
+	}
+
 	ui = std::make_unique<Ui::MainWindow>();
 	ui->setupUi(this);
 	romRequestBaseText = ui->missingROMsBox->toPlainText();
@@ -355,7 +363,8 @@ void MainWindow::launchMachine() {
 	const auto timedMachine = machine->timed_machine();
 	if(timedMachine) {
 		timer = std::make_unique<Timer>(this);
-		timer->startWithMachine(timedMachine, &machineMutex);
+		timer->startWithMachine(machine.get(), &machineMutex);
+		ui->openGLWidget->setVSyncDelegate(timer.get());
 	}
 
 	// If the machine can accept new media while running, enable
@@ -711,8 +720,9 @@ void MainWindow::setAppleIISquarePixels(bool squarePixels) {
 	configurable->set_options(options);
 }
 
-void MainWindow::speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) {
+void MainWindow::speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) {
 	audioBuffer.write(buffer);
+	speaker->set_output_buffer_fill(audioBuffer.fill(), audioBuffer.targetFill());
 }
 
 void MainWindow::dragEnterEvent(QDragEnterEvent* event) {
@@ -881,15 +891,19 @@ bool MainWindow::processEvent(QKeyEvent *event) {
 	if(!key) return true;
 
 	const bool isPressed = event->type() == QEvent::KeyPress;
-	std::unique_lock lock(machineMutex);
+
+	// Input is queued for the timer thread rather than applied here, to avoid waiting for the machine lock.
+	if(!timer) return true;
+	auto &inputQueue = timer->inputQueue();
 
 	switch(keyboardInputMode) {
 		case KeyboardInputMode::Keyboard: {
 			const auto keyboardMachine = machine->keyboard_machine();
 			if(!keyboardMachine) return true;
 
-			auto &keyboard = keyboardMachine->get_keyboard();
-			keyboard.set_key_pressed(*key, event->text().size() ? event->text()[0].toLatin1() : '\0', isPressed);
+			// A keyboard's exclusivity and set of observed keys are fixed, so can safely be inspected from this thread.
+			const auto &keyboard = keyboardMachine->get_keyboard();
+			inputQueue.set_key_pressed(*key, event->text().size() ? event->text()[0].toLatin1() : '\0', isPressed);
 			if(keyboard.is_exclusive() || keyboard.observed_keys().find(*key) != keyboard.observed_keys().end()) {
 				return false;
 			}
@@ -904,20 +918,20 @@ bool MainWindow::processEvent(QKeyEvent *event) {
 			if(!joysticks.empty()) {
 				using Key = Inputs::Keyboard::Key;
 				switch(*key) {
-					case Key::Left:		joysticks[0]->set_input(Inputs::Joystick::Input::Left, isPressed);		break;
-					case Key::Right:	joysticks[0]->set_input(Inputs::Joystick::Input::Right, isPressed);		break;
-					case Key::Up:		joysticks[0]->set_input(Inputs::Joystick::Input::Up, isPressed);		break;
-					case Key::Down:		joysticks[0]->set_input(Inputs::Joystick::Input::Down, isPressed);		break;
-					case Key::Space:	joysticks[0]->set_input(Inputs::Joystick::Input::Fire, isPressed);		break;
-					case Key::A:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0), isPressed);	break;
-					case Key::S:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1), isPressed);	break;
-					case Key::D:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2), isPressed);	break;
-					case Key::F:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3), isPressed);	break;
+					case Key::Left:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Left, isPressed);		break;
+					case Key::Right:	inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Right, isPressed);		break;
+					case Key::Up:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Up, isPressed);		break;
+					case Key::Down:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Down, isPressed);		break;
+					case Key::Space:	inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Fire, isPressed);		break;
+					case Key::A:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0), isPressed);	break;
+					case Key::S:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1), isPressed);	break;
+					case Key::D:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2), isPressed);	break;
+					case Key::F:		inputQueue.set_joystick_input(0, Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3), isPressed);	break;
 					default:
 						if(event->text().size()) {
-							joysticks[0]->set_input(Inputs::Joystick::Input(event->text()[0].toLatin1()), isPressed);
+							inputQueue.set_joystick_input(0, Inputs::Joystick::Input(event->text()[0].toLatin1()), isPressed);
 						} else {
-							joysticks[0]->set_input(Inputs::Joystick::Input::Fire, isPressed);
+							inputQueue.set_joystick_input(0, Inputs::Joystick::Input::Fire, isPressed);
 						}
 					break;
 				}
@@ -934,19 +948,13 @@ void MainWindow::setMouseIsCaptured(bool isCaptured) {
 }
 
 void MainWindow::moveMouse(QPoint vector) {
-	std::unique_lock lock(machineMutex);
-	auto mouseMachine = machine->mouse_machine();
-	if(!mouseMachine) return;
-
-	mouseMachine->get_mouse().move(vector.x(), vector.y());
+	if(!timer || !machine->mouse_machine()) return;
+	timer->inputQueue().move_mouse(vector.x(), vector.y());
 }
 
 void MainWindow::setButtonPressed(int index, bool isPressed) {
-	std::unique_lock lock(machineMutex);
-	auto mouseMachine = machine->mouse_machine();
-	if(!mouseMachine) return;
-
-	mouseMachine->get_mouse().set_button_pressed(index, isPressed);
+	if(!timer || !machine->mouse_machine()) return;
+	timer->inputQueue().set_mouse_button_pressed(index, isPressed);
 }
 
 // MARK: - New Machine Creation
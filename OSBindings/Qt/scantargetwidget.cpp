@@ -4,11 +4,13 @@
 #include <QCursor>
 #include <QDebug>
 #include <QDesktopWidget>
+#include <QDir>
 #include <QGuiApplication>
 #include <QKeyEvent>
 #include <QMouseEvent>
 #include <QOpenGLContext>
 #include <QScreen>
+#include <QStandardPaths>
 #include <QTimer>
 
 #include "../../ClockReceiver/TimeTypes.hpp"
@@ -57,6 +59,13 @@ void ScanTargetWidget::paintGL() {
 		if(producer) {
 			isConnected = true;
 			framebuffer = defaultFramebufferObject();
+
+			// Permit linked shaders to be cached between runs, if the driver allows.
+			const QString cacheDirectory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+			if(!cacheDirectory.isEmpty() && QDir().mkpath(cacheDirectory)) {
+				Outputs::Display::OpenGL::Shader::set_program_cache_directory(cacheDirectory.toStdString());
+			}
+
 			scanTarget = std::make_unique<Outputs::Display::OpenGL::ScanTarget>(framebuffer);
 			producer->set_scan_target(scanTarget.get());
 			producer = nullptr;
@@ -82,6 +91,7 @@ void ScanTargetWidget::vsync() {
 	if(!isConnected) return;
 
 	vsyncPredictor.announce_vsync();
+	if(vsyncDelegate) vsyncDelegate->scanTargetWidgetDidVSync(vsyncPredictor.frame_duration());
 
 	const auto time_now = Time::nanos_now();
 	requestedRedrawTime = vsyncPredictor.suggested_draw_time();
@@ -223,6 +233,10 @@ void ScanTargetWidget::mouseMoveEvent(QMouseEvent *event) {
 	}
 }
 
+void ScanTargetWidget::setVSyncDelegate(VSyncDelegate *delegate) {
+	vsyncDelegate = delegate;
+}
+
 bool ScanTargetWidget::isMouseCaptured() {
 	return mouseIsCaptured;
 }
@@ -33,6 +33,14 @@ class ScanTargetWidget : public QOpenGLWidget {
 		/// @returns @c true if the mouse is currently captured; @c false otherwise.
 		bool isMouseCaptured();
 
+		struct VSyncDelegate {
+			/// Announces that a frame has just been presented, and the host's current frame duration.
+			virtual void scanTargetWidgetDidVSync(Time::Nanos frameDuration) = 0;
+		};
+		/// If a delegate is assigned then it will be informed of every presented frame, e.g. to allow
+		/// the machine's output to be synchronised with the display's.
+		void setVSyncDelegate(VSyncDelegate *);
+
 	protected:
 		void initializeGL() override;
 		void resizeGL(int w, int h) override;
@@ -66,6 +74,7 @@ class ScanTargetWidget : public QOpenGLWidget {
 		void resize();
 
 		MouseDelegate *mouseDelegate = nullptr;
+		VSyncDelegate *vsyncDelegate = nullptr;
 		bool mouseIsCaptured = false;
 		bool f8State = false, f12State = false;	// To support F8+F12 as a mouse release combination.
 
@@ -1,44 +1,92 @@
 #include "timer.h"
 
-#include "../../ClockReceiver/TimeTypes.hpp"
-
 #include <algorithm>
-#include <QDebug>
+#include <chrono>
 
 Timer::Timer(QObject *parent) : QObject(parent) {}
 
-void Timer::startWithMachine(MachineTypes::TimedMachine *machine, std::mutex *machineMutex) {
+void Timer::startWithMachine(Machine::DynamicMachine *machine, std::mutex *machineMutex) {
 	this->machine = machine;
 	this->machineMutex = machineMutex;
 
-	thread.start();
-	thread.performAsync([this] {
-		// Set up the emulation timer. Bluffer's guide: the QTimer will post an
-		// event to an event loop. QThread is a thread with an event loop.
-		// My class, Timer, will be wired up to receive the QTimer's events.
-		timer = std::make_unique<QTimer>();
-		timer->setInterval(1);
+	{
+		std::lock_guard lock_guard(stateMutex);
+		isRunning = true;
+	}
+	thread.start(QThread::TimeCriticalPriority);
+}
 
-		connect(timer.get(), &QTimer::timeout, this, &Timer::tick, Qt::DirectConnection);
-		timer->start();
-	});
+Timer::~Timer() {
+	{
+		std::lock_guard lock_guard(stateMutex);
+		isRunning = false;
+	}
+	stateCondition.notify_all();
+	thread.wait();
+}
+
+void Timer::scanTargetWidgetDidVSync(Time::Nanos frameDuration) {
+	this->frameDuration = frameDuration;
+	vsyncNanos = Time::nanos_now();
+}
+
+void Timer::run() {
+	lastTickNanos = Time::nanos_now();
+
+	// Wake at a fixed period, skipping any ticks that have already been missed rather than
+	// attempting to catch up with them; each tick runs the machine up to the current time anyway.
+	auto nextTick = std::chrono::steady_clock::now();
+	std::unique_lock lock(stateMutex);
+	while(true) {
+		nextTick = std::max(nextTick + std::chrono::nanoseconds(tickPeriod), std::chrono::steady_clock::now());
+		if(stateCondition.wait_until(lock, nextTick, [this] { return !isRunning; })) {
+			break;
+		}
+
+		lock.unlock();
+		runToNow();
+		lock.lock();
+	}
 }
 
-void Timer::tick() {
+void Timer::runToNow() {
+	// If it's been more than half a second since the last tick then forego
+	// the excess, as there's obviously been some sort of substantial time glitch.
 	const auto now = Time::nanos_now();
-	const auto duration = std::min(now - lastTickNanos, int64_t(500'000'000));
-	lastTickNanos = now;
+	lastTickNanos = std::max(lastTickNanos, now - Time::Nanos(500'000'000));
 
 	std::lock_guard lock_guard(*machineMutex);
-	machine->run_for(double(duration) / 1e9);
-	machine->flush_output(MachineTypes::TimedMachine::Output::All);
-}
+	const auto timedMachine = machine->timed_machine();
 
-Timer::~Timer() {
-	thread.performAsync([this] {
-		if(timer) {
-			timer->stop();
+	// Upon each host vsync, adjust speed towards synchronisation if the machine's frame rate is
+	// close enough to the host's; otherwise run at the nominal speed.
+	const auto vsync = vsyncNanos.load();
+	if(lastTickNanos < vsync && now >= vsync) {
+		const auto scanProducer = machine->scan_producer();
+		const auto duration = frameDuration.load();
+		if(scanProducer && duration > 0 && scanSynchroniser.can_synchronise(scanProducer->get_scan_status(), double(duration) / 1e9)) {
+			timedMachine->set_speed_multiplier(scanSynchroniser.next_speed_multiplier(scanProducer->get_scan_status()));
+		} else {
+			timedMachine->set_speed_multiplier(scanSynchroniser.get_base_speed_multiplier());
+		}
+	}
+
+	// Run for no more than runBudget of host time, carrying forward any emulated time not completed.
+	const Time::Nanos deadline = now + runBudget;
+	const auto runFor = [&](Time::Seconds duration) {
+		const Time::Seconds total = duration + overdue;
+		overdue = std::min(total - timedMachine->run_until_deadline(total, deadline), maxOverdue);
+	};
+
+	// Apply any queued input at the point within this period that it was posted.
+	Time::Nanos position = lastTickNanos;
+	inputs.apply_until(now, *machine, nullptr, [&](Time::Nanos timestamp) {
+		if(timestamp > position) {
+			runFor(double(timestamp - position) / 1e9);
+			position = timestamp;
 		}
 	});
-	thread.stop();
+	runFor(double(now - position) / 1e9);
+	timedMachine->flush_output(MachineTypes::TimedMachine::Output::All);
+	lastTickNanos = now;
 }
@@ -2,15 +2,27 @@
 #define TIMER_H
 
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 #include <QObject>
 #include <QThread>
-#include <QTimer>
 
+#include "../../ClockReceiver/ScanSynchroniser.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Machines/Utility/InputQueue.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
-#include "functionthread.h"
+#include "scantargetwidget.h"
 
-class Timer : public QObject
+/*!
+ * \brief Runs a machine in real time on a dedicated, high-priority thread.
+ *
+ * The thread paces itself, rather than relying on Qt timer events, so that neither GUI
+ * activity nor the event loop's timer resolution can delay emulation. If informed of the
+ * host's vsyncs then, as per the SDL runner, it nudges the machine's speed to bring its
+ * frames into phase with the host's whenever the two are sufficiently close in rate.
+ */
+class Timer : public QObject, public ScanTargetWidget::VSyncDelegate
 {
 		Q_OBJECT
 
@@ -18,17 +30,47 @@ class Timer : public QObject
 		explicit Timer(QObject *parent = nullptr);
 		~Timer();
 
-		void startWithMachine(MachineTypes::TimedMachine *machine, std::mutex *machineMutex);
+		void startWithMachine(Machine::DynamicMachine *machine, std::mutex *machineMutex);
 
-	public slots:
-		void tick();
+		/// Input posted here from the UI thread is applied to the machine without waiting for the machine lock.
+		Machine::InputQueue &inputQueue() {
+			return inputs;
+		}
+
+		// ScanTargetWidget::VSyncDelegate; may be called from any thread.
+		void scanTargetWidgetDidVSync(Time::Nanos frameDuration) override;
 
 	private:
-		MachineTypes::TimedMachine *machine = nullptr;
+		Machine::DynamicMachine *machine = nullptr;
 		std::mutex *machineMutex = nullptr;
-		int64_t lastTickNanos = 0;
-		FunctionThread thread;
-		std::unique_ptr<QTimer> timer;
+		Machine::InputQueue inputs;
+
+		// The emulation thread.
+		struct Thread: public QThread {
+			Thread(Timer &timer) : timer(timer) {}
+			void run() override {
+				timer.run();
+			}
+			Timer &timer;
+		} thread{*this};
+		void run();
+		void runToNow();
+
+		static constexpr Time::Nanos tickPeriod = 1'000'000;
+		std::mutex stateMutex;
+		std::condition_variable stateCondition;
+		bool isRunning = false;
+
+		// Used only by the emulation thread.
+		static constexpr Time::Nanos runBudget = 2 * tickPeriod;
+		static constexpr Time::Seconds maxOverdue = 0.5;
+		Time::Nanos lastTickNanos = 0;
+		Time::Seconds overdue = 0.0;
+		Time::ScanSynchroniser scanSynchroniser;
+
+		// Supplied by the GUI thread.
+		std::atomic<Time::Nanos> vsyncNanos = 0;
+		std::atomic<Time::Nanos> frameDuration = 0;
 };
 
 #endif // TIMER_H
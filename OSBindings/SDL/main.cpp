@@ -17,26 +17,49 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
+#include <sstream>
+#include <thread>
 #include <sys/stat.h>
 
 #include <SDL2/SDL.h>
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
+#include "../../Machines/Utility/InputLog.hpp"
+#include "../../Machines/Utility/InputQueue.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Machines/Utility/MemoryFuzzer.hpp"
+#include "../../Machines/Utility/MetricsServer.hpp"
+#include "../../Machines/Utility/ROMIndex.hpp"
+#include "../../Machines/Utility/Rewinder.hpp"
+#include "../../Machines/Utility/RunAhead.hpp"
+#include "../../Machines/Utility/RuntimeMetrics.hpp"
 
 #include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../ClockReceiver/ScanSynchroniser.hpp"
+#include "../../ClockReceiver/VSyncPredictor.hpp"
+#include "../../Concurrency/SPSCRing.hpp"
+#include "../../Concurrency/ThreadPlacement.hpp"
 
 #include "../../Machines/MachineTypes.hpp"
 
 #include "../../Activity/Observer.hpp"
+#include "../../Outputs/FrameHasher.hpp"
+#include "../../Outputs/Logger.hpp"
+#include "../../Outputs/OpenGL/FrameGrabber.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../Outputs/OpenGL/Screenshot.hpp"
+#include "../../Outputs/SharedMemoryPublisher.hpp"
+#include "../../Outputs/Software/ScanTarget.hpp"
+#include "../../Outputs/Speaker/WAVWriter.hpp"
+#include "../../Outputs/VideoWriter.hpp"
 
 #include "../../Reflection/Enum.hpp"
 #include "../../Reflection/Struct.hpp"
 
+#include "../../Storage/Disk/Track/FluxCache.hpp"
+
 namespace {
 
 struct MachineRunner {
@@ -90,14 +113,52 @@ struct MachineRunner {
 		scan_synchroniser_.set_base_speed_multiplier(multiplier);
 	}
 
+	/*!
+		In low-latency mode the machine is no longer held at vsync by the timer to await the next draw;
+		rather the drawing thread should call @c catch_up immediately before each draw, so that each frame
+		includes all output up to that moment. Speed is still nudged to bring emulated and host frames
+		into phase where possible.
+	*/
+	void set_low_latency(bool low_latency) {
+		low_latency_ = low_latency;
+	}
+
+	/*!
+		Runs the machine up to the current time and flushes its output, ready for a draw.
+	*/
+	void catch_up() {
+		std::unique_lock lock_guard(*machine_mutex);
+		run_to_now(lock_guard);
+	}
+
 	std::mutex *machine_mutex;
 	Machine::DynamicMachine *machine;
 
+	/// If set, records machine state every @c rewind_period to allow hold-to-rewind.
+	std::unique_ptr<Machine::Rewinder> rewinder;
+	std::atomic<bool> is_rewinding = false;
+
+	/// Allows roughly a minute of history for most machines.
+	static constexpr size_t rewind_memory_budget = 64 * 1024 * 1024;
+
+	/// If set, all running is routed via run-ahead.
+	std::unique_ptr<Machine::RunAhead> run_ahead;
+
+	/// If set, receives the duration and cost of every period of running.
+	Machine::RuntimeMetrics *metrics = nullptr;
+
+	/// Input posted by the UI thread, which is applied as the machine runs.
+	Machine::InputQueue input_queue;
+
+	/// If set, all input is applied via this recorder; it should be changed only with @c machine_mutex held.
+	Machine::InputRecorder *input_recorder = nullptr;
+
 	private:
 		SDL_TimerID timer_ = 0;
 		Time::Nanos last_time_ = 0;
 		std::atomic<Time::Nanos> vsync_time_;
 		std::atomic_flag frame_lock_;
+		std::atomic<bool> low_latency_ = false;
 
 		enum class State {
 			Running,
@@ -108,6 +169,9 @@ struct MachineRunner {
 
 		Time::ScanSynchroniser scan_synchroniser_;
 
+		static constexpr Time::Nanos rewind_period = 100'000'000;
+		Time::Nanos time_since_rewind_action_ = 0;
+
 		// A slightly clumsy means of trying to derive frame rate from calls to
 		// signal_vsync(); SDL_DisplayMode provides only an integral quantity
 		// whereas, empirically, it's fairly common for monitors to run at the
@@ -118,6 +182,16 @@ struct MachineRunner {
 		std::atomic<double> _frame_period;
 
 		static constexpr Uint32 timer_period = 4;
+
+		// Each update may run for at most two timer periods of host time; emulated time not completed
+		// within that is carried forward, up to the same half-second limit as applies to time glitches.
+		static constexpr Time::Nanos run_budget = 2 * timer_period * 1'000'000;
+		static constexpr Time::Seconds max_overdue = 0.5;
+		Time::Seconds overdue_ = 0.0;
+
+		// Used only by the timer thread.
+		bool is_placed_ = false;
+
 		static Uint32 sdl_callback(Uint32, void *param) {
 			reinterpret_cast<MachineRunner *>(param)->update();
 			return timer_period;
@@ -130,28 +204,101 @@ struct MachineRunner {
 				return;
 			}
 
-			// Get time now and determine how long it has been since the last time this
-			// function was called. If it's more than half a second then forego any activity
-			// now, as there's obviously been some sort of substantial time glitch.
+			// SDL's timer thread is this runner's emulation thread.
+			if(!is_placed_) {
+				Concurrency::ApplyThreadPlacement(Concurrency::ThreadRole::Emulation);
+				is_placed_ = true;
+			}
+
+			std::unique_lock lock_guard(*machine_mutex);
+			run_to_now(lock_guard);
+		}
+
+		/// Runs the machine from @c last_time_ to now; @c lock_guard should hold @c machine_mutex.
+		void run_to_now(std::unique_lock<std::mutex> &lock_guard) {
+			// Get time now and determine how long it has been since the machine was last run.
+			// If it's more than half a second then forego any activity now, as there's obviously
+			// been some sort of substantial time glitch.
+			//
+			// This is done with the machine lock held as run_to_now may be called from either the
+			// timer or the drawing thread.
 			const auto time_now = Time::nanos_now();
 			if(time_now - last_time_ > Time::Nanos(500'000'000)) {
 				last_time_ = time_now - Time::Nanos(500'000'000);
 			}
 
 			const auto vsync_time = vsync_time_.load();
-
-			std::unique_lock lock_guard(*machine_mutex);
 			const auto scan_producer = machine->scan_producer();
 			const auto timed_machine = machine->timed_machine();
 
+			// Periodically either capture state or, if rewinding, step back by one capture.
+			// The machine continues to run in between so that the display reflects each step.
+			if(rewinder) {
+				time_since_rewind_action_ += time_now - last_time_;
+				if(time_since_rewind_action_ >= rewind_period) {
+					time_since_rewind_action_ %= rewind_period;
+					if(is_rewinding) {
+						rewinder->rewind();
+					} else {
+						rewinder->capture();
+					}
+				}
+			}
+
+			// Bound the time spent running; anything not completed by the deadline is carried forward.
+			Time::Nanos deadline = time_now + run_budget;
+			const auto run_for = [&] (Time::Seconds duration) {
+				const auto start_time = metrics ? Time::nanos_now() : 0;
+				const auto start_cycles = timed_machine->get_cycles_run();
+				if(run_ahead) {
+					run_ahead->run_for(duration);
+				} else {
+					const Time::Seconds total = duration + overdue_;
+					duration = timed_machine->run_until_deadline(total, deadline);
+					overdue_ = std::min(total - duration, max_overdue);
+				}
+
+				if(metrics) {
+					// Run-ahead reruns some cycles, so in that case assume the nominal speed was achieved.
+					const Time::Seconds emulated_duration = run_ahead ?
+						duration * timed_machine->get_speed_multiplier() :
+						double(timed_machine->get_cycles_run() - start_cycles) / timed_machine->get_clock_rate();
+					metrics->did_run(emulated_duration, Time::Nanos(duration * 1e9), Time::nanos_now() - start_time);
+				}
+			};
+
+			// Runs until @c end, applying any queued input at the point within this period that it was posted.
+			Time::Nanos position = last_time_;
+			const auto run_until = [&] (Time::Nanos end) {
+				input_queue.apply_until(end, *machine, input_recorder, [&] (Time::Nanos timestamp) {
+					if(timestamp > position) {
+						run_for(double(timestamp - position) / 1e9);
+						position = timestamp;
+					}
+				});
+				run_for(double(end - position) / 1e9);
+				position = end;
+			};
+
+			const bool did_cross_vsync = last_time_ < vsync_time && time_now >= vsync_time;
 			bool split_and_sync = false;
-			if(last_time_ < vsync_time && time_now >= vsync_time) {
+			if(did_cross_vsync) {
 				split_and_sync = scan_synchroniser_.can_synchronise(scan_producer->get_scan_status(), _frame_period);
 			}
 
-			if(split_and_sync) {
-				timed_machine->run_for(double(vsync_time - last_time_) / 1e9);
+			if(split_and_sync && low_latency_) {
+				// Adjust speed towards synchronisation but don't block; the drawing thread will catch up
+				// with the machine when it is ready to draw.
+				timed_machine->set_speed_multiplier(
+					scan_synchroniser_.next_speed_multiplier(scan_producer->get_scan_status())
+				);
+				run_until(time_now);
+				timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+				if(run_ahead) run_ahead->present();
+			} else if(split_and_sync) {
+				run_until(vsync_time);
 				timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+				if(run_ahead) run_ahead->present();
 				timed_machine->set_speed_multiplier(
 					scan_synchroniser_.next_speed_multiplier(scan_producer->get_scan_status())
 				);
@@ -163,12 +310,14 @@ struct MachineRunner {
 				while(frame_lock_.test_and_set());
 				lock_guard.lock();
 
-				timed_machine->run_for(double(time_now - vsync_time) / 1e9);
+				deadline = Time::nanos_now() + run_budget;
+				run_until(time_now);
 				timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
 			} else {
 				timed_machine->set_speed_multiplier(scan_synchroniser_.get_base_speed_multiplier());
-				timed_machine->run_for(double(time_now - last_time_) / 1e9);
+				run_until(time_now);
 				timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+				if(run_ahead && did_cross_vsync) run_ahead->present();
 			}
 			last_time_ = time_now;
 		}
@@ -179,38 +328,68 @@ struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
 	static constexpr size_t buffered_samples = 1024;
 	bool is_stereo = false;
 
-	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
-		const size_t buffer_size = buffered_samples * (is_stereo ? 2 : 1);
-		if(audio_buffer_.size() > buffer_size) {
-			audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.end() - buffer_size);
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final {
+		{
+			std::lock_guard lock_guard(recorder_mutex_);
+			if(recorder_) recorder_->speaker_did_complete_samples(speaker, buffer);
+		}
+
+		// If the audio thread has stalled for long enough that the ring is full, drop these samples;
+		// the audio thread will skip to the latest audio anyway once it resumes.
+		if(!audio_buffer_.push(buffer.data(), buffer.size()) && metrics) {
+			metrics->did_overrun_audio();
 		}
-		audio_buffer_.insert(audio_buffer_.end(), buffer.begin(), buffer.end());
+
+		// Aim to keep one callback's worth of audio buffered, nudging the rate of production up or down
+		// slightly as required, rather than periodically running dry or skipping audio.
+		speaker->set_output_buffer_fill(audio_buffer_.size(), buffered_samples * (is_stereo ? 2 : 1));
 	}
 
 	void audio_callback(Uint8 *stream, int len) {
-		std::lock_guard lock_guard(audio_buffer_mutex_);
+		if(!is_placed_) {
+			Concurrency::ApplyThreadPlacement(Concurrency::ThreadRole::Audio);
+			is_placed_ = true;
+		}
+
+		// Skip any audio well beyond the intended amount of buffering, to bound latency.
+		const size_t latency_limit = 2 * buffered_samples * (is_stereo ? 2 : 1);
+		if(metrics && audio_buffer_.size() > latency_limit) metrics->did_overrun_audio();
+		audio_buffer_.discard_to(latency_limit);
 
 		// SDL buffer length is in bytes, so there's no need to adjust for stereo/mono in here.
 		const std::size_t sample_length = size_t(len) / sizeof(int16_t);
-		const std::size_t copy_length = std::min(sample_length, audio_buffer_.size());
 		int16_t *const target = static_cast<int16_t *>(static_cast<void *>(stream));
 
-		std::memcpy(stream, audio_buffer_.data(), copy_length * sizeof(int16_t));
+		const std::size_t copy_length = audio_buffer_.pop(target, sample_length);
 		if(copy_length < sample_length) {
 			std::memset(&target[copy_length], 0, (sample_length - copy_length) * sizeof(int16_t));
+			if(metrics) metrics->did_underrun_audio();
 		}
-		audio_buffer_.erase(audio_buffer_.begin(), audio_buffer_.begin() + copy_length);
 	}
 
 	static void SDL_audio_callback(void *userdata, Uint8 *stream, int len) {
 		reinterpret_cast<SpeakerDelegate *>(userdata)->audio_callback(stream, len);
 	}
 
+	/// Nominates a further delegate to receive a copy of all audio, or @c nullptr for none.
+	void set_recorder(Outputs::Speaker::Speaker::Delegate *recorder) {
+		std::lock_guard lock_guard(recorder_mutex_);
+		recorder_ = recorder;
+	}
+
 	SDL_AudioDeviceID audio_device;
 
-	std::mutex audio_buffer_mutex_;
-	std::vector<int16_t> audio_buffer_;
+	/// If set, is informed whenever audio runs out or has to be discarded; should be set before audio starts.
+	Machine::RuntimeMetrics *metrics = nullptr;
+
+	// Filled by the emulation thread and emptied by SDL's audio thread, neither ever waiting for the other.
+	Concurrency::SPSCRing<int16_t, 16384> audio_buffer_;
+
+	std::mutex recorder_mutex_;
+	Outputs::Speaker::Speaker::Delegate *recorder_ = nullptr;
+
+	// Used only by SDL's audio thread.
+	bool is_placed_ = false;
 };
 
 class ActivityObserver: public Activity::Observer {
@@ -525,6 +704,366 @@ class SDLJoystick {
 		std::vector<Uint8> hat_values_;
 };
 
+/*!
+	Writes the @c width x @c height RGBA image at @c pixels to @c target as a BMP.
+*/
+void save_screenshot(const uint8_t *pixels, int width, int height, const std::string &target) {
+	const bool is_big_endian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
+	SDL_Surface *const surface = SDL_CreateRGBSurfaceFrom(
+		const_cast<uint8_t *>(pixels),
+		width, height,
+		8*4,
+		width*4,
+		is_big_endian ? 0xff000000 : 0x000000ff,
+		is_big_endian ? 0x00ff0000 : 0x0000ff00,
+		is_big_endian ? 0x0000ff00 : 0x00ff0000,
+		0);
+	SDL_SaveBMP(surface, target.c_str());
+	SDL_FreeSurface(surface);
+}
+
+/*!
+	Prints the profile of @c machine to stdout, with components ordered by exclusive host time.
+*/
+void print_profile(Machine::DynamicMachine &machine) {
+	if constexpr (!Profiling::Enabled) {
+		std::cerr << "Profiling is not enabled in this build; rebuild with CLK_PROFILE defined, e.g. via scons profile=1." << std::endl;
+		return;
+	}
+
+	const auto profiled = machine.profiled();
+	if(!profiled) {
+		std::cerr << "This machine cannot be profiled." << std::endl;
+		return;
+	}
+
+	auto report = profiled->get_profile();
+	std::sort(report.begin(), report.end(), [](const Profiling::Record &lhs, const Profiling::Record &rhs) {
+		return lhs.exclusive > rhs.exclusive;
+	});
+	Time::Seconds total = 0.0;
+	for(const auto &record: report) {
+		total += record.exclusive;
+	}
+
+	std::cout << std::setw(12) << "exclusive/s" << std::setw(8) << "%" << std::setw(12) << "inclusive/s";
+	std::cout << std::setw(12) << "calls" << std::setw(16) << "cycles" << "  component" << std::endl;
+	for(const auto &record: report) {
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << std::setw(12) << record.exclusive;
+		std::cout << std::setw(8) << std::setprecision(1) << (total > 0.0 ? 100.0 * record.exclusive / total : 0.0);
+		std::cout << std::setw(12) << std::setprecision(3) << record.inclusive;
+		std::cout << std::setw(12) << record.calls << std::setw(16) << record.cycles;
+		std::cout << "  " << record.name << std::endl;
+	}
+	std::cout << std::defaultfloat;
+}
+
+/*!
+	@returns The format in which video should be recorded to @c target: raw RGBA if it has a .rgba
+	or .raw extension; the delta format if it has a .clkd extension; YUV4MPEG2 otherwise.
+*/
+Outputs::Display::VideoWriter::Format video_format_for(const std::string &target) {
+	const auto has_extension = [&target](const std::string &extension) {
+		return target.size() >= extension.size() && !target.compare(target.size() - extension.size(), extension.size(), extension);
+	};
+	if(has_extension(".rgba") || has_extension(".raw")) return Outputs::Display::VideoWriter::Format::RGBA;
+	if(has_extension(".clkd")) return Outputs::Display::VideoWriter::Format::Delta;
+	return Outputs::Display::VideoWriter::Format::Y4M;
+}
+
+/*!
+	Forwards all calls to another scan target, keeping count of the number
+	of vertical retraces that pass through it and optionally discarding the
+	data and scans of all but one in every so many frames.
+*/
+class FrameCountingScanTarget: public Outputs::Display::ScanTarget {
+	public:
+		FrameCountingScanTarget(Outputs::Display::ScanTarget *target) : target_(target) {}
+
+		/// @returns The number of vertical retraces that have begun since construction.
+		int frames() const {
+			return frames_;
+		}
+
+		/// Sets the number of frames to discard after each that is forwarded.
+		///
+		/// Announcements and submits are always forwarded, so the target keeps its
+		/// place; it just receives no lines for discarded frames.
+		void set_frames_to_skip(int frames) {
+			frames_to_skip_ = frames;
+		}
+
+		void set_modals(Modals modals) final				{	target_->set_modals(modals);	}
+		void set_palette(const uint32_t *palette, size_t length) final {
+			target_->set_palette(palette, length);
+		}
+		Scan *begin_scan() final {
+			return is_discarding_ ? &scan_ : target_->begin_scan();
+		}
+		void end_scan() final {
+			if(!is_discarding_) target_->end_scan();
+		}
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final {
+			// Latch the decision so that this piece of data is ended wherever it was begun.
+			data_is_forwarded_ = !is_discarding_;
+			return data_is_forwarded_ ? target_->begin_data(required_length, required_alignment) : nullptr;
+		}
+		void end_data(size_t actual_length) final {
+			if(data_is_forwarded_) target_->end_data(actual_length);
+		}
+		bool is_discarding_data() const final				{	return is_discarding_ || target_->is_discarding_data();	}
+		void will_change_owner() final						{	target_->will_change_owner();	}
+		void submit() final									{	target_->submit();				}
+
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final {
+			if(event == Event::BeginVerticalRetrace) {
+				++frames_;
+
+				// Switch only during retrace, when no scans are in progress.
+				frames_skipped_ = is_discarding_ ? frames_skipped_ + 1 : 0;
+				is_discarding_ = frames_skipped_ < frames_to_skip_;
+			}
+			target_->announce(event, is_visible, location, composite_amplitude);
+		}
+
+	private:
+		Outputs::Display::ScanTarget *const target_;
+		int frames_ = 0;
+
+		int frames_to_skip_ = 0;
+		int frames_skipped_ = 0;
+		bool is_discarding_ = false;
+		bool data_is_forwarded_ = false;
+		Scan scan_;
+};
+
+/*!
+	Runs @c machine with no display or audio output, as quickly as the host permits, until
+	either the number of frames specified by --frames or the amount of emulated time specified
+	by --seconds has elapsed. If --screenshot={file} was supplied then output is rasterised
+	in software and the final frame is saved to that file. If --record-audio={file} was supplied
+	then all audio is written to that file as a WAV. If --record-video={file} was supplied then
+	the rasterised output is sampled at --record-fps frames per emulated second, defaulting to 50,
+	and written as YUV4MPEG2 or, for files ending .rgba or .raw, as raw RGBA or, for files ending
+	.clkd, in the lossless delta format. If --publish-frames={name} was supplied then frames are
+	sampled in the same way and published to the named POSIX shared-memory object. If
+	--replay-input={file} was supplied then the inputs recorded in that file are replayed, and
+	the run also ends when the recording does. If --frame-hashes={file} was supplied then a hash
+	of each frame's video and audio is written to that file, as per Outputs/FrameHasher.hpp.
+
+	@returns The process exit code.
+*/
+int run_headless(Machine::DynamicMachine &machine, const ParsedArguments &arguments) {
+	// The calling thread runs the machine.
+	Concurrency::ApplyThreadPlacement(Concurrency::ThreadRole::Emulation);
+
+	// Parse the stop conditions; at least one is required.
+	const auto parse_limit = [&arguments](const char *name, double &value) -> bool {
+		const auto argument = arguments.selections.find(name);
+		if(argument == arguments.selections.end()) return true;
+
+		const char *string = argument->second.c_str();
+		char *end;
+		value = strtod(string, &end);
+		if(size_t(end - string) != strlen(string) || value <= 0.0) {
+			std::cerr << "Unable to parse --" << name << "=" << argument->second << "; a positive number is required." << std::endl;
+			return false;
+		}
+		return true;
+	};
+	double frame_limit = 0.0, seconds_limit = 0.0;
+	if(!parse_limit("frames", frame_limit) || !parse_limit("seconds", seconds_limit)) {
+		return EXIT_FAILURE;
+	}
+	const auto replay_input_argument = arguments.selections.find("replay-input");
+	if(frame_limit == 0.0 && seconds_limit == 0.0 && replay_input_argument == arguments.selections.end()) {
+		std::cerr << "Headless mode requires a stop condition; use --frames={count} and/or --seconds={emulated seconds}, or --replay-input={file}." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const auto screenshot_argument = arguments.selections.find("screenshot");
+	const bool take_screenshot = screenshot_argument != arguments.selections.end() && !screenshot_argument->second.empty();
+
+	const auto record_video_argument = arguments.selections.find("record-video");
+	const bool record_video = record_video_argument != arguments.selections.end() && !record_video_argument->second.empty();
+	const auto publish_frames_argument = arguments.selections.find("publish-frames");
+	const bool publish_frames = publish_frames_argument != arguments.selections.end() && !publish_frames_argument->second.empty();
+	double video_rate = 50.0;
+	if(!parse_limit("record-fps", video_rate)) {
+		return EXIT_FAILURE;
+	}
+
+	// Without a screenshot or video, no video output is needed at all. Otherwise rasterise in software.
+	std::unique_ptr<Outputs::Display::Software::ScanTarget> software_scan_target;
+	if(take_screenshot || record_video || publish_frames) {
+		software_scan_target = std::make_unique<Outputs::Display::Software::ScanTarget>();
+	}
+
+	// Record video if requested, at a fixed frame rate in emulated time so that it remains
+	// in step with any recorded audio.
+	std::unique_ptr<Outputs::Display::VideoWriter> video_writer;
+	if(record_video) {
+		try {
+			video_writer = std::make_unique<Outputs::Display::VideoWriter>(
+				record_video_argument->second,
+				software_scan_target->width(), software_scan_target->height(),
+				int(video_rate * 1000.0 + 0.5), 1000,
+				video_format_for(record_video_argument->second));
+		} catch(Storage::FileHolder::Error) {
+			std::cerr << "Unable to open " << record_video_argument->second << " to record video." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Publish frames to shared memory if requested, at the same rate as video would be recorded.
+	std::unique_ptr<Outputs::Display::SharedMemoryPublisher> frame_publisher;
+	if(publish_frames) {
+		try {
+			frame_publisher = std::make_unique<Outputs::Display::SharedMemoryPublisher>(
+				publish_frames_argument->second,
+				software_scan_target->width(), software_scan_target->height());
+		} catch(Outputs::Display::SharedMemoryPublisher::Error) {
+			std::cerr << "Unable to create shared memory " << publish_frames_argument->second << " to publish frames." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	const bool samples_frames = video_writer || frame_publisher;
+
+	// Replay recorded input if requested.
+	std::unique_ptr<Machine::InputPlayer> input_player;
+	if(replay_input_argument != arguments.selections.end() && !replay_input_argument->second.empty()) {
+		try {
+			input_player = std::make_unique<Machine::InputPlayer>(machine, replay_input_argument->second);
+		} catch(Storage::FileHolder::Error) {
+			std::cerr << "Unable to open " << replay_input_argument->second << " to replay input." << std::endl;
+			return EXIT_FAILURE;
+		} catch(Machine::InputPlayer::Error) {
+			std::cerr << replay_input_argument->second << " is not an input recording." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Hash frames if requested; the hasher sees all video before anything else does.
+	std::unique_ptr<Outputs::Display::FrameHasher> frame_hasher;
+	const auto frame_hashes_argument = arguments.selections.find("frame-hashes");
+	if(frame_hashes_argument != arguments.selections.end() && !frame_hashes_argument->second.empty()) {
+		try {
+			frame_hasher = std::make_unique<Outputs::Display::FrameHasher>(frame_hashes_argument->second, software_scan_target.get());
+		} catch(Storage::FileHolder::Error) {
+			std::cerr << "Unable to open " << frame_hashes_argument->second << " to write frame hashes." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	Outputs::Display::ScanTarget *output_scan_target = &Outputs::Display::NullScanTarget::singleton;
+	if(frame_hasher) {
+		output_scan_target = frame_hasher.get();
+	} else if(software_scan_target) {
+		output_scan_target = software_scan_target.get();
+	}
+	FrameCountingScanTarget scan_target(output_scan_target);
+	machine.scan_producer()->set_scan_target(&scan_target);
+
+	// Record audio if requested.
+	std::unique_ptr<Outputs::Speaker::WAVWriter> audio_writer;
+	const auto record_audio_argument = arguments.selections.find("record-audio");
+	const bool record_audio = record_audio_argument != arguments.selections.end() && !record_audio_argument->second.empty();
+	const auto audio_producer = machine.audio_producer();
+	const auto speaker = audio_producer ? audio_producer->get_speaker() : nullptr;
+	constexpr int audio_rate = 44100;
+	if(record_audio) {
+		if(!speaker) {
+			std::cerr << "This machine has no audio output to record." << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		try {
+			audio_writer = std::make_unique<Outputs::Speaker::WAVWriter>(record_audio_argument->second, audio_rate, speaker->get_is_stereo());
+		} catch(Storage::FileHolder::Error) {
+			std::cerr << "Unable to open " << record_audio_argument->second << " to record audio." << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Route audio via the hasher, if any, then to the recorder, if any.
+	if(speaker && (audio_writer || frame_hasher)) {
+		speaker->set_output_rate(audio_rate, 1024, speaker->get_is_stereo());
+		if(frame_hasher) {
+			frame_hasher->set_audio_delegate(audio_writer.get());
+			speaker->set_delegate(frame_hasher.get());
+		} else {
+			speaker->set_delegate(audio_writer.get());
+		}
+	}
+
+	// Run in slices of a hundredth of an emulated second, testing the stop conditions after each.
+	// If a screenshot is going to be taken then buffered video is drained at every frame boundary
+	// so that the final frame is assuredly available. If video is being recorded then slices
+	// are instead one output frame long, and the framebuffer is captured after each.
+	const auto timed_machine = machine.timed_machine();
+	const Time::Seconds slice = samples_frames ? 1.0 / video_rate : 0.01;
+	Time::Seconds elapsed = 0.0;
+	int last_frames = 0;
+	while(
+		(frame_limit == 0.0 || double(scan_target.frames()) < frame_limit) &&
+		(seconds_limit == 0.0 || elapsed < seconds_limit)
+	) {
+		if(input_player) {
+			if(!input_player->run_for(slice)) break;
+		} else {
+			timed_machine->run_for(slice);
+		}
+		elapsed += slice;
+
+		if(samples_frames) {
+			timed_machine->flush_output(MachineTypes::TimedMachine::Output::Video);
+			software_scan_target->update();
+			if(video_writer) {
+				video_writer->write_frame(
+					software_scan_target->pixels(),
+					software_scan_target->width(),
+					software_scan_target->height(),
+					size_t(software_scan_target->width() * 4));
+			}
+			if(frame_publisher) {
+				frame_publisher->publish_frame(
+					software_scan_target->pixels(),
+					software_scan_target->width(),
+					software_scan_target->height(),
+					size_t(software_scan_target->width() * 4),
+					uint64_t(elapsed * 1e9));
+			}
+		} else if(software_scan_target && scan_target.frames() != last_frames) {
+			last_frames = scan_target.frames();
+			timed_machine->flush_output(MachineTypes::TimedMachine::Output::Video);
+			software_scan_target->update();
+		}
+	}
+	timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+	video_writer.reset();
+
+	if(speaker) {
+		speaker->set_delegate(nullptr);
+	}
+	audio_writer.reset();
+
+	if(take_screenshot) {
+		software_scan_target->update();
+		save_screenshot(
+			software_scan_target->pixels(),
+			software_scan_target->width(),
+			software_scan_target->height(),
+			screenshot_argument->second);
+	}
+
+	std::cout << "Ran " << elapsed << " emulated seconds, " << scan_target.frames() << " frames." << std::endl;
+	if(arguments.selections.find("profile") != arguments.selections.end()) {
+		print_profile(machine);
+	}
+	return EXIT_SUCCESS;
+}
+
 }
 
 int main(int argc, char *argv[]) {
@@ -534,7 +1073,7 @@ int main(int argc, char *argv[]) {
 	const ParsedArguments arguments = parse_arguments(argc, argv);
 
 	// This may be printed either as
-	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}]";
+	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}] [--loading-speed={speed multiplier while a tape plays, e.g. 8}]  [--logical-keyboard] [--volume={0.0 to 1.0}] [--runahead={frames}] [--low-latency[=just-in-time]] [--beam-race={slices}] [--copy-on-write] [--fuzz-seed={number}] [--log={source,source,...}] [--headless --frames={count} --seconds={emulated seconds} --screenshot={file} --record-fps={frames per second}] [--record-audio={file}] [--record-video={file}] [--publish-frames={shared memory name}] [--frame-hashes={file}] [--record-input={file}] [--replay-input={file}] [--bus-trace={file}] [--metrics={port or socket path}] [--{emulation|audio|storage}-cores={list, e.g. 0,2-3}] [--{emulation|audio|storage}-priority={default|elevated|realtime}] [--profile]";
 
 	// Print a help message if requested.
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
@@ -542,6 +1081,20 @@ int main(int argc, char *argv[]) {
 
 		std::cout << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
 		std::cout << "Use alt+enter to toggle full screen display. Use control+shift+V to paste text." << std::endl;
+		std::cout << "Use --headless to run without display or audio as quickly as possible until --frames or --seconds has elapsed, optionally saving the final frame via --screenshot." << std::endl;
+		std::cout << "Use --record-audio to record audio as a WAV and --record-video to record video as YUV4MPEG2, as raw RGBA if the file name ends .rgba or .raw, or as a lossless delta stream if it ends .clkd; named pipes are acceptable targets." << std::endl;
+		std::cout << "Use --publish-frames with --headless to publish frames to a POSIX shared-memory object, e.g. --publish-frames=/clk; see Outputs/SharedMemoryPublisher.hpp for its layout." << std::endl;
+		std::cout << "Use --frame-hashes with --headless to write a hash of each frame's video and audio to a text file, for quick comparison between runs." << std::endl;
+		std::cout << "Use --record-input to record all input to a file, and --replay-input with --headless to replay it; replays must use the same machine, media and options as the recording. Both imply --copy-on-write, and recording disables rewind and run-ahead." << std::endl;
+		std::cout << "Use --low-latency to bring the machine up to date immediately before each frame is drawn; add =just-in-time also to delay drawing until just before each predicted vsync, minimising input latency at the risk of the occasional dropped frame." << std::endl;
+		std::cout << "Use --beam-race to present each frame in the given number of horizontal slices, each just ahead of the display's raster; this implies --low-latency and works best with a fixed-refresh display and a machine running at the display's frame rate." << std::endl;
+		std::cout << "Use --copy-on-write to leave all disk and hard disk images unmodified, retaining any changes in memory only until exit." << std::endl;
+		std::cout << "Use --fuzz-seed to fill emulated memory at startup with a reproducible pattern derived from the given number, rather than at random." << std::endl;
+		std::cout << "Use --log to write diagnostic output from the named sources, e.g. --log=\"WD FDC,SCSI\", to stderr; output is formatted on a separate thread so as not to slow emulation." << std::endl;
+		std::cout << "Use --bus-trace to record every bus cycle of the machine's main processor to a compressed file, e.g. to find where two runs diverge; see Processors/BusTrace.hpp for its format." << std::endl;
+		std::cout << "Use --metrics to serve speed, frame, audio and timing statistics in the Prometheus text format over HTTP, either on the given port of 127.0.0.1 or on a Unix domain socket if given a path, e.g. --metrics=9100." << std::endl;
+		std::cout << "Use --emulation-cores, --audio-cores and --storage-cores to confine emulation threads, audio threads and disk-writing threads to the listed cores, and the equivalent -priority options to raise their priorities where permitted; each emulation worker is pinned to one core of its list." << std::endl;
+		std::cout << "Use --profile to print a breakdown of host time by component upon exit, in builds with CLK_PROFILE defined." << std::endl;
 		std::cout << "Required machine type **and all options** are determined from the file if specified; otherwise use:" << std::endl << std::endl;
 		std::cout << "\t--new={";
 		bool is_first = true;
@@ -630,6 +1183,35 @@ int main(int argc, char *argv[]) {
 		return EXIT_SUCCESS;
 	}
 
+	// Establish a cache directory, in $XDG_CACHE_HOME/clksignal or, failing that, ~/.cache/clksignal.
+	std::string cache_directory;
+	{
+		const char *const xdg_cache_home = getenv("XDG_CACHE_HOME");
+		const char *const home = getenv("HOME");
+		if(xdg_cache_home && *xdg_cache_home) {
+			cache_directory = xdg_cache_home;
+		} else if(home) {
+			cache_directory = std::string(home) + "/.cache";
+			mkdir(cache_directory.c_str(), 0755);
+		}
+
+		if(!cache_directory.empty()) {
+			cache_directory += "/clksignal";
+			mkdir(cache_directory.c_str(), 0755);
+
+			struct stat directory_stats;
+			if(stat(cache_directory.c_str(), &directory_stats) || !S_ISDIR(directory_stats.st_mode)) {
+				cache_directory.clear();
+			}
+		}
+	}
+
+	// Permit slow-to-decode disk images to keep their decoded tracks between runs; this needs to be
+	// in place before any media is opened.
+	if(!cache_directory.empty()) {
+		Storage::Disk::FluxCache::set_cache_directory(cache_directory);
+	}
+
 	// Determine the machine for the supplied file, if any, or from --new.
 	Analyser::Static::TargetList targets;
 
@@ -697,69 +1279,113 @@ int main(int argc, char *argv[]) {
 	//	/usr/local/share/CLK/[system];
 	//	/usr/share/CLK/[system]; or
 	//	[user-supplied path]/[system]
+	std::vector<std::string> rom_paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	};
+
+	const auto rompath = arguments.selections.find("rompath");
+	if(rompath != arguments.selections.end()) {
+		std::string path = rompath->second;
+
+		// Ensure the path ends in a slash.
+		if(path.back() != '/') {
+			path += '/';
+		}
+
+		// If ~ is present, expand it to %HOME%.
+		const size_t tilde_position = path.find("~");
+		if(tilde_position != std::string::npos) {
+			path.replace(tilde_position, 1, getenv("HOME"));
+		}
+
+		rom_paths.push_back(path);
+	}
+
+	// Keep an index of everything in those directories, so that ROMs can also be found by contents and so
+	// that the index can be retained between runs.
+	if(!cache_directory.empty()) {
+		ROM::Index::set_cache_directory(cache_directory);
+	}
+	ROM::Index rom_index(rom_paths);
+
 	ROM::Request missing_roms;
 	std::vector<std::string> checked_paths;
-	ROMMachine::ROMFetcher rom_fetcher = [&missing_roms, &arguments, &checked_paths]
+	ROMMachine::ROMFetcher rom_fetcher = [&missing_roms, &rom_index, &checked_paths]
 		(const ROM::Request &roms) -> ROM::Map {
-			std::vector<std::string> paths = {
-				"/usr/local/share/CLK/",
-				"/usr/share/CLK/"
-			};
+			const ROM::Map results = rom_index.find(roms);
+			const auto &rom_checked_paths = rom_index.checked_paths();
+			std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
 
-			const auto rompath = arguments.selections.find("rompath");
-			if(rompath != arguments.selections.end()) {
-				std::string path = rompath->second;
+			missing_roms = roms.subtract(results);
+			return results;
+		};
 
-				// Ensure the path ends in a slash.
-				if(path.back() != '/') {
-					path += '/';
-				}
+	// If requested, ensure that no media is modified, by directing all writes to copy-on-write overlays.
+	// Recording or replaying input implies this, so that every replay starts from the same media.
+	const bool copy_on_write =
+		arguments.selections.find("copy-on-write") != arguments.selections.end() ||
+		arguments.selections.find("record-input") != arguments.selections.end() ||
+		arguments.selections.find("replay-input") != arguments.selections.end();
+	if(copy_on_write) {
+		for(auto &target: targets) {
+			target->media = Analyser::Static::CopyOnWrite(target->media);
+		}
+	}
 
-				// If ~ is present, expand it to %HOME%.
-				const size_t tilde_position = path.find("~");
-				if(tilde_position != std::string::npos) {
-					path.replace(tilde_position, 1, getenv("HOME"));
+	// Enable any requested logging.
+	{
+		const auto log_argument = arguments.selections.find("log");
+		if(log_argument != arguments.selections.end()) {
+			std::stringstream sources(log_argument->second);
+			std::string source;
+			while(std::getline(sources, source, ',')) {
+				if(!Log::Logger::set_enabled(source, true)) {
+					std::cerr << "Unrecognised log source: " << source << std::endl;
 				}
-
-				paths.push_back(path);
 			}
+			Log::Logger::start();
+		}
+	}
 
-			ROM::Map results;
-			for(const auto &description: roms.all_descriptions()) {
-				for(const auto &file_name: description.file_names) {
-					FILE *file = nullptr;
-					std::vector<std::string> rom_checked_paths;
-					for(const auto &path: paths) {
-						std::string local_path = path + description.machine_name + "/" + file_name;
-						file = std::fopen(local_path.c_str(), "rb");
-						rom_checked_paths.push_back(local_path);
-						if(file) break;
-					}
-
-					if(!file) {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
-						continue;
-					}
+	// If requested, fill memory at construction with a reproducible pattern rather than random contents.
+	{
+		const auto fuzz_seed_argument = arguments.selections.find("fuzz-seed");
+		if(fuzz_seed_argument != arguments.selections.end()) {
+			const char *seed_string = fuzz_seed_argument->second.c_str();
+			char *end;
+			const unsigned long long seed = strtoull(seed_string, &end, 0);
+			if(!*seed_string || size_t(end - seed_string) != strlen(seed_string)) {
+				std::cerr << "Unable to parse fuzz seed: " << seed_string << std::endl;
+			} else {
+				Memory::SetFuzzSeed(uint64_t(seed));
+			}
+		}
+	}
 
-					std::vector<uint8_t> data;
+	// Place threads as requested; this precedes machine construction so that all threads are affected.
+	{
+		static constexpr std::pair<const char *, Concurrency::ThreadRole> roles[] = {
+			{"emulation", Concurrency::ThreadRole::Emulation},
+			{"audio", Concurrency::ThreadRole::Audio},
+			{"storage", Concurrency::ThreadRole::Storage},
+		};
+		for(const auto &role: roles) {
+			Concurrency::ThreadPlacement placement;
 
-					std::fseek(file, 0, SEEK_END);
-					data.resize(std::ftell(file));
-					std::fseek(file, 0, SEEK_SET);
-					std::size_t read = fread(data.data(), 1, data.size(), file);
-					std::fclose(file);
+			const auto cores_argument = arguments.selections.find(std::string(role.first) + "-cores");
+			if(cores_argument != arguments.selections.end() && !Concurrency::ParseCores(cores_argument->second, placement.cores)) {
+				std::cerr << "Unable to parse core list: " << cores_argument->second << std::endl;
+			}
 
-					if(read == data.size()) {
-						results[description.name] = std::move(data);
-					} else {
-						std::copy(rom_checked_paths.begin(), rom_checked_paths.end(), std::back_inserter(checked_paths));
-					}
-				}
+			const auto priority_argument = arguments.selections.find(std::string(role.first) + "-priority");
+			if(priority_argument != arguments.selections.end() && !Concurrency::ParsePriority(priority_argument->second, placement.priority)) {
+				std::cerr << "Unrecognised thread priority: " << priority_argument->second << std::endl;
 			}
 
-			missing_roms = roms.subtract(results);
-			return results;
-		};
+			Concurrency::SetThreadPlacement(role.second, placement);
+		}
+	}
 
 	// Apply all command-line options to the targets.
 	for(auto &target: targets) {
@@ -768,10 +1394,20 @@ int main(int argc, char *argv[]) {
 		arguments.apply(reflectable_target);
 	}
 
-	// Create and configure a machine.
+	// Create and configure a machine; construction proceeds on another thread while SDL
+	// is initialised, unless running headless.
 	::Machine::Error error;
 	std::mutex machine_mutex;
-	std::unique_ptr<::Machine::DynamicMachine> machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
+	auto machine_construction = ::Machine::MachineForTargetsAsync(targets, rom_fetcher, error);
+
+	const bool is_headless = arguments.selections.find("headless") != arguments.selections.end();
+	if(!is_headless && SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
+		std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+		delete machine_construction.get();
+		return EXIT_FAILURE;
+	}
+
+	std::unique_ptr<::Machine::DynamicMachine> machine(machine_construction.get());
 	if(!machine) {
 		switch(error) {
 			default: break;
@@ -804,7 +1440,9 @@ int main(int argc, char *argv[]) {
 		configurable->set_options(options);
 	}
 
-	// Apply the speed multiplier, if one was requested.
+	// Apply the speed multiplier, if one was requested. At whole multiples of real speed and above,
+	// display only one frame in every multiple; the rest would be overdrawn before presentation anyway.
+	int frames_to_skip = 0;
 	{
 		const auto speed_argument = arguments.selections.find("speed");
 		if(speed_argument != arguments.selections.end()) {
@@ -818,6 +1456,26 @@ int main(int argc, char *argv[]) {
 				std::cerr << "Cannot run at speed " << speed_string << "; speeds must be positive." << std::endl;
 			} else {
 				machine_runner.set_speed_multiplier(speed);
+				frames_to_skip = std::max(0, int(speed) - 1);
+			}
+		}
+	}
+
+	// Apply the loading speed multiplier, if one was requested.
+	{
+		const auto speed_argument = arguments.selections.find("loading-speed");
+		const auto timed_machine = machine->timed_machine();
+		if(speed_argument != arguments.selections.end() && timed_machine) {
+			const char *speed_string = speed_argument->second.c_str();
+			char *end;
+			const double speed = strtod(speed_string, &end);
+
+			if(size_t(end - speed_string) != strlen(speed_string)) {
+				std::cerr << "Unable to parse loading speed: " << speed_string << std::endl;
+			} else if(speed <= 0.0) {
+				std::cerr << "Cannot load at speed " << speed_string << "; speeds must be positive." << std::endl;
+			} else {
+				timed_machine->set_loading_speed_multiplier(speed);
 			}
 		}
 	}
@@ -844,6 +1502,60 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	// Determine the number of frames to run ahead by, if requested.
+	int run_ahead_frames = 0;
+	{
+		const auto run_ahead_argument = arguments.selections.find("runahead");
+		if(run_ahead_argument != arguments.selections.end()) {
+			const char *run_ahead_string = run_ahead_argument->second.c_str();
+			char *end;
+			const long frames = strtol(run_ahead_string, &end, 10);
+
+			if(size_t(end - run_ahead_string) != strlen(run_ahead_string)) {
+				std::cerr << "Unable to parse run-ahead frame count: " << run_ahead_string << std::endl;
+			} else if(frames < 0 || frames > 8) {
+				std::cerr << "Cannot run ahead by " << run_ahead_string << " frames; please pick between 0 and 8." << std::endl;
+			} else {
+				run_ahead_frames = int(frames);
+			}
+		}
+	}
+
+	// Input recording requires a single, monotonic timeline, so is incompatible with run-ahead.
+	const auto record_input_argument = arguments.selections.find("record-input");
+	const bool record_input = record_input_argument != arguments.selections.end() && !record_input_argument->second.empty();
+	if(record_input && run_ahead_frames) {
+		std::cerr << "Run-ahead is disabled while recording input." << std::endl;
+		run_ahead_frames = 0;
+	}
+
+	// Check whether low-latency presentation has been requested.
+	const auto low_latency_argument = arguments.selections.find("low-latency");
+	const bool just_in_time =
+		low_latency_argument != arguments.selections.end() && low_latency_argument->second == "just-in-time";
+	if(low_latency_argument != arguments.selections.end() && !just_in_time && !low_latency_argument->second.empty()) {
+		std::cerr << "Unrecognised low-latency mode: " << low_latency_argument->second << std::endl;
+	}
+
+	// Check whether beam racing has been requested; if so then it implies low-latency mode.
+	int beam_race_slices = 1;
+	const auto beam_race_argument = arguments.selections.find("beam-race");
+	if(beam_race_argument != arguments.selections.end()) {
+		const auto &beam_race_string = beam_race_argument->second;
+		char *end;
+		const long slices = strtol(beam_race_string.c_str(), &end, 10);
+		if(*end) {
+			std::cerr << "Unable to parse beam-race slice count: " << beam_race_string << std::endl;
+		} else if(slices < 2 || slices > 16) {
+			std::cerr << "Cannot beam race with " << beam_race_string << " slices; please pick between 2 and 16." << std::endl;
+		} else {
+			beam_race_slices = int(slices);
+		}
+	}
+
+	const bool low_latency = low_latency_argument != arguments.selections.end() || beam_race_slices > 1;
+	machine_runner.set_low_latency(low_latency);
+
 	// Check whether a 'logical' keyboard has been requested, or the machine would prefer one anyway.
 	const bool logical_keyboard =
 		(arguments.selections.find("logical-keyboard") != arguments.selections.end()) ||
@@ -860,14 +1572,39 @@ int main(int argc, char *argv[]) {
 			for(const auto &file_name: arguments.file_names) {
 				media += Analyser::Static::GetMedia(file_name);
 			}
-			media_target->insert_media(media);
+			media_target->insert_media(copy_on_write ? Analyser::Static::CopyOnWrite(media) : media);
 		}
 	}
 
-	// Attempt to set up video and audio.
-	if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-		std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-		return EXIT_FAILURE;
+	// Begin a bus trace if requested.
+	std::unique_ptr<CPU::BusTrace> bus_trace;
+	const auto bus_trace_argument = arguments.selections.find("bus-trace");
+	if(bus_trace_argument != arguments.selections.end()) {
+		const auto bus_traceable = machine->bus_traceable();
+		if(!bus_traceable) {
+			std::cerr << "Bus tracing is not supported by this machine." << std::endl;
+		} else {
+			try {
+				bus_trace = std::make_unique<CPU::BusTrace>(bus_trace_argument->second, bus_traceable->traced_bus());
+				bus_traceable->set_bus_trace(bus_trace.get());
+			} catch(Storage::FileHolder::Error) {
+				std::cerr << "Unable to open " << bus_trace_argument->second << " for bus tracing." << std::endl;
+			}
+		}
+	}
+	const auto end_bus_trace = [&] {
+		if(bus_trace) {
+			machine->bus_traceable()->set_bus_trace(nullptr);
+			bus_trace.reset();
+		}
+	};
+
+	// In headless mode, just run the machine for the requested period with no attempt
+	// at realtime presentation.
+	if(is_headless) {
+		const int result = run_headless(*machine, arguments);
+		end_bus_trace();
+		return result;
 	}
 
 	// Ask for no depth buffer, a core profile and vsync-aligned rendering.
@@ -899,18 +1636,65 @@ int main(int argc, char *argv[]) {
 	GLint target_framebuffer = 0;
 	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target_framebuffer);
 
+	// Permit linked shaders to be cached between runs, if the driver allows.
+	if(!cache_directory.empty()) {
+		Outputs::Display::OpenGL::Shader::set_program_cache_directory(cache_directory);
+	}
+
 	// Setup output, assuming a CRT machine for now, and prepare a best-effort updater.
 	Outputs::Display::OpenGL::ScanTarget scan_target(target_framebuffer);
 	std::unique_ptr<ActivityObserver> activity_observer;
 	bool uses_mouse;
 	std::vector<SDLJoystick> joysticks;
 
+	// Prepare to record audio and/or video if requested; the recorders themselves are created
+	// once output rates and sizes are known.
+	const auto recording_target = [&arguments](const char *name) -> std::string {
+		const auto argument = arguments.selections.find(name);
+		return argument == arguments.selections.end() ? "" : argument->second;
+	};
+	const std::string record_audio_target = recording_target("record-audio");
+	std::string record_video_target = recording_target("record-video");
+	std::unique_ptr<Outputs::Speaker::WAVWriter> audio_writer;
+	std::unique_ptr<Outputs::Display::VideoWriter> video_writer;
+	std::unique_ptr<Outputs::Display::OpenGL::FrameGrabber> frame_grabber;
+
+	// Serve runtime metrics if requested.
+	Machine::RuntimeMetrics runtime_metrics;
+	std::unique_ptr<Machine::MetricsServer> metrics_server;
+	const auto metrics_argument = arguments.selections.find("metrics");
+	if(metrics_argument != arguments.selections.end()) {
+		try {
+			const std::string instance = long_machine_name.empty() ? final_path_component(arguments.file_names.front()) : long_machine_name;
+			metrics_server = std::make_unique<Machine::MetricsServer>(metrics_argument->second, [&runtime_metrics, instance] {
+				return runtime_metrics.prometheus_text(instance);
+			});
+			runtime_metrics.set_display_metrics(&scan_target.display_metrics());
+			machine_runner.metrics = &runtime_metrics;
+			speaker_delegate.metrics = &runtime_metrics;
+		} catch(Machine::MetricsServer::Error) {
+			std::cerr << "Unable to serve metrics at " << metrics_argument->second << "." << std::endl;
+		}
+	}
+
+	// Skip frames only if every frame isn't going to be recorded.
+	FrameCountingScanTarget skipping_scan_target(&scan_target);
+	if(record_video_target.empty()) {
+		skipping_scan_target.set_frames_to_skip(frames_to_skip);
+	}
+
 	machine_runner.machine_mutex = &machine_mutex;
-	const auto setup_machine_input_output = [&scan_target, &machine, &speaker_delegate, &activity_observer, &joysticks, &uses_mouse, &machine_runner] {
+	const auto setup_machine_input_output = [&skipping_scan_target, &machine, &speaker_delegate, &activity_observer, &joysticks, &uses_mouse, &machine_runner, run_ahead_frames, &record_audio_target, &audio_writer] {
 		// Wire up the best-effort updater, its delegate, and the speaker delegate.
 		machine_runner.machine = machine.get();
+		int audio_output_rate = 0;
 
-		machine->scan_producer()->set_scan_target(&scan_target);
+		// Keep a rewind history if the machine is able to produce its state.
+		const auto state_producer = machine->state_producer();
+		machine_runner.rewinder = state_producer ?
+			std::make_unique<Machine::Rewinder>(*state_producer, MachineRunner::rewind_memory_budget) : nullptr;
+
+		machine->scan_producer()->set_scan_target(&skipping_scan_target);
 
 		// For now, lie about audio output intentions.
 		const auto audio_producer = machine->audio_producer();
@@ -931,10 +1715,24 @@ int main(int argc, char *argv[]) {
 
 				speaker_delegate.audio_device = SDL_OpenAudioDevice(nullptr, 0, &desired_audio_spec, &obtained_audio_spec, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
 
+				audio_output_rate = obtained_audio_spec.freq;
 				speaker->set_output_rate(obtained_audio_spec.freq, desired_audio_spec.samples, obtained_audio_spec.channels == 2);
 				speaker_delegate.is_stereo = obtained_audio_spec.channels == 2;
 				speaker->set_delegate(&speaker_delegate);
 				SDL_PauseAudioDevice(speaker_delegate.audio_device, 0);
+
+				// Audio is recorded only from the first machine, as a WAV can't change format midway.
+				speaker_delegate.set_recorder(nullptr);
+				if(audio_writer) {
+					audio_writer.reset();
+				} else if(!record_audio_target.empty()) {
+					try {
+						audio_writer = std::make_unique<Outputs::Speaker::WAVWriter>(record_audio_target, obtained_audio_spec.freq, speaker_delegate.is_stereo);
+						speaker_delegate.set_recorder(audio_writer.get());
+					} catch(Storage::FileHolder::Error) {
+						std::cerr << "Unable to open " << record_audio_target << " to record audio." << std::endl;
+					}
+				}
 			}
 		}
 
@@ -962,9 +1760,37 @@ int main(int argc, char *argv[]) {
 
 		// Keep a record of whether mouse events can be forwarded.
 		uses_mouse = !!machine->mouse_machine();
+
+		// Route via run-ahead if requested and possible.
+		if(run_ahead_frames && state_producer) {
+			machine_runner.run_ahead = std::make_unique<Machine::RunAhead>(
+				*machine,
+				&skipping_scan_target,
+				audio_output_rate ? &speaker_delegate : nullptr,
+				float(audio_output_rate),
+				speaker_delegate.is_stereo);
+			machine_runner.run_ahead->set_frames(run_ahead_frames);
+		} else {
+			if(run_ahead_frames) {
+				std::cerr << "Run-ahead is not supported by this machine." << std::endl;
+			}
+			machine_runner.run_ahead = nullptr;
+		}
 	};
 	setup_machine_input_output();
 
+	// Record input if requested; rewinding is disabled for the same reason as run-ahead.
+	std::unique_ptr<Machine::InputRecorder> input_recorder;
+	if(record_input) {
+		try {
+			input_recorder = std::make_unique<Machine::InputRecorder>(*machine, record_input_argument->second);
+			machine_runner.input_recorder = input_recorder.get();
+			machine_runner.rewinder = nullptr;
+		} catch(Storage::FileHolder::Error) {
+			std::cerr << "Unable to open " << record_input_argument->second << " to record input." << std::endl;
+		}
+	}
+
 	int window_width, window_height;
 	SDL_GetWindowSize(window, &window_width, &window_height);
 
@@ -983,27 +1809,146 @@ int main(int argc, char *argv[]) {
 	};
 	std::vector<KeyPress> keypresses;
 
+	// Screenshots are captured asynchronously, being requested by the event loop and then issued after the next draw.
+	Outputs::Display::OpenGL::AsyncScreenshots screenshots;
+	bool screenshot_requested = false;
+
+	// In low-latency mode, track vsync and the cost of drawing in order to predict the latest
+	// moment at which drawing can begin and still make the next vsync.
+	Time::VSyncPredictor vsync_predictor;
+	{
+		SDL_DisplayMode display_mode;
+		if(!SDL_GetWindowDisplayMode(window, &display_mode) && display_mode.refresh_rate) {
+			vsync_predictor.set_frame_rate(float(display_mode.refresh_rate));
+		}
+	}
+
 	// Run the main event loop until the OS tells us to quit.
 	bool should_quit = false;
 	Uint32 fullscreen_mode = 0;
 	machine_runner.start();
 	while(!should_quit) {
+		// If just-in-time presentation is enabled, sleep until the predicted latest start time.
+		if(just_in_time) {
+			const auto draw_time = vsync_predictor.suggested_draw_time();
+			const auto delay = draw_time - Time::nanos_now();
+			if(delay > 0 && delay < vsync_predictor.frame_duration()) {
+				std::this_thread::sleep_for(std::chrono::nanoseconds(delay));
+				vsync_predictor.add_timer_jitter(Time::nanos_now() - draw_time);
+			}
+		}
+
+		// In low-latency mode, bring the machine up to date immediately before drawing.
+		vsync_predictor.begin_redraw();
+		if(low_latency) {
+			machine_runner.catch_up();
+		}
+
 		// Draw a new frame, indicating completion of the draw to the machine runner.
 		scan_target.update(int(window_width), int(window_height));
 		scan_target.draw(int(window_width), int(window_height));
+
+		// Capture video if requested, sized upon the first frame to a 4:3 portion of the window
+		// and at the display's refresh rate, as every drawn frame is captured.
+		if(!record_video_target.empty() && !frame_grabber) {
+			GLint viewport[4];
+			glGetIntegerv(GL_VIEWPORT, viewport);
+
+			SDL_DisplayMode display_mode;
+			const int refresh_rate =
+				!SDL_GetWindowDisplayMode(window, &display_mode) && display_mode.refresh_rate ? display_mode.refresh_rate : 60;
+
+			try {
+				video_writer = std::make_unique<Outputs::Display::VideoWriter>(
+					record_video_target,
+					(int(viewport[3]) * 4) / 3, int(viewport[3]),
+					refresh_rate, 1,
+					video_format_for(record_video_target));
+				frame_grabber = std::make_unique<Outputs::Display::OpenGL::FrameGrabber>(*video_writer);
+			} catch(Storage::FileHolder::Error) {
+				std::cerr << "Unable to open " << record_video_target << " to record video." << std::endl;
+				record_video_target.clear();
+			}
+		}
+		if(frame_grabber) frame_grabber->capture();
+
+		// Similarly capture and save a screenshot if requested, asynchronously so as not to hitch.
+		if(screenshot_requested) {
+			screenshot_requested = false;
+			screenshots.request(4, 3, [](Outputs::Display::OpenGL::Screenshot &&screenshot) {
+				// Pick the directory for images. Try `xdg-user-dir PICTURES` first.
+				std::string target_directory = system_get("xdg-user-dir PICTURES");
+
+				// Make sure there are no newlines.
+				target_directory.erase(std::remove(target_directory.begin(), target_directory.end(), '\n'), target_directory.end());
+				target_directory.erase(std::remove(target_directory.begin(), target_directory.end(), '\r'), target_directory.end());
+
+				// Fall back on the HOME directory if necessary.
+				if(target_directory.empty()) target_directory = getenv("HOME");
+
+				// Find the first available name of the form ~/clk-screenshot-<number>.bmp.
+				size_t index = 0;
+				std::string target;
+				while(true) {
+					target = target_directory + "/clk-screenshot-" + std::to_string(index) + ".bmp";
+
+					struct stat file_stats;
+					if(stat(target.c_str(), &file_stats))
+						break;
+
+					++index;
+				}
+
+				// Create a suitable SDL surface and save the thing.
+				save_screenshot(screenshot.pixel_data.data(), screenshot.width, screenshot.height, target);
+			});
+		}
+		screenshots.update();
+
 		if(activity_observer) activity_observer->draw();
 		machine_runner.signal_did_draw();
+		vsync_predictor.end_redraw();
 
 		// Wait for presentation of that frame, posting a vsync.
 		SDL_GL_SwapWindow(window);
 		machine_runner.signal_vsync();
+		vsync_predictor.announce_vsync();
+
+		// If beam racing, present the remaining slices of this frame without waiting for vsync,
+		// timing each so that it is complete just before the host raster reaches the top of its slice.
+		// The resulting tear is then always at or just above the raster, i.e. invisible.
+		if(beam_race_slices > 1) {
+			SDL_GL_SetSwapInterval(0);
+			for(int slice = 1; slice < beam_race_slices; ++slice) {
+				const auto frame_duration = vsync_predictor.frame_duration();
+				const auto slice_time =
+					vsync_predictor.suggested_draw_time() - frame_duration + (frame_duration * slice) / beam_race_slices;
+				const auto delay = slice_time - Time::nanos_now();
+				if(delay > 0) {
+					std::this_thread::sleep_for(std::chrono::nanoseconds(delay));
+				}
+
+				machine_runner.catch_up();
+				scan_target.update(int(window_width), int(window_height));
 
-		// NB: machine_mutex is *not* currently locked, therefore it shouldn't
-		// be 'most' of the time — assuming most of the time is spent waiting
-		// on vsync, anyway.
+				// If the machine's output hasn't yet reached this slice then everything new is above the
+				// host raster and won't be seen until the next full frame; skip this slice.
+				if(scan_target.raster_position() * float(beam_race_slices) < float(slice)) {
+					continue;
+				}
 
-		// Grab the machine lock and process all pending events.
-		std::lock_guard lock_guard(machine_mutex);
+				scan_target.draw(int(window_width), int(window_height));
+				if(activity_observer) activity_observer->draw();
+				SDL_GL_SwapWindow(window);
+			}
+			SDL_GL_SetSwapInterval(1);
+		}
+
+		// NB: machine_mutex is *not* currently locked, and is taken below only for those few
+		// events that can't be posted to the machine runner's input queue; so processing
+		// input never waits for the machine to finish running.
+
+		// Process all pending events.
 		const auto keyboard_machine = machine->keyboard_machine();
 		SDL_Event event;
 		while(SDL_PollEvent(&event)) {
@@ -1025,22 +1970,40 @@ int main(int argc, char *argv[]) {
 				break;
 
 				case SDL_DROPFILE: {
+					std::lock_guard lock_guard(machine_mutex);
 					const Analyser::Static::Media media = Analyser::Static::GetMedia(event.drop.file);
 
 					// If the new file is only media, insert it; if it is a state snapshot then
 					// tear down the entire machine and replace it.
 					if(!media.empty()) {
-						machine->media_target()->insert_media(media);
+						if(input_recorder) {
+							input_recorder->insert_media(event.drop.file, Analyser::Static::CopyOnWrite(media));
+						} else {
+							machine->media_target()->insert_media(copy_on_write ? Analyser::Static::CopyOnWrite(media) : media);
+						}
 						break;
 					}
 
 					targets = Analyser::Static::GetTargets(event.drop.file);
 					if(targets.empty()) break;
+					if(copy_on_write) {
+						for(auto &target: targets) {
+							target->media = Analyser::Static::CopyOnWrite(target->media);
+						}
+					}
 
 					::Machine::Error error;
 					std::unique_ptr<::Machine::DynamicMachine> new_machine(::Machine::MachineForTargets(targets, rom_fetcher, error));
 					if(error != Machine::Error::None) break;
 
+					if(input_recorder) {
+						std::cerr << "Input recording ended as the machine was replaced." << std::endl;
+						machine_runner.input_recorder = nullptr;
+						input_recorder.reset();
+					}
+
+					machine_runner.input_queue.discard();
+					machine_runner.run_ahead = nullptr;
 					machine = std::move(new_machine);
 					static_cast<Outputs::Display::ScanTarget *>(&scan_target)->will_change_owner();
 					setup_machine_input_output();
@@ -1057,11 +2020,22 @@ int main(int argc, char *argv[]) {
 						// Syphon off the key-press if it's control+shift+V (paste).
 						if(event.key.keysym.sym == SDLK_v && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
 							if(keyboard_machine) {
-								keyboard_machine->type_string(SDL_GetClipboardText());
+								std::lock_guard lock_guard(machine_mutex);
+								if(input_recorder) {
+									input_recorder->type_string(SDL_GetClipboardText());
+								} else {
+									keyboard_machine->type_string(SDL_GetClipboardText());
+								}
 								break;
 							}
 						}
 
+						// Hold ctrl+shift+r to rewind.
+						if(event.key.keysym.sym == SDLK_r && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
+							machine_runner.is_rewinding = !input_recorder;
+							break;
+						}
+
 						// Use ctrl+escape to release the mouse (if captured).
 						if(event.key.keysym.sym == SDLK_ESCAPE && (SDL_GetModState()&KMOD_CTRL)) {
 							SDL_SetRelativeMouseMode(SDL_FALSE);
@@ -1070,49 +2044,18 @@ int main(int argc, char *argv[]) {
 
 						// Capture ctrl+shift+d as a take-a-screenshot command.
 						if(event.key.keysym.sym == SDLK_d && (SDL_GetModState()&KMOD_CTRL) && (SDL_GetModState()&KMOD_SHIFT)) {
-							// Grab the screen buffer.
-							Outputs::Display::OpenGL::Screenshot screenshot(4, 3);
-
-							// Pick the directory for images. Try `xdg-user-dir PICTURES` first.
-							std::string target_directory = system_get("xdg-user-dir PICTURES");
-
-							// Make sure there are no newlines.
-							target_directory.erase(std::remove(target_directory.begin(), target_directory.end(), '\n'), target_directory.end());
-							target_directory.erase(std::remove(target_directory.begin(), target_directory.end(), '\r'), target_directory.end());
-
-							// Fall back on the HOME directory if necessary.
-							if(target_directory.empty()) target_directory = getenv("HOME");
-
-							// Find the first available name of the form ~/clk-screenshot-<number>.bmp.
-							size_t index = 0;
-							std::string target;
-							while(true) {
-								target = target_directory + "/clk-screenshot-" + std::to_string(index) + ".bmp";
-
-								struct stat file_stats;
-								if(stat(target.c_str(), &file_stats))
-									break;
-
-								++index;
-							}
-
-							// Create a suitable SDL surface and save the thing.
-							const bool is_big_endian = SDL_BYTEORDER == SDL_BIG_ENDIAN;
-							SDL_Surface *const surface = SDL_CreateRGBSurfaceFrom(
-								screenshot.pixel_data.data(),
-								screenshot.width, screenshot.height,
-								8*4,
-								screenshot.width*4,
-								is_big_endian ? 0xff000000 : 0x000000ff,
-								is_big_endian ? 0x00ff0000 : 0x0000ff00,
-								is_big_endian ? 0x0000ff00 : 0x00ff0000,
-								0);
-							SDL_SaveBMP(surface, target.c_str());
-							SDL_FreeSurface(surface);
+							// Request a capture after the next draw; it'll be saved when available.
+							screenshot_requested = true;
 							break;
 						}
 					}
 
+					// End any rewind upon release of r.
+					if(event.type == SDL_KEYUP && event.key.keysym.sym == SDLK_r && machine_runner.is_rewinding) {
+						machine_runner.is_rewinding = false;
+						break;
+					}
+
 					// Syphon off alt+enter (toggle full-screen) upon key up only; this was previously a key down action,
 					// but the SDL_KEYDOWN announcement was found to be reposted after changing graphics mode on some
 					// systems, causing a loop of changes, so key up is safer.
@@ -1122,10 +2065,7 @@ int main(int argc, char *argv[]) {
 						SDL_ShowCursor((fullscreen_mode&SDL_WINDOW_FULLSCREEN_DESKTOP) ? SDL_DISABLE : SDL_ENABLE);
 
 						// Announce a potential discontinuity in keyboard input.
-						const auto keyboard_machine = machine->keyboard_machine();
-						if(keyboard_machine) {
-							keyboard_machine->get_keyboard().reset_all_keys();
-						}
+						machine_runner.input_queue.reset_all_keys();
 						break;
 					}
 
@@ -1142,18 +2082,14 @@ int main(int argc, char *argv[]) {
 
 					const auto mouse_machine = machine->mouse_machine();
 					if(mouse_machine) {
-						mouse_machine->get_mouse().set_button_pressed(
-							event.button.button % mouse_machine->get_mouse().get_number_of_buttons(),
-							event.type == SDL_MOUSEBUTTONDOWN);
+						const int button = event.button.button % mouse_machine->get_mouse().get_number_of_buttons();
+						machine_runner.input_queue.set_mouse_button_pressed(button, event.type == SDL_MOUSEBUTTONDOWN);
 					}
 				} break;
 
 				case SDL_MOUSEMOTION: {
 					if(SDL_GetRelativeMouseMode()) {
-						const auto mouse_machine = machine->mouse_machine();
-						if(mouse_machine) {
-							mouse_machine->get_mouse().move(event.motion.xrel, event.motion.yrel);
-						}
+						machine_runner.input_queue.move_mouse(event.motion.xrel, event.motion.yrel);
 					}
 				} break;
 
@@ -1203,53 +2139,55 @@ int main(int argc, char *argv[]) {
 			}
 		}
 
-		// Handle accumulated key states.
+		// Joystick inputs are posted to the machine runner, like all others.
 		const auto joystick_machine = machine->joystick_machine();
+		const auto set_joystick_input = [&](size_t joystick, const Inputs::Joystick::Input &input, auto value) {
+			machine_runner.input_queue.set_joystick_input(joystick, input, value);
+		};
+
+		// Handle accumulated key states.
 		for (const auto &keypress: logical_keyboard ? matched_keypresses : keypresses) {
-			// Try to set this key on the keyboard first, if there is one.
-			if(keyboard_machine) {
-				Inputs::Keyboard::Key key = Inputs::Keyboard::Key::Space;
-				if(KeyboardKeyForSDLScancode(keypress.scancode, key)) {
-					// In principle there's no need for a conditional here; in practice logical_keyboard mode
-					// is sufficiently untested on SDL, and somewhat too reliant on empirical timestamp behaviour,
-					// for it to be trustworthy enough otherwise to expose.
-					if(logical_keyboard) {
-						if(keyboard_machine->apply_key(key, keypress.input.size() ? keypress.input[0] : 0, keypress.is_down, logical_keyboard)) {
-							continue;
-						}
-					} else {
-						// This is a slightly terrible way of obtaining a symbol for the key, e.g. for letters it will always return
-						// the capital letter version, at least empirically. But it'll have to do for now.
-						const char *key_name = SDL_GetKeyName(keypress.keycode);
-						if(keyboard_machine->get_keyboard().set_key_pressed(key, (strlen(key_name) == 1) ? key_name[0] : 0, keypress.is_down)) {
-							continue;
+			// Determine the joystick input, if any, that this key should produce if the keyboard doesn't handle it.
+			std::optional<Inputs::Joystick::Input> joystick_input;
+			if(joystick_machine && !joystick_machine->get_joysticks().empty()) {
+				switch(keypress.scancode) {
+					case SDL_SCANCODE_LEFT:		joystick_input.emplace(Inputs::Joystick::Input::Left);		break;
+					case SDL_SCANCODE_RIGHT:	joystick_input.emplace(Inputs::Joystick::Input::Right);		break;
+					case SDL_SCANCODE_UP:		joystick_input.emplace(Inputs::Joystick::Input::Up);		break;
+					case SDL_SCANCODE_DOWN:		joystick_input.emplace(Inputs::Joystick::Input::Down);		break;
+					case SDL_SCANCODE_SPACE:	joystick_input.emplace(Inputs::Joystick::Input::Fire);		break;
+					case SDL_SCANCODE_A:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 0);	break;
+					case SDL_SCANCODE_S:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 1);	break;
+					case SDL_SCANCODE_D:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 2);	break;
+					case SDL_SCANCODE_F:		joystick_input.emplace(Inputs::Joystick::Input::Fire, 3);	break;
+					default: {
+						if(keypress.input.size()) {
+							joystick_input.emplace(wchar_t(keypress.input[0]));
 						}
-					}
+					} break;
 				}
 			}
-
-			// Having failed that, try converting it into a joystick action.
-			if(joystick_machine) {
-				auto &joysticks = joystick_machine->get_joysticks();
-				if(!joysticks.empty()) {
-					const bool is_pressed = keypress.is_down;
-					switch(keypress.scancode) {
-						case SDL_SCANCODE_LEFT:		joysticks[0]->set_input(Inputs::Joystick::Input::Left, is_pressed);		break;
-						case SDL_SCANCODE_RIGHT:	joysticks[0]->set_input(Inputs::Joystick::Input::Right, is_pressed);	break;
-						case SDL_SCANCODE_UP:		joysticks[0]->set_input(Inputs::Joystick::Input::Up, is_pressed);		break;
-						case SDL_SCANCODE_DOWN:		joysticks[0]->set_input(Inputs::Joystick::Input::Down, is_pressed);		break;
-						case SDL_SCANCODE_SPACE:	joysticks[0]->set_input(Inputs::Joystick::Input::Fire, is_pressed);		break;
-						case SDL_SCANCODE_A:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 0), is_pressed);	break;
-						case SDL_SCANCODE_S:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 1), is_pressed);	break;
-						case SDL_SCANCODE_D:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 2), is_pressed);	break;
-						case SDL_SCANCODE_F:		joysticks[0]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Fire, 3), is_pressed);	break;
-						default: {
-							if(keypress.input.size()) {
-								joysticks[0]->set_input(Inputs::Joystick::Input(keypress.input[0]), is_pressed);
-							}
-						} break;
-					}
+			const Inputs::Joystick::Input *const joystick_fallback = joystick_input ? &*joystick_input : nullptr;
+
+			// Try to set this key on the keyboard first, if there is one; the joystick input is applied
+			// by the machine runner if that fails.
+			Inputs::Keyboard::Key key = Inputs::Keyboard::Key::Space;
+			if(keyboard_machine && KeyboardKeyForSDLScancode(keypress.scancode, key)) {
+				// In principle there's no need for a conditional here; in practice logical_keyboard mode
+				// is sufficiently untested on SDL, and somewhat too reliant on empirical timestamp behaviour,
+				// for it to be trustworthy enough otherwise to expose.
+				if(logical_keyboard) {
+					const char symbol = keypress.input.size() ? keypress.input[0] : 0;
+					machine_runner.input_queue.apply_key(key, symbol, keypress.is_down, logical_keyboard, joystick_fallback);
+				} else {
+					// This is a slightly terrible way of obtaining a symbol for the key, e.g. for letters it will always return
+					// the capital letter version, at least empirically. But it'll have to do for now.
+					const char *key_name = SDL_GetKeyName(keypress.keycode);
+					const char symbol = (strlen(key_name) == 1) ? key_name[0] : 0;
+					machine_runner.input_queue.set_key_pressed(key, symbol, keypress.is_down, joystick_fallback);
 				}
+			} else if(joystick_fallback) {
+				set_joystick_input(0, *joystick_fallback, keypress.is_down);
 			}
 		}
 		keypresses.clear();
@@ -1266,8 +2204,8 @@ int main(int argc, char *argv[]) {
 				if(!joysticks[c].hat_values()) {
 					const float x_axis = float(SDL_JoystickGetAxis(joysticks[c].get(), 0) + 32768) / 65535.0f;
 					const float y_axis = float(SDL_JoystickGetAxis(joysticks[c].get(), 1) + 32768) / 65535.0f;
-					machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Horizontal), x_axis);
-					machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Vertical), y_axis);
+					set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Horizontal), x_axis);
+					set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Vertical), y_axis);
 				}
 
 				// Forward hats as directions; hats always override analogue inputs.
@@ -1278,23 +2216,23 @@ int main(int argc, char *argv[]) {
 					joysticks[c].last_hat_value(hat) = hat_value;
 
 					if(changes & SDL_HAT_UP) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Up), !!(hat_value & SDL_HAT_UP));
+						set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Up), !!(hat_value & SDL_HAT_UP));
 					}
 					if(changes & SDL_HAT_DOWN) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Down), !!(hat_value & SDL_HAT_DOWN));
+						set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Down), !!(hat_value & SDL_HAT_DOWN));
 					}
 					if(changes & SDL_HAT_LEFT) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Left), !!(hat_value & SDL_HAT_LEFT));
+						set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Left), !!(hat_value & SDL_HAT_LEFT));
 					}
 					if(changes & SDL_HAT_RIGHT) {
-						machine_joysticks[target]->set_input(Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Right), !!(hat_value & SDL_HAT_RIGHT));
+						set_joystick_input(target, Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Right), !!(hat_value & SDL_HAT_RIGHT));
 					}
 				}
 
 				// Forward all fire buttons, retaining their original indices.
 				const int number_of_buttons = SDL_JoystickNumButtons(joysticks[c].get());
 				for(int button = 0; button < number_of_buttons; ++button) {
-					machine_joysticks[target]->set_input(
+					set_joystick_input(target,
 						Inputs::Joystick::Input(Inputs::Joystick::Input::Type::Fire, button),
 						SDL_JoystickGetButton(joysticks[c].get(), button) ? true : false);
 				}
@@ -1304,7 +2242,21 @@ int main(int argc, char *argv[]) {
 
 	// Clean up.
 	machine_runner.stop();	// Ensure no further updates will occur.
+	end_bus_trace();
 	joysticks.clear();
+
+	if(frame_grabber) {
+		frame_grabber->flush();
+		frame_grabber.reset();
+	}
+	video_writer.reset();
+	speaker_delegate.set_recorder(nullptr);
+	audio_writer.reset();
+
+	if(arguments.selections.find("profile") != arguments.selections.end()) {
+		print_profile(*machine);
+	}
+
 	SDL_DestroyWindow( window );
 	SDL_Quit();
 
@@ -8,6 +8,8 @@
 
 #include "CRT.hpp"
 
+#include "../../ClockReceiver/Profiler.hpp"
+
 #include <cstdarg>
 #include <cmath>
 #include <algorithm>
@@ -71,6 +73,12 @@ void CRT::set_scan_target(Outputs::Display::ScanTarget *scan_target) {
 	scan_target_ = scan_target;
 	if(!scan_target_) scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 	scan_target_->set_modals(scan_target_modals_);
+	if(!palette_.empty()) scan_target_->set_palette(palette_.data(), palette_.size());
+}
+
+void CRT::set_palette(const uint32_t *palette, size_t length) {
+	palette_.assign(palette, palette + length);
+	scan_target_->set_palette(palette, length);
 }
 
 void CRT::set_new_data_type(Outputs::Display::InputDataType data_type) {
@@ -194,7 +202,7 @@ Outputs::Display::ScanTarget::Scan::EndPoint CRT::end_point(uint16_t data_offset
 	// out during times of resync.
 	end_point.x = uint16_t(std::min(horizontal_flywheel_->get_current_output_position(), 65535));
 	end_point.y = uint16_t(std::min(vertical_flywheel_->get_current_output_position() / vertical_flywheel_output_divider_, 65535));
-	end_point.data_offset = data_offset;
+	end_point.data_offset = uint16_t(data_base_ + data_offset);
 
 	// Ensure .composite_angle is sampled at the location indicated by .cycles_since_end_of_horizontal_retrace.
 	// TODO: I could supply time_multiplier_ as a modal and just not round .cycles_since_end_of_horizontal_retrace. Would that be better?
@@ -313,6 +321,7 @@ void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_
 
 void CRT::output_scan(const Scan *const scan) {
 	assert(scan->number_of_cycles >= 0);
+	Profiling::Scope<CRT> profiling_scope(scan->number_of_cycles);
 
 	// Simplified colour burst logic: if it's within the back porch we'll take it.
 	if(scan->type == Scan::Type::ColourBurst) {
@@ -442,6 +451,69 @@ void CRT::output_data(int number_of_cycles, size_t number_of_samples) {
 	output_scan(&scan);
 }
 
+void CRT::output_segments(const Segment *const segments, size_t count) {
+	// Declare all data as having been written at once.
+	size_t level_samples = 0, data_samples = 0;
+	for(size_t c = 0; c < count; c++) {
+		switch(segments[c].type) {
+			default: break;
+			case Segment::Type::Level:	++level_samples;										break;
+			case Segment::Type::Data:	data_samples += size_t(segments[c].number_of_samples);	break;
+		}
+	}
+	if(level_samples + data_samples) {
+#ifndef NDEBUG
+		if(data_samples) {
+			assert(level_samples + data_samples <= allocated_data_length_);
+			allocated_data_length_ = std::numeric_limits<size_t>::min();
+		}
+#endif
+		scan_target_->end_data(level_samples + data_samples);
+	}
+
+	size_t c = 0;
+	while(c < count) {
+		const Segment &segment = segments[c];
+		++c;
+
+		Scan scan;
+		scan.number_of_cycles = segment.number_of_cycles;
+		switch(segment.type) {
+			case Segment::Type::Sync:
+			case Segment::Type::Blank:
+				scan.type = segment.type == Segment::Type::Sync ? Scan::Type::Sync : Scan::Type::Blank;
+				while(c < count && segments[c].type == segment.type) {
+					scan.number_of_cycles += segments[c].number_of_cycles;
+					++c;
+				}
+			break;
+
+			case Segment::Type::Level:
+				scan.type = Scan::Type::Level;
+				scan.number_of_samples = 1;
+			break;
+
+			case Segment::Type::Data:
+				scan.type = Scan::Type::Data;
+				scan.number_of_samples = segment.number_of_samples;
+			break;
+
+			case Segment::Type::ColourBurst:
+				output_colour_burst(segment.number_of_cycles, segment.phase, segment.is_alternate_line, segment.amplitude);
+			continue;
+
+			case Segment::Type::DefaultColourBurst:
+				output_default_colour_burst(segment.number_of_cycles, segment.amplitude);
+			continue;
+		}
+
+		output_scan(&scan);
+		data_base_ += scan.number_of_samples;
+	}
+
+	data_base_ = 0;
+}
+
 // MARK: - Getters.
 
 Outputs::Display::Rect CRT::get_rect_for_area(int first_line_after_sync, int number_of_lines, int first_cycle_after_sync, int number_of_cycles, float aspect_ratio) const {
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "../ScanTarget.hpp"
 #include "Internals/Flywheel.hpp"
@@ -46,6 +47,10 @@ class CRT {
 		int cycles_since_horizontal_sync_ = 0;
 		Display::ScanTarget::Scan::EndPoint end_point(uint16_t data_offset);
 
+		// The offset of the current scan's first sample within the current data allocation; this is
+		// non-zero only during output_segments.
+		int data_base_ = 0;
+
 		struct Scan {
 			enum Type {
 				Sync, Level, Data, Blank, ColourBurst
@@ -81,6 +86,7 @@ class CRT {
 
 		Outputs::Display::ScanTarget *scan_target_ = &Outputs::Display::NullScanTarget::singleton;
 		Outputs::Display::ScanTarget::Modals scan_target_modals_;
+		std::vector<uint32_t> palette_;
 		static constexpr uint8_t DefaultAmplitude = 41;	// Based upon a black level to maximum excursion and positive burst peak of: NTSC: 882 & 143; PAL: 933 & 150.
 
 #ifndef NDEBUG
@@ -215,6 +221,33 @@ class CRT {
 		*/
 		void output_default_colour_burst(int number_of_cycles, uint8_t amplitude = DefaultAmplitude);
 
+		/*! Describes a single period of output for @c output_segments. */
+		struct Segment {
+			enum class Type {
+				Sync, Blank, Level, Data, ColourBurst, DefaultColourBurst
+			} type = Type::Blank;
+			int number_of_cycles = 0;
+
+			/// For Data segments, the number of samples to output; Level segments always use exactly one.
+			int number_of_samples = 0;
+
+			/// For colour bursts, as per the equivalent arguments to @c output_colour_burst; @c phase and
+			/// @c is_alternate_line are ignored for DefaultColourBurst segments.
+			uint8_t phase = 0;
+			bool is_alternate_line = false;
+			uint8_t amplitude = DefaultAmplitude;
+		};
+
+		/*!	Outputs @c count segments in order, with the same effect as a call to the equivalent output
+			method for each.
+
+			Samples for all Level and Data segments are taken consecutively from the single area most
+			recently allocated via @c begin_data, rather than from one allocation per segment. Adjacent
+			sync and blank segments are combined, so that a run of many small periods costs no more than a
+			single long one.
+		*/
+		void output_segments(const Segment *segments, size_t count);
+
 		/*! Sets the current phase of the colour subcarrier used by output_default_colour_burst.
 
 			@param phase The normalised instantaneous phase. 0.0f is the start of a colour cycle, 1.0f is the
@@ -245,6 +278,13 @@ class CRT {
 			return result;
 		}
 
+		/*!	@returns @c true if the scan target is discarding all data, in which case @c begin_data will return
+			@c nullptr and the caller may skip any work that serves only to produce pixels.
+		*/
+		inline bool is_discarding_data() const {
+			return scan_target_->is_discarding_data();
+		}
+
 		/*!	Sets the gamma exponent for the simulated screen. */
 		void set_input_gamma(float gamma);
 
@@ -305,6 +345,13 @@ class CRT {
 		/*! Sets the input data type. */
 		void set_input_data_type(Outputs::Display::InputDataType);
 
+		/*!
+			Sets the palette against which subsequent Palette8 data will be interpreted; @c length should be
+			at most Outputs::Display::ScanTarget::PaletteSize. The palette is retained so that it can be
+			resupplied upon any change of scan target.
+		*/
+		void set_palette(const uint32_t *palette, size_t length);
+
 		/*! Sets the output brightness. */
 		void set_brightness(float);
 };
@@ -21,6 +21,7 @@ void Metrics::announce_event(ScanTarget::Event event) {
 		break;
 		case ScanTarget::Event::BeginVerticalRetrace:
 			add_line_total(lines_this_frame_);
+			total_frames_produced_.fetch_add(1, std::memory_order_relaxed);
 		break;
 		case ScanTarget::Event::EndVerticalRetrace:
 			lines_this_frame_ = 0;
@@ -53,8 +54,10 @@ void Metrics::announce_did_resize() {
 void Metrics::announce_draw_status(bool complete) {
 	if(!complete) {
 		++frames_missed_;
+		total_frames_missed_.fetch_add(1, std::memory_order_relaxed);
 	} else {
 		++frames_hit_;
+		total_frames_drawn_.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	// Don't allow the record of history to extend too far into the past.
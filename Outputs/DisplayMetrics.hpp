@@ -14,6 +14,7 @@
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 
 namespace Outputs {
 namespace Display {
@@ -46,6 +47,19 @@ class Metrics {
 		/// @returns The number of lines since vertical retrace ended.
 		int current_line() const;
 
+		/// @returns The total number of frames announced via BeginVerticalRetrace.
+		uint64_t total_frames_produced() const {
+			return total_frames_produced_;
+		}
+
+		/// @returns The total numbers of draws reported as complete and as incomplete via @c announce_draw_status.
+		uint64_t total_frames_drawn() const {
+			return total_frames_drawn_;
+		}
+		uint64_t total_frames_missed() const {
+			return total_frames_missed_;
+		}
+
 	private:
 		int lines_this_frame_ = 0;
 		std::array<int, 20> line_total_history_;
@@ -54,6 +68,11 @@ class Metrics {
 
 		std::atomic<int> frames_hit_ = 0;
 		std::atomic<int> frames_missed_ = 0;
+
+		// Totals since construction, unaffected by resizes or the rolling window above.
+		std::atomic<uint64_t> total_frames_produced_ = 0;
+		std::atomic<uint64_t> total_frames_drawn_ = 0;
+		std::atomic<uint64_t> total_frames_missed_ = 0;
 };
 
 }
@@ -0,0 +1,151 @@
+//
+//  FrameHasher.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "FrameHasher.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+
+using namespace Outputs::Display;
+
+namespace {
+
+constexpr uint64_t Offset = 0xcbf29ce484222325;
+constexpr uint64_t Multiplier = 0x9e3779b97f4a7c15;
+
+/// Folds @c length bytes from @c data into @c hash, reading words as little endian so that
+/// results are identical on all hosts.
+uint64_t hash(uint64_t hash, const uint8_t *data, size_t length) {
+	while(length >= 8) {
+		uint64_t word = 0;
+		for(int c = 7; c >= 0; --c) {
+			word = (word << 8) | data[c];
+		}
+		hash = (hash ^ word) * Multiplier;
+		hash ^= hash >> 29;
+		data += 8;
+		length -= 8;
+	}
+	while(length--) {
+		hash = (hash ^ *data) * Multiplier;
+		++data;
+	}
+	return hash;
+}
+
+uint64_t hash(uint64_t hash, uint64_t value) {
+	hash = (hash ^ value) * Multiplier;
+	return hash ^ (hash >> 29);
+}
+
+}
+
+FrameHasher::FrameHasher(const std::string &file_name, ScanTarget *target) :
+	file_(file_name, Storage::FileHolder::FileMode::Rewrite),
+	target_(target) {
+	reset_hashes();
+}
+
+void FrameHasher::reset_hashes() {
+	video_hash_ = audio_hash_ = Offset;
+}
+
+// MARK: - Video.
+
+void FrameHasher::set_modals(Modals modals) {
+	data_type_size_ = size_for_data_type(modals.input_data_type);
+	if(target_) target_->set_modals(modals);
+}
+
+void FrameHasher::set_palette(const uint32_t *palette, size_t length) {
+	for(size_t c = 0; c < length; ++c) {
+		video_hash_ = hash(video_hash_, palette[c]);
+	}
+	if(target_) target_->set_palette(palette, length);
+}
+
+ScanTarget::Scan *FrameHasher::begin_scan() {
+	scan_ = target_ ? target_->begin_scan() : nullptr;
+	if(scan_) return scan_;
+
+	// Substitute a scan if the target didn't supply one, and forget it upon completion.
+	substitute_scan_ = Scan();
+	return &substitute_scan_;
+}
+
+void FrameHasher::end_scan() {
+	const Scan &scan = scan_ ? *scan_ : substitute_scan_;
+	for(const auto &end_point: scan.end_points) {
+		video_hash_ = hash(video_hash_,
+			uint64_t(end_point.x) |
+			(uint64_t(end_point.y) << 16) |
+			(uint64_t(end_point.data_offset) << 32) |
+			(uint64_t(end_point.cycles_since_end_of_horizontal_retrace) << 48));
+		video_hash_ = hash(video_hash_, uint16_t(end_point.composite_angle));
+	}
+	video_hash_ = hash(video_hash_, scan.composite_amplitude);
+
+	if(scan_) target_->end_scan();
+	scan_ = nullptr;
+}
+
+uint8_t *FrameHasher::begin_data(size_t required_length, size_t required_alignment) {
+	data_ = target_ ? target_->begin_data(required_length, required_alignment) : nullptr;
+	data_is_forwarded_ = data_;
+	if(data_) return data_;
+
+	// Supply suitably-aligned substitute storage.
+	const size_t required_size = required_length * data_type_size_ + required_alignment;
+	if(substitute_data_.size() < required_size) {
+		substitute_data_.resize(required_size);
+	}
+	const uintptr_t address = reinterpret_cast<uintptr_t>(substitute_data_.data());
+	data_ = substitute_data_.data() + (required_alignment - address % required_alignment) % required_alignment;
+	return data_;
+}
+
+void FrameHasher::end_data(size_t actual_length) {
+	if(data_) {
+		video_hash_ = hash(video_hash_, data_, actual_length * data_type_size_);
+		data_ = nullptr;
+	}
+	if(data_is_forwarded_) target_->end_data(actual_length);
+}
+
+void FrameHasher::will_change_owner() {
+	if(target_) target_->will_change_owner();
+}
+
+void FrameHasher::submit() {
+	if(target_) target_->submit();
+}
+
+void FrameHasher::announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) {
+	if(event == Event::BeginVerticalRetrace) {
+		char line[64];
+		const int length = snprintf(line, sizeof(line), "%" PRIu64 " %016" PRIx64 " %016" PRIx64 "\n", frame_, video_hash_, audio_hash_);
+		file_.write(reinterpret_cast<const uint8_t *>(line), size_t(length));
+
+		++frame_;
+		reset_hashes();
+	}
+	if(target_) target_->announce(event, is_visible, location, composite_amplitude);
+}
+
+// MARK: - Audio.
+
+void FrameHasher::speaker_did_complete_samples(Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) {
+	for(const auto sample: buffer) {
+		audio_hash_ = hash(audio_hash_, uint16_t(sample));
+	}
+	if(audio_delegate_) audio_delegate_->speaker_did_complete_samples(speaker, buffer);
+}
+
+void FrameHasher::speaker_did_change_input_clock(Speaker::Speaker *speaker) {
+	if(audio_delegate_) audio_delegate_->speaker_did_change_input_clock(speaker);
+}
@@ -0,0 +1,95 @@
+//
+//  FrameHasher.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef FrameHasher_hpp
+#define FrameHasher_hpp
+
+#include "ScanTarget.hpp"
+#include "Speaker/Speaker.hpp"
+#include "../Storage/FileHolder.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Sits between a machine and its scan target and speaker delegate, writing a 64-bit hash of
+	each frame's video and audio to a file, for cheap comparison of one run against another.
+
+	Video is hashed as the machine supplies it, prior to any rasterisation: pixel data, scan
+	positions and palettes are all included. Hashes are therefore independent of the host and of
+	whatever target, if any, the output is forwarded to. Audio is hashed as each packet of samples
+	is delivered, and attributed to the frame during which it arrived.
+
+	Pixel data is always requested from the machine, even if the target would otherwise discard it.
+	Where the target declines to allocate a scan or data, this class substitutes its own storage.
+
+	Output is text, with one line per completed frame: the frame number in decimal, then the
+	video and audio hashes as sixteen hexadecimal digits, all separated by spaces. Frames end at
+	the start of each vertical retrace.
+*/
+class FrameHasher: public ScanTarget, public Speaker::Speaker::Delegate {
+	public:
+		/*!
+			Opens @c file_name for writing.
+
+			@param target The scan target to forward video to, if any.
+			@throws Storage::FileHolder::Error if the file could not be opened.
+		*/
+		FrameHasher(const std::string &file_name, ScanTarget *target = nullptr);
+
+		/// Sets a delegate to which all audio will be forwarded after hashing.
+		void set_audio_delegate(Speaker::Speaker::Delegate *delegate) {
+			audio_delegate_ = delegate;
+		}
+
+		/// @returns The number of frames hashed so far.
+		uint64_t frames() const {
+			return frame_;
+		}
+
+		// ScanTarget overrides.
+		void set_modals(Modals) final;
+		void set_palette(const uint32_t *palette, size_t length) final;
+		Scan *begin_scan() final;
+		void end_scan() final;
+		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
+		void end_data(size_t actual_length) final;
+		void will_change_owner() final;
+		void submit() final;
+		void announce(Event event, bool is_visible, const Scan::EndPoint &location, uint8_t composite_amplitude) final;
+
+		// Speaker::Delegate overrides.
+		void speaker_did_complete_samples(Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final;
+		void speaker_did_change_input_clock(Speaker::Speaker *speaker) final;
+
+	private:
+		Storage::FileHolder file_;
+		ScanTarget *const target_;
+		Speaker::Speaker::Delegate *audio_delegate_ = nullptr;
+
+		size_t data_type_size_ = 1;
+		uint64_t frame_ = 0;
+		uint64_t video_hash_, audio_hash_;
+
+		Scan *scan_ = nullptr;
+		Scan substitute_scan_;
+		uint8_t *data_ = nullptr;
+		bool data_is_forwarded_ = false;
+		std::vector<uint8_t> substitute_data_;
+
+		void reset_hashes();
+};
+
+}
+}
+
+#endif /* FrameHasher_hpp */
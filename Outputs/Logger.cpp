@@ -0,0 +1,218 @@
+//
+//  Logger.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Logger.hpp"
+
+#include "../Concurrency/SPSCRing.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Log;
+
+namespace {
+
+const auto epoch = std::chrono::steady_clock::now();
+
+/// Each producing thread has a ring of its own, so that pushing a record never requires a lock.
+/// Rings are returned for reuse as threads end.
+struct ProducerRing {
+	Concurrency::SPSCRing<Record, 2048> ring;
+	std::atomic<bool> in_use = true;
+};
+
+class Writer {
+	public:
+		~Writer() {
+			{
+				std::lock_guard lock(mutex_);
+				is_running_ = false;
+			}
+			condition_.notify_all();
+			if(thread_.joinable()) {
+				thread_.join();
+			}
+		}
+
+		/// @returns A ring for the exclusive use of the calling thread.
+		ProducerRing *acquire() {
+			std::lock_guard lock(mutex_);
+			for(auto &ring: rings_) {
+				bool in_use = false;
+				if(ring->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire)) {
+					return ring.get();
+				}
+			}
+			rings_.push_back(std::make_unique<ProducerRing>());
+			return rings_.back().get();
+		}
+
+		void start(FILE *target) {
+			std::lock_guard lock(mutex_);
+			if(thread_.joinable()) return;
+
+			target_ = target;
+			is_running_ = true;
+			thread_ = std::thread([this] {
+				std::unique_lock lock(mutex_);
+				while(is_running_) {
+					condition_.wait_for(lock, std::chrono::milliseconds(20));
+					write_pending();
+				}
+				write_pending();
+			});
+		}
+
+		void did_drop() {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+	private:
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		std::vector<std::unique_ptr<ProducerRing>> rings_;
+
+		std::thread thread_;
+		bool is_running_ = false;
+		FILE *target_ = nullptr;
+		std::atomic<size_t> dropped_ = 0;
+
+		// Used only by the logging thread, with mutex_ held.
+		std::vector<Record> records_;
+
+		void write_pending() {
+			for(auto &ring: rings_) {
+				Record buffer[256];
+				size_t count;
+				while((count = ring->ring.pop(buffer, std::size(buffer)))) {
+					records_.insert(records_.end(), buffer, buffer + count);
+				}
+			}
+
+			// Rings are collected in no particular order; merge them by time.
+			std::stable_sort(records_.begin(), records_.end(), [](const Record &lhs, const Record &rhs) {
+				return lhs.time < rhs.time;
+			});
+			for(const auto &record: records_) {
+				write(record);
+			}
+			records_.clear();
+
+			const size_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+			if(dropped) {
+				fprintf(target_, "[%zu log records dropped]\n", dropped);
+			}
+			fflush(target_);
+		}
+
+		void write(const Record &record) {
+			fprintf(target_, "%.6f [%s] ", double(record.time) / 1e9, name(record.source));
+
+			// Reinterpret the format string, forwarding each directive's flags and width to fprintf
+			// but substituting the size of the argument as stored.
+			size_t next_argument = 0;
+			const auto argument = [&] {
+				return next_argument < record.argument_count ? record.arguments[next_argument++] : 0;
+			};
+			for(const char *c = record.format; *c; ++c) {
+				if(*c != '%') {
+					fputc(*c, target_);
+					continue;
+				}
+
+				char directive[16] = "%";
+				size_t length = 1;
+				++c;
+				while(*c && strchr("-+ #0123456789", *c) && length < sizeof(directive) - 4) {
+					directive[length++] = *c++;
+				}
+
+				switch(*c) {
+					case '\0':
+						--c;
+					break;
+					case 'd': case 'i':
+						strcpy(&directive[length], "lld");
+						fprintf(target_, directive, static_cast<long long>(int64_t(argument())));
+					break;
+					case 'u': case 'x': case 'X': case 'o':
+						directive[length++] = 'l';
+						directive[length++] = 'l';
+						directive[length] = *c;
+						fprintf(target_, directive, static_cast<unsigned long long>(argument()));
+					break;
+					case 'c':
+						directive[length] = 'c';
+						fprintf(target_, directive, int(argument()));
+					break;
+					default:
+						fputc(*c, target_);
+					break;
+				}
+			}
+			fputc('\n', target_);
+		}
+};
+
+Writer &writer() {
+	static Writer writer;
+	return writer;
+}
+
+struct RingHandle {
+	ProducerRing *ring = nullptr;
+	~RingHandle() {
+		if(ring) ring->in_use.store(false, std::memory_order_release);
+	}
+};
+thread_local RingHandle handle;
+
+std::string normalised(const std::string &name) {
+	std::string result;
+	for(const char c: name) {
+		if(c != ' ') result.push_back(char(std::tolower(c)));
+	}
+	return result;
+}
+
+}
+
+uint64_t Logger::now() {
+	return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Logger::push(const Record &record) {
+	if(!handle.ring) {
+		handle.ring = writer().acquire();
+	}
+	if(!handle.ring->ring.push(&record, 1)) {
+		writer().did_drop();
+	}
+}
+
+void Logger::start(FILE *target) {
+	writer().start(target);
+}
+
+bool Logger::set_enabled(const std::string &source_name, bool enabled) {
+	const auto target = normalised(source_name);
+	for(int c = 0; c < 64 && *name(Source(c)); c++) {
+		if(normalised(name(Source(c))) == target) {
+			set_enabled(Source(c), enabled);
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,133 @@
+//
+//  Logger.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Logger_hpp
+#define Logger_hpp
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+/*
+	An asynchronous alternative to the stream-based macros of Log.hpp, cheap enough to be compiled
+	into release builds and enabled at will.
+
+	Each log statement nominates a source, which can be enabled or disabled at runtime; when disabled
+	the cost of a statement is a single relaxed atomic load and branch. Enabled statements store
+	a fixed-size binary record — the time, source, format string and up to four integral arguments —
+	into a lock-free ring belonging to the calling thread. Records are formatted and written by
+	a background thread.
+
+	Sources can also be removed at compile time by defining LOG_SOURCE_MASK as a bit mask of
+	those to retain, indexed by Log::Source; statements for any other source then compile to nothing.
+*/
+
+#ifndef LOG_SOURCE_MASK
+#define LOG_SOURCE_MASK ~uint64_t(0)
+#endif
+
+/// Logs @c format, a string literal with printf-style directives, to @c source, e.g.
+/// LOGF(Log::Source::WDFDC, "Starting %02x", command_). Arguments are evaluated only if @c source is enabled.
+#define LOGF(source, ...)	\
+	do {	\
+		if(Log::Logger::is_enabled(source)) Log::Logger::log(source, __VA_ARGS__);	\
+	} while(false)
+
+namespace Log {
+
+enum class Source: uint8_t {
+	AmigaBlitter,
+	NCR5380,
+	SCSI,
+	WDFDC,
+};
+
+/// @returns The name of @c source, for use as a prefix upon its output and to select it by name.
+constexpr const char *name(Source source) {
+	switch(source) {
+		case Source::AmigaBlitter:	return "Blitter";
+		case Source::NCR5380:		return "5380";
+		case Source::SCSI:			return "SCSI";
+		case Source::WDFDC:			return "WD FDC";
+	}
+	return "";
+}
+
+struct Record {
+	uint64_t time;
+	const char *format;
+	uint64_t arguments[4];
+	Source source;
+	uint8_t argument_count;
+};
+
+class Logger {
+	public:
+		/// Enables or disables all statements for @c source.
+		static void set_enabled(Source source, bool enabled) {
+			const uint64_t bit = uint64_t(1) << int(source);
+			if(enabled) {
+				enabled_sources_.fetch_or(bit, std::memory_order_relaxed);
+			} else {
+				enabled_sources_.fetch_and(~bit, std::memory_order_relaxed);
+			}
+		}
+
+		/*!
+			Enables or disables the source named @c name, comparing case-insensitively and ignoring spaces.
+
+			@returns @c true if a source was found; @c false otherwise.
+		*/
+		static bool set_enabled(const std::string &name, bool enabled);
+
+		/// @returns @c true if statements for @c source should be recorded; @c false otherwise.
+		static bool is_enabled(Source source) {
+			const uint64_t bit = uint64_t(1) << int(source);
+			return (LOG_SOURCE_MASK) & bit & enabled_sources_.load(std::memory_order_relaxed);
+		}
+
+		/// Records @c format and @c arguments for output on the logging thread, if there is space to do so.
+		template <typename... Args> static void log(Source source, const char *format, Args... arguments) {
+			static_assert(sizeof...(Args) <= 4, "At most four arguments may be logged");
+			static_assert((std::is_integral_v<Args> && ...), "Only integral arguments may be logged");
+
+			Record record{now(), format, {argument(arguments)...}, source, uint8_t(sizeof...(Args))};
+			push(record);
+		}
+
+		/*!
+			Starts the logging thread, which will write to @c target; records made before this call are
+			retained as space permits. Output continues until the process exits, at which point all pending
+			records are written.
+
+			Has no effect if the logging thread is already running.
+		*/
+		static void start(FILE *target = stderr);
+
+	private:
+		static inline std::atomic<uint64_t> enabled_sources_ = 0;
+
+		static uint64_t now();
+
+		/// Stores @c value as a record argument, sign extending if it is of signed type.
+		template <typename IntT> static uint64_t argument(IntT value) {
+			if constexpr (std::is_signed_v<IntT>) {
+				return uint64_t(int64_t(value));
+			} else {
+				return uint64_t(value);
+			}
+		}
+
+		static void push(const Record &);
+};
+
+}
+
+#endif /* Logger_hpp */
@@ -0,0 +1,78 @@
+//
+//  FrameGrabber.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "FrameGrabber.hpp"
+
+#include <algorithm>
+
+using namespace Outputs::Display::OpenGL;
+
+FrameGrabber::FrameGrabber(VideoWriter &writer) : writer_(writer) {
+	const auto size = GLsizeiptr(writer_.width() * writer_.height() * 4);
+	for(auto &buffer: buffers_) {
+		test_gl(glGenBuffers, 1, &buffer.name);
+		test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, buffer.name);
+		test_gl(glBufferData, GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+	}
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+}
+
+FrameGrabber::~FrameGrabber() {
+	for(auto &buffer: buffers_) {
+		glDeleteBuffers(1, &buffer.name);
+	}
+}
+
+void FrameGrabber::capture() {
+	// Determine the centre portion of the viewport, clamped to the viewport itself;
+	// the writer will pad if the viewport is too small.
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	Buffer &buffer = buffers_[issued_ % BufferCount];
+	buffer.width = std::min(GLsizei(writer_.width()), GLsizei(viewport[2]));
+	buffer.height = std::min(GLsizei(writer_.height()), GLsizei(viewport[3]));
+
+	// Issue the read; with a pack buffer bound this returns without waiting for the GPU.
+	int prior_alignment;
+	glGetIntegerv(GL_PACK_ALIGNMENT, &prior_alignment);
+	test_gl(glPixelStorei, GL_PACK_ALIGNMENT, 1);
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, buffer.name);
+	test_gl(glReadPixels,
+		viewport[0] + ((viewport[2] - buffer.width) >> 1),
+		viewport[1] + ((viewport[3] - buffer.height) >> 1),
+		buffer.width, buffer.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+	test_gl(glPixelStorei, GL_PACK_ALIGNMENT, prior_alignment);
+	++issued_;
+
+	// Keep one buffer's worth of latency in hand so that mapping doesn't stall.
+	if(issued_ - delivered_ == BufferCount) {
+		deliver();
+	}
+}
+
+void FrameGrabber::flush() {
+	while(delivered_ != issued_) {
+		deliver();
+	}
+}
+
+void FrameGrabber::deliver() {
+	const Buffer &buffer = buffers_[delivered_ % BufferCount];
+	const auto size = GLsizeiptr(buffer.width * buffer.height * 4);
+
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, buffer.name);
+	const auto pixels = static_cast<const uint8_t *>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT));
+	if(pixels) {
+		writer_.write_frame(pixels, int(buffer.width), int(buffer.height), size_t(buffer.width * 4), true);
+		test_gl(glUnmapBuffer, GL_PIXEL_PACK_BUFFER);
+	}
+	test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+	++delivered_;
+}
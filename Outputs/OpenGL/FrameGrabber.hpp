@@ -0,0 +1,61 @@
+//
+//  FrameGrabber.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef FrameGrabber_hpp
+#define FrameGrabber_hpp
+
+#include "OpenGL.hpp"
+#include "../VideoWriter.hpp"
+
+#include <array>
+
+namespace Outputs {
+namespace Display {
+namespace OpenGL {
+
+/*!
+	Captures successive frames from the currently-bound framebuffer into a VideoWriter without
+	stalling the pipeline: each capture is read into one of a ring of pixel buffer objects, and
+	is mapped and handed to the writer only once the next-but-one capture has been issued, by
+	which time the GPU will normally have completed the transfer.
+
+	As per Screenshot, the centre portion of the viewport is captured, sized to match the writer.
+*/
+class FrameGrabber {
+	public:
+		FrameGrabber(VideoWriter &writer);
+		~FrameGrabber();
+
+		/*!
+			Begins capture of the current framebuffer contents; call after drawing and before presenting.
+			Delivers the oldest outstanding capture to the writer if the ring is now full.
+		*/
+		void capture();
+
+		/// Delivers all outstanding captures to the writer, waiting for their transfers if necessary.
+		void flush();
+
+	private:
+		VideoWriter &writer_;
+
+		static constexpr size_t BufferCount = 3;
+		struct Buffer {
+			GLuint name = 0;
+			GLsizei width = 0, height = 0;
+		};
+		std::array<Buffer, BufferCount> buffers_;
+		size_t issued_ = 0, delivered_ = 0;
+
+		void deliver();
+};
+
+}
+}
+}
+
+#endif /* FrameGrabber_hpp */
@@ -9,6 +9,8 @@
 #include "Shader.hpp"
 
 #include "../../Log.hpp"
+
+#include <cstdio>
 #include <vector>
 
 using namespace Outputs::Display::OpenGL;
@@ -17,6 +19,114 @@ namespace {
 	// The below is disabled because it isn't context/thread-specific. Which makes it
 	// fairly 'unuseful'.
 //	Shader *bound_shader = nullptr;
+
+	/// Folds @c string into the 64-bit FNV-1a hash @c hash.
+	uint64_t fnv1a(uint64_t hash, const std::string &string) {
+		for(const auto c: string) {
+			hash = (hash ^ uint8_t(c)) * 1099511628211ull;
+		}
+		return (hash ^ 0xff) * 1099511628211ull;	// Mark the end of the string, so that boundaries are significant.
+	}
+}
+
+std::string Shader::program_cache_directory_;
+
+void Shader::set_program_cache_directory(const std::string &directory) {
+	program_cache_directory_ = directory;
+}
+
+bool Shader::supports_program_binaries() {
+#ifdef GL_VERSION_4_1
+	// Program binaries are core from OpenGL 4.1; GL_NUM_PROGRAM_BINARY_FORMATS isn't a valid query before then.
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if(major < 4 || (major == 4 && minor < 1)) {
+		return false;
+	}
+
+	// Even then, a driver may decline to offer any formats.
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	return formats > 0;
+#else
+	return false;
+#endif
+}
+
+std::string Shader::program_cache_path(const std::vector<Stage> &stages, const std::vector<AttributeBinding> &attribute_bindings) const {
+	uint64_t hash = 14695981039346656037ull;
+	for(const auto name: {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+		const auto value = reinterpret_cast<const char *>(glGetString(name));
+		hash = fnv1a(hash, value ? value : "");
+	}
+	for(const auto &stage: stages) {
+		hash = fnv1a(hash, stage.source);
+	}
+	for(const auto &binding: attribute_bindings) {
+		hash = fnv1a(hash, binding.name + "@" + std::to_string(binding.index));
+	}
+
+	char name[24];
+	snprintf(name, sizeof(name), "%016llx.glbin", static_cast<unsigned long long>(hash));
+	return program_cache_directory_ + "/" + name;
+}
+
+bool Shader::load_program_binary([[maybe_unused]] const std::string &path) {
+#ifdef GL_VERSION_4_1
+	FILE *const file = fopen(path.c_str(), "rb");
+	if(!file) return false;
+
+	// Files are the binary format followed by the binary itself.
+	GLenum format;
+	std::vector<uint8_t> binary;
+	bool did_read = fread(&format, sizeof(format), 1, file) == 1;
+	if(did_read) {
+		fseek(file, 0, SEEK_END);
+		const long length = ftell(file) - long(sizeof(format));
+		fseek(file, long(sizeof(format)), SEEK_SET);
+		did_read = length > 0;
+		if(did_read) {
+			binary.resize(size_t(length));
+			did_read = fread(binary.data(), 1, binary.size(), file) == binary.size();
+		}
+	}
+	fclose(file);
+	if(!did_read) return false;
+
+	// The driver may reject the binary, e.g. if it has been updated since; that's signalled only via the link status.
+	test_gl(glProgramBinary, shader_program_, format, binary.data(), GLsizei(binary.size()));
+	GLint did_link = 0;
+	test_gl(glGetProgramiv, shader_program_, GL_LINK_STATUS, &did_link);
+	return did_link == GL_TRUE;
+#else
+	return false;
+#endif
+}
+
+void Shader::store_program_binary([[maybe_unused]] const std::string &path) {
+#ifdef GL_VERSION_4_1
+	GLint length = 0;
+	test_gl(glGetProgramiv, shader_program_, GL_PROGRAM_BINARY_LENGTH, &length);
+	if(length <= 0) return;
+
+	GLenum format;
+	std::vector<uint8_t> binary(size_t(length), 0);
+	test_gl(glGetProgramBinary, shader_program_, length, &length, &format, binary.data());
+
+	// Write to a temporary and then rename, so that a concurrent reader never sees a partial file.
+	const std::string temporary_path = path + ".tmp";
+	FILE *const file = fopen(temporary_path.c_str(), "wb");
+	if(!file) return;
+	const bool did_write =
+		fwrite(&format, sizeof(format), 1, file) == 1 &&
+		fwrite(binary.data(), 1, size_t(length), file) == size_t(length);
+	fclose(file);
+
+	if(!did_write || rename(temporary_path.c_str(), path.c_str())) {
+		remove(temporary_path.c_str());
+	}
+#endif
 }
 
 GLuint Shader::compile_shader(const std::string &source, GLenum type) {
@@ -38,7 +148,13 @@ GLuint Shader::compile_shader(const std::string &source, GLenum type) {
 			LOG("Compile log:\n" << log.data());
 		}
 
-		throw (type == GL_VERTEX_SHADER) ? VertexShaderCompilationError : FragmentShaderCompilationError;
+		switch(type) {
+			case GL_VERTEX_SHADER:		throw VertexShaderCompilationError;
+			default:					throw FragmentShaderCompilationError;
+#ifdef GL_VERSION_4_3
+			case GL_COMPUTE_SHADER:		throw ComputeShaderCompilationError;
+#endif
+		}
 	}
 #endif
 
@@ -46,7 +162,7 @@ GLuint Shader::compile_shader(const std::string &source, GLenum type) {
 }
 
 Shader::Shader(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings) {
-	init(vertex_shader, fragment_shader, attribute_bindings);
+	init({{GL_VERTEX_SHADER, vertex_shader}, {GL_FRAGMENT_SHADER, fragment_shader}}, attribute_bindings);
 }
 
 Shader::Shader(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<std::string> &binding_names) {
@@ -56,16 +172,39 @@ Shader::Shader(const std::string &vertex_shader, const std::string &fragment_sha
 		bindings.emplace_back(name, index);
 		++index;
 	}
-	init(vertex_shader, fragment_shader, bindings);
+	init({{GL_VERTEX_SHADER, vertex_shader}, {GL_FRAGMENT_SHADER, fragment_shader}}, bindings);
 }
 
-void Shader::init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings) {
+#ifdef GL_VERSION_4_3
+Shader::Shader(const std::string &compute_shader) {
+	init({{GL_COMPUTE_SHADER, compute_shader}}, {});
+}
+
+bool Shader::supports_compute_shaders() {
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return major > 4 || (major == 4 && minor >= 3);
+}
+#else
+bool Shader::supports_compute_shaders() {
+	return false;
+}
+#endif
+
+void Shader::init(const std::vector<Stage> &stages, const std::vector<AttributeBinding> &attribute_bindings) {
 	shader_program_ = glCreateProgram();
-	const GLuint vertex = compile_shader(vertex_shader, GL_VERTEX_SHADER);
-	const GLuint fragment = compile_shader(fragment_shader, GL_FRAGMENT_SHADER);
 
-	test_gl(glAttachShader, shader_program_, vertex);
-	test_gl(glAttachShader, shader_program_, fragment);
+	// Use a cached binary if one is available.
+	const bool uses_cache = !program_cache_directory_.empty() && supports_program_binaries();
+	const std::string cache_path = uses_cache ? program_cache_path(stages, attribute_bindings) : "";
+	if(uses_cache && load_program_binary(cache_path)) {
+		return;
+	}
+
+	for(const auto &stage: stages) {
+		test_gl(glAttachShader, shader_program_, compile_shader(stage.source, stage.type));
+	}
 
 	for(const auto &binding : attribute_bindings) {
 		test_gl(glBindAttribLocation, shader_program_, binding.index, binding.name.c_str());
@@ -86,6 +225,11 @@ void Shader::init(const std::string &vertex_shader, const std::string &fragment_
 #endif
 	}
 
+#ifdef GL_VERSION_4_1
+	if(uses_cache) {
+		test_gl(glProgramParameteri, shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+#endif
 	test_gl(glLinkProgram, shader_program_);
 
 #ifndef NDEBUG
@@ -104,6 +248,10 @@ void Shader::init(const std::string &vertex_shader, const std::string &fragment_
 		throw ProgramLinkageError;
 	}
 #endif
+
+	if(uses_cache) {
+		store_program_binary(cache_path);
+	}
 }
 
 Shader::~Shader() {
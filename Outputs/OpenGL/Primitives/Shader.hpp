@@ -22,15 +22,17 @@ namespace OpenGL {
 
 /*!
 	A @c Shader compiles and holds a shader object, based on a single
-	vertex program and a single fragment program. Attribute bindings
-	may be supplied if desired.
+	vertex program and a single fragment program or, where supported,
+	on a single compute program. Attribute bindings may be supplied
+	if desired.
 */
 class Shader {
 public:
 	enum {
 		VertexShaderCompilationError,
 		FragmentShaderCompilationError,
-		ProgramLinkageError
+		ProgramLinkageError,
+		ComputeShaderCompilationError
 	};
 
 	struct AttributeBinding {
@@ -53,8 +55,30 @@ public:
 		@param binding_names A list of attributes to generate bindings for; these will be given indices 0, 1, 2 ... n-1.
 	*/
 	Shader(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<std::string> &binding_names);
+#ifdef GL_VERSION_4_3
+	/*!
+		Attempts to compile a compute shader, throwing @c ComputeShaderCompilationError or @c ProgramLinkageError upon failure.
+		Check @c supports_compute_shaders before constructing one.
+		@param compute_shader The compute shader source code.
+	*/
+	explicit Shader(const std::string &compute_shader);
+#endif
 	~Shader();
 
+	/// @returns @c true if the current context is able to run compute shaders; @c false otherwise.
+	static bool supports_compute_shaders();
+
+	/*!
+		Nominates a directory in which linked program binaries may be stored, if the context supports
+		retrieving them, so that later constructions of identical shaders can skip compilation and linkage.
+
+		Binaries are keyed by the shader sources, attribute bindings and the vendor, renderer and
+		version strings of the context, so may safely be shared between drivers. The directory is not
+		created if it does not already exist. Supply an empty string to disable caching; that is
+		the default.
+	*/
+	static void set_program_cache_directory(const std::string &directory);
+
 	/*!
 		Performs an @c glUseProgram to make this the active shader unless:
 			(i) it was the previous shader bound; and
@@ -117,11 +141,21 @@ public:
 	void set_uniform_matrix(const std::string &name, GLint size, GLsizei count, bool transpose, const GLfloat *values);
 
 private:
-	void init(const std::string &vertex_shader, const std::string &fragment_shader, const std::vector<AttributeBinding> &attribute_bindings);
+	struct Stage {
+		GLenum type;
+		const std::string &source;
+	};
+	void init(const std::vector<Stage> &stages, const std::vector<AttributeBinding> &attribute_bindings);
 
 	GLuint compile_shader(const std::string &source, GLenum type);
 	GLuint shader_program_;
 
+	static std::string program_cache_directory_;
+	static bool supports_program_binaries();
+	std::string program_cache_path(const std::vector<Stage> &stages, const std::vector<AttributeBinding> &attribute_bindings) const;
+	bool load_program_binary(const std::string &path);
+	void store_program_binary(const std::string &path);
+
 	void flush_functions() const;
 	mutable std::vector<std::function<void(void)>> enqueued_functions_;
 	mutable std::mutex function_mutex_;
@@ -33,7 +33,7 @@ TextureTarget::TextureTarget(GLsizei width, GLsizei height, GLenum texture_unit,
 	bind_texture();
 
 	// Set dimensions and set the user-supplied magnification filter.
-	test_gl(glTexImage2D, GL_TEXTURE_2D, 0, GL_RGBA, GLsizei(expanded_width_), GLsizei(expanded_height_), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	test_gl(glTexImage2D, GL_TEXTURE_2D, 0, GL_RGBA8, GLsizei(expanded_width_), GLsizei(expanded_height_), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 	test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter);
 	test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
@@ -93,6 +93,12 @@ void TextureTarget::bind_texture() const {
 	test_gl(glBindTexture, GL_TEXTURE_2D, texture_);
 }
 
+#ifdef GL_VERSION_4_2
+void TextureTarget::bind_image(GLuint unit) const {
+	test_gl(glBindImageTexture, unit, texture_, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+}
+#endif
+
 void TextureTarget::draw(float aspect_ratio, float colour_threshold) const {
 	if(!pixel_shader_) {
 		const char *vertex_shader =
@@ -48,6 +48,13 @@ class TextureTarget {
 		*/
 		void bind_texture() const;
 
+#ifdef GL_VERSION_4_2
+		/*!
+			Binds this target as a write-only RGBA8 image on image unit @c unit, for use by compute shaders.
+		*/
+		void bind_image(GLuint unit) const;
+#endif
+
 		/*!
 			@returns the width of the texture target.
 		*/
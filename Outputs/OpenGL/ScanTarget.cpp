@@ -11,6 +11,7 @@
 #include "OpenGL.hpp"
 #include "Primitives/Rectangle.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
@@ -40,6 +41,9 @@ constexpr GLenum QAMChromaTextureUnit = GL_TEXTURE2;
 /// The texture unit that contains the current display.
 constexpr GLenum AccumulationTextureUnit = GL_TEXTURE3;
 
+/// The texture unit that contains the palettes that accompany Palette8 input data, one per row of source data.
+constexpr GLenum PaletteTextureUnit = GL_TEXTURE4;
+
 constexpr GLint internalFormatForDepth(std::size_t depth) {
 	switch(depth) {
 		default: return GL_FALSE;
@@ -60,37 +64,87 @@ constexpr GLenum formatForDepth(std::size_t depth) {
 	}
 }
 
+// Apple's headers top out at OpenGL 4.1, so persistent mapping can't even be attempted there.
+#ifdef GL_VERSION_4_4
+constexpr GLbitfield PersistentMappingFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+#endif
+
+}
+
+bool ScanTarget::supports_persistent_mapping() {
+#ifdef GL_VERSION_4_4
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	return major > 4 || (major == 4 && minor >= 4);
+#else
+	return false;
+#endif
 }
 
-template <typename T> void ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
+void ScanTarget::draw_in_situ([[maybe_unused]] size_t begin, [[maybe_unused]] size_t end, [[maybe_unused]] size_t size) {
+#ifdef GL_VERSION_4_4
+	if(begin < end) {
+		test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(end - begin), GLuint(begin));
+	} else {
+		test_gl(glDrawArraysInstancedBaseInstance, GL_TRIANGLE_STRIP, 0, 4, GLsizei(size - begin), GLuint(begin));
+		if(end) {
+			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(end));
+		}
+	}
+#else
+	assert(false);
+#endif
+}
+
+template <typename T> typename T::value_type *ScanTarget::allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name) {
 	const auto buffer_size = array.size() * sizeof(array[0]);
+	typename T::value_type *mapping = nullptr;
 	test_gl(glGenBuffers, 1, &buffer_name);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
-	test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+#ifdef GL_VERSION_4_4
+	if(uses_persistent_mapping_) {
+		test_gl(glBufferStorage, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), nullptr, PersistentMappingFlags);
+		mapping = static_cast<typename T::value_type *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), PersistentMappingFlags));
+		test_gl_error();
+	} else
+#endif
+	{
+		test_gl(glBufferData, GL_ARRAY_BUFFER, GLsizeiptr(buffer_size), NULL, GL_STREAM_DRAW);
+	}
 
 	test_gl(glGenVertexArrays, 1, &vertex_array_name);
 	test_gl(glBindVertexArray, vertex_array_name);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, buffer_name);
+	return mapping;
 }
 
 ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 	target_framebuffer_(target_framebuffer),
 	output_gamma_(output_gamma),
 	unprocessed_line_texture_(LineBufferWidth, LineBufferHeight, UnprocessedLineBufferTextureUnit, GL_NEAREST, false),
-	full_display_rectangle_(-1.0f, -1.0f, 2.0f, 2.0f) {
+	full_display_rectangle_(-1.0f, -1.0f, 2.0f, 2.0f),
+	palette_area_(size_t(WriteAreaHeight) * PaletteSize) {
 
-	set_scan_buffer(scan_buffer_.data(), scan_buffer_.size());
-	set_line_buffer(line_buffer_.data(), line_metadata_buffer_.data(), line_buffer_.size());
+	// Allocate space for the scans and lines, directing the emulation thread to write straight into
+	// GPU-visible memory if possible.
+	uses_persistent_mapping_ = supports_persistent_mapping();
+	Scan *const scans = allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
+	Line *const lines = allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
+	uses_persistent_mapping_ &= scans && lines;
+	LOG("Persistent mapping " << (uses_persistent_mapping_ ? "is" : "is not") << " in use");
 
-	// Allocate space for the scans and lines.
-	allocate_buffer(scan_buffer_, scan_buffer_name_, scan_vertex_array_);
-	allocate_buffer(line_buffer_, line_buffer_name_, line_vertex_array_);
+	set_scan_buffer(uses_persistent_mapping_ ? scans : scan_buffer_.data(), scan_buffer_.size());
+	lines_ = uses_persistent_mapping_ ? lines : line_buffer_.data();
+	set_line_buffer(lines_, line_metadata_buffer_.data(), line_buffer_.size());
 
-	// TODO: if this is OpenGL 4.4 or newer, use glBufferStorage rather than glBufferData
-	// and specify GL_MAP_PERSISTENT_BIT. Then map the buffer now, and let the client
-	// write straight into it.
+	// Lines in the unprocessed line texture are cleared only when their slot is next reused, so
+	// it's safe to let repeated lines refer back to earlier composition.
+	set_reuses_repeated_lines(true);
 
 	test_gl(glGenTextures, 1, &write_area_texture_name_);
+	test_gl(glGenTextures, 1, &palette_texture_name_);
+	set_palette_area(palette_area_.data());
 
 	test_gl(glBlendFunc, GL_SRC_ALPHA, GL_CONSTANT_COLOR);
 	test_gl(glBlendColor, 0.4f, 0.4f, 0.4f, 1.0f);
@@ -102,7 +156,12 @@ ScanTarget::ScanTarget(GLuint target_framebuffer, float output_gamma) :
 ScanTarget::~ScanTarget() {
 	perform([=] {
 		glDeleteBuffers(1, &scan_buffer_name_);
+		glDeleteBuffers(1, &line_buffer_name_);
+		if(write_area_buffer_name_) {
+			glDeleteBuffers(1, &write_area_buffer_name_);
+		}
 		glDeleteTextures(1, &write_area_texture_name_);
+		glDeleteTextures(1, &palette_texture_name_);
 		glDeleteVertexArrays(1, &scan_vertex_array_);
 	});
 }
@@ -119,6 +178,25 @@ void ScanTarget::setup_pipeline() {
 
 	// Resize the texture only if required.
 	const size_t required_size = WriteAreaWidth*WriteAreaHeight*data_type_size;
+#ifdef GL_VERSION_4_4
+	if(uses_persistent_mapping_) {
+		if(required_size != write_area_buffer_size_) {
+			if(write_area_buffer_name_) {
+				test_gl(glDeleteBuffers, 1, &write_area_buffer_name_);
+			}
+
+			test_gl(glGenBuffers, 1, &write_area_buffer_name_);
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+			test_gl(glBufferStorage, GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(required_size), nullptr, PersistentMappingFlags);
+			const auto write_area = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(required_size), PersistentMappingFlags));
+			test_gl_error();
+			test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
+
+			write_area_buffer_size_ = required_size;
+			set_write_area(write_area);
+		}
+	} else
+#endif
 	if(required_size != write_area_data_size()) {
 		write_area_texture_.resize(required_size);
 		set_write_area(write_area_texture_.data());
@@ -129,23 +207,37 @@ void ScanTarget::setup_pipeline() {
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, line_buffer_name_);
 
 	// Destroy or create a QAM buffer and shader, if appropriate.
-	const bool needs_qam_buffer = (modals.display_type == DisplayType::CompositeColour || modals.display_type == DisplayType::SVideo);
+	const bool needs_qam_buffer = PipelineDescription(modals, output_gamma_).has(PipelineDescription::Stage::Demodulation);
 	if(needs_qam_buffer) {
 		if(!qam_chroma_texture_) {
 			qam_chroma_texture_ = std::make_unique<TextureTarget>(LineBufferWidth, LineBufferHeight, QAMChromaTextureUnit, GL_NEAREST, false);
 		}
 
-		qam_separation_shader_ = qam_separation_shader();
-		enable_vertex_attributes(ShaderType::QAMSeparation, *qam_separation_shader_);
-		set_uniforms(ShaderType::QAMSeparation, *qam_separation_shader_);
-		qam_separation_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
+		// Prefer a compute shader if available, as that avoids a switch of render target and
+		// the rasterisation of lines into the QAM buffer.
+		qam_separation_shader_ = nullptr;
+		qam_separation_compute_shader_ = nullptr;
+#ifdef GL_VERSION_4_3
+		if(Shader::supports_compute_shaders()) {
+			qam_separation_compute_shader_ = qam_separation_compute_shader(modals);
+			set_uniforms(ShaderType::QAMSeparation, *qam_separation_compute_shader_);
+			qam_separation_compute_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
+		}
+#endif
+		if(!qam_separation_compute_shader_) {
+			qam_separation_shader_ = qam_separation_shader(modals);
+			enable_vertex_attributes(ShaderType::QAMSeparation, *qam_separation_shader_);
+			set_uniforms(ShaderType::QAMSeparation, *qam_separation_shader_);
+			qam_separation_shader_->set_uniform("textureName", GLint(UnprocessedLineBufferTextureUnit - GL_TEXTURE0));
+		}
 	} else {
 		qam_chroma_texture_.reset();
-		qam_separation_shader_.reset();
+		qam_separation_shader_ = nullptr;
+		qam_separation_compute_shader_ = nullptr;
 	}
 
 	// Establish an output shader.
-	output_shader_ = conversion_shader();
+	output_shader_ = conversion_shader(modals);
 	enable_vertex_attributes(ShaderType::Conversion, *output_shader_);
 	set_uniforms(ShaderType::Conversion, *output_shader_);
 	output_shader_->set_uniform("origin", modals.visible_area.origin.x, modals.visible_area.origin.y);
@@ -154,12 +246,24 @@ void ScanTarget::setup_pipeline() {
 	output_shader_->set_uniform("qamTextureName", GLint(QAMChromaTextureUnit - GL_TEXTURE0));
 
 	// Establish an input shader.
-	input_shader_ = composition_shader();
+	input_shader_ = composition_shader(modals);
 	test_gl(glBindVertexArray, scan_vertex_array_);
 	test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 	enable_vertex_attributes(ShaderType::Composition, *input_shader_);
 	set_uniforms(ShaderType::Composition, *input_shader_);
 	input_shader_->set_uniform("textureName", GLint(SourceDataTextureUnit - GL_TEXTURE0));
+	input_shader_->set_uniform("paletteTextureName", GLint(PaletteTextureUnit - GL_TEXTURE0));
+
+	// Queue up all other display types for compilation in advance, so that a user who switches
+	// between them doesn't have to wait for compilation. Thumbnails don't offer a choice.
+	display_types_to_prepare_.clear();
+	if(!is_thumbnail()) {
+		for(const auto display_type: {DisplayType::CompositeMonochrome, DisplayType::CompositeColour, DisplayType::SVideo, DisplayType::RGB}) {
+			if(display_type != modals.display_type) {
+				display_types_to_prepare_.push_back(display_type);
+			}
+		}
+	}
 }
 
 bool ScanTarget::is_soft_display_type() {
@@ -177,6 +281,7 @@ void ScanTarget::update(int, int output_height) {
 				false);
 			return;
 		}
+		glDeleteSync(fence_);
 		fence_ = nullptr;
 	}
 
@@ -188,6 +293,13 @@ void ScanTarget::update(int, int output_height) {
 
 	// Grab the new output list.
 	perform([=] {
+		// The GPU has now finished with whatever was drawn last time, so if that was
+		// drawn in situ it can now be released.
+		if(has_pending_area_) {
+			complete_output_area(pending_area_);
+			has_pending_area_ = false;
+		}
+
 		OutputArea area = get_output_area();
 
 		// Establish the pipeline if necessary.
@@ -195,6 +307,11 @@ void ScanTarget::update(int, int output_height) {
 		const bool did_setup_pipeline = bool(new_modals);
 		if(did_setup_pipeline) {
 			setup_pipeline();
+		} else if(!display_types_to_prepare_.empty()) {
+			auto modals = BufferingScanTarget::modals();
+			modals.display_type = display_types_to_prepare_.back();
+			display_types_to_prepare_.pop_back();
+			prepare_shaders(modals);
 		}
 
 		// Determine the start time of this submission group and the number of lines it will contain.
@@ -203,7 +320,7 @@ void ScanTarget::update(int, int output_height) {
 
 		// Submit scans; only the new ones need to be communicated.
 		size_t new_scans = (area.end.scan - area.start.scan + scan_buffer_.size()) % scan_buffer_.size();
-		if(new_scans) {
+		if(new_scans && !uses_persistent_mapping_) {
 			test_gl(glBindBuffer, GL_ARRAY_BUFFER, scan_buffer_name_);
 
 			// Map only the required portion of the buffer.
@@ -232,6 +349,18 @@ void ScanTarget::update(int, int output_height) {
 			test_gl(glActiveTexture, SourceDataTextureUnit);
 			test_gl(glBindTexture, GL_TEXTURE_2D, write_area_texture_name_);
 
+			// If persistent mapping is in use then the write area is already in a pixel unpack buffer,
+			// so pass offsets into that rather than host addresses.
+			const auto source = [&] (size_t offset) -> const void * {
+				if(uses_persistent_mapping_) {
+					return reinterpret_cast<const void *>(offset);
+				}
+				return &write_area_texture_[offset];
+			};
+			if(uses_persistent_mapping_) {
+				test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, write_area_buffer_name_);
+			}
+
 			// Create storage for the texture if it doesn't yet exist; this was deferred until here
 			// because the pixel format wasn't initially known.
 			if(!texture_exists_) {
@@ -248,7 +377,7 @@ void ScanTarget::update(int, int output_height) {
 					0,
 					formatForDepth(write_area_data_size()),
 					GL_UNSIGNED_BYTE,
-					nullptr);
+					source(0));
 				texture_exists_ = true;
 			}
 
@@ -261,7 +390,7 @@ void ScanTarget::update(int, int output_height) {
 					1 + area.end.write_area_y - area.start.write_area_y,
 					formatForDepth(write_area_data_size()),
 					GL_UNSIGNED_BYTE,
-					&write_area_texture_[size_t(area.start.write_area_y * WriteAreaWidth) * write_area_data_size()]);
+					source(size_t(area.start.write_area_y * WriteAreaWidth) * write_area_data_size()));
 			} else {
 				// The circular buffer wrapped around; submit the data from the read pointer to the end of
 				// the buffer and from the start of the buffer to the submit pointer.
@@ -272,7 +401,7 @@ void ScanTarget::update(int, int output_height) {
 					WriteAreaHeight - area.start.write_area_y,
 					formatForDepth(write_area_data_size()),
 					GL_UNSIGNED_BYTE,
-					&write_area_texture_[size_t(area.start.write_area_y * WriteAreaWidth) * write_area_data_size()]);
+					source(size_t(area.start.write_area_y * WriteAreaWidth) * write_area_data_size()));
 				test_gl(glTexSubImage2D,
 					GL_TEXTURE_2D, 0,
 					0, 0,
@@ -280,7 +409,52 @@ void ScanTarget::update(int, int output_height) {
 					1 + area.end.write_area_y,
 					formatForDepth(write_area_data_size()),
 					GL_UNSIGNED_BYTE,
-					&write_area_texture_[0]);
+					source(0));
+			}
+
+			if(uses_persistent_mapping_) {
+				test_gl(glBindBuffer, GL_PIXEL_UNPACK_BUFFER, 0);
+			}
+
+			// Palette data is accompanied by a palette for each row, so submit the palettes for the same rows.
+			if(modals().input_data_type == InputDataType::Palette8) {
+				test_gl(glActiveTexture, PaletteTextureUnit);
+				test_gl(glBindTexture, GL_TEXTURE_2D, palette_texture_name_);
+
+				if(!palette_texture_exists_) {
+					test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+					test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+					test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+					test_gl(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+					test_gl(glTexImage2D,
+						GL_TEXTURE_2D,
+						0,
+						GL_RGBA8UI,
+						GLsizei(PaletteSize),
+						WriteAreaHeight,
+						0,
+						GL_RGBA_INTEGER,
+						GL_UNSIGNED_BYTE,
+						palette_area_.data());
+					palette_texture_exists_ = true;
+				}
+
+				const auto submit_palettes = [&] (int first_row, int rows) {
+					test_gl(glTexSubImage2D,
+						GL_TEXTURE_2D, 0,
+						0, first_row,
+						GLsizei(PaletteSize),
+						rows,
+						GL_RGBA_INTEGER,
+						GL_UNSIGNED_BYTE,
+						&palette_area_[size_t(first_row) * PaletteSize]);
+				};
+				if(area.end.write_area_y >= area.start.write_area_y) {
+					submit_palettes(area.start.write_area_y, 1 + area.end.write_area_y - area.start.write_area_y);
+				} else {
+					submit_palettes(area.start.write_area_y, WriteAreaHeight - area.start.write_area_y);
+					submit_palettes(0, 1 + area.end.write_area_y);
+				}
 			}
 		}
 
@@ -319,7 +493,11 @@ void ScanTarget::update(int, int output_height) {
 			// Apply new spans. They definitely always go to the first buffer.
 			test_gl(glBindVertexArray, scan_vertex_array_);
 			input_shader_->bind();
-			test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+			if(uses_persistent_mapping_) {
+				draw_in_situ(area.start.scan, area.end.scan, scan_buffer_.size());
+			} else {
+				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(new_scans));
+			}
 		}
 
 		// Logic for reducing resolution: start doing so if the metrics object reports that
@@ -335,8 +513,12 @@ void ScanTarget::update(int, int output_height) {
 		}
 
 		// Ensure the accumulation buffer is properly sized, allowing for the metrics object's
-		// feelings about whether too high a resolution is being used.
-		const int framebuffer_height = std::max(output_height / resolution_reduction_level_, std::min(540, output_height));
+		// feelings about whether too high a resolution is being used. Thumbnails are always
+		// accumulated at exactly their output size.
+		const int framebuffer_height =
+			is_thumbnail() ?
+				std::max(output_height, 1) :
+				std::max(output_height / resolution_reduction_level_, std::min(540, output_height));
 		const int proportional_width = (framebuffer_height * 4) / 3;
 		const bool did_create_accumulation_texture = !accumulation_texture_ || ( (accumulation_texture_->get_width() != proportional_width || accumulation_texture_->get_height() != framebuffer_height));
 
@@ -387,8 +569,11 @@ void ScanTarget::update(int, int output_height) {
 				accumulation_texture_->bind_framebuffer();
 				output_shader_->bind();
 
-				// Enable blending and stenciling.
-				test_gl(glEnable, GL_BLEND);
+				// Enable blending and stenciling; thumbnails don't simulate phosphor persistence
+				// so needn't blend.
+				if(!is_thumbnail()) {
+					test_gl(glEnable, GL_BLEND);
+				}
 				test_gl(glEnable, GL_STENCIL_TEST);
 			}
 
@@ -426,27 +611,49 @@ void ScanTarget::update(int, int output_height) {
 					}
 				}
 
-				// Upload.
-				const auto buffer_size = lines * sizeof(Line);
-				if(!end_line || end_line > start_line) {
-					test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
-				} else {
-					uint8_t *destination = static_cast<uint8_t *>(
-						glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
-					);
-					assert(destination);
-					test_gl_error();
-
-					const size_t buffer_length = line_buffer_.size() * sizeof(Line);
-					const size_t start_position = start_line * sizeof(Line);
-					memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
-					memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
-
-					test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
-					test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+				// Upload, if necessary.
+				const auto draw_lines = [&] {
+					if(uses_persistent_mapping_) {
+						draw_in_situ(start_line, end_line, line_buffer_.size());
+					} else {
+						test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+					}
+				};
+				if(!uses_persistent_mapping_) {
+					const auto buffer_size = lines * sizeof(Line);
+					if(!end_line || end_line > start_line) {
+						test_gl(glBufferSubData, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), &line_buffer_[start_line]);
+					} else {
+						uint8_t *destination = static_cast<uint8_t *>(
+							glMapBufferRange(GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size), GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT)
+						);
+						assert(destination);
+						test_gl_error();
+
+						const size_t buffer_length = line_buffer_.size() * sizeof(Line);
+						const size_t start_position = start_line * sizeof(Line);
+						memcpy(&destination[0], &line_buffer_[start_line], buffer_length - start_position);
+						memcpy(&destination[buffer_length - start_position], &line_buffer_[0], end_line * sizeof(Line));
+
+						test_gl(glFlushMappedBufferRange, GL_ARRAY_BUFFER, 0, GLsizeiptr(buffer_size));
+						test_gl(glUnmapBuffer, GL_ARRAY_BUFFER);
+					}
 				}
 
 				// Produce colour information, if required.
+#ifdef GL_VERSION_4_3
+				if(qam_separation_compute_shader_) {
+					// Without persistent mapping, the lines in use have just been uploaded to the start of the buffer.
+					qam_separation_compute_shader_->set_uniform("firstLine", GLuint(uses_persistent_mapping_ ? start_line : 0));
+					qam_separation_compute_shader_->bind();
+					test_gl(glBindBufferBase, GL_SHADER_STORAGE_BUFFER, 0, line_buffer_name_);
+					qam_chroma_texture_->bind_image(0);
+					test_gl(glDispatchCompute, GLuint(lines), 1, 1);
+					test_gl(glMemoryBarrier, GL_TEXTURE_FETCH_BARRIER_BIT);
+
+					output_shader_->bind();
+				}
+#endif
 				if(qam_separation_shader_) {
 					qam_separation_shader_->bind();
 					qam_chroma_texture_->bind_framebuffer();
@@ -455,16 +662,18 @@ void ScanTarget::update(int, int output_height) {
 
 					test_gl(glDisable, GL_BLEND);
 					test_gl(glDisable, GL_STENCIL_TEST);
-					test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+					draw_lines();
 
 					accumulation_texture_->bind_framebuffer();
 					output_shader_->bind();
-					test_gl(glEnable, GL_BLEND);
+					if(!is_thumbnail()) {
+						test_gl(glEnable, GL_BLEND);
+					}
 					test_gl(glEnable, GL_STENCIL_TEST);
 				}
 
 				// Render to the output.
-				test_gl(glDrawArraysInstanced, GL_TRIANGLE_STRIP, 0, 4, GLsizei(lines));
+				draw_lines();
 
 				start_line = end_line;
 				new_lines -= lines;
@@ -473,6 +682,13 @@ void ScanTarget::update(int, int output_height) {
 			// Disable blending and the stencil test again.
 			test_gl(glDisable, GL_STENCIL_TEST);
 			test_gl(glDisable, GL_BLEND);
+
+			// Note the vertical position of the final line, mapping it into the visible area in the
+			// same way as the conversion shader.
+			const auto &modals = BufferingScanTarget::modals();
+			const Line &final_line = lines_[(area.end.line + LineBufferHeight - 1) % LineBufferHeight];
+			const float y = float(final_line.end_points[0].y) / (float(modals.output_scale.y) * modals.aspect_ratio * (3.0f / 4.0f));
+			raster_position_ = std::clamp((y - modals.visible_area.origin.y) / modals.visible_area.size.height, 0.0f, 1.0f);
 		}
 
 		// That's it for operations affecting the accumulation buffer.
@@ -481,20 +697,37 @@ void ScanTarget::update(int, int output_height) {
 		// Grab a fence sync object to avoid busy waiting upon the next extry into this
 		// function, and reset the is_updating_ flag.
 		fence_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-		complete_output_area(area);
+		if(uses_persistent_mapping_) {
+			pending_area_ = area;
+			has_pending_area_ = true;
+		} else {
+			complete_output_area(area);
+		}
 	});
 }
 
+float ScanTarget::raster_position() const {
+	return raster_position_;
+}
+
 void ScanTarget::draw(int output_width, int output_height) {
+	draw(0, 0, output_width, output_height);
+}
+
+void ScanTarget::draw(int output_x, int output_y, int output_width, int output_height) {
 	while(is_drawing_to_accumulation_buffer_.test_and_set(std::memory_order_acquire));
 
 	if(accumulation_texture_) {
 		// Copy the accumulation texture to the target.
 		test_gl(glBindFramebuffer, GL_FRAMEBUFFER, target_framebuffer_);
-		test_gl(glViewport, 0, 0, (GLsizei)output_width, (GLsizei)output_height);
+		test_gl(glViewport, (GLint)output_x, (GLint)output_y, (GLsizei)output_width, (GLsizei)output_height);
 
+		// Clear only the area being drawn to, in case other scan targets are sharing this framebuffer.
+		test_gl(glEnable, GL_SCISSOR_TEST);
+		test_gl(glScissor, (GLint)output_x, (GLint)output_y, (GLsizei)output_width, (GLsizei)output_height);
 		test_gl(glClearColor, 0.0f, 0.0f, 0.0f, 0.0f);
 		test_gl(glClear, GL_COLOR_BUFFER_BIT);
+		test_gl(glDisable, GL_SCISSOR_TEST);
 		accumulation_texture_->bind_texture();
 		accumulation_texture_->draw(float(output_width) / float(output_height), 4.0f / 255.0f);
 	}
@@ -12,6 +12,7 @@
 #include "../Log.hpp"
 #include "../DisplayMetrics.hpp"
 #include "../ScanTargets/BufferingScanTarget.hpp"
+#include "../ScanTargets/PipelineDescription.hpp"
 
 #include "OpenGL.hpp"
 #include "Primitives/TextureTarget.hpp"
@@ -26,6 +27,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Outputs {
@@ -47,9 +49,22 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 
 		/*! Pushes the current state of output to the target framebuffer. */
 		void draw(int output_width, int output_height);
+		/*!
+			Pushes the current state of output to the rectangle with origin (@c output_x, @c output_y) — measured
+			from the bottom left, as per OpenGL — and the specified size within the target framebuffer, leaving
+			the rest of the framebuffer untouched. This allows several scan targets to share one framebuffer.
+		*/
+		void draw(int output_x, int output_y, int output_width, int output_height);
 		/*! Processes all the latest input, at a resolution suitable for later output to a framebuffer of the specified size. */
 		void update(int output_width, int output_height);
 
+		/*!
+			@returns How far down the visible area, in the range [0, 1], the most recent line
+			processed by @c update fell. Hosts that race the beam can use this to determine whether
+			output has yet reached any particular portion of the display.
+		*/
+		float raster_position() const;
+
 	private:
 		static constexpr int LineBufferWidth = 2048;
 		static constexpr int LineBufferHeight = 2048;
@@ -70,6 +85,7 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		int output_height_ = 0;
 
 		size_t lines_submitted_ = 0;
+		std::atomic<float> raster_position_ = 0.0f;
 		std::chrono::high_resolution_clock::time_point line_submission_begin_time_;
 
 		// Contains the first composition of scans into lines;
@@ -91,12 +107,34 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		GLuint scan_buffer_name_ = 0, scan_vertex_array_ = 0;
 		GLuint line_buffer_name_ = 0, line_vertex_array_ = 0;
 
-		template <typename T> void allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
+		/// Creates a buffer and vertex array sized to hold all of @c array; if persistent mapping is in use then
+		/// also maps the buffer and returns its address, otherwise returns @c nullptr.
+		template <typename T> typename T::value_type *allocate_buffer(const T &array, GLuint &buffer_name, GLuint &vertex_array_name);
 		template <typename T> void patch_buffer(const T &array, GLuint target, uint16_t submit_pointer, uint16_t read_pointer);
 
 		GLuint write_area_texture_name_ = 0;
 		bool texture_exists_ = false;
 
+		GLuint palette_texture_name_ = 0;
+		bool palette_texture_exists_ = false;
+
+		// If the context supports persistent, coherent buffer mappings then the scan and line buffers and
+		// the write area are all GPU-visible buffers that the emulation thread writes to directly, rather than
+		// the arrays below, and no copying is necessary. Each output area is then marked as complete only
+		// once the GPU has finished with it, i.e. once the fence for the update that drew it has signalled.
+		bool uses_persistent_mapping_ = false;
+		GLuint write_area_buffer_name_ = 0;
+		size_t write_area_buffer_size_ = 0;
+		OutputArea pending_area_;
+		bool has_pending_area_ = false;
+
+		/// @returns @c true if the current context permits persistent mapping; @c false otherwise.
+		static bool supports_persistent_mapping();
+
+		/// Draws scans or lines in the range [begin, end) from a circular buffer of size @c size that
+		/// has been persistently mapped, using the buffer in situ.
+		static void draw_in_situ(size_t begin, size_t end, size_t size);
+
 		// Receives scan target modals.
 		void setup_pipeline();
 
@@ -117,31 +155,53 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		GLsync fence_ = nullptr;
 		std::atomic_flag is_drawing_to_accumulation_buffer_;
 
-		std::unique_ptr<Shader> input_shader_;
-		std::unique_ptr<Shader> output_shader_;
-		std::unique_ptr<Shader> qam_separation_shader_;
+		// The shaders currently in use, all owned by shaders_.
+		Shader *input_shader_ = nullptr;
+		Shader *output_shader_ = nullptr;
+		Shader *qam_separation_shader_ = nullptr;
+		Shader *qam_separation_compute_shader_ = nullptr;
+
+		// Every shader compiled so far, keyed by source, so that a return to an earlier set of modals
+		// — e.g. upon toggling display type — needn't compile anything.
+		std::unordered_map<std::string, std::unique_ptr<Shader>> shaders_;
+		Shader *shader(const std::string &vertex_shader, const std::string &fragment_shader, ShaderType type);
+#ifdef GL_VERSION_4_3
+		Shader *shader(const std::string &compute_shader);
+#endif
+
+		// Display types for which shaders are still to be compiled in advance of their use, one per update.
+		std::vector<DisplayType> display_types_to_prepare_;
+		void prepare_shaders(const Modals &);
 
 		/*!
 			Produces a shader that composes fragment of the input stream to a single buffer,
 			normalising the data into one of four forms: RGB, 8-bit luminance,
 			phase-linked luminance or luminance+phase offset.
 		*/
-		std::unique_ptr<Shader> composition_shader() const;
+		Shader *composition_shader(const Modals &);
 		/*!
 			Produces a shader that reads from a composition buffer and converts to host
 			output RGB, decoding composite or S-Video as necessary.
 		*/
-		std::unique_ptr<Shader> conversion_shader() const;
+		Shader *conversion_shader(const Modals &);
 		/*!
 			Produces a shader that writes separated but not-yet filtered QAM components
 			from the unprocessed line texture to the QAM chroma texture, at a fixed
 			size of four samples per colour clock, point sampled.
 		*/
-		std::unique_ptr<Shader> qam_separation_shader() const;
+		Shader *qam_separation_shader(const Modals &);
+#ifdef GL_VERSION_4_3
+		/*!
+			Produces a compute shader with the same output as @c qam_separation_shader but which reads
+			lines directly from the line buffer, bound as a shader storage buffer, and writes to the QAM
+			chroma texture as an image. One work group should be dispatched per line.
+		*/
+		Shader *qam_separation_compute_shader(const Modals &);
+#endif
 
 		void set_sampling_window(int output_Width, int output_height, Shader &target);
 
-		std::string sampling_function() const;
+		static std::string sampling_function(const Modals &);
 
 		/*!
 			@returns true if the current display type is a 'soft' one, i.e. one in which
@@ -149,11 +209,16 @@ class ScanTarget: public Outputs::Display::BufferingScanTarget {	// TODO: use pr
 		*/
 		bool is_soft_display_type();
 
-		// Storage for the various buffers.
+		// Storage for the various buffers; scans, lines and the write area use these only
+		// if persistent mapping isn't available.
 		std::vector<uint8_t> write_area_texture_;
 		std::array<Scan, LineBufferHeight*5> scan_buffer_;
 		std::array<Line, LineBufferHeight> line_buffer_;
+		Line *lines_ = nullptr;	// Either line_buffer_ or the persistently-mapped equivalent.
 		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
+
+		// Palettes for Palette8 data are always uploaded from here.
+		std::vector<uint32_t> palette_area_;
 };
 
 }
@@ -31,32 +31,18 @@ void ScanTarget::set_uniforms(ShaderType type, Shader &target) const {
 			target.set_uniform("scale", GLfloat(modals.output_scale.x), GLfloat(modals.output_scale.y) * modals.aspect_ratio * (3.0f / 4.0f));
 			target.set_uniform("phaseOffset", GLfloat(modals.input_data_tweaks.phase_linked_luminance_offset));
 
-			const float clocks_per_angle = float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator);
+			const PipelineDescription pipeline(modals, output_gamma_);
 			GLfloat texture_offsets[4];
 			GLfloat angles[4];
 			for(int c = 0; c < 4; ++c) {
 				GLfloat angle = (GLfloat(c) - 1.5f) / 4.0f;
-				texture_offsets[c] = angle * clocks_per_angle;
+				texture_offsets[c] = angle * pipeline.clocks_per_angle;
 				angles[c] = GLfloat(angle * 2.0f * M_PI);
 			}
 			target.set_uniform("textureCoordinateOffsets", 1, 4, texture_offsets);
 			target.set_uniform("compositeAngleOffsets", 4, 1, angles);
-
-			switch(modals.composite_colour_space) {
-				case ColourSpace::YIQ: {
-					const GLfloat rgbToYIQ[] = {0.299f, 0.596f, 0.211f, 0.587f, -0.274f, -0.523f, 0.114f, -0.322f, 0.312f};
-					const GLfloat yiqToRGB[] = {1.0f, 1.0f, 1.0f, 0.956f, -0.272f, -1.106f, 0.621f, -0.647f, 1.703f};
-					target.set_uniform_matrix("lumaChromaToRGB", 3, false, yiqToRGB);
-					target.set_uniform_matrix("rgbToLumaChroma", 3, false, rgbToYIQ);
-				} break;
-
-				case ColourSpace::YUV: {
-					const GLfloat rgbToYUV[] = {0.299f, -0.14713f, 0.615f, 0.587f, -0.28886f, -0.51499f, 0.114f, 0.436f, -0.10001f};
-					const GLfloat yuvToRGB[] = {1.0f, 1.0f, 1.0f, 0.0f, -0.39465f, 2.03211f, 1.13983f, -0.58060f, 0.0f};
-					target.set_uniform_matrix("lumaChromaToRGB", 3, false, yuvToRGB);
-					target.set_uniform_matrix("rgbToLumaChroma", 3, false, rgbToYUV);
-				} break;
-			}
+			target.set_uniform_matrix("lumaChromaToRGB", 3, false, pipeline.to_rgb.data());
+			target.set_uniform_matrix("rgbToLumaChroma", 3, false, pipeline.from_rgb.data());
 		break;
 	}
 }
@@ -65,7 +51,7 @@ void ScanTarget::set_sampling_window(int output_width, int, Shader &target) {
 	const auto modals = BufferingScanTarget::modals();
 	if(modals.display_type != DisplayType::CompositeColour) {
 		const float one_pixel_width = float(modals.cycles_per_line) * modals.visible_area.size.width / float(output_width);
-		const float clocks_per_angle = float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator);
+		const float clocks_per_angle = PipelineDescription(modals, output_gamma_).clocks_per_angle;
 		GLfloat texture_offsets[4];
 		GLfloat angles[4];
 		for(int c = 0; c < 4; ++c) {
@@ -194,11 +180,46 @@ std::vector<std::string> ScanTarget::bindings(ShaderType type) const {
 	}
 }
 
+// MARK: - Shader cache.
+
+Shader *ScanTarget::shader(const std::string &vertex_shader, const std::string &fragment_shader, ShaderType type) {
+	// Sources are separated by a character that can't appear in GLSL, to keep keys unambiguous;
+	// bindings are implied by the type, which is also included.
+	auto &shader = shaders_[std::to_string(int(type)) + '\0' + vertex_shader + '\0' + fragment_shader];
+	if(!shader) {
+		shader = std::make_unique<Shader>(vertex_shader, fragment_shader, bindings(type));
+	}
+	return shader.get();
+}
+
+#ifdef GL_VERSION_4_3
+Shader *ScanTarget::shader(const std::string &compute_shader) {
+	auto &shader = shaders_[compute_shader];
+	if(!shader) {
+		shader = std::make_unique<Shader>(compute_shader);
+	}
+	return shader.get();
+}
+#endif
+
+void ScanTarget::prepare_shaders(const Modals &modals) {
+	composition_shader(modals);
+	conversion_shader(modals);
+	if(PipelineDescription(modals, output_gamma_).has(PipelineDescription::Stage::Demodulation)) {
+#ifdef GL_VERSION_4_3
+		if(Shader::supports_compute_shaders()) {
+			qam_separation_compute_shader(modals);
+			return;
+		}
+#endif
+		qam_separation_shader(modals);
+	}
+}
+
 // MARK: - Shader code.
 
-std::string ScanTarget::sampling_function() const {
+std::string ScanTarget::sampling_function(const Modals &modals) {
 	std::string fragment_shader;
-	const auto modals = BufferingScanTarget::modals();
 	const bool is_svideo = modals.display_type == DisplayType::SVideo;
 
 	if(is_svideo) {
@@ -246,6 +267,7 @@ std::string ScanTarget::sampling_function() const {
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::Palette8:
 			fragment_shader +=
 				"vec3 colour = rgbToLumaChroma * textureLod(textureName, coordinate, 0).rgb;"
 				"vec2 quadrature = vec2(cos(angle), sin(angle));";
@@ -262,8 +284,7 @@ std::string ScanTarget::sampling_function() const {
 	return fragment_shader;
 }
 
-std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
-	const auto modals = BufferingScanTarget::modals();
+Shader *ScanTarget::conversion_shader(const Modals &modals) {
 
 	// Compose a vertex shader. If the display type is RGB, generate just the proper
 	// geometry position, plus a solitary textureCoordinate.
@@ -375,7 +396,7 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 			"uniform mat3 lumaChromaToRGB;"
 			"uniform mat3 rgbToLumaChroma;";
 
-		fragment_shader += sampling_function();
+		fragment_shader += sampling_function(modals);
 	}
 
 	fragment_shader +=
@@ -472,29 +493,24 @@ std::unique_ptr<Shader> ScanTarget::conversion_shader() const {
 	}
 
 	// Apply a brightness adjustment if requested.
-	if(fabs(modals.brightness - 1.0f) > 0.05f) {
-		fragment_shader += "fragColour3 = fragColour3 * " + std::to_string(modals.brightness) + ";";
+	const PipelineDescription pipeline(modals, output_gamma_);
+	if(pipeline.has_output_multiplier()) {
+		fragment_shader += "fragColour3 = fragColour3 * " + std::to_string(pipeline.output_multiplier) + ";";
 	}
 
 	// Apply a gamma correction if required.
-	if(fabs(output_gamma_ - modals.intended_gamma) > 0.05f) {
-		const float gamma_ratio = output_gamma_ / modals.intended_gamma;
-		fragment_shader += "fragColour3 = pow(fragColour3, vec3(" + std::to_string(gamma_ratio) + "));";
+	if(pipeline.has_output_gamma()) {
+		fragment_shader += "fragColour3 = pow(fragColour3, vec3(" + std::to_string(pipeline.output_gamma) + "));";
 	}
 
 	fragment_shader +=
 			"fragColour = vec4(fragColour3, 0.64);"
 		"}";
 
-	return std::make_unique<Shader>(
-		vertex_shader,
-		fragment_shader,
-		bindings(ShaderType::Conversion)
-	);
+	return shader(vertex_shader, fragment_shader, ShaderType::Conversion);
 }
 
-std::unique_ptr<Shader> ScanTarget::composition_shader() const {
-	const auto modals = BufferingScanTarget::modals();
+Shader *ScanTarget::composition_shader(const Modals &modals) {
 	const std::string vertex_shader =
 	R"x(#version 150
 
@@ -527,6 +543,7 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 		in vec2 textureCoordinate;
 
 		uniform usampler2D textureName;
+		uniform usampler2D paletteTextureName;
 
 		void main(void) {
 	)x";
@@ -561,17 +578,20 @@ std::unique_ptr<Shader> ScanTarget::composition_shader() const {
 				"uvec2 textureValue = textureLod(textureName, textureCoordinate, 0).rg;"
 				"fragColour = vec4(float(textureValue.r) / 15.0, float(textureValue.g & 240u) / 240.0, float(textureValue.g & 15u) / 15.0, 1.0);";
 		break;
+
+		case InputDataType::Palette8:
+			// The palette for each row of source data is in the corresponding row of the palette texture.
+			fragment_shader +=
+				"uint index = textureLod(textureName, textureCoordinate, 0).r;"
+				"int row = int(textureCoordinate.y * float(textureSize(textureName, 0).y));"
+				"fragColour = vec4(texelFetch(paletteTextureName, ivec2(int(index), row), 0)) / vec4(255.0);";
+		break;
 	}
 
-	return std::make_unique<Shader>(
-		vertex_shader,
-		fragment_shader + "}",
-		bindings(ShaderType::Composition)
-	);
+	return shader(vertex_shader, fragment_shader + "}", ShaderType::Composition);
 }
 
-std::unique_ptr<Shader> ScanTarget::qam_separation_shader() const {
-	const auto modals = BufferingScanTarget::modals();
+Shader *ScanTarget::qam_separation_shader(const Modals &modals) {
 	const bool is_svideo = modals.display_type == DisplayType::SVideo;
 
 	// Sets up texture coordinates to run between startClock and endClock, mapping to
@@ -645,7 +665,7 @@ std::unique_ptr<Shader> ScanTarget::qam_separation_shader() const {
 	vertex_shader += "}";
 
 	fragment_shader +=
-		sampling_function() +
+		sampling_function(modals) +
 		"void main(void) {";
 
 	if(modals.display_type == DisplayType::SVideo) {
@@ -676,9 +696,92 @@ std::unique_ptr<Shader> ScanTarget::qam_separation_shader() const {
 			"fragColour = fragColour*0.5 + vec4(0.5);"
 		"}";
 
-	return std::make_unique<Shader>(
-		vertex_shader,
-		fragment_shader,
-		bindings(ShaderType::QAMSeparation)
-	);
+	return shader(vertex_shader, fragment_shader, ShaderType::QAMSeparation);
 }
+
+#ifdef GL_VERSION_4_3
+Shader *ScanTarget::qam_separation_compute_shader(const Modals &modals) {
+	const bool is_svideo = modals.display_type == DisplayType::SVideo;
+
+	// Lines are read directly from the line buffer rather than via vertex attributes, so byte offsets
+	// of the relevant fields are baked into the source. All fields of interest are 16-bit and aligned.
+	const auto offset = [] (size_t end_point, size_t field) {
+		return std::to_string(offsetof(Line, end_points) + end_point * sizeof(Line::EndPoint) + field);
+	};
+	std::string compute_shader =
+		"#version 430\n"
+
+		"layout(local_size_x = 64) in;"
+		"layout(std430, binding = 0) readonly buffer LineBuffer { uint lines[]; };"
+		"layout(rgba8, binding = 0) writeonly uniform image2D qamImage;"
+
+		"uniform sampler2D textureName;"
+		"uniform mat3 rgbToLumaChroma;"
+		"uniform float textureCoordinateOffsets[4];"
+		"uniform vec4 compositeAngleOffsets;"
+		"uniform uint firstLine;"
+
+		"float compositeAmplitude;"
+
+		"uint field(uint line, uint offset) {"
+			"uint address = line * " + std::to_string(sizeof(Line)) + "u + offset;"
+			"return (lines[address >> 2] >> ((address & 2u) * 8u)) & 0xffffu;"
+		"}"
+
+		"float signedField(uint line, uint offset) {"
+			"return float(int(field(line, offset) << 16) >> 16);"
+		"}" +
+
+		sampling_function(modals) +
+
+		// Each work group handles one line; its invocations cover that line's output pixels, in the same
+		// snapped positions and with the same interpolation as the rasterised version of this pass.
+		"void main(void) {"
+			"uint line = (firstLine + gl_WorkGroupID.x) % " + std::to_string(LineBufferHeight) + "u;"
+
+			"float startClock = float(field(line, " + offset(0, offsetof(Line::EndPoint, cycles_since_end_of_horizontal_retrace)) + "u));"
+			"float endClock = float(field(line, " + offset(1, offsetof(Line::EndPoint, cycles_since_end_of_horizontal_retrace)) + "u));"
+			"float startCompositeAngle = signedField(line, " + offset(0, offsetof(Line::EndPoint, composite_angle)) + "u) / 64.0;"
+			"float endCompositeAngle = signedField(line, " + offset(1, offsetof(Line::EndPoint, composite_angle)) + "u) / 64.0;"
+			"float lineY = float(field(line, " + std::to_string(offsetof(Line, line)) + "u));"
+			"float lineCompositeAmplitude = float(field(line, " + std::to_string(offsetof(Line, composite_amplitude)) + "u) & 0xffu);"
+
+			"compositeAmplitude = lineCompositeAmplitude / 255.0;"
+			"float oneOverCompositeAmplitude = mix(0.0, 255.0 / lineCompositeAmplitude, step(0.95, lineCompositeAmplitude));"
+
+			"float startX = floor(abs(startCompositeAngle) * 4.0);"
+			"float endX = floor(abs(endCompositeAngle) * 4.0);"
+			"vec2 size = vec2(textureSize(textureName, 0));"
+
+			"for(int x = int(min(startX, endX)) + int(gl_LocalInvocationID.x); x < int(max(startX, endX)); x += int(gl_WorkGroupSize.x)) {"
+				"float lateral = (float(x) + 0.5 - startX) / (endX - startX);"
+				"float centreClock = mix(startClock, endClock, lateral);"
+				"float compositeAngle = mix(startCompositeAngle, endCompositeAngle, lateral) * 2.0 * 3.141592654;"
+				"vec4 colour;";
+
+	if(is_svideo) {
+		compute_shader +=
+				"colour = vec4(svideo_sample(vec2(centreClock, lineY + 0.5) / size, compositeAngle).rgg * vec3(1.0, cos(compositeAngle), sin(compositeAngle)), 1.0);";
+	} else {
+		compute_shader +=
+				"vec4 angles = compositeAngle + compositeAngleOffsets;"
+				"vec4 samples = vec4("
+					"composite_sample(vec2(centreClock + textureCoordinateOffsets[0], lineY + 0.5) / size, angles.x),"
+					"composite_sample(vec2(centreClock + textureCoordinateOffsets[1], lineY + 0.5) / size, angles.y),"
+					"composite_sample(vec2(centreClock + textureCoordinateOffsets[2], lineY + 0.5) / size, angles.z),"
+					"composite_sample(vec2(centreClock + textureCoordinateOffsets[3], lineY + 0.5) / size, angles.w)"
+				");"
+
+				"float luminance = dot(samples, vec4(0.25));"
+				"float chrominance = (dot(samples.yz, vec2(0.5)) - luminance) * oneOverCompositeAmplitude;"
+				"colour = vec4(luminance, vec2(cos(compositeAngle), sin(compositeAngle)) * chrominance, 1.0);";
+	}
+
+	compute_shader +=
+				"imageStore(qamImage, ivec2(x, int(lineY)), colour*0.5 + vec4(0.5));"
+			"}"
+		"}";
+
+	return shader(compute_shader);
+}
+#endif
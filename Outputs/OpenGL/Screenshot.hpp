@@ -11,6 +11,10 @@
 
 #include "OpenGL.hpp"
 
+#include <cstring>
+#include <functional>
+#include <vector>
+
 namespace Outputs {
 namespace Display {
 namespace OpenGL {
@@ -50,10 +54,123 @@ struct Screenshot {
 		}
 	}
 
+	/*!
+		Constructs a screenshot from @c width x @c height RGBA data at @c pixels, supplied
+		bottom row first as per OpenGL.
+	*/
+	Screenshot(int width, int height, const uint8_t *pixels) : width(width), height(height) {
+		const size_t line_size = size_t(width * 4);
+		pixel_data.resize(line_size * size_t(height));
+		for(size_t y = 0; y < size_t(height); ++y) {
+			memcpy(&pixel_data[y * line_size], &pixels[(size_t(height - 1) - y) * line_size], line_size);
+		}
+	}
+
 	std::vector<uint8_t> pixel_data;
 	int width, height;
 };
 
+/*!
+	Captures screenshots as per Screenshot but without stalling the GL pipeline: each request issues a
+	read into a pixel buffer object and posts a fence, and the result is mapped and delivered only
+	once that fence has been passed, usually by the next frame.
+
+	Calls to @c request and @c update should be made with the relevant context current;
+	callbacks are made from within @c update.
+*/
+class AsyncScreenshots {
+	public:
+		using Callback = std::function<void(Screenshot &&)>;
+
+		~AsyncScreenshots() {
+			for(auto &capture: captures_) {
+				glDeleteSync(capture.fence);
+				spare_buffers_.push_back(capture.buffer);
+			}
+			if(!spare_buffers_.empty()) {
+				glDeleteBuffers(GLsizei(spare_buffers_.size()), spare_buffers_.data());
+			}
+		}
+
+		/*!
+			Begins capture of the centre portion of the currently-bound framebuffer, cropped to the
+			requested aspect ratio; @c callback will receive the result from a later call to @c update.
+		*/
+		void request(int aspect_width, int aspect_height, Callback &&callback) {
+			GLint dimensions[4];
+			glGetIntegerv(GL_VIEWPORT, dimensions);
+
+			Capture capture;
+			capture.height = int(dimensions[3]);
+			capture.width = (capture.height * aspect_width) / aspect_height;
+			capture.callback = std::move(callback);
+
+			// Reuse a buffer if one is available; capture sizes are assumed usually to be
+			// stable so there are almost always at most two.
+			if(spare_buffers_.empty()) {
+				test_gl(glGenBuffers, 1, &capture.buffer);
+			} else {
+				capture.buffer = spare_buffers_.back();
+				spare_buffers_.pop_back();
+			}
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, capture.buffer);
+			test_gl(glBufferData, GL_PIXEL_PACK_BUFFER, GLsizeiptr(capture.width * capture.height * 4), nullptr, GL_STREAM_READ);
+
+			int prior_alignment;
+			glGetIntegerv(GL_PACK_ALIGNMENT, &prior_alignment);
+			test_gl(glPixelStorei, GL_PACK_ALIGNMENT, 1);
+			test_gl(glReadPixels, (dimensions[2] - GLint(capture.width)) >> 1, 0, GLint(capture.width), GLint(capture.height), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			test_gl(glPixelStorei, GL_PACK_ALIGNMENT, prior_alignment);
+			test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+			capture.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			captures_.push_back(std::move(capture));
+		}
+
+		/*!
+			Delivers every capture that the GPU has completed, without waiting for any others.
+		*/
+		void update() {
+			while(!captures_.empty()) {
+				Capture &capture = captures_.front();
+				const GLenum status = glClientWaitSync(capture.fence, 0, 0);
+				if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+					break;
+				}
+				glDeleteSync(capture.fence);
+
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, capture.buffer);
+				const auto pixels = static_cast<const uint8_t *>(
+					glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(capture.width * capture.height * 4), GL_MAP_READ_BIT)
+				);
+				if(pixels) {
+					Screenshot screenshot(capture.width, capture.height, pixels);
+					test_gl(glUnmapBuffer, GL_PIXEL_PACK_BUFFER);
+					capture.callback(std::move(screenshot));
+				}
+				test_gl(glBindBuffer, GL_PIXEL_PACK_BUFFER, 0);
+
+				spare_buffers_.push_back(capture.buffer);
+				captures_.erase(captures_.begin());
+			}
+		}
+
+		/// @returns @c true if any requested captures have yet to be delivered; @c false otherwise.
+		bool has_pending() const {
+			return !captures_.empty();
+		}
+
+	private:
+		struct Capture {
+			GLuint buffer = 0;
+			GLsync fence = nullptr;
+			int width = 0, height = 0;
+			Callback callback;
+		};
+		std::vector<Capture> captures_;
+		std::vector<GLuint> spare_buffers_;
+};
+
 }
 }
 }
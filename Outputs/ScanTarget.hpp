@@ -91,6 +91,12 @@ enum class InputDataType {
 	Red4Green4Blue4,		// 2 bytes/pixel; low nibble in first byte is red, high nibble in second is green, low is blue.
 							// i.e. if it were a little endian word, 0xgb0r; or 0x0rgb big endian.
 	Red8Green8Blue8,		// 4 bytes/pixel; first is red, second is green, third is blue, fourth is vacant.
+
+	// The palette type is an RGB type, but describes each pixel only as an index into
+	// a palette that is supplied separately.
+
+	Palette8,				// 1 byte/pixel; an index into the Red8Green8Blue8-format palette most recently
+							// supplied via ScanTarget::set_palette.
 };
 
 /// @returns the number of bytes per sample for data of type @c data_type.
@@ -101,6 +107,7 @@ constexpr inline size_t size_for_data_type(InputDataType data_type) {
 		case InputDataType::Luminance8:
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
+		case InputDataType::Palette8:
 			return 1;
 
 		case InputDataType::Luminance8Phase8:
@@ -131,6 +138,7 @@ constexpr inline size_t data_type_is_normalised(InputDataType data_type) {
 		case InputDataType::Red1Green1Blue1:
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
+		case InputDataType::Palette8:
 			return false;
 	}
 }
@@ -149,6 +157,7 @@ constexpr inline DisplayType natural_display_type_for_data_type(InputDataType da
 		case InputDataType::Red2Green2Blue2:
 		case InputDataType::Red4Green4Blue4:
 		case InputDataType::Red8Green8Blue8:
+		case InputDataType::Palette8:
 			return DisplayType::RGB;
 
 		case InputDataType::Luminance8Phase8:
@@ -260,6 +269,15 @@ struct ScanTarget {
 		/// Sets the total format of input data.
 		virtual void set_modals(Modals) = 0;
 
+		/// The number of entries in a palette, as used by the Palette8 input data type.
+		static constexpr size_t PaletteSize = 256;
+
+		/// Supplies the palette against which all Palette8 data subsequently provided via @c begin_data
+		/// should be interpreted, as @c length entries in Red8Green8Blue8 format. Entries beyond @c length
+		/// are undefined. The palette may be changed as often as necessary, but each change may cost
+		/// additional storage.
+		virtual void set_palette([[maybe_unused]] const uint32_t *palette, [[maybe_unused]] size_t length) {}
+
 
 	/*
 		This second section of the interface allows provision of the streamed data, plus some control
@@ -327,6 +345,13 @@ struct ScanTarget {
 		/// @returns a pointer to the allocated space if any was available; @c nullptr otherwise.
 		virtual uint8_t *begin_data(size_t required_length, size_t required_alignment = 1) = 0;
 
+		/// @returns @c true if the scan target is currently discarding all data, e.g. because the frame
+		/// in progress will never be displayed; @c begin_data will return @c nullptr for as long as that is so.
+		///
+		/// Owners may then skip any work that serves only to produce pixels, but should otherwise continue
+		/// exactly as usual — supplying scans, announcements and submits with unaltered timing.
+		virtual bool is_discarding_data() const { return false; }
+
 		/// Announces that the owner is finished with the region created by the most recent @c begin_data
 		/// and indicates that its actual final size was @c actual_length.
 		///
@@ -8,6 +8,7 @@
 
 #include "BufferingScanTarget.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -18,6 +19,30 @@
 
 using namespace Outputs::Display;
 
+namespace {
+
+/// Folds @c length bytes from @c data into @c hash; this need be only a quick and
+/// reasonably well-distributed hash since it's used only to spot repeated lines.
+uint64_t hash(uint64_t hash, const void *data, size_t length) {
+	constexpr uint64_t multiplier = 0x9e3779b97f4a7c15;
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	while(length >= sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(word));
+		hash = (hash ^ word) * multiplier;
+		hash ^= hash >> 29;
+		bytes += sizeof(word);
+		length -= sizeof(word);
+	}
+	while(length--) {
+		hash = (hash ^ *bytes) * multiplier;
+		++bytes;
+	}
+	return hash;
+}
+
+}
+
 BufferingScanTarget::BufferingScanTarget() {
 	// Ensure proper initialisation of the two atomic pointer sets.
 	read_pointers_.store(write_pointers_, std::memory_order::memory_order_relaxed);
@@ -38,8 +63,8 @@ uint8_t *BufferingScanTarget::begin_data(size_t required_length, size_t required
 	// If allocation has already failed on this line, continue the trend.
 	if(allocation_has_failed_) return nullptr;
 
-	// If there isn't yet a write area or data size then mark allocation as failed and finish.
-	if(!write_area_ || !data_type_size_) {
+	// If there isn't yet a write area or data size, or a palette area for palette data, then mark allocation as failed and finish.
+	if(!write_area_ || !data_type_size_ || (uses_palette_ && !palette_area_)) {
 		allocation_has_failed_ = true;
 		return nullptr;
 	}
@@ -58,6 +83,15 @@ uint8_t *BufferingScanTarget::begin_data(size_t required_length, size_t required
 		end_x = aligned_start_x + uint16_t(1 + required_length);
 	}
 
+	// Palette data needs the current palette to be attached to its row; if the row already has
+	// a different palette then move to the next.
+	const bool needs_palette = uses_palette_ && (int(output_y) != palette_row_ || palette_row_generation_ != palette_generation_);
+	if(needs_palette && int(output_y) == palette_row_) {
+		output_y = (output_y + 1) % WriteAreaHeight;
+		aligned_start_x = uint16_t(required_alignment);
+		end_x = aligned_start_x + uint16_t(1 + required_length);
+	}
+
 	// Check whether that steps over the read pointer; if so then the final address will be closer
 	// to the write pointer than the old.
 	const auto end_address = TextureAddress(end_x, output_y);
@@ -77,6 +111,18 @@ uint8_t *BufferingScanTarget::begin_data(size_t required_length, size_t required
 		return nullptr;
 	}
 
+	// Attach the current palette to this row if necessary, provided that doesn't affect data still awaiting output.
+	if(needs_palette) {
+		if(TextureAddressGetY(read_pointers.write_area) == output_y && read_pointers.write_area != write_pointers_.write_area) {
+			allocation_has_failed_ = true;
+			return nullptr;
+		}
+
+		std::copy(palette_.begin(), palette_.end(), &palette_area_[size_t(output_y) * PaletteSize]);
+		palette_row_ = output_y;
+		palette_row_generation_ = palette_generation_;
+	}
+
 	// Everything checks out, note expectation of a future end_data and return the pointer.
 	assert(!data_is_allocated_);
 	data_is_allocated_ = true;
@@ -120,6 +166,14 @@ void BufferingScanTarget::end_data(size_t actual_length) {
 		case 4:	end_data<uint32_t>(actual_length);	break;
 	}
 
+	// Include the new data in the line's hash if repeated lines are being sought.
+	if(reuses_repeated_lines_) {
+		line_hash_ = hash(line_hash_, &write_area_[size_t(write_pointers_.write_area) * data_type_size_], actual_length * data_type_size_);
+		if(uses_palette_) {
+			line_hash_ = hash(line_hash_, &palette_hash_, sizeof(palette_hash_));
+		}
+	}
+
 	// Advance to the end of the current run.
 	write_pointers_.write_area += actual_length + 1;
 
@@ -178,6 +232,15 @@ void BufferingScanTarget::end_scan() {
 
 	// Complete the scan only if one is afoot.
 	if(vended_scan_) {
+		// Hash the scan's endpoints while data offsets are still relative to the data allocation; with the data
+		// itself that's everything that determines the composed line.
+		if(reuses_repeated_lines_) {
+			for(const auto &end_point: vended_scan_->scan.end_points) {
+				const uint16_t fields[] = {end_point.data_offset, end_point.cycles_since_end_of_horizontal_retrace};
+				line_hash_ = hash(line_hash_, fields, sizeof(fields));
+			}
+		}
+
 		vended_scan_->data_y = TextureAddressGetY(vended_write_area_pointer_);
 		vended_scan_->line = write_pointers_.line;
 		vended_scan_->scan.end_points[0].data_offset += TextureAddressGetX(vended_write_area_pointer_);
@@ -202,6 +265,7 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 		is_first_in_frame_ = true;
 		previous_frame_was_complete_ = frame_is_complete_;
 		frame_is_complete_ = true;
+		line_in_frame_ = 0;
 	}
 
 	// Proceed from here only if a change in visibility has occurred.
@@ -218,6 +282,14 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 		// Attempt to allocate a new line, noting allocation success or failure.
 		const auto next_line = uint16_t((write_pointers_.line + 1) % line_buffer_size_);
 		allocation_has_failed_ = next_line == read_pointers.line;
+
+		// If repeated lines are being reused then also decline to get more than half a buffer ahead of the consumer;
+		// that guarantees that any line being reused has been consumed before its intermediate line is overwritten.
+		if(reuses_repeated_lines_) {
+			allocation_has_failed_ |= (next_line + line_buffer_size_ - read_pointers.line) % line_buffer_size_ > line_buffer_size_ / 2;
+			line_hash_ = 0;
+		}
+
 		if(!allocation_has_failed_) {
 			// If there was space for a new line, establish its start and reset the count of provided scans.
 			Line &active_line = line_buffer_[size_t(write_pointers_.line)];
@@ -234,6 +306,32 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 		// Commit the most recent line only if any scans fell on it and all allocation was successful.
 		if(!allocation_has_failed_ && provided_scans_) {
 			const auto submit_pointers = submit_pointers_.load(std::memory_order::memory_order_relaxed);
+			Line &active_line = line_buffer_[size_t(write_pointers_.line)];
+
+			// If this line repeats the one at the same position in a recent enough frame, discard its scans and data
+			// in favour of that line's existing composition. Otherwise note it for potential future reuse.
+			if(reuses_repeated_lines_ && line_in_frame_ < repeated_lines_.size()) {
+				line_hash_ = hash(line_hash_, &provided_scans_, sizeof(provided_scans_));
+				RepeatedLine &repeated_line = repeated_lines_[line_in_frame_];
+				if(
+					repeated_line.is_valid &&
+					repeated_line.hash == line_hash_ &&
+					lines_committed_ - repeated_line.commit < line_buffer_size_ / 2
+				) {
+					active_line.line = repeated_line.line;
+					write_pointers_.scan = submit_pointers.scan;
+					write_pointers_.write_area = submit_pointers.write_area;
+					palette_row_ = submitted_palette_row_;
+					palette_row_generation_ = submitted_palette_row_generation_;
+					provided_scans_ = 0;
+				} else {
+					repeated_line.hash = line_hash_;
+					repeated_line.line = write_pointers_.line;
+					repeated_line.commit = lines_committed_;
+					repeated_line.is_valid = true;
+				}
+			}
+			++lines_committed_;
 
 			// Store metadata.
 			LineMetadata &metadata = line_metadata_buffer_[size_t(write_pointers_.line)];
@@ -246,7 +344,6 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 			assert(((metadata.first_scan + size_t(provided_scans_)) % scan_buffer_size_) == write_pointers_.scan);
 
 			// Store actual line data.
-			Line &active_line = line_buffer_[size_t(write_pointers_.line)];
 			active_line.end_points[1].x = location.x;
 			active_line.end_points[1].y = location.y;
 			active_line.end_points[1].cycles_since_end_of_horizontal_retrace = location.cycles_since_end_of_horizontal_retrace;
@@ -258,12 +355,17 @@ void BufferingScanTarget::announce(Event event, bool is_visible, const Outputs::
 			// Update the submit pointers with all lines, scans and data written during this line.
 			std::atomic_thread_fence(std::memory_order::memory_order_release);
 			submit_pointers_.store(write_pointers_, std::memory_order::memory_order_release);
+			submitted_palette_row_ = palette_row_;
+			submitted_palette_row_generation_ = palette_row_generation_;
 		} else {
 			// Something failed, or there was nothing on the line anyway, so reset all pointers to where they
 			// were before this line. Mark frame as incomplete if this was an allocation failure.
 			write_pointers_ = submit_pointers_.load(std::memory_order::memory_order_relaxed);
+			palette_row_ = submitted_palette_row_;
+			palette_row_generation_ = submitted_palette_row_generation_;
 			frame_is_complete_ &= !allocation_has_failed_;
 		}
+		++line_in_frame_;
 
 		// Don't permit anything to be allocated on invisible areas.
 		allocation_has_failed_ = true;
@@ -289,8 +391,43 @@ void BufferingScanTarget::set_write_area(uint8_t *base) {
 	std::lock_guard lock_guard(producer_mutex_);
 	write_area_ = base;
 	write_pointers_ = submit_pointers_ = read_pointers_ = PointerSet();
+	palette_row_ = submitted_palette_row_ = -1;
 	allocation_has_failed_ = true;
 	vended_scan_ = nullptr;
+	invalidate_repeated_lines();
+}
+
+void BufferingScanTarget::set_palette_area(uint32_t *base) {
+	std::lock_guard lock_guard(producer_mutex_);
+	palette_area_ = base;
+	palette_row_ = submitted_palette_row_ = -1;
+}
+
+void BufferingScanTarget::set_palette(const uint32_t *palette, size_t length) {
+	std::lock_guard lock_guard(producer_mutex_);
+
+	// Palettes are attached to data only upon allocation, so a change merely needs to be noted.
+	length = std::min(length, PaletteSize);
+	if(std::equal(palette, palette + length, palette_.begin())) return;
+	std::copy(palette, palette + length, palette_.begin());
+	palette_hash_ = hash(0, palette_.data(), sizeof(palette_));
+	++palette_generation_;
+}
+
+void BufferingScanTarget::set_reuses_repeated_lines(bool reuses_repeated_lines) {
+	std::lock_guard lock_guard(producer_mutex_);
+	reuses_repeated_lines_ = reuses_repeated_lines;
+
+	// Lines can be reused only if they're less than half a buffer old, and a frame is
+	// composed of distinct lines, so there's no point tracking any more than that.
+	repeated_lines_.resize(reuses_repeated_lines ? line_buffer_size_ / 2 : 0);
+	invalidate_repeated_lines();
+}
+
+void BufferingScanTarget::invalidate_repeated_lines() {
+	for(auto &line: repeated_lines_) {
+		line.is_valid = false;
+	}
 }
 
 size_t BufferingScanTarget::write_area_data_size() const {
@@ -301,11 +438,41 @@ size_t BufferingScanTarget::write_area_data_size() const {
 
 void BufferingScanTarget::set_modals(Modals modals) {
 	perform([=] {
-		modals_ = modals;
-		modals_are_dirty_.store(true, std::memory_order::memory_order_relaxed);
+		requested_modals_ = modals;
+		has_modals_ = true;
+		apply_modals();
+	});
+}
+
+void BufferingScanTarget::set_is_thumbnail(bool is_thumbnail) {
+	perform([=] {
+		if(is_thumbnail_ == is_thumbnail) return;
+		is_thumbnail_ = is_thumbnail;
+		if(has_modals_) apply_modals();
 	});
 }
 
+bool BufferingScanTarget::is_thumbnail() const {
+	return is_thumbnail_;
+}
+
+void BufferingScanTarget::apply_modals() {
+	modals_ = requested_modals_;
+	if(is_thumbnail_) {
+		switch(modals_.input_data_type) {
+			case InputDataType::PhaseLinkedLuminance8:
+			case InputDataType::Luminance8Phase8:
+				modals_.display_type = DisplayType::CompositeMonochrome;
+			break;
+
+			default:
+				modals_.display_type = DisplayType::RGB;
+			break;
+		}
+	}
+	modals_are_dirty_.store(true, std::memory_order::memory_order_relaxed);
+}
+
 // MARK: - Consumer.
 
 BufferingScanTarget::OutputArea BufferingScanTarget::get_output_area() {
@@ -387,6 +554,10 @@ const Outputs::Display::ScanTarget::Modals *BufferingScanTarget::new_modals() {
 	std::lock_guard lock_guard(producer_mutex_);
 	data_type_size_ = Outputs::Display::size_for_data_type(modals_.input_data_type);
 	assert((data_type_size_ == 1) || (data_type_size_ == 2) || (data_type_size_ == 4));
+	uses_palette_ = modals_.input_data_type == InputDataType::Palette8;
+
+	// The caller is also likely to compose lines differently from here onwards.
+	invalidate_repeated_lines();
 
 	return &modals_;
 }
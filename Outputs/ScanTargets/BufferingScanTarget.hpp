@@ -33,6 +33,11 @@ namespace Display {
 		*	will then output the lines.
 
 	This buffer rejects new data when full.
+
+	Optionally it will also spot lines that exactly repeat the corresponding line of a recent
+	frame and, rather than posting their scans and data again, will point them at the
+	intermediate buffer line already composed for that earlier frame. That is useful only
+	to consumers that retain the intermediate buffer between lines; see set_reuses_repeated_lines.
 */
 class BufferingScanTarget: public Outputs::Display::ScanTarget {
 	public:
@@ -44,6 +49,20 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 
 		BufferingScanTarget();
 
+		/*!
+			Enables or disables thumbnail output, for small previews at minimal cost. In thumbnail mode the
+			display type requested by the machine is replaced by the cheapest one that can present its data —
+			RGB for luminance, palette and RGB data, monochrome composite otherwise — so that no chrominance
+			separation or demodulation occurs. Consumers may also use @c is_thumbnail to decline other
+			costly processing, such as phosphor persistence.
+
+			Safe to call from any thread.
+		*/
+		void set_is_thumbnail(bool);
+
+		/// @returns @c true if thumbnail output is enabled; @c false otherwise.
+		bool is_thumbnail() const;
+
 		// This is included because it's assumed that scan targets will want to expose one.
 		// It is the subclass's responsibility to post timings.
 		Metrics display_metrics_;
@@ -75,6 +94,10 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 			} end_points[2];
 
 			uint8_t composite_amplitude;
+
+			/// The line in the intermediate buffer that holds this line's content. Usually this is
+			/// the line's own index in the line buffer, but if repeated lines are being reused then
+			/// it may instead be that of an earlier line with identical content.
 			uint16_t line;
 		};
 
@@ -98,6 +121,17 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		/// Sets the area of memory to use as line and line metadata buffers.
 		void set_line_buffer(Line *line_buffer, LineMetadata *metadata_buffer, size_t size);
 
+		/// Enables or disables reuse of repeated lines. If enabled then whenever a line has exactly the same
+		/// scans and data as the line at the same position in a recent frame, its scans and data are discarded
+		/// and its Line points to the intermediate buffer line that was composed for the earlier frame.
+		///
+		/// A consumer that enables this must leave the intermediate buffer line for each Line intact until at
+		/// least half of the line buffer has subsequently been consumed. In exchange the producer will
+		/// not run more than half of the line buffer ahead of the consumer.
+		///
+		/// Must be called after set_line_buffer.
+		void set_reuses_repeated_lines(bool);
+
 		/// Sets a new base address for the texture.
 		/// When called this will flush all existing data and load up the
 		/// new data size.
@@ -106,6 +140,15 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		/// @returns The number of bytes per input sample, as per the latest modals.
 		size_t write_area_data_size() const;
 
+		/// Sets the area of memory to use for palettes, which must be at least WriteAreaHeight * PaletteSize
+		/// four-byte entries in size. Each row of the write area that holds Palette8 data is accompanied by
+		/// the palette that applies to it, in Red8Green8Blue8 format, at the corresponding row of the palette area.
+		/// Palette rows are modified only alongside their write area rows, so are subject to the same
+		/// output area bounds.
+		///
+		/// Palette8 data can't be accepted until a palette area has been supplied.
+		void set_palette_area(uint32_t *base);
+
 		/// Defines a segment of data now ready for output, consisting of start and endpoints for:
 		///
 		///	(i) the region of the write area that has been modified; if the caller is using shared memory
@@ -169,6 +212,7 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 	private:
 		// ScanTarget overrides.
 		void set_modals(Modals) final;
+		void set_palette(const uint32_t *palette, size_t length) final;
 		Outputs::Display::ScanTarget::Scan *begin_scan() final;
 		void end_scan() final;
 		uint8_t *begin_data(size_t required_length, size_t required_alignment) final;
@@ -180,6 +224,18 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		uint8_t *write_area_ = nullptr;
 		size_t data_type_size_ = 0;
 
+		// Palette state: the owner-supplied palette area, the palette most recently supplied plus a
+		// hash of it, and a count of palette changes. Palettes are copied into the palette area only as
+		// data is allocated; palette_row_ and palette_row_generation_ record the write area row most
+		// recently given a palette and which palette that was, with copies as at the last submission.
+		uint32_t *palette_area_ = nullptr;
+		bool uses_palette_ = false;
+		std::array<uint32_t, PaletteSize> palette_{};
+		uint64_t palette_hash_ = 0;
+		size_t palette_generation_ = 0;
+		int palette_row_ = -1, submitted_palette_row_ = -1;
+		size_t palette_row_generation_ = 0, submitted_palette_row_generation_ = 0;
+
 		// Tracks changes in raster visibility in order to populate
 		// Lines and LineMetadatas.
 		bool output_is_visible_ = false;
@@ -198,6 +254,23 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		bool frame_is_complete_ = true;
 		bool previous_frame_was_complete_ = true;
 
+		// State for the reuse of repeated lines: a running hash of the line currently being
+		// composed, its position within the frame, a count of all lines committed and, for each
+		// position in the frame, the hash of, intermediate buffer line used by and commit count
+		// of the most recent line at that position.
+		struct RepeatedLine {
+			uint64_t hash = 0;
+			size_t commit = 0;
+			uint16_t line = 0;
+			bool is_valid = false;
+		};
+		bool reuses_repeated_lines_ = false;
+		uint64_t line_hash_ = 0;
+		size_t line_in_frame_ = 0;
+		size_t lines_committed_ = 0;
+		std::vector<RepeatedLine> repeated_lines_;
+		void invalidate_repeated_lines();
+
 		// By convention everything in the PointerSet points to the next instance
 		// of whatever it is that will be used. So a client should start with whatever
 		// is pointed to by the read pointers and carry until it gets to a value that
@@ -256,9 +329,13 @@ class BufferingScanTarget: public Outputs::Display::ScanTarget {
 		size_t line_buffer_size_ = 0;
 
 		// Current modals and whether they've yet been returned
-		// from a call to @c get_new_modals.
-		Modals modals_;
+		// from a call to @c get_new_modals; also those originally
+		// requested, which may differ if this is a thumbnail.
+		Modals modals_, requested_modals_;
 		std::atomic<bool> modals_are_dirty_ = false;
+		bool has_modals_ = false;
+		std::atomic<bool> is_thumbnail_ = false;
+		void apply_modals();
 
 		// Provides a per-data size implementation of end_data; a previous
 		// implementation used blind memcpy and that turned into something
@@ -0,0 +1,156 @@
+//
+//  PipelineDescription.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "PipelineDescription.hpp"
+
+#include "../../SignalProcessing/FIRFilter.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Outputs::Display;
+
+namespace {
+
+constexpr float Pi = 3.141592654f;
+
+/// @returns the proper 1d kernel to apply a box filter around a certain point a pixel density of @c radians_per_pixel and applying an
+///		angular limit of @c cutoff. The values returned will be the first eight of a fifteen-point filter that is symmetrical around its centre.
+std::array<float, 8> box_coefficients(float radians_per_pixel, float cutoff) {
+	std::array<float, 8> filter;
+	float total = 0.0f;
+
+	for(size_t c = 0; c < 8; ++c) {
+		// This coefficient occupies the angular window [6.5-c, 7.5-c]*radians_per_pixel.
+		const float start_angle = (6.5f - float(c)) * radians_per_pixel;
+		const float end_angle = (7.5f - float(c)) * radians_per_pixel;
+
+		float coefficient = 0.0f;
+		if(end_angle < cutoff) {
+			coefficient = 1.0f;
+		} else if(start_angle >= cutoff) {
+			coefficient = 0.0f;
+		} else {
+			coefficient = (cutoff - start_angle) / radians_per_pixel;
+		}
+		total += 2.0f * coefficient;	// All but the centre coefficient will be used twice.
+		filter[c] = coefficient;
+	}
+	total = total - filter[7];			// As per above; ensure the centre coefficient is counted only once.
+
+	for(size_t c = 0; c < 8; ++c) {
+		filter[c] /= total;
+	}
+
+	return filter;
+}
+
+}
+
+PipelineDescription::PipelineDescription(const ScanTarget::Modals &modals, float display_gamma) :
+	to_rgb(to_rgb_matrix(modals.composite_colour_space)),
+	from_rgb(from_rgb_matrix(modals.composite_colour_space)),
+	output_multiplier(modals.brightness),
+	output_gamma(display_gamma / modals.intended_gamma) {
+
+	// Lines need to be composed and processed only for S-Video and composite colour; RGB and
+	// monochrome composite can be painted directly.
+	switch(modals.display_type) {
+		default:							type = Type::DirectToDisplay;	break;
+		case DisplayType::SVideo:			type = Type::SVideo;			break;
+		case DisplayType::CompositeColour:	type = Type::CompositeColour;	break;
+	}
+
+	clocks_per_angle = float(modals.cycles_per_line) * float(modals.colour_cycle_denominator) / float(modals.colour_cycle_numerator);
+	line_buffer_pixels_per_line = modals.cycles_per_line;
+	if(type == Type::DirectToDisplay) {
+		return;
+	}
+
+	// Pick a suitable cycle multiplier: enough to provide at least four samples per colour cycle,
+	// subject to the limit of the line buffer's width.
+	const float minimum_size = 4.0f * float(modals.colour_cycle_numerator) / float(modals.colour_cycle_denominator);
+	while(float(cycles_multiplier * modals.cycles_per_line) < minimum_size) {
+		++cycles_multiplier;
+
+		if(cycles_multiplier * modals.cycles_per_line > 2048) {
+			--cycles_multiplier;
+			break;
+		}
+	}
+	line_buffer_pixels_per_line = modals.cycles_per_line * cycles_multiplier;
+
+	// Compute radians per pixel.
+	const float colour_cycles_per_line = float(modals.colour_cycle_numerator) / float(modals.colour_cycle_denominator);
+	const float radians_per_pixel = (colour_cycles_per_line * Pi * 2.0f) / float(line_buffer_pixels_per_line);
+
+	// Generate the chrominance filter.
+	const bool is_svideo = type == Type::SVideo;
+	const auto chroma_coefficients = box_coefficients(radians_per_pixel, Pi * 2.0f);
+	for(size_t c = 0; c < 8; ++c) {
+		// Bit of a fix here: if the pipeline is for composite then assume that chroma separation wasn't
+		// perfect and deemphasise the colour.
+		chroma_kernel[c][1] = chroma_kernel[c][2] = (is_svideo ? 2.0f : 1.25f) * chroma_coefficients[c];
+		chroma_kernel[c][0] = 0.0f;
+		if(fabsf(chroma_coefficients[c]) < 0.01f) {
+			chroma_kernel_size -= 2;
+		}
+	}
+	chroma_kernel[7][0] = 1.0f;
+
+	// Luminance will be very soft as a result of the separation phase; apply a sharpen filter to try to undo that.
+	//
+	// This is applied separately in order to partition three parts of the signal rather than two:
+	//
+	//	1) the luminance;
+	//	2) not the luminance:
+	//		2a) the chrominance; and
+	//		2b) some noise.
+	//
+	// There are real numerical hazards here given the low number of taps I am permitting to be used, so the sharpen
+	// filter below is just one that I found worked well. Since all numbers are fixed, the actual cutoff frequency is
+	// going to be a function of the input clock, which is a bit phoney but the best way to stay safe within the
+	// PCM sampling limits.
+	if(!is_svideo) {
+		SignalProcessing::FIRFilter sharpen_filter(15, 1368, 60.0f, 227.5f);
+		const auto sharpen = sharpen_filter.get_coefficients();
+		size_t sharpen_filter_size = 15;
+		bool is_start = true;
+		for(size_t c = 0; c < 8; ++c) {
+			chroma_kernel[c][0] = sharpen[c];
+			if(fabsf(sharpen[c]) > 0.01f) is_start = false;
+			if(is_start) sharpen_filter_size -= 2;
+		}
+		chroma_kernel_size = std::max(chroma_kernel_size, sharpen_filter_size);
+	}
+
+	// Generate the luminance separation filter and determine its required size.
+	luma_kernel = box_coefficients(radians_per_pixel, Pi);
+	for(size_t c = 0; c < 8; ++c) {
+		if(fabsf(luma_kernel[c]) < 0.01f) {
+			luma_kernel_size -= 2;
+		}
+	}
+}
+
+bool PipelineDescription::has(Stage stage) const {
+	switch(stage) {
+		default:					return true;
+		case Stage::Composition:
+		case Stage::Demodulation:	return type != Type::DirectToDisplay;
+		case Stage::Separation:		return type == Type::CompositeColour;
+	}
+}
+
+bool PipelineDescription::has_output_multiplier() const {
+	return fabsf(output_multiplier - 1.0f) > 0.05f;
+}
+
+bool PipelineDescription::has_output_gamma() const {
+	return fabsf(output_gamma - 1.0f) > 0.01f;
+}
@@ -0,0 +1,108 @@
+//
+//  PipelineDescription.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef PipelineDescription_hpp
+#define PipelineDescription_hpp
+
+#include "../ScanTarget.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Describes, independently of any particular graphics API, the stages by which the scans
+	collected by a BufferingScanTarget should be turned into a display for a given set of modals,
+	and the parameters of each of those stages.
+
+	Backends remain free to implement the stages however suits them — e.g. to merge some, or
+	to compose lines even when that isn't strictly necessary — but should obtain any filter
+	kernels, sizes and output adjustments from here rather than deriving their own.
+*/
+struct PipelineDescription {
+	PipelineDescription(const ScanTarget::Modals &modals, float display_gamma);
+
+	enum class Type {
+		/// Scans are painted directly to the display.
+		DirectToDisplay,
+		/// Scans are composed into lines, which are then demodulated and filtered
+		/// before being painted to the display.
+		SVideo,
+		/// Scans are composed into lines, luminance is separated from chrominance
+		/// and chrominance is then demodulated and filtered before lines are painted
+		/// to the display.
+		CompositeColour,
+	} type;
+
+	enum class Stage {
+		/// Paints scans into a line buffer, modulating them to composite or S-Video as necessary.
+		Composition,
+		/// Separates luminance from a composed composite line.
+		Separation,
+		/// Demodulates and filters the chrominance of a composed line.
+		Demodulation,
+		/// Paints the final result to the display.
+		Output,
+	};
+
+	/// @returns @c true if @c stage is part of this pipeline; @c false otherwise.
+	bool has(Stage stage) const;
+
+	// MARK: - Composition.
+
+	/// The number of samples per input cycle at which lines should be composed; this is chosen
+	/// so that there are at least four samples per colour cycle.
+	int cycles_multiplier = 1;
+
+	/// The number of samples that make up each composed line.
+	int line_buffer_pixels_per_line = 0;
+
+	/// The number of input cycles per complete colour cycle.
+	float clocks_per_angle = 0.0f;
+
+	// MARK: - Separation.
+
+	/// The first half, plus centre, of a symmetric fifteen-point filter that isolates luminance.
+	std::array<float, 8> luma_kernel{};
+
+	/// The number of points of @c luma_kernel that are actually significant.
+	size_t luma_kernel_size = 15;
+
+	// MARK: - Demodulation.
+
+	/// The first half, plus centre, of a symmetric fifteen-point filter which, per sample, provides
+	/// a sharpening filter for luminance and then low-pass filters for each of the two chroma channels.
+	std::array<std::array<float, 3>, 8> chroma_kernel{};
+
+	/// The number of points of @c chroma_kernel that are actually significant.
+	size_t chroma_kernel_size = 15;
+
+	// MARK: - Output.
+
+	/// Matrices to convert between RGB and the luminance/chrominance space in use; cf. to_rgb_matrix and from_rgb_matrix.
+	std::array<float, 9> to_rgb, from_rgb;
+
+	/// A multiplier to apply to output colours.
+	float output_multiplier = 1.0f;
+
+	/// The power to which output colours should be raised.
+	float output_gamma = 1.0f;
+
+	/// @returns @c true if @c output_multiplier differs sufficiently from 1.0 to be worth applying.
+	bool has_output_multiplier() const;
+
+	/// @returns @c true if @c output_gamma differs sufficiently from 1.0 to be worth applying.
+	bool has_output_gamma() const;
+};
+
+}
+}
+
+#endif /* PipelineDescription_hpp */
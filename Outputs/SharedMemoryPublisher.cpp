@@ -0,0 +1,117 @@
+//
+//  SharedMemoryPublisher.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "SharedMemoryPublisher.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_SHARED_MEMORY
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace Outputs::Display;
+
+// Atomics are used in memory shared between processes, so must not rely on any process-local lock.
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+SharedMemoryPublisher::SharedMemoryPublisher(const std::string &name, int width, int height, int slot_count) : name_(name) {
+#ifdef HAS_SHARED_MEMORY
+	const uint32_t stride = uint32_t(width * 4);
+	const uint32_t slot_size = uint32_t((sizeof(Slot) + size_t(stride) * size_t(height) + 63) & ~size_t(63));
+	size_ = sizeof(Header) + size_t(slot_size) * size_t(slot_count);
+
+	const int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if(fd < 0) throw Error::CantCreate;
+	if(ftruncate(fd, off_t(size_))) {
+		close(fd);
+		shm_unlink(name_.c_str());
+		throw Error::CantCreate;
+	}
+	void *const mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if(mapping == MAP_FAILED) {
+		shm_unlink(name_.c_str());
+		throw Error::CantCreate;
+	}
+	mapping_ = static_cast<uint8_t *>(mapping);
+
+	// The object is zero-filled upon creation, so all slots start black and at sequence 0.
+	header_ = new (mapping_) Header;
+	header_->version = 1;
+	header_->slot_count = uint32_t(slot_count);
+	header_->width = uint32_t(width);
+	header_->height = uint32_t(height);
+	header_->stride = stride;
+	header_->slot_size = slot_size;
+	header_->frame_number.store(0, std::memory_order_relaxed);
+	for(int c = 0; c < slot_count; c++) {
+		new (&mapping_[sizeof(Header) + size_t(slot_size) * size_t(c)]) Slot{};
+	}
+
+	// Publish the magic number last, so that a reader that sees it will see a complete header.
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(header_->magic, "CLKFRAME", 8);
+#else
+	(void)width;
+	(void)height;
+	(void)slot_count;
+	throw Error::CantCreate;
+#endif
+}
+
+SharedMemoryPublisher::~SharedMemoryPublisher() {
+#ifdef HAS_SHARED_MEMORY
+	munmap(mapping_, size_);
+	shm_unlink(name_.c_str());
+#endif
+}
+
+void SharedMemoryPublisher::publish_frame(const uint8_t *pixels, int width, int height, size_t stride, uint64_t timestamp, bool is_bottom_up) {
+	const uint32_t frame_number = header_->frame_number.load(std::memory_order_relaxed);
+	uint8_t *const slot_base = &mapping_[sizeof(Header) + size_t(header_->slot_size) * (frame_number % header_->slot_count)];
+	Slot &slot = *reinterpret_cast<Slot *>(slot_base);
+	uint8_t *const target = slot_base + sizeof(Slot);
+
+	// Mark the slot as being written.
+	const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Copy the frame, cropping or padding as required.
+	const int output_width = int(header_->width);
+	const int output_height = int(header_->height);
+	const int copy_width = std::min(width, output_width);
+	const int copy_height = std::min(height, output_height);
+	if(copy_width < output_width || copy_height < output_height) {
+		std::memset(target, 0, size_t(header_->stride) * size_t(output_height));
+	}
+	for(int y = 0; y < copy_height; y++) {
+		const int row = is_bottom_up ? height - 1 - y : y;
+		std::memcpy(&target[size_t(y) * header_->stride], &pixels[size_t(row) * stride], size_t(copy_width * 4));
+	}
+	slot.frame_number = frame_number + 1;
+	slot.timestamp = timestamp;
+
+	// Mark the slot as complete, then announce it.
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+	header_->frame_number.store(frame_number + 1, std::memory_order_release);
+
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<uint32_t *>(&header_->frame_number), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+#endif
+}
@@ -0,0 +1,91 @@
+//
+//  SharedMemoryPublisher.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SharedMemoryPublisher_hpp
+#define SharedMemoryPublisher_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Publishes a sequence of fixed-size RGBA frames into a named POSIX shared-memory object, from which
+	any number of other processes may read them without copying and without the publisher ever waiting
+	for them.
+
+	The object begins with a @c Header, which is followed by @c slot_count slots, each of which is a
+	@c Slot and then @c height rows of @c stride bytes of pixels, stored top row first. Frames are written
+	to slots in rotation; after each the header's @c frame_number is incremented and, on Linux, a futex wake
+	is issued on it so that readers may sleep on it rather than polling.
+
+	Each slot carries a sequence number which is odd while the slot is being written, to allow readers to
+	detect that a slot was overwritten while they were reading it: a reader should note the sequence,
+	read the pixels, and then discard them if the sequence has since changed.
+
+	The shared-memory object is unlinked when this publisher is destroyed.
+*/
+class SharedMemoryPublisher {
+	public:
+		enum class Error {
+			CantCreate
+		};
+
+		struct Header {
+			/// Always "CLKFRAME".
+			char magic[8];
+			uint32_t version;
+			uint32_t slot_count;
+			uint32_t width, height, stride;
+			/// The size of each slot including its @c Slot metadata, in bytes; the first slot begins @c sizeof(Header) bytes in.
+			uint32_t slot_size;
+			/// The number of frames published so far; the most recent is in slot (frame_number - 1) % slot_count.
+			std::atomic<uint32_t> frame_number;
+		};
+
+		struct Slot {
+			std::atomic<uint32_t> sequence;
+			uint32_t frame_number;
+			/// The caller-supplied time at which this frame was produced, in nanoseconds.
+			uint64_t timestamp;
+		};
+
+		/*!
+			Creates, or replaces, the shared-memory object @c name — which should begin with a slash.
+
+			@throws Error::CantCreate if the object could not be created and mapped.
+		*/
+		SharedMemoryPublisher(const std::string &name, int width, int height, int slot_count = 3);
+		~SharedMemoryPublisher();
+
+		/*!
+			Publishes a frame of four-byte RGBA pixels.
+
+			If the source differs in size from the output then it is aligned to the top left, being cropped or
+			surrounded by black.
+
+			@param stride The distance between the starts of successive rows, in bytes.
+			@param timestamp The time at which this frame was produced, in nanoseconds and in any consistent base.
+			@param is_bottom_up @c true if rows are supplied from the bottom of the image upwards, as by OpenGL; @c false otherwise.
+		*/
+		void publish_frame(const uint8_t *pixels, int width, int height, size_t stride, uint64_t timestamp, bool is_bottom_up = false);
+
+	private:
+		const std::string name_;
+		uint8_t *mapping_ = nullptr;
+		size_t size_ = 0;
+		Header *header_ = nullptr;
+};
+
+}
+}
+
+#endif /* SharedMemoryPublisher_hpp */
@@ -0,0 +1,719 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#ifndef M_PI
+#define M_PI 3.1415926f
+#endif
+
+using namespace Outputs::Display::Software;
+
+namespace {
+
+/// Applies to @c source the symmetric fifteen-point filter of which @c kernel is the first half plus centre,
+/// using only its central @c size points, writing the results for [begin, end) to @c target.
+/// @c source must be valid for seven samples either side of that range.
+///
+/// The filter is applied a tap at a time across the whole range so that the inner loop is a simple
+/// multiply-accumulate that the compiler can vectorise.
+void apply_filter(float *target, const float *source, int begin, int end, const std::array<float, 8> &kernel, size_t size) {
+	std::fill(target + begin, target + end, 0.0f);
+
+	const int first_tap = (15 - int(size)) / 2;
+	for(int tap = first_tap; tap < 15 - first_tap; ++tap) {
+		const float coefficient = kernel[size_t(tap < 8 ? tap : 14 - tap)];
+		const float *const input = source + tap - 7;
+		for(int x = begin; x < end; ++x) {
+			target[x] += coefficient * input[x];
+		}
+	}
+}
+
+}
+
+ScanTarget::ScanTarget(int width, int height, float output_gamma) :
+	output_gamma_(output_gamma),
+	palette_area_(size_t(WriteAreaHeight) * PaletteSize),
+	scan_buffer_(LineBufferHeight*5),
+	line_buffer_(LineBufferHeight),
+	line_metadata_buffer_(LineBufferHeight) {
+
+	set_palette_area(palette_area_.data());
+	set_scan_buffer(scan_buffer_.data(), scan_buffer_.size());
+	set_line_buffer(line_buffer_.data(), line_metadata_buffer_.data(), line_buffer_.size());
+	set_output_size(width, height);
+}
+
+void ScanTarget::set_output_size(int width, int height) {
+	perform([=] {
+		width_ = std::max(width, 1);
+		height_ = std::max(height, 1);
+
+		framebuffer_.clear();
+		framebuffer_.resize(size_t(width_ * height_), pack(0, 0, 0));
+		row_painted_.assign(size_t(height_), false);
+		previous_row_painted_.assign(size_t(height_), false);
+	});
+}
+
+// MARK: - Colour conversion.
+
+uint32_t ScanTarget::pack(uint8_t red, uint8_t green, uint8_t blue) {
+	// Pack via memory so that the byte order is as documented regardless of host endianness.
+	const uint8_t bytes[4] = {red, green, blue, 0xff};
+	uint32_t result;
+	memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+uint32_t ScanTarget::pack_adjusted(float red, float green, float blue) const {
+	const auto channel = [this](float value) {
+		return channel_table_[size_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f)];
+	};
+	return pack(channel(red), channel(green), channel(blue));
+}
+
+void ScanTarget::setup_pipeline() {
+	const auto &modals = BufferingScanTarget::modals();
+
+	// Resize the write area only if required.
+	const size_t data_type_size = Outputs::Display::size_for_data_type(modals.input_data_type);
+	const size_t required_size = WriteAreaWidth*WriteAreaHeight*data_type_size;
+	if(required_size != write_area_.size()) {
+		write_area_.resize(required_size);
+		set_write_area(write_area_.data());
+	}
+
+	// Build the per-channel table, applying brightness and gamma with the same
+	// thresholds as the OpenGL pipeline.
+	const bool adjust_brightness = std::fabs(modals.brightness - 1.0f) > 0.05f;
+	const bool adjust_gamma = std::fabs(output_gamma_ - modals.intended_gamma) > 0.05f;
+	const float gamma_ratio = output_gamma_ / modals.intended_gamma;
+	channel_table_is_identity_ = !adjust_brightness && !adjust_gamma;
+	for(size_t c = 0; c < channel_table_.size(); ++c) {
+		float value = float(c) / 255.0f;
+		if(adjust_brightness) value *= modals.brightness;
+		if(adjust_gamma) value = std::pow(value, gamma_ratio);
+		channel_table_[c] = uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	// If decoding is required then input should be converted without adjustment, which
+	// is instead applied to decoded output.
+	pipeline_.reset();
+	const PipelineDescription pipeline(modals, output_gamma_);
+	if(pipeline.has(PipelineDescription::Stage::Demodulation)) {
+		pipeline_ = pipeline;
+		output_table_ = channel_table_;
+		channel_table_is_identity_ = true;
+		for(size_t c = 0; c < channel_table_.size(); ++c) {
+			channel_table_[c] = uint8_t(c);
+		}
+
+		if(!decode_pool_) {
+			decode_pool_ = std::make_unique<Concurrency::WorkStealingPool>();
+			decode_buffers_.resize(decode_pool_->size());
+		}
+	}
+
+	// Build a palette for any type that can be indexed.
+	palette_.clear();
+	switch(modals.input_data_type) {
+		case InputDataType::Luminance1:
+			palette_.resize(256);
+			for(size_t c = 0; c < 256; ++c) {
+				const float level = c ? 1.0f : 0.0f;
+				palette_[c] = pack_adjusted(level, level, level);
+			}
+		break;
+
+		case InputDataType::Luminance8:
+			palette_.resize(256);
+			for(size_t c = 0; c < 256; ++c) {
+				const float level = float(c) / 255.0f;
+				palette_[c] = pack_adjusted(level, level, level);
+			}
+		break;
+
+		case InputDataType::Red1Green1Blue1:
+			palette_.resize(256);
+			for(size_t c = 0; c < 256; ++c) {
+				palette_[c] = pack_adjusted(float((c >> 2) & 1), float((c >> 1) & 1), float(c & 1));
+			}
+		break;
+
+		case InputDataType::Red2Green2Blue2:
+			palette_.resize(256);
+			for(size_t c = 0; c < 256; ++c) {
+				palette_[c] = pack_adjusted(float((c >> 4) & 3) / 3.0f, float((c >> 2) & 3) / 3.0f, float(c & 3) / 3.0f);
+			}
+		break;
+
+		case InputDataType::Red4Green4Blue4:
+		case InputDataType::Luminance8Phase8: {
+			// Both of these are two bytes per pixel; index by native-endian 16-bit word
+			// but decode by byte, to be independent of host byte order.
+			palette_.resize(65536);
+			const auto matrix = to_rgb_matrix(modals.composite_colour_space);
+			for(size_t c = 0; c < 65536; ++c) {
+				uint8_t bytes[2];
+				const uint16_t word = uint16_t(c);
+				memcpy(bytes, &word, sizeof(word));
+
+				if(modals.input_data_type == InputDataType::Red4Green4Blue4) {
+					palette_[c] = pack_adjusted(float(bytes[0] & 0xf) / 15.0f, float(bytes[1] >> 4) / 15.0f, float(bytes[1] & 0xf) / 15.0f);
+					continue;
+				}
+
+				// Luminance8Phase8: phase is on a 128-unit circle, and anything above 192 means no colour.
+				// A nominal chroma amplitude is assumed. A monochrome display, including that substituted
+				// for thumbnails, shows luminance only.
+				const float luminance = float(bytes[0]) / 255.0f;
+				float chroma[2] = {0.0f, 0.0f};
+				if(bytes[1] <= 192 && modals.display_type != DisplayType::CompositeMonochrome) {
+					const float angle = float(bytes[1]) * 2.0f * float(M_PI) / 128.0f;
+					constexpr float amplitude = 0.25f;
+					chroma[0] = amplitude * std::cos(angle);
+					chroma[1] = amplitude * std::sin(angle);
+				}
+				palette_[c] = pack_adjusted(
+					matrix[0]*luminance + matrix[3]*chroma[0] + matrix[6]*chroma[1],
+					matrix[1]*luminance + matrix[4]*chroma[0] + matrix[7]*chroma[1],
+					matrix[2]*luminance + matrix[5]*chroma[0] + matrix[8]*chroma[1]
+				);
+			}
+		} break;
+
+		// Four-byte types are converted directly, as are palette indices
+		// since their palettes accompany the data.
+		case InputDataType::Red8Green8Blue8:
+		case InputDataType::PhaseLinkedLuminance8:
+		case InputDataType::Palette8:
+		break;
+	}
+}
+
+template <typename SourceType> void ScanTarget::convert_palette(uint32_t *target, const SourceType *source, int length, uint32_t position, uint32_t step) const {
+	const uint32_t *const palette = palette_.data();
+	if(step == 0x10000) {
+		// Exactly one input sample per output pixel; this is the common case.
+		source += position >> 16;
+		for(int c = 0; c < length; ++c) {
+			target[c] = palette[source[c]];
+		}
+		return;
+	}
+
+	for(int c = 0; c < length; ++c) {
+		target[c] = palette[source[position >> 16]];
+		position += step;
+	}
+}
+
+void ScanTarget::convert_rgb8(uint32_t *target, const uint32_t *source, int length, uint32_t position, uint32_t step) const {
+	// The fourth byte of input is vacant, so just force it to be opaque.
+	uint32_t alpha;
+	const uint8_t alpha_bytes[4] = {0, 0, 0, 0xff};
+	memcpy(&alpha, alpha_bytes, sizeof(alpha));
+
+	if(channel_table_is_identity_ && step == 0x10000) {
+		source += position >> 16;
+		for(int c = 0; c < length; ++c) {
+			target[c] = source[c] | alpha;
+		}
+		return;
+	}
+
+	const auto &table = channel_table_;
+	for(int c = 0; c < length; ++c) {
+		uint8_t bytes[4];
+		memcpy(bytes, &source[position >> 16], sizeof(bytes));
+		target[c] = pack(table[bytes[0]], table[bytes[1]], table[bytes[2]]);
+		position += step;
+	}
+}
+
+void ScanTarget::convert_indexed(uint32_t *target, const uint8_t *source, const uint32_t *palette, int length, uint32_t position, uint32_t step) const {
+	// Palette entries are in Red8Green8Blue8 form, so map through the channel table as per convert_rgb8.
+	uint32_t alpha;
+	const uint8_t alpha_bytes[4] = {0, 0, 0, 0xff};
+	memcpy(&alpha, alpha_bytes, sizeof(alpha));
+
+	if(channel_table_is_identity_) {
+		for(int c = 0; c < length; ++c) {
+			target[c] = palette[source[position >> 16]] | alpha;
+			position += step;
+		}
+		return;
+	}
+
+	const auto &table = channel_table_;
+	for(int c = 0; c < length; ++c) {
+		uint8_t bytes[4];
+		memcpy(bytes, &palette[source[position >> 16]], sizeof(bytes));
+		target[c] = pack(table[bytes[0]], table[bytes[1]], table[bytes[2]]);
+		position += step;
+	}
+}
+
+void ScanTarget::convert_phase_linked(uint32_t *target, const uint32_t *source, int length, uint32_t position, uint32_t step) const {
+	// Without a composite decoder, just average the four samples to obtain a luminance.
+	const auto &table = channel_table_;
+	for(int c = 0; c < length; ++c) {
+		uint8_t bytes[4];
+		memcpy(bytes, &source[position >> 16], sizeof(bytes));
+		const uint8_t level = table[(bytes[0] + bytes[1] + bytes[2] + bytes[3] + 2) >> 2];
+		target[c] = pack(level, level, level);
+		position += step;
+	}
+}
+
+// MARK: - Composition.
+
+void ScanTarget::compose_scans(const Scan *begin, const Scan *end, uint32_t *row) {
+	const auto data_type = BufferingScanTarget::modals().input_data_type;
+	const size_t data_type_size = write_area_data_size();
+
+	for(auto scan = begin; scan != end; ++scan) {
+		const auto &end_points = scan->scan.end_points;
+		const int start_clock = std::min(int(end_points[0].cycles_since_end_of_horizontal_retrace), LineBufferWidth);
+		const int end_clock = std::min(int(end_points[1].cycles_since_end_of_horizontal_retrace), LineBufferWidth);
+		const int length = end_clock - start_clock;
+		if(length <= 0) continue;
+
+		// Step through source data at a fixed-point rate, sampling from pixel centres.
+		const int data_length = int(end_points[1].data_offset) - int(end_points[0].data_offset);
+		const uint32_t step = uint32_t((int64_t(std::max(data_length, 0)) << 16) / length);
+		const uint32_t position = (uint32_t(end_points[0].data_offset) << 16) + (step >> 1);
+		const uint8_t *const source = &write_area_[size_t(scan->data_y) * WriteAreaWidth * data_type_size];
+
+		uint32_t *const target = &row[start_clock];
+		switch(data_type) {
+			case InputDataType::Luminance1:
+			case InputDataType::Luminance8:
+			case InputDataType::Red1Green1Blue1:
+			case InputDataType::Red2Green2Blue2:
+				convert_palette(target, source, length, position, step);
+			break;
+
+			case InputDataType::Red4Green4Blue4:
+			case InputDataType::Luminance8Phase8:
+				convert_palette(target, reinterpret_cast<const uint16_t *>(source), length, position, step);
+			break;
+
+			case InputDataType::Red8Green8Blue8:
+				convert_rgb8(target, reinterpret_cast<const uint32_t *>(source), length, position, step);
+			break;
+
+			case InputDataType::PhaseLinkedLuminance8:
+				convert_phase_linked(target, reinterpret_cast<const uint32_t *>(source), length, position, step);
+			break;
+
+			case InputDataType::Palette8:
+				convert_indexed(target, source, &palette_area_[size_t(scan->data_y) * PaletteSize], length, position, step);
+			break;
+		}
+	}
+}
+
+void ScanTarget::output_line(const Line &line, const uint32_t *row, int cycles_multiplier) {
+	const auto &modals = BufferingScanTarget::modals();
+	const auto &visible_area = modals.visible_area;
+
+	// Determine the vertical extent of this line; each is painted to cover the space between
+	// it and the next so that there are no gaps regardless of output size.
+	const float y = (float(line.end_points[0].y) + float(line.end_points[1].y)) * 0.5f / float(modals.output_scale.y);
+	const float row_height = float(height_) / (visible_area.size.height * float(std::max(modals.expected_vertical_lines, 1)));
+	const float top = (y - visible_area.origin.y) * float(height_) / visible_area.size.height;
+	const int first_row = std::max(int(std::floor(top)), 0);
+	const int end_row = std::min(std::max(int(std::ceil(top + row_height)), first_row + 1), height_);
+	if(first_row >= end_row) return;
+
+	// Determine the horizontal extent.
+	const float left = (float(line.end_points[0].x) / float(modals.output_scale.x) - visible_area.origin.x) * float(width_) / visible_area.size.width;
+	const float right = (float(line.end_points[1].x) / float(modals.output_scale.x) - visible_area.origin.x) * float(width_) / visible_area.size.width;
+	if(right <= left) return;
+
+	const int first_column = std::max(int(std::ceil(left - 0.5f)), 0);
+	const int end_column = std::min(int(std::ceil(right - 0.5f)), width_);
+	if(first_column >= end_column) return;
+
+	// Sample from the composed row at a fixed-point rate.
+	const float start_clock = float(line.end_points[0].cycles_since_end_of_horizontal_retrace * cycles_multiplier);
+	const float end_clock = float(line.end_points[1].cycles_since_end_of_horizontal_retrace * cycles_multiplier);
+	const float clocks_per_pixel = (end_clock - start_clock) / (right - left);
+	const float initial_clock = start_clock + (float(first_column) + 0.5f - left) * clocks_per_pixel;
+
+	int64_t position = int64_t(initial_clock * 65536.0f);
+	const int64_t step = int64_t(clocks_per_pixel * 65536.0f);
+	constexpr int64_t max_position = int64_t(LineBufferWidth - 1) << 16;
+
+	uint32_t *const target = &framebuffer_[size_t(first_row * width_)];
+	for(int c = first_column; c < end_column; ++c) {
+		target[c] = row[std::clamp(position, int64_t(0), max_position) >> 16];
+		position += step;
+	}
+
+	// Duplicate for any further rows this line covers.
+	const size_t span = size_t(end_column - first_column) * sizeof(uint32_t);
+	for(int r = first_row + 1; r < end_row; ++r) {
+		memcpy(&framebuffer_[size_t(r * width_ + first_column)], &target[first_column], span);
+	}
+	std::fill(row_painted_.begin() + first_row, row_painted_.begin() + end_row, true);
+}
+
+void ScanTarget::begin_frame(bool previous_frame_was_complete) {
+	// If the previous frame was complete then clear anything it didn't touch, to avoid
+	// retaining stale content; if it wasn't then it's better to leave older output in place.
+	if(previous_frame_was_complete) {
+		const uint32_t black = pack(0, 0, 0);
+		for(int r = 0; r < height_; ++r) {
+			if(!row_painted_[size_t(r)]) {
+				std::fill(&framebuffer_[size_t(r * width_)], &framebuffer_[size_t((r + 1) * width_)], black);
+			}
+		}
+	}
+
+	std::swap(row_painted_, previous_row_painted_);
+	std::fill(row_painted_.begin(), row_painted_.end(), false);
+	++completed_frames_;
+}
+
+// MARK: - Composite and S-Video decoding.
+
+ScanTarget::DecodeBuffers::DecodeBuffers() :
+	signal(LineBufferWidth + 2*FilterPadding),
+	cosine(LineBufferWidth + 2*FilterPadding),
+	sine(LineBufferWidth + 2*FilterPadding),
+	amplitude(LineBufferWidth + 2*FilterPadding),
+	luma(LineBufferWidth + 2*FilterPadding),
+	i(LineBufferWidth + 2*FilterPadding),
+	q(LineBufferWidth + 2*FilterPadding),
+	filtered_luma(LineBufferWidth + 2*FilterPadding),
+	filtered_i(LineBufferWidth + 2*FilterPadding),
+	filtered_q(LineBufferWidth + 2*FilterPadding),
+	source(LineBufferWidth) {}
+
+uint8_t ScanTarget::output_level(float value) const {
+	return output_table_[size_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f)];
+}
+
+void ScanTarget::modulate_scans(const Scan *begin, const Scan *end, DecodeBuffers &buffers) const {
+	const auto data_type = BufferingScanTarget::modals().input_data_type;
+	const size_t data_type_size = write_area_data_size();
+	const bool is_svideo = pipeline_->type == PipelineDescription::Type::SVideo;
+	const int cycles_multiplier = pipeline_->cycles_multiplier;
+	const auto &from_rgb = pipeline_->from_rgb;
+
+	for(auto scan = begin; scan != end; ++scan) {
+		const auto &end_points = scan->scan.end_points;
+		const int start_x = std::min(int(end_points[0].cycles_since_end_of_horizontal_retrace) * cycles_multiplier, LineBufferWidth);
+		const int end_x = std::min(int(end_points[1].cycles_since_end_of_horizontal_retrace) * cycles_multiplier, LineBufferWidth);
+		const int length = end_x - start_x;
+		if(length <= 0) continue;
+
+		// Step through source data as per compose_scans.
+		const int data_length = int(end_points[1].data_offset) - int(end_points[0].data_offset);
+		const uint32_t step = uint32_t((int64_t(std::max(data_length, 0)) << 16) / length);
+		const uint32_t position = (uint32_t(end_points[0].data_offset) << 16) + (step >> 1);
+		const uint8_t *const source = &write_area_[size_t(scan->data_y) * WriteAreaWidth * data_type_size];
+
+		// Determine the colour subcarrier at each sample; angles are in 64ths of a cycle.
+		const int offset = FilterPadding + start_x;
+		float *const cosine = &buffers.cosine[size_t(offset)];
+		float *const sine = &buffers.sine[size_t(offset)];
+		const float start_phase = float(end_points[0].composite_angle) / 64.0f;
+		const float phase_step = float(end_points[1].composite_angle - end_points[0].composite_angle) / (64.0f * float(length));
+		for(int c = 0; c < length; ++c) {
+			const float angle = 2.0f * float(M_PI) * (start_phase + phase_step * (float(c) + 0.5f));
+			cosine[c] = std::cos(angle);
+			sine[c] = std::sin(angle);
+		}
+
+		// Obtain luminance and chrominance for each sample; chrominance is already modulated
+		// onto the subcarrier. Luminance-only types carry no chrominance and are
+		// never mixed with it.
+		float *const luma = &buffers.luma[size_t(offset)];
+		float *const chroma = &buffers.signal[size_t(offset)];
+		bool is_luminance_only = false;
+		switch(data_type) {
+			case InputDataType::Luminance1:
+			case InputDataType::Luminance8: {
+				is_luminance_only = true;
+				convert_palette(buffers.source.data(), source, length, position, step);
+				for(int c = 0; c < length; ++c) {
+					uint8_t bytes[4];
+					memcpy(bytes, &buffers.source[size_t(c)], sizeof(bytes));
+					luma[c] = float(bytes[0]) / 255.0f;
+					chroma[c] = 0.0f;
+				}
+			} break;
+
+			case InputDataType::PhaseLinkedLuminance8: {
+				// Pick whichever of the four samples corresponds to the current quarter of the colour cycle.
+				is_luminance_only = true;
+				uint32_t sample_position = position;
+				for(int c = 0; c < length; ++c) {
+					const int quarter = int((start_phase + phase_step * (float(c) + 0.5f)) * 4.0f) & 3;
+					luma[c] = float(source[(sample_position >> 16) * 4 + uint32_t(quarter)]) / 255.0f;
+					chroma[c] = 0.0f;
+					sample_position += step;
+				}
+			} break;
+
+			case InputDataType::Luminance8Phase8: {
+				// Phase is a proportion of a circle; anything above 0.75 means no colour.
+				uint32_t sample_position = position;
+				for(int c = 0; c < length; ++c) {
+					const uint8_t *const sample = &source[(sample_position >> 16) * 2];
+					const float phase = float(sample[1]) / 255.0f;
+					luma[c] = float(sample[0]) / 255.0f;
+					chroma[c] = phase <= 0.75f ?
+						std::cos(2.0f * float(M_PI) * (start_phase + phase_step * (float(c) + 0.5f) + 2.0f * phase)) : 0.0f;
+					sample_position += step;
+				}
+			} break;
+
+			case InputDataType::Red1Green1Blue1:
+			case InputDataType::Red2Green2Blue2:
+			case InputDataType::Red4Green4Blue4:
+			case InputDataType::Red8Green8Blue8:
+			case InputDataType::Palette8: {
+				uint32_t *const rgb = buffers.source.data();
+				switch(data_type) {
+					default:
+						convert_palette(rgb, source, length, position, step);
+					break;
+					case InputDataType::Red4Green4Blue4:
+						convert_palette(rgb, reinterpret_cast<const uint16_t *>(source), length, position, step);
+					break;
+					case InputDataType::Red8Green8Blue8:
+						convert_rgb8(rgb, reinterpret_cast<const uint32_t *>(source), length, position, step);
+					break;
+					case InputDataType::Palette8:
+						convert_indexed(rgb, source, &palette_area_[size_t(scan->data_y) * PaletteSize], length, position, step);
+					break;
+				}
+
+				for(int c = 0; c < length; ++c) {
+					uint8_t bytes[4];
+					memcpy(bytes, &rgb[c], sizeof(bytes));
+					const float red = float(bytes[0]) / 255.0f;
+					const float green = float(bytes[1]) / 255.0f;
+					const float blue = float(bytes[2]) / 255.0f;
+
+					luma[c] = from_rgb[0]*red + from_rgb[3]*green + from_rgb[6]*blue;
+					const float chroma_x = from_rgb[1]*red + from_rgb[4]*green + from_rgb[7]*blue;
+					const float chroma_y = from_rgb[2]*red + from_rgb[5]*green + from_rgb[8]*blue;
+					chroma[c] = chroma_x * cosine[c] + chroma_y * sine[c];
+				}
+			} break;
+		}
+
+		if(is_svideo) {
+			// Demodulate immediately; the halving matches the scaling expected by the chroma kernel.
+			float *const i = &buffers.i[size_t(offset)];
+			float *const q = &buffers.q[size_t(offset)];
+			for(int c = 0; c < length; ++c) {
+				i[c] = 0.5f * chroma[c] * cosine[c];
+				q[c] = 0.5f * chroma[c] * sine[c];
+			}
+			continue;
+		}
+
+		// Combine luminance and chrominance to a composite signal, in place of chrominance.
+		const float amplitude = float(scan->scan.composite_amplitude) / 255.0f;
+		std::fill(&buffers.amplitude[size_t(offset)], &buffers.amplitude[size_t(offset + length)], amplitude);
+		if(is_luminance_only) {
+			std::copy(luma, luma + length, chroma);
+		} else {
+			for(int c = 0; c < length; ++c) {
+				chroma[c] = luma[c] + (chroma[c] - luma[c]) * amplitude;
+			}
+		}
+	}
+}
+
+void ScanTarget::decode_line(const PendingLine &pending, DecodeBuffers &buffers, uint32_t *row) const {
+	const Line &line = line_buffer_[pending.line];
+	const auto &metadata = line_metadata_buffer_[pending.line];
+	const int cycles_multiplier = pipeline_->cycles_multiplier;
+
+	// Determine the range of the line buffer that this line will sample; include one sample
+	// beyond its end as output_line may sample that.
+	const auto clocks = std::minmax({
+		int(line.end_points[0].cycles_since_end_of_horizontal_retrace),
+		int(line.end_points[1].cycles_since_end_of_horizontal_retrace)});
+	const int begin = std::min(clocks.first * cycles_multiplier, LineBufferWidth);
+	const int end = std::min(clocks.second * cycles_multiplier + 1, LineBufferWidth);
+	if(begin >= end) return;
+
+	// Clear that range, plus padding, and modulate.
+	const bool is_svideo = pipeline_->type == PipelineDescription::Type::SVideo;
+	const auto clear = [&](std::vector<float> &buffer) {
+		std::fill(&buffer[size_t(begin)], &buffer[size_t(end + 2*FilterPadding)], 0.0f);
+	};
+	clear(buffers.luma);
+	clear(buffers.i);
+	clear(buffers.q);
+	if(!is_svideo) {
+		clear(buffers.signal);
+		clear(buffers.amplitude);
+	}
+
+	const Scan *const scans = scan_buffer_.data();
+	if(metadata.first_scan <= pending.end_scan) {
+		modulate_scans(&scans[metadata.first_scan], &scans[pending.end_scan], buffers);
+	} else {
+		modulate_scans(&scans[metadata.first_scan], scans + scan_buffer_.size(), buffers);
+		modulate_scans(&scans[0], &scans[pending.end_scan], buffers);
+	}
+
+	// Indices below are within the padded buffers.
+	const int padded_begin = begin + FilterPadding;
+	const int padded_end = end + FilterPadding;
+
+	if(!is_svideo) {
+		// Separate luminance, then divide chrominance from it, removing the colour subcarrier
+		// entirely if there was no colour burst.
+		apply_filter(buffers.luma.data(), buffers.signal.data(), padded_begin, padded_end, pipeline_->luma_kernel, pipeline_->luma_kernel_size);
+		for(int x = padded_begin; x < padded_end; ++x) {
+			const float amplitude = buffers.amplitude[size_t(x)];
+			const float luma = buffers.luma[size_t(x)];
+			if(amplitude < 0.01f) {
+				buffers.i[size_t(x)] = buffers.q[size_t(x)] = 0.0f;
+				continue;
+			}
+
+			const float chroma = (buffers.signal[size_t(x)] - luma) / amplitude;
+			buffers.luma[size_t(x)] = luma / (1.0f - amplitude);
+			buffers.i[size_t(x)] = 0.5f * chroma * buffers.cosine[size_t(x)];
+			buffers.q[size_t(x)] = 0.5f * chroma * buffers.sine[size_t(x)];
+		}
+	}
+
+	// Sharpen luminance and low-pass filter chrominance.
+	std::array<float, 8> kernels[3];
+	for(size_t c = 0; c < 8; ++c) {
+		for(size_t channel = 0; channel < 3; ++channel) {
+			kernels[channel][c] = pipeline_->chroma_kernel[c][channel];
+		}
+	}
+	const size_t size = pipeline_->chroma_kernel_size;
+	apply_filter(buffers.filtered_luma.data(), buffers.luma.data(), padded_begin, padded_end, kernels[0], size);
+	apply_filter(buffers.filtered_i.data(), buffers.i.data(), padded_begin, padded_end, kernels[1], size);
+	apply_filter(buffers.filtered_q.data(), buffers.q.data(), padded_begin, padded_end, kernels[2], size);
+
+	// Convert to RGB; brightness and gamma are applied by the output table.
+	const auto &to_rgb = pipeline_->to_rgb;
+	for(int x = begin; x < end; ++x) {
+		const size_t index = size_t(x + FilterPadding);
+		const float y = buffers.filtered_luma[index];
+		const float i = buffers.filtered_i[index];
+		const float q = buffers.filtered_q[index];
+		row[x] = pack(
+			output_level(to_rgb[0]*y + to_rgb[3]*i + to_rgb[6]*q),
+			output_level(to_rgb[1]*y + to_rgb[4]*i + to_rgb[7]*q),
+			output_level(to_rgb[2]*y + to_rgb[5]*i + to_rgb[8]*q)
+		);
+	}
+}
+
+void ScanTarget::decode_lines() {
+	const size_t lines = pending_lines_.size();
+	if(!lines) return;
+	if(decoded_rows_.size() < lines * LineBufferWidth) {
+		decoded_rows_.resize(lines * LineBufferWidth);
+	}
+
+	// Divide the lines into one band per worker.
+	const size_t bands = std::min(decode_buffers_.size(), lines);
+	std::atomic<size_t> completed_bands = 0;
+	for(size_t band = 0; band < bands; ++band) {
+		decode_pool_->submit([this, band, bands, lines, &completed_bands] {
+			for(size_t index = band * lines / bands; index < (band + 1) * lines / bands; ++index) {
+				decode_line(pending_lines_[index], decode_buffers_[band], &decoded_rows_[index * LineBufferWidth]);
+			}
+			completed_bands.fetch_add(1, std::memory_order_release);
+		});
+	}
+	decode_pool_->wait_until([&] {
+		return completed_bands.load(std::memory_order_acquire) == bands;
+	});
+}
+
+// MARK: - Public interface.
+
+void ScanTarget::update() {
+	display_metrics_.announce_draw_status(true);
+
+	perform([=] {
+		const OutputArea area = get_output_area();
+
+		// Establish the pipeline if necessary.
+		if(BufferingScanTarget::new_modals()) {
+			setup_pipeline();
+		}
+
+		// Determine the scans for each line; they run up to the first scan of the next line, or to
+		// the end of this output area if this is the final line within it.
+		pending_lines_.clear();
+		auto line = area.start.line;
+		while(line != area.end.line) {
+			const auto next_line = (line + 1) % line_buffer_.size();
+			const size_t end_scan = next_line == area.end.line ? area.end.scan : line_metadata_buffer_[next_line].first_scan;
+			pending_lines_.push_back({line, end_scan});
+			line = next_line;
+		}
+
+		// If decoding then do so for all lines up front, in parallel.
+		if(pipeline_) {
+			decode_lines();
+		}
+
+		const uint32_t black = pack(0, 0, 0);
+		for(size_t index = 0; index < pending_lines_.size(); ++index) {
+			const auto &pending = pending_lines_[index];
+			const auto &metadata = line_metadata_buffer_[pending.line];
+			if(metadata.is_first_in_frame) {
+				begin_frame(metadata.previous_frame_was_complete);
+			}
+
+			const Line &source_line = line_buffer_[pending.line];
+			if(pipeline_) {
+				output_line(source_line, &decoded_rows_[index * LineBufferWidth], pipeline_->cycles_multiplier);
+				continue;
+			}
+
+			// Clear the portion of the composition row that this line will sample, then compose.
+			const auto clocks = std::minmax({
+				int(source_line.end_points[0].cycles_since_end_of_horizontal_retrace),
+				int(source_line.end_points[1].cycles_since_end_of_horizontal_retrace)});
+			std::fill(
+				composition_row_.begin() + std::min(clocks.first, LineBufferWidth),
+				composition_row_.begin() + std::min(clocks.second + 1, LineBufferWidth),
+				black);
+
+			if(metadata.first_scan <= pending.end_scan) {
+				compose_scans(&scan_buffer_[metadata.first_scan], &scan_buffer_[pending.end_scan], composition_row_.data());
+			} else {
+				compose_scans(&scan_buffer_[metadata.first_scan], scan_buffer_.data() + scan_buffer_.size(), composition_row_.data());
+				compose_scans(&scan_buffer_[0], &scan_buffer_[pending.end_scan], composition_row_.data());
+			}
+
+			output_line(source_line, composition_row_.data(), 1);
+		}
+
+		complete_output_area(area);
+	});
+}
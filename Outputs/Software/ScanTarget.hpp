@@ -0,0 +1,153 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Software_ScanTarget_hpp
+#define Software_ScanTarget_hpp
+
+#include "../ScanTargets/BufferingScanTarget.hpp"
+#include "../ScanTargets/PipelineDescription.hpp"
+#include "../../Concurrency/WorkStealingPool.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+namespace Software {
+
+/*!
+	Provides a ScanTarget that rasterises directly into an in-memory RGBA framebuffer,
+	requiring no GPU.
+
+	As per the OpenGL ScanTarget, scans are first composed into a line buffer indexed by
+	clock; each line is then stretched into place in the framebuffer. Untouched
+	areas of the framebuffer are cleared at the start of each frame if the previous
+	frame was complete.
+
+	Conversion from input data to RGB is via lookup tables rebuilt upon every change of
+	modals, incorporating brightness and gamma adjustment; Palette8 input is mapped through
+	the palette attached to its row of the write area. Luminance-only input is output
+	as greyscale; Luminance8Phase8 is demodulated directly from its phase.
+
+	For composite colour and S-Video displays, lines are instead modulated into a signal at
+	the rate nominated by the PipelineDescription, then for composite have luminance separated
+	from chrominance and, for both, are demodulated and filtered using the PipelineDescription's
+	kernels, as per the GPU ScanTargets. Lines are decoded in bands on a pool of worker threads;
+	all intermediate buffers are arrays of floats processed a whole line at a time, so that
+	each filter tap is a vectorisable multiply-accumulate.
+
+	The framebuffer is safe to read only on the thread that calls @c update.
+*/
+class ScanTarget: public Outputs::Display::BufferingScanTarget {
+	public:
+		ScanTarget(int width = 640, int height = 480, float output_gamma = 2.2f);
+
+		/*! Sets the dimensions of the framebuffer; this also clears it. */
+		void set_output_size(int width, int height);
+
+		/*! Processes all the latest input into the framebuffer. */
+		void update();
+
+		/*!
+			@returns The framebuffer, in raster order from the top-left, four bytes per pixel
+			in the order red, green, blue, alpha regardless of host endianness.
+		*/
+		const uint8_t *pixels() const	{	return reinterpret_cast<const uint8_t *>(framebuffer_.data());	}
+		int width() const				{	return width_;		}
+		int height() const				{	return height_;		}
+
+		/*! @returns The total number of frames that have been completed since construction. */
+		size_t completed_frames() const	{	return completed_frames_;	}
+
+	private:
+		static constexpr int LineBufferWidth = 2048;
+		static constexpr int LineBufferHeight = 2048;
+
+		void setup_pipeline();
+		void compose_scans(const Scan *begin, const Scan *end, uint32_t *row);
+		void output_line(const Line &line, const uint32_t *row, int cycles_multiplier);
+		void begin_frame(bool previous_frame_was_complete);
+
+		/// Converts the @c length samples starting at @c source into RGBA at @c target, sampling from @c source
+		/// at a fixed-point 16.16 @c step starting from @c position.
+		template <typename SourceType> void convert_palette(uint32_t *target, const SourceType *source, int length, uint32_t position, uint32_t step) const;
+		void convert_rgb8(uint32_t *target, const uint32_t *source, int length, uint32_t position, uint32_t step) const;
+		void convert_indexed(uint32_t *target, const uint8_t *source, const uint32_t *palette, int length, uint32_t position, uint32_t step) const;
+		void convert_phase_linked(uint32_t *target, const uint32_t *source, int length, uint32_t position, uint32_t step) const;
+
+		static uint32_t pack(uint8_t red, uint8_t green, uint8_t blue);
+		uint32_t pack_adjusted(float red, float green, float blue) const;
+
+		const float output_gamma_;
+		int width_ = 0, height_ = 0;
+		std::vector<uint32_t> framebuffer_;
+
+		// Records whether each framebuffer row has been painted during this frame.
+		std::vector<bool> row_painted_, previous_row_painted_;
+		size_t completed_frames_ = 0;
+
+		// Lookup tables; the palette is indexed by input sample for one- and two-byte types,
+		// the channel table maps from a linear byte to a gamma- and brightness-adjusted byte.
+		std::vector<uint32_t> palette_;
+		std::array<uint8_t, 256> channel_table_;
+		bool channel_table_is_identity_ = true;
+
+		// Composite and S-Video decoding; the pipeline is populated only if decoding is required.
+		std::optional<PipelineDescription> pipeline_;
+		std::array<uint8_t, 256> output_table_;
+
+		/// Filters are applied by reading up to this many samples either side of each output, so intermediate
+		/// buffers carry that much padding at each end to avoid any need to test bounds.
+		static constexpr int FilterPadding = 7;
+		struct DecodeBuffers {
+			DecodeBuffers();
+
+			// Composed signal; composite uses signal plus the subcarrier and its amplitude,
+			// S-Video composes directly to luma, i and q.
+			std::vector<float> signal, cosine, sine, amplitude;
+			std::vector<float> luma, i, q;
+
+			// Filtered output.
+			std::vector<float> filtered_luma, filtered_i, filtered_q;
+
+			// Source pixels for those input types that are converted to RGB before modulation.
+			std::vector<uint32_t> source;
+		};
+
+		struct PendingLine {
+			size_t line;
+			size_t end_scan;
+		};
+		std::vector<PendingLine> pending_lines_;
+
+		std::unique_ptr<Concurrency::WorkStealingPool> decode_pool_;
+		std::vector<DecodeBuffers> decode_buffers_;	// One per worker thread.
+		std::vector<uint32_t> decoded_rows_;
+
+		void decode_lines();
+		void decode_line(const PendingLine &, DecodeBuffers &, uint32_t *row) const;
+		void modulate_scans(const Scan *begin, const Scan *end, DecodeBuffers &) const;
+		uint8_t output_level(float) const;
+
+		// Storage for the various buffers.
+		std::vector<uint8_t> write_area_;
+		std::vector<uint32_t> palette_area_;
+		std::vector<Scan> scan_buffer_;
+		std::vector<Line> line_buffer_;
+		std::vector<LineMetadata> line_metadata_buffer_;
+		std::array<uint32_t, LineBufferWidth> composition_row_;
+};
+
+}
+}
+}
+
+#endif /* Software_ScanTarget_hpp */
@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cstring>
 #include <atomic>
+#include <vector>
 
 namespace Outputs {
 namespace Speaker {
@@ -34,7 +35,9 @@ template <typename... T> class CompoundSource:
 		}
 
 		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-			source_holder_.template get_samples<get_is_stereo()>(number_of_samples, target);
+			if(!source_holder_.template get_samples<get_is_stereo()>(number_of_samples, target)) {
+				std::memset(target, 0, sizeof(std::int16_t) * number_of_samples * (get_is_stereo() ? 2 : 1));
+			}
 		}
 
 		void skip_samples(const std::size_t number_of_samples) {
@@ -82,8 +85,8 @@ template <typename... T> class CompoundSource:
 
 		template <typename... S> class CompoundSourceHolder: public Outputs::Speaker::SampleSource {
 			public:
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
-					std::memset(target, 0, sizeof(std::int16_t) * number_of_samples);
+				template <bool output_stereo> bool get_samples(std::size_t, std::int16_t *) {
+					return false;
 				}
 
 				void set_scaled_volume_range(int16_t, double *, double) {}
@@ -105,39 +108,60 @@ template <typename... T> class CompoundSource:
 			public:
 				CompoundSourceHolder(S &source, R &...next) : source_(source), next_source_(next...) {}
 
-				template <bool output_stereo> void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+				/*!
+					Mixes this source and all those after it into @c target.
+
+					@returns @c true if @c target has been written to; @c false if every source was
+						silent and @c target has been left untouched.
+				*/
+				template <bool output_stereo> bool get_samples(std::size_t number_of_samples, std::int16_t *target) {
 					// Get the rest of the output.
-					next_source_.template get_samples<output_stereo>(number_of_samples, target);
+					const bool has_output = next_source_.template get_samples<output_stereo>(number_of_samples, target);
 
 					if(source_.is_zero_level()) {
 						// This component is currently outputting silence; therefore don't add anything to the output
 						// audio — just pass the call onward.
 						source_.skip_samples(number_of_samples);
-						return;
+						return has_output;
+					}
+
+					if constexpr (output_stereo == S::get_is_stereo()) {
+						// If nothing has been written yet and formats match, write directly to the target.
+						if(!has_output) {
+							source_.get_samples(number_of_samples, target);
+							return true;
+						}
 					}
 
 					// Get this component's output.
-					auto buffer_size = number_of_samples * (output_stereo ? 2 : 1);
+					const auto buffer_size = number_of_samples * (S::get_is_stereo() ? 2 : 1);
 					int16_t local_samples[buffer_size];
 					source_.get_samples(number_of_samples, local_samples);
 
 					// Merge it in; furthermore if total output is stereo but this source isn't,
-					// map it to stereo.
+					// map it to stereo. Both loops are kept simple enough to be vectorised.
 					if constexpr (output_stereo == S::get_is_stereo()) {
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size];
+						for(std::size_t c = 0; c < buffer_size; c++) {
+							target[c] += local_samples[c];
 						}
 					} else {
 						// This will happen only if mapping from mono to stereo, never in the
 						// other direction, because the compound source outputs stereo if any
 						// subcomponent does. So it outputs mono only if no stereo devices are
 						// in the mixing chain.
-						while(buffer_size--) {
-							target[buffer_size] += local_samples[buffer_size >> 1];
+						if(has_output) {
+							for(std::size_t c = 0; c < buffer_size; c++) {
+								target[c*2] += local_samples[c];
+								target[c*2 + 1] += local_samples[c];
+							}
+						} else {
+							for(std::size_t c = 0; c < buffer_size; c++) {
+								target[c*2] = target[c*2 + 1] = local_samples[c];
+							}
 						}
 					}
 
-					// TODO: accelerate above?
+					return true;
 				}
 
 				void skip_samples(const std::size_t number_of_samples) {
@@ -12,6 +12,7 @@
 #include "../Speaker.hpp"
 #include "../../../SignalProcessing/FIRFilter.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../ClockReceiver/Profiler.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
 
 #include <algorithm>
@@ -91,7 +92,14 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 		// MARK: - Filtering.
 
 		std::size_t output_buffer_pointer_ = 0;
+
+		// The input buffer is a multiple of the filter's window size; the window
+		// slides along it, and its contents are moved back to the start only upon
+		// reaching the end of the buffer.
+		static constexpr std::size_t InputBufferWindows = 8;
 		std::size_t input_buffer_depth_ = 0;
+		std::size_t input_window_start_ = 0;
+		std::size_t input_window_size_ = 0;
 		std::vector<int16_t> input_buffer_;
 		std::vector<int16_t> output_buffer_;
 
@@ -99,6 +107,10 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 		float position_error_ = 0.0f;
 		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
 
+		// The parameters that filter_ was built for; it is reused for as long as they are unchanged.
+		float filter_input_cycles_per_second_ = 0.0f;
+		float filter_high_pass_frequency_ = 0.0f;
+
 		std::mutex filter_parameters_mutex_;
 		struct FilterParameters {
 			float input_cycles_per_second = 0.0f;
@@ -115,6 +127,11 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				high_pass_frequency = std::min(filter_parameters.high_frequency_cutoff, high_pass_frequency);
 			}
 
+			// Snap the cut-off to a grid of 128 steps per octave, i.e. steps of about 0.5%. The difference is
+			// inaudible but it allows the filter to be kept across small changes in output rate, such as those
+			// made continually as the speed multiplier is adjusted to synchronise with the host display.
+			high_pass_frequency = exp2f(roundf(log2f(high_pass_frequency) * 128.0f) / 128.0f);
+
 			// Make a guess at a good number of taps.
 			std::size_t number_of_taps = std::size_t(
 				ceilf((filter_parameters.input_cycles_per_second + high_pass_frequency) / high_pass_frequency)
@@ -124,12 +141,20 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			step_rate_ = filter_parameters.input_cycles_per_second / filter_parameters.output_cycles_per_second;
 			position_error_ = 0.0f;
 
-			filter_ = std::make_unique<SignalProcessing::FIRFilter>(
-				unsigned(number_of_taps),
-				filter_parameters.input_cycles_per_second,
-				0.0,
-				high_pass_frequency,
-				SignalProcessing::FIRFilter::DefaultAttenuation);
+			if(
+				!filter_ ||
+				filter_input_cycles_per_second_ != filter_parameters.input_cycles_per_second ||
+				filter_high_pass_frequency_ != high_pass_frequency
+			) {
+				filter_input_cycles_per_second_ = filter_parameters.input_cycles_per_second;
+				filter_high_pass_frequency_ = high_pass_frequency;
+				filter_ = std::make_unique<SignalProcessing::FIRFilter>(
+					unsigned(number_of_taps),
+					filter_parameters.input_cycles_per_second,
+					0.0,
+					high_pass_frequency,
+					SignalProcessing::FIRFilter::DefaultAttenuation);
+			}
 
 			// Pick the new conversion function.
 			if(	filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second &&
@@ -157,13 +182,19 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 					// Reize the input buffer only if absolutely necessary; if sizing downward
 					// such that a sample would otherwise be lost then output it now. Keep anything
 					// currently in the input buffer that hasn't yet been processed.
-					const size_t required_buffer_size = size_t(number_of_taps) * (is_stereo + 1);
-					if(input_buffer_.size() != required_buffer_size) {
-						if(input_buffer_depth_ >= required_buffer_size) {
+					const size_t required_window_size = size_t(number_of_taps) * (is_stereo + 1);
+					if(input_window_size_ != required_window_size) {
+						compact_input_buffer();
+						if(input_buffer_depth_ > required_window_size) {
+							input_window_start_ = input_buffer_depth_ - required_window_size;
+							compact_input_buffer();
+						}
+
+						input_window_size_ = required_window_size;
+						input_buffer_.resize(required_window_size * InputBufferWindows);
+						if(input_buffer_depth_ == input_window_size_) {
 							resample_input_buffer(scale);
-							input_buffer_depth_ %= required_buffer_size;
 						}
-						input_buffer_.resize(required_buffer_size);
 					}
 				} break;
 			}
@@ -175,11 +206,10 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			}
 
 			if constexpr (is_stereo) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
+				filter_->apply_stereo(&input_buffer_[input_window_start_], &output_buffer_[output_buffer_pointer_]);
 				output_buffer_pointer_+= 2;
 			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
+				output_buffer_[output_buffer_pointer_] = filter_->apply(&input_buffer_[input_window_start_]);
 				output_buffer_pointer_++;
 			}
 
@@ -201,31 +231,72 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				did_complete_samples(this, output_buffer_, is_stereo);
 			}
 
-			// If the next loop around is going to reuse some of the samples just collected, use a memmove to
-			// preserve them in the correct locations (TODO: use a longer buffer to fix that?) and don't skip
-			// anything. Otherwise skip as required to get to the next sample batch and don't expect to reuse.
+			// If the next loop around is going to reuse some of the samples just collected, slide the window
+			// along, moving its contents back to the start of the buffer only if there's no further space.
+			// Otherwise skip as required to get to the next sample batch and don't expect to reuse.
 			const size_t steps = size_t(step_rate_ + position_error_) * (is_stereo + 1);
 			position_error_ = fmodf(step_rate_ + position_error_, 1.0f);
-			if(steps < input_buffer_.size()) {
-				auto *const input_buffer = input_buffer_.data();
-				std::memmove(	input_buffer,
-								&input_buffer[steps],
-								sizeof(int16_t) * (input_buffer_.size() - steps));
-				input_buffer_depth_ -= steps;
+			if(steps < input_window_size_) {
+				input_window_start_ += steps;
+				if(input_window_start_ + input_window_size_ > input_buffer_.size()) {
+					compact_input_buffer();
+				}
 			} else {
-				if(steps > input_buffer_.size()) {
-					static_cast<ConcreteT *>(this)->skip_samples((steps - input_buffer_.size()) / (1 + is_stereo));
+				if(steps > input_window_size_) {
+					static_cast<ConcreteT *>(this)->skip_samples((steps - input_window_size_) / (1 + is_stereo));
 				}
-				input_buffer_depth_ = 0;
+				input_window_start_ = input_buffer_depth_ = 0;
 			}
 		}
 
+		/// Moves all retained input back to the start of the input buffer.
+		void compact_input_buffer() {
+			if(!input_window_start_) {
+				return;
+			}
+
+			auto *const input_buffer = input_buffer_.data();
+			std::memmove(	input_buffer,
+							&input_buffer[input_window_start_],
+							sizeof(int16_t) * (input_buffer_depth_ - input_window_start_));
+			input_buffer_depth_ -= input_window_start_;
+			input_window_start_ = 0;
+		}
+
 		enum class Conversion {
 			ResampleSmaller,
 			Copy,
 			ResampleLarger
 		} conversion_ = Conversion::Copy;
 
+		// While muted, the number of silent output samples owed, in fractions.
+		double silent_output_position_ = 0.0;
+
+		/// Posts as many silent samples to the delegate as would result from @c length input samples,
+		/// regardless of conversion.
+		void post_silence(size_t length) {
+			if(output_buffer_.empty()) {
+				return;
+			}
+
+			silent_output_position_ += double(length) / double(step_rate_);
+			size_t outputs = size_t(silent_output_position_);
+			silent_output_position_ -= double(outputs);
+
+			while(outputs) {
+				const size_t samples = std::min((output_buffer_.size() - output_buffer_pointer_) / (1 + is_stereo), outputs);
+				std::fill_n(&output_buffer_[output_buffer_pointer_], samples * (1 + is_stereo), int16_t(0));
+				output_buffer_pointer_ += samples * (1 + is_stereo);
+
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, is_stereo);
+				}
+
+				outputs -= samples;
+			}
+		}
+
 		bool recalculate_filter_if_dirty() {
 			FilterParameters filter_parameters;
 			{
@@ -239,6 +310,10 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 		}
 
 	protected:
+		/// Set by subclasses when output volume is zero; while muted samples are skipped rather than
+		/// generated, and silence is posted to the delegate at the usual rate.
+		std::atomic<bool> is_muted_ = false;
+
 		bool process(size_t length) {
 			const auto delegate = delegate_.load(std::memory_order::memory_order_relaxed);
 			if(!delegate) return false;
@@ -249,6 +324,14 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				delegate->speaker_did_change_input_clock(this);
 			}
 
+			if(is_muted_.load(std::memory_order::memory_order_relaxed)) {
+				// Discard any partial input window too, so that output resumes with fresh input if unmuted.
+				input_buffer_depth_ = input_window_start_ = 0;
+				static_cast<ConcreteT *>(this)->skip_samples(length);
+				post_silence(length);
+				return true;
+			}
+
 			switch(conversion_) {
 				case Conversion::Copy:
 					while(length) {
@@ -270,11 +353,12 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 
 				case Conversion::ResampleSmaller:
 					while(length) {
-						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (1 + is_stereo), length);
+						const size_t window_end = input_window_start_ + input_window_size_;
+						const auto cycles_to_read = std::min((window_end - input_buffer_depth_) / (1 + is_stereo), length);
 						static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
 						input_buffer_depth_ += cycles_to_read * (1 + is_stereo);
 
-						if(input_buffer_depth_ == input_buffer_.size()) {
+						if(input_buffer_depth_ == window_end) {
 							resample_input_buffer(scale);
 						}
 
@@ -308,7 +392,7 @@ template <bool is_stereo> class PushLowpass: public LowpassBase<PushLowpass<is_s
 		const int16_t *buffer_ = nullptr;
 
 		void skip_samples(size_t count) {
-			buffer_ += count;
+			buffer_ += count * (1 + is_stereo);
 		}
 
 		void get_samples(size_t length, int16_t *target) {
@@ -320,6 +404,7 @@ template <bool is_stereo> class PushLowpass: public LowpassBase<PushLowpass<is_s
 	public:
 		void set_output_volume(float volume) final {
 			scale_.store(int(std::clamp(volume * 65536.0f, 0.0f, 65536.0f)));
+			BaseT::is_muted_ = scale_ == 0;
 		}
 
 		bool get_is_stereo() final {
@@ -361,6 +446,7 @@ template <typename SampleSource> class PullLowpass: public LowpassBase<PullLowpa
 			// Clamp to the acceptable range, and set.
 			volume = std::clamp(volume, 0.0f, 1.0f);
 			sample_source_.set_sample_volume_range(int16_t(32767.0f * volume));
+			BaseT::is_muted_ = volume == 0.0f;
 		}
 
 		bool get_is_stereo() final {
@@ -398,6 +484,7 @@ template <typename SampleSource> class PullLowpass: public LowpassBase<PullLowpa
 		SampleSource &sample_source_;
 
 		void skip_samples(size_t count) {
+			Profiling::Scope<SampleSource> profiling_scope(static_cast<int64_t>(count));
 			sample_source_.skip_samples(count);
 		}
 
@@ -406,6 +493,7 @@ template <typename SampleSource> class PullLowpass: public LowpassBase<PullLowpa
 		}
 
 		void get_samples(size_t length, int16_t *target) {
+			Profiling::Scope<SampleSource> profiling_scope(static_cast<int64_t>(length));
 			sample_source_.get_samples(length, target);
 		}
 };
@@ -0,0 +1,122 @@
+//
+//  Mixer.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Mixer.hpp"
+
+#include <algorithm>
+
+using namespace Outputs::Speaker;
+
+Mixer::Mixer(float sample_rate, bool is_stereo, int buffered_samples) :
+	sample_rate_(sample_rate),
+	is_stereo_(is_stereo),
+	buffered_samples_(buffered_samples) {
+	// Size working storage for the expected callback size up front, to avoid allocation
+	// on the audio thread.
+	const size_t channels = is_stereo ? 2 : 1;
+	accumulator_.resize(size_t(buffered_samples) * channels);
+	samples_.resize(size_t(buffered_samples) * channels);
+}
+
+Mixer::~Mixer() {
+	for(auto &input: inputs_) {
+		input->speaker->set_delegate(nullptr);
+	}
+}
+
+// MARK: - Configuration.
+
+void Mixer::add_speaker(Speaker *speaker, float gain) {
+	speaker->set_output_rate(sample_rate_, buffered_samples_, is_stereo_);
+
+	auto input = std::make_unique<Input>(speaker, gain, size_t(buffered_samples_) * (is_stereo_ ? 2 : 1));
+	speaker->set_delegate(input.get());
+
+	std::lock_guard lock(inputs_mutex_);
+	inputs_.push_back(std::move(input));
+}
+
+void Mixer::remove_speaker(Speaker *speaker) {
+	speaker->set_delegate(nullptr);
+
+	Speaker *expected_focus = speaker;
+	focus_.compare_exchange_strong(expected_focus, nullptr);
+
+	std::lock_guard lock(inputs_mutex_);
+	inputs_.erase(
+		std::remove_if(inputs_.begin(), inputs_.end(), [speaker](const auto &input) {
+			return input->speaker == speaker;
+		}),
+		inputs_.end()
+	);
+}
+
+void Mixer::set_gain(Speaker *speaker, float gain) {
+	std::lock_guard lock(inputs_mutex_);
+	for(auto &input: inputs_) {
+		if(input->speaker == speaker) {
+			input->gain = std::clamp(gain, 0.0f, 1.0f);
+		}
+	}
+}
+
+void Mixer::set_focus(Speaker *speaker) {
+	focus_ = speaker;
+}
+
+void Mixer::set_ducking_level(float level) {
+	ducking_level_ = std::clamp(level, 0.0f, 1.0f);
+}
+
+// MARK: - Speaker threads.
+
+void Mixer::Input::speaker_did_complete_samples(Speaker *, const std::vector<int16_t> &samples) {
+	// As per a host with a single speaker: if the audio thread has stalled for long enough that the
+	// ring is full then drop these samples, and nudge the rate of production to maintain the
+	// intended amount of buffering.
+	buffer.push(samples.data(), samples.size());
+	speaker->set_output_buffer_fill(buffer.size(), target_fill);
+}
+
+// MARK: - Audio thread.
+
+void Mixer::get_samples(int16_t *target, size_t count) {
+	if(accumulator_.size() < count) {
+		accumulator_.resize(count);
+		samples_.resize(count);
+	}
+	std::fill(accumulator_.begin(), accumulator_.begin() + ptrdiff_t(count), 0.0f);
+
+	Speaker *const focus = focus_;
+	const float ducking_level = ducking_level_;
+
+	{
+		std::lock_guard lock(inputs_mutex_);
+		for(auto &input: inputs_) {
+			// Skip any audio well beyond the intended amount of buffering, to bound latency.
+			input->buffer.discard_to(2 * input->target_fill);
+			const size_t length = input->buffer.pop(samples_.data(), count);
+
+			// Ramp linearly from the previously-applied gain to the current one across this buffer,
+			// so that changes in focus or gain don't click.
+			const float gain = input->gain * ((focus && focus != input->speaker) ? ducking_level : 1.0f);
+			const float initial_gain = input->applied_gain;
+			const float gain_step = (gain - initial_gain) / float(count);
+			input->applied_gain = gain;
+
+			if(gain == 0.0f && initial_gain == 0.0f) continue;
+			for(size_t c = 0; c < length; c++) {
+				accumulator_[c] += float(samples_[c]) * (initial_gain + gain_step * float(c));
+			}
+		}
+	}
+
+	for(size_t c = 0; c < count; c++) {
+		target[c] = int16_t(std::clamp(accumulator_[c], -32768.0f, 32767.0f));
+	}
+}
@@ -0,0 +1,106 @@
+//
+//  Mixer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Mixer_hpp
+#define Mixer_hpp
+
+#include "Speaker.hpp"
+#include "../../Concurrency/SPSCRing.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	Combines the output of several speakers, e.g. those of a number of simultaneously-running machines,
+	into a single stream suitable for one host audio device.
+
+	Each speaker is set to produce audio at the device's rate and channel count, so that resampling
+	occurs via each speaker's own filter, and becomes the producer for a separate lock-free ring.
+	The host's audio callback then calls @c get_samples to mix the current contents of all rings,
+	applying a per-speaker gain and ducking all but the focussed speaker, if there is one.
+
+	Speakers should be added and removed only while their machines are not running.
+*/
+class Mixer {
+	public:
+		/*!
+			@param sample_rate The host device's output rate.
+			@param is_stereo @c true if the host device is stereo; @c false otherwise.
+			@param buffered_samples The number of sample sets the host device consumes per callback; also the
+				amount of buffering that each speaker will aim to maintain.
+		*/
+		Mixer(float sample_rate, bool is_stereo, int buffered_samples);
+		~Mixer();
+
+		/// Adds @c speaker, setting its output rate and delegate, with an initial gain of @c gain.
+		void add_speaker(Speaker *speaker, float gain = 1.0f);
+
+		/// Removes @c speaker and resets its delegate.
+		void remove_speaker(Speaker *speaker);
+
+		/// Sets the gain to apply to @c speaker, in the range [0, 1].
+		void set_gain(Speaker *speaker, float gain);
+
+		/// Nominates @c speaker as the one that the user is currently paying attention to; all others will be
+		/// reduced to the ducking level. Supply @c nullptr to play all speakers at their normal gain.
+		void set_focus(Speaker *speaker);
+
+		/// Sets the multiplier applied to the gain of all speakers that do not currently have focus.
+		void set_ducking_level(float level);
+
+		/*!
+			Mixes the audio currently available from all speakers into @c target; to be called from the
+			host's audio thread.
+
+			@param target The destination; stereo output is interleaved as left, then right.
+			@param count The number of samples to write, counting each channel separately.
+		*/
+		void get_samples(int16_t *target, size_t count);
+
+	private:
+		struct Input: public Speaker::Delegate {
+			Input(Speaker *speaker, float gain, size_t target_fill) :
+				speaker(speaker), gain(gain), target_fill(target_fill) {}
+
+			void speaker_did_complete_samples(Speaker *, const std::vector<int16_t> &) final;
+
+			Speaker *const speaker;
+			std::atomic<float> gain;
+			const size_t target_fill;
+
+			// Written by the speaker's thread, read by the audio thread.
+			Concurrency::SPSCRing<int16_t, 16384> buffer;
+
+			// Used only by the audio thread.
+			float applied_gain = 0.0f;
+		};
+
+		const float sample_rate_;
+		const bool is_stereo_;
+		const int buffered_samples_;
+
+		std::atomic<Speaker *> focus_ = nullptr;
+		std::atomic<float> ducking_level_ = 0.25f;
+
+		std::mutex inputs_mutex_;
+		std::vector<std::unique_ptr<Input>> inputs_;
+
+		// Used only by the audio thread.
+		std::vector<float> accumulator_;
+		std::vector<int16_t> samples_;
+};
+
+}
+}
+
+#endif /* Mixer_hpp */
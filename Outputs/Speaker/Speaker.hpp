@@ -9,7 +9,10 @@
 #ifndef Speaker_hpp
 #define Speaker_hpp
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -52,9 +55,56 @@ class Speaker {
 			output_cycles_per_second_ = rhs.output_cycles_per_second_;
 			output_buffer_size_ = rhs.output_buffer_size_;
 			stereo_output_.store(rhs.stereo_output_.load(std::memory_order::memory_order_relaxed), std::memory_order::memory_order_relaxed);
+			output_rate_adjustment_ = rhs.output_rate_adjustment_;
 			compute_output_rate();
 		}
 
+		/*!
+			Scales the effective output rate by @c adjustment, which is clamped to within 0.5% of 1.0, without
+			altering the nominal rate supplied to @c set_output_rate. This allows a host to produce audio very
+			slightly faster or slower than it is consumed, to hold its buffering at a constant depth.
+
+			Adjustments are quantised to steps of 0.05%, so that the output filter is rebuilt only upon a
+			meaningful change.
+		*/
+		void set_output_rate_adjustment(float adjustment) {
+			adjustment = std::round(std::clamp(adjustment, 0.995f, 1.005f) * 2000.0f) / 2000.0f;
+			if(adjustment == output_rate_adjustment_) return;
+			output_rate_adjustment_ = adjustment;
+			compute_output_rate();
+		}
+
+		/*!
+			Sets an output rate adjustment based on the amount of audio currently buffered by the host, @c fill,
+			and the amount that it would ideally keep buffered, @c target, both in any consistent unit.
+
+			This should be called regularly, e.g. upon every delivery of samples to the delegate, and on the
+			same thread. @c fill is averaged over successive calls so that the bursty nature of most audio
+			consumers is ignored.
+		*/
+		void set_output_buffer_fill(std::size_t fill, std::size_t target) {
+			if(!target) return;
+
+			// Average over a fixed number of calls, and adjust only once per period.
+			fill_total_ += fill;
+			++fill_count_;
+			if(fill_count_ < 64) return;
+			const float average_fill = float(fill_total_) / float(fill_count_);
+			fill_total_ = fill_count_ = 0;
+
+			// Adjust in proportion to the error plus its accumulation, the latter accounting for any
+			// persistent mismatch between the nominal output rate and the real one.
+			const float error = (average_fill - float(target)) / float(target);
+			fill_error_integral_ = std::clamp(fill_error_integral_ + error * 0.0005f, -0.005f, 0.005f);
+			const float adjustment = 1.0f - 0.0025f * error - fill_error_integral_;
+
+			// Apply that only once it is clearly more than a step away from the current adjustment,
+			// to avoid flipping back and forth between neighbours.
+			if(std::abs(adjustment - output_rate_adjustment_) > 0.00075f) {
+				set_output_rate_adjustment(adjustment);
+			}
+		}
+
 		/// Sets the output volume, in the range [0, 1].
 		virtual void set_output_volume(float) = 0;
 
@@ -115,14 +165,14 @@ class Speaker {
 			if(is_stereo) {
 				// Mix down.
 				mix_buffer_.resize(buffer.size() / 2);
-				for(size_t c = 0; c < mix_buffer_.size(); ++c) {
+				for(std::size_t c = 0; c < mix_buffer_.size(); ++c) {
 					mix_buffer_[c] = (buffer[(c << 1) + 0] + buffer[(c << 1) + 1]) >> 1;
 					// TODO: is there an Accelerate framework solution to this?
 				}
 			} else {
 				// Double up.
 				mix_buffer_.resize(buffer.size() * 2);
-				for(size_t c = 0; c < buffer.size(); ++c) {
+				for(std::size_t c = 0; c < buffer.size(); ++c) {
 					mix_buffer_[(c << 1) + 0] = mix_buffer_[(c << 1) + 1] = buffer[c];
 				}
 			}
@@ -134,12 +184,15 @@ class Speaker {
 		void compute_output_rate() {
 			// The input rate multiplier is actually used as an output rate divider,
 			// to confirm to the public interface of a generic speaker being output-centric.
-			set_computed_output_rate(output_cycles_per_second_ / input_rate_multiplier_, output_buffer_size_, stereo_output_);
+			set_computed_output_rate(output_cycles_per_second_ * output_rate_adjustment_ / input_rate_multiplier_, output_buffer_size_, stereo_output_);
 		}
 
 		int completed_sample_sets_ = 0;
 		float input_rate_multiplier_ = 1.0f;
 		float output_cycles_per_second_ = 1.0f;
+		float output_rate_adjustment_ = 1.0f;
+		std::size_t fill_total_ = 0, fill_count_ = 0;
+		float fill_error_integral_ = 0.0f;
 		int output_buffer_size_ = 1;
 		std::atomic<bool> stereo_output_{false};
 		std::vector<int16_t> mix_buffer_;
@@ -0,0 +1,111 @@
+//
+//  WAVWriter.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "WAVWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Outputs::Speaker;
+
+WAVWriter::WAVWriter(const std::string &file_name, int sample_rate, bool is_stereo, size_t buffer_size) :
+	file_(file_name, Storage::FileHolder::FileMode::Rewrite),
+	sample_rate_(sample_rate),
+	channels_(is_stereo ? 2 : 1),
+	ring_(buffer_size) {
+	// Write a header now, with no data; the sizes are filled in upon destruction.
+	write_header(0);
+	writer_ = std::thread([this] {
+		run_writer();
+	});
+}
+
+WAVWriter::~WAVWriter() {
+	{
+		std::lock_guard lock(mutex_);
+		is_finishing_ = true;
+	}
+	has_data_.notify_all();
+	writer_.join();
+
+	file_.seek(0, SEEK_SET);
+	write_header(uint32_t(samples_written_ * sizeof(int16_t)));
+	file_.flush();
+}
+
+void WAVWriter::write_header(uint32_t data_size) {
+	file_.write(reinterpret_cast<const uint8_t *>("RIFF"), 4);
+	file_.put_le<uint32_t>(36 + data_size);
+	file_.write(reinterpret_cast<const uint8_t *>("WAVE"), 4);
+
+	file_.write(reinterpret_cast<const uint8_t *>("fmt "), 4);
+	file_.put_le<uint32_t>(16);
+	file_.put_le<uint16_t>(1);	// i.e. PCM.
+	file_.put_le<uint16_t>(uint16_t(channels_));
+	file_.put_le<uint32_t>(uint32_t(sample_rate_));
+	file_.put_le<uint32_t>(uint32_t(sample_rate_ * channels_) * sizeof(int16_t));
+	file_.put_le<uint16_t>(uint16_t(channels_ * sizeof(int16_t)));
+	file_.put_le<uint16_t>(16);
+
+	file_.write(reinterpret_cast<const uint8_t *>("data"), 4);
+	file_.put_le<uint32_t>(data_size);
+}
+
+void WAVWriter::speaker_did_complete_samples(Speaker *, const std::vector<int16_t> &buffer) {
+	const int16_t *source = buffer.data();
+	size_t remaining = buffer.size();
+
+	while(remaining) {
+		std::unique_lock lock(mutex_);
+		has_space_.wait(lock, [this] { return write_ - read_ < ring_.size(); });
+
+		// Copy as much as will fit before either the end of the ring or the reader.
+		const size_t offset = write_ % ring_.size();
+		const size_t length = std::min({remaining, ring_.size() - (write_ - read_), ring_.size() - offset});
+		std::memcpy(&ring_[offset], source, length * sizeof(int16_t));
+		write_ += length;
+		source += length;
+		remaining -= length;
+
+		lock.unlock();
+		has_data_.notify_one();
+	}
+}
+
+size_t WAVWriter::samples_written() const {
+	return samples_written_;
+}
+
+void WAVWriter::run_writer() {
+	while(true) {
+		std::unique_lock lock(mutex_);
+		has_data_.wait(lock, [this] { return read_ != write_ || is_finishing_; });
+		if(read_ == write_) {
+			return;
+		}
+
+		// Take whatever is contiguous, and write it without holding the lock.
+		const size_t offset = read_ % ring_.size();
+		const size_t length = std::min(write_ - read_, ring_.size() - offset);
+		lock.unlock();
+
+		// WAV is little endian, so convert via a staging buffer.
+		staging_.resize(length * sizeof(int16_t));
+		for(size_t c = 0; c < length; c++) {
+			staging_[c*2 + 0] = uint8_t(ring_[offset + c]);
+			staging_[c*2 + 1] = uint8_t(ring_[offset + c] >> 8);
+		}
+		file_.write(staging_.data(), staging_.size());
+		samples_written_ += length;
+
+		lock.lock();
+		read_ += length;
+		lock.unlock();
+		has_space_.notify_one();
+	}
+}
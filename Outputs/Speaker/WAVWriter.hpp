@@ -0,0 +1,77 @@
+//
+//  WAVWriter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef WAVWriter_hpp
+#define WAVWriter_hpp
+
+#include "Speaker.hpp"
+#include "../../Storage/FileHolder.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A speaker delegate that records all audio it receives to a 16-bit PCM WAV file.
+
+	Incoming buffers are copied into a fixed-size ring, so no allocation occurs per buffer,
+	and are written to disk by a dedicated thread. If the writer falls behind then the speaker's
+	thread is blocked until there is space; no audio is ever dropped, so capture is accurate
+	regardless of whether the machine is running in real time.
+
+	The WAV header is completed when this writer is destroyed.
+*/
+class WAVWriter: public Speaker::Delegate {
+	public:
+		/*!
+			Opens @c file_name for writing.
+
+			@param sample_rate The output rate that the speaker has been, or will be, set to.
+			@param is_stereo @c true if the speaker has been, or will be, set to stereo output; @c false otherwise.
+			@param buffer_size The capacity of the ring buffer between speaker and disk, in samples.
+
+			@throws Storage::FileHolder::Error if the file could not be opened.
+		*/
+		WAVWriter(const std::string &file_name, int sample_rate, bool is_stereo, size_t buffer_size = 1 << 18);
+		~WAVWriter();
+
+		void speaker_did_complete_samples(Speaker *speaker, const std::vector<int16_t> &buffer) final;
+
+		/// @returns The number of samples written so far, counting each channel separately.
+		size_t samples_written() const;
+
+	private:
+		Storage::FileHolder file_;
+		const int sample_rate_;
+		const int channels_;
+
+		std::vector<int16_t> ring_;
+		size_t read_ = 0, write_ = 0;		// Both counted in samples since creation; guarded by mutex_.
+		bool is_finishing_ = false;
+
+		mutable std::mutex mutex_;
+		std::condition_variable has_data_, has_space_;
+
+		std::atomic<size_t> samples_written_ = 0;
+		std::vector<uint8_t> staging_;
+		std::thread writer_;
+
+		void write_header(uint32_t data_size);
+		void run_writer();
+};
+
+}
+}
+
+#endif /* WAVWriter_hpp */
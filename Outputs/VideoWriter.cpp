@@ -0,0 +1,225 @@
+//
+//  VideoWriter.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "VideoWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Outputs::Display;
+
+VideoWriter::VideoWriter(
+	const std::string &file_name,
+	int width, int height,
+	int frame_rate_numerator, int frame_rate_denominator,
+	Format format,
+	size_t buffered_frames) :
+		file_(file_name, Storage::FileHolder::FileMode::Rewrite),
+		width_(width),
+		height_(height),
+		format_(format),
+		frames_(std::max(buffered_frames, size_t(1)), std::vector<uint8_t>(size_t(width * height * 4))) {
+	if(format_ == Format::Y4M) {
+		const std::string header =
+			"YUV4MPEG2 W" + std::to_string(width_) +
+			" H" + std::to_string(height_) +
+			" F" + std::to_string(frame_rate_numerator) + ":" + std::to_string(frame_rate_denominator) +
+			" Ip A1:1 C444\n";
+		file_.write(reinterpret_cast<const uint8_t *>(header.data()), header.size());
+	}
+	if(format_ == Format::Delta) {
+		const uint8_t header[] = {
+			'C', 'L', 'K', 'D',
+			uint8_t(width_), uint8_t(width_ >> 8),
+			uint8_t(height_), uint8_t(height_ >> 8),
+			uint8_t(frame_rate_numerator), uint8_t(frame_rate_numerator >> 8),
+			uint8_t(frame_rate_denominator), uint8_t(frame_rate_denominator >> 8),
+		};
+		file_.write(header, sizeof(header));
+		previous_frame_.resize(size_t(width_ * height_ * 4));
+	}
+
+	writer_ = std::thread([this] {
+		run_writer();
+	});
+}
+
+VideoWriter::~VideoWriter() {
+	{
+		std::lock_guard lock(mutex_);
+		is_finishing_ = true;
+	}
+	has_data_.notify_all();
+	writer_.join();
+	file_.flush();
+}
+
+void VideoWriter::write_frame(const uint8_t *pixels, int width, int height, size_t stride, bool is_bottom_up) {
+	std::unique_lock lock(mutex_);
+	has_space_.wait(lock, [this] { return write_ - read_ < frames_.size(); });
+	std::vector<uint8_t> &frame = frames_[write_ % frames_.size()];
+	lock.unlock();
+
+	// Centre the source within the output, cropping or padding on each axis as required.
+	const int copy_width = std::min(width, width_);
+	const int copy_height = std::min(height, height_);
+	const int source_x = std::max(0, (width - width_) >> 1);
+	const int source_y = std::max(0, (height - height_) >> 1);
+	const int target_x = std::max(0, (width_ - width) >> 1);
+	const int target_y = std::max(0, (height_ - height) >> 1);
+
+	if(copy_width < width_ || copy_height < height_) {
+		std::fill(frame.begin(), frame.end(), 0);
+	}
+	for(int y = 0; y < copy_height; y++) {
+		const int row = is_bottom_up ? height - 1 - (source_y + y) : source_y + y;
+		std::memcpy(
+			&frame[size_t(((target_y + y) * width_ + target_x) * 4)],
+			&pixels[size_t(row) * stride + size_t(source_x * 4)],
+			size_t(copy_width * 4));
+	}
+
+	lock.lock();
+	++write_;
+	lock.unlock();
+	has_data_.notify_one();
+}
+
+size_t VideoWriter::frames_written() const {
+	return frames_written_;
+}
+
+void VideoWriter::convert_to_ycbcr(const std::vector<uint8_t> &frame) {
+	static constexpr char frame_header[] = "FRAME\n";
+	const size_t plane_size = size_t(width_ * height_);
+	staging_.resize(sizeof(frame_header) - 1 + plane_size * 3);
+	std::memcpy(staging_.data(), frame_header, sizeof(frame_header) - 1);
+
+	uint8_t *y = &staging_[sizeof(frame_header) - 1];
+	uint8_t *cb = y + plane_size;
+	uint8_t *cr = cb + plane_size;
+
+	// BT.601 studio-range coefficients, in 8.8 fixed point.
+	for(size_t c = 0; c < plane_size; c++) {
+		const int red = frame[c*4 + 0];
+		const int green = frame[c*4 + 1];
+		const int blue = frame[c*4 + 2];
+
+		y[c] = uint8_t(16 + ((66*red + 129*green + 25*blue + 128) >> 8));
+		cb[c] = uint8_t(128 + ((-38*red - 74*green + 112*blue + 128) >> 8));
+		cr[c] = uint8_t(128 + ((112*red - 94*green - 18*blue + 128) >> 8));
+	}
+}
+
+void VideoWriter::encode_delta(const std::vector<uint8_t> &frame) {
+	const size_t pixels = size_t(width_ * height_);
+	const bool is_key_frame = !(frames_written_ % KeyFrameInterval);
+	if(is_key_frame) {
+		std::fill(previous_frame_.begin(), previous_frame_.end(), 0);
+	}
+
+	// Leave space for the frame header, to be completed once the length is known.
+	staging_.resize(5);
+
+	const auto colour = [](const uint8_t *pixel) {
+		return uint32_t(pixel[0] | (pixel[1] << 8) | (pixel[2] << 16));
+	};
+	const auto append_count = [this](uint8_t opcode, size_t count) {
+		if(count < 64) {
+			staging_.push_back(uint8_t(opcode | count));
+			return;
+		}
+		staging_.push_back(opcode);
+		count -= 64;
+		while(count >= 0x80) {
+			staging_.push_back(uint8_t(0x80 | (count & 0x7f)));
+			count >>= 7;
+		}
+		staging_.push_back(uint8_t(count));
+	};
+
+	uint32_t cache[64]{};
+	uint32_t last = 0;
+	size_t c = 0;
+	while(c < pixels) {
+		// Measure how far the pixels remain unchanged, and how far they repeat the last colour.
+		size_t skip = c;
+		while(skip < pixels && colour(&frame[skip * 4]) == colour(&previous_frame_[skip * 4])) ++skip;
+		size_t run = c;
+		while(run < pixels && colour(&frame[run * 4]) == last) ++run;
+
+		if(skip > c && skip >= run) {
+			append_count(0x40, skip - c);
+			c = skip;
+			last = colour(&frame[(c - 1) * 4]);
+			continue;
+		}
+		if(run > c) {
+			append_count(0x80, run - c);
+			c = run;
+			continue;
+		}
+
+		// Otherwise output a single colour, from the cache if possible.
+		const uint8_t *const pixel = &frame[c * 4];
+		last = colour(pixel);
+		const size_t index = (pixel[0]*3 + pixel[1]*5 + pixel[2]*7) & 63;
+		if(cache[index] == last) {
+			staging_.push_back(uint8_t(index));
+		} else {
+			cache[index] = last;
+			staging_.push_back(0xff);
+			staging_.push_back(pixel[0]);
+			staging_.push_back(pixel[1]);
+			staging_.push_back(pixel[2]);
+		}
+		++c;
+	}
+
+	const size_t length = staging_.size() - 5;
+	staging_[0] = is_key_frame ? 1 : 0;
+	staging_[1] = uint8_t(length);
+	staging_[2] = uint8_t(length >> 8);
+	staging_[3] = uint8_t(length >> 16);
+	staging_[4] = uint8_t(length >> 24);
+
+	previous_frame_ = frame;
+}
+
+void VideoWriter::run_writer() {
+	while(true) {
+		std::unique_lock lock(mutex_);
+		has_data_.wait(lock, [this] { return read_ != write_ || is_finishing_; });
+		if(read_ == write_) {
+			return;
+		}
+		const std::vector<uint8_t> &frame = frames_[read_ % frames_.size()];
+		lock.unlock();
+
+		// Convert and write without holding the lock.
+		switch(format_) {
+			case Format::Y4M:
+				convert_to_ycbcr(frame);
+				file_.write(staging_.data(), staging_.size());
+			break;
+			case Format::RGBA:
+				file_.write(frame.data(), frame.size());
+			break;
+			case Format::Delta:
+				encode_delta(frame);
+				file_.write(staging_.data(), staging_.size());
+			break;
+		}
+		++frames_written_;
+
+		lock.lock();
+		++read_;
+		lock.unlock();
+		has_space_.notify_one();
+	}
+}
@@ -0,0 +1,126 @@
+//
+//  VideoWriter.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef VideoWriter_hpp
+#define VideoWriter_hpp
+
+#include "../Storage/FileHolder.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+
+/*!
+	Records a sequence of fixed-size RGBA frames to a file or named pipe, either as a
+	YUV4MPEG2 stream — 4:4:4, BT.601 studio range — as unadorned RGBA, or as a compact
+	lossless delta stream suited to forwarding over a network.
+
+	Frames are copied into a fixed pool on the caller's thread, cropping or padding with black
+	as necessary to match the dimensions supplied at construction, and are then converted and
+	written by a dedicated thread. If that thread falls behind then the caller is blocked until
+	a buffer is free; no frame is ever dropped.
+*/
+class VideoWriter {
+	public:
+		enum class Format {
+			/// A YUV4MPEG2 stream, suitable for direct consumption by most video encoders.
+			Y4M,
+			/// Raw RGBA bytes, four per pixel, in raster order; no header or framing.
+			RGBA,
+			/*!
+				A lossless RGB stream in which each frame is encoded relative to the previous one; unchanged
+				pixels cost almost nothing, and the small palettes typical of emulated machines encode compactly.
+
+				The stream begins "CLKD" then the width, height and frame-rate numerator and denominator, each
+				a 16-bit little-endian value. Each frame then consists of a flags byte — bit 0 being set for a
+				key frame, which should be decoded against a black previous frame — and a 32-bit little-endian
+				count of the bytes of encoded pixels that follow.
+
+				Pixels are encoded in raster order as a sequence of:
+				* @c 00iiiiii: the colour at index i of a 64-entry cache;
+				* @c 01nnnnnn: n pixels unchanged from the previous frame;
+				* @c 10nnnnnn: n repeats of the most-recently decoded pixel;
+				* @c 11111111 r g b: a literal colour.
+
+				If n is 0 then it is followed by an unsigned LEB128 value, to which 64 is added to get the count.
+				Literal and cache colours are stored into the cache at index (r*3 + g*5 + b*7) % 64. The cache
+				and most-recently decoded pixel are reset to black at the start of every frame.
+			*/
+			Delta,
+		};
+
+		/*!
+			Opens @c file_name for writing.
+
+			@param width The width of all frames in the output stream.
+			@param height The height of all frames in the output stream.
+			@param frame_rate_numerator The numerator of the output frame rate, in frames per second.
+			@param frame_rate_denominator The denominator of the output frame rate.
+			@param buffered_frames The number of frames that may be pending between caller and disk.
+
+			@throws Storage::FileHolder::Error if the file could not be opened.
+		*/
+		VideoWriter(
+			const std::string &file_name,
+			int width, int height,
+			int frame_rate_numerator, int frame_rate_denominator,
+			Format format = Format::Y4M,
+			size_t buffered_frames = 4);
+		~VideoWriter();
+
+		/*!
+			Enqueues a frame of four-byte RGBA pixels for output.
+
+			If the source differs in size from the output then it is centred, being cropped or surrounded by black.
+
+			@param stride The distance between the starts of successive rows, in bytes.
+			@param is_bottom_up @c true if rows are supplied from the bottom of the image upwards, as by OpenGL; @c false otherwise.
+		*/
+		void write_frame(const uint8_t *pixels, int width, int height, size_t stride, bool is_bottom_up = false);
+
+		/// @returns The number of frames written to disk so far.
+		size_t frames_written() const;
+
+		int width() const	{	return width_;	}
+		int height() const	{	return height_;	}
+
+	private:
+		Storage::FileHolder file_;
+		const int width_, height_;
+		const Format format_;
+
+		std::vector<std::vector<uint8_t>> frames_;
+		size_t read_ = 0, write_ = 0;		// Both counted in frames since creation; guarded by mutex_.
+		bool is_finishing_ = false;
+
+		mutable std::mutex mutex_;
+		std::condition_variable has_data_, has_space_;
+
+		std::atomic<size_t> frames_written_ = 0;
+		std::vector<uint8_t> staging_;
+		std::thread writer_;
+
+		void run_writer();
+		void convert_to_ycbcr(const std::vector<uint8_t> &frame);
+
+		static constexpr size_t KeyFrameInterval = 250;
+		std::vector<uint8_t> previous_frame_;
+		void encode_delta(const std::vector<uint8_t> &frame);
+};
+
+}
+}
+
+#endif /* VideoWriter_hpp */
@@ -9,6 +9,7 @@
 #ifndef MOS6502_cpp
 #define MOS6502_cpp
 
+#include <array>
 #include <cassert>
 #include <cstdio>
 #include <cstdint>
@@ -17,6 +18,7 @@
 #include "../6502Esque/Implementation/LazyFlags.hpp"
 #include "../../Numeric/RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../ClockReceiver/Profiler.hpp"
 
 namespace CPU {
 namespace MOS6502 {
@@ -125,6 +127,17 @@ class ProcessorBase: public ProcessorStorage {
 			@returns @c true if the 6502 is jammed; @c false otherwise.
 		*/
 		inline bool is_jammed() const;
+
+		/*!
+			Nominates @c trace to receive a record of every subsequent bus operation, or ends tracing
+			if @c trace is @c nullptr.
+		*/
+		void set_bus_trace(CPU::BusTrace *trace) {
+			bus_trace_ = trace;
+		}
+
+	protected:
+		CPU::BusTrace *bus_trace_ = nullptr;
 };
 
 /*!
@@ -158,6 +171,11 @@ template <Personality personality, typename BusHandler, bool uses_ready_line> cl
 
 	private:
 		BusHandler &bus_handler_;
+
+		// Idle-loop detection, per the bus handler's skips_idle_loops.
+		using IdleLoopRegisters = std::array<uint16_t, 7>;
+		CPU::IdleLoopDetector<IdleLoopRegisters, Cycles, uint16_t> idle_loop_detector_;
+		void consider_idle_loop(Cycles &number_of_cycles);
 };
 
 #include "Implementation/6502Implementation.hpp"
@@ -20,7 +20,7 @@ namespace {
 
 static constexpr bool LogAllReads = false;
 static constexpr bool LogAllWrites = false;
-static constexpr bool LogCIAAccesses = true;
+static constexpr bool LogCIAAccesses = false;
 static constexpr bool LogProgramCounter = false;
 
 using Type = CPU::MOS6502Esque::Type;
@@ -59,6 +59,7 @@ template <Type type, bool has_cias> class ConcreteAllRAMProcessor:
 					}
 					check_address_for_trap(address);
 					--instructions_;
+					++opcode_fetches_;
 				}
 
 				if(isReadOperation(operation)) {
@@ -114,6 +115,22 @@ template <Type type, bool has_cias> class ConcreteAllRAMProcessor:
 			return Cycles(1);
 		}
 
+		// The instruction-level 6502 is given no direct access to memory, so that every access is observed as above.
+		const PageTable &page_table() {
+			return page_table_;
+		}
+
+		void advance_time(Cycles cycles) {
+			timestamp_ += cycles;
+			if constexpr (has_cias) {
+				cia1_.run_for(HalfCycles(cycles.as<int>() * 2));
+				cia2_.run_for(HalfCycles(cycles.as<int>() * 2));
+
+				mos6502_.set_irq_line(cia1_.get_interrupt_line());
+				mos6502_.set_nmi_line(cia2_.get_interrupt_line());
+			}
+		}
+
 		void run_for(const Cycles cycles) {
 			mos6502_.run_for(cycles);
 		}
@@ -148,6 +165,7 @@ template <Type type, bool has_cias> class ConcreteAllRAMProcessor:
 	private:
 		CPU::MOS6502Esque::Processor<type, ConcreteAllRAMProcessor, false> mos6502_;
 		int instructions_ = 0;
+		PageTable page_table_;
 
 		class PortHandler: public MOS::MOS6526::PortHandler {};
 		PortHandler cia1_handler_, cia2_handler_;
@@ -171,6 +189,7 @@ AllRAMProcessor *AllRAMProcessor::Processor(Type type, bool has_cias) {
 		Bind(Type::TWDC65C02)
 		Bind(Type::TRockwell65C02)
 		Bind(Type::TWDC65816)
+		Bind(Type::TInstructionLevel6502)
 	}
 #undef Bind
 }
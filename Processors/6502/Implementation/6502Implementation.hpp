@@ -13,6 +13,8 @@
 */
 
 template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::run_for(const Cycles cycles) {
+	Profiling::Scope<Processor> profiling_scope(cycles.as_integral());
+
 #define checkSchedule() \
 	if(!scheduled_program_counter_) {\
 		if(interrupt_requests_) {\
@@ -31,14 +33,25 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	}
 
 #define bus_access() \
+	if constexpr (T::skips_idle_loops) {	\
+		if(next_bus_operation_ == BusOperation::Read) idle_loop_detector_.did_read(bus_address_);	\
+		else if(next_bus_operation_ == BusOperation::Write) idle_loop_detector_.did_write();	\
+	}	\
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::IRQ) | irq_request_history_;	\
 	irq_request_history_ = irq_line_ & flags_.inverse_interrupt;	\
-	number_of_cycles -= bus_handler_.perform_bus_operation(next_bus_operation_, bus_address_, bus_value_);	\
+	{	\
+		const Cycles length = bus_handler_.perform_bus_operation(next_bus_operation_, bus_address_, bus_value_);	\
+		number_of_cycles -= length;	\
+		if(bus_trace_) MOS6502Esque::trace_bus_operation(*bus_trace_, next_bus_operation_, bus_address_, bus_value_, length);	\
+	}	\
 	next_bus_operation_ = BusOperation::None;	\
 	if(number_of_cycles <= Cycles(0)) break;
 
 	checkSchedule();
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	if constexpr (T::skips_idle_loops) {
+		idle_loop_detector_.did_extend_time(cycles);
+	}
 
 	while(number_of_cycles > Cycles(0)) {
 
@@ -88,6 +101,9 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 // MARK: - Fetch/Decode
 
 					case CycleFetchOperation: {
+						if constexpr (T::skips_idle_loops) {
+							consider_idle_loop(number_of_cycles);
+						}
 						last_operation_pc_ = pc_;
 						pc_.full++;
 						read_op(operation_, last_operation_pc_.full);
@@ -662,6 +678,22 @@ template <Personality personality, typename T, bool uses_ready_line> void Proces
 	}
 }
 
+template <Personality personality, typename T, bool uses_ready_line> void Processor<personality, T, uses_ready_line>::consider_idle_loop(Cycles &number_of_cycles) {
+	const IdleLoopRegisters registers = {
+		pc_.full, a_, x_, y_, s_, flags_.get(),
+		uint16_t(interrupt_requests_ | (irq_line_ & flags_.inverse_interrupt))
+	};
+	const auto loop = idle_loop_detector_.instruction(pc_.full, registers, number_of_cycles);
+	if(!loop) return;
+
+	// Leave at least one cycle, so that this run_for ends exactly where it would have without skipping.
+	const Cycles skipped = bus_handler_.skip_idle_loop(*loop, number_of_cycles - Cycles(1));
+	if(skipped <= Cycles(0)) return;
+
+	number_of_cycles -= skipped;
+	idle_loop_detector_.did_skip(skipped, registers);
+}
+
 void ProcessorBase::set_reset_line(bool active) {
 	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::Reset) | (active ? InterruptRequestFlags::Reset : 0);
 }
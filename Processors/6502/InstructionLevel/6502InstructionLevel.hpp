@@ -0,0 +1,206 @@
+//
+//  6502InstructionLevel.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MOS6502InstructionLevel_hpp
+#define MOS6502InstructionLevel_hpp
+
+#include <cstdint>
+
+#include "../../6502Esque/6502Esque.hpp"
+#include "../../6502Esque/Implementation/LazyFlags.hpp"
+#include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../ClockReceiver/ForceInline.hpp"
+
+namespace CPU {
+namespace MOS6502 {
+
+/*!
+	Describes the memory that a bus handler allows the instruction-level 6502 to access directly, in 256-byte pages.
+	A @c nullptr indicates that accesses to that page must be passed to @c perform_bus_operation.
+*/
+struct PageTable {
+	const uint8_t *read[256]{};
+	uint8_t *write[256]{};
+};
+
+/*!
+	A base class from which the instruction-level 6502 descends; separated for implementation reasons only.
+*/
+class InstructionLevelProcessorBase {
+	public:
+		/*!
+			Gets the value of a register.
+
+			@see set_value_of_register
+
+			@param r The register to set.
+			@returns The value of the register. 8-bit registers will be returned as unsigned.
+		*/
+		inline uint16_t get_value_of_register(MOS6502Esque::Register r) const;
+
+		/*!
+			Sets the value of a register.
+
+			@see get_value_of_register
+
+			@param r The register to set.
+			@param value The value to set. If the register is only 8 bit, the value will be truncated.
+		*/
+		inline void set_value_of_register(MOS6502Esque::Register r, uint16_t value);
+
+		/// Sets the current level of the RST line.
+		inline void set_reset_line(bool active);
+
+		/// @returns @c true if the 6502 would reset at the next opportunity.
+		inline bool get_is_resetting() const;
+
+		/// As per the cycle-accurate 6502: this processor will reset at the first opportunity unless @c set_power_on(false) is called.
+		inline void set_power_on(bool active);
+
+		/// Sets the current level of the IRQ line.
+		inline void set_irq_line(bool active);
+
+		/// Sets the current level of the set overflow line; a leading edge will set the overflow flag.
+		inline void set_overflow_line(bool active);
+
+		/// Sets the current level of the NMI line, which is edge triggered.
+		inline void set_nmi_line(bool active);
+
+		/// @returns @c true if the 6502 has encountered an instruction that it doesn't implement.
+		inline bool is_jammed() const;
+
+	protected:
+		uint16_t pc_ = 0, last_operation_pc_ = 0;
+		uint8_t a_ = 0, x_ = 0, y_ = 0, s_ = 0;
+		MOS6502Esque::LazyFlags flags_;
+
+		// The value of flags_.inverse_interrupt as at the point that IRQ is next sampled, which
+		// is before any change made by CLI, SEI or PLP takes effect.
+		uint8_t irq_mask_ = 0;
+
+		enum InterruptRequestFlags: uint8_t {
+			Reset		= 0x80,
+			NMI			= 0x20,
+			PowerOn		= 0x10,
+		};
+		uint8_t interrupt_requests_ = InterruptRequestFlags::PowerOn;
+		uint8_t irq_line_ = 0;
+		bool nmi_line_is_enabled_ = false, set_overflow_line_is_enabled_ = false;
+		bool ready_is_active_ = false;
+		bool is_jammed_ = false;
+};
+
+/*!
+	@abstact Template providing an instruction-level emulation of an NMOS 6502 processor, implementing
+	all documented instructions and decimal mode; any other opcode causes the processor to jam.
+
+	@discussion Unlike CPU::MOS6502::Processor, this performs whole instructions at a time and accesses
+	memory directly through the page table supplied by the bus handler. So bus handlers should provide,
+	in addition to @c perform_bus_operation:
+
+		const PageTable &page_table();
+		void advance_time(Cycles);
+
+	@c perform_bus_operation is called only for accesses to pages that the page table leaves as @c nullptr,
+	each such call accounting for one cycle as usual. All other time is supplied via @c advance_time, which
+	is called as necessary to keep the bus handler up to date before each call to @c perform_bus_operation,
+	and before @c run_for returns. Data accesses are assumed to occupy the final cycles of each instruction,
+	and read-modify-write instructions perform their dummy write if the page is signalled, but no other
+	dummy accesses are made.
+
+	So this is suitable only where instruction-level timing is acceptable, in exchange for substantially
+	reduced cost.
+*/
+template <typename BusHandler, bool uses_ready_line> class InstructionLevelProcessor: public InstructionLevelProcessorBase {
+	public:
+		/*!
+			Constructs an instance of the 6502 that will use @c bus_handler for all bus communications.
+		*/
+		InstructionLevelProcessor(BusHandler &bus_handler) : bus_handler_(bus_handler) {}
+
+		/*!
+			Runs the 6502 for at least the supplied number of cycles; any excess will be deducted from the next call.
+
+			@param cycles The number of cycles to run the 6502 for.
+		*/
+		void run_for(const Cycles cycles);
+
+		/*!
+			Sets the current level of the RDY line; while it is active the processor will make no progress.
+		*/
+		void set_ready_line(bool active) {
+			ready_is_active_ = active;
+		}
+
+	private:
+		BusHandler &bus_handler_;
+
+		// Time that has been spent but not yet supplied to the bus handler.
+		Cycles time_owed_to_bus_handler_;
+
+		// Time remaining in the current call to run_for, which may become negative at the end of an instruction.
+		Cycles cycles_remaining_;
+
+		// Time spent by the current instruction that has been accounted for neither
+		// via time_owed_to_bus_handler_ nor via perform_bus_operation.
+		int instruction_cycles_ = 0;
+
+		// The number of memory accesses, other than opcode and operand fetches, that the current
+		// instruction has yet to make; those are assumed to occupy its final cycles.
+		int accesses_remaining_ = 0;
+
+		forceinline void spend(int cycles);
+		forceinline void flush_time();
+		forceinline void begin(int cycles, int accesses);
+		forceinline void end();
+
+		// Memory accesses other than opcode and operand fetches.
+		forceinline uint8_t read(uint16_t address);
+		forceinline void write(uint16_t address, uint8_t value);
+		template <uint8_t (InstructionLevelProcessor::*operation)(uint8_t)> void read_modify_write(uint16_t address);
+
+		// Opcode and operand fetches.
+		forceinline uint8_t fetch(MOS6502Esque::BusOperation operation = MOS6502Esque::BusOperation::Read);
+		forceinline uint16_t fetch16();
+
+		void catch_up();
+		uint8_t signal(MOS6502Esque::BusOperation operation, uint16_t address, uint8_t value);
+
+		forceinline void push(uint8_t value);
+		forceinline uint8_t pull();
+
+		// Addressing modes; each returns the effective address, adding a cycle for any page crossing if @c is_read.
+		forceinline uint16_t zero_page_indexed(uint8_t index);
+		forceinline uint16_t absolute_indexed(uint8_t index, bool is_read);
+		forceinline uint16_t indexed_indirect();
+		forceinline uint16_t indirect_indexed(bool is_read);
+
+		// Operations.
+		forceinline void adc(uint8_t operand);
+		forceinline void sbc(uint8_t operand);
+		forceinline void compare(uint8_t reg, uint8_t operand);
+		forceinline void bit(uint8_t operand);
+		forceinline void branch(bool condition);
+		uint8_t asl(uint8_t operand);
+		uint8_t lsr(uint8_t operand);
+		uint8_t rol(uint8_t operand);
+		uint8_t ror(uint8_t operand);
+		uint8_t inc(uint8_t operand);
+		uint8_t dec(uint8_t operand);
+
+		void interrupt(uint16_t vector, bool is_brk);
+		void reset();
+		void execute();
+};
+
+#include "Implementation/6502InstructionLevelImplementation.hpp"
+
+}
+}
+
+#endif /* MOS6502InstructionLevel_hpp */
@@ -0,0 +1,616 @@
+//
+//  6502InstructionLevelImplementation.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+/*
+	Here's implementation of the instruction-level 6502; it is included inline
+	within CPU::MOS6502 by 6502InstructionLevel.hpp.
+*/
+
+// MARK: - Time keeping.
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::spend(int cycles) {
+	time_owed_to_bus_handler_ += Cycles(cycles);
+	cycles_remaining_ -= Cycles(cycles);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::flush_time() {
+	if(time_owed_to_bus_handler_ > Cycles(0)) {
+		bus_handler_.advance_time(time_owed_to_bus_handler_);
+		time_owed_to_bus_handler_ = Cycles(0);
+	}
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::begin(int cycles, int accesses) {
+	instruction_cycles_ += cycles;
+	accesses_remaining_ = accesses;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::end() {
+	if(instruction_cycles_ > 0) {
+		spend(instruction_cycles_);
+	}
+	instruction_cycles_ = 0;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::catch_up() {
+	// Data accesses are assumed to occupy the final cycles of the instruction, so
+	// spend everything that precedes them.
+	if(instruction_cycles_ > accesses_remaining_) {
+		spend(instruction_cycles_ - accesses_remaining_);
+		instruction_cycles_ = accesses_remaining_;
+	}
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::signal(MOS6502Esque::BusOperation operation, uint16_t address, uint8_t value) {
+	flush_time();
+	cycles_remaining_ -= bus_handler_.perform_bus_operation(operation, address, &value);
+	--instruction_cycles_;
+	return value;
+}
+
+// MARK: - Memory access.
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::read(uint16_t address) {
+	const uint8_t *const page = bus_handler_.page_table().read[address >> 8];
+	if(page) {
+		--accesses_remaining_;
+		return page[address & 0xff];
+	}
+
+	catch_up();
+	--accesses_remaining_;
+	return signal(MOS6502Esque::BusOperation::Read, address, 0xff);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::write(uint16_t address, uint8_t value) {
+	uint8_t *const page = bus_handler_.page_table().write[address >> 8];
+	if(page) {
+		--accesses_remaining_;
+		page[address & 0xff] = value;
+		return;
+	}
+
+	catch_up();
+	--accesses_remaining_;
+	signal(MOS6502Esque::BusOperation::Write, address, value);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+template <uint8_t (InstructionLevelProcessor<BusHandler, uses_ready_line>::*operation)(uint8_t)>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::read_modify_write(uint16_t address) {
+	const uint8_t source = read(address);
+	const uint8_t result = (this->*operation)(source);
+
+	uint8_t *const page = bus_handler_.page_table().write[address >> 8];
+	if(page) {
+		accesses_remaining_ -= 2;
+		page[address & 0xff] = result;
+		return;
+	}
+
+	write(address, source);
+	write(address, result);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::fetch(MOS6502Esque::BusOperation operation) {
+	const uint16_t address = pc_++;
+	const uint8_t *const page = bus_handler_.page_table().read[address >> 8];
+	if(page) {
+		return page[address & 0xff];
+	}
+	return signal(operation, address, 0xff);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint16_t InstructionLevelProcessor<BusHandler, uses_ready_line>::fetch16() {
+	const uint8_t low = fetch();
+	return uint16_t(low | (fetch() << 8));
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::push(uint8_t value) {
+	write(0x100 | s_, value);
+	--s_;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::pull() {
+	++s_;
+	return read(0x100 | s_);
+}
+
+// MARK: - Addressing modes.
+
+template <typename BusHandler, bool uses_ready_line>
+uint16_t InstructionLevelProcessor<BusHandler, uses_ready_line>::zero_page_indexed(uint8_t index) {
+	return uint8_t(fetch() + index);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint16_t InstructionLevelProcessor<BusHandler, uses_ready_line>::absolute_indexed(uint8_t index, bool is_read) {
+	const uint16_t base = fetch16();
+	const uint16_t address = uint16_t(base + index);
+	if(is_read && ((base ^ address) & 0xff00)) {
+		++instruction_cycles_;
+	}
+	return address;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint16_t InstructionLevelProcessor<BusHandler, uses_ready_line>::indexed_indirect() {
+	const uint8_t pointer = uint8_t(fetch() + x_);
+	const uint8_t low = read(pointer);
+	return uint16_t(low | (read(uint8_t(pointer + 1)) << 8));
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint16_t InstructionLevelProcessor<BusHandler, uses_ready_line>::indirect_indexed(bool is_read) {
+	const uint8_t pointer = fetch();
+	const uint8_t low = read(pointer);
+	const uint16_t base = uint16_t(low | (read(uint8_t(pointer + 1)) << 8));
+	const uint16_t address = uint16_t(base + y_);
+	if(is_read && ((base ^ address) & 0xff00)) {
+		++instruction_cycles_;
+	}
+	return address;
+}
+
+// MARK: - Operations.
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::adc(uint8_t operand) {
+	if(flags_.decimal) {
+		const uint16_t decimalResult = uint16_t(a_) + uint16_t(operand) + uint16_t(flags_.carry);
+
+		uint8_t low_nibble = (a_ & 0xf) + (operand & 0xf) + flags_.carry;
+		if(low_nibble >= 0xa) low_nibble = ((low_nibble + 0x6) & 0xf) + 0x10;
+		uint16_t result = uint16_t(a_ & 0xf0) + uint16_t(operand & 0xf0) + uint16_t(low_nibble);
+		flags_.negative_result = uint8_t(result);
+		flags_.overflow = (( (result^a_)&(result^operand) )&0x80) >> 1;
+		if(result >= 0xa0) result += 0x60;
+
+		flags_.carry = (result >> 8) ? 1 : 0;
+		a_ = uint8_t(result);
+		flags_.zero_result = uint8_t(decimalResult);
+	} else {
+		const uint16_t result = uint16_t(a_) + uint16_t(operand) + uint16_t(flags_.carry);
+		flags_.overflow = (( (result^a_)&(result^operand) )&0x80) >> 1;
+		flags_.set_nz(a_ = uint8_t(result));
+		flags_.carry = (result >> 8)&1;
+	}
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::sbc(uint8_t operand) {
+	if(!flags_.decimal) {
+		adc(uint8_t(~operand));
+		return;
+	}
+
+	const uint16_t notCarry = flags_.carry ^ 0x1;
+	const uint16_t decimalResult = uint16_t(a_) - uint16_t(operand) - notCarry;
+	uint16_t temp16;
+
+	temp16 = (a_&0xf) - (operand&0xf) - notCarry;
+	if(temp16 > 0xf) temp16 -= 0x6;
+	temp16 = (temp16&0x0f) | ((temp16 > 0x0f) ? 0xfff0 : 0x00);
+	temp16 += (a_&0xf0) - (operand&0xf0);
+
+	flags_.overflow = ( ( (decimalResult^a_)&(~decimalResult^operand) )&0x80) >> 1;
+	flags_.negative_result = uint8_t(temp16);
+	flags_.zero_result = uint8_t(decimalResult);
+
+	if(temp16 > 0xff) temp16 -= 0x60;
+
+	flags_.carry = (temp16 > 0xff) ? 0 : MOS6502Esque::Flag::Carry;
+	a_ = uint8_t(temp16);
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::compare(uint8_t reg, uint8_t operand) {
+	const uint16_t result = uint16_t(reg - operand);
+	flags_.set_nz(uint8_t(result));
+	flags_.carry = ((result >> 8) & 1) ^ 1;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::bit(uint8_t operand) {
+	flags_.zero_result = operand & a_;
+	flags_.negative_result = operand;
+	flags_.overflow = operand & MOS6502Esque::Flag::Overflow;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::branch(bool condition) {
+	const uint8_t offset = fetch();
+	if(condition) {
+		const uint16_t target = uint16_t(pc_ + int8_t(offset));
+		instruction_cycles_ += ((target ^ pc_) & 0xff00) ? 2 : 1;
+		pc_ = target;
+	}
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::asl(uint8_t operand) {
+	flags_.carry = operand >> 7;
+	operand <<= 1;
+	flags_.set_nz(operand);
+	return operand;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::lsr(uint8_t operand) {
+	flags_.carry = operand & 1;
+	operand >>= 1;
+	flags_.set_nz(operand);
+	return operand;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::rol(uint8_t operand) {
+	const uint8_t result = uint8_t((operand << 1) | flags_.carry);
+	flags_.carry = operand >> 7;
+	flags_.set_nz(result);
+	return result;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::ror(uint8_t operand) {
+	const uint8_t result = uint8_t((operand >> 1) | (flags_.carry << 7));
+	flags_.carry = operand & 1;
+	flags_.set_nz(result);
+	return result;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::inc(uint8_t operand) {
+	flags_.set_nz(++operand);
+	return operand;
+}
+
+template <typename BusHandler, bool uses_ready_line>
+uint8_t InstructionLevelProcessor<BusHandler, uses_ready_line>::dec(uint8_t operand) {
+	flags_.set_nz(--operand);
+	return operand;
+}
+
+// MARK: - Interrupts.
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::interrupt(uint16_t vector, bool is_brk) {
+	push(uint8_t(pc_ >> 8));
+	push(uint8_t(pc_));
+	push(is_brk ? flags_.get() : uint8_t(flags_.get() & ~MOS6502Esque::Flag::Break));
+	flags_.inverse_interrupt = 0;
+	irq_mask_ = 0;
+
+	const uint8_t low = read(vector);
+	pc_ = uint16_t(low | (read(vector + 1) << 8));
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::reset() {
+	// Stack accesses during reset are reads, which have no side effects on the stack page.
+	begin(7, 2);
+	interrupt_requests_ &= ~InterruptRequestFlags::PowerOn;
+	is_jammed_ = false;
+	s_ -= 3;
+	flags_.inverse_interrupt = 0;
+	irq_mask_ = 0;
+
+	const uint8_t low = read(0xfffc);
+	pc_ = uint16_t(low | (read(0xfffd) << 8));
+	end();
+}
+
+// MARK: - Execution.
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::run_for(const Cycles cycles) {
+	cycles_remaining_ += cycles;
+
+	while(cycles_remaining_ > Cycles(0)) {
+		if(interrupt_requests_ & (InterruptRequestFlags::Reset | InterruptRequestFlags::PowerOn)) {
+			reset();
+			continue;
+		}
+
+		if(is_jammed_ || (uses_ready_line && ready_is_active_)) {
+			spend(cycles_remaining_.as<int>());
+			break;
+		}
+
+		if(interrupt_requests_ & InterruptRequestFlags::NMI) {
+			interrupt_requests_ &= ~InterruptRequestFlags::NMI;
+			begin(7, 5);
+			interrupt(0xfffa, false);
+			end();
+			continue;
+		}
+
+		if(irq_line_ & irq_mask_) {
+			begin(7, 5);
+			interrupt(0xfffe, false);
+			end();
+			continue;
+		}
+
+		execute();
+		end();
+	}
+
+	flush_time();
+}
+
+template <typename BusHandler, bool uses_ready_line>
+void InstructionLevelProcessor<BusHandler, uses_ready_line>::execute() {
+	using Flag = MOS6502Esque::Flag;
+	using Processor = InstructionLevelProcessor<BusHandler, uses_ready_line>;
+
+	// IRQ is sampled before any change to the interrupt flag by this instruction takes effect.
+	irq_mask_ = flags_.inverse_interrupt;
+	last_operation_pc_ = pc_;
+
+	const uint8_t opcode = fetch(MOS6502Esque::BusOperation::ReadOpcode);
+	switch(opcode) {
+
+// MARK: - Reads.
+
+		// The eight main read modes, at their usual positions relative to base.
+#define Read(base, operation)	\
+		case base + 0x01:	begin(6, 3);	operation(read(indexed_indirect()));				break;	\
+		case base + 0x05:	begin(3, 1);	operation(read(fetch()));							break;	\
+		case base + 0x09:	begin(2, 0);	operation(fetch());									break;	\
+		case base + 0x0d:	begin(4, 1);	operation(read(fetch16()));							break;	\
+		case base + 0x11:	begin(5, 3);	operation(read(indirect_indexed(true)));			break;	\
+		case base + 0x15:	begin(4, 1);	operation(read(zero_page_indexed(x_)));				break;	\
+		case base + 0x19:	begin(4, 1);	operation(read(absolute_indexed(y_, true)));		break;	\
+		case base + 0x1d:	begin(4, 1);	operation(read(absolute_indexed(x_, true)));		break;
+
+#define ORA(v)	flags_.set_nz(a_ |= (v))
+#define AND(v)	flags_.set_nz(a_ &= (v))
+#define EOR(v)	flags_.set_nz(a_ ^= (v))
+#define LDA(v)	flags_.set_nz(a_ = (v))
+#define CMP(v)	compare(a_, (v))
+
+		Read(0x00, ORA);
+		Read(0x20, AND);
+		Read(0x40, EOR);
+		Read(0x60, adc);
+		Read(0xa0, LDA);
+		Read(0xc0, CMP);
+		Read(0xe0, sbc);
+
+#undef ORA
+#undef AND
+#undef EOR
+#undef LDA
+#undef CMP
+#undef Read
+
+		case 0xa2:	begin(2, 0);	flags_.set_nz(x_ = fetch());								break;
+		case 0xa6:	begin(3, 1);	flags_.set_nz(x_ = read(fetch()));							break;
+		case 0xb6:	begin(4, 1);	flags_.set_nz(x_ = read(zero_page_indexed(y_)));			break;
+		case 0xae:	begin(4, 1);	flags_.set_nz(x_ = read(fetch16()));						break;
+		case 0xbe:	begin(4, 1);	flags_.set_nz(x_ = read(absolute_indexed(y_, true)));		break;
+
+		case 0xa0:	begin(2, 0);	flags_.set_nz(y_ = fetch());								break;
+		case 0xa4:	begin(3, 1);	flags_.set_nz(y_ = read(fetch()));							break;
+		case 0xb4:	begin(4, 1);	flags_.set_nz(y_ = read(zero_page_indexed(x_)));			break;
+		case 0xac:	begin(4, 1);	flags_.set_nz(y_ = read(fetch16()));						break;
+		case 0xbc:	begin(4, 1);	flags_.set_nz(y_ = read(absolute_indexed(x_, true)));		break;
+
+		case 0xe0:	begin(2, 0);	compare(x_, fetch());										break;
+		case 0xe4:	begin(3, 1);	compare(x_, read(fetch()));									break;
+		case 0xec:	begin(4, 1);	compare(x_, read(fetch16()));								break;
+
+		case 0xc0:	begin(2, 0);	compare(y_, fetch());										break;
+		case 0xc4:	begin(3, 1);	compare(y_, read(fetch()));									break;
+		case 0xcc:	begin(4, 1);	compare(y_, read(fetch16()));								break;
+
+		case 0x24:	begin(3, 1);	bit(read(fetch()));											break;
+		case 0x2c:	begin(4, 1);	bit(read(fetch16()));										break;
+
+// MARK: - Writes.
+
+		case 0x81:	begin(6, 3);	write(indexed_indirect(), a_);								break;
+		case 0x85:	begin(3, 1);	write(fetch(), a_);											break;
+		case 0x8d:	begin(4, 1);	write(fetch16(), a_);										break;
+		case 0x91:	begin(6, 3);	write(indirect_indexed(false), a_);							break;
+		case 0x95:	begin(4, 1);	write(zero_page_indexed(x_), a_);							break;
+		case 0x99:	begin(5, 1);	write(absolute_indexed(y_, false), a_);						break;
+		case 0x9d:	begin(5, 1);	write(absolute_indexed(x_, false), a_);						break;
+
+		case 0x86:	begin(3, 1);	write(fetch(), x_);											break;
+		case 0x96:	begin(4, 1);	write(zero_page_indexed(y_), x_);							break;
+		case 0x8e:	begin(4, 1);	write(fetch16(), x_);										break;
+
+		case 0x84:	begin(3, 1);	write(fetch(), y_);											break;
+		case 0x94:	begin(4, 1);	write(zero_page_indexed(x_), y_);							break;
+		case 0x8c:	begin(4, 1);	write(fetch16(), y_);										break;
+
+// MARK: - Read-modify-writes.
+
+#define Modify(base, operation)	\
+		case base + 0x06:	begin(5, 3);	read_modify_write<&Processor::operation>(fetch());								break;	\
+		case base + 0x0e:	begin(6, 3);	read_modify_write<&Processor::operation>(fetch16());							break;	\
+		case base + 0x16:	begin(6, 3);	read_modify_write<&Processor::operation>(zero_page_indexed(x_));				break;	\
+		case base + 0x1e:	begin(7, 3);	read_modify_write<&Processor::operation>(absolute_indexed(x_, false));		break;
+
+		Modify(0x00, asl);
+		Modify(0x20, rol);
+		Modify(0x40, lsr);
+		Modify(0x60, ror);
+		Modify(0xc0, dec);
+		Modify(0xe0, inc);
+
+#undef Modify
+
+		case 0x0a:	begin(2, 0);	a_ = asl(a_);				break;
+		case 0x2a:	begin(2, 0);	a_ = rol(a_);				break;
+		case 0x4a:	begin(2, 0);	a_ = lsr(a_);				break;
+		case 0x6a:	begin(2, 0);	a_ = ror(a_);				break;
+
+// MARK: - Implied.
+
+		case 0xaa:	begin(2, 0);	flags_.set_nz(x_ = a_);		break;
+		case 0xa8:	begin(2, 0);	flags_.set_nz(y_ = a_);		break;
+		case 0x8a:	begin(2, 0);	flags_.set_nz(a_ = x_);		break;
+		case 0x98:	begin(2, 0);	flags_.set_nz(a_ = y_);		break;
+		case 0xba:	begin(2, 0);	flags_.set_nz(x_ = s_);		break;
+		case 0x9a:	begin(2, 0);	s_ = x_;					break;
+
+		case 0xe8:	begin(2, 0);	flags_.set_nz(++x_);		break;
+		case 0xc8:	begin(2, 0);	flags_.set_nz(++y_);		break;
+		case 0xca:	begin(2, 0);	flags_.set_nz(--x_);		break;
+		case 0x88:	begin(2, 0);	flags_.set_nz(--y_);		break;
+
+		case 0x18:	begin(2, 0);	flags_.carry = 0;								break;
+		case 0x38:	begin(2, 0);	flags_.carry = Flag::Carry;						break;
+		case 0x58:	begin(2, 0);	flags_.inverse_interrupt = Flag::Interrupt;		break;
+		case 0x78:	begin(2, 0);	flags_.inverse_interrupt = 0;					break;
+		case 0xb8:	begin(2, 0);	flags_.overflow = 0;							break;
+		case 0xd8:	begin(2, 0);	flags_.decimal = 0;								break;
+		case 0xf8:	begin(2, 0);	flags_.decimal = Flag::Decimal;					break;
+
+		case 0xea:	begin(2, 0);	break;
+
+// MARK: - Stack.
+
+		case 0x48:	begin(3, 1);	push(a_);						break;
+		case 0x08:	begin(3, 1);	push(flags_.get());				break;
+		case 0x68:	begin(4, 1);	flags_.set_nz(a_ = pull());		break;
+		case 0x28:	begin(4, 1);	flags_.set(pull());				break;
+
+// MARK: - Flow control.
+
+		case 0x10:	begin(2, 0);	branch(!(flags_.negative_result & 0x80));	break;
+		case 0x30:	begin(2, 0);	branch(flags_.negative_result & 0x80);		break;
+		case 0x50:	begin(2, 0);	branch(!flags_.overflow);					break;
+		case 0x70:	begin(2, 0);	branch(flags_.overflow);					break;
+		case 0x90:	begin(2, 0);	branch(!flags_.carry);						break;
+		case 0xb0:	begin(2, 0);	branch(flags_.carry);						break;
+		case 0xd0:	begin(2, 0);	branch(flags_.zero_result);					break;
+		case 0xf0:	begin(2, 0);	branch(!flags_.zero_result);				break;
+
+		case 0x4c:	begin(3, 0);	pc_ = fetch16();			break;
+		case 0x6c: {
+			begin(5, 2);
+
+			// The high byte of the vector is fetched from within the same page as the low.
+			const uint16_t pointer = fetch16();
+			const uint8_t low = read(pointer);
+			pc_ = uint16_t(low | (read((pointer & 0xff00) | ((pointer + 1) & 0xff)) << 8));
+		} break;
+
+		case 0x20: {
+			// The final operand fetch follows the stack accesses, so is counted amongst them.
+			begin(6, 3);
+			const uint8_t low = fetch();
+			push(uint8_t(pc_ >> 8));
+			push(uint8_t(pc_));
+			pc_ = uint16_t(low | (fetch() << 8));
+		} break;
+
+		case 0x60: {
+			begin(6, 2);
+			const uint8_t low = pull();
+			pc_ = uint16_t((low | (pull() << 8)) + 1);
+		} break;
+
+		case 0x40: {
+			begin(6, 3);
+			flags_.set(pull());
+			irq_mask_ = flags_.inverse_interrupt;
+
+			const uint8_t low = pull();
+			pc_ = uint16_t(low | (pull() << 8));
+		} break;
+
+		case 0x00:
+			begin(7, 5);
+			++pc_;
+			interrupt(0xfffe, true);
+		break;
+
+		default:
+			begin(2, 0);
+			is_jammed_ = true;
+		break;
+	}
+}
+
+// MARK: - Base class.
+
+uint16_t InstructionLevelProcessorBase::get_value_of_register(MOS6502Esque::Register r) const {
+	switch (r) {
+		case MOS6502Esque::Register::ProgramCounter:			return pc_;
+		case MOS6502Esque::Register::LastOperationAddress:		return last_operation_pc_;
+		case MOS6502Esque::Register::StackPointer:				return s_;
+		case MOS6502Esque::Register::Flags:						return flags_.get();
+		case MOS6502Esque::Register::A:							return a_;
+		case MOS6502Esque::Register::X:							return x_;
+		case MOS6502Esque::Register::Y:							return y_;
+		default: return 0;
+	}
+}
+
+void InstructionLevelProcessorBase::set_value_of_register(MOS6502Esque::Register r, uint16_t value) {
+	switch (r) {
+		case MOS6502Esque::Register::ProgramCounter:	pc_ = value;				break;
+		case MOS6502Esque::Register::StackPointer:		s_ = uint8_t(value);		break;
+		case MOS6502Esque::Register::Flags:				flags_.set(uint8_t(value));	break;
+		case MOS6502Esque::Register::A:					a_ = uint8_t(value);		break;
+		case MOS6502Esque::Register::X:					x_ = uint8_t(value);		break;
+		case MOS6502Esque::Register::Y:					y_ = uint8_t(value);		break;
+		default: break;
+	}
+}
+
+void InstructionLevelProcessorBase::set_reset_line(bool active) {
+	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::Reset) | (active ? InterruptRequestFlags::Reset : 0);
+}
+
+bool InstructionLevelProcessorBase::get_is_resetting() const {
+	return interrupt_requests_ & (InterruptRequestFlags::Reset | InterruptRequestFlags::PowerOn);
+}
+
+void InstructionLevelProcessorBase::set_power_on(bool active) {
+	interrupt_requests_ = (interrupt_requests_ & ~InterruptRequestFlags::PowerOn) | (active ? InterruptRequestFlags::PowerOn : 0);
+}
+
+void InstructionLevelProcessorBase::set_irq_line(bool active) {
+	irq_line_ = active ? MOS6502Esque::Flag::Interrupt : 0;
+}
+
+void InstructionLevelProcessorBase::set_overflow_line(bool active) {
+	// a leading edge will set the overflow flag
+	if(active && !set_overflow_line_is_enabled_)
+		flags_.overflow = MOS6502Esque::Flag::Overflow;
+	set_overflow_line_is_enabled_ = active;
+}
+
+void InstructionLevelProcessorBase::set_nmi_line(bool active) {
+	// NMI is edge triggered, not level
+	if(active && !nmi_line_is_enabled_)
+		interrupt_requests_ |= InterruptRequestFlags::NMI;
+	nmi_line_is_enabled_ = active;
+}
+
+bool InstructionLevelProcessorBase::is_jammed() const {
+	return is_jammed_;
+}
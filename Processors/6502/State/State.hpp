@@ -86,7 +86,7 @@ struct State: public Reflection::StructImpl<State> {
 	State(const ProcessorBase &src);
 
 	/// Applies this state to @c target.
-	void apply(ProcessorBase &target);
+	void apply(ProcessorBase &target) const;
 };
 
 
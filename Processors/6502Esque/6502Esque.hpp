@@ -10,6 +10,8 @@
 #define m6502Esque_h
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../BusTrace.hpp"
+#include "../IdleLoopDetector.hpp"
 
 /*
 	This file defines how the CPU-controlled part of a bus looks for the 6502 and
@@ -113,6 +115,18 @@ enum BusOperation {
 */
 #define isAccessOperation(v)	((v <= CPU::MOS6502Esque::ReadVector) || (v == CPU::MOS6502Esque::Write))
 
+/*!
+	Records a completed bus operation to @c trace; @c value is inspected only for reads and writes.
+*/
+inline void trace_bus_operation(CPU::BusTrace &trace, BusOperation operation, uint32_t address, const uint8_t *value, Cycles length) {
+	trace.record(
+		operation,
+		address,
+		((isReadOperation(operation) || isWriteOperation(operation)) && value) ? *value : 0,
+		length.as<int>()
+	);
+}
+
 /*!
 	A class providing empty implementations of the methods a 6502 uses to access the bus. To wire the 6502 to a bus,
 	machines should subclass BusHandler and then declare a realisation of the 6502 template, suplying their bus
@@ -121,6 +135,7 @@ enum BusOperation {
 template <typename addr_t> class BusHandler {
 	public:
 		using AddressType = addr_t;
+		using IdleLoop = CPU::IdleLoop<Cycles, addr_t>;
 
 		/*!
 			Announces that the 6502 has performed the cycle defined by operation, address and value. On the 6502,
@@ -141,6 +156,20 @@ template <typename addr_t> class BusHandler {
 		Cycles perform_bus_operation([[maybe_unused]] BusOperation operation, [[maybe_unused]] addr_t address, [[maybe_unused]] uint8_t *value) {
 			return Cycles(1);
 		}
+
+		/*!
+			Bus handlers may set this to @c true to be offered the chance to skip idle loops, such as a short loop
+			polling a device, via:
+
+				Cycles skip_idle_loop(const IdleLoop &loop, Cycles limit);
+
+			The processor will call that upon completing any iteration of a loop that performed no writes and that
+			left all registers as they were. The bus handler should then advance time by a whole number of iterations
+			of @c loop, not exceeding @c limit, during which it is certain that every address in @c loop.reads would
+			have produced the same value as during the iteration just completed, and no interrupt would have been
+			signalled. It should return the amount of time so advanced, or zero to decline.
+		*/
+		static constexpr bool skips_idle_loops = false;
 };
 
 }
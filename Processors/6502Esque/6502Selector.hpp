@@ -10,6 +10,7 @@
 #define _502Selector_h
 
 #include "../6502/6502.hpp"
+#include "../6502/InstructionLevel/6502InstructionLevel.hpp"
 #include "../65816/65816.hpp"
 
 namespace CPU {
@@ -22,6 +23,8 @@ enum class Type {
 	TRockwell65C02,		// like the Synertek, but with BBR, BBS, RMB and SMB
 	TWDC65C02,			// like the Rockwell, but with STP and WAI
 	TWDC65816,			// the slightly 16-bit follow-up to the 6502
+
+	TInstructionLevel6502,	// an original [NMOS] 6502 implemented at instruction level, with direct access to memory via a page table; see 6502InstructionLevel.hpp
 };
 
 /*
@@ -40,6 +43,11 @@ template <typename BusHandler, bool uses_ready_line> class Processor<Type::TWDC6
 		using CPU::WDC65816::Processor<BusHandler, uses_ready_line>::Processor;
 };
 
+template <typename BusHandler, bool uses_ready_line> class Processor<Type::TInstructionLevel6502, BusHandler, uses_ready_line>:
+	public CPU::MOS6502::InstructionLevelProcessor<BusHandler, uses_ready_line> {
+		using CPU::MOS6502::InstructionLevelProcessor<BusHandler, uses_ready_line>::InstructionLevelProcessor;
+};
+
 /*
 	Using BusHandlerT allows bus size to be defaulted by processor type.
 */
@@ -9,6 +9,7 @@
 #ifndef WDC65816_hpp
 #define WDC65816_hpp
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -16,6 +17,7 @@
 
 #include "../../Numeric/RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../ClockReceiver/Profiler.hpp"
 #include "../6502Esque/6502Esque.hpp"
 #include "../6502Esque/Implementation/LazyFlags.hpp"
 
@@ -63,6 +65,17 @@ class ProcessorBase: protected ProcessorStorage {
 
 		void set_value_of_register(Register r, uint16_t value);
 		uint16_t get_value_of_register(Register r) const;
+
+		/*!
+			Nominates @c trace to receive a record of every subsequent bus operation, or ends tracing
+			if @c trace is @c nullptr.
+		*/
+		void set_bus_trace(CPU::BusTrace *trace) {
+			bus_trace_ = trace;
+		}
+
+	protected:
+		CPU::BusTrace *bus_trace_ = nullptr;
 };
 
 template <typename BusHandler, bool uses_ready_line> class Processor: public ProcessorBase {
@@ -88,6 +101,11 @@ template <typename BusHandler, bool uses_ready_line> class Processor: public Pro
 
 	private:
 		BusHandler &bus_handler_;
+
+		// Idle-loop detection, per the bus handler's skips_idle_loops.
+		using IdleLoopRegisters = std::array<uint16_t, 10>;
+		CPU::IdleLoopDetector<IdleLoopRegisters, Cycles, typename BusHandler::AddressType> idle_loop_detector_;
+		void consider_idle_loop(Cycles &number_of_cycles);
 };
 
 #include "Implementation/65816Implementation.hpp"
@@ -7,6 +7,7 @@
 //
 
 template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler, uses_ready_line>::run_for(const Cycles cycles) {
+	Profiling::Scope<Processor> profiling_scope(cycles.as_integral());
 
 #define perform_bus(address, value, operation)	\
 	bus_address_ = (address) & 0xff'ffff;		\
@@ -22,6 +23,9 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 #define stack_address()	((registers_.s.full & registers_.e_masks[1]) | (0x0100 & registers_.e_masks[0]))
 
 	Cycles number_of_cycles = cycles + cycles_left_to_run_;
+	if constexpr (BusHandler::skips_idle_loops) {
+		idle_loop_detector_.did_extend_time(cycles);
+	}
 	while(number_of_cycles > Cycles(0)) {
 		// Wait for ready to be inactive before proceeding.
 		while(uses_ready_line && ready_line_ && number_of_cycles > Cycles(0)) {
@@ -59,6 +63,10 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 					} else {
 						exception_is_interrupt_ = false;
 						active_instruction_ = &instructions[size_t(OperationSlot::FetchDecodeExecute)];
+
+						if constexpr (BusHandler::skips_idle_loops) {
+							consider_idle_loop(number_of_cycles);
+						}
 					}
 
 					next_op_ = &micro_ops_[active_instruction_->program_offsets[0]];
@@ -71,9 +79,7 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 
 				case OperationDecode: {
 					active_instruction_ = &instructions[instruction_buffer_.value];
-
-					const auto size_flag = registers_.mx_flags[active_instruction_->size_field];
-					next_op_ = &micro_ops_[active_instruction_->program_offsets[size_flag]];
+					next_op_ = &micro_ops_[mx_program_offsets[registers_.mx_table][instruction_buffer_.value]];
 					instruction_buffer_.clear();
 				} continue;
 
@@ -1018,7 +1024,24 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 			// Store a selection as to the exceptions, if any, that would be honoured after this cycle if the
 			// next thing is a MoveToNextProgram.
 			selected_exceptions_ = pending_exceptions_ & (registers_.flags.inverse_interrupt | PowerOn | Reset | NMI);
-			number_of_cycles -= bus_handler_.perform_bus_operation(bus_operation_, static_cast<typename BusHandler::AddressType>(bus_address_), bus_value_);
+			if constexpr (BusHandler::skips_idle_loops) {
+				switch(bus_operation_) {
+					default: break;
+					case MOS6502Esque::Read:
+					case MOS6502Esque::ReadProgram:
+					case MOS6502Esque::ReadVector:
+					case MOS6502Esque::InternalOperationRead:
+						idle_loop_detector_.did_read(static_cast<typename BusHandler::AddressType>(bus_address_));
+					break;
+					case MOS6502Esque::Write:
+					case MOS6502Esque::InternalOperationWrite:
+						idle_loop_detector_.did_write();
+					break;
+				}
+			}
+			const Cycles length = bus_handler_.perform_bus_operation(bus_operation_, static_cast<typename BusHandler::AddressType>(bus_address_), bus_value_);
+			number_of_cycles -= length;
+			if(bus_trace_) MOS6502Esque::trace_bus_operation(*bus_trace_, bus_operation_, bus_address_, bus_value_, length);
 		}
 	}
 
@@ -1085,6 +1108,26 @@ template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler,
 	ready_line_ = active;
 }
 
+template <typename BusHandler, bool uses_ready_line> void Processor<BusHandler, uses_ready_line>::consider_idle_loop(Cycles &number_of_cycles) {
+	const IdleLoopRegisters registers = {
+		registers_.a.full, registers_.x.full, registers_.y.full, registers_.s.full,
+		registers_.pc, registers_.flags.get(),
+		uint16_t(registers_.mx_flags[0] | (registers_.mx_flags[1] << 1) | (registers_.emulation_flag ? 4 : 0)),
+		registers_.direct,
+		uint16_t((registers_.data_bank >> 16) | (registers_.program_bank >> 8)),
+		uint16_t(pending_exceptions_)
+	};
+	const auto loop = idle_loop_detector_.instruction(static_cast<typename BusHandler::AddressType>(registers_.pc | registers_.program_bank), registers, number_of_cycles);
+	if(!loop) return;
+
+	// Leave at least one cycle, so that this run_for ends exactly where it would have without skipping.
+	const Cycles skipped = bus_handler_.skip_idle_loop(*loop, number_of_cycles - Cycles(1));
+	if(skipped <= Cycles(0)) return;
+
+	number_of_cycles -= skipped;
+	idle_loop_detector_.did_skip(skipped, registers);
+}
+
 // The 65816 can't jam.
 bool ProcessorBase::is_jammed() const { return false; }
 
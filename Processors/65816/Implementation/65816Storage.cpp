@@ -1083,6 +1083,15 @@ ProcessorStorage::ProcessorStorage() {
 	constructor.set_exception_generator(&ProcessorStorageConstructor::stack_exception, &ProcessorStorageConstructor::reset);
 	constructor.install_fetch_decode_execute();
 
+	// Resolve the program for every opcode under each combination of M and X, so that decoding
+	// needn't inspect either flag.
+	for(int table = 0; table < 4; table++) {
+		for(size_t c = 0; c < 256; c++) {
+			const uint8_t size_flag = (table >> instructions[c].size_field) & 1;
+			mx_program_offsets[table][c] = instructions[c].program_offsets[size_flag];
+		}
+	}
+
 	// Find any OperationMoveToNextProgram.
 	next_op_ = micro_ops_.data();
 	while(*next_op_ != OperationMoveToNextProgram) ++next_op_;
@@ -1131,6 +1140,7 @@ void ProcessorStorage::set_m_x_flags(bool m, bool x) {
 	// true/1 => 8bit for both flags.
 	registers_.mx_flags[0] = m;
 	registers_.mx_flags[1] = x;
+	registers_.mx_table = uint8_t(m | (x << 1));
 }
 
 uint8_t ProcessorStorage::get_flags() const {
@@ -265,6 +265,11 @@ struct ProcessorStorage {
 		FetchDecodeExecute,
 	};
 
+	/// The program offsets from @c instructions resolved for each combination of the M and X flags,
+	/// indexed as [m | (x << 1)][opcode]; the table for the current flags is given by @c Registers::mx_table.
+	/// Emulation mode implies that M and X are both set, so it always uses the final table.
+	uint16_t mx_program_offsets[4][256];
+
 	// A helper for testing.
 	uint16_t last_operation_pc_;
 	uint8_t last_operation_program_bank_;
@@ -285,6 +290,9 @@ struct ProcessorStorage {
 		// [0] = m; [1] = x. In both cases either `0` or `1`; `1` => 8-bit.
 		uint8_t mx_flags[2] = {1, 1};
 
+		// The index into mx_program_offsets that corresponds to the current m and x flags.
+		uint8_t mx_table = 3;
+
 		// Used to determine which parts of a register are currently in use, as a function
 		// of the M flag.
 		//
@@ -20,6 +20,7 @@
 
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../ClockReceiver/Profiler.hpp"
 #include "../../Numeric/RegisterSizes.hpp"
 
 namespace CPU {
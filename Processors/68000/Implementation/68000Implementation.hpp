@@ -68,6 +68,7 @@
 #endif
 
 template <class T, bool dtack_is_implicit, bool signal_will_perform> void Processor<T, dtack_is_implicit, signal_will_perform>::run_for(HalfCycles duration) {
+	Profiling::Scope<Processor> profiling_scope(duration.as_integral());
 	const HalfCycles remaining_duration = duration + half_cycles_left_to_run_;
 
 	// This loop counts upwards rather than downwards because it simplifies calculation of
@@ -9,13 +9,21 @@
 #ifndef _8000Mk2_h
 #define _8000Mk2_h
 
+#include <array>
+
+#include "../BusTrace.hpp"
+#include "../IdleLoopDetector.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../ClockReceiver/Profiler.hpp"
 #include "../../Numeric/RegisterSizes.hpp"
 #include "../../InstructionSets/M68k/RegisterSet.hpp"
 
 namespace CPU {
 namespace MC68000Mk2 {
 
+/// Describes an idle loop, as offered to bus handlers that set @c skips_idle_loops.
+using IdleLoop = CPU::IdleLoop<HalfCycles, uint32_t>;
+
 /*!
 	A microcycle is an atomic unit of 68000 bus activity — it is a single item large enough
 	fully to specify a sequence of bus events that occur without any possible interruption.
@@ -331,6 +339,19 @@ struct Microcycle {
 	}
 };
 
+/*!
+	Records a completed microcycle of total length @c length to @c trace; the data value is
+	recorded only for cycles that select a byte or word.
+*/
+inline void trace_bus_operation(CPU::BusTrace &trace, const Microcycle &cycle, HalfCycles length) {
+	uint16_t value = 0;
+	if(cycle.value) {
+		if(cycle.operation & Microcycle::SelectWord) value = cycle.value->w;
+		else if(cycle.operation & Microcycle::SelectByte) value = cycle.value->b;
+	}
+	trace.record(cycle.operation, cycle.address ? *cycle.address : 0, value, length.as<int>());
+}
+
 /*!
 	This is the prototype for a 68000 bus handler; real bus handlers can descend from this
 	in order to get default implementations of any changes that may occur in the expected interface.
@@ -351,6 +372,40 @@ class BusHandler {
 			Provides information about the path of execution if enabled via the template.
 		*/
 		void will_perform([[maybe_unused]] uint32_t address, [[maybe_unused]] uint16_t opcode) {}
+
+		/*!
+			Bus handlers may set this to @c true to be offered the chance to skip idle loops, such as a short loop
+			polling a device, via:
+
+				HalfCycles skip_idle_loop(const IdleLoop &loop, HalfCycles limit);
+
+			The 68000 will call that upon completing any iteration of a loop that performed no writes, interrupt
+			acknowledgements or resets, and that left all registers as they were. The bus handler should then
+			advance time by a whole number of iterations of @c loop, not exceeding @c limit, during which it is certain
+			that every address in @c loop.reads would have produced the same value as during the iteration just completed,
+			and the interrupt level wouldn't have changed. It should return the amount of time so advanced, or zero to decline.
+		*/
+		static constexpr bool skips_idle_loops = false;
+
+		/*!
+			Bus handlers may set this to @c true to allow the 68000 to complete accesses to plain memory — memory
+			with no side effects — itself, rather than calling @c perform_bus_operation for each of their microcycles.
+			They should then implement:
+
+				uint8_t *plain_memory(const Microcycle &cycle, int is_supervisor, HalfCycles pending, HalfCycles &delay);
+
+			The 68000 will offer each read or write via its data-select microcycle before announcing the address.
+			If the access is to plain memory, and would assert neither VPA nor BERR, the bus handler should return a
+			pointer suitable for use with @c Microcycle::apply and set @c delay to the number of wait states the access
+			would incur. Otherwise it should return @c nullptr, and the access will proceed as usual.
+
+			The time spent on accesses completed in this way, and on idle microcycles, isn't passed to the bus handler
+			immediately; @c pending gives the amount of time that has passed so far without having been passed on,
+			up to the start of the access being offered. It is eventually supplied as a single null microcycle — one with
+			neither @c NewAddress nor @c SameAddress set — before any other call to @c perform_bus_operation, before the
+			interrupt inputs are sampled and before @c run_for returns.
+		*/
+		static constexpr bool has_plain_memory = false;
 };
 
 struct State {
@@ -397,6 +452,14 @@ class Processor: private ProcessorBase {
 
 		void run_for(HalfCycles duration);
 
+		/// Runs for at most @c duration, but returns early upon reaching an instruction boundary, i.e.
+		/// immediately before the next instruction is decoded.
+		///
+		/// @returns @c true if a boundary was reached, in which case @c duration will have been updated to
+		/// the amount of time not yet expended, and @c get_state will give a state appropriate to
+		/// use with @c decode_from_state. @c false otherwise.
+		bool run_to_instruction_boundary(HalfCycles &duration);
+
 		/// @returns The current processor state.
 		CPU::MC68000Mk2::State get_state();
 
@@ -409,6 +472,13 @@ class Processor: private ProcessorBase {
 		/// The queue is filled synchronously, during this call, causing calls to the bus handler.
 		void decode_from_state(const InstructionSet::M68k::RegisterSet &);
 
+		/// Sets all registers and the prefetch queue to the values provided and ensures the
+		/// next action the processor will take is to decode whatever is in the queue.
+		///
+		/// No bus activity occurs; the program counter should already point beyond the prefetched words,
+		/// as per @c get_state.
+		void decode_from_state(const CPU::MC68000Mk2::State &);
+
 		// TODO: bus ack/grant, halt,
 
 		/// Sets the DTack line — @c true for active, @c false for inactive.
@@ -443,8 +513,27 @@ class Processor: private ProcessorBase {
 
 		void reset();
 
+		/// Nominates @c trace to receive a record of every subsequent bus access, or ends tracing
+		/// if @c trace is @c nullptr. Idle cycles are recorded only if the bus handler lacks plain memory.
+		void set_bus_trace(CPU::BusTrace *trace) {
+			bus_trace_ = trace;
+		}
+
 	private:
 		BusHandler &bus_handler_;
+
+		CPU::BusTrace *bus_trace_ = nullptr;
+
+		// Idle-loop detection, per the bus handler's skips_idle_loops.
+		using IdleLoopRegisters = std::array<uint32_t, 22>;
+		CPU::IdleLoopDetector<IdleLoopRegisters, HalfCycles, uint32_t> idle_loop_detector_;
+		void consider_idle_loop();
+		inline void record_idle_loop_access(const Microcycle &);
+
+		// Plain-memory accesses, per the bus handler's has_plain_memory.
+		HalfCycles plain_time_;
+		inline bool perform_plain_access(const Microcycle &, HalfCycles &delay);
+		inline void flush_plain_time();
 };
 
 }
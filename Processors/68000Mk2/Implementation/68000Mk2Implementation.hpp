@@ -212,11 +212,15 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	// Accumulate the newly paid-in cycles. If this instance remains in deficit, exit.
 	e_clock_phase_ += duration;
 	time_remaining_ += duration;
+	if constexpr (BusHandler::skips_idle_loops) {
+		idle_loop_detector_.did_extend_time(duration);
+	}
 	if(time_remaining_ < HalfCycles(0)) return;
+	Profiling::Scope<Processor> profiling_scope(duration.as_integral());
 
 	// Check whether all remaining time has been expended; if so then exit, having set this line up as
 	// the next resumption point.
-#define ConsiderExit()	if(time_remaining_ < HalfCycles(0)) { state_ = ExecutionState::Max + ((__COUNTER__+1) >> 1); return; } [[fallthrough]]; case ExecutionState::Max + (__COUNTER__ >> 1):
+#define ConsiderExit()	if(time_remaining_ < HalfCycles(0)) { state_ = ExecutionState::Max + ((__COUNTER__+1) >> 1); flush_plain_time(); return; } [[fallthrough]]; case ExecutionState::Max + (__COUNTER__ >> 1):
 
 	// Subtracts `n` half-cycles from `time_remaining_`; if permit_overrun is false, also ConsiderExit()
 #define Spend(n)		time_remaining_ -= (n); if constexpr (!permit_overrun) ConsiderExit()
@@ -284,13 +288,25 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	// Performs the bus operation and then applies a `Spend` of its length
 	// plus any additional length returned by the bus handler.
 #define PerformBusOperation(x)										\
+	if constexpr (BusHandler::skips_idle_loops) {					\
+		record_idle_loop_access(x);									\
+	}																\
+	flush_plain_time();												\
 	delay = bus_handler_.perform_bus_operation(x, is_supervisor_);	\
+	if(bus_trace_) trace_bus_operation(*bus_trace_, x, x.length + delay);	\
 	Spend(x.length + delay)
 
-	// Performs no bus activity for the specified number of microcycles.
+	// Performs no bus activity for the specified number of microcycles;
+	// if the bus handler has plain memory then this is deferred along with
+	// plain-memory accesses.
 #define IdleBus(n)						\
 	idle.length = HalfCycles((n) << 2);	\
-	PerformBusOperation(idle)
+	if(BusHandler::has_plain_memory) {	\
+		plain_time_ += idle.length;		\
+		Spend(idle.length);				\
+	} else {							\
+		PerformBusOperation(idle);		\
+	}
 
 	// Spin until DTACK, VPA or BERR is asserted (unless DTACK is implicit),
 	// holding the bus cycle provided.
@@ -334,9 +350,13 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	if(*perform.address & (perform.operation >> 1) & 1) {	\
 		RaiseBusOrAddressError(AddressError, perform);		\
 	}														\
-	PerformBusOperation(announce);							\
-	WaitForDTACK(announce);									\
-	CompleteAccess(perform);
+	if(perform_plain_access(perform, delay)) {				\
+		Spend(HalfCycles(8) + delay);						\
+	} else {												\
+		PerformBusOperation(announce);						\
+		WaitForDTACK(announce);								\
+		CompleteAccess(perform);							\
+	}
 
 	// Sets up the next data access size and read flags.
 #define SetupDataAccess(read_flag, select_flag)												\
@@ -361,6 +381,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 #define Prefetch()										\
 	prefetch_.high = prefetch_.low;						\
 	ReadProgramWord(prefetch_.low)						\
+	flush_plain_time();									\
 	captured_interrupt_level_ = bus_interrupt_level_;
 
 	// Copies the current program counter, adjusted to allow for the prefetch queue,
@@ -400,6 +421,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 
 		BeginState(WaitForInterrupt):
 			// Spin in place until an interrupt arrives.
+			flush_plain_time();
 			captured_interrupt_level_ = bus_interrupt_level_;
 			if(status_.would_accept_interrupt(captured_interrupt_level_)) {
 				MoveToStateSpecific(DoInterrupt);
@@ -649,6 +671,14 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 		BeginState(Decode):
 			CheckOverrun();
 
+			// Exit here if requested by run_to_instruction_boundary.
+			if(stop_at_instruction_boundary_) {
+				state_ = Decode;
+				did_reach_instruction_boundary_ = true;
+				flush_plain_time();
+				return;
+			}
+
 			// Capture the address of the next instruction.
 			ReloadInstructionAddress();
 
@@ -665,6 +695,11 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 			// Capture the current trace flag.
 			should_trace_ = status_.trace_flag;
 
+			// Look for an idle loop if the bus handler is interested.
+			if constexpr (BusHandler::skips_idle_loops) {
+				consider_idle_loop();
+			}
+
 			// Read and decode an opcode.
 			opcode_ = prefetch_.high.w;
 			instruction_ = decoder_.decode(opcode_);
@@ -3073,16 +3108,11 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
 void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::decode_from_state(const InstructionSet::M68k::RegisterSet &registers) {
 	// Populate registers.
-	CPU::MC68000Mk2::State state;
+	CPU::MC68000Mk2::State state{};
 	state.registers = registers;
-	set_state(state);
-
-	// Ensure the state machine will resume at decode.
-	state_ = Decode;
+	decode_from_state(state);
 
 	// Fill the prefetch queue.
-	captured_interrupt_level_ = bus_interrupt_level_;
-
 	read_program.value = &prefetch_.high;
 	bus_handler_.perform_bus_operation(read_program_announce, is_supervisor_);
 	bus_handler_.perform_bus_operation(read_program, is_supervisor_);
@@ -3094,6 +3124,106 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	program_counter_.l += 2;
 }
 
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::decode_from_state(const CPU::MC68000Mk2::State &state) {
+	set_state(state);
+
+	// Ensure the state machine will resume at decode.
+	state_ = Decode;
+	captured_interrupt_level_ = bus_interrupt_level_;
+}
+
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+bool Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::run_to_instruction_boundary(HalfCycles &duration) {
+	stop_at_instruction_boundary_ = true;
+	did_reach_instruction_boundary_ = false;
+	run_for(duration);
+	stop_at_instruction_boundary_ = false;
+
+	if(!did_reach_instruction_boundary_) {
+		return false;
+	}
+
+	// Return whatever time is left, and don't count it towards the E clock.
+	if constexpr (BusHandler::skips_idle_loops) {
+		idle_loop_detector_.did_extend_time(-time_remaining_);
+	}
+	duration = time_remaining_;
+	e_clock_phase_ -= time_remaining_;
+	time_remaining_ = HalfCycles(0);
+	return true;
+}
+
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::record_idle_loop_access(const Microcycle &cycle) {
+	// Program reads are treated like opcode fetches elsewhere, i.e. they aren't recorded.
+	if(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte)) {
+		if(!(cycle.operation & Microcycle::Read)) {
+			idle_loop_detector_.did_write();
+		} else if(!(cycle.operation & Microcycle::IsProgram)) {
+			idle_loop_detector_.did_read(*cycle.address);
+		}
+	}
+	if(cycle.operation & (Microcycle::InterruptAcknowledge | Microcycle::Reset)) {
+		idle_loop_detector_.did_write();
+	}
+}
+
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::consider_idle_loop() {
+	IdleLoopRegisters registers;
+	for(int c = 0; c < 16; c++) {
+		registers[size_t(c)] = registers_[c].l;
+	}
+	registers[16] = stack_pointers_[0].l;
+	registers[17] = stack_pointers_[1].l;
+	registers[18] = program_counter_.l;
+	registers[19] = prefetch_.l;
+	registers[20] = status_.status();
+	registers[21] = uint32_t(captured_interrupt_level_);
+
+	const auto loop = idle_loop_detector_.instruction(instruction_address_.l, registers, time_remaining_);
+	if(!loop) return;
+
+	flush_plain_time();
+	const HalfCycles skipped = bus_handler_.skip_idle_loop(*loop, time_remaining_);
+	if(skipped <= HalfCycles(0)) return;
+
+	time_remaining_ -= skipped;
+	idle_loop_detector_.did_skip(skipped, registers);
+}
+
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+bool Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::perform_plain_access(const Microcycle &cycle, HalfCycles &delay) {
+	if constexpr (BusHandler::has_plain_memory) {
+		uint8_t *const memory = bus_handler_.plain_memory(cycle, is_supervisor_, plain_time_, delay);
+		if(!memory) return false;
+
+		if constexpr (BusHandler::skips_idle_loops) {
+			record_idle_loop_access(cycle);
+		}
+		cycle.apply(memory);
+
+		// Account for both the address strobe and the data strobe.
+		plain_time_ += HalfCycles(8) + delay;
+		if(bus_trace_) trace_bus_operation(*bus_trace_, cycle, HalfCycles(8) + delay);
+		return true;
+	} else {
+		return false;
+	}
+}
+
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::flush_plain_time() {
+	if constexpr (BusHandler::has_plain_memory) {
+		if(plain_time_ == HalfCycles(0)) return;
+
+		const Microcycle cycle(0, plain_time_);
+		plain_time_ = HalfCycles(0);
+		bus_handler_.perform_bus_operation(cycle, is_supervisor_);
+	}
+}
+
 template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
 void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::reset() {
 	state_ = Reset;
@@ -39,7 +39,7 @@ struct ProcessorBase: public InstructionSet::M68k::NullFlowController {
 
 	// A decoder for instructions, plus all collected information about the
 	// current instruction.
-	InstructionSet::M68k::Predecoder<InstructionSet::M68k::Model::M68000> decoder_;
+	InstructionSet::M68k::CachingPredecoder<InstructionSet::M68k::Model::M68000> decoder_;
 	InstructionSet::M68k::Preinstruction instruction_;
 	uint16_t opcode_;
 	uint8_t operand_flags_;
@@ -57,6 +57,10 @@ struct ProcessorBase: public InstructionSet::M68k::NullFlowController {
 	bool vpa_ = false;
 	/// Current state of the BERR input.
 	bool berr_ = false;
+
+	/// Set if run_for should exit at the next instruction boundary, and records whether it did.
+	bool stop_at_instruction_boundary_ = false;
+	bool did_reach_instruction_boundary_ = false;
 	/// Current input interrupt level.
 	int bus_interrupt_level_ = 0;
 
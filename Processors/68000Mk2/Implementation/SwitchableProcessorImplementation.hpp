@@ -0,0 +1,273 @@
+//
+//  SwitchableProcessorImplementation.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef _8000Mk2_SwitchableProcessorImplementation_h
+#define _8000Mk2_SwitchableProcessorImplementation_h
+
+namespace CPU {
+namespace MC68000Mk2 {
+
+#define TemplateParameters	template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+#define Switchable			SwitchableProcessor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>
+
+// MARK: - Execution.
+
+TemplateParameters
+void Switchable::run_for(HalfCycles duration) {
+	time_remaining_ += duration;
+
+	while(time_remaining_ > HalfCycles(0)) {
+		if(!is_fast_mode_) {
+			// If fast mode isn't wanted, just pass all time to the accurate processor.
+			if(!fast_mode_requested_) {
+				accurate_.run_for(time_remaining_);
+				time_remaining_ = HalfCycles(0);
+				return;
+			}
+
+			// Otherwise, run up to the next instruction boundary and switch there.
+			HalfCycles remaining = time_remaining_;
+			if(!accurate_.run_to_instruction_boundary(remaining)) {
+				time_remaining_ = HalfCycles(0);
+				return;
+			}
+			time_remaining_ = remaining;
+
+			// The accurate processor's program counter points beyond the two prefetched words.
+			enter_fast_mode(accurate_.get_state());
+			continue;
+		}
+
+		// Switch back to bus-accurate mode if requested, unless currently STOPped;
+		// that state can't be communicated to the accurate processor.
+		if(!fast_mode_requested_ && !executor_->is_stopped()) {
+			leave_fast_mode();
+			continue;
+		}
+
+		// Run a single instruction. If the executor is STOPped then idle the bus until something changes;
+		// an instruction may otherwise legitimately take no bus time, being satisfied from the prefetch.
+		executor_is_running_ = true;
+		executor_->run_for_instructions(1);
+		executor_is_running_ = false;
+		if(executor_->is_stopped()) {
+			Microcycle idle(0, HalfCycles(4));
+			perform(idle, is_supervisor_);
+		}
+	}
+}
+
+TemplateParameters
+void Switchable::enter_fast_mode(const CPU::MC68000Mk2::State &state) {
+	if(!executor_) {
+		// Construction performs a reset, which is immediately superseded. ExecutorBus ignores
+		// everything until executor_ is set, so that reset has no effect on the bus.
+		executor_ = std::make_unique<Executor>(executor_bus_);
+	}
+
+	auto registers = state.registers;
+	registers.program_counter -= 4;
+	executor_->set_state(registers);
+	executor_->set_interrupt_level(interrupt_level_);
+	is_fast_mode_ = true;
+
+	// The accurate processor has already fetched the next two words; hand them over.
+	prefetch_[0] = state.prefetch[0];
+	prefetch_[1] = state.prefetch[1];
+	prefetch_address_ = registers.program_counter;
+	prefetch_count_ = 2;
+}
+
+TemplateParameters
+void Switchable::leave_fast_mode() {
+	// Fill the accurate processor's prefetch queue, using whatever is left of the
+	// handed-over words before fetching the remainder with proper bus timing.
+	// A bus error here will instead be encountered when the accurate processor next prefetches.
+	CPU::MC68000Mk2::State state{};
+	state.registers = executor_->get_state();
+
+	const auto function =
+		(state.registers.status & 0x2000) ?
+			InstructionSet::M68k::FunctionCode::SupervisorProgram : InstructionSet::M68k::FunctionCode::UserProgram;
+	state.prefetch[0] = executor_bus_.template read<uint16_t>(state.registers.program_counter, function);
+	state.prefetch[1] = executor_bus_.template read<uint16_t>(state.registers.program_counter + 2, function);
+	state.registers.program_counter += 4;
+
+	is_fast_mode_ = false;
+	accurate_.decode_from_state(state);
+}
+
+// MARK: - State.
+
+TemplateParameters
+CPU::MC68000Mk2::State Switchable::get_state() {
+	if(!is_fast_mode_) {
+		return accurate_.get_state();
+	}
+
+	// Present the program counter as the accurate processor would, i.e. beyond the prefetch.
+	CPU::MC68000Mk2::State state{};
+	state.registers = executor_->get_state();
+	state.registers.program_counter += 4;
+	state.prefetch[0] = state.prefetch[1] = 0;
+	return state;
+}
+
+TemplateParameters
+void Switchable::set_state(const CPU::MC68000Mk2::State &state) {
+	if(!is_fast_mode_) {
+		accurate_.set_state(state);
+		return;
+	}
+
+	auto registers = state.registers;
+	registers.program_counter -= 4;
+	executor_->set_state(registers);
+}
+
+TemplateParameters
+void Switchable::decode_from_state(const InstructionSet::M68k::RegisterSet &registers) {
+	is_fast_mode_ = false;
+	accurate_.decode_from_state(registers);
+}
+
+// MARK: - Bus activity on behalf of the executor.
+
+TemplateParameters
+void Switchable::perform(Microcycle &cycle, int is_supervisor) {
+	const HalfCycles total = cycle.length + bus_handler_.perform_bus_operation(cycle, is_supervisor);
+	if(bus_trace_) trace_bus_operation(*bus_trace_, cycle, total);
+	time_remaining_ -= total;
+	fast_e_clock_phase_ += total;
+}
+
+TemplateParameters
+void Switchable::access(Microcycle::OperationT operation, uint32_t address, InstructionSet::M68k::FunctionCode function) {
+	using FunctionCode = InstructionSet::M68k::FunctionCode;
+
+	is_supervisor_ = (int(function) >> 2) & 1;
+	const Microcycle::OperationT function_flags =
+		((int(function) & int(FunctionCode::UserData)) ? Microcycle::IsData : 0) |
+		((int(function) & int(FunctionCode::UserProgram)) ? Microcycle::IsProgram : 0);
+	address_ = address;
+
+	Microcycle announce(Microcycle::NewAddress | function_flags | (operation & Microcycle::Read));
+	announce.address = &address_;
+	announce.value = &value_;
+	perform(announce, is_supervisor_);
+	if(berr_ && executor_is_running_) {
+		executor_->signal_bus_error(function, address);
+	}
+
+	// Stretch to the E clock if VPA is asserted, as per the accurate processor.
+	Microcycle data(Microcycle::SameAddress | function_flags | operation);
+	data.address = &address_;
+	data.value = &value_;
+	if(vpa_) {
+		data.length = HalfCycles(20) + (HalfCycles(20) + fast_e_clock_phase_ % HalfCycles(20)) % HalfCycles(20);
+	}
+	perform(data, is_supervisor_);
+	if(berr_ && executor_is_running_) {
+		executor_->signal_bus_error(function, address);
+	}
+}
+
+TemplateParameters
+template <typename IntT>
+IntT Switchable::ExecutorBus::read(uint32_t address, InstructionSet::M68k::FunctionCode function) {
+	if constexpr (sizeof(IntT) == 4) {
+		const uint32_t high = read<uint16_t>(address, function);
+		return IntT((high << 16) | read<uint16_t>(address + 2, function));
+	} else {
+		if(!owner.executor_) {
+			return IntT(~0);
+		}
+
+		// Satisfy sequential program fetches from any words handed over by the accurate processor.
+		if(owner.prefetch_count_ && (int(function) & 0b011) == int(InstructionSet::M68k::FunctionCode::UserProgram)) {
+			if constexpr (sizeof(IntT) == 2) {
+				if(address == owner.prefetch_address_) {
+					const uint16_t value = owner.prefetch_[2 - owner.prefetch_count_];
+					--owner.prefetch_count_;
+					owner.prefetch_address_ += 2;
+					return value;
+				}
+			}
+			owner.prefetch_count_ = 0;
+		}
+
+		owner.value_.w = 0xffff;
+		owner.access(Microcycle::Read | (sizeof(IntT) == 1 ? Microcycle::SelectByte : Microcycle::SelectWord), address, function);
+
+		if constexpr (sizeof(IntT) == 1) {
+			return owner.value_.b;
+		} else {
+			return owner.value_.w;
+		}
+	}
+}
+
+TemplateParameters
+template <typename IntT>
+void Switchable::ExecutorBus::write(uint32_t address, IntT value, InstructionSet::M68k::FunctionCode function) {
+	if(!owner.executor_) {
+		return;
+	}
+
+	if constexpr (sizeof(IntT) == 4) {
+		write<uint16_t>(address, uint16_t(value >> 16), function);
+		write<uint16_t>(address + 2, uint16_t(value), function);
+	} else if constexpr (sizeof(IntT) == 1) {
+		owner.value_.b = value;
+		owner.access(Microcycle::SelectByte, address, function);
+	} else {
+		owner.value_.w = value;
+		owner.access(Microcycle::SelectWord, address, function);
+	}
+}
+
+TemplateParameters
+void Switchable::ExecutorBus::reset() {
+	if(!owner.executor_) {
+		return;
+	}
+
+	Microcycle cycle(Microcycle::Reset, HalfCycles(248));
+	owner.perform(cycle, 1);
+}
+
+TemplateParameters
+int Switchable::ExecutorBus::acknowlege_interrupt(int interrupt_level) {
+	owner.address_ = 0xffff'fff1 | uint32_t(interrupt_level << 1);
+	owner.value_.w = 0xffff;
+
+	Microcycle announce(Microcycle::InterruptAcknowledge | Microcycle::Read | Microcycle::NewAddress);
+	announce.address = &owner.address_;
+	announce.value = &owner.value_;
+	owner.perform(announce, 1);
+
+	Microcycle data(Microcycle::InterruptAcknowledge | Microcycle::Read | Microcycle::SameAddress | Microcycle::SelectByte);
+	data.address = &owner.address_;
+	data.value = &owner.value_;
+	if(owner.vpa_) {
+		data.length = HalfCycles(20) + (HalfCycles(20) + owner.fast_e_clock_phase_ % HalfCycles(20)) % HalfCycles(20);
+	}
+	owner.perform(data, 1);
+
+	if(owner.vpa_) return -1;
+	if(owner.berr_) return InstructionSet::M68k::Exception::SpuriousInterrupt;
+	return owner.value_.b;
+}
+
+#undef Switchable
+#undef TemplateParameters
+
+}
+}
+
+#endif /* _8000Mk2_SwitchableProcessorImplementation_h */
@@ -0,0 +1,149 @@
+//
+//  SwitchableProcessor.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 14/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef _8000Mk2_SwitchableProcessor_h
+#define _8000Mk2_SwitchableProcessor_h
+
+#include "68000Mk2.hpp"
+#include "../../InstructionSets/M68k/Executor.hpp"
+
+#include <memory>
+
+namespace CPU {
+namespace MC68000Mk2 {
+
+/*!
+	Provides the same interface as MC68000Mk2::Processor, but is able to switch at runtime between
+	that bus-accurate implementation and the instruction-level InstructionSet::M68k::Executor.
+
+	In fast mode every memory access is still presented to the @c BusHandler as a standard pair of
+	address-strobe-then-data-strobe microcycles, honouring VPA and BERR, so machines need no changes
+	in order to support it. But internal processing time is not counted, prefetch is not modelled and
+	the timing of interrupts is approximate. It is therefore intended for fast-forwarding.
+
+	Switches take effect at the next instruction boundary; register state and the two words of the
+	prefetch queue are handed between the two cores, so nothing is fetched twice.
+*/
+template <class BusHandler, bool dtack_is_implicit = true, bool permit_overrun = true, bool signal_will_perform = false>
+class SwitchableProcessor {
+	public:
+		SwitchableProcessor(BusHandler &bus_handler) : bus_handler_(bus_handler), accurate_(bus_handler) {}
+		SwitchableProcessor(const SwitchableProcessor& rhs) = delete;
+		SwitchableProcessor& operator=(const SwitchableProcessor& rhs) = delete;
+
+		void run_for(HalfCycles duration);
+
+		/// Requests either fast, instruction-level execution or bus-accurate execution.
+		/// The change will occur at the next instruction boundary.
+		void set_fast_mode(bool fast_mode) {
+			fast_mode_requested_ = fast_mode;
+		}
+
+		/// @returns @c true if the processor is currently executing in fast mode; @c false otherwise.
+		bool is_fast_mode() const {
+			return is_fast_mode_;
+		}
+
+		/// @returns The current processor state. In fast mode the prefetch queue is not populated.
+		CPU::MC68000Mk2::State get_state();
+
+		/// Sets the current processor state. In fast mode the prefetch queue is ignored.
+		void set_state(const CPU::MC68000Mk2::State &);
+
+		/// As per MC68000Mk2::Processor::decode_from_state; this always resumes in bus-accurate mode,
+		/// switching back to fast mode at the next opportunity if so requested.
+		void decode_from_state(const InstructionSet::M68k::RegisterSet &);
+
+		/// As per MC68000Mk2::Processor::set_bus_trace; in fast mode, each access is recorded as a single microcycle.
+		void set_bus_trace(CPU::BusTrace *trace) {
+			bus_trace_ = trace;
+			accurate_.set_bus_trace(trace);
+		}
+
+		inline void set_dtack(bool dtack) {
+			accurate_.set_dtack(dtack);
+		}
+
+		inline void set_is_peripheral_address(bool is_peripheral_address) {
+			vpa_ = is_peripheral_address;
+			accurate_.set_is_peripheral_address(is_peripheral_address);
+		}
+
+		inline void set_bus_error(bool bus_error) {
+			berr_ = bus_error;
+			accurate_.set_bus_error(bus_error);
+		}
+
+		inline void set_interrupt_level(int interrupt_level) {
+			interrupt_level_ = interrupt_level;
+			accurate_.set_interrupt_level(interrupt_level);
+			if(executor_) executor_->set_interrupt_level(interrupt_level);
+		}
+
+		HalfCycles get_e_clock_phase() {
+			return is_fast_mode_ ? fast_e_clock_phase_ % HalfCycles(20) : accurate_.get_e_clock_phase();
+		}
+
+		/// Resets the processor; reset is always performed in bus-accurate mode.
+		void reset() {
+			is_fast_mode_ = false;
+			accurate_.reset();
+		}
+
+	private:
+		/// Adapts the Executor's bus interface to microcycles for the BusHandler.
+		struct ExecutorBus {
+			SwitchableProcessor &owner;
+
+			template <typename IntT> void write(uint32_t address, IntT value, InstructionSet::M68k::FunctionCode function);
+			template <typename IntT> IntT read(uint32_t address, InstructionSet::M68k::FunctionCode function);
+			void reset();
+			int acknowlege_interrupt(int interrupt_level);
+		};
+		using Executor = InstructionSet::M68k::Executor<InstructionSet::M68k::Model::M68000, ExecutorBus>;
+
+		BusHandler &bus_handler_;
+		Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform> accurate_;
+
+		// The executor is created only upon first use. Its construction implies a reset,
+		// which ExecutorBus disregards since executor_ is not yet set.
+		ExecutorBus executor_bus_{*this};
+		std::unique_ptr<Executor> executor_;
+
+		bool fast_mode_requested_ = false;
+		bool is_fast_mode_ = false;
+		bool executor_is_running_ = false;
+
+		// Prefetched words handed over by the accurate processor, not yet consumed by the executor.
+		uint16_t prefetch_[2]{};
+		uint32_t prefetch_address_ = 0;
+		int prefetch_count_ = 0;
+
+		// Time accounting and bus state for fast mode.
+		HalfCycles time_remaining_;
+		HalfCycles fast_e_clock_phase_;
+		bool vpa_ = false, berr_ = false;
+		int interrupt_level_ = 0;
+		int is_supervisor_ = 1;
+		CPU::BusTrace *bus_trace_ = nullptr;
+
+		uint32_t address_ = 0;
+		SlicedInt16 value_;
+
+		void enter_fast_mode(const CPU::MC68000Mk2::State &);
+		void leave_fast_mode();
+		void perform(Microcycle &cycle, int is_supervisor);
+		void access(Microcycle::OperationT operation, uint32_t address, InstructionSet::M68k::FunctionCode function);
+};
+
+}
+}
+
+#include "Implementation/SwitchableProcessorImplementation.hpp"
+
+#endif /* _8000Mk2_SwitchableProcessor_h */
@@ -8,12 +8,15 @@
 
 #include "AllRAMProcessor.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace CPU;
 
 AllRAMProcessor::AllRAMProcessor(std::size_t memory_size) :
 	memory_(memory_size),
-	traps_(memory_size, false),
-	timestamp_(0) {}
+	timestamp_(0),
+	traps_(memory_size, false) {}
 
 void AllRAMProcessor::set_data_at_address(size_t start_address, std::size_t length, const uint8_t *data) {
 	const size_t end_address = std::min(start_address + length, memory_.size());
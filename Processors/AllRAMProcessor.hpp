@@ -31,9 +31,15 @@ class AllRAMProcessor {
 		void set_trap_handler(TrapHandler *trap_handler);
 		void add_trap_address(uint16_t address);
 
+		/// @returns The number of opcode fetches performed so far; on a Z80 each prefix is a separate fetch.
+		uint64_t get_opcode_fetches() const {
+			return opcode_fetches_;
+		}
+
 	protected:
 		std::vector<uint8_t> memory_;
 		HalfCycles timestamp_;
+		uint64_t opcode_fetches_ = 0;
 
 		inline void check_address_for_trap(uint16_t address) {
 			if(traps_[address]) {
@@ -0,0 +1,75 @@
+//
+//  BusTrace.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "BusTrace.hpp"
+
+#include "../Concurrency/AsyncTaskQueue.hpp"
+#include "../Storage/FileHolder.hpp"
+
+#include <array>
+
+#include <zlib.h>
+
+using namespace CPU;
+
+/// Compresses blocks and writes them to the file; used only on the queue's thread after construction.
+struct BusTrace::Writer {
+	Writer(const std::string &file_name, Bus bus) : file(file_name, Storage::FileHolder::FileMode::Rewrite) {
+		file.write(reinterpret_cast<const uint8_t *>("CLKTRACE"), 8);
+		file.put_le<uint32_t>(1);
+		file.put8(uint8_t(bus));
+
+		// Favour speed over ratio; the delta-encoded stream is highly repetitive regardless.
+		deflateInit(&stream, Z_BEST_SPEED);
+	}
+
+	~Writer() {
+		deflateEnd(&stream);
+	}
+
+	void compress(const uint8_t *data, size_t size, int flush) {
+		stream.next_in = const_cast<Bytef *>(data);
+		stream.avail_in = uInt(size);
+		do {
+			stream.next_out = output.data();
+			stream.avail_out = uInt(output.size());
+			deflate(&stream, flush);
+			file.write(output.data(), output.size() - stream.avail_out);
+		} while(!stream.avail_out);
+	}
+
+	Storage::FileHolder file;
+	z_stream stream{};
+	std::array<uint8_t, 64 * 1024> output;
+
+	Concurrency::AsyncTaskQueue<true> queue;
+};
+
+BusTrace::BusTrace(const std::string &file_name, Bus bus) :
+	block_(new uint8_t[BlockSize]),
+	writer_(std::make_unique<Writer>(file_name, bus)) {}
+
+BusTrace::~BusTrace() {
+	write_block();
+	writer_->queue.enqueue([this] {
+		writer_->compress(nullptr, 0, Z_FINISH);
+	});
+	writer_->queue.stop();
+}
+
+void BusTrace::write_block() {
+	// Hand the current block to the queue, and start a new one.
+	auto block = std::shared_ptr<uint8_t[]>(block_.release());
+	const size_t size = block_size_;
+	writer_->queue.enqueue([this, block, size] {
+		writer_->compress(block.get(), size, Z_NO_FLUSH);
+	});
+
+	block_.reset(new uint8_t[BlockSize]);
+	block_size_ = 0;
+}
@@ -0,0 +1,98 @@
+//
+//  BusTrace.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef BusTrace_hpp
+#define BusTrace_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace CPU {
+
+/*!
+	Records every bus cycle performed by a processor to a compressed file, at a cost low enough to be
+	left running for an entire session; e.g. to compare two sessions and find where they first diverge.
+
+	Processors supporting tracing offer a @c set_bus_trace method, and record each cycle after their
+	bus handler has performed it — so that reads include the value read — as an operation, address,
+	data value and length in half cycles. The meaning of the operation field is processor-specific:
+	it is the numeric value of the Z80's PartialMachineCycle::Operation, the 6502 or 65816's
+	BusOperation, or the 68000's Microcycle::OperationT.
+
+	Files begin "CLKTRACE", a 32-bit version number and a @c Bus byte, all little endian, followed by
+	a zlib stream. Within that stream each cycle is stored as varints — seven bits per byte, least
+	significant first, with the top bit set on all but the final byte — of:
+
+		the operation;
+		the signed difference between this address and the previous, zigzag encoded;
+		the data value; and
+		the length.
+
+	Recording appends only to an in-memory block; full blocks are compressed and written by a
+	background thread.
+*/
+class BusTrace {
+	public:
+		enum class Bus: uint8_t {
+			Z80,
+			MOS6502,
+			WDC65816,
+			MC68000,
+		};
+
+		/*!
+			Begins a new trace in @c file_name.
+
+			@throws Storage::FileHolder::Error if the file could not be opened.
+		*/
+		BusTrace(const std::string &file_name, Bus bus);
+
+		/// Compresses and writes all remaining cycles, completing the file.
+		~BusTrace();
+
+		/// Records a bus cycle.
+		void record(uint32_t operation, uint32_t address, uint16_t value, int length) {
+			if(block_size_ > BlockSize - MaxRecordSize) {
+				write_block();
+			}
+
+			put(operation);
+			const int32_t difference = int32_t(address - last_address_);
+			put((uint32_t(difference) << 1) ^ uint32_t(difference >> 31));
+			put(value);
+			put(uint32_t(length));
+			last_address_ = address;
+		}
+
+	private:
+		static constexpr size_t BlockSize = 64 * 1024;
+		static constexpr size_t MaxRecordSize = 4 * 5;
+
+		std::unique_ptr<uint8_t[]> block_;
+		size_t block_size_ = 0;
+		uint32_t last_address_ = 0;
+
+		void put(uint32_t value) {
+			while(value >= 0x80) {
+				block_[block_size_++] = uint8_t(value | 0x80);
+				value >>= 7;
+			}
+			block_[block_size_++] = uint8_t(value);
+		}
+
+		void write_block();
+
+		struct Writer;
+		std::unique_ptr<Writer> writer_;
+};
+
+}
+
+#endif /* BusTrace_hpp */
@@ -0,0 +1,135 @@
+//
+//  IdleLoopDetector.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef IdleLoopDetector_hpp
+#define IdleLoopDetector_hpp
+
+namespace CPU {
+
+/*!
+	Describes an idle loop: a short sequence of instructions that returns the processor to exactly the state
+	it was in beforehand, without writing to memory or performing any other access that might have side effects.
+	Such a loop will therefore repeat for as long as every read it performs continues to produce the same value.
+*/
+template <typename TimeT, typename AddressT> struct IdleLoop {
+	static constexpr int MaxReads = 8;
+
+	/// The duration of a single iteration of the loop.
+	TimeT length;
+
+	/// The addresses of every read performed by a single iteration of the loop, other than opcode fetches.
+	/// Depending on the processor this may include operand fetches and dummy reads.
+	AddressT reads[MaxReads];
+	int read_count = 0;
+
+	/// @returns The largest whole number of iterations of this loop that fits within @c time, expressed as a duration.
+	TimeT whole_iterations(TimeT time) const {
+		if(time < length) return TimeT(0);
+		return time - (time % length);
+	}
+};
+
+/*!
+	Provides the bookkeeping necessary for a processor to spot idle loops.
+
+	The processor should call @c instruction at each instruction boundary, supplying its current program counter,
+	a copy of every other piece of state that is relevant to the execution of future instructions, and its current
+	count of time remaining. It should report reads via @c did_read and writes, and any other bus activity that might
+	have side effects, via @c did_write.
+
+	@c RegistersT should be a cheap-to-copy type that implements @c operator==.
+*/
+template <typename RegistersT, typename TimeT, typename AddressT> class IdleLoopDetector {
+	public:
+		using Loop = IdleLoop<TimeT, AddressT>;
+
+		/// The longest loop that will be detected, in instructions.
+		static constexpr int MaxInstructions = 8;
+
+		/// Indicates that the processor's count of time remaining has increased by @c time, without any time passing.
+		void did_extend_time(TimeT time) {
+			start_ += time;
+		}
+
+		/// Records a read from @c address, other than an opcode fetch.
+		void did_read(AddressT address) {
+			if(read_count_ == Loop::MaxReads) {
+				is_tainted_ = true;
+				return;
+			}
+			reads_[read_count_] = address;
+			++read_count_;
+		}
+
+		/// Records a write, or any other bus activity that might have side effects.
+		void did_write() {
+			is_tainted_ = true;
+		}
+
+		/*!
+			Indicates that the processor is about to begin the instruction at @c pc.
+
+			@returns A description of the loop that has just been completed if the processor is now in
+				exactly the same state as it was a short while ago; @c nullptr otherwise.
+		*/
+		const Loop *instruction(AddressT pc, const RegistersT &registers, TimeT remaining) {
+			if(pc == pc_ && !is_tainted_ && registers == registers_) {
+				loop_.length = start_ - remaining;
+				loop_.read_count = read_count_;
+				for(int c = 0; c < read_count_; c++) {
+					loop_.reads[c] = reads_[c];
+				}
+
+				// Keep watching from here, in case the loop can't be skipped now but may be later.
+				begin(pc, registers, remaining);
+				return &loop_;
+			}
+
+			if(pc == pc_ || is_tainted_ || ++instructions_ == MaxInstructions) {
+				begin(pc, registers, remaining);
+			}
+			return nullptr;
+		}
+
+		/// Indicates that @c time has been skipped following a call to @c instruction, leaving the processor
+		/// otherwise in the state described by @c registers.
+		void did_skip(TimeT time, const RegistersT &registers) {
+			start_ -= time;
+			registers_ = registers;
+		}
+
+		/// @returns The state most recently supplied to @c instruction as the start of a potential loop.
+		const RegistersT &registers() const {
+			return registers_;
+		}
+
+	private:
+		AddressT pc_{};
+		RegistersT registers_{};
+		TimeT start_{};
+		int instructions_ = 0;
+		bool is_tainted_ = true;
+
+		AddressT reads_[Loop::MaxReads];
+		int read_count_ = 0;
+
+		Loop loop_;
+
+		void begin(AddressT pc, const RegistersT &registers, TimeT remaining) {
+			pc_ = pc;
+			registers_ = registers;
+			start_ = remaining;
+			instructions_ = 0;
+			read_count_ = 0;
+			is_tainted_ = false;
+		}
+};
+
+}
+
+#endif /* IdleLoopDetector_hpp */
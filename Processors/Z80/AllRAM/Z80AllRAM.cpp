@@ -26,6 +26,7 @@ class ConcreteAllRAMProcessor: public AllRAMProcessor, public BusHandler {
 			switch(cycle.operation) {
 				case PartialMachineCycle::ReadOpcode:
 					check_address_for_trap(address);
+					++opcode_fetches_;
 				case PartialMachineCycle::Read:
 					*cycle.value = memory_[address];
 				break;
@@ -18,6 +18,8 @@ template <	class T,
 			bool uses_bus_request,
 			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
 				::run_for(const HalfCycles cycles) {
+	Profiling::Scope<Processor> profiling_scope(cycles.as_integral());
+
 #define advance_operation() \
 	pc_increment_ = 1;	\
 	if(last_request_status_) {	\
@@ -36,14 +38,69 @@ template <	class T,
 		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
 	}
 
+	// Each micro-op is dispatched either through a switch statement or, where the compiler supports it,
+	// by direct threading: each micro-op's implementation ends by jumping straight to the next's via a
+	// table of label addresses, so that there's a separate and better-predicted branch per micro-op.
+	// Define Z80_SWITCH_DISPATCH to force the former.
+#if defined(__GNUC__) && !defined(Z80_SWITCH_DISPATCH)
+#define Z80_THREADED_DISPATCH
+#endif
+
+#ifdef Z80_THREADED_DISPATCH
+	// This table is in the same order as MicroOp::Type.
+	static const void *const micro_op_dispatch[] = {
+		&&micro_op_BusOperation, &&micro_op_IncrementR, &&micro_op_DecodeOperation, &&micro_op_MoveToNextProgram,
+		&&micro_op_Increment8NoFlags, &&micro_op_Increment8, &&micro_op_Increment16, &&micro_op_Decrement8,
+		&&micro_op_Decrement16, &&micro_op_Move8, &&micro_op_Move16, &&micro_op_IncrementPC,
+		&&micro_op_AssembleAF, &&micro_op_DisassembleAF, &&micro_op_And, &&micro_op_Or,
+		&&micro_op_Xor, &&micro_op_TestNZ, &&micro_op_TestZ, &&micro_op_TestNC,
+		&&micro_op_TestC, &&micro_op_TestPO, &&micro_op_TestPE, &&micro_op_TestP,
+		&&micro_op_TestM, &&micro_op_ADD16, &&micro_op_ADC16, &&micro_op_SBC16,
+		&&micro_op_CP8, &&micro_op_SUB8, &&micro_op_SBC8, &&micro_op_ADD8,
+		&&micro_op_ADC8, &&micro_op_NEG, &&micro_op_ExDEHL, &&micro_op_ExAFAFDash,
+		&&micro_op_EXX, &&micro_op_EI, &&micro_op_DI, &&micro_op_IM,
+		&&micro_op_LDI, &&micro_op_LDIR, &&micro_op_LDD, &&micro_op_LDDR,
+		&&micro_op_CPI, &&micro_op_CPIR, &&micro_op_CPD, &&micro_op_CPDR,
+		&&micro_op_INI, &&micro_op_INIR, &&micro_op_IND, &&micro_op_INDR,
+		&&micro_op_OUTI, &&micro_op_OUTD, &&micro_op_OUT_R, &&micro_op_RLA,
+		&&micro_op_RLCA, &&micro_op_RRA, &&micro_op_RRCA, &&micro_op_RLC,
+		&&micro_op_RRC, &&micro_op_RL, &&micro_op_RR, &&micro_op_SLA,
+		&&micro_op_SRA, &&micro_op_SLL, &&micro_op_SRL, &&micro_op_RLD,
+		&&micro_op_RRD, &&micro_op_SetInstructionPage, &&micro_op_CalculateIndexAddress, &&micro_op_BeginNMI,
+		&&micro_op_BeginIRQ, &&micro_op_BeginIRQMode0, &&micro_op_RETN, &&micro_op_JumpTo66,
+		&&micro_op_HALT, &&micro_op_DJNZ, &&micro_op_DAA, &&micro_op_CPL,
+		&&micro_op_SCF, &&micro_op_CCF, &&micro_op_RES, &&micro_op_BIT,
+		&&micro_op_SET, &&micro_op_CalculateRSTDestination, &&micro_op_SetAFlags, &&micro_op_SetInFlags,
+		&&micro_op_SetOutFlags, &&micro_op_SetZero, &&micro_op_IndexedPlaceHolder, &&micro_op_SetAddrAMemptr,
+		&&micro_op_Reset
+	};
+	static_assert(sizeof(micro_op_dispatch) / sizeof(*micro_op_dispatch) == MicroOp::Reset + 1);
+
+#define micro_op_case(x)	case MicroOp::x: micro_op_##x:
+#define next_micro_op()	\
+	operation = scheduled_program_counter_;	\
+	scheduled_program_counter_++;	\
+	goto *micro_op_dispatch[operation->type];
+#else
+#define micro_op_case(x)	case MicroOp::x:
+#define next_micro_op()	break
+#endif
+
 	number_of_cycles_ += cycles;
+	if constexpr (T::skips_idle_loops) {
+		idle_loop_detector_.did_extend_time(cycles);
+	}
 	if(!scheduled_program_counter_) {
 		advance_operation();
 	}
 
+	const MicroOp *operation;
 	while(1) {
 
 		do_bus_acknowledge:
+		if(uses_bus_request && bus_request_line_) {
+			flush_fast_time();
+		}
 		while(uses_bus_request && bus_request_line_) {
 			static PartialMachineCycle bus_acknowledge_cycle = {PartialMachineCycle::BusAcknowledge, HalfCycles(2), nullptr, nullptr, false};
 			number_of_cycles_ -= bus_handler_.perform_machine_cycle(bus_acknowledge_cycle) + HalfCycles(1);
@@ -53,7 +110,7 @@ template <	class T,
 		}
 
 		while(true) {
-			const MicroOp *const operation = scheduled_program_counter_;
+			operation = scheduled_program_counter_;
 			scheduled_program_counter_++;
 
 #define set_did_compute_flags()	\
@@ -65,10 +122,14 @@ template <	class T,
 	parity_overflow_result_ ^= parity_overflow_result_ << 2;\
 	parity_overflow_result_ ^= parity_overflow_result_ >> 1;
 
+#ifdef Z80_THREADED_DISPATCH
+			goto *micro_op_dispatch[operation->type];
+#endif
 			switch(operation->type) {
-				case MicroOp::BusOperation:
+				micro_op_case(BusOperation)
 					if(number_of_cycles_ < operation->machine_cycle.length) {
 						scheduled_program_counter_--;
+						flush_fast_time();
 						return;
 					}
 					if(uses_wait_line && operation->machine_cycle.was_requested) {
@@ -78,43 +139,71 @@ template <	class T,
 							continue;
 						}
 					}
+					if constexpr (T::skips_idle_loops) {
+						switch(operation->machine_cycle.operation) {
+							default: break;
+							case PartialMachineCycle::Read:
+								idle_loop_detector_.did_read(*operation->machine_cycle.address);
+							break;
+							case PartialMachineCycle::Write:
+							case PartialMachineCycle::Input:
+							case PartialMachineCycle::Output:
+							case PartialMachineCycle::Interrupt:
+								idle_loop_detector_.did_write();
+							break;
+						}
+					}
+					if(perform_fast_machine_cycle(operation->machine_cycle)) {
+						next_micro_op();
+					}
+					flush_fast_time();
+
 					number_of_cycles_ -= operation->machine_cycle.length;
 					last_request_status_ = request_status_;
 
 					// TODO: eliminate this conditional if all bus cycles have an address filled in.
 					last_address_bus_ = operation->machine_cycle.address ? *operation->machine_cycle.address : 0xdead;
 
-					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					{
+						const HalfCycles delay = bus_handler_.perform_machine_cycle(operation->machine_cycle);
+						number_of_cycles_ -= delay;
+						if(bus_trace_) trace(operation->machine_cycle, operation->machine_cycle.length + delay);
+					}
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
-				break;
-				case MicroOp::MoveToNextProgram:
+				next_micro_op();
+				micro_op_case(MoveToNextProgram)
 					advance_operation();
-				break;
-				case MicroOp::IncrementR:
+					if constexpr (T::skips_idle_loops) {
+						if(scheduled_program_counter_ == base_page_.fetch_decode_execute_data) {
+							consider_idle_loop();
+						}
+					}
+				next_micro_op();
+				micro_op_case(IncrementR)
 					refresh_addr_ = ir_;
 					ir_.halves.low = (ir_.halves.low & 0x80) | ((ir_.halves.low + 1) & 0x7f);
-				break;
-				case MicroOp::DecodeOperation:
+				next_micro_op();
+				micro_op_case(DecodeOperation)
 					pc_.full += pc_increment_ & uint16_t(halt_mask_);
 					scheduled_program_counter_ = current_instruction_page_->instructions[operation_ & halt_mask_];
 					flag_adjustment_history_ <<= 1;
-				break;
+				next_micro_op();
 
-				case MicroOp::Increment8NoFlags:	++ *static_cast<uint8_t *>(operation->source);			break;
-				case MicroOp::Increment16:			++ *static_cast<uint16_t *>(operation->source);			break;
-				case MicroOp::IncrementPC:			pc_.full += pc_increment_;								break;
-				case MicroOp::Decrement16:			-- *static_cast<uint16_t *>(operation->source);			break;
-				case MicroOp::Move8:				*static_cast<uint8_t *>(operation->destination) = *static_cast<uint8_t *>(operation->source);		break;
-				case MicroOp::Move16:				*static_cast<uint16_t *>(operation->destination) = *static_cast<uint16_t *>(operation->source);		break;
+				micro_op_case(Increment8NoFlags)	++ *static_cast<uint8_t *>(operation->source);			next_micro_op();
+				micro_op_case(Increment16)			++ *static_cast<uint16_t *>(operation->source);			next_micro_op();
+				micro_op_case(IncrementPC)			pc_.full += pc_increment_;								next_micro_op();
+				micro_op_case(Decrement16)			-- *static_cast<uint16_t *>(operation->source);			next_micro_op();
+				micro_op_case(Move8)				*static_cast<uint8_t *>(operation->destination) = *static_cast<uint8_t *>(operation->source);		next_micro_op();
+				micro_op_case(Move16)				*static_cast<uint16_t *>(operation->destination) = *static_cast<uint16_t *>(operation->source);		next_micro_op();
 
-				case MicroOp::AssembleAF:
+				micro_op_case(AssembleAF)
 					temp16_.halves.high = a_;
 					temp16_.halves.low = get_flags();
-				break;
-				case MicroOp::DisassembleAF:
+				next_micro_op();
+				micro_op_case(DisassembleAF)
 					a_ = temp16_.halves.high;
 					set_flags(temp16_.halves.low);
-				break;
+				next_micro_op();
 
 // MARK: - Logical
 
@@ -126,32 +215,32 @@ template <	class T,
 	carry_result_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::And:
+				micro_op_case(And)
 					a_ &= *static_cast<uint8_t *>(operation->source);
 					set_logical_flags(Flag::HalfCarry);
-				break;
+				next_micro_op();
 
-				case MicroOp::Or:
+				micro_op_case(Or)
 					a_ |= *static_cast<uint8_t *>(operation->source);
 					set_logical_flags(0);
-				break;
+				next_micro_op();
 
-				case MicroOp::Xor:
+				micro_op_case(Xor)
 					a_ ^= *static_cast<uint8_t *>(operation->source);
 					set_logical_flags(0);
-				break;
+				next_micro_op();
 
 #undef set_logical_flags
 
-				case MicroOp::CPL:
+				micro_op_case(CPL)
 					a_ ^= 0xff;
 					subtract_flag_ = Flag::Subtract;
 					half_carry_result_ = Flag::HalfCarry;
 					bit53_result_ = a_;
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::CCF:
+				micro_op_case(CCF)
 					half_carry_result_ = uint8_t(carry_result_ << 4);
 					carry_result_ ^= Flag::Carry;
 					subtract_flag_ = 0;
@@ -161,9 +250,9 @@ template <	class T,
 						bit53_result_ |= a_;
 					}
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SCF:
+				micro_op_case(SCF)
 					carry_result_ = Flag::Carry;
 					half_carry_result_ = 0;
 					subtract_flag_ = 0;
@@ -173,20 +262,20 @@ template <	class T,
 						bit53_result_ |= a_;
 					}
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
 // MARK: - Flow control
 
-				case MicroOp::DJNZ:
+				micro_op_case(DJNZ)
 					bc_.halves.high--;
 					if(!bc_.halves.high) {
 						advance_operation();
 					}
-				break;
+				next_micro_op();
 
-				case MicroOp::CalculateRSTDestination:
+				micro_op_case(CalculateRSTDestination)
 					memptr_.full = operation_ & 0x38;
-				break;
+				next_micro_op();
 
 // MARK: - 8-bit arithmetic
 
@@ -199,7 +288,7 @@ template <	class T,
 	bit53_result_ = uint8_t(b53);	\
 	set_did_compute_flags();
 
-				case MicroOp::CP8: {
+				micro_op_case(CP8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
@@ -210,9 +299,9 @@ template <	class T,
 
 					// the 5 and 3 flags come from the operand, atypically
 					set_arithmetic_flags(Flag::Subtract, value);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SUB8: {
+				micro_op_case(SUB8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
@@ -223,9 +312,9 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(Flag::Subtract, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SBC8: {
+				micro_op_case(SBC8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = a_ - value - (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) - (value&0xf) - (carry_result_ & Flag::Carry);
@@ -236,9 +325,9 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(Flag::Subtract, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADD8: {
+				micro_op_case(ADD8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = a_ + value;
 					const int half_result = (a_&0xf) + (value&0xf);
@@ -249,9 +338,9 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(0, result);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADC8: {
+				micro_op_case(ADC8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = a_ + value + (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) + (value&0xf) + (carry_result_ & Flag::Carry);
@@ -262,11 +351,11 @@ template <	class T,
 
 					a_ = uint8_t(result);
 					set_arithmetic_flags(0, result);
-				} break;
+				} next_micro_op();
 
 #undef set_arithmetic_flags
 
-				case MicroOp::NEG: {
+				micro_op_case(NEG) {
 					const int overflow = (a_ == 0x80);
 					const int result = -a_;
 					const int halfResult = -(a_&0xf);
@@ -278,9 +367,9 @@ template <	class T,
 					carry_result_ = uint8_t(result >> 8);
 					half_carry_result_ = uint8_t(halfResult);
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::Increment8: {
+				micro_op_case(Increment8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = value + 1;
 
@@ -297,9 +386,9 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 5);
 					subtract_flag_ = 0;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::Decrement8: {
+				micro_op_case(Decrement8) {
 					const uint8_t value = *static_cast<uint8_t *>(operation->source);
 					const int result = value - 1;
 
@@ -316,9 +405,9 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 5);
 					subtract_flag_ = Flag::Subtract;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::DAA: {
+				micro_op_case(DAA) {
 					const int lowNibble = a_ & 0xf;
 					const int highNibble = a_ >> 4;
 					int amountToAdd = 0;
@@ -359,11 +448,11 @@ template <	class T,
 
 					set_parity(a_);
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
 // MARK: - 16-bit arithmetic
 
-				case MicroOp::ADD16: {
+				micro_op_case(ADD16) {
 					memptr_.full = *static_cast<uint16_t *>(operation->destination);
 					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
@@ -378,9 +467,9 @@ template <	class T,
 
 					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ADC16: {
+				micro_op_case(ADC16) {
 					memptr_.full = *static_cast<uint16_t *>(operation->destination);
 					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
@@ -400,9 +489,9 @@ template <	class T,
 
 					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SBC16: {
+				micro_op_case(SBC16) {
 					memptr_.full = *static_cast<uint16_t *>(operation->destination);
 					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
@@ -425,7 +514,7 @@ template <	class T,
 
 					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
 					memptr_.full++;
-				} break;
+				} next_micro_op();
 
 // MARK: - Conditionals
 
@@ -436,14 +525,14 @@ template <	class T,
 		advance_operation();	\
 	}
 
-				case MicroOp::TestNZ:	if(!zero_result_)								{ decline_conditional(); }		break;
-				case MicroOp::TestZ:	if(zero_result_)								{ decline_conditional(); }		break;
-				case MicroOp::TestNC:	if(carry_result_ & Flag::Carry)					{ decline_conditional(); }		break;
-				case MicroOp::TestC:	if(!(carry_result_ & Flag::Carry))				{ decline_conditional(); }		break;
-				case MicroOp::TestPO:	if(parity_overflow_result_ & Flag::Parity)		{ decline_conditional(); }		break;
-				case MicroOp::TestPE:	if(!(parity_overflow_result_ & Flag::Parity))	{ decline_conditional(); }		break;
-				case MicroOp::TestP:	if(sign_result_ & Flag::Sign)					{ decline_conditional(); }		break;
-				case MicroOp::TestM:	if(!(sign_result_ & Flag::Sign))				{ decline_conditional(); }		break;
+				micro_op_case(TestNZ)	if(!zero_result_)								{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestZ)	if(zero_result_)								{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestNC)	if(carry_result_ & Flag::Carry)					{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestC)	if(!(carry_result_ & Flag::Carry))				{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestPO)	if(parity_overflow_result_ & Flag::Parity)		{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestPE)	if(!(parity_overflow_result_ & Flag::Parity))	{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestP)	if(sign_result_ & Flag::Sign)					{ decline_conditional(); }		next_micro_op();
+				micro_op_case(TestM)	if(!(sign_result_ & Flag::Sign))				{ decline_conditional(); }		next_micro_op();
 
 #undef decline_conditional
 
@@ -451,26 +540,26 @@ template <	class T,
 
 #define swap(a, b)	temp = a.full; a.full = b.full; b.full = temp;
 
-				case MicroOp::ExDEHL: {
+				micro_op_case(ExDEHL) {
 					uint16_t temp;
 					swap(de_, hl_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::ExAFAFDash: {
+				micro_op_case(ExAFAFDash) {
 					const uint8_t a = a_;
 					const uint8_t f = get_flags();
 					set_flags(af_dash_.halves.low);
 					a_ = af_dash_.halves.high;
 					af_dash_.halves.high = a;
 					af_dash_.halves.low = f;
-				} break;
+				} next_micro_op();
 
-				case MicroOp::EXX: {
+				micro_op_case(EXX) {
 					uint16_t temp;
 					swap(de_, de_dash_);
 					swap(bc_, bc_dash_);
 					swap(hl_, hl_dash_);
-				} break;
+				} next_micro_op();
 
 #undef swap
 
@@ -495,23 +584,23 @@ template <	class T,
 	parity_overflow_result_ = bc_.full ? Flag::Parity : 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::LDDR: {
+				micro_op_case(LDDR) {
 					LDxR_STEP(-1);
 					REPEAT(bc_.full);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDIR: {
+				micro_op_case(LDIR) {
 					LDxR_STEP(1);
 					REPEAT(bc_.full);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDD: {
+				micro_op_case(LDD) {
 					LDxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::LDI: {
+				micro_op_case(LDI) {
 					LDxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef LDxR_STEP
 
@@ -532,23 +621,23 @@ template <	class T,
 	bit53_result_ = uint8_t((result&0x8) | ((result&0x2) << 4));	\
 	set_did_compute_flags();
 
-				case MicroOp::CPDR: {
+				micro_op_case(CPDR) {
 					CPxR_STEP(-1);
 					REPEAT(bc_.full && sign_result_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPIR: {
+				micro_op_case(CPIR) {
 					CPxR_STEP(1);
 					REPEAT(bc_.full && sign_result_);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPD: {
+				micro_op_case(CPD) {
 					CPxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::CPI: {
+				micro_op_case(CPI) {
 					CPxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef CPxR_STEP
 
@@ -583,23 +672,23 @@ template <	class T,
 	set_parity(summation);	\
 	set_did_compute_flags();
 
-				case MicroOp::INDR: {
+				micro_op_case(INDR) {
 					INxR_STEP(-1);
 					REPEAT(bc_.halves.high);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::INIR: {
+				micro_op_case(INIR) {
 					INxR_STEP(1);
 					REPEAT(bc_.halves.high);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::IND: {
+				micro_op_case(IND) {
 					INxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::INI: {
+				micro_op_case(INI) {
 					INxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef INxR_STEP
 
@@ -623,23 +712,23 @@ template <	class T,
 	set_parity(summation);	\
 	set_did_compute_flags();
 
-				case MicroOp::OUT_R:
+				micro_op_case(OUT_R)
 					REPEAT(bc_.halves.high);
-				break;
+				next_micro_op();
 
-				case MicroOp::OUTD: {
+				micro_op_case(OUTD) {
 					OUTxR_STEP(-1);
-				} break;
+				} next_micro_op();
 
-				case MicroOp::OUTI: {
+				micro_op_case(OUTI) {
 					OUTxR_STEP(1);
-				} break;
+				} next_micro_op();
 
 #undef OUTxR_STEP
 
 // MARK: - Bit Manipulation
 
-				case MicroOp::BIT: {
+				micro_op_case(BIT) {
 					const uint8_t result = *static_cast<uint8_t *>(operation->source) & (1 << ((operation_ >> 3)&7));
 
 					// Leak MEMPTR into bits 5 and 3 if this is either BIT n,(HL) or BIT n,(IX/IY+d).
@@ -654,15 +743,15 @@ template <	class T,
 					subtract_flag_ = 0;
 					parity_overflow_result_ = result ? 0 : Flag::Parity;
 					set_did_compute_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RES:
+				micro_op_case(RES)
 					*static_cast<uint8_t *>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
-				break;
+				next_micro_op();
 
-				case MicroOp::SET:
+				micro_op_case(SET)
 					*static_cast<uint8_t *>(operation->source) |= (1 << ((operation_ >> 3)&7));
-				break;
+				next_micro_op();
 
 // MARK: - Rotation and shifting
 
@@ -672,29 +761,29 @@ template <	class T,
 	subtract_flag_ = half_carry_result_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::RLA: {
+				micro_op_case(RLA) {
 					const uint8_t new_carry = a_ >> 7;
 					a_ = uint8_t((a_ << 1) | (carry_result_ & Flag::Carry));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RRA: {
+				micro_op_case(RRA) {
 					const uint8_t new_carry = a_ & 1;
 					a_ = uint8_t((a_ >> 1) | (carry_result_ << 7));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RLCA: {
+				micro_op_case(RLCA) {
 					const uint8_t new_carry = a_ >> 7;
 					a_ = uint8_t((a_ << 1) | new_carry);
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RRCA: {
+				micro_op_case(RRCA) {
 					const uint8_t new_carry = a_ & 1;
 					a_ = uint8_t((a_ >> 1) | (new_carry << 7));
 					set_rotate_flags();
-				} break;
+				} next_micro_op();
 
 #undef set_rotate_flags
 
@@ -705,55 +794,55 @@ template <	class T,
 	subtract_flag_ = 0;	\
 	set_did_compute_flags();
 
-				case MicroOp::RLC:
+				micro_op_case(RLC)
 					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | carry_result_);
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::RRC:
+				micro_op_case(RRC)
 					carry_result_ = *static_cast<uint8_t *>(operation->source);
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::RL: {
+				micro_op_case(RL) {
 					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source) >> 7;
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | (carry_result_ & Flag::Carry));
 					carry_result_ = next_carry;
 					set_shift_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RR: {
+				micro_op_case(RR) {
 					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source);
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
 					carry_result_ = next_carry;
 					set_shift_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::SLA:
+				micro_op_case(SLA)
 					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
 					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1);
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SRA:
+				micro_op_case(SRA)
 					carry_result_ = *static_cast<uint8_t *>(operation->source);
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (*static_cast<uint8_t *>(operation->source) & 0x80));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SLL:
+				micro_op_case(SLL)
 					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
 					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1) | 1;
 					set_shift_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SRL:
+				micro_op_case(SRL)
 					carry_result_ = *static_cast<uint8_t *>(operation->source);
 					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1));
 					set_shift_flags();
-				break;
+				next_micro_op();
 
 #undef set_shift_flags
 
@@ -764,105 +853,105 @@ template <	class T,
 	bit53_result_ = zero_result_ = sign_result_ = a_;	\
 	set_did_compute_flags();
 
-				case MicroOp::RRD: {
+				micro_op_case(RRD) {
 					memptr_.full = hl_.full + 1;
 					const uint8_t low_nibble = a_ & 0xf;
 					a_ = (a_ & 0xf0) | (temp8_ & 0xf);
 					temp8_ = uint8_t((temp8_ >> 4) | (low_nibble << 4));
 					set_decimal_rotate_flags();
-				} break;
+				} next_micro_op();
 
-				case MicroOp::RLD: {
+				micro_op_case(RLD) {
 					memptr_.full = hl_.full + 1;
 					const uint8_t low_nibble = a_ & 0xf;
 					a_ = (a_ & 0xf0) | (temp8_ >> 4);
 					temp8_ = uint8_t((temp8_ << 4) | low_nibble);
 					set_decimal_rotate_flags();
-				} break;
+				} next_micro_op();
 
 #undef set_decimal_rotate_flags
 
 
 // MARK: - Interrupt state
 
-				case MicroOp::EI:
+				micro_op_case(EI)
 					iff1_ = iff2_ = true;
 					if(irq_line_) request_status_ |= Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::DI:
+				micro_op_case(DI)
 					iff1_ = iff2_ = false;
 					request_status_ &= ~Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::IM:
+				micro_op_case(IM)
 					switch(operation_ & 0x18) {
 						case 0x00:	interrupt_mode_ = 0;	break;
 						case 0x08:	interrupt_mode_ = 0;	break;	// IM 0/1
 						case 0x10:	interrupt_mode_ = 1;	break;
 						case 0x18:	interrupt_mode_ = 2;	break;
 					}
-				break;
+				next_micro_op();
 
 // MARK: - Input and Output
 
-				case MicroOp::SetInFlags:
+				micro_op_case(SetInFlags)
 					subtract_flag_ = half_carry_result_ = 0;
 					sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);
 					set_parity(sign_result_);
 					set_did_compute_flags();
 					++memptr_.full;
-				break;
+				next_micro_op();
 
-				case MicroOp::SetOutFlags:
+				micro_op_case(SetOutFlags)
 					memptr_.full = bc_.full + 1;
-				break;
+				next_micro_op();
 
-				case MicroOp::SetAFlags:
+				micro_op_case(SetAFlags)
 					subtract_flag_ = half_carry_result_ = 0;
 					parity_overflow_result_ = iff2_ ? Flag::Parity : 0;
 					sign_result_ = zero_result_ = bit53_result_ = a_;
 					set_did_compute_flags();
-				break;
+				next_micro_op();
 
-				case MicroOp::SetZero:
+				micro_op_case(SetZero)
 					temp8_ = 0;
-				break;
+				next_micro_op();
 
 // MARK: - Special-case Flow
 
-				case MicroOp::BeginIRQMode0:
+				micro_op_case(BeginIRQMode0)
 					pc_increment_ = 0;
 					[[fallthrough]];
-				case MicroOp::BeginIRQ:
+				micro_op_case(BeginIRQ)
 					iff2_ = iff1_ = false;
 					request_status_ &= ~Interrupt::IRQ;
 					temp16_.full = 0x38;
-				break;
+				next_micro_op();
 
-				case MicroOp::BeginNMI:
+				micro_op_case(BeginNMI)
 					iff2_ = iff1_;
 					iff1_ = false;
 					request_status_ &= ~Interrupt::IRQ;
-				break;
+				next_micro_op();
 
-				case MicroOp::JumpTo66:
+				micro_op_case(JumpTo66)
 					pc_.full = 0x66;
-				break;
+				next_micro_op();
 
-				case MicroOp::RETN:
+				micro_op_case(RETN)
 					iff1_ = iff2_;
 					if(irq_line_ && iff1_) request_status_ |= Interrupt::IRQ;
 					memptr_ = pc_;
-				break;
+				next_micro_op();
 
-				case MicroOp::HALT:
+				micro_op_case(HALT)
 					halt_mask_ = 0x00;
-				break;
+				next_micro_op();
 
 // MARK: - Interrupt handling
 
-				case MicroOp::Reset:
+				micro_op_case(Reset)
 					iff1_ = iff2_ = false;
 					interrupt_mode_ = 0;
 					pc_.full = 0;
@@ -870,30 +959,139 @@ template <	class T,
 					a_ = 0xff;
 					set_flags(0xff);
 					ir_.full = 0;
-				break;
+				next_micro_op();
 
 // MARK: - Internal bookkeeping
 
-				case MicroOp::SetInstructionPage:
+				micro_op_case(SetInstructionPage)
 					current_instruction_page_ = (InstructionPage *)operation->source;
 					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute_data;
-				break;
+				next_micro_op();
 
-				case MicroOp::CalculateIndexAddress:
+				micro_op_case(CalculateIndexAddress)
 					memptr_.full = uint16_t(*static_cast<uint16_t *>(operation->source) + int8_t(temp8_));
-				break;
+				next_micro_op();
 
-				case MicroOp::SetAddrAMemptr:
+				micro_op_case(SetAddrAMemptr)
 					memptr_.full = uint16_t(((*static_cast<uint16_t *>(operation->source) + 1)&0xff) + (a_ << 8));
-				break;
+				next_micro_op();
 
-				case MicroOp::IndexedPlaceHolder:
+				micro_op_case(IndexedPlaceHolder)
 				return;
 			}
 #undef set_parity
 		}
 
 	}
+
+#undef micro_op_case
+#undef next_micro_op
+#undef Z80_THREADED_DISPATCH
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> forceinline bool Processor <T, uses_bus_request, uses_wait_line>
+				::perform_fast_machine_cycle(const PartialMachineCycle &cycle) {
+	if constexpr (T::has_fast_memory) {
+		FastMemory &memory = bus_handler_.fast_memory();
+		HalfCycles length = cycle.length;
+
+		switch(cycle.operation) {
+			case PartialMachineCycle::ReadOpcode:
+				length += memory.opcode_fetch_delay;
+				[[fallthrough]];
+			case PartialMachineCycle::Read: {
+				const uint8_t *const page = memory.read[*cycle.address >> FastMemory::PageShift];
+				if(!page || fast_time_ + length >= memory.time_available) return false;
+				*cycle.value = page[*cycle.address & FastMemory::PageMask];
+			} break;
+
+			case PartialMachineCycle::Write: {
+				uint8_t *const page = memory.write[*cycle.address >> FastMemory::PageShift];
+				if(!page || fast_time_ + length >= memory.time_available) return false;
+				page[*cycle.address & FastMemory::PageMask] = *cycle.value;
+			} break;
+
+			case PartialMachineCycle::Input:
+			case PartialMachineCycle::Output:
+			case PartialMachineCycle::Interrupt:
+			case PartialMachineCycle::BusAcknowledge:
+			case PartialMachineCycle::InputWait:
+			case PartialMachineCycle::OutputWait:
+			case PartialMachineCycle::InterruptWait:
+			case PartialMachineCycle::InputStart:
+			case PartialMachineCycle::OutputStart:
+			case PartialMachineCycle::InterruptStart:
+			return false;
+
+			default:
+				if(fast_time_ + length >= memory.time_available) return false;
+			break;
+		}
+
+		fast_time_ += length;
+		number_of_cycles_ -= length;
+		last_request_status_ = request_status_;
+		last_address_bus_ = cycle.address ? *cycle.address : 0xdead;
+		if(bus_trace_) trace(cycle, length);
+		return true;
+	} else {
+		(void)cycle;
+		return false;
+	}
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> forceinline void Processor <T, uses_bus_request, uses_wait_line>
+				::flush_fast_time() {
+	if constexpr (T::has_fast_memory) {
+		if(fast_time_ > HalfCycles(0)) {
+			bus_handler_.advance_time(fast_time_);
+			fast_time_ = HalfCycles(0);
+		}
+	}
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> typename Processor <T, uses_bus_request, uses_wait_line>::IdleLoopRegisters Processor <T, uses_bus_request, uses_wait_line>
+				::idle_loop_registers() const {
+	return IdleLoopRegisters{
+		{
+			uint16_t((a_ << 8) | get_flags()), bc_.full, de_.full, hl_.full,
+			af_dash_.full, bc_dash_.full, de_dash_.full, hl_dash_.full,
+			ix_.full, iy_.full, sp_.full, memptr_.full,
+			ir_.halves.high,
+			uint16_t(
+				(iff1_ ? 0x01 : 0x00) | (iff2_ ? 0x02 : 0x00) | (interrupt_mode_ << 2) |
+				((flag_adjustment_history_ & 1) << 4) | (halt_mask_ << 8)
+			)
+		},
+		ir_.halves.low
+	};
+}
+
+template <	class T,
+			bool uses_bus_request,
+			bool uses_wait_line> void Processor <T, uses_bus_request, uses_wait_line>
+				::consider_idle_loop() {
+	const uint8_t previous_r = idle_loop_detector_.registers().r;
+	const IdleLoop *const loop = idle_loop_detector_.instruction(pc_.full, idle_loop_registers(), number_of_cycles_);
+	if(!loop) return;
+
+	flush_fast_time();
+	const HalfCycles skipped = bus_handler_.skip_idle_loop(*loop, number_of_cycles_);
+	if(skipped <= HalfCycles(0)) return;
+
+	// Every iteration will have incremented R by the same amount.
+	const auto iterations = skipped.as_integral() / loop->length.as_integral();
+	const auto increment = (ir_.halves.low - previous_r) & 0x7f;
+	ir_.halves.low = uint8_t((ir_.halves.low & 0x80) | ((ir_.halves.low + increment * iterations) & 0x7f));
+
+	number_of_cycles_ -= skipped;
+	idle_loop_detector_.did_skip(skipped, idle_loop_registers());
 }
 
 template <	class T,
@@ -101,7 +101,7 @@ State::State(const ProcessorBase &src): State() {
 #undef ContainedBy
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.a_ = registers.a;
 	target.set_flags(registers.flags);
@@ -9,13 +9,17 @@
 #ifndef Z80_hpp
 #define Z80_hpp
 
+#include <array>
 #include <cassert>
 #include <vector>
 #include <cstdint>
 
+#include "../BusTrace.hpp"
+#include "../IdleLoopDetector.hpp"
 #include "../../Numeric/RegisterSizes.hpp"
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
+#include "../../ClockReceiver/Profiler.hpp"
 
 namespace CPU {
 namespace Z80 {
@@ -381,6 +385,9 @@ struct PartialMachineCycle {
 	PartialMachineCycle() noexcept;
 };
 
+/// Describes an idle loop, as offered to bus handlers that set @c skips_idle_loops.
+using IdleLoop = CPU::IdleLoop<HalfCycles, uint16_t>;
+
 /*!
 	A class providing empty implementations of the methods a Z80 uses to access the bus. To wire the Z80 to a bus,
 	machines should subclass BusHandler and then declare a realisation of the Z80 template, supplying their bus
@@ -399,6 +406,58 @@ class BusHandler {
 		HalfCycles perform_machine_cycle([[maybe_unused]] const PartialMachineCycle &cycle) {
 			return HalfCycles(0);
 		}
+
+		/*!
+			Bus handlers may set this to @c true to declare that, within the pages nominated by @c fast_memory(),
+			reads and writes are plain accesses to RAM or ROM with fixed wait states, and that no partial machine
+			cycle other than input, output, interrupt acknowledge or bus acknowledge has any effect beyond
+			the passage of time.
+
+			The Z80 will then perform such accesses and cycles itself, without calling @c perform_machine_cycle,
+			for up to @c FastMemory::time_available at a time. The total time spent in that way is passed to
+			@c advance_time before the next call to @c perform_machine_cycle and before @c run_for returns.
+
+			Bus handlers that do so should implement:
+
+				FastMemory &fast_memory();
+				void advance_time(HalfCycles);
+		*/
+		static constexpr bool has_fast_memory = false;
+
+		/*!
+			Bus handlers may set this to @c true to be offered the chance to skip idle loops, such as a HALT or
+			a short loop polling a device, via:
+
+				HalfCycles skip_idle_loop(const IdleLoop &loop, HalfCycles limit);
+
+			The Z80 will call that upon completing any iteration of a loop that performed no writes, input, output
+			or interrupt acknowledgement, and that left all registers other than R as they were. The bus handler
+			should then advance time by a whole number of iterations of @c loop, not exceeding @c limit, during
+			which it is certain that every address in @c loop.reads would have produced the same value as during
+			the iteration just completed, and no interrupt would have been signalled. It should return the
+			amount of time so advanced, or zero to decline.
+		*/
+		static constexpr bool skips_idle_loops = false;
+};
+
+/*!
+	Describes the memory that a bus handler with @c has_fast_memory allows the Z80 to access directly.
+*/
+struct FastMemory {
+	static constexpr int PageShift = 10;
+	static constexpr uint16_t PageMask = (1 << PageShift) - 1;
+
+	/// Pointers to each 1kb page of memory for reading and for writing; @c nullptr indicates
+	/// that accesses to that page must be passed to @c perform_machine_cycle.
+	const uint8_t *read[65536 >> PageShift]{};
+	uint8_t *write[65536 >> PageShift]{};
+
+	/// The number of additional half cycles to add to every opcode fetch, being a fixed number of wait states.
+	HalfCycles opcode_fetch_delay;
+
+	/// The amount of time that may be spent without calling @c perform_machine_cycle or @c advance_time,
+	/// as at the end of the most recent such call.
+	HalfCycles time_available;
 };
 
 #include "Implementation/Z80Storage.hpp"
@@ -483,6 +542,25 @@ class ProcessorBase: public ProcessorStorage {
 			This is not a speedy operation.
 		*/
 		bool is_starting_new_instruction() const;
+
+		/*!
+			Nominates @c trace to receive a record of every subsequent machine cycle, or ends tracing
+			if @c trace is @c nullptr.
+		*/
+		void set_bus_trace(CPU::BusTrace *trace) {
+			bus_trace_ = trace;
+		}
+
+	protected:
+		CPU::BusTrace *bus_trace_ = nullptr;
+		void trace(const PartialMachineCycle &cycle, HalfCycles length) {
+			bus_trace_->record(
+				cycle.operation,
+				cycle.address ? *cycle.address : 0,
+				cycle.value ? *cycle.value : 0,
+				length.as<int>()
+			);
+		}
 };
 
 /*!
@@ -533,6 +611,26 @@ template <class T, bool uses_bus_request, bool uses_wait_line> class Processor:
 
 		void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets);
 		void copy_program(const MicroOp *source, std::vector<MicroOp> &destination);
+
+		// Time spent performing bus cycles directly, per the bus handler's FastMemory,
+		// that hasn't yet been reported to the bus handler.
+		HalfCycles fast_time_;
+		bool perform_fast_machine_cycle(const PartialMachineCycle &cycle);
+		void flush_fast_time();
+
+		// Idle-loop detection, per the bus handler's skips_idle_loops. R is carried but not compared,
+		// as it'll increment in every iteration of a loop.
+		struct IdleLoopRegisters {
+			std::array<uint16_t, 14> registers;
+			uint8_t r;
+
+			bool operator ==(const IdleLoopRegisters &rhs) const {
+				return registers == rhs.registers;
+			}
+		};
+		CPU::IdleLoopDetector<IdleLoopRegisters, HalfCycles, uint16_t> idle_loop_detector_;
+		IdleLoopRegisters idle_loop_registers() const;
+		void consider_idle_loop();
 };
 
 #include "Implementation/Z80Implementation.hpp"
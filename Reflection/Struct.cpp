@@ -9,15 +9,27 @@
 #include "Struct.hpp"
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <iomanip>
 #include <iterator>
 #include <sstream>
 #include <type_traits>
 
+// MARK: - Keys
+
+std::vector<std::string> Reflection::Struct::all_keys() const {
+	std::vector<std::string> keys;
+	keys.reserve(key_count());
+	for(size_t c = 0; c < key_count(); c++) {
+		keys.emplace_back(key(c));
+	}
+	return keys;
+}
+
 // MARK: - Setters
 
-template <> bool Reflection::set(Struct &target, const std::string &name, float value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, float value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -29,7 +41,7 @@ template <> bool Reflection::set(Struct &target, const std::string &name, float
 	return set<double>(target, name, value);
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, double value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, double value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -47,11 +59,11 @@ template <> bool Reflection::set(Struct &target, const std::string &name, double
 	return false;
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, int value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, int value, size_t offset) {
 	return set<int64_t>(target, name, value, offset);
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, int64_t value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, int64_t value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -75,7 +87,7 @@ template <> bool Reflection::set(Struct &target, const std::string &name, int64_
 	return false;
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, const std::string &value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, const std::string &value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -100,12 +112,12 @@ template <> bool Reflection::set(Struct &target, const std::string &name, const
 	return true;
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, const char *value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, const char *value, size_t offset) {
 	const std::string string(value);
 	return set<const std::string &>(target, name, string, offset);
 }
 
-template <> bool Reflection::set(Struct &target, const std::string &name, bool value, size_t offset) {
+template <> bool Reflection::set(Struct &target, std::string_view name, bool value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -118,7 +130,7 @@ template <> bool Reflection::set(Struct &target, const std::string &name, bool v
 
 // MARK: - Fuzzy setter
 
-bool Reflection::fuzzy_set(Struct &target, const std::string &name, const std::string &value) {
+bool Reflection::fuzzy_set(Struct &target, std::string_view name, const std::string &value) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -159,7 +171,7 @@ bool Reflection::fuzzy_set(Struct &target, const std::string &name, const std::s
 
 // MARK: - Description
 
-void Reflection::Struct::append(std::ostringstream &stream, const std::string &key, const std::type_info *const type, size_t offset) const {
+void Reflection::Struct::append(std::ostringstream &stream, std::string_view key, const std::type_info *const type, size_t offset) const {
 	// Output Bools as yes/no.
 	if(*type == typeid(bool)) {
 		stream << ::Reflection::get<bool>(*this, key, offset);
@@ -209,7 +221,8 @@ std::string Reflection::Struct::description() const {
 	stream << "{";
 
 	bool is_first = true;
-	for(const auto &key: all_keys()) {
+	for(size_t c = 0; c < key_count(); c++) {
+		const auto key = this->key(c);
 		if(!is_first) stream << ", ";
 		is_first = false;
 
@@ -239,12 +252,12 @@ std::string Reflection::Struct::description() const {
 
 /* Contractually, this serialises as BSON. */
 std::vector<uint8_t> Reflection::Struct::serialise() const {
-	auto push_name = [] (std::vector<uint8_t> &result, const std::string &name) {
+	auto push_name = [] (std::vector<uint8_t> &result, std::string_view name) {
 		std::copy(name.begin(), name.end(), std::back_inserter(result));
 		result.push_back(0);
 	};
 
-	auto append = [push_name, this] (std::vector<uint8_t> &result, const std::string &key, const std::string &output_name, const std::type_info *type, size_t offset) {
+	auto append = [push_name, this] (std::vector<uint8_t> &result, std::string_view key, std::string_view output_name, const std::type_info *type, size_t offset) {
 		auto push_int = [&result] (auto x) {
 			for(size_t c = 0; c < sizeof(x); ++c)
 				result.push_back(uint8_t((x) >> (8 * c)));
@@ -278,7 +291,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(!Reflection::Enum::name(*type).empty()) {
 			int value;
 			Reflection::get(*this, key, value, offset);
-			const auto text = Reflection::Enum::to_string(*type, 0);
+			const auto text = Reflection::Enum::to_string(*type, value);
 			push_string(text);
 			return;
 		}
@@ -373,7 +386,8 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 
 	std::vector<uint8_t> result;
 
-	for(const auto &key: all_keys()) {
+	for(size_t index = 0; index < key_count(); index++) {
+		const auto key = this->key(index);
 		if(!should_serialise(key)) continue;
 
 		/* Here:	e_list	::=	element e_list | ""		*/
@@ -412,145 +426,172 @@ namespace {
 	an offset based on the propety name specified here.
 */
 struct ArrayReceiver: public Reflection::Struct {
-	ArrayReceiver(Reflection::Struct *target, const std::type_info *type, const std::string &key, size_t count) :
+	ArrayReceiver(Reflection::Struct *target, const std::type_info *type, std::string_view key, size_t count) :
 		target_(target), type_(type), key_(key), count_(count) {}
 
-	std::vector<std::string> all_keys() const final { return {}; }
-	const std::type_info *type_of(const std::string &) const final { return type_; }
-	size_t count_of(const std::string &) const final { return 0; }
+	size_t key_count() const final { return 0; }
+	std::string_view key(size_t) const final { return {}; }
+	const std::type_info *type_of(std::string_view) const final { return type_; }
+	size_t count_of(std::string_view) const final { return 0; }
 
-	void set(const std::string &name, const void *value, size_t) final {
-		const auto index = size_t(std::stoi(name));
-		if(index >= count_) {
+	void set(std::string_view name, const void *value, size_t) final {
+		size_t index;
+		const auto result = std::from_chars(name.data(), name.data() + name.size(), index);
+		if(result.ec != std::errc() || index >= count_) {
 			return;
 		}
 		target_->set(key_, value, index);
 	}
 
-	virtual std::vector<std::string> values_for(const std::string &) const final {
+	virtual std::vector<std::string> values_for(std::string_view) const final {
 		return {};
 	}
 
-	void *get(const std::string &) final {
+	void *get(std::string_view) final {
 		return nullptr;
 	}
 
 	private:
 		Reflection::Struct *target_;
 		const std::type_info *type_;
-		std::string key_;
+		std::string_view key_;
 		size_t count_;
 };
 
-}
+/*!
+	Reads BSON elements in place, declining to read beyond the end of the document.
+*/
+struct BSONReader {
+	const uint8_t *cursor;
+	const uint8_t *const end;
+	bool overran = false;
+
+	template <typename IntT> IntT read_int() {
+		if(size_t(end - cursor) < sizeof(IntT)) {
+			overran = true;
+			return 0;
+		}
 
-bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
-	// Validate the object's declared size.
-	const auto end = bson + size;
-	auto read_int = [&bson] (auto &target) {
-		constexpr auto shift = 8 * (sizeof(target) - 1);
-		target = 0;
-		for(size_t c = 0; c < sizeof(target); ++c) {
-			target >>= 8;
-			target |= decltype(target)(*bson) << shift;
-			++bson;
+		std::make_unsigned_t<IntT> value = 0;
+		for(size_t c = 0; c < sizeof(IntT); ++c) {
+			value |= decltype(value)(cursor[c]) << (8 * c);
 		}
-	};
+		cursor += sizeof(IntT);
+		return IntT(value);
+	}
 
-	uint32_t object_size;
-	read_int(object_size);
-	if(object_size > size) return false;
+	/// @returns A view of the next @c length bytes, which are then skipped, or @c nullptr if there are insufficient.
+	const uint8_t *read(size_t length) {
+		if(size_t(end - cursor) < length) {
+			overran = true;
+			return nullptr;
+		}
+		const uint8_t *const result = cursor;
+		cursor += length;
+		return result;
+	}
 
-	while(true) {
-		const uint8_t next_type = *bson;
-		++bson;
-		if(!next_type)
+	/// @returns A view of the NULL-terminated string that begins at the cursor, which is then skipped.
+	std::string_view read_name() {
+		const auto terminator = static_cast<const uint8_t *>(memchr(cursor, 0, size_t(end - cursor)));
+		if(!terminator) {
+			overran = true;
+			return {};
+		}
+		const std::string_view result(reinterpret_cast<const char *>(cursor), size_t(terminator - cursor));
+		cursor = terminator + 1;
+		return result;
+	}
+};
+
+}
+
+bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
+	// Validate the object's declared size, and limit reading to it.
+	BSONReader reader{bson, bson + size};
+	const uint32_t object_size = reader.read_int<uint32_t>();
+	if(reader.overran || object_size > size || object_size < 5) return false;
+	BSONReader elements{reader.cursor, bson + object_size};
+
+	while(!elements.overran) {
+		const uint8_t next_type = elements.read_int<uint8_t>();
+		if(!next_type || elements.overran)
 			break;
 
-		std::string key;
-		while(*bson) {
-			key.push_back(char(*bson));
-			++bson;
-		}
-		++bson;
+		const auto key = elements.read_name();
+		const auto type = type_of(key);
 
 		switch(next_type) {
 			default:
 				return false;
 
 			// 0x03: A subdocument; try to install the inner BSON.
-			// 0x05: Binary data. Seek to populate a std::vector<uint8_t>.
+			// 0x04: An array. BSON's encoding of these is a minor pain, but could be worse;
+			// they're presented as a subobject with objects serialised in array order
+			// but given the string keys "0", "1", etc. So: validate the keys, decode
+			// the objects.
 			case 0x03:
-			case 0x05: {
-				const auto type = type_of(key);
-
-				uint32_t subobject_size;
-				read_int(subobject_size);
+			case 0x04: {
+				const uint8_t *const document = elements.cursor;
+				const uint32_t length = elements.read_int<uint32_t>();
+				if(length < 4 || !elements.read(length - 4)) return false;
 
-				if(next_type == 0x03 && *type == typeid(Reflection::Struct)) {
+				if(next_type == 0x03 && type && *type == typeid(Reflection::Struct)) {
 					auto child = reinterpret_cast<Reflection::Struct *>(get(key));
-					child->deserialise(bson - 4, size_t(end - bson + 4));
-					bson += subobject_size - 4;
+					if(!child->deserialise(document, length)) return false;
 				}
 
-				if(next_type == 0x05 && *type == typeid(std::vector<uint8_t>)) {
-					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
-					*child = std::vector<uint8_t>(bson, bson + subobject_size);
-					bson += subobject_size;
+				if(next_type == 0x04 && type) {
+					ArrayReceiver receiver(this, type, key, count_of(key));
+					if(!receiver.deserialise(document, length)) return false;
 				}
 			} break;
 
-			// Array. BSON's encoding of these is a minor pain, but could be worse;
-			// they're presented as a subobject with objects serialised in array order
-			// but given the string keys "0", "1", etc. So: validate the keys, decode
-			// the objects.
-			case 0x04: {
-				ArrayReceiver receiver(this, type_of(key), key, count_of(key));
-
-				uint32_t subobject_size;
-				read_int(subobject_size);
-
-				receiver.deserialise(bson - 4, size_t(end - bson + 4));
+			// Binary data. Seek to populate a std::vector<uint8_t>, reusing its existing storage
+			// if possible.
+			case 0x05: {
+				const uint32_t length = elements.read_int<uint32_t>();
+				elements.read_int<uint8_t>();	// Subtype.
+				const uint8_t *const data = elements.read(length);
+				if(!data) return false;
 
-				bson += subobject_size - 4;
+				if(type && *type == typeid(std::vector<uint8_t>)) {
+					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
+					child->assign(data, data + length);
+				}
 			} break;
 
 			// String.
 			case 0x02: {
-				uint32_t length;
-				read_int(length);
+				const uint32_t length = elements.read_int<uint32_t>();
+				const uint8_t *const data = elements.read(length);
+				if(!data || !length) return false;
 
-				const std::string value(bson, bson + length - 1);
+				const std::string value(data, data + length - 1);
 				::Reflection::set<const std::string &>(*this, key, value);
-
-				bson += length;
 			} break;
 
 			// Boolean.
 			case 0x08: {
-				const bool value = *bson;
-				++bson;
+				const bool value = elements.read_int<uint8_t>();
 				::Reflection::set(*this, key, value);
 			} break;
 
 			// 32-bit int.
 			case 0x10: {
-				int32_t value;
-				read_int(value);
+				const int32_t value = elements.read_int<int32_t>();
 				::Reflection::set(*this, key, value);
 			} break;
 
 			// 64-bit int.
 			case 0x12: {
-				int64_t value;
-				read_int(value);
+				const int64_t value = elements.read_int<int64_t>();
 				::Reflection::set(*this, key, value);
 			} break;
 
 			// 64-bit double.
 			case 0x01: {
-				uint64_t value;
-				read_int(value);
+				const uint64_t value = elements.read_int<uint64_t>();
 
 				const double mantissa = 0.5 + double(value & 0x000f'ffff'ffff'ffff) / 9007199254740992.0;
 				const int exponent = ((value >> 52) & 2047) - 1022;
@@ -562,5 +603,191 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 		}
 	}
 
+	return !elements.overran;
+}
+
+// MARK: - Snapshots
+
+namespace {
+
+template <typename IntT> void push_raw(std::vector<uint8_t> &target, const void *source, IntT size) {
+	const auto start = target.size();
+	target.resize(start + size_t(size));
+	memcpy(&target[start], source, size_t(size));
+}
+
+bool read_length(const uint8_t *&source, const uint8_t *end, uint32_t &length) {
+	if(end - source < ptrdiff_t(sizeof(length))) return false;
+	memcpy(&length, source, sizeof(length));
+	source += sizeof(length);
+	return end - source >= ptrdiff_t(length);
+}
+
+}
+
+std::vector<uint8_t> Reflection::Struct::snapshot() const {
+	std::vector<uint8_t> result;
+	snapshot(result);
+	return result;
+}
+
+void Reflection::Struct::snapshot(std::vector<uint8_t> &target) const {
+	const auto layout = snapshot_layout();
+	assert(layout);
+	if(!layout) return;
+
+	const uint8_t *const base = reinterpret_cast<const uint8_t *>(this);
+	for(const auto &entry: *layout) {
+		const uint8_t *const source = base + entry.offset;
+
+		switch(entry.kind) {
+			case SnapshotEntry::Kind::Bytes:
+				push_raw(target, source, entry.size);
+			break;
+
+			case SnapshotEntry::Kind::Vector: {
+				const auto &vector = *reinterpret_cast<const std::vector<uint8_t> *>(source);
+				const uint32_t length = uint32_t(vector.size());
+				push_raw(target, &length, sizeof(length));
+				push_raw(target, vector.data(), length);
+			} break;
+
+			case SnapshotEntry::Kind::String: {
+				const auto &string = *reinterpret_cast<const std::string *>(source);
+				const uint32_t length = uint32_t(string.size());
+				push_raw(target, &length, sizeof(length));
+				push_raw(target, string.data(), length);
+			} break;
+
+			case SnapshotEntry::Kind::Struct:
+				reinterpret_cast<const Reflection::Struct *>(source)->snapshot(target);
+			break;
+		}
+	}
+}
+
+bool Reflection::Struct::restore(const std::vector<uint8_t> &snapshot) {
+	const uint8_t *source = snapshot.data();
+	return restore(source, snapshot.data() + snapshot.size()) && source == snapshot.data() + snapshot.size();
+}
+
+bool Reflection::Struct::restore(const uint8_t *&source, const uint8_t *end) {
+	const auto layout = snapshot_layout();
+	if(!layout) return false;
+
+	uint8_t *const base = reinterpret_cast<uint8_t *>(this);
+	for(const auto &entry: *layout) {
+		uint8_t *const target = base + entry.offset;
+		uint32_t length;
+
+		switch(entry.kind) {
+			case SnapshotEntry::Kind::Bytes:
+				if(end - source < ptrdiff_t(entry.size)) return false;
+				memcpy(target, source, entry.size);
+				source += entry.size;
+			break;
+
+			case SnapshotEntry::Kind::Vector: {
+				if(!read_length(source, end, length)) return false;
+				auto &vector = *reinterpret_cast<std::vector<uint8_t> *>(target);
+				vector.assign(source, source + length);
+				source += length;
+			} break;
+
+			case SnapshotEntry::Kind::String: {
+				if(!read_length(source, end, length)) return false;
+				auto &string = *reinterpret_cast<std::string *>(target);
+				string.assign(reinterpret_cast<const char *>(source), length);
+				source += length;
+			} break;
+
+			case SnapshotEntry::Kind::Struct:
+				if(!reinterpret_cast<Reflection::Struct *>(target)->restore(source, end)) return false;
+			break;
+		}
+	}
+
+	return true;
+}
+
+/*
+	Deltas are:
+
+		uint32_t	size of the target snapshot
+		... followed by any number of runs:
+		uint32_t	number of bytes to retain from the original
+		uint32_t	number of bytes (n) that follow
+		[n bytes]	replacement data
+*/
+std::vector<uint8_t> Reflection::snapshot_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to) {
+	std::vector<uint8_t> result;
+	const uint32_t size = uint32_t(to.size());
+	push_raw(result, &size, sizeof(size));
+
+	// Anything beyond the end of from necessarily differs.
+	const size_t common = std::min(from.size(), to.size());
+	size_t cursor = 0;
+	while(cursor < to.size()) {
+		// Find the next difference, comparing in blocks where possible.
+		size_t start = cursor;
+		constexpr size_t BlockSize = 64;
+		while(start + BlockSize <= common && !memcmp(&from[start], &to[start], BlockSize)) start += BlockSize;
+		while(start < common && from[start] == to[start]) ++start;
+		if(start == to.size()) break;
+
+		// Find the end of the run of differences; tolerate short intervening matches
+		// since each new run costs eight bytes.
+		size_t end = start + 1;
+		size_t matches = 0;
+		while(end < to.size()) {
+			if(end < common && from[end] == to[end]) {
+				++matches;
+				if(matches == 8) {
+					++end;
+					break;
+				}
+			} else {
+				matches = 0;
+			}
+			++end;
+		}
+		end -= matches;
+
+		const uint32_t retain = uint32_t(start - cursor);
+		const uint32_t length = uint32_t(end - start);
+		push_raw(result, &retain, sizeof(retain));
+		push_raw(result, &length, sizeof(length));
+		push_raw(result, &to[start], length);
+		cursor = end;
+	}
+
+	return result;
+}
+
+bool Reflection::apply_snapshot_delta(std::vector<uint8_t> &snapshot, const std::vector<uint8_t> &delta) {
+	const uint8_t *source = delta.data();
+	const uint8_t *const end = delta.data() + delta.size();
+
+	uint32_t size;
+	if(end - source < ptrdiff_t(sizeof(size))) return false;
+	memcpy(&size, source, sizeof(size));
+	source += sizeof(size);
+	snapshot.resize(size);
+
+	size_t cursor = 0;
+	while(source != end) {
+		uint32_t retain, length;
+		if(end - source < ptrdiff_t(sizeof(retain))) return false;
+		memcpy(&retain, source, sizeof(retain));
+		source += sizeof(retain);
+		if(!read_length(source, end, length)) return false;
+
+		cursor += retain;
+		if(cursor + length > snapshot.size()) return false;
+		memcpy(&snapshot[cursor], source, length);
+		source += length;
+		cursor += length;
+	}
+
 	return true;
 }
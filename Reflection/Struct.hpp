@@ -9,11 +9,13 @@
 #ifndef Struct_hpp
 #define Struct_hpp
 
+#include <algorithm>
 #include <cassert>
 #include <cstdarg>
 #include <cstring>
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <typeinfo>
 #include <type_traits>
@@ -28,17 +30,26 @@ namespace Reflection {
 #define DeclareField(Name) declare(&Name, #Name)
 
 struct Struct {
-	virtual std::vector<std::string> all_keys() const = 0;
-	virtual const std::type_info *type_of(const std::string &name) const = 0;
-	virtual size_t count_of(const std::string &name) const = 0;
-	virtual void set(const std::string &name, const void *value, size_t offset = 0) = 0;
-	virtual void *get(const std::string &name) = 0;
-	virtual const void *get(const std::string &name) const {
+	/// @returns The number of declared fields; together with @c key this allows iteration without allocation.
+	virtual size_t key_count() const = 0;
+	/// @returns The name of the field at @c index, which must be less than @c key_count().
+	virtual std::string_view key(size_t index) const = 0;
+
+	virtual const std::type_info *type_of(std::string_view name) const = 0;
+	virtual size_t count_of(std::string_view name) const = 0;
+	virtual void set(std::string_view name, const void *value, size_t offset = 0) = 0;
+	virtual void *get(std::string_view name) = 0;
+	virtual const void *get(std::string_view name) const {
 		return const_cast<Struct *>(this)->get(name);
 	}
-	virtual std::vector<std::string> values_for(const std::string &name) const = 0;
+	virtual std::vector<std::string> values_for(std::string_view name) const = 0;
 	virtual ~Struct() {}
 
+	/*!
+		@returns A vector of all declared fields for this struct.
+	*/
+	std::vector<std::string> all_keys() const;
+
 	/*!
 		@returns A string describing this struct. This string has no guaranteed layout, may not be
 			sufficiently formed for a formal language parser, etc.
@@ -70,22 +81,87 @@ struct Struct {
 	*/
 	bool deserialise(const std::vector<uint8_t> &bson);
 
+	/*!
+		Applies fields from the @c size bytes of BSON at @c bson, which are parsed in place; neither
+		the document nor any part of it is copied other than into the fields that it sets.
+
+		@returns @c false if the BSON was malformed or exceeded @c size bytes, in which case some
+			fields may already have been applied; @c true otherwise.
+	*/
+	bool deserialise(const uint8_t *bson, size_t size);
+
 	/*!
 		Called to determine whether @c key should be included in the serialisation of this struct.
 	*/
-	virtual bool should_serialise([[maybe_unused]] const std::string &key) const { return true; }
+	virtual bool should_serialise([[maybe_unused]] std::string_view key) const { return true; }
+
+	/*!
+		Appends a binary snapshot of this struct to @c target.
+
+		Unlike @c serialise, a snapshot contains only raw field contents, in a fixed order and without
+		names or type information, so it is much cheaper to produce and to apply. But it can be restored
+		only by the same build on the same host; it is intended for short-term use such as rewind.
+
+		All declared fields are included, regardless of @c should_serialise. Supported field types are
+		as per @c serialise, with the exception that snapshots are not supported by structs that are
+		not @c StructImpls.
+	*/
+	void snapshot(std::vector<uint8_t> &target) const;
+	std::vector<uint8_t> snapshot() const;
+
+	/*!
+		Applies a snapshot previously produced by @c snapshot.
+
+		@returns @c true if the snapshot was applied in full; @c false if it appears to be malformed.
+	*/
+	bool restore(const std::vector<uint8_t> &snapshot);
+
+	protected:
+		/// Describes one contiguous part of a snapshot.
+		struct SnapshotEntry {
+			enum class Kind {
+				/// @c size bytes to be copied directly.
+				Bytes,
+				/// A std::vector<uint8_t>, stored as a length and its contents.
+				Vector,
+				/// A std::string, stored as a length and its contents.
+				String,
+				/// A child Reflection::Struct, stored as its snapshot.
+				Struct,
+			} kind;
+			ptrdiff_t offset;
+			size_t size;
+		};
+
+		/// @returns The order and form in which this struct's fields are included in a snapshot,
+		/// or @c nullptr if snapshots are unsupported.
+		virtual const std::vector<SnapshotEntry> *snapshot_layout() const { return nullptr; }
 
 	private:
-		void append(std::ostringstream &stream, const std::string &key, const std::type_info *type, size_t offset) const;
-		bool deserialise(const uint8_t *bson, size_t size);
+		void append(std::ostringstream &stream, std::string_view key, const std::type_info *type, size_t offset) const;
+		bool restore(const uint8_t *&snapshot, const uint8_t *end);
 };
 
+/*!
+	@returns A description of the differences between the two snapshots @c from and @c to, as
+	produced by Struct::snapshot; this is likely to be much smaller than @c to if few fields have changed.
+*/
+std::vector<uint8_t> snapshot_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to);
+
+/*!
+	Applies @c delta, as produced by @c snapshot_delta, to @c snapshot, which should be the same as the
+	@c from that was used to produce it. Upon return @c snapshot will be the @c to that was used.
+
+	@returns @c true if the delta was applied; @c false if it appears to be malformed.
+*/
+bool apply_snapshot_delta(std::vector<uint8_t> &snapshot, const std::vector<uint8_t> &delta);
+
 /*!
 	Attempts to set the property @c name to @c value ; will perform limited type conversions.
 
 	@returns @c true if the property was successfully set; @c false otherwise.
 */
-template <typename Type> bool set(Struct &target, const std::string &name, Type value, size_t offset = 0);
+template <typename Type> bool set(Struct &target, std::string_view name, Type value, size_t offset = 0);
 
 /*!
 	Setting an int:
@@ -95,27 +171,27 @@ template <typename Type> bool set(Struct &target, const std::string &name, Type
 		* to an int64_t promotes the int; and
 		* to a registered enum, copies the int.
 */
-template <> bool set(Struct &target, const std::string &name, int64_t value, size_t offset);
-template <> bool set(Struct &target, const std::string &name, int value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, int64_t value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, int value, size_t offset);
 
 /*!
 	Setting a string:
 
 		* to an enum, if the string names a member of the enum, sets the value.
 */
-template <> bool set(Struct &target, const std::string &name, const std::string &value, size_t offset);
-template <> bool set(Struct &target, const std::string &name, const char *value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, const std::string &value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, const char *value, size_t offset);
 
 /*!
 	Setting a bool:
 
 		* to a bool, copies the value.
 */
-template <> bool set(Struct &target, const std::string &name, bool value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, bool value, size_t offset);
 
 
-template <> bool set(Struct &target, const std::string &name, float value, size_t offset);
-template <> bool set(Struct &target, const std::string &name, double value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, float value, size_t offset);
+template <> bool set(Struct &target, std::string_view name, double value, size_t offset);
 
 /*!
 	Fuzzy-set attempts to set any property based on a string value. This is intended to allow input provided by the user.
@@ -131,7 +207,7 @@ template <> bool set(Struct &target, const std::string &name, double value, size
 
 @returns @c true if the property was successfully set; @c false otherwise.
 */
-bool fuzzy_set(Struct &target, const std::string &name, const std::string &value);
+bool fuzzy_set(Struct &target, std::string_view name, const std::string &value);
 
 
 /*!
@@ -139,14 +215,14 @@ bool fuzzy_set(Struct &target, const std::string &name, const std::string &value
 
 	@returns @c true if the property was successfully read; @c false otherwise.
 */
-template <typename Type> bool get(const Struct &target, const std::string &name, Type &value, size_t offset = 0);
+template <typename Type> bool get(const Struct &target, std::string_view name, Type &value, size_t offset = 0);
 
 /*!
 	Attempts to get the property @c name to @c value ; will perform limited type conversions.
 
 	@returns @c true if the property was successfully read; a default-constructed instance of Type otherwise.
 */
-template <typename Type> Type get(const Struct &target, const std::string &name, size_t offset = 0);
+template <typename Type> Type get(const Struct &target, std::string_view name, size_t offset = 0);
 
 template <typename Owner> class StructImpl: public Struct {
 	public:
@@ -154,10 +230,10 @@ template <typename Owner> class StructImpl: public Struct {
 			@returns the value of type @c Type that is loaded from the offset registered for the field @c name.
 				It is the caller's responsibility to provide an appropriate type of data.
 		*/
-		void *get(const std::string &name) final {
-			const auto iterator = contents_.find(name);
-			if(iterator == contents_.end()) return nullptr;
-			return reinterpret_cast<uint8_t *>(this) + iterator->second.offset;
+		void *get(std::string_view name) final {
+			const Field *const field = find(name);
+			if(!field) return nullptr;
+			return reinterpret_cast<uint8_t *>(this) + field->offset;
 		}
 
 		/*!
@@ -165,54 +241,53 @@ template <typename Owner> class StructImpl: public Struct {
 
 			It is the caller's responsibility to provide an appropriate type of data.
 		*/
-		void set(const std::string &name, const void *value, size_t offset) final {
-			const auto iterator = contents_.find(name);
-			if(iterator == contents_.end()) return;
-			assert(offset < iterator->second.count);
-			memcpy(reinterpret_cast<uint8_t *>(this) + iterator->second.offset + offset * iterator->second.size, value, iterator->second.size);
+		void set(std::string_view name, const void *value, size_t offset) final {
+			const Field *const field = find(name);
+			if(!field) return;
+			assert(offset < field->count);
+			memcpy(reinterpret_cast<uint8_t *>(this) + field->offset + offset * field->size, value, field->size);
 		}
 
 		/*!
 			@returns @c type_info for the field @c name.
 		*/
-		const std::type_info *type_of(const std::string &name) const final {
-			const auto iterator = contents_.find(name);
-			if(iterator == contents_.end()) return nullptr;
-			return iterator->second.type;
+		const std::type_info *type_of(std::string_view name) const final {
+			const Field *const field = find(name);
+			if(!field) return nullptr;
+			return field->type;
 		}
 
 		/*!
 			@returns The number of instances of objects of the same type as @c name that sit consecutively in memory.
 		*/
-		size_t count_of(const std::string &name) const final {
-			const auto iterator = contents_.find(name);
-			if(iterator == contents_.end()) return 0;
-			return iterator->second.count;
+		size_t count_of(std::string_view name) const final {
+			const Field *const field = find(name);
+			if(!field) return 0;
+			return field->count;
 		}
 
 		/*!
 			@returns a list of the valid enum value names for field @c name if it is a declared enum field of this struct;
 				the empty list otherwise.
 		*/
-		std::vector<std::string> values_for(const std::string &name) const final {
+		std::vector<std::string> values_for(std::string_view name) const final {
 			std::vector<std::string> result;
 
 			// Return an empty vector if this field isn't declared.
-			const auto type = type_of(name);
-			if(!type) return result;
+			const Field *const field = find(name);
+			if(!field) return result;
 
 			// Also return an empty vector if this field isn't a registered enum.
-			const auto all_values = Enum::all_values(*type);
+			const auto all_values = Enum::all_values(*field->type);
 			if(all_values.empty()) return result;
 
 			// If no restriction is stored, return all values.
-			const auto permitted_values = permitted_enum_values_.find(name);
-			if(permitted_values == permitted_enum_values_.end()) return all_values;
+			if(field->permitted_values.empty()) return all_values;
 
 			// Compile a vector of only those values the stored set indicates.
 			auto value = all_values.begin();
-			auto flag = permitted_values->second.begin();
-			while(value != all_values.end() && flag != permitted_values->second.end()) {
+			auto flag = field->permitted_values.begin();
+			while(value != all_values.end() && flag != field->permitted_values.end()) {
 				if(*flag) {
 					result.push_back(*value);
 				}
@@ -224,14 +299,17 @@ template <typename Owner> class StructImpl: public Struct {
 		}
 
 		/*!
-			@returns A vector of all declared fields for this struct.
+			@returns The number of declared fields.
 		*/
-		std::vector<std::string> all_keys() const final {
-			std::vector<std::string> keys;
-			for(const auto &pair: contents_) {
-				keys.push_back(pair.first);
-			}
-			return keys;
+		size_t key_count() const final {
+			return fields_.size();
+		}
+
+		/*!
+			@returns The name of the @c index th field, in order of declaration.
+		*/
+		std::string_view key(size_t index) const final {
+			return fields_[index].name;
 		}
 
 	protected:
@@ -251,7 +329,7 @@ template <typename Owner> class StructImpl: public Struct {
 			Exposes the field pointed to by @c t for reflection as @c name. If @c t is itself a Reflection::Struct,
 			it'll be the struct that's exposed.
 		*/
-		template <typename Type> void declare(Type *t, const std::string &name) {
+		template <typename Type> void declare(Type *t, std::string_view name) {
 			// If the declared item is a class, see whether it can be dynamically cast
 			// to a reflectable for emplacement. If so, exit early.
 			if constexpr (std::is_class<Type>()) {
@@ -274,8 +352,8 @@ template <typename Owner> class StructImpl: public Struct {
 			with a value of -1.
 		*/
 		template <typename Type> void limit_enum(Type *t, ...) {
-			const auto name = name_of(t);
-			if(name.empty()) return;
+			Field *const field = field_at(t);
+			if(!field) return;
 
 			// The default vector size of '8' isn't especially scientific,
 			// but I feel like it's a good choice.
@@ -294,37 +372,81 @@ template <typename Owner> class StructImpl: public Struct {
 			}
 			va_end(list);
 
-			permitted_enum_values_.emplace(std::make_pair(name, permitted_values));
+			// As per declaration, the first limit applied wins.
+			if(field->permitted_values.empty()) {
+				field->permitted_values = std::move(permitted_values);
+			}
 		}
 
 		/*!
 			@returns @c true if this subclass of @c Struct has not yet declared any fields.
 		*/
 		bool needs_declare() {
-			return contents_.empty();
+			return fields_.empty();
 		}
 
 		/*!
 			Performs a reverse lookup from field to name.
 		*/
 		std::string name_of(void *field) {
-			const ssize_t offset = reinterpret_cast<uint8_t *>(field) - reinterpret_cast<uint8_t *>(this);
-
-			auto iterator = contents_.begin();
-			while(iterator != contents_.end()) {
-				if(iterator->second.offset == offset) break;
-				++iterator;
-			}
+			const Field *const declared = field_at(field);
+			return declared ? declared->name : std::string();
+		}
 
-			if(iterator != contents_.end()) {
-				return iterator->first;
-			} else {
-				return std::string();
-			}
+		/*!
+			Provides a layout, calculated upon first request, that orders fields by their position
+			in memory and merges adjacent plain-data fields into single copies.
+		*/
+		const std::vector<SnapshotEntry> *snapshot_layout() const final {
+			static const std::vector<SnapshotEntry> layout = [] {
+				std::vector<const Field *> fields;
+				for(const auto &field: fields_) {
+					fields.push_back(&field);
+				}
+				std::sort(fields.begin(), fields.end(), [] (const Field *lhs, const Field *rhs) {
+					return lhs->offset < rhs->offset;
+				});
+
+				std::vector<SnapshotEntry> result;
+				for(const auto field: fields) {
+					using Kind = SnapshotEntry::Kind;
+
+					if(*field->type == typeid(Reflection::Struct)) {
+						result.push_back({Kind::Struct, field->offset, field->size});
+						continue;
+					}
+
+					const bool is_vector = *field->type == typeid(std::vector<uint8_t>);
+					const bool is_string = *field->type == typeid(std::string);
+					if(is_vector || is_string) {
+						for(size_t c = 0; c < field->count; c++) {
+							result.push_back({
+								is_vector ? Kind::Vector : Kind::String,
+								field->offset + ptrdiff_t(c * field->size),
+								field->size
+							});
+						}
+						continue;
+					}
+
+					const size_t size = field->size * field->count;
+					if(
+						!result.empty() &&
+						result.back().kind == Kind::Bytes &&
+						result.back().offset + ptrdiff_t(result.back().size) == field->offset
+					) {
+						result.back().size += size;
+					} else {
+						result.push_back({Kind::Bytes, field->offset, size});
+					}
+				}
+				return result;
+			}();
+			return &layout;
 		}
 
 	private:
-		template <typename Type> bool declare_reflectable([[maybe_unused]] Type *t, const std::string &name) {
+		template <typename Type> bool declare_reflectable([[maybe_unused]] Type *t, std::string_view name) {
 			if constexpr (std::is_base_of<Reflection::Struct, Type>::value) {
 				Reflection::Struct *const str = static_cast<Reflection::Struct *>(t);
 				declare_emplace(str, name);
@@ -334,24 +456,77 @@ template <typename Owner> class StructImpl: public Struct {
 			return false;
 		}
 
-		template <typename Type> void declare_emplace(Type *t, const std::string &name, size_t count = 1) {
-			contents_.emplace(
-				std::make_pair(
-					name,
-					Field(typeid(Type), reinterpret_cast<uint8_t *>(t) - reinterpret_cast<uint8_t *>(this), sizeof(Type), count)
-				));
+		template <typename Type> void declare_emplace(Type *t, std::string_view name, size_t count = 1) {
+			// Retain only the first declaration of any name.
+			if(find(name)) return;
+
+			fields_.emplace_back(
+				name,
+				typeid(Type),
+				reinterpret_cast<uint8_t *>(t) - reinterpret_cast<uint8_t *>(this),
+				sizeof(Type),
+				count
+			);
+
+			// Keep the index no more than half full, so that probe sequences stay short.
+			if(fields_.size() * 2 > index_.size()) {
+				index_.assign(index_.empty() ? 16 : index_.size() * 2, 0);
+				for(size_t c = 0; c < fields_.size(); c++) {
+					insert(c);
+				}
+			} else {
+				insert(fields_.size() - 1);
+			}
 		}
 
 		struct Field {
+			std::string name;
+			size_t hash;
 			const std::type_info *type;
 			ssize_t offset;
 			size_t size;
 			size_t count;
-			Field(const std::type_info &type, ssize_t offset, size_t size, size_t count) :
-				type(&type), offset(offset), size(size), count(count) {}
+
+			/// Empty if all values of an enum are permitted; otherwise a flag per value.
+			std::vector<bool> permitted_values;
+
+			Field(std::string_view name, const std::type_info &type, ssize_t offset, size_t size, size_t count) :
+				name(name), hash(std::hash<std::string_view>()(name)), type(&type), offset(offset), size(size), count(count) {}
 		};
-		static inline std::unordered_map<std::string, Field> contents_;
-		static inline std::unordered_map<std::string, std::vector<bool>> permitted_enum_values_;
+
+		/// All declared fields, in order of declaration.
+		static inline std::vector<Field> fields_;
+
+		/// An open-addressed hash table of indices into fields_, each plus one so that zero can mark an empty
+		/// slot; its size is always a power of two and is at least twice the number of fields.
+		static inline std::vector<uint32_t> index_;
+
+		void insert(size_t field) {
+			const size_t mask = index_.size() - 1;
+			size_t slot = fields_[field].hash & mask;
+			while(index_[slot]) slot = (slot + 1) & mask;
+			index_[slot] = uint32_t(field + 1);
+		}
+
+		static const Field *find(std::string_view name) {
+			if(index_.empty()) return nullptr;
+
+			const size_t hash = std::hash<std::string_view>()(name);
+			const size_t mask = index_.size() - 1;
+			for(size_t slot = hash & mask; index_[slot]; slot = (slot + 1) & mask) {
+				const Field &field = fields_[index_[slot] - 1];
+				if(field.hash == hash && field.name == name) return &field;
+			}
+			return nullptr;
+		}
+
+		Field *field_at(void *field) {
+			const ssize_t offset = reinterpret_cast<uint8_t *>(field) - reinterpret_cast<uint8_t *>(this);
+			for(auto &declared: fields_) {
+				if(declared.offset == offset) return &declared;
+			}
+			return nullptr;
+		}
 };
 
 
@@ -363,7 +538,7 @@ template <typename Owner> class StructImpl: public Struct {
 
 // MARK: - Getters
 
-template <typename Type> bool get(const Struct &target, const std::string &name, Type &value, size_t offset) {
+template <typename Type> bool get(const Struct &target, std::string_view name, Type &value, size_t offset) {
 	const auto target_type = target.type_of(name);
 	if(!target_type) return false;
 
@@ -420,7 +595,7 @@ template <typename Type> bool get(const Struct &target, const std::string &name,
 	return false;
 }
 
-template <typename Type> Type get(const Struct &target, const std::string &name, size_t offset) {
+template <typename Type> Type get(const Struct &target, std::string_view name, size_t offset) {
 	Type value{};
 	get(target, name, value, offset);
 	return value;
@@ -15,6 +15,10 @@
 #if defined(__APPLE__) && !defined(TARGET_QT)
 #include <Accelerate/Accelerate.h>
 #define USE_ACCELERATE
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
 #endif
 
 #include <cstddef>
@@ -60,14 +64,91 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
+				const std::size_t taps = filter_coefficients_.size();
+				const short *const coefficients = filter_coefficients_.data();
+				std::size_t c = 0;
 				int outputValue = 0;
-				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
-					outputValue += filter_coefficients_[c] * src[c * stride];
+
+				if(stride == 1) {
+					#if defined(__SSE2__)
+						__m128i sum = _mm_setzero_si128();
+						for(; c + 8 <= taps; c += 8) {
+							sum = _mm_add_epi32(sum, _mm_madd_epi16(
+								_mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c])),
+								_mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]))
+							));
+						}
+						outputValue = horizontal_sum(sum);
+					#elif defined(__ARM_NEON)
+						int32x4_t sum = vdupq_n_s32(0);
+						for(; c + 4 <= taps; c += 4) {
+							sum = vmlal_s16(sum, vld1_s16(&src[c]), vld1_s16(&coefficients[c]));
+						}
+						outputValue = horizontal_sum(sum);
+					#endif
+				}
+
+				for(; c < taps; ++c) {
+					outputValue += coefficients[c] * src[c * stride];
 				}
 				return short(outputValue >> FixedShift);
 			#endif
 		}
 
+		/*!
+			Applies the filter to both channels of a batch of stereo-interleaved input samples.
+
+			@param src The source buffer to apply the filter to.
+			@param destination Receives the left and then the right result.
+		*/
+		inline void apply_stereo(const short *src, short *destination) const {
+			#if defined(USE_ACCELERATE) || !(defined(__SSE2__) || defined(__ARM_NEON))
+				destination[0] = apply(src, 2);
+				destination[1] = apply(src + 1, 2);
+			#else
+				const std::size_t taps = filter_coefficients_.size();
+				const short *const coefficients = filter_coefficients_.data();
+				std::size_t c = 0;
+
+				#if defined(__SSE2__)
+					// Take four stereo samples at a time, rearrange from LRLRLRLR to LLLLRRRR,
+					// and multiply by the next four coefficients twice over.
+					__m128i left_right = _mm_setzero_si128();
+					for(; c + 4 <= taps; c += 4) {
+						__m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c * 2]));
+						samples = _mm_shufflelo_epi16(samples, _MM_SHUFFLE(3, 1, 2, 0));
+						samples = _mm_shufflehi_epi16(samples, _MM_SHUFFLE(3, 1, 2, 0));
+						samples = _mm_shuffle_epi32(samples, _MM_SHUFFLE(3, 1, 2, 0));
+
+						const __m128i coefficient = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&coefficients[c]));
+						left_right = _mm_add_epi32(left_right, _mm_madd_epi16(samples, _mm_unpacklo_epi64(coefficient, coefficient)));
+					}
+
+					// Lanes are now: left, left, right, right.
+					left_right = _mm_add_epi32(left_right, _mm_shuffle_epi32(left_right, _MM_SHUFFLE(2, 3, 0, 1)));
+					int left = _mm_cvtsi128_si32(left_right);
+					int right = _mm_cvtsi128_si32(_mm_shuffle_epi32(left_right, _MM_SHUFFLE(3, 2, 3, 2)));
+				#else
+					int32x4_t left_sum = vdupq_n_s32(0), right_sum = vdupq_n_s32(0);
+					for(; c + 4 <= taps; c += 4) {
+						const int16x4x2_t samples = vld2_s16(&src[c * 2]);
+						const int16x4_t coefficient = vld1_s16(&coefficients[c]);
+						left_sum = vmlal_s16(left_sum, samples.val[0], coefficient);
+						right_sum = vmlal_s16(right_sum, samples.val[1], coefficient);
+					}
+					int left = horizontal_sum(left_sum);
+					int right = horizontal_sum(right_sum);
+				#endif
+
+				for(; c < taps; ++c) {
+					left += coefficients[c] * src[c * 2];
+					right += coefficients[c] * src[c * 2 + 1];
+				}
+				destination[0] = short(left >> FixedShift);
+				destination[1] = short(right >> FixedShift);
+			#endif
+		}
+
 		/*! @returns The number of taps used by this filter. */
 		inline std::size_t get_number_of_taps() const {
 			return filter_coefficients_.size();
@@ -96,6 +177,19 @@ class FIRFilter {
 	private:
 		std::vector<short> filter_coefficients_;
 
+		#if !defined(USE_ACCELERATE) && defined(__SSE2__)
+			static inline int horizontal_sum(__m128i sum) {
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+				sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+				return _mm_cvtsi128_si32(sum);
+			}
+		#elif !defined(USE_ACCELERATE) && defined(__ARM_NEON)
+			static inline int horizontal_sum(int32x4_t sum) {
+				const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+				return vget_lane_s32(vpadd_s32(pair, pair), 0);
+			}
+		#endif
+
 		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
 		static float ino(float a);
 };
@@ -8,33 +8,26 @@
 
 #include "PRG.hpp"
 
-#include <cstdio>
-#include <sys/stat.h>
-
 #include "../Encodings/CommodoreROM.hpp"
+#include "../../FileHolder.hpp"
 
 using namespace Storage::Cartridge;
 
 PRG::PRG(const std::string &file_name) {
-	struct stat file_stats;
-	stat(file_name.c_str(), &file_stats);
+	FileHolder file(file_name, FileHolder::FileMode::Read);
 
 	// accept only files sized less than 8kb
-	if(file_stats.st_size > 0x2000 + 2)
+	if(file.stats().st_size > 0x2000 + 2 || file.stats().st_size < 2)
 		throw ErrorNotROM;
 
 	// get the loading address, and the rest of the contents
-	FILE *file = std::fopen(file_name.c_str(), "rb");
-
-	int loading_address = fgetc(file);
-	loading_address |= fgetc(file) << 8;
+	const int loading_address = file.get16le();
 
-	std::size_t data_length = size_t(file_stats.st_size) - 2;
+	std::size_t data_length = size_t(file.stats().st_size) - 2;
 	std::size_t padded_data_length = 1;
 	while(padded_data_length < data_length) padded_data_length <<= 1;
 	std::vector<uint8_t> contents(padded_data_length);
-	std::size_t length = std::fread(contents.data(), 1, size_t(data_length), file);
-	std::fclose(file);
+	std::size_t length = file.read(contents.data(), data_length);
 
 	// accept only files intended to load at 0xa000
 	if(loading_address != 0xa000 || length != size_t(data_length))
@@ -0,0 +1,341 @@
+//
+//  Container.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Container.hpp"
+
+#include "FileHolder.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <sys/stat.h>
+#include <zlib.h>
+
+using namespace Storage;
+
+namespace {
+
+/// The total size of decompressed files retained, beyond which the least recently used are discarded.
+/// No single file larger than this will be decompressed.
+constexpr size_t CacheLimit = 256 * 1024 * 1024;
+
+bool has_extension(const std::string &name, const std::string &extension) {
+	if(name.size() <= extension.size()) return false;
+	return std::equal(extension.begin(), extension.end(), name.end() - long(extension.size()), [](char lhs, char rhs) {
+		return lhs == std::tolower(uint8_t(rhs));
+	});
+}
+
+bool is_gzip(const std::string &file_name) {
+	return has_extension(file_name, ".gz");
+}
+
+/// @returns The name of the single file within the gzip archive @c file_name, i.e. its final path component less the .gz extension.
+std::string gzip_member(const std::string &file_name) {
+	const auto slash = file_name.find_last_of('/');
+	const auto start = slash == std::string::npos ? 0 : slash + 1;
+	return file_name.substr(start, file_name.size() - 3 - start);
+}
+
+/*!
+	Splits @c name into the path of an existing archive and the name of a file within that archive.
+
+	@returns @c true if @c name refers to a file within an archive; @c false otherwise.
+*/
+bool split(const std::string &name, std::string &archive, std::string &member, struct stat &archive_stats) {
+	for(auto slash = name.find('/'); slash != std::string::npos; slash = name.find('/', slash + 1)) {
+		archive = name.substr(0, slash);
+		if(!Container::is_container(archive)) continue;
+		if(stat(archive.c_str(), &archive_stats) || !S_ISREG(archive_stats.st_mode)) continue;
+
+		member = name.substr(slash + 1);
+		return !member.empty();
+	}
+	return false;
+}
+
+/*!
+	Inflates @c source, which should be in the form indicated by @c window_bits as per zlib's @c inflateInit2,
+	into @c destination; @c destination should be sized to the expected size of the result, but will be
+	grown if necessary, up to @c limit, and trimmed to fit.
+
+	@returns @c true if the whole of @c source was inflated successfully to at most @c limit bytes; @c false otherwise.
+*/
+bool inflate_into(std::vector<uint8_t> &source, int window_bits, std::vector<uint8_t> &destination, size_t limit) {
+	z_stream stream{};
+	if(inflateInit2(&stream, window_bits) != Z_OK) return false;
+
+	stream.next_in = source.data();
+	stream.avail_in = uInt(source.size());
+
+	// Count output separately from total_out, which is reset along with the stream.
+	size_t length = 0;
+	bool succeeded = false;
+	while(true) {
+		if(length == destination.size()) {
+			// Allow one byte beyond the limit, so that a result of exactly the limit can be distinguished from one that exceeds it.
+			if(length > limit) break;
+			destination.resize(std::min(std::max(destination.size() * 2, size_t(65536)), limit + 1));
+		}
+		stream.next_out = &destination[length];
+		stream.avail_out = uInt(destination.size() - length);
+
+		const int result = inflate(&stream, Z_NO_FLUSH);
+		length = destination.size() - stream.avail_out;
+		if(result == Z_STREAM_END) {
+			// gzip files may consist of several concatenated members.
+			if(stream.avail_in && window_bits > MAX_WBITS && inflateReset(&stream) == Z_OK) continue;
+			succeeded = true;
+			break;
+		}
+		if(result != Z_OK && !(result == Z_BUF_ERROR && !stream.avail_out)) break;
+	}
+
+	destination.resize(length);
+	inflateEnd(&stream);
+	return succeeded && length <= limit;
+}
+
+/*!
+	@returns An initial size for the buffer into which @c compressed_size bytes will be inflated, given the archive's
+	@c claimed_size. The claim isn't trusted: it is limited both by deflate's maximum compression ratio and absolutely,
+	since @c inflate_into will grow the buffer if necessary.
+*/
+size_t initial_size(size_t claimed_size, size_t compressed_size) {
+	constexpr size_t MaximumRatio = 1032;
+	constexpr size_t MaximumInitialSize = 16 * 1024 * 1024;
+	return std::min({claimed_size, compressed_size * MaximumRatio, MaximumInitialSize});
+}
+
+std::shared_ptr<const std::vector<uint8_t>> gzip_contents(FileHolder &file) {
+	std::vector<uint8_t> source = file.read(size_t(file.stats().st_size));
+	if(source.size() < 4) return nullptr;
+
+	// The final four bytes of a gzip file give the size of the original, modulo 2^32.
+	const uint8_t *const trailer = &source[source.size() - 4];
+	std::vector<uint8_t> destination(initial_size(
+		uint32_t(trailer[0]) |
+		(uint32_t(trailer[1]) << 8) |
+		(uint32_t(trailer[2]) << 16) |
+		(uint32_t(trailer[3]) << 24),
+		source.size()
+	));
+
+	if(!inflate_into(source, 16 + MAX_WBITS, destination, CacheLimit)) return nullptr;
+	return std::make_shared<const std::vector<uint8_t>>(std::move(destination));
+}
+
+struct ZipEntry {
+	std::string name;
+	uint16_t method = 0;
+	uint32_t crc32 = 0;
+	uint32_t compressed_size = 0;
+	uint32_t uncompressed_size = 0;
+	uint32_t local_header_offset = 0;
+};
+
+/// @returns All entries in the central directory of the zip file @c file, or an empty list if it has none or can't be read.
+std::vector<ZipEntry> zip_directory(FileHolder &file) {
+	// The end of central directory record is 22 bytes long plus a comment of up to 65535 bytes, and sits at the end of the file.
+	const long size = long(file.stats().st_size);
+	const long tail_size = std::min(size, 22l + 65535l);
+	file.seek(size - tail_size, SEEK_SET);
+	const std::vector<uint8_t> tail = file.read(size_t(tail_size));
+	if(tail.size() < 22) return {};
+
+	size_t record = tail.size() - 22;
+	while(memcmp(&tail[record], "PK\5\6", 4)) {
+		if(!record) return {};
+		--record;
+	}
+	const uint16_t entry_count = uint16_t(tail[record + 10] | (tail[record + 11] << 8));
+	const uint32_t directory_offset =
+		uint32_t(tail[record + 16]) |
+		(uint32_t(tail[record + 17]) << 8) |
+		(uint32_t(tail[record + 18]) << 16) |
+		(uint32_t(tail[record + 19]) << 24);
+
+	std::vector<ZipEntry> entries;
+	file.seek(long(directory_offset), SEEK_SET);
+	for(uint16_t c = 0; c < entry_count; c++) {
+		if(file.get32le() != 0x02014b50) break;
+
+		ZipEntry entry;
+		file.seek(6, SEEK_CUR);		// Skip: version made by, version needed, flags.
+		entry.method = file.get16le();
+		file.seek(4, SEEK_CUR);		// Skip: modification time and date.
+		entry.crc32 = file.get32le();
+		entry.compressed_size = file.get32le();
+		entry.uncompressed_size = file.get32le();
+
+		const uint16_t name_length = file.get16le();
+		const uint16_t extra_length = file.get16le();
+		const uint16_t comment_length = file.get16le();
+		file.seek(8, SEEK_CUR);		// Skip: disk number, internal and external attributes.
+		entry.local_header_offset = file.get32le();
+
+		const std::vector<uint8_t> name = file.read(name_length);
+		entry.name.assign(name.begin(), name.end());
+		file.seek(long(extra_length) + long(comment_length), SEEK_CUR);
+		if(file.eof()) break;
+
+		entries.push_back(std::move(entry));
+	}
+	return entries;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> zip_contents(FileHolder &file, const std::string &member) {
+	const auto entries = zip_directory(file);
+	const auto entry = std::find_if(entries.begin(), entries.end(), [&member](const ZipEntry &entry) {
+		return entry.name == member;
+	});
+	if(entry == entries.end()) return nullptr;
+
+	// Skip the local header; its name and extra field lengths may differ from those in the central directory.
+	file.seek(long(entry->local_header_offset), SEEK_SET);
+	if(file.get32le() != 0x04034b50) return nullptr;
+	file.seek(22, SEEK_CUR);
+	const uint16_t name_length = file.get16le();
+	const uint16_t extra_length = file.get16le();
+	file.seek(long(name_length) + long(extra_length), SEEK_CUR);
+
+	std::vector<uint8_t> source = file.read(entry->compressed_size);
+	if(source.size() != entry->compressed_size) return nullptr;
+
+	std::vector<uint8_t> destination;
+	switch(entry->method) {
+		default: return nullptr;
+
+		case 0:		// Stored.
+			destination = std::move(source);
+		break;
+
+		case 8:		// Deflated.
+			destination.resize(initial_size(entry->uncompressed_size, source.size()));
+			if(!inflate_into(source, -MAX_WBITS, destination, CacheLimit)) return nullptr;
+		break;
+	}
+
+	if(crc32(0, destination.data(), uInt(destination.size())) != entry->crc32) return nullptr;
+	return std::make_shared<const std::vector<uint8_t>>(std::move(destination));
+}
+
+/// Files that have been decompressed during this run, along with a description of the archive that each came from.
+struct CachedFile {
+	off_t archive_size;
+	time_t archive_modification_time;
+	std::shared_ptr<const std::vector<uint8_t>> contents;
+	uint64_t last_use;
+};
+std::mutex cache_mutex;
+std::map<std::string, CachedFile> cache;
+uint64_t cache_uses = 0;
+size_t cache_size = 0;
+
+/// Adds @c file to the cache as @c name, discarding other files as necessary to stay within @c CacheLimit.
+/// @c cache_mutex must be held.
+void cache_insert(const std::string &name, CachedFile &&file) {
+	const auto existing = cache.find(name);
+	if(existing != cache.end()) {
+		cache_size -= existing->second.contents->size();
+		cache.erase(existing);
+	}
+
+	while(!cache.empty() && cache_size + file.contents->size() > CacheLimit) {
+		const auto oldest = std::min_element(cache.begin(), cache.end(), [](const auto &lhs, const auto &rhs) {
+			return lhs.second.last_use < rhs.second.last_use;
+		});
+		cache_size -= oldest->second.contents->size();
+		cache.erase(oldest);
+	}
+
+	cache_size += file.contents->size();
+	file.last_use = ++cache_uses;
+	cache.emplace(name, std::move(file));
+}
+
+}
+
+bool Container::is_container(const std::string &file_name) {
+	return is_gzip(file_name) || has_extension(file_name, ".zip");
+}
+
+std::vector<std::string> Container::members(const std::string &file_name) {
+	if(is_gzip(file_name)) {
+		return {file_name + "/" + gzip_member(file_name)};
+	}
+	if(!is_container(file_name)) return {};
+
+	std::vector<std::string> members;
+	try {
+		FileHolder file(file_name, FileHolder::FileMode::Read);
+		for(const auto &entry: zip_directory(file)) {
+			// Omit directories, and the resource forks that macOS adds to archives it creates.
+			if(entry.name.empty() || entry.name.back() == '/' || !entry.name.compare(0, 9, "__MACOSX/")) continue;
+			members.push_back(file_name + "/" + entry.name);
+		}
+	} catch(...) {}
+	return members;
+}
+
+std::shared_ptr<const std::vector<uint8_t>> Container::contents(const std::string &name) {
+	std::string archive, member;
+	struct stat archive_stats;
+	if(!split(name, archive, member, archive_stats)) return nullptr;
+
+	{
+		std::lock_guard lock(cache_mutex);
+		const auto existing = cache.find(name);
+		if(
+			existing != cache.end() &&
+			existing->second.archive_size == archive_stats.st_size &&
+			existing->second.archive_modification_time == archive_stats.st_mtime
+		) {
+			existing->second.last_use = ++cache_uses;
+			return existing->second.contents;
+		}
+	}
+
+	// Decompress without holding the lock, so that separate files can be decompressed concurrently.
+	std::shared_ptr<const std::vector<uint8_t>> contents;
+	try {
+		FileHolder file(archive, FileHolder::FileMode::Read);
+		if(is_gzip(archive)) {
+			if(member == gzip_member(archive)) contents = gzip_contents(file);
+		} else {
+			contents = zip_contents(file, member);
+		}
+	} catch(...) {}
+	if(!contents) return nullptr;
+
+	std::lock_guard lock(cache_mutex);
+	cache_insert(name, CachedFile{archive_stats.st_size, archive_stats.st_mtime, contents, 0});
+	return contents;
+}
+
+void Container::prefetch(const std::vector<std::string> &names) {
+	if(names.empty()) return;
+
+	std::atomic<size_t> next = 0;
+	const auto decompress = [&] {
+		size_t index;
+		while((index = next++) < names.size()) {
+			contents(names[index]);
+		}
+	};
+
+	std::vector<std::thread> threads(std::min(names.size(), size_t(std::max(1u, std::thread::hardware_concurrency()))) - 1);
+	for(auto &thread: threads) thread = std::thread(decompress);
+	decompress();
+	for(auto &thread: threads) thread.join();
+}
@@ -0,0 +1,48 @@
+//
+//  Container.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Container_hpp
+#define Container_hpp
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Storage {
+namespace Container {
+
+/*!
+	Provides access to files held within zip and gzip archives.
+
+	A file within an archive is named by the archive's path, followed by a slash, followed by the file's
+	name within the archive; e.g. "games.zip/disk1.adf". The single file within a gzip archive takes the
+	archive's name without its .gz extension; e.g. "disk1.adf.gz/disk1.adf".
+
+	Files are decompressed only when first requested, and the most recently used results are retained,
+	up to a fixed total size, so that a file needn't be decompressed again unless its archive changes.
+	A file that would decompress to more than that size is treated as unreadable.
+*/
+
+/// @returns @c true if @c file_name has the extension of a supported archive type; @c false otherwise.
+bool is_container(const std::string &file_name);
+
+/// @returns The names of all files within the archive @c file_name, or an empty list if it can't be read.
+std::vector<std::string> members(const std::string &file_name);
+
+/// @returns The contents of @c name if it is a file within an archive, decompressing it if necessary;
+///		@c nullptr otherwise.
+std::shared_ptr<const std::vector<uint8_t>> contents(const std::string &name);
+
+/// Decompresses all of @c names concurrently, so that subsequent calls to @c contents can be satisfied immediately.
+void prefetch(const std::vector<std::string> &names);
+
+}
+}
+
+#endif /* Container_hpp */
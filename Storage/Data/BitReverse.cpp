@@ -8,18 +8,43 @@
 
 #include "BitReverse.hpp"
 
+#include "../../Numeric/BitReverse.hpp"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 void Storage::Data::BitReverse::reverse(std::vector<uint8_t> &vector) {
-	for(auto &byte : vector) {
-		byte =
-			uint8_t(
-				((byte & 0x01) << 7) |
-				((byte & 0x02) << 5) |
-				((byte & 0x04) << 3) |
-				((byte & 0x08) << 1) |
-				((byte & 0x10) >> 1) |
-				((byte & 0x20) >> 3) |
-				((byte & 0x40) >> 5) |
-				((byte & 0x80) >> 7)
-			);
+	uint8_t *data = vector.data();
+	size_t length = vector.size();
+
+#if defined(__SSSE3__)
+	// Reverse each nibble via a table lookup, then swap the two nibbles' positions.
+	const __m128i reversed_nibbles = _mm_setr_epi8(
+		0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe,
+		0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf
+	);
+	const __m128i low_mask = _mm_set1_epi8(0x0f);
+	while(length >= 16) {
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+		const __m128i low = _mm_shuffle_epi8(reversed_nibbles, _mm_and_si128(bytes, low_mask));
+		const __m128i high = _mm_shuffle_epi8(reversed_nibbles, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(data), _mm_or_si128(_mm_slli_epi16(low, 4), high));
+		data += 16;
+		length -= 16;
+	}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	while(length >= 16) {
+		vst1q_u8(data, vrbitq_u8(vld1q_u8(data)));
+		data += 16;
+		length -= 16;
+	}
+#endif
+
+	while(length--) {
+		*data = Numeric::bit_reverse(*data);
+		++data;
 	}
 }
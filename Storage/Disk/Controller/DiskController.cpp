@@ -8,6 +8,8 @@
 
 #include "DiskController.hpp"
 
+#include <cmath>
+
 using namespace Storage::Disk;
 
 Controller::Controller(Cycles clock_rate) :
@@ -54,7 +56,17 @@ Drive &Controller::get_drive() {
 
 void Controller::process_event(const Drive::Event &event) {
 	switch(event.type) {
-		case Track::Event::FluxTransition:	pll_.add_pulse();		break;
+		case Track::Event::FluxTransition: {
+			// If this flux transition is from a track with regularly-spaced transitions at very close
+			// to the expected bit length, as is every track encoded from sector contents, then the
+			// PLL can skip phase tracking. Drift of less than 1/32nd of a window per bit can't
+			// misplace a pulse across the short runs of zeroes that FM, MFM and GCR permit.
+			const float uniform_bit_length = get_drive().get_uniform_bit_length();
+			pll_.set_input_is_clean(
+				std::abs(uniform_bit_length - expected_bit_length_) * 32.0f < expected_bit_length_
+			);
+			pll_.add_pulse();
+		} break;
 		case Track::Event::IndexHole:		process_index_hole();	break;
 	}
 }
@@ -72,6 +84,7 @@ void Controller::process_write_completed() {
 void Controller::set_expected_bit_length(Time bit_length) {
 	bit_length_ = bit_length;
 	bit_length_.simplify();
+	expected_bit_length_ = bit_length_.get<float>();
 
 	Time cycles_per_bit = Storage::Time(int(clock_rate_)) * bit_length;
 	cycles_per_bit.simplify();
@@ -91,6 +91,14 @@ class Controller:
 		*/
 		virtual void process_write_completed() override;
 
+		/*!
+			May be overridden by subclasses; indicates whether the controller currently has any interest in
+			the bits that the PLL recognises. If not then the drive will announce only index holes.
+		*/
+		virtual bool is_listening() const override {
+			return true;
+		}
+
 		/*!
 			Puts the controller and the drive returned by get_drive() into write mode, supplying to
 			the drive the current bit length.
@@ -139,6 +147,7 @@ class Controller:
 
 	private:
 		Time bit_length_;
+		float expected_bit_length_ = 0.0f;
 		Cycles::IntType clock_rate_multiplier_ = 1;
 		Cycles::IntType clock_rate_ = 1;
 
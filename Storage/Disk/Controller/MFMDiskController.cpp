@@ -9,6 +9,8 @@
 #include "MFMDiskController.hpp"
 
 #include "../Encodings/MFM/Constants.hpp"
+#include "../Encodings/MFM/SegmentParser.hpp"
+#include "../Track/TrackSerialiser.hpp"
 
 using namespace Storage::Disk;
 
@@ -39,6 +41,55 @@ bool MFMController::get_is_double_density() {
 	return is_double_density_;
 }
 
+void MFMController::set_is_fast_sector_access_enabled(bool enabled) {
+	is_fast_sector_access_enabled_ = enabled;
+	if(!enabled) {
+		sectors_track_ = nullptr;
+		sectors_drive_ = nullptr;
+		track_sectors_.clear();
+	}
+}
+
+bool MFMController::get_is_fast_sector_access_enabled() const {
+	return is_fast_sector_access_enabled_;
+}
+
+void MFMController::set_is_fast_mechanics_enabled(bool enabled) {
+	is_fast_mechanics_enabled_ = enabled;
+}
+
+bool MFMController::get_is_fast_mechanics_enabled() const {
+	return is_fast_mechanics_enabled_;
+}
+
+const std::map<std::size_t, Storage::Encodings::MFM::Sector> &MFMController::get_track_sectors() {
+	// Writes patch the existing track in place, so a matching pointer isn't enough to
+	// show that the track is unchanged; also compare the drive's count of writes.
+	auto &drive = get_drive();
+	const auto track = drive.get_track_under_head();
+	if(
+		track != sectors_track_ ||
+		&drive != sectors_drive_ ||
+		drive.get_write_count() != sectors_write_count_ ||
+		is_double_density_ != sectors_are_double_density_
+	) {
+		sectors_track_ = track;
+		sectors_drive_ = &drive;
+		sectors_write_count_ = drive.get_write_count();
+		sectors_are_double_density_ = is_double_density_;
+		track_sectors_.clear();
+
+		if(track) {
+			track_sectors_ = Storage::Encodings::MFM::sectors_from_segment(
+				Storage::Disk::track_serialisation(
+					*track,
+					is_double_density_ ? Storage::Encodings::MFM::MFMBitLength : Storage::Encodings::MFM::FMBitLength),
+				is_double_density_);
+		}
+	}
+	return track_sectors_;
+}
+
 void MFMController::set_data_mode(DataMode mode) {
 	data_mode_ = mode;
 	shifter_.set_should_obey_syncs(mode == DataMode::Scanning);
@@ -12,8 +12,12 @@
 #include "DiskController.hpp"
 #include "../../../Numeric/CRC.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../Encodings/MFM/Sector.hpp"
 #include "../Encodings/MFM/Shifter.hpp"
 
+#include <map>
+#include <memory>
+
 namespace Storage {
 namespace Disk {
 
@@ -32,6 +36,36 @@ class MFMController: public Controller {
 		/// @returns @c true if currently decoding MFM content; @c false otherwise.
 		bool get_is_double_density();
 
+		/*!
+			Enables or disables fast sector access, in which subclasses may satisfy sector reads from
+			a decoded copy of the track under the head rather than waiting for the disk to rotate.
+
+			This is not a realistic controller behaviour; it's for the benefit of user-optional
+			fast-loading mechanisms only.
+		*/
+		void set_is_fast_sector_access_enabled(bool);
+
+		/// @returns @c true if fast sector access is enabled; @c false otherwise.
+		bool get_is_fast_sector_access_enabled() const;
+
+		/*!
+			Enables or disables fast mechanics, in which subclasses collapse seeking, head settling and
+			motor spin-up to a minimal delay. Data continues to be read and written in real time.
+
+			Like fast sector access, this is not a realistic controller behaviour.
+		*/
+		void set_is_fast_mechanics_enabled(bool);
+
+		/// @returns @c true if fast mechanics are enabled; @c false otherwise.
+		bool get_is_fast_mechanics_enabled() const;
+
+		/*!
+			@returns All sectors found on the track currently under the head at the current density,
+			keyed by their bit position after the index hole. Results are cached until the track changes
+			or is written to.
+		*/
+		const std::map<std::size_t, Encodings::MFM::Sector> &get_track_sectors();
+
 		enum DataMode {
 			/// When the controller is scanning it will obey all synchronisation marks found, even if in the middle of data.
 			Scanning,
@@ -164,6 +198,17 @@ class MFMController: public Controller {
 
 		// CRC generator
 		CRC::CCITT crc_generator_;
+
+		// Fast sector access.
+		bool is_fast_sector_access_enabled_ = false;
+		std::shared_ptr<Track> sectors_track_;
+		const Drive *sectors_drive_ = nullptr;
+		uint64_t sectors_write_count_ = 0;
+		bool sectors_are_double_density_ = false;
+		std::map<std::size_t, Encodings::MFM::Sector> track_sectors_;
+
+		// Fast mechanics.
+		bool is_fast_mechanics_enabled_ = false;
 };
 
 }
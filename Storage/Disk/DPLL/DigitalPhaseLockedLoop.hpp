@@ -41,6 +41,19 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 			window_length_ = clocks_per_bit_ = clocks_per_bit;
 		}
 
+		/*!
+			Indicates whether input is known to be clean, i.e. every pulse falls in the centre of a window
+			of the expected length, as it will on a track encoded from sector contents.
+
+			Clean input needs no tracking: the window is held at the expected length and each pulse
+			simply recentres the phase, skipping the averaging otherwise applied to every pulse.
+		*/
+		void set_input_is_clean(bool input_is_clean) {
+			if(input_is_clean == input_is_clean_) return;
+			input_is_clean_ = input_is_clean;
+			if(input_is_clean_) window_length_ = clocks_per_bit_;
+		}
+
 		/*!
 			Runs the loop, impliedly posting no pulses during that period.
 
@@ -69,7 +82,11 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 			if(!window_was_filled_) {
 				bit_handler_.digital_phase_locked_loop_output_bit(1);
 				window_was_filled_ = true;
-				post_phase_offset(phase_, offset_);
+				if(input_is_clean_) {
+					phase_ = window_length_ >> 1;
+				} else {
+					post_phase_offset(phase_, offset_);
+				}
 				offset_ = 0;
 			}
 		}
@@ -129,6 +146,7 @@ template <typename BitHandler, size_t length_of_history = 3> class DigitalPhaseL
 		bool window_was_filled_ = false;
 
 		int clocks_per_bit_ = 0;
+		bool input_is_clean_ = false;
 };
 
 }
@@ -9,8 +9,12 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <algorithm>
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
@@ -77,10 +81,100 @@ class DiskImage {
 };
 
 class DiskImageHolderBase: public Disk {
+	public:
+		static constexpr size_t DefaultTrackCacheLimit = 64;
+
+		/*!
+			Sets the maximum number of decoded tracks to retain. Beyond that the least-recently
+			used are discarded, other than any with changes not yet passed to the disk image.
+		*/
+		void set_track_cache_limit(size_t limit) {
+			track_cache_limit_ = std::max(limit, size_t(1));
+			evict_tracks();
+		}
+
 	protected:
 		std::set<Track::Address> unwritten_tracks_;
-		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
-		std::unique_ptr<Concurrency::AsyncTaskQueue<true>> update_queue_;
+		std::unique_ptr<Concurrency::AsyncTaskQueue<false>> update_queue_;
+
+		// Tracks adjacent to the most recently-requested one are decoded in advance on the
+		// update queue; image_mutex_ serialises access to the underlying disk image between
+		// that queue and the caller, and prefetch_mutex_ guards both prefetched_tracks_ and
+		// writes_in_flight_, the tracks that have been flushed but not yet written.
+		Track::Address last_requested_address_{-1, HeadPosition(0)};
+		std::set<Track::Address> prefetch_requests_;
+		std::map<Track::Address, std::shared_ptr<Track>> prefetched_tracks_;
+		std::set<Track::Address> writes_in_flight_;
+		std::mutex prefetch_mutex_;
+		std::mutex image_mutex_;
+
+		/// @returns A track that has been prefetched for @c address, if any; @c nullptr otherwise.
+		std::shared_ptr<Track> take_prefetched_track(Track::Address address) {
+			std::lock_guard lock_guard(prefetch_mutex_);
+			const auto prefetched = prefetched_tracks_.find(address);
+			if(prefetched == prefetched_tracks_.end()) return nullptr;
+
+			auto track = std::move(prefetched->second);
+			prefetched_tracks_.erase(prefetched);
+			return track;
+		}
+
+		/// @returns The cached track for @c address, if any, marking it as most-recently used; @c nullptr otherwise.
+		std::shared_ptr<Track> cached_track(Track::Address address) {
+			const auto cached = cached_tracks_.find(address);
+			if(cached == cached_tracks_.end()) return nullptr;
+
+			recency_.splice(recency_.begin(), recency_, cached->second.recency);
+			return cached->second.track;
+		}
+
+		/// @returns @c true if there is a cached track for @c address; @c false otherwise.
+		bool is_cached(Track::Address address) const {
+			return cached_tracks_.find(address) != cached_tracks_.end();
+		}
+
+		/// Caches @c track as the most-recently used, evicting others if that exceeds the limit.
+		void cache_track(Track::Address address, const std::shared_ptr<Track> &track) {
+			const auto cached = cached_tracks_.find(address);
+			if(cached != cached_tracks_.end()) {
+				cached->second.track = track;
+				recency_.splice(recency_.begin(), recency_, cached->second.recency);
+				return;
+			}
+
+			recency_.push_front(address);
+			cached_tracks_.emplace(address, CachedTrack{track, recency_.begin()});
+			evict_tracks();
+		}
+
+	private:
+		struct CachedTrack {
+			std::shared_ptr<Track> track;
+			std::list<Track::Address>::iterator recency;
+		};
+		std::unordered_map<Track::Address, CachedTrack, Track::Address::Hash> cached_tracks_;
+		std::list<Track::Address> recency_;		// Most-recently used first.
+		size_t track_cache_limit_ = DefaultTrackCacheLimit;
+
+		void evict_tracks() {
+			if(cached_tracks_.size() <= track_cache_limit_) return;
+
+			// Work from least- towards most-recently used, never evicting the most recent.
+			std::lock_guard lock_guard(prefetch_mutex_);
+			auto candidate = recency_.end();
+			while(cached_tracks_.size() > track_cache_limit_) {
+				--candidate;
+				if(candidate == recency_.begin()) break;
+				if(unwritten_tracks_.count(*candidate) || writes_in_flight_.count(*candidate)) continue;
+
+				// Also discard any prefetch of this track; one that landed while it was cached may be
+				// from before it was last written.
+				cached_tracks_.erase(*candidate);
+				prefetched_tracks_.erase(*candidate);
+				prefetch_requests_.erase(*candidate);
+				candidate = recency_.erase(candidate);
+			}
+		}
 };
 
 /*!
@@ -108,6 +202,9 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase, public
 	private:
 		T disk_image_;
 
+		/// Schedules decoding of the tracks either side of, and on the other surfaces at, @c address.
+		void prefetch_around(Track::Address address);
+
 		TargetPlatform::Type target_platform_type() final {
 			if constexpr (std::is_base_of<TargetPlatform::TypeDistinguisher, T>::value) {
 				return static_cast<TargetPlatform::TypeDistinguisher *>(&disk_image_)->target_platform_type();
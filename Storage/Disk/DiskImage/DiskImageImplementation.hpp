@@ -20,18 +20,29 @@ template <typename T> bool DiskImageHolder<T>::get_is_read_only() {
 
 template <typename T> void DiskImageHolder<T>::flush_tracks() {
 	if(!unwritten_tracks_.empty()) {
-		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue<true>>();
+		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue<false>>(Concurrency::ThreadRole::Storage);
 
 		using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
 		std::shared_ptr<TrackMap> track_copies(new TrackMap);
 		for(const auto &address : unwritten_tracks_) {
-			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address]->clone())));
+			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_track(address)->clone())));
+		}
+		{
+			std::lock_guard lock_guard(prefetch_mutex_);
+			writes_in_flight_.insert(unwritten_tracks_.begin(), unwritten_tracks_.end());
 		}
 		unwritten_tracks_.clear();
 
 		update_queue_->enqueue([this, track_copies]() {
+			std::lock_guard lock_guard(image_mutex_);
 			disk_image_.set_tracks(*track_copies);
+
+			std::lock_guard prefetch_lock_guard(prefetch_mutex_);
+			for(const auto &track: *track_copies) {
+				writes_in_flight_.erase(track.first);
+			}
 		});
+		update_queue_->perform();
 	}
 }
 
@@ -39,22 +50,77 @@ template <typename T> void DiskImageHolder<T>::set_track_at_position(Track::Addr
 	if(disk_image_.get_is_read_only()) return;
 
 	unwritten_tracks_.insert(address);
-	cached_tracks_[address] = track;
+	cache_track(address, track);
 }
 
 template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_position(Track::Address address) {
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position >= get_maximum_head_position()) return nullptr;
 
-	auto cached_track = cached_tracks_.find(address);
-	if(cached_track != cached_tracks_.end()) return cached_track->second;
+	// If the head has moved, start decoding wherever it's likely to go next.
+	if(address != last_requested_address_) {
+		last_requested_address_ = address;
+		prefetch_around(address);
+	}
 
-	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
+	if(auto track = cached_track(address)) return track;
+
+	// Use a prefetched track if one is ready; otherwise decode the track now, having
+	// acquired the image from the prefetcher and checked whether it just finished this track.
+	std::shared_ptr<Track> track = take_prefetched_track(address);
+	if(!track) {
+		std::lock_guard lock_guard(image_mutex_);
+		track = take_prefetched_track(address);
+		if(!track) track = disk_image_.get_track_at_position(address);
+	}
+	prefetch_requests_.erase(address);
 	if(!track) return nullptr;
-	cached_tracks_[address] = track;
+	cache_track(address, track);
 	return track;
 }
 
+template <typename T> void DiskImageHolder<T>::prefetch_around(Track::Address address) {
+	std::vector<Track::Address> targets;
+	const int whole_position = address.position.as_int();
+	targets.emplace_back(address.head, HeadPosition(whole_position + 1));
+	targets.emplace_back(address.head, HeadPosition(whole_position - 1));
+
+	const int head_count = get_head_count();
+	for(int head = 0; head < head_count; ++head) {
+		if(head != address.head) targets.emplace_back(head, address.position);
+	}
+
+	// Discard anything prefetched previously that is no longer nearby.
+	{
+		std::lock_guard lock_guard(prefetch_mutex_);
+		for(auto prefetched = prefetched_tracks_.begin(); prefetched != prefetched_tracks_.end();) {
+			if(std::find(targets.begin(), targets.end(), prefetched->first) == targets.end()) {
+				prefetch_requests_.erase(prefetched->first);
+				prefetched = prefetched_tracks_.erase(prefetched);
+			} else {
+				++prefetched;
+			}
+		}
+	}
+
+	for(const auto &target: targets) {
+		if(target.position < HeadPosition(0) || target.position >= get_maximum_head_position()) continue;
+		if(is_cached(target)) continue;
+		if(!prefetch_requests_.insert(target).second) continue;
+
+		if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue<false>>(Concurrency::ThreadRole::Storage);
+		update_queue_->enqueue([this, target]() {
+			std::lock_guard lock_guard(image_mutex_);
+			auto track = disk_image_.get_track_at_position(target);
+
+			std::lock_guard prefetch_lock_guard(prefetch_mutex_);
+			prefetched_tracks_[target] = std::move(track);
+		});
+	}
+
+	if(update_queue_) update_queue_->perform();
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
 	if(update_queue_) update_queue_->flush();
 }
@@ -12,6 +12,7 @@
 #include "../../Track/TrackSerialiser.hpp"
 #include "../../Encodings/AppleGCR/Encoder.hpp"
 #include "../../Encodings/AppleGCR/SegmentParser.hpp"
+#include "Utility/SectorWrites.hpp"
 
 #include <cstring>
 
@@ -97,27 +98,34 @@ std::shared_ptr<Track> AppleDSK::get_track_at_position(Track::Address address) {
 }
 
 void AppleDSK::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
-	std::map<Track::Address, std::vector<uint8_t>> tracks_by_address;
+	struct DecodedTrack {
+		std::vector<uint8_t> contents;
+		std::vector<bool> found;
+	};
+	std::map<Track::Address, DecodedTrack> tracks_by_address;
 	for(const auto &pair: tracks) {
 		// Decode the track.
 		const auto serialistion = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
 		const auto sector_map = Storage::Encodings::AppleGCR::sectors_from_segment(serialistion);
 
 		// Rearrange sectors into Apple DOS or Pro-DOS order.
-		std::vector<uint8_t> track_contents(size_t(bytes_per_sector * sectors_per_track_));
+		DecodedTrack track;
+		track.contents.resize(size_t(bytes_per_sector * sectors_per_track_));
+		track.found.resize(size_t(sectors_per_track_), false);
 		for(const auto &sector_pair: sector_map) {
 			const size_t target_address = logical_sector_for_physical_sector(sector_pair.second.address.sector);
-			memcpy(&track_contents[target_address*256], sector_pair.second.data.data(), bytes_per_sector);
+			if(target_address >= track.found.size() || sector_pair.second.data.size() < size_t(bytes_per_sector)) continue;
+			memcpy(&track.contents[target_address*256], sector_pair.second.data.data(), bytes_per_sector);
+			track.found[target_address] = true;
 		}
 
 		// Store for later.
-		tracks_by_address[pair.first] = std::move(track_contents);
+		tracks_by_address[pair.first] = std::move(track);
 	}
 
-	// Grab the file lock and write out the new tracks.
+	// Grab the file lock and write out whichever sectors have changed.
 	std::lock_guard lock_guard(file_.get_file_access_mutex());
 	for(const auto &pair: tracks_by_address) {
-		file_.seek(file_offset(pair.first), SEEK_SET);
-		file_.write(pair.second);
+		write_changed_sectors(file_, file_offset(pair.first), pair.second.contents.data(), bytes_per_sector, pair.second.found);
 	}
 }
@@ -123,17 +123,11 @@ std::shared_ptr<Track> D64::get_track_at_position(Track::Address address) {
 			0x07, source_data[0], source_data[1], source_data[2]
 		};
 		Encodings::CommodoreGCR::encode_block(&sector_data[24], start_of_data);
-		int source_data_offset = 3;
-		int target_data_offset = 29;
-		while((source_data_offset+4) < 256) {
-			Encodings::CommodoreGCR::encode_block(&sector_data[target_data_offset], &source_data[source_data_offset]);
-			target_data_offset += 5;
-			source_data_offset += 4;
-		}
+		Encodings::CommodoreGCR::encode_blocks(&sector_data[29], &source_data[3], 63);
 		uint8_t end_of_data[4] = {
 			source_data[255], checksum, 0, 0
 		};
-		Encodings::CommodoreGCR::encode_block(&sector_data[target_data_offset], end_of_data);
+		Encodings::CommodoreGCR::encode_block(&sector_data[344], end_of_data);
 	}
 
 	return std::make_shared<PCMTrack>(PCMSegment(data));
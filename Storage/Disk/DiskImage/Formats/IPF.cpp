@@ -36,7 +36,7 @@ size_t block_size(Storage::FileHolder &file, uint8_t header) {
 
 }
 
-IPF::IPF(const std::string &file_name) : file_(file_name) {
+IPF::IPF(const std::string &file_name) : file_(file_name, FileHolder::FileMode::Read), flux_cache_(file_name) {
 	std::map<uint32_t, Track::Address> tracks_by_data_key;
 
 	// For now, just build up a list of tracks that exist, noting the file position at which their data begins
@@ -186,7 +186,18 @@ int IPF::get_head_count() {
 	return head_count_;
 }
 
-std::shared_ptr<Track> IPF::get_track_at_position([[maybe_unused]] Track::Address address) {
+std::shared_ptr<Track> IPF::get_track_at_position(Track::Address address) {
+	// Decoding is expensive, so use the result of a previous run if there is one.
+	if(const auto track = flux_cache_.track(address)) {
+		return track;
+	}
+
+	const auto track = decode_track_at_position(address);
+	flux_cache_.store(address, track);
+	return track;
+}
+
+std::shared_ptr<Track> IPF::decode_track_at_position(Track::Address address) {
 	// Get the track description, if it exists, and check either that the file has contents for the track.
 	auto pair = tracks_.find(address);
 	if(pair == tracks_.end()) {
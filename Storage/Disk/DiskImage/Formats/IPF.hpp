@@ -10,6 +10,7 @@
 #define IPF_hpp
 
 #include "../DiskImage.hpp"
+#include "../../Track/FluxCache.hpp"
 #include "../../Track/PCMTrack.hpp"
 #include "../../../FileHolder.hpp"
 #include "../../../TargetPlatforms.hpp"
@@ -44,7 +45,9 @@ class IPF: public DiskImage, public TargetPlatform::TypeDistinguisher {
 
 	private:
 		Storage::FileHolder file_;
+		FluxCache flux_cache_;
 		uint16_t seek_track(Track::Address address);
+		std::shared_ptr<Track> decode_track_at_position(Track::Address address);
 
 		struct TrackDescription {
 			long file_offset = 0;
@@ -9,6 +9,7 @@
 #include "MFMSectorDump.hpp"
 
 #include "Utility/ImplicitSectors.hpp"
+#include "Utility/SectorWrites.hpp"
 
 using namespace Storage::Disk;
 
@@ -45,13 +46,13 @@ void MFMSectorDump::set_tracks(const std::map<Track::Address, std::shared_ptr<Tr
 
 	for(const auto &track : tracks) {
 		// Assumption here: sector IDs will run from 0.
-		decode_sectors(*track.second, parsed_track, first_sector_, first_sector_ + uint8_t(sectors_per_track_-1), sector_size_, is_double_density_);
+		const auto found = decode_sectors(*track.second, parsed_track, first_sector_, first_sector_ + uint8_t(sectors_per_track_-1), sector_size_, is_double_density_);
 		const long file_offset = get_file_offset_for_position(track.first);
 
+		// Write only those sectors that were both found and modified.
 		std::lock_guard lock_guard(file_.get_file_access_mutex());
-		file_.ensure_is_at_least_length(file_offset);
-		file_.seek(file_offset, SEEK_SET);
-		file_.write(parsed_track, sizeof(parsed_track));
+		file_.ensure_is_at_least_length(file_offset + long(sizeof(parsed_track)));
+		write_changed_sectors(file_, file_offset, parsed_track, size_t(128 << sector_size_), found);
 	}
 	file_.flush();
 }
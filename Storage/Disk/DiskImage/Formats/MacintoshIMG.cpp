@@ -14,6 +14,7 @@
 #include "../../Track/TrackSerialiser.hpp"
 #include "../../Encodings/AppleGCR/Encoder.hpp"
 #include "../../Encodings/AppleGCR/SegmentParser.hpp"
+#include "Utility/SectorWrites.hpp"
 
 /*
 	File format specifications as referenced below are largely
@@ -253,7 +254,11 @@ std::shared_ptr<::Storage::Disk::Track> MacintoshIMG::get_track_at_position(::St
 }
 
 void MacintoshIMG::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
-	std::map<Track::Address, std::vector<uint8_t>> tracks_by_address;
+	struct DecodedTrack {
+		std::vector<uint8_t> contents;
+		std::vector<bool> found;
+	};
+	std::map<Track::Address, DecodedTrack> tracks_by_address;
 	for(const auto &pair: tracks) {
 		// Determine a data rate for the track.
 		const auto included_sectors = Storage::Encodings::AppleGCR::Macintosh::sectors_in_track(pair.first.position.as_int());
@@ -266,54 +271,60 @@ void MacintoshIMG::set_tracks(const std::map<Track::Address, std::shared_ptr<Tra
 			Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, data_rate)));
 
 		// Rearrange sectors into ascending order.
-		std::vector<uint8_t> track_contents(size_t(524 * included_sectors.length));
+		DecodedTrack track;
+		track.contents.resize(size_t(524 * included_sectors.length));
+		track.found.resize(size_t(included_sectors.length), false);
 		for(const auto &sector_pair: sector_map) {
 			const size_t target_address = sector_pair.second.address.sector * 524;
-			if(target_address >= track_contents.size() || sector_pair.second.data.size() != 524) continue;
-			memcpy(&track_contents[target_address], sector_pair.second.data.data(), 524);
+			if(target_address >= track.contents.size() || sector_pair.second.data.size() != 524) continue;
+			memcpy(&track.contents[target_address], sector_pair.second.data.data(), 524);
+			track.found[sector_pair.second.address.sector] = true;
 		}
 
 		// Store for later.
-		tracks_by_address[pair.first] = std::move(track_contents);
+		tracks_by_address[pair.first] = std::move(track);
 	}
 
-	// Grab the buffer mutex and update the in-memory buffer.
+	// Grab the buffer mutex and update the in-memory buffer, noting which sectors and tags change.
+	std::vector<bool> changed_sectors(data_.size() / 512, false);
+	std::vector<bool> changed_tags(tags_.size() / 12, false);
 	{
 		std::lock_guard buffer_lock(buffer_mutex_);
 		for(const auto &pair: tracks_by_address) {
 			const auto included_sectors = Storage::Encodings::AppleGCR::Macintosh::sectors_in_track(pair.first.position.as_int());
 			size_t start_sector = size_t(included_sectors.start * get_head_count() + included_sectors.length * pair.first.head);
 
-			for(int c = 0; c < included_sectors.length; ++c) {
-				const auto sector_plus_tags = &pair.second[size_t(c)*524];
+			for(int c = 0; c < included_sectors.length; ++c, ++start_sector) {
+				// Leave alone any sector that couldn't be found.
+				if(!pair.second.found[size_t(c)]) continue;
+				const auto sector_plus_tags = &pair.second.contents[size_t(c)*524];
 
 				// Copy the 512 bytes that constitute the sector body.
-				memcpy(&data_[start_sector * 512], &sector_plus_tags[12], 512);
+				if(memcmp(&data_[start_sector * 512], &sector_plus_tags[12], 512)) {
+					memcpy(&data_[start_sector * 512], &sector_plus_tags[12], 512);
+					changed_sectors[start_sector] = true;
+				}
 
 				// Copy the tags if this file can store them.
 				// TODO: add tags to a DiskCopy-format image that doesn't have them, if they contain novel content?
-				if(tags_.size()) {
+				if(tags_.size() && memcmp(&tags_[start_sector * 12], sector_plus_tags, 12)) {
 					memcpy(&tags_[start_sector * 12], sector_plus_tags, 12);
+					changed_tags[start_sector] = true;
 				}
-
-				++start_sector;
 			}
 		}
 	}
 
-	// Grab the file lock and write out the new tracks.
+	// Grab the file lock and write out whatever has changed.
 	{
 		std::lock_guard lock_guard(file_.get_file_access_mutex());
 
 		if(!is_diskCopy_file_) {
-			// Just dump out the entire disk. Grossly lazy, possibly worth improving.
-			file_.seek(raw_offset_, SEEK_SET);
-			file_.write(data_);
+			write_sectors(file_, raw_offset_, data_.data(), 512, changed_sectors);
 		} else {
 			// Write out the sectors, and possibly the tags, and update checksums.
-			file_.seek(0x54, SEEK_SET);
-			file_.write(data_);
-			file_.write(tags_);
+			write_sectors(file_, 0x54, data_.data(), 512, changed_sectors);
+			write_sectors(file_, 0x54 + long(data_.size()), tags_.data(), 12, changed_tags);
 
 			const auto data_checksum = checksum(data_);
 			const auto tag_checksum = checksum(tags_, 12);
@@ -389,7 +389,7 @@ class TrackConstructor {
 
 }
 
-STX::STX(const std::string &file_name) : file_(file_name) {
+STX::STX(const std::string &file_name) : file_(file_name, FileHolder::FileMode::Read), flux_cache_(file_name) {
 	// Require that this be a version 3 Pasti.
 	if(!file_.check_signature("RSY", 4)) throw Error::InvalidFormat;
 	if(file_.get16le() != 3) throw Error::InvalidFormat;
@@ -449,6 +449,17 @@ int STX::get_head_count() {
 }
 
 std::shared_ptr<::Storage::Disk::Track> STX::get_track_at_position(::Storage::Disk::Track::Address address) {
+	// Track construction is expensive, so use the result of a previous run if there is one.
+	if(const auto track = flux_cache_.track(address)) {
+		return track;
+	}
+
+	const auto track = decode_track_at_position(address);
+	flux_cache_.store(address, track);
+	return track;
+}
+
+std::shared_ptr<::Storage::Disk::Track> STX::decode_track_at_position(::Storage::Disk::Track::Address address) {
 	// These images have two sides, at most.
 	if(address.head > 1) return nullptr;
 
@@ -10,6 +10,7 @@
 #define STX_hpp
 
 #include "../DiskImage.hpp"
+#include "../../Track/FluxCache.hpp"
 #include "../../../FileHolder.hpp"
 
 namespace Storage {
@@ -36,6 +37,9 @@ class STX: public DiskImage {
 
 	private:
 		FileHolder file_;
+		FluxCache flux_cache_;
+
+		std::shared_ptr<::Storage::Disk::Track> decode_track_at_position(::Storage::Disk::Track::Address address);
 
 		int track_count_;
 		int head_count_;
@@ -45,12 +45,13 @@ std::shared_ptr<Track> Storage::Disk::track_for_sectors(const uint8_t *const sou
 	return nullptr;
 }
 
-void Storage::Disk::decode_sectors(Track &track, uint8_t *const destination, uint8_t first_sector, uint8_t last_sector, uint8_t sector_size, bool is_double_density) {
+std::vector<bool> Storage::Disk::decode_sectors(Track &track, uint8_t *const destination, uint8_t first_sector, uint8_t last_sector, uint8_t sector_size, bool is_double_density) {
 	std::map<std::size_t, Storage::Encodings::MFM::Sector> sectors =
 		Storage::Encodings::MFM::sectors_from_segment(
 			Storage::Disk::track_serialisation(track, is_double_density ? Storage::Encodings::MFM::MFMBitLength : Storage::Encodings::MFM::FMBitLength),
 			is_double_density);
 
+	std::vector<bool> found(size_t(last_sector - first_sector + 1), false);
 	std::size_t byte_size = size_t(128 << sector_size);
 	for(const auto &pair : sectors) {
 		if(pair.second.address.sector > last_sector) continue;
@@ -58,5 +59,7 @@ void Storage::Disk::decode_sectors(Track &track, uint8_t *const destination, uin
 		if(pair.second.size != sector_size) continue;
 		if(pair.second.samples.empty()) continue;
 		std::memcpy(&destination[(pair.second.address.sector - first_sector) * byte_size], pair.second.samples[0].data(), std::min(pair.second.samples[0].size(), byte_size));
+		found[size_t(pair.second.address.sector - first_sector)] = true;
 	}
+	return found;
 }
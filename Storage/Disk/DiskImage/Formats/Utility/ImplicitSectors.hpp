@@ -17,7 +17,14 @@ namespace Storage {
 namespace Disk {
 
 std::shared_ptr<Track> track_for_sectors(const uint8_t *source, int number_of_sectors, uint8_t track, uint8_t side, uint8_t first_sector, uint8_t size, bool is_double_density);
-void decode_sectors(Track &track, uint8_t *destination, uint8_t first_sector, uint8_t last_sector, uint8_t sector_size, bool is_double_density);
+
+/*!
+	Decodes from @c track all sectors numbered from @c first_sector to @c last_sector of size @c sector_size,
+	storing them consecutively at @c destination.
+
+	@returns A flag for each sector in that range indicating whether it was found.
+*/
+std::vector<bool> decode_sectors(Track &track, uint8_t *destination, uint8_t first_sector, uint8_t last_sector, uint8_t sector_size, bool is_double_density);
 
 }
 }
@@ -0,0 +1,45 @@
+//
+//  SectorWrites.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "SectorWrites.hpp"
+
+#include <cstring>
+
+using namespace Storage::Disk;
+
+void Storage::Disk::write_sectors(FileHolder &file, long offset, const uint8_t *source, std::size_t sector_size, const std::vector<bool> &should_write) {
+	std::size_t sector = 0;
+	while(sector < should_write.size()) {
+		if(!should_write[sector]) {
+			++sector;
+			continue;
+		}
+
+		std::size_t end = sector + 1;
+		while(end < should_write.size() && should_write[end]) ++end;
+
+		file.seek(offset + long(sector * sector_size), SEEK_SET);
+		file.write(&source[sector * sector_size], (end - sector) * sector_size);
+		sector = end;
+	}
+}
+
+void Storage::Disk::write_changed_sectors(FileHolder &file, long offset, const uint8_t *source, std::size_t sector_size, std::vector<bool> should_write) {
+	// Compare against the file's current contents; anything that can't be read is assumed to differ.
+	std::vector<uint8_t> existing(sector_size * should_write.size());
+	file.seek(offset, SEEK_SET);
+	const std::size_t existing_sectors = file.read(existing.data(), existing.size()) / sector_size;
+
+	for(std::size_t sector = 0; sector < existing_sectors; ++sector) {
+		if(should_write[sector] && !memcmp(&existing[sector * sector_size], &source[sector * sector_size], sector_size)) {
+			should_write[sector] = false;
+		}
+	}
+
+	write_sectors(file, offset, source, sector_size, should_write);
+}
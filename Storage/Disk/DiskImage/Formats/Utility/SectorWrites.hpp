@@ -0,0 +1,41 @@
+//
+//  SectorWrites.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef SectorWrites_hpp
+#define SectorWrites_hpp
+
+#include "../../../../FileHolder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Storage {
+namespace Disk {
+
+/*!
+	Writes to @c file those of the @c sector_size -byte sectors at @c source for which @c should_write
+	is @c true, each to the corresponding position after @c offset. Runs of adjacent sectors are
+	coalesced into single writes.
+
+	The caller should hold the file's access mutex.
+*/
+void write_sectors(FileHolder &file, long offset, const uint8_t *source, std::size_t sector_size, const std::vector<bool> &should_write);
+
+/*!
+	As per @c write_sectors, but first discards from @c should_write any sector whose contents are
+	already present in @c file.
+
+	The caller should hold the file's access mutex.
+*/
+void write_changed_sectors(FileHolder &file, long offset, const uint8_t *source, std::size_t sector_size, std::vector<bool> should_write);
+
+}
+}
+
+#endif /* SectorWrites_hpp */
@@ -37,12 +37,15 @@ WOZ::WOZ(const std::string &file_name) :
 	// Get the file's CRC32.
 	const uint32_t crc = file_.get32le();
 
-	// Get the collection of all data that contributes to the CRC.
-	post_crc_contents_ = file_.read(size_t(file_.stats().st_size - 12));
-
-	// Test the CRC.
-	const uint32_t computed_crc = crc_generator.compute_crc(post_crc_contents_);
-	if(crc != computed_crc) {
+	// Test the CRC, streaming through the remainder of the file rather than retaining it;
+	// track contents are read only upon request.
+	crc_generator.reset();
+	uint8_t buffer[4096];
+	size_t length;
+	while((length = file_.read(buffer, sizeof(buffer))) > 0) {
+		crc_generator.add(buffer, length);
+	}
+	if(crc != crc_generator.get_value()) {
 		 throw Error::InvalidFormat;
 	}
 
@@ -185,33 +188,37 @@ std::shared_ptr<Track> WOZ::get_track_at_position(Track::Address address) {
 void WOZ::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
 	if(type_ == Type::WOZ2) return;
 
+	// Grab the file lock, then get the collection of all data that contributes to the CRC.
+	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	file_.seek(12, SEEK_SET);
+	std::vector<uint8_t> post_crc_contents = file_.read(size_t(file_.stats().st_size - 12));
+
 	for(const auto &pair: tracks) {
-		// Decode the track and store, patching into the post_crc_contents_.
+		// Decode the track and store, patching into the post_crc_contents.
 		auto segment = Storage::Disk::track_serialisation(*pair.second, Storage::Time(1, 50000));
 
 		auto offset = size_t(file_offset(pair.first) - 12);
 		std::vector<uint8_t> segment_bytes = segment.byte_data();
-		memcpy(&post_crc_contents_[offset - 12], segment_bytes.data(), segment_bytes.size());
+		memcpy(&post_crc_contents[offset - 12], segment_bytes.data(), segment_bytes.size());
 
 		// Write number of bytes and number of bits.
-		post_crc_contents_[offset + 6646] = uint8_t(segment.data.size() >> 3);
-		post_crc_contents_[offset + 6647] = uint8_t(segment.data.size() >> 11);
-		post_crc_contents_[offset + 6648] = uint8_t(segment.data.size());
-		post_crc_contents_[offset + 6649] = uint8_t(segment.data.size() >> 8);
+		post_crc_contents[offset + 6646] = uint8_t(segment.data.size() >> 3);
+		post_crc_contents[offset + 6647] = uint8_t(segment.data.size() >> 11);
+		post_crc_contents[offset + 6648] = uint8_t(segment.data.size());
+		post_crc_contents[offset + 6649] = uint8_t(segment.data.size() >> 8);
 
 		// Set no splice information now provided, since it's been lost if ever it was known.
-		post_crc_contents_[offset + 6650] = 0xff;
-		post_crc_contents_[offset + 6651] = 0xff;
+		post_crc_contents[offset + 6650] = 0xff;
+		post_crc_contents[offset + 6651] = 0xff;
 	}
 
 	// Calculate the new CRC.
-	const uint32_t crc = crc_generator.compute_crc(post_crc_contents_);
+	const uint32_t crc = crc_generator.compute_crc(post_crc_contents);
 
-	// Grab the file lock, then write the CRC, then just dump the entire file buffer.
-	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	// Write the CRC, then just dump the entire file buffer.
 	file_.seek(8, SEEK_SET);
 	file_.put_le(crc);
-	file_.write(post_crc_contents_);
+	file_.write(post_crc_contents);
 }
 
 bool WOZ::get_is_read_only() {
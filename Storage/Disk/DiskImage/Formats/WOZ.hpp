@@ -43,7 +43,6 @@ class WOZ: public DiskImage {
 		uint8_t track_map_[160];
 		long tracks_offset_ = -1;
 
-		std::vector<uint8_t> post_crc_contents_;
 		CRC::CRC32 crc_generator;
 
 		/*!
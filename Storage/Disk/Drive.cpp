@@ -14,6 +14,7 @@
 #include <cassert>
 #include <cmath>
 #include <chrono>
+#include <limits>
 #include <random>
 
 using namespace Storage::Disk;
@@ -119,6 +120,10 @@ std::shared_ptr<Track> Drive::step_to(HeadPosition offset) {
 	return track_;
 }
 
+std::shared_ptr<Track> Drive::get_track_under_head() {
+	return get_track();
+}
+
 void Drive::set_head(int head) {
 	head = std::min(head, available_heads_ - 1);
 	if(head != head_) {
@@ -217,26 +222,30 @@ void Drive::run_for(const Cycles cycles) {
 
 	if(disk_is_rotating_) {
 		if(has_disk_) {
-			Time zero(0);
-
 			auto number_of_cycles = cycles.as_integral();
+			if(!is_listening()) {
+				run_unobserved(number_of_cycles);
+			}
+			if(number_of_cycles) {
+				resume_listening();
+			}
+
 			while(number_of_cycles) {
 				auto cycles_until_next_event = get_cycles_until_next_event();
 				auto cycles_to_run_for = std::min(cycles_until_next_event, number_of_cycles);
-				if(!is_reading_ && cycles_until_bits_written_ > zero) {
-					auto write_cycles_target = cycles_until_bits_written_.get<Cycles::IntType>();
-					if(cycles_until_bits_written_.length % cycles_until_bits_written_.clock_rate) ++write_cycles_target;
+				if(!is_reading_ && cycles_until_bits_written_ > FixedTime()) {
+					const auto write_cycles_target = Cycles::IntType(cycles_until_bits_written_.ceiling());
 					cycles_to_run_for = std::min(cycles_to_run_for, write_cycles_target);
 				}
 
 				number_of_cycles -= cycles_to_run_for;
 				if(!is_reading_) {
-					if(cycles_until_bits_written_ > zero) {
-						Storage::Time cycles_to_run_for_time(static_cast<int>(cycles_to_run_for));
+					if(cycles_until_bits_written_ > FixedTime()) {
+						const auto cycles_to_run_for_time = FixedTime::from_value(uint64_t(cycles_to_run_for) << FixedTime::FractionalBits);
 						if(cycles_until_bits_written_ <= cycles_to_run_for_time) {
 							if(event_delegate_) event_delegate_->process_write_completed();
 							if(cycles_until_bits_written_ <= cycles_to_run_for_time)
-								cycles_until_bits_written_.set_zero();
+								cycles_until_bits_written_ = FixedTime();
 							else
 								cycles_until_bits_written_ -= cycles_to_run_for_time;
 						} else {
@@ -252,6 +261,56 @@ void Drive::run_for(const Cycles cycles) {
 	}
 }
 
+Cycles::IntType Drive::cycles_until_next_change() const {
+	auto result = std::numeric_limits<Cycles::IntType>::max();
+
+	// A motor transition takes effect at the start of the call in which it falls due, so must be
+	// preceded by a separate call.
+	if(time_until_motor_transition > Cycles(0)) {
+		result = time_until_motor_transition.as_integral() - 1;
+	}
+	if(disk_is_rotating_) {
+		result = std::min(result, get_cycles_until_next_event());
+	}
+	return std::max(result, Cycles::IntType(1));
+}
+
+bool Drive::is_listening() const {
+	// Writing always proceeds bit by bit, so that completion can be signalled.
+	return !is_reading_ || (event_delegate_ && event_delegate_->is_listening());
+}
+
+void Drive::run_unobserved(Cycles::IntType &number_of_cycles) {
+	// With nobody interested in flux transitions, just count down to each index hole in turn,
+	// stopping early if the delegate's interest is piqued by one.
+	was_listening_ = false;
+	while(number_of_cycles) {
+		const auto cycles_until_index_hole = std::max(Cycles::IntType(cycles_per_revolution_) - cycles_since_index_hole_, Cycles::IntType(0));
+		const auto cycles_to_run_for = std::min(number_of_cycles, cycles_until_index_hole);
+		number_of_cycles -= cycles_to_run_for;
+		cycles_since_index_hole_ += cycles_to_run_for;
+		if(cycles_since_index_hole_ < cycles_per_revolution_) break;
+
+		post_index_hole();
+		if(event_delegate_) {
+			Event index_hole;
+			index_hole.type = Track::Event::IndexHole;
+			event_delegate_->process_event(index_hole);
+		}
+		if(is_listening()) break;
+	}
+}
+
+void Drive::resume_listening() {
+	if(was_listening_) return;
+
+	// Pick up the track again from the current rotational position.
+	was_listening_ = true;
+	reset_timer();
+	invalidate_track();
+	get_next_event(0.0f);
+}
+
 // MARK: - Track timed event loop
 
 void Drive::get_next_event(float duration_already_passed) {
@@ -322,14 +381,7 @@ void Drive::get_next_event(float duration_already_passed) {
 
 void Drive::process_next_event() {
 	if(current_event_.type == Track::Event::IndexHole) {
-		++ready_index_count_;
-		if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
-			is_ready_ = true;
-		}
-		cycles_since_index_hole_ = 0;
-
-		// Begin a 2ms period of holding the index line pulse active.
-		index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+		post_index_hole();
 	}
 	if(
 		event_delegate_ &&
@@ -340,6 +392,17 @@ void Drive::process_next_event() {
 	get_next_event(0.0f);
 }
 
+void Drive::post_index_hole() {
+	++ready_index_count_;
+	if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
+		is_ready_ = true;
+	}
+	cycles_since_index_hole_ = 0;
+
+	// Begin a 2ms period of holding the index line pulse active.
+	index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+}
+
 // MARK: - Track management
 
 std::shared_ptr<Track> Drive::get_track() {
@@ -356,6 +419,7 @@ void Drive::setup_track() {
 	if(!track_) {
 		track_ = std::make_shared<UnformattedTrack>();
 	}
+	uniform_bit_count_ = track_->get_uniform_bit_count();
 
 	float offset = 0.0f;
 	const float track_time_now = get_time_into_track();
@@ -376,6 +440,7 @@ void Drive::setup_track() {
 void Drive::invalidate_track() {
 	random_interval_ = 0.0f;
 	track_ = nullptr;
+	uniform_bit_count_ = 0;
 	if(patched_track_) {
 		set_track(patched_track_);
 		patched_track_ = nullptr;
@@ -388,6 +453,7 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	// Do nothing if already writing.
 	// TODO: cope properly if there's no disk to write to.
 	if(!is_reading_ || !disk_) return;
+	resume_listening();
 
 	// Get a copy of the track if that hasn't happened yet.
 	if(!track_) {
@@ -398,8 +464,9 @@ void Drive::begin_writing(Time bit_length, bool clamp_to_index_hole) {
 	is_reading_ = false;
 	clamp_writing_to_index_hole_ = clamp_to_index_hole;
 
-	cycles_per_bit_ = Storage::Time(int(get_input_clock_rate())) * bit_length;
-	cycles_per_bit_.simplify();
+	Time cycles_per_bit = Storage::Time(int(get_input_clock_rate())) * bit_length;
+	cycles_per_bit.simplify();
+	cycles_per_bit_ = FixedTime(cycles_per_bit);
 
 	write_segment_.length_of_a_bit = bit_length / Time(rotational_multiplier_);
 	write_segment_.data.clear();
@@ -434,6 +501,7 @@ void Drive::end_writing() {
 		patched_track_->add_segment(write_start_time_, write_segment_, clamp_writing_to_index_hole_);
 		cycles_since_index_hole_ %= cycles_per_revolution_;
 		invalidate_track();
+		++write_count_;
 	}
 }
 
@@ -441,6 +509,10 @@ bool Drive::is_writing() const {
 	return !is_reading_;
 }
 
+uint64_t Drive::get_write_count() const {
+	return write_count_;
+}
+
 void Drive::set_disk_is_rotating(bool is_rotating) {
 	disk_is_rotating_ = is_rotating;
 
@@ -129,13 +129,26 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		bool is_writing() const;
 
+		/*!
+			@returns The number of writes this drive has completed. A write modifies the track under the
+			head in place, so anything that caches an interpretation of a track should compare this too.
+		*/
+		uint64_t get_write_count() const;
+
 		/*!
 			Advances the drive by @c number_of_cycles cycles.
 		*/
 		void run_for(const Cycles cycles);
 
+		/*!
+			@returns A number of cycles, at least 1, for which this drive could be run in a single call to @c run_for
+				with exactly the same outcome as if it were run for one cycle at a time: no event will be posted
+				to the delegate before the final cycle, and the motor won't start or stop.
+		*/
+		Cycles::IntType cycles_until_next_change() const;
+
 		struct Event {
-			Track::Event::Type type;
+			Track::Event::Type type = Track::Event::IndexHole;
 			float length = 0.0f;
 		} current_event_;
 
@@ -155,6 +168,13 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 			/// Informs the delegate of the passing of @c cycles.
 			virtual void advance([[maybe_unused]] Cycles cycles) {}
+
+			/*!
+				@returns @c true if the delegate currently has any use for flux transitions; @c false otherwise.
+				While the delegate is not listening, the drive tracks only its rotational position, posting
+				index holes but no other events and making no calls to @c advance.
+			*/
+			virtual bool is_listening() const { return true; }
 		};
 
 		/// Sets the current event delegate.
@@ -178,6 +198,15 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		std::shared_ptr<Track> step_to(HeadPosition offset);
 
+		/*!
+			@returns The track currently under the head, if there is a disk and it has a track there;
+			@c nullptr otherwise.
+
+			As per @c step_to, this is **NOT FOR HARDWARE EMULATION USAGE**; it's for the benefit
+			of user-optional fast-loading mechanisms **ONLY**.
+		*/
+		std::shared_ptr<Track> get_track_under_head();
+
 		/*!
 			Alters the rotational velocity of this drive.
 		*/
@@ -188,6 +217,14 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		*/
 		bool get_tachometer() const;
 
+		/*!
+			@returns The length of a bit window in seconds if the track currently under the head
+			has all flux transitions in the centres of equal-length windows; 0 otherwise.
+		*/
+		float get_uniform_bit_length() const {
+			return uniform_bit_count_ ? rotational_multiplier_ / float(uniform_bit_count_) : 0.0f;
+		}
+
 	protected:
 		/*!
 			Announces the result of a step.
@@ -214,6 +251,9 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		std::shared_ptr<Track> track_;
 		bool has_disk_ = false;
 
+		// The track's uniform bit count, if any, cached whenever a new track is obtained.
+		size_t uniform_bit_count_ = 0;
+
 		// Contains the multiplier that converts between track-relative lengths
 		// to real-time lengths. So it's the reciprocal of rotation speed.
 		float rotational_multiplier_ = 1.0f;
@@ -249,6 +289,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		// If writing is occurring then the drive will be accumulating a write segment,
 		// for addition to a (high-resolution) PCM track.
 		std::shared_ptr<PCMTrack> patched_track_;
+		uint64_t write_count_ = 0;
 		PCMSegment write_segment_;
 		Time write_start_time_;
 
@@ -259,8 +300,8 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// Maintains appropriate counting to know when to indicate that writing
 		// is complete.
-		Time cycles_until_bits_written_;
-		Time cycles_per_bit_;
+		FixedTime cycles_until_bits_written_;
+		FixedTime cycles_per_bit_;
 
 		// TimedEventLoop call-ins and state.
 		void process_next_event() override;
@@ -273,6 +314,16 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		// The target (if any) for track events.
 		EventDelegate *event_delegate_ = nullptr;
 
+		// Indicates whether flux transitions were being timed as of the most recent call to run_for;
+		// if not then the event loop will need to be resynchronised with the track before it is next used.
+		bool was_listening_ = true;
+		bool is_listening() const;
+		void run_unobserved(Cycles::IntType &number_of_cycles);
+		void resume_listening();
+
+		// Performs the bookkeeping associated with passing the index hole.
+		void post_index_hole();
+
 		/*!
 			@returns the track underneath the current head at the location now stepped to.
 		*/
@@ -293,7 +344,7 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// A rotating random data source.
 		uint64_t random_source_;
-		float random_interval_;
+		float random_interval_ = 0.0f;
 };
 
 
@@ -8,6 +8,8 @@
 
 #include "Encoder.hpp"
 
+#include <algorithm>
+
 namespace {
 
 const uint8_t five_and_three_mapping[] = {
@@ -35,18 +37,12 @@ const uint8_t six_and_two_mapping[] = {
 Storage::Disk::PCMSegment sync(int length, int bit_size) {
 	Storage::Disk::PCMSegment segment;
 
-	// Reserve sufficient storage.
-	segment.data.reserve(size_t(length * bit_size));
-
-	// Write patters of 0xff padded with 0s to the selected bit size.
+	// Write patterns of 0xff padded with 0s to the selected bit size.
+	segment.data.resize(size_t(length * bit_size), false);
+	auto bit = segment.data.begin();
 	while(length--) {
-		int c = 8;
-		while(c--)
-			segment.data.push_back(true);
-
-		c = bit_size - 8;
-		while(c--)
-			segment.data.push_back(false);
+		std::fill(bit, bit + 8, true);
+		bit += bit_size;
 	}
 
 	return segment;
@@ -7,7 +7,10 @@
 //
 
 #include "CommodoreGCR.hpp"
+
+#include <array>
 #include <limits>
+#include <utility>
 
 using namespace Storage;
 
@@ -16,56 +19,69 @@ Time Storage::Encodings::CommodoreGCR::length_of_a_bit_in_time_zone(unsigned int
 	return Time(16 - time_zone, 4000000u);
 }
 
+namespace {
+
+constexpr uint8_t nibble_encodings[16] = {
+	0x0a, 0x0b, 0x12, 0x13, 0x0e, 0x0f, 0x16, 0x17,
+	0x09, 0x19, 0x1a, 0x1b, 0x0d, 0x1d, 0x1e, 0x15,
+};
+
+constexpr uint16_t byte_encoding(uint8_t byte) {
+	return uint16_t(nibble_encodings[byte & 0xf] | (nibble_encodings[byte >> 4] << 5));
+}
+
+template <size_t... bytes> constexpr std::array<uint16_t, 256> byte_table(std::index_sequence<bytes...>) {
+	return {byte_encoding(uint8_t(bytes))...};
+}
+constexpr auto byte_encodings = byte_table(std::make_index_sequence<256>());
+
+/// Maps from quintet to nibble, with 0xff indicating an invalid quintet.
+constexpr uint8_t quintet_decodings[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0x08, 0x00, 0x01, 0xff, 0x0c, 0x04, 0x05,
+	0xff, 0xff, 0x02, 0x03, 0xff, 0x0f, 0x06, 0x07,
+	0xff, 0x09, 0x0a, 0x0b, 0xff, 0x0d, 0x0e, 0xff,
+};
+
+}
+
 unsigned int Storage::Encodings::CommodoreGCR::encoding_for_nibble(uint8_t nibble) {
-	switch(nibble & 0xf) {
-		case 0x0:	return 0x0a;		case 0x1:	return 0x0b;
-		case 0x2:	return 0x12;		case 0x3:	return 0x13;
-		case 0x4:	return 0x0e;		case 0x5:	return 0x0f;
-		case 0x6:	return 0x16;		case 0x7:	return 0x17;
-		case 0x8:	return 0x09;		case 0x9:	return 0x19;
-		case 0xa:	return 0x1a;		case 0xb:	return 0x1b;
-		case 0xc:	return 0x0d;		case 0xd:	return 0x1d;
-		case 0xe:	return 0x1e;		case 0xf:	return 0x15;
-
-		// for the benefit of the compiler; clearly unreachable
-		default:	return 0xff;
-	}
+	return nibble_encodings[nibble & 0xf];
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::decoding_from_quintet(unsigned int quintet) {
-	switch(quintet & 0x1f) {
-		case 0x0a:	return 0x0;			case 0x0b:	return 0x1;
-		case 0x12:	return 0x2;			case 0x13:	return 0x3;
-		case 0x0e:	return 0x4;			case 0x0f:	return 0x5;
-		case 0x16:	return 0x6;			case 0x17:	return 0x7;
-		case 0x09:	return 0x8;			case 0x19:	return 0x9;
-		case 0x1a:	return 0xa;			case 0x1b:	return 0xb;
-		case 0x0d:	return 0xc;			case 0x1d:	return 0xd;
-		case 0x1e:	return 0xe;			case 0x15:	return 0xf;
-
-		default:	return std::numeric_limits<unsigned int>::max();
-	}
+	const uint8_t nibble = quintet_decodings[quintet & 0x1f];
+	return nibble == 0xff ? std::numeric_limits<unsigned int>::max() : nibble;
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::encoding_for_byte(uint8_t byte) {
-	return encoding_for_nibble(byte) | (encoding_for_nibble(byte >> 4) << 5);
+	return byte_encodings[byte];
 }
 
 unsigned int Storage::Encodings::CommodoreGCR::decoding_from_dectet(unsigned int dectet) {
 	return decoding_from_quintet(dectet) | (decoding_from_quintet(dectet >> 5) << 4);
 }
 
-void Storage::Encodings::CommodoreGCR::encode_block(uint8_t *destination, uint8_t *source) {
-	unsigned int encoded_bytes[4] = {
-		encoding_for_byte(source[0]),
-		encoding_for_byte(source[1]),
-		encoding_for_byte(source[2]),
-		encoding_for_byte(source[3]),
-	};
-
-	destination[0] = uint8_t(encoded_bytes[0] >> 2);
-	destination[1] = uint8_t((encoded_bytes[0] << 6) | (encoded_bytes[1] >> 4));
-	destination[2] = uint8_t((encoded_bytes[1] << 4) | (encoded_bytes[2] >> 6));
-	destination[3] = uint8_t((encoded_bytes[2] << 2) | (encoded_bytes[3] >> 8));
-	destination[4] = uint8_t(encoded_bytes[3]);
+void Storage::Encodings::CommodoreGCR::encode_block(uint8_t *destination, const uint8_t *source) {
+	encode_blocks(destination, source, 1);
+}
+
+void Storage::Encodings::CommodoreGCR::encode_blocks(uint8_t *destination, const uint8_t *source, size_t count) {
+	while(count--) {
+		// Compose all forty output bits and then write them out in one go.
+		const uint64_t encoded =
+			(uint64_t(byte_encodings[source[0]]) << 30) |
+			(uint64_t(byte_encodings[source[1]]) << 20) |
+			(uint64_t(byte_encodings[source[2]]) << 10) |
+			uint64_t(byte_encodings[source[3]]);
+
+		destination[0] = uint8_t(encoded >> 32);
+		destination[1] = uint8_t(encoded >> 24);
+		destination[2] = uint8_t(encoded >> 16);
+		destination[3] = uint8_t(encoded >> 8);
+		destination[4] = uint8_t(encoded);
+
+		source += 4;
+		destination += 5;
+	}
 }
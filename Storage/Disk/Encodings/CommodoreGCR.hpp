@@ -10,6 +10,7 @@
 #define Storage_Disk_Encodings_CommodoreGCR_hpp
 
 #include "../../Storage.hpp"
+#include <cstddef>
 #include <cstdint>
 
 namespace Storage {
@@ -35,7 +36,12 @@ namespace CommodoreGCR {
 	/*!
 		A block is defined to be four source bytes, which encodes to five GCR bytes.
 	*/
-	void encode_block(uint8_t *destination, uint8_t *source);
+	void encode_block(uint8_t *destination, const uint8_t *source);
+
+	/*!
+		Encodes @c count consecutive blocks, i.e. @c count * 4 bytes from @c source to @c count * 5 bytes at @c destination.
+	*/
+	void encode_blocks(uint8_t *destination, const uint8_t *source, size_t count);
 
 	/*!
 		@returns the four bit nibble for the five-bit GCR @c quintet if a valid GCR value; INT_MAX otherwise.
@@ -13,8 +13,10 @@
 #include "../../../../Numeric/CRC.hpp"
 #include "../../../../Numeric/BitSpread.hpp"
 
+#include <array>
 #include <cassert>
 #include <set>
+#include <utility>
 
 using namespace Storage::Encodings::MFM;
 
@@ -23,6 +25,37 @@ enum class SurfaceItem {
 	Data
 };
 
+namespace {
+
+/// @returns The MFM encoding of @c input, assuming that the preceding data bit was a 0; if it was
+/// a 1 then the top clock bit should be cleared.
+constexpr uint16_t mfm_encoding(uint8_t input) {
+	const uint16_t spread_value = Numeric::spread_bits(input);
+	const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1));
+	return spread_value | ((~or_bits) & 0xaaaa);
+}
+
+/// @returns The FM encoding of @c input.
+constexpr uint16_t fm_encoding(uint8_t input) {
+	return Numeric::spread_bits(input) | 0xaaaa;
+}
+
+template <size_t... bytes> constexpr std::array<uint16_t, 256> mfm_table(std::index_sequence<bytes...>) {
+	return {mfm_encoding(uint8_t(bytes))...};
+}
+template <size_t... bytes> constexpr std::array<uint16_t, 256> fm_table(std::index_sequence<bytes...>) {
+	return {fm_encoding(uint8_t(bytes))...};
+}
+template <size_t... bytes> constexpr std::array<uint16_t, 256> spread_table(std::index_sequence<bytes...>) {
+	return {Numeric::spread_bits(uint8_t(bytes))...};
+}
+
+constexpr auto mfm_encodings = mfm_table(std::make_index_sequence<256>());
+constexpr auto fm_encodings = fm_table(std::make_index_sequence<256>());
+constexpr auto spread_masks = spread_table(std::make_index_sequence<256>());
+
+}
+
 class MFMEncoder: public Encoder {
 	public:
 		MFMEncoder(std::vector<bool> &target, std::vector<bool> *fuzzy_target = nullptr) : Encoder(target, fuzzy_target) {}
@@ -30,12 +63,10 @@ class MFMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			const uint16_t spread_value = Numeric::spread_bits(input);
-			const uint16_t spread_mask = Numeric::spread_bits(fuzzy_mask);
-			const uint16_t or_bits = uint16_t((spread_value << 1) | (spread_value >> 1) | (last_output_ << 15));
-			const uint16_t output = spread_value | ((~or_bits) & 0xaaaa);
 
-			output_short(output, spread_mask);
+			// The leading clock bit is present only if the previous data bit was clear.
+			const uint16_t output = mfm_encodings[input] & uint16_t(~(last_output_ << 15));
+			output_short(output, spread_masks[fuzzy_mask]);
 		}
 
 		void add_index_address_mark() final {
@@ -87,10 +118,7 @@ class FMEncoder: public Encoder {
 
 		void add_byte(uint8_t input, uint8_t fuzzy_mask = 0) final {
 			crc_generator_.add(input);
-			output_short(
-				Numeric::spread_bits(input) | 0xaaaa,
-				Numeric::spread_bits(fuzzy_mask)
-			);
+			output_short(fm_encodings[input], spread_masks[fuzzy_mask]);
 		}
 
 		void add_index_address_mark() final {
@@ -267,12 +295,18 @@ void Encoder::output_short(uint16_t value, uint16_t fuzzy_mask) {
 		value &= ~fuzzy_mask;
 	}
 
-	uint16_t mask = 0x8000;
-	while(mask) {
-		target_->push_back(value & mask);
-		if(write_fuzzy_bits) fuzzy_target_->push_back(fuzzy_mask & mask);
-		mask >>= 1;
-	}
+	// Resize once and then fill, which is substantially cheaper than sixteen separate push_backs.
+	const auto append = [](std::vector<bool> &target, uint16_t bits) {
+		const auto start = target.size();
+		target.resize(start + 16);
+		auto bit = target.begin() + long(start);
+		for(int shift = 15; shift >= 0; --shift) {
+			*bit = (bits >> shift) & 1;
+			++bit;
+		}
+	};
+	append(*target_, value);
+	if(write_fuzzy_bits) append(*fuzzy_target_, fuzzy_mask);
 }
 
 void Encoder::add_crc(bool incorrectly) {
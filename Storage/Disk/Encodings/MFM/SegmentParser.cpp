@@ -9,6 +9,8 @@
 #include "SegmentParser.hpp"
 #include "Shifter.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Encodings::MFM;
 
 std::map<std::size_t, Storage::Encodings::MFM::Sector> Storage::Encodings::MFM::sectors_from_segment(const Storage::Disk::PCMSegment &&segment, bool is_double_density) {
@@ -23,10 +25,24 @@ std::map<std::size_t, Storage::Encodings::MFM::Sector> Storage::Encodings::MFM::
 	std::size_t size = 0;
 	std::size_t start_location = 0;
 
+	// Bits are gathered up to eight at a time and then passed to the shifter, which
+	// consumes them only as far as the next token.
 	std::size_t bit_cursor = 0;
-	for(const auto bit: segment.data) {
-		shifter.add_input_bit(bit ? 1 : 0);
-		++bit_cursor;
+	auto next_bit = segment.data.begin();
+	uint8_t pending_bits = 0;
+	int pending_count = 0;
+	while(bit_cursor < segment.data.size()) {
+		if(!pending_count) {
+			pending_count = int(std::min(std::size_t(8), segment.data.size() - bit_cursor));
+			for(int c = 0; c < pending_count; c++) {
+				pending_bits = uint8_t((pending_bits << 1) | (*next_bit ? 1 : 0));
+				++next_bit;
+			}
+		}
+
+		const int consumed = shifter.add_input_bits(pending_bits, pending_count);
+		pending_count -= consumed;
+		bit_cursor += std::size_t(consumed);
 
 		switch(shifter.get_token()) {
 			case Shifter::Token::None:
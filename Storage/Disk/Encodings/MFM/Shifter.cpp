@@ -11,6 +11,8 @@
 
 #include "../../../../Numeric/BitSpread.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Encodings::MFM;
 
 Shifter::Shifter() : owned_crc_generator_(new CRC::CCITT()), crc_generator_(owned_crc_generator_.get()) {}
@@ -123,6 +125,38 @@ void Shifter::add_input_bit(int value) {
 	}
 }
 
+int Shifter::add_input_bits(uint8_t bits, int count) {
+	// Determine how many bits can be shifted in before one would produce a token: either the
+	// one that completes a byte or whichever first completes a sync pattern.
+	bits &= uint8_t((1 << count) - 1);
+	int safe_count = std::min(count, 15 - bits_since_token_);
+	if(should_obey_syncs_) {
+		const uint32_t shifted = uint32_t(shift_register_ << count) | bits;
+		for(int bit = 1; bit <= safe_count; bit++) {
+			const uint16_t window = uint16_t(shifted >> (count - bit));
+			const bool is_sync = is_double_density_ ?
+				(window == MFMIndexSync || window == MFMSync) :
+				(window == FMIndexAddressMark || window == FMIDAddressMark || window == FMDataAddressMark || window == FMDeletedDataAddressMark);
+			if(is_sync) {
+				safe_count = bit - 1;
+				break;
+			}
+		}
+	}
+
+	// Shift in all bits up to that point in one go.
+	token_ = Token::None;
+	if(safe_count) {
+		shift_register_ = (shift_register_ << safe_count) | unsigned(bits >> (count - safe_count));
+		bits_since_token_ += safe_count;
+	}
+	if(safe_count == count) return count;
+
+	// Use the usual path for whichever bit is expected to produce a token.
+	add_input_bit((bits >> (count - safe_count - 1)) & 1);
+	return safe_count + 1;
+}
+
 uint8_t Shifter::get_byte() const {
 	return Numeric::unspread_bits(uint16_t(shift_register_));
 }
@@ -31,7 +31,7 @@ namespace MFM {
 	detecting a false sync — the received byte value will be either a 0xc1 or 0x14,
 	depending on phase.
 
-	Bits should be fed in with @c add_input_bit.
+	Bits should be fed in with @c add_input_bit or, up to eight at a time, with @c add_input_bits.
 
 	The current output token can be read with @c get_token. It will usually be None but
 	may indicate that an index, ID, data or deleted data mark was found, that an
@@ -54,6 +54,14 @@ class Shifter {
 		void set_should_obey_syncs(bool should_obey_syncs);
 		void add_input_bit(int bit);
 
+		/*!
+			Adds up to eight bits, supplied in the low @c count bits of @c bits with the earliest in the most
+			significant position. Stops after the first bit that produces a token.
+
+			@returns The number of bits consumed.
+		*/
+		int add_input_bits(uint8_t bits, int count = 8);
+
 		enum Token {
 			Index, ID, Data, DeletedData, Sync, Byte, None
 		};
@@ -0,0 +1,67 @@
+//
+//  Overlay.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Overlay.hpp"
+
+using namespace Storage::Disk;
+
+Overlay::Overlay(const std::shared_ptr<Disk> &base) : base_(std::make_shared<Base>(base)) {}
+
+Overlay::Overlay(const std::shared_ptr<Base> &base) : base_(base) {}
+
+std::shared_ptr<Overlay> Overlay::sibling() const {
+	return std::shared_ptr<Overlay>(new Overlay(base_));
+}
+
+std::shared_ptr<Overlay> Overlay::fork() const {
+	const auto result = sibling();
+	for(const auto &track: tracks_) {
+		result->tracks_[track.first] = std::shared_ptr<Track>(track.second->clone());
+	}
+	return result;
+}
+
+void Overlay::discard_changes() {
+	tracks_.clear();
+}
+
+HeadPosition Overlay::get_maximum_head_position() {
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->disk->get_maximum_head_position();
+}
+
+int Overlay::get_head_count() {
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->disk->get_head_count();
+}
+
+std::shared_ptr<Track> Overlay::get_track_at_position(Track::Address address) {
+	const auto existing = tracks_.find(address);
+	if(existing != tracks_.end()) return existing->second;
+
+	// Clone whatever the base disk has, and keep that copy so that the same Track is
+	// returned for as long as this overlay's drive is using it.
+	std::shared_ptr<Track> track;
+	{
+		std::lock_guard lock_guard(base_->mutex);
+		const auto base_track = base_->disk->get_track_at_position(address);
+		if(!base_track) return nullptr;
+		track = std::shared_ptr<Track>(base_track->clone());
+	}
+	tracks_[address] = track;
+	return track;
+}
+
+void Overlay::set_track_at_position(Track::Address address, const std::shared_ptr<Track> &track) {
+	tracks_[address] = track;
+}
+
+bool Overlay::tracks_differ(Track::Address lhs, Track::Address rhs) {
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->disk->tracks_differ(lhs, rhs);
+}
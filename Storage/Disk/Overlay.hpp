@@ -0,0 +1,69 @@
+//
+//  Overlay.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Storage_Disk_Overlay_hpp
+#define Storage_Disk_Overlay_hpp
+
+#include "Disk.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Storage {
+namespace Disk {
+
+/*!
+	Provides a copy-on-write view of another Disk: tracks are read from the base disk until
+	written, after which this overlay's own copies are used. The base disk is never modified,
+	so any number of overlays can share a single base, each with its own changes.
+
+	Tracks read from the base are cloned before being returned, since a Track carries its own
+	read position and therefore can't be shared between drives.
+*/
+class Overlay: public Disk {
+	public:
+		/// Constructs an overlay upon @c base, which will thereafter be used only via overlays.
+		Overlay(const std::shared_ptr<Disk> &base);
+
+		/// @returns A new overlay upon the same base as this one, with no changes.
+		std::shared_ptr<Overlay> sibling() const;
+
+		/// @returns A new overlay upon the same base as this one, starting with copies of all changes made to this one.
+		/// This overlay must not be in use elsewhere while that copy is made.
+		std::shared_ptr<Overlay> fork() const;
+
+		/// Discards all tracks written to this overlay, restoring the contents of the base disk.
+		void discard_changes();
+
+		/* Disk overrides. */
+		HeadPosition get_maximum_head_position() final;
+		int get_head_count() final;
+		std::shared_ptr<Track> get_track_at_position(Track::Address address) final;
+		void set_track_at_position(Track::Address address, const std::shared_ptr<Track> &track) final;
+		void flush_tracks() final {}
+		bool get_is_read_only() final { return false; }
+		bool tracks_differ(Track::Address, Track::Address) final;
+
+	private:
+		struct Base {
+			Base(const std::shared_ptr<Disk> &disk) : disk(disk) {}
+
+			std::shared_ptr<Disk> disk;
+			std::mutex mutex;
+		};
+		Overlay(const std::shared_ptr<Base> &base);
+
+		std::shared_ptr<Base> base_;
+		std::map<Track::Address, std::shared_ptr<Track>> tracks_;
+};
+
+}
+}
+
+#endif /* Storage_Disk_Overlay_hpp */
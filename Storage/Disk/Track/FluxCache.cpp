@@ -0,0 +1,280 @@
+//
+//  FluxCache.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "FluxCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Storage::Disk;
+
+/*
+	Cache files are laid out as follows, with all fields being little endian:
+
+		8 bytes:	"CLKFLUX1"
+		4 bytes:	number of tracks
+
+		per track, an index entry of:
+			4 bytes:	head
+			4 bytes:	head position, in quarter tracks
+			8 bytes:	offset of the track's description from the start of the file
+
+		per track, a description of:
+			4 bytes:	number of segments
+
+			per segment:
+				4 bytes:	length of a bit, numerator
+				4 bytes:	length of a bit, denominator
+				4 bytes:	number of bits
+				4 bytes:	flags; b0 is set if a fuzzy mask follows the data
+				ceil(number of bits / 8) bytes:	data, MSB first
+				[ceil(number of bits / 8) bytes:	fuzzy mask, MSB first]
+*/
+
+namespace {
+
+constexpr char Signature[] = "CLKFLUX1";
+constexpr size_t SignatureLength = sizeof(Signature) - 1;
+constexpr size_t IndexEntryLength = 16;
+constexpr size_t SegmentHeaderLength = 16;
+
+uint32_t get32(const uint8_t *source) {
+	return uint32_t(source[0]) | (uint32_t(source[1]) << 8) | (uint32_t(source[2]) << 16) | (uint32_t(source[3]) << 24);
+}
+
+uint64_t get64(const uint8_t *source) {
+	return uint64_t(get32(source)) | (uint64_t(get32(source + 4)) << 32);
+}
+
+void put32(std::vector<uint8_t> &destination, uint32_t value) {
+	destination.push_back(uint8_t(value));
+	destination.push_back(uint8_t(value >> 8));
+	destination.push_back(uint8_t(value >> 16));
+	destination.push_back(uint8_t(value >> 24));
+}
+
+void put64(std::vector<uint8_t> &destination, uint64_t value) {
+	put32(destination, uint32_t(value));
+	put32(destination, uint32_t(value >> 32));
+}
+
+void put_bits(std::vector<uint8_t> &destination, const std::vector<bool> &bits) {
+	const size_t start = destination.size();
+	destination.resize(start + ((bits.size() + 7) >> 3), 0);
+	for(size_t c = 0; c < bits.size(); ++c) {
+		if(bits[c]) destination[start + (c >> 3)] |= 0x80 >> (c & 7);
+	}
+}
+
+std::vector<bool> get_bits(const uint8_t *source, size_t number_of_bits) {
+	std::vector<bool> bits(number_of_bits, false);
+	for(size_t c = 0; c < number_of_bits; ++c) {
+		bits[c] = (source[c >> 3] >> (7 ^ (c & 7))) & 1;
+	}
+	return bits;
+}
+
+/// @returns A 64-bit FNV-1a hash of the contents of @c file_name, or 0 if it can't be read.
+uint64_t file_hash(const std::string &file_name) {
+	FILE *const file = fopen(file_name.c_str(), "rb");
+	if(!file) return 0;
+
+	uint64_t hash = 14695981039346656037ull;
+	uint8_t buffer[65536];
+	size_t length;
+	while((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		for(size_t c = 0; c < length; ++c) {
+			hash = (hash ^ buffer[c]) * 1099511628211ull;
+		}
+	}
+	fclose(file);
+	return hash;
+}
+
+}
+
+std::string FluxCache::cache_directory_;
+
+void FluxCache::set_cache_directory(const std::string &directory) {
+	cache_directory_ = directory;
+}
+
+FluxCache::FluxCache(const std::string &file_name) {
+	if(cache_directory_.empty()) return;
+
+	const uint64_t hash = file_hash(file_name);
+	if(!hash) return;
+
+	char name[24];
+	snprintf(name, sizeof(name), "%016llx.flux", static_cast<unsigned long long>(hash));
+	cache_file_name_ = cache_directory_ + "/" + name;
+
+	// Map the existing cache file, if any.
+	const int descriptor = open(cache_file_name_.c_str(), O_RDONLY);
+	if(descriptor < 0) return;
+
+	struct stat file_stats;
+	if(!fstat(descriptor, &file_stats) && file_stats.st_size > 0) {
+		mapping_size_ = size_t(file_stats.st_size);
+		mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(mapping_ == MAP_FAILED) {
+			mapping_ = nullptr;
+		}
+	}
+	close(descriptor);
+	if(!mapping_) return;
+
+	// Build the index, checking as it goes that the file is well-formed; if anything is amiss
+	// then the index will be discarded and the file rewritten.
+	const auto data = static_cast<const uint8_t *>(mapping_);
+	if(mapping_size_ < SignatureLength + 4 || memcmp(data, Signature, SignatureLength)) return;
+
+	const size_t track_count = get32(&data[SignatureLength]);
+	if((mapping_size_ - SignatureLength - 4) / IndexEntryLength < track_count) return;
+
+	std::map<Track::Address, size_t> offsets;
+	for(size_t c = 0; c < track_count; ++c) {
+		const uint8_t *const entry = &data[SignatureLength + 4 + c * IndexEntryLength];
+		const uint64_t offset = get64(&entry[8]);
+
+		// Check that every segment lies within the file.
+		if(offset > mapping_size_ - 4) return;
+		const size_t segment_count = get32(&data[offset]);
+		size_t segment_offset = size_t(offset) + 4;
+		for(size_t s = 0; s < segment_count; ++s) {
+			if(segment_offset > mapping_size_ - SegmentHeaderLength) return;
+
+			const size_t bytes = (size_t(get32(&data[segment_offset + 8])) + 7) >> 3;
+			const size_t copies = (get32(&data[segment_offset + 12]) & 1) ? 2 : 1;
+			segment_offset += SegmentHeaderLength;
+			if((mapping_size_ - segment_offset) / copies < bytes) return;
+			segment_offset += bytes * copies;
+		}
+
+		offsets.emplace(Track::Address(int(get32(entry)), HeadPosition(int(get32(&entry[4])), 4)), size_t(offset));
+	}
+	mapped_offsets_ = std::move(offsets);
+}
+
+FluxCache::~FluxCache() {
+	if(!new_tracks_.empty()) {
+		// Gather all tracks, existing and new.
+		std::map<Track::Address, std::vector<PCMSegment>> tracks;
+		for(const auto &offset: mapped_offsets_) {
+			tracks.emplace(offset.first, mapped_segments(offset.second));
+		}
+		for(auto &track: new_tracks_) {
+			tracks[track.first] = std::move(track.second);
+		}
+
+		// Serialise.
+		std::vector<uint8_t> file(Signature, Signature + SignatureLength);
+		put32(file, uint32_t(tracks.size()));
+
+		const size_t index_start = file.size();
+		file.resize(index_start + tracks.size() * IndexEntryLength);
+
+		size_t index_entry = index_start;
+		for(const auto &track: tracks) {
+			std::vector<uint8_t> entry;
+			put32(entry, uint32_t(track.first.head));
+			put32(entry, uint32_t(track.first.position.as_quarter()));
+			put64(entry, file.size());
+			std::copy(entry.begin(), entry.end(), file.begin() + long(index_entry));
+			index_entry += IndexEntryLength;
+
+			put32(file, uint32_t(track.second.size()));
+			for(const auto &segment: track.second) {
+				const bool has_fuzzy_mask = !segment.fuzzy_mask.empty();
+				put32(file, segment.length_of_a_bit.length);
+				put32(file, segment.length_of_a_bit.clock_rate);
+				put32(file, uint32_t(segment.data.size()));
+				put32(file, has_fuzzy_mask ? 1 : 0);
+				put_bits(file, segment.data);
+				if(has_fuzzy_mask) {
+					std::vector<bool> fuzzy_mask = segment.fuzzy_mask;
+					fuzzy_mask.resize(segment.data.size(), false);
+					put_bits(file, fuzzy_mask);
+				}
+			}
+		}
+
+		// Write to a temporary and then rename, so that a concurrent reader never sees a partial file.
+		const std::string temporary_name = cache_file_name_ + ".tmp";
+		FILE *const output = fopen(temporary_name.c_str(), "wb");
+		if(output) {
+			const bool did_write = fwrite(file.data(), 1, file.size(), output) == file.size();
+			fclose(output);
+
+			if(!did_write || rename(temporary_name.c_str(), cache_file_name_.c_str())) {
+				remove(temporary_name.c_str());
+			}
+		}
+	}
+
+	if(mapping_) {
+		munmap(mapping_, mapping_size_);
+	}
+}
+
+std::vector<PCMSegment> FluxCache::mapped_segments(size_t offset) const {
+	const auto data = static_cast<const uint8_t *>(mapping_);
+	std::vector<PCMSegment> segments;
+
+	const size_t segment_count = get32(&data[offset]);
+	offset += 4;
+	for(size_t c = 0; c < segment_count; ++c) {
+		const Time length_of_a_bit(get32(&data[offset]), get32(&data[offset + 4]));
+		const size_t number_of_bits = get32(&data[offset + 8]);
+		const bool has_fuzzy_mask = get32(&data[offset + 12]) & 1;
+		const size_t bytes = (number_of_bits + 7) >> 3;
+		offset += SegmentHeaderLength;
+
+		segments.emplace_back(length_of_a_bit, get_bits(&data[offset], number_of_bits));
+		offset += bytes;
+
+		if(has_fuzzy_mask) {
+			segments.back().fuzzy_mask = get_bits(&data[offset], number_of_bits);
+			offset += bytes;
+		}
+	}
+
+	return segments;
+}
+
+std::shared_ptr<PCMTrack> FluxCache::track(Track::Address address) {
+	const auto new_track = new_tracks_.find(address);
+	if(new_track != new_tracks_.end()) {
+		hits_.fetch_add(1, std::memory_order_relaxed);
+		return std::make_shared<PCMTrack>(new_track->second);
+	}
+
+	const auto offset = mapped_offsets_.find(address);
+	if(offset == mapped_offsets_.end()) {
+		if(!cache_file_name_.empty()) misses_.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	hits_.fetch_add(1, std::memory_order_relaxed);
+	return std::make_shared<PCMTrack>(mapped_segments(offset->second));
+}
+
+void FluxCache::store(Track::Address address, const std::shared_ptr<Track> &track) {
+	if(cache_file_name_.empty()) return;
+
+	const auto pcm_track = dynamic_cast<PCMTrack *>(track.get());
+	if(!pcm_track) return;
+
+	new_tracks_[address] = pcm_track->segments();
+}
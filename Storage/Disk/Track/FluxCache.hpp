@@ -0,0 +1,81 @@
+//
+//  FluxCache.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef FluxCache_hpp
+#define FluxCache_hpp
+
+#include "PCMTrack.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Storage {
+namespace Disk {
+
+/*!
+	Retains the PCM segments of tracks decoded from a disk image in a file keyed by a hash of that
+	image, so that formats which are expensive to decode can supply the same tracks during later
+	runs by mapping the file into memory and copying bits out, without reparsing the image.
+
+	The cache is inactive unless a host has nominated a directory via @c set_cache_directory.
+	Tracks decoded during this run are added to the file upon destruction, written first to
+	a temporary name and then renamed so that concurrent instances never see a partial file.
+*/
+class FluxCache {
+	public:
+		/// Nominates the directory in which cache files should be stored; if empty, caching is disabled.
+		static void set_cache_directory(const std::string &directory);
+
+		/// Opens the cache for the image in @c file_name, if there is one.
+		FluxCache(const std::string &file_name);
+		~FluxCache();
+
+		FluxCache(const FluxCache &) = delete;
+		FluxCache &operator =(const FluxCache &) = delete;
+
+		/// @returns The track at @c address if it is in the cache; @c nullptr otherwise.
+		std::shared_ptr<PCMTrack> track(Track::Address address);
+
+		/// Adds @c track to the cache as the contents of @c address, if it is a @c PCMTrack.
+		void store(Track::Address address, const std::shared_ptr<Track> &track);
+
+		/// @returns The number of calls to @c track, across all caches, that found or didn't find a track.
+		static uint64_t total_hits() {
+			return hits_;
+		}
+		static uint64_t total_misses() {
+			return misses_;
+		}
+
+	private:
+		static std::string cache_directory_;
+		static inline std::atomic<uint64_t> hits_ = 0;
+		static inline std::atomic<uint64_t> misses_ = 0;
+
+		std::string cache_file_name_;
+
+		// The mapped cache file, and the location of each track within it.
+		void *mapping_ = nullptr;
+		size_t mapping_size_ = 0;
+		std::map<Track::Address, size_t> mapped_offsets_;
+
+		// Tracks decoded during this run, for inclusion when the cache file is rewritten.
+		std::map<Track::Address, std::vector<PCMSegment>> new_tracks_;
+
+		std::vector<PCMSegment> mapped_segments(size_t offset) const;
+};
+
+}
+}
+
+#endif /* FluxCache_hpp */
@@ -8,13 +8,17 @@
 
 #include "PCMSegment.hpp"
 
+#include "../../../Numeric/LeadingZeros.hpp"
+
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 using namespace Storage::Disk;
 
 PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegment &segment) :
-		segment_(new PCMSegment(segment)) {
+		segment_(new PCMSegment(segment)),
+		packed_data_(std::make_shared<PackedData>()) {
 	// add an extra bit of storage at the bottom if one is going to be needed;
 	// events returned are going to be in integral multiples of the length of a bit
 	// other than the very first and very last which will include a half bit length
@@ -33,6 +37,7 @@ PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegment &segment) :
 PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegmentEventSource &original) {
 	// share underlying data with the original
 	segment_ = original.segment_;
+	packed_data_ = original.packed_data_;
 
 	// load up the clock rate and set initial conditions
 	next_event_.length.clock_rate = segment_->length_of_a_bit.clock_rate;
@@ -79,6 +84,30 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// is set, it should be in the centre of its window.
 	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
 
+	// If there's no fuzzy mask then every event is determined by the data alone, so
+	// the next set bit can be found a word at a time.
+	if(segment_->fuzzy_mask.empty()) {
+		if(!packed_data_->is_valid) pack_data();
+
+		const auto &words = packed_data_->words;
+		const std::size_t size = segment_->data.size();
+		while(bit_pointer_ < size) {
+			// Shift out any bits prior to bit_pointer_; bits beyond the end of the data are zero.
+			const std::size_t word_pointer = bit_pointer_ >> 6;
+			const uint64_t word = words[word_pointer] << (bit_pointer_ & 63);
+			if(word) {
+				const std::size_t set_bit = bit_pointer_ + std::size_t(Numeric::leading_zeros(word));
+				next_event_.length.length += unsigned(set_bit + 1 - bit_pointer_) * segment_->length_of_a_bit.length;
+				bit_pointer_ = set_bit + 1;
+				return next_event_;
+			}
+
+			const std::size_t next_bit_pointer = std::min((word_pointer + 1) << 6, size);
+			next_event_.length.length += unsigned(next_bit_pointer - bit_pointer_) * segment_->length_of_a_bit.length;
+			bit_pointer_ = next_bit_pointer;
+		}
+	}
+
 	// search for the next bit that is set, if any
 	while(bit_pointer_ < segment_->data.size()) {
 		bool bit = segment_->data[bit_pointer_];
@@ -144,5 +173,17 @@ const PCMSegment &PCMSegmentEventSource::segment() const {
 }
 
 PCMSegment &PCMSegmentEventSource::segment() {
+	packed_data_->is_valid = false;
 	return *segment_;
 }
+
+void PCMSegmentEventSource::pack_data() {
+	const auto &data = segment_->data;
+	auto &words = packed_data_->words;
+
+	words.assign((data.size() + 63) >> 6, 0);
+	for(std::size_t c = 0; c < data.size(); ++c) {
+		if(data[c]) words[c >> 6] |= uint64_t(1) << (63 - (c & 63));
+	}
+	packed_data_->is_valid = true;
+}
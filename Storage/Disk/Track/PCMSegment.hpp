@@ -61,10 +61,10 @@ struct PCMSegment {
 	*/
 	PCMSegment(size_t number_of_bits, const uint8_t *source)
 		: data(number_of_bits, false) {
+		auto bit = data.begin();
 		for(size_t c = 0; c < number_of_bits; ++c) {
-			if((source[c >> 3] >> (7 ^ (c & 7)))&1) {
-				data[c] = true;
-			}
+			*bit = (source[c >> 3] << (c & 7)) & 0x80;
+			++bit;
 		}
 	}
 
@@ -191,7 +191,8 @@ class PCMSegmentEventSource {
 		Time get_length();
 
 		/*!
-			@returns a reference to the underlying segment.
+			@returns a reference to the underlying segment. Use of the non-const form
+			implies that the segment may be modified.
 		*/
 		const PCMSegment &segment() const;
 		PCMSegment &segment();
@@ -201,6 +202,16 @@ class PCMSegmentEventSource {
 		std::size_t bit_pointer_;
 		Track::Event next_event_;
 		Numeric::LFSR<uint64_t> lfsr_;
+
+		/// A copy of the segment's data packed into 64-bit words, MSB first, so that the next
+		/// set bit can be found a word at a time. Shared alongside the segment, and rebuilt
+		/// whenever the segment may have been modified.
+		struct PackedData {
+			std::vector<uint64_t> words;
+			bool is_valid = false;
+		};
+		std::shared_ptr<PackedData> packed_data_;
+		void pack_data();
 };
 
 }
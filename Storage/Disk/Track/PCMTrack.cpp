@@ -46,6 +46,14 @@ PCMTrack::PCMTrack(const PCMTrack &original) : PCMTrack() {
 	segment_event_sources_ = original.segment_event_sources_;
 }
 
+std::vector<PCMSegment> PCMTrack::segments() const {
+	std::vector<PCMSegment> segments;
+	for(const auto &source: segment_event_sources_) {
+		segments.push_back(source.segment());
+	}
+	return segments;
+}
+
 PCMTrack::PCMTrack(unsigned int bits_per_track) : PCMTrack() {
 	PCMSegment segment;
 	segment.length_of_a_bit.length = 1;
@@ -121,6 +129,15 @@ Track::Event PCMTrack::get_next_event() {
 	return event;
 }
 
+size_t PCMTrack::get_uniform_bit_count() const {
+	// A single segment has a single bit length; any fuzzy bits would make it irregular.
+	if(segment_event_sources_.size() != 1) return 0;
+
+	const PCMSegment &segment = segment_event_sources_.front().segment();
+	if(!segment.fuzzy_mask.empty()) return 0;
+	return segment.data.size();
+}
+
 float PCMTrack::seek_to(float time_since_index_hole) {
 	// initial condition: no time yet accumulated, the whole thing requested yet to navigate
 	float accumulated_time = 0.0f;
@@ -52,6 +52,7 @@ class PCMTrack: public Track {
 		Event get_next_event() final;
 		float seek_to(float time_since_index_hole) final;
 		Track *clone() const final;
+		size_t get_uniform_bit_count() const final;
 
 		// Obtains a copy of this track, flattened to a single PCMSegment, which
 		// consists of @c bits_per_track potential flux transition points.
@@ -72,6 +73,12 @@ class PCMTrack: public Track {
 		*/
 		void add_segment(const Time &start_time, const PCMSegment &segment, bool clamp_to_index_hole);
 
+		/*!
+			@returns Copies of the segments that make up this track, each with a @c length_of_a_bit
+			expressed as a proportion of the whole track.
+		*/
+		std::vector<PCMSegment> segments() const;
+
 	private:
 		/*!
 			Creates a PCMTrack with a single segment, consisting of @c bits_per_track flux windows,
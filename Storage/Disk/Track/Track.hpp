@@ -92,6 +92,13 @@ class Track {
 			}
 
 			constexpr Address(int head, HeadPosition position) : head(head), position(position) {}
+
+			/// Permits Addresses to be used as keys in unordered containers.
+			struct Hash {
+				size_t operator()(const Address &address) const {
+					return (size_t(address.position.as_largest()) << 4) ^ size_t(address.head);
+				}
+			};
 		};
 
 		/*!
@@ -124,6 +131,14 @@ class Track {
 			The virtual copy constructor pattern; returns a copy of the Track.
 		*/
 		virtual Track *clone() const = 0;
+
+		/*!
+			@returns The number of equal-length bit windows that make up this track if every flux
+			transition is known to fall exactly in the centre of one of them, with no randomness; 0 otherwise.
+		*/
+		virtual size_t get_uniform_bit_count() const {
+			return 0;
+		}
 };
 
 }
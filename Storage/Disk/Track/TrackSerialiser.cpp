@@ -7,12 +7,22 @@
 //
 
 #include "TrackSerialiser.hpp"
+#include "PCMTrack.hpp"
 
 #include <memory>
 
-// TODO: if this is a PCMTrack with only one segment and that segment's bit rate is within tolerance,
-// just return a copy of that segment.
 Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track, Time length_of_a_bit) {
+	// If this is a PCMTrack with a single, non-fuzzy segment at exactly the requested bit rate then
+	// there's nothing for the PLL to recover; just return a copy of that segment.
+	const size_t uniform_bit_count = track.get_uniform_bit_count();
+	if(uniform_bit_count && uint64_t(length_of_a_bit.length) * uniform_bit_count == length_of_a_bit.clock_rate) {
+		if(const auto pcm_track = dynamic_cast<const PCMTrack *>(&track)) {
+			PCMSegment result = pcm_track->segments().front();
+			result.length_of_a_bit = length_of_a_bit;
+			return result;
+		}
+	}
+
 	unsigned int history_size = 16;
 	std::unique_ptr<Track> track_copy(track.clone());
 
@@ -8,19 +8,38 @@
 
 #include "FileHolder.hpp"
 
+#include "Container.hpp"
+
 #include <algorithm>
 #include <cstring>
 
+#include <sys/mman.h>
+
 using namespace Storage;
 
 FileHolder::~FileHolder() {
+	if(mapped_ && !contents_) munmap(const_cast<uint8_t *>(mapped_), mapped_size_);
 	if(file_) std::fclose(file_);
 }
 
 FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
 	: name_(file_name) {
-	stat(file_name.c_str(), &file_stats_);
 	is_read_only_ = false;
+	if(stat(file_name.c_str(), &file_stats_)) {
+		// There's no such file on disk, but this may name a file within an archive; if so then
+		// serve it from memory, for reading only.
+		if(ideal_mode != FileMode::Rewrite && (contents_ = Container::contents(file_name))) {
+			static constexpr uint8_t empty = 0;
+			mapped_ = contents_->empty() ? &empty : contents_->data();
+			mapped_size_ = contents_->size();
+
+			file_stats_ = {};
+			file_stats_.st_mode = S_IFREG;
+			file_stats_.st_size = off_t(mapped_size_);
+			is_read_only_ = true;
+			return;
+		}
+	}
 
 	switch(ideal_mode) {
 		case FileMode::ReadWrite:
@@ -39,58 +58,67 @@ FileHolder::FileHolder(const std::string &file_name, FileMode ideal_mode)
 	}
 
 	if(!file_) throw Error::CantOpen;
+	if(ideal_mode == FileMode::Read || is_read_only_) {
+		map();
+	}
 }
 
-uint32_t FileHolder::get32le() {
-	uint32_t result = uint32_t(std::fgetc(file_));
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 24;
+void FileHolder::map() {
+	// Map the whole file, if it has any content; an empty mapping isn't permitted, and failure
+	// leaves all access to stdio.
+	if(file_stats_.st_size <= 0) return;
 
-	return result;
+	void *const mapping = mmap(nullptr, size_t(file_stats_.st_size), PROT_READ, MAP_PRIVATE, fileno(file_), 0);
+	if(mapping == MAP_FAILED) return;
+
+	mapped_ = static_cast<const uint8_t *>(mapping);
+	mapped_size_ = size_t(file_stats_.st_size);
 }
 
-uint32_t FileHolder::get32be() {
-	uint32_t result = uint32_t(std::fgetc(file_)) << 24;
-	result |= uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_));
+uint32_t FileHolder::get32le() {
+	return get_le<uint32_t>();
+}
 
-	return result;
+uint32_t FileHolder::get32be() {
+	return get_be<uint32_t>();
 }
 
 uint32_t FileHolder::get24le() {
-	uint32_t result = uint32_t(std::fgetc(file_));
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_)) << 16;
+	uint32_t result = uint32_t(get_char());
+	result |= uint32_t(get_char()) << 8;
+	result |= uint32_t(get_char()) << 16;
 
 	return result;
 }
 
 uint32_t FileHolder::get24be() {
-	uint32_t result = uint32_t(std::fgetc(file_)) << 16;
-	result |= uint32_t(std::fgetc(file_)) << 8;
-	result |= uint32_t(std::fgetc(file_));
+	uint32_t result = uint32_t(get_char()) << 16;
+	result |= uint32_t(get_char()) << 8;
+	result |= uint32_t(get_char());
 
 	return result;
 }
 
 uint16_t FileHolder::get16le() {
-	uint16_t result = uint16_t(std::fgetc(file_));
-	result |= uint16_t(uint16_t(std::fgetc(file_)) << 8);
-
-	return result;
+	return get_le<uint16_t>();
 }
 
 uint16_t FileHolder::get16be() {
-	uint16_t result = uint16_t(uint16_t(std::fgetc(file_)) << 8);
-	result |= uint16_t(std::fgetc(file_));
+	return get_be<uint16_t>();
+}
 
-	return result;
+int FileHolder::get_char() {
+	if(mapped_) {
+		// As per fgetc, reading beyond the end of the file produces EOF and sets the end-of-file indicator.
+		if(const uint8_t *const byte = mapped_bytes(1)) return *byte;
+		is_at_eof_ = true;
+		return EOF;
+	}
+	return std::fgetc(file_);
 }
 
 uint8_t FileHolder::get8() {
-	return uint8_t(std::fgetc(file_));
+	return uint8_t(get_char());
 }
 
 void FileHolder::put16be(uint16_t value) {
@@ -113,11 +141,21 @@ void FileHolder::putn(std::size_t repeats, uint8_t value) {
 
 std::vector<uint8_t> FileHolder::read(std::size_t size) {
 	std::vector<uint8_t> result(size);
-	result.resize(std::fread(result.data(), 1, size, file_));
+	result.resize(read(result.data(), size));
 	return result;
 }
 
 std::size_t FileHolder::read(uint8_t *buffer, std::size_t size) {
+	if(mapped_) {
+		const size_t available = cursor_ < mapped_size_ ? mapped_size_ - cursor_ : 0;
+		const size_t length = std::min(size, available);
+		if(length) {
+			std::memcpy(buffer, &mapped_[cursor_], length);
+			cursor_ += length;
+		}
+		is_at_eof_ |= length < size;
+		return length;
+	}
 	return std::fread(buffer, 1, size, file_);
 }
 
@@ -130,10 +168,25 @@ std::size_t FileHolder::write(const uint8_t *buffer, std::size_t size) {
 }
 
 void FileHolder::seek(long offset, int whence) {
+	if(mapped_) {
+		// Per fseek, a seek to before the start of the file fails; any other clears the end-of-file indicator.
+		long target = offset;
+		switch(whence) {
+			default:		break;
+			case SEEK_CUR:	target += long(cursor_);		break;
+			case SEEK_END:	target += long(mapped_size_);	break;
+		}
+		if(target < 0) return;
+
+		cursor_ = size_t(target);
+		is_at_eof_ = false;
+		return;
+	}
 	std::fseek(file_, offset, whence);
 }
 
 long FileHolder::tell() {
+	if(mapped_) return long(cursor_);
 	return std::ftell(file_);
 }
 
@@ -142,11 +195,12 @@ void FileHolder::flush() {
 }
 
 bool FileHolder::eof() {
+	if(mapped_) return is_at_eof_;
 	return std::feof(file_);
 }
 
 FileHolder::BitStream FileHolder::get_bitstream(bool lsb_first) {
-	return BitStream(file_, lsb_first);
+	return BitStream(*this, lsb_first);
 }
 
 bool FileHolder::check_signature(const char *signature, std::size_t length) {
@@ -13,6 +13,7 @@
 #include <array>
 #include <cstdio>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -43,10 +44,50 @@ class FileHolder final {
 				Rewrite		opens the file for rewriting; none of the original content is preserved; whatever
 							the caller outputs will replace the existing file.
 
+			Files that end up being opened for reading only are mapped into memory where possible, so that
+			subsequent reads are served directly from memory rather than via stdio.
+
+			Files within zip and gzip archives may also be opened, for reading only, by supplying a name
+			as described by @c Storage::Container; they are decompressed into memory.
+
 			@throws ErrorCantOpen if the file cannot be opened.
 		*/
 		FileHolder(const std::string &file_name, FileMode ideal_mode = FileMode::ReadWrite);
 
+		/*!
+			Reads a value of type @c T, assembled from successive bytes in little endian order.
+		*/
+		template <typename T> T get_le() {
+			T result = 0;
+			if(const uint8_t *const bytes = mapped_bytes(sizeof(T))) {
+				for(size_t c = 0; c < sizeof(T); c++) {
+					result |= T(T(bytes[c]) << (c * 8));
+				}
+			} else {
+				for(size_t c = 0; c < sizeof(T); c++) {
+					result |= T(T(get_char()) << (c * 8));
+				}
+			}
+			return result;
+		}
+
+		/*!
+			Reads a value of type @c T, assembled from successive bytes in big endian order.
+		*/
+		template <typename T> T get_be() {
+			T result = 0;
+			if(const uint8_t *const bytes = mapped_bytes(sizeof(T))) {
+				for(size_t c = 0; c < sizeof(T); c++) {
+					result = T((result << 8) | bytes[c]);
+				}
+			} else {
+				for(size_t c = 0; c < sizeof(T); c++) {
+					result |= T(T(get_char()) << ((sizeof(T) - 1 - c) * 8));
+				}
+			}
+			return result;
+		}
+
 		/*!
 			Performs @c get8 four times on @c file, casting each result to a @c uint32_t
 			and returning the four assembled in little endian order.
@@ -164,14 +205,14 @@ class FileHolder final {
 				}
 
 			private:
-				BitStream(FILE *file, bool lsb_first) :
+				BitStream(FileHolder &file, bool lsb_first) :
 					file_(file),
 					lsb_first_(lsb_first),
 					next_value_(0),
 					bits_remaining_(0) {}
 				friend FileHolder;
 
-				FILE *file_;
+				FileHolder &file_;
 				bool lsb_first_;
 				uint8_t next_value_;
 				int bits_remaining_;
@@ -179,7 +220,7 @@ class FileHolder final {
 				uint8_t get_bit() {
 					if(!bits_remaining_) {
 						bits_remaining_ = 8;
-						next_value_ = uint8_t(fgetc(file_));
+						next_value_ = file_.get8();
 					}
 
 					uint8_t bit;
@@ -242,6 +283,26 @@ class FileHolder final {
 		FILE *file_ = nullptr;
 		const std::string name_;
 
+		// If the file is open for reading only, it may also be mapped into memory; if so then
+		// all reads, seeks and end-of-file tests are performed here rather than via file_.
+		const uint8_t *mapped_ = nullptr;
+		size_t mapped_size_ = 0;
+		std::shared_ptr<const std::vector<uint8_t>> contents_;		// Set if mapped_ points into a decompressed file rather than a mapping.
+		size_t cursor_ = 0;
+		bool is_at_eof_ = false;
+		void map();
+
+		/// Reads a single byte, returning it or EOF as per @c fgetc.
+		int get_char();
+
+		/// @returns A pointer to the next @c count bytes if the file is mapped and that many bytes remain, advancing the cursor past them; @c nullptr otherwise.
+		const uint8_t *mapped_bytes(size_t count) {
+			if(!mapped_ || cursor_ > mapped_size_ || mapped_size_ - cursor_ < count) return nullptr;
+			const uint8_t *const bytes = &mapped_[cursor_];
+			cursor_ += count;
+			return bytes;
+		}
+
 		struct stat file_stats_;
 		bool is_read_only_ = false;
 
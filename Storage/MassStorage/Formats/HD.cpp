@@ -0,0 +1,37 @@
+//
+//  HD.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "HD.hpp"
+
+using namespace Storage::MassStorage;
+
+HD::HD(const std::string &file_name) : RawSectorDump(file_name) {
+	// Does the root sector contain at least one plausible partition entry? Each is a flags byte,
+	// of which b0 indicates existence, then a three-character identifier, then a big-endian
+	// start sector and size.
+	const auto root = get_block(0);
+	if(root.size() != 512) {
+		throw std::exception();
+	}
+
+	for(size_t entry = 0x1c6; entry < 0x1f6; entry += 12) {
+		if(!(root[entry] & 1)) continue;
+
+		const auto id = [&](const char *name) {
+			return root[entry + 1] == name[0] && root[entry + 2] == name[1] && root[entry + 3] == name[2];
+		};
+		if(!id("GEM") && !id("BGM") && !id("XGM")) continue;
+
+		const uint32_t start =
+			uint32_t(root[entry + 4] << 24) | uint32_t(root[entry + 5] << 16) |
+			uint32_t(root[entry + 6] << 8) | uint32_t(root[entry + 7]);
+		if(start && start < get_number_of_blocks()) return;
+	}
+
+	throw std::exception();
+}
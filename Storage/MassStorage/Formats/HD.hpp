@@ -0,0 +1,30 @@
+//
+//  HD.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MassStorage_HD_hpp
+#define MassStorage_HD_hpp
+
+#include "RawSectorDump.hpp"
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Provides a @c MassStorageDevice containing an Atari ST hard disk image, which is just a
+	sector dump of an entire ACSI device. It will be validated for an AHDI-style root sector
+	and communicate in 512-byte blocks.
+*/
+class HD: public RawSectorDump<512> {
+	public:
+		HD(const std::string &file_name);
+};
+
+}
+}
+
+#endif /* MassStorage_HD_hpp */
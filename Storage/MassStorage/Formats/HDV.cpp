@@ -9,13 +9,16 @@
 #include "HDV.hpp"
 
 #include <algorithm>
+#include <cassert>
+#include <cstring>
 
 using namespace Storage::MassStorage;
 
 HDV::HDV(const std::string &file_name, long start, long size):
 	file_(file_name),
 	file_start_(start),
-	image_size_(std::min(size, long(file_.stats().st_size)))
+	image_size_(std::min(size, long(file_.stats().st_size))),
+	image_(file_name, file_start_, image_size_)
 {
 	mapper_.set_drive_type(
 		Storage::MassStorage::Encodings::Apple::DriveType::SCSI,
@@ -32,6 +35,10 @@ size_t HDV::get_number_of_blocks() {
 }
 
 std::vector<uint8_t> HDV::get_block(size_t address) {
+	if(const auto contents = block_contents(address)) {
+		return std::vector<uint8_t>(contents, contents + get_block_size());
+	}
+
 	const auto source_address = mapper_.to_source_address(address);
 	const auto file_offset = offset_for_block(source_address);
 
@@ -44,12 +51,31 @@ std::vector<uint8_t> HDV::get_block(size_t address) {
 }
 
 void HDV::set_block(size_t address, const std::vector<uint8_t> &data) {
+	assert(data.size() == get_block_size());
+	set_block_contents(address, data.data());
+}
+
+const uint8_t *HDV::block_contents(size_t address) {
+	const auto source_address = mapper_.to_source_address(address);
+	const auto file_offset = offset_for_block(source_address);
+
+	// Blocks that the mapper synthesises, and those beyond the end of the image, aren't available in place.
+	if(!image_.data() || source_address < 0 || file_offset < 0) return nullptr;
+	return image_.data() + (file_offset - file_start_);
+}
+
+void HDV::set_block_contents(size_t address, const uint8_t *contents) {
 	const auto source_address = mapper_.to_source_address(address);
 	const auto file_offset = offset_for_block(source_address);
 
 	if(source_address >= 0 && file_offset >= 0) {
+		if(image_.data()) {
+			memcpy(image_.data() + (file_offset - file_start_), contents, get_block_size());
+			return;
+		}
+
 		file_.seek(file_offset, SEEK_SET);
-		file_.write(data);
+		file_.write(contents, get_block_size());
 	}
 }
 
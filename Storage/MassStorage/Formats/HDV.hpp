@@ -10,6 +10,7 @@
 #define HDV_hpp
 
 #include "../MassStorageDevice.hpp"
+#include "../MappedImage.hpp"
 #include "../../FileHolder.hpp"
 #include "../Encodings/AppleIIVolume.hpp"
 
@@ -38,6 +39,7 @@ class HDV: public MassStorageDevice {
 		FileHolder file_;
 		long file_start_, image_size_;
 		Storage::MassStorage::Encodings::AppleII::Mapper mapper_;
+		MappedImage image_;
 
 		/// @returns -1 if @c address is out of range; the offset into the file at which
 		/// the block for @c address resides otherwise.
@@ -48,6 +50,8 @@ class HDV: public MassStorageDevice {
 		size_t get_number_of_blocks() final;
 		std::vector<uint8_t> get_block(size_t address) final;
 		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		const uint8_t *block_contents(size_t address) final;
+		void set_block_contents(size_t address, const uint8_t *) final;
 };
 
 }
@@ -8,9 +8,12 @@
 
 #include "HFV.hpp"
 
+#include <cassert>
+#include <cstring>
+
 using namespace Storage::MassStorage;
 
-HFV::HFV(const std::string &file_name) : file_(file_name) {
+HFV::HFV(const std::string &file_name) : file_(file_name), image_(file_name, 0, long(file_.stats().st_size)) {
 	// Is the file a multiple of 512 bytes in size and larger than a floppy disk?
 	const auto file_size = file_.stats().st_size;
 	if(file_size & 511 || file_size <= 800*1024) throw std::exception();
@@ -30,8 +33,9 @@ size_t HFV::get_number_of_blocks() {
 }
 
 std::vector<uint8_t> HFV::get_block(size_t address) {
-	const auto written = writes_.find(address);
-	if(written != writes_.end()) return written->second;
+	if(const auto contents = block_contents(address)) {
+		return std::vector<uint8_t>(contents, contents + get_block_size());
+	}
 
 	const auto source_address = mapper_.to_source_address(address);
 	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
@@ -44,14 +48,36 @@ std::vector<uint8_t> HFV::get_block(size_t address) {
 }
 
 void HFV::set_block(size_t address, const std::vector<uint8_t> &contents) {
+	assert(contents.size() == get_block_size());
+	set_block_contents(address, contents.data());
+}
+
+const uint8_t *HFV::block_contents(size_t address) {
+	const auto written = writes_.find(address);
+	if(written != writes_.end()) return written->second.data();
+
+	// Blocks that the mapper synthesises aren't available in place.
+	const auto source_address = mapper_.to_source_address(address);
+	if(image_.data() && source_address >= 0 && size_t(source_address)*get_block_size() < image_.size()) {
+		return image_.data() + size_t(source_address)*get_block_size();
+	}
+	return nullptr;
+}
+
+void HFV::set_block_contents(size_t address, const uint8_t *contents) {
 	const auto source_address = mapper_.to_source_address(address);
 	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
+		if(image_.data()) {
+			memcpy(image_.data() + size_t(source_address)*get_block_size(), contents, get_block_size());
+			return;
+		}
+
 		const long file_offset = long(get_block_size()) * long(source_address);
 		file_.seek(file_offset, SEEK_SET);
-		file_.write(contents);
+		file_.write(contents, get_block_size());
 	} else {
-		writes_[address] = contents;
- 	}
+		writes_[address] = std::vector<uint8_t>(contents, contents + get_block_size());
+	}
 }
 
 void HFV::set_drive_type(Encodings::Macintosh::DriveType drive_type) {
@@ -10,6 +10,7 @@
 #define HFV_hpp
 
 #include "../MassStorageDevice.hpp"
+#include "../MappedImage.hpp"
 #include "../../FileHolder.hpp"
 #include "../Encodings/MacintoshVolume.hpp"
 
@@ -35,12 +36,15 @@ class HFV: public MassStorageDevice, public Encodings::Macintosh::Volume {
 	private:
 		FileHolder file_;
 		Encodings::Macintosh::Mapper mapper_;
+		MappedImage image_;
 
 		/* MassStorageDevices overrides. */
 		size_t get_block_size() final;
 		size_t get_number_of_blocks() final;
 		std::vector<uint8_t> get_block(size_t address) final;
 		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		const uint8_t *block_contents(size_t address) final;
+		void set_block_contents(size_t address, const uint8_t *) final;
 
 		/* Encodings::Macintosh::Volume overrides. */
 		void set_drive_type(Encodings::Macintosh::DriveType) final;
@@ -10,9 +10,11 @@
 #define RawSectorDump_h
 
 #include "../MassStorageDevice.hpp"
+#include "../MappedImage.hpp"
 #include "../../FileHolder.hpp"
 
 #include <cassert>
+#include <cstring>
 
 namespace Storage {
 namespace MassStorage {
@@ -22,7 +24,8 @@ template <long sector_size> class RawSectorDump: public MassStorageDevice {
 		RawSectorDump(const std::string &file_name, long offset = 0, long length = -1) :
 			file_(file_name),
 			file_size_((length == -1) ? long(file_.stats().st_size) : length),
-			file_start_(offset)
+			file_start_(offset),
+			image_(file_name, file_start_, file_size_)
 		{
 			// Is the file a multiple of sector_size bytes in size?
 			if(file_size_ % sector_size) throw std::exception();
@@ -38,19 +41,38 @@ template <long sector_size> class RawSectorDump: public MassStorageDevice {
 		}
 
 		std::vector<uint8_t> get_block(size_t address) final {
+			if(const auto contents = block_contents(address)) {
+				return std::vector<uint8_t>(contents, contents + sector_size);
+			}
+
 			file_.seek(file_start_ + long(address * sector_size), SEEK_SET);
 			return file_.read(sector_size);
 		}
 
 		void set_block(size_t address, const std::vector<uint8_t> &contents) final {
 			assert(contents.size() == sector_size);
+			set_block_contents(address, contents.data());
+		}
+
+		const uint8_t *block_contents(size_t address) final {
+			if(!image_.data() || address >= get_number_of_blocks()) return nullptr;
+			return image_.data() + address * sector_size;
+		}
+
+		void set_block_contents(size_t address, const uint8_t *contents) final {
+			if(image_.data() && address < get_number_of_blocks()) {
+				memcpy(image_.data() + address * sector_size, contents, sector_size);
+				return;
+			}
+
 			file_.seek(file_start_ + long(address * sector_size), SEEK_SET);
-			file_.write(contents);
+			file_.write(contents, sector_size);
 		}
 
 	private:
 		FileHolder file_;
 		const long file_size_, file_start_;
+		MappedImage image_;
 };
 
 }
@@ -0,0 +1,68 @@
+//
+//  MappedImage.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "MappedImage.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Storage::MassStorage;
+
+MappedImage::MappedImage(const std::string &file_name, long start, long length) {
+	if(start < 0 || length <= 0) return;
+
+	// Prefer a writeable, shared mapping but accept a private one if the file can only be read.
+	bool is_writeable = true;
+	int descriptor = open(file_name.c_str(), O_RDWR);
+	if(descriptor < 0) {
+		is_writeable = false;
+		descriptor = open(file_name.c_str(), O_RDONLY);
+		if(descriptor < 0) return;
+	}
+
+	// Don't map anything beyond the end of the file, as accesses there would fault.
+	struct stat file_stats;
+	if(fstat(descriptor, &file_stats) || start + length > file_stats.st_size) {
+		close(descriptor);
+		return;
+	}
+
+	// Mappings have to begin on a page boundary, so map from the page containing start.
+	const long page_size = sysconf(_SC_PAGESIZE);
+	const long mapping_start = start - (start % page_size);
+	const size_t lead_in = size_t(start - mapping_start);
+
+	mapping_size_ = lead_in + size_t(length);
+	mapping_ = mmap(
+		nullptr,
+		mapping_size_,
+		PROT_READ | PROT_WRITE,
+		is_writeable ? MAP_SHARED : MAP_PRIVATE,
+		descriptor,
+		off_t(mapping_start));
+
+	// The mapping remains valid after the descriptor is closed.
+	close(descriptor);
+
+	if(mapping_ == MAP_FAILED) {
+		mapping_ = nullptr;
+		return;
+	}
+
+	data_ = static_cast<uint8_t *>(mapping_) + lead_in;
+	size_ = size_t(length);
+}
+
+MappedImage::~MappedImage() {
+	if(!mapping_) return;
+
+	msync(mapping_, mapping_size_, MS_SYNC);
+	munmap(mapping_, mapping_size_);
+}
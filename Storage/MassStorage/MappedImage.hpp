@@ -0,0 +1,59 @@
+//
+//  MappedImage.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MappedImage_hpp
+#define MappedImage_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Maps a region of a file into memory so that a mass storage device can serve and
+	accept blocks in place, without a heap allocation or copy per block.
+
+	If the file is writeable then the mapping is shared, so modified pages are written back
+	to the file by the host's virtual memory system and synchronised upon destruction.
+	Otherwise the mapping is private, and writes are retained only for the lifetime of the mapping.
+
+	If the region can't be mapped, including if it extends beyond the end of the file, then
+	@c data() will return @c nullptr and the owner should fall back on conventional file access.
+*/
+class MappedImage {
+	public:
+		MappedImage(const std::string &file_name, long start, long length);
+		~MappedImage();
+
+		MappedImage(const MappedImage &) = delete;
+		MappedImage &operator =(const MappedImage &) = delete;
+
+		/// @returns The start of the mapped region, or @c nullptr if mapping failed.
+		uint8_t *data() {
+			return data_;
+		}
+
+		/// @returns The size of the mapped region, in bytes.
+		size_t size() const {
+			return size_;
+		}
+
+	private:
+		void *mapping_ = nullptr;
+		size_t mapping_size_ = 0;
+
+		uint8_t *data_ = nullptr;
+		size_t size_ = 0;
+};
+
+}
+}
+
+#endif /* MappedImage_hpp */
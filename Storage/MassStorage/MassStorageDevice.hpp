@@ -53,6 +53,27 @@ class MassStorageDevice {
 			Sets new contents for the block at @c address.
 		*/
 		virtual void set_block([[maybe_unused]] size_t address, const std::vector<uint8_t> &) {}
+
+		/*!
+			@returns A pointer to the current contents of the block at @c address, which are
+			@c get_block_size() bytes long, or @c nullptr if this device can't provide them
+			without constructing them. A non-null result remains valid until the next call to
+			@c set_block or @c set_block_contents.
+
+			Devices that can supply blocks in place should override this; callers should
+			fall back on @c get_block if it returns @c nullptr.
+		*/
+		virtual const uint8_t *block_contents([[maybe_unused]] size_t address) {
+			return nullptr;
+		}
+
+		/*!
+			Sets new contents for the block at @c address from the @c get_block_size() bytes
+			at @c contents. By default this forwards to @c set_block.
+		*/
+		virtual void set_block_contents(size_t address, const uint8_t *contents) {
+			set_block(address, std::vector<uint8_t>(contents, contents + get_block_size()));
+		}
 };
 
 }
@@ -0,0 +1,71 @@
+//
+//  Overlay.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Overlay.hpp"
+
+using namespace Storage::MassStorage;
+
+Overlay::Overlay(const std::shared_ptr<MassStorageDevice> &base) : base_(std::make_shared<Base>(base)) {}
+
+Overlay::Overlay(const std::shared_ptr<Base> &base) : base_(base) {}
+
+std::shared_ptr<Overlay> Overlay::sibling() const {
+	return std::shared_ptr<Overlay>(new Overlay(base_));
+}
+
+std::shared_ptr<Overlay> Overlay::fork() const {
+	const auto result = sibling();
+	result->blocks_ = blocks_;
+	return result;
+}
+
+void Overlay::discard_changes() {
+	blocks_.clear();
+}
+
+size_t Overlay::get_block_size() {
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->device->get_block_size();
+}
+
+size_t Overlay::get_number_of_blocks() {
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->device->get_number_of_blocks();
+}
+
+std::vector<uint8_t> Overlay::get_block(size_t address) {
+	const auto written = blocks_.find(address);
+	if(written != blocks_.end()) return written->second;
+
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->device->get_block(address);
+}
+
+void Overlay::set_block(size_t address, const std::vector<uint8_t> &contents) {
+	blocks_[address] = contents;
+}
+
+const uint8_t *Overlay::block_contents(size_t address) {
+	const auto written = blocks_.find(address);
+	if(written != blocks_.end()) return written->second.data();
+
+	// The base device is never written, so anything it supplies in place remains valid.
+	std::lock_guard lock_guard(base_->mutex);
+	return base_->device->block_contents(address);
+}
+
+void Overlay::set_block_contents(size_t address, const uint8_t *contents) {
+	blocks_[address] = std::vector<uint8_t>(contents, contents + get_block_size());
+}
+
+void Overlay::set_drive_type(Encodings::Macintosh::DriveType drive_type) {
+	std::lock_guard lock_guard(base_->mutex);
+	if(const auto volume = dynamic_cast<Encodings::Macintosh::Volume *>(base_->device.get())) {
+		volume->set_drive_type(drive_type);
+	}
+}
@@ -0,0 +1,76 @@
+//
+//  Overlay.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Storage_MassStorage_Overlay_hpp
+#define Storage_MassStorage_Overlay_hpp
+
+#include "MassStorageDevice.hpp"
+#include "Encodings/MacintoshVolume.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Provides a copy-on-write view of another MassStorageDevice: blocks are read from the base
+	device until written, after which this overlay's own copies are used. The base device is
+	never modified, so any number of overlays can share a single base, each with its own changes.
+
+	Where the base device can supply blocks in place, so can the overlay for any block it
+	hasn't modified.
+
+	If the base device is a Macintosh volume then so is the overlay, forwarding drive type
+	selection; all overlays on the same base should select the same drive type.
+*/
+class Overlay: public MassStorageDevice, public Encodings::Macintosh::Volume {
+	public:
+		/// Constructs an overlay upon @c base, which will thereafter be used only via overlays.
+		Overlay(const std::shared_ptr<MassStorageDevice> &base);
+
+		/// @returns A new overlay upon the same base as this one, with no changes.
+		std::shared_ptr<Overlay> sibling() const;
+
+		/// @returns A new overlay upon the same base as this one, starting with copies of all changes made to this one.
+		/// This overlay must not be in use elsewhere while that copy is made.
+		std::shared_ptr<Overlay> fork() const;
+
+		/// Discards all blocks written to this overlay, restoring the contents of the base device.
+		void discard_changes();
+
+	private:
+		struct Base {
+			Base(const std::shared_ptr<MassStorageDevice> &device) : device(device) {}
+
+			std::shared_ptr<MassStorageDevice> device;
+			std::mutex mutex;
+		};
+		Overlay(const std::shared_ptr<Base> &base);
+
+		std::shared_ptr<Base> base_;
+		std::unordered_map<size_t, std::vector<uint8_t>> blocks_;
+
+		/* MassStorageDevices overrides. */
+		size_t get_block_size() final;
+		size_t get_number_of_blocks() final;
+		std::vector<uint8_t> get_block(size_t address) final;
+		void set_block(size_t address, const std::vector<uint8_t> &) final;
+		const uint8_t *block_contents(size_t address) final;
+		void set_block_contents(size_t address, const uint8_t *) final;
+
+		/* Encodings::Macintosh::Volume overrides. */
+		void set_drive_type(Encodings::Macintosh::DriveType) final;
+};
+
+}
+}
+
+#endif /* Storage_MassStorage_Overlay_hpp */
@@ -7,7 +7,7 @@
 //
 
 #include "DirectAccessDevice.hpp"
-#include "../../../Outputs/Log.hpp"
+#include "../../../Outputs/Logger.hpp"
 
 using namespace SCSI;
 
@@ -19,12 +19,20 @@ bool DirectAccessDevice::read(const Target::CommandState &state, Target::Respond
 	if(!device_) return false;
 
 	const auto specs = state.read_write_specs();
-	LOG("Read: " << std::dec << specs.number_of_blocks << " from " << specs.address);
+	LOGF(Log::Source::SCSI, "Read: %u from %u", specs.number_of_blocks, specs.address);
 
-	std::vector<uint8_t> output = device_->get_block(specs.address);
-	for(uint32_t offset = 1; offset < specs.number_of_blocks; ++offset) {
-		const auto next_block = device_->get_block(specs.address + offset);
-		std::copy(next_block.begin(), next_block.end(), std::back_inserter(output));
+	// Copy blocks straight out of the device where it permits that, rather than
+	// having it construct each one individually.
+	const auto block_size = device_->get_block_size();
+	std::vector<uint8_t> output;
+	output.reserve(block_size * specs.number_of_blocks);
+	for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
+		if(const auto contents = device_->block_contents(specs.address + offset)) {
+			output.insert(output.end(), contents, contents + block_size);
+		} else {
+			const auto next_block = device_->get_block(specs.address + offset);
+			output.insert(output.end(), next_block.begin(), next_block.end());
+		}
 	}
 
 	responder.send_data(std::move(output), [] (const Target::CommandState &, Target::Responder &responder) {
@@ -38,15 +46,13 @@ bool DirectAccessDevice::write(const Target::CommandState &state, Target::Respon
 	if(!device_) return false;
 
 	const auto specs = state.read_write_specs();
-	LOG("Write: " << specs.number_of_blocks << " to " << specs.address);
+	LOGF(Log::Source::SCSI, "Write: %u to %u", specs.number_of_blocks, specs.address);
 
 	responder.receive_data(device_->get_block_size() * specs.number_of_blocks, [this, specs] (const Target::CommandState &state, Target::Responder &responder) {
 		const auto received_data = state.received_data();
-		const auto block_size = ssize_t(device_->get_block_size());
+		const auto block_size = device_->get_block_size();
 		for(uint32_t offset = 0; offset < specs.number_of_blocks; ++offset) {
-			// TODO: clean up this gross inefficiency when std::span is standard.
-			std::vector<uint8_t> sub_vector(received_data.begin() + ssize_t(offset)*block_size, received_data.begin() + ssize_t(offset+1)*block_size);
-			this->device_->set_block(specs.address + offset, sub_vector);
+			this->device_->set_block_contents(specs.address + offset, &received_data[offset * block_size]);
 		}
 		responder.terminate_command(Target::Responder::Status::Good);
 	});
@@ -93,6 +93,15 @@ void Bus::update_observers() {
 	}
 }
 
+bool Bus::acknowledge_data(uint8_t initiator_data) {
+	for(auto &observer: observers_) {
+		if(observer->scsi_bus_acknowledge_data(this, initiator_data)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void Bus::run_for(HalfCycles time) {
 	if(dispatch_index_ < dispatch_times_.size()) {
 		time_in_state_ += time;
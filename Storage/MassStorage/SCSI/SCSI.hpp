@@ -129,6 +129,16 @@ class Bus: public ClockingHint::Source, public Activity::Source {
 			/// ArbitrationDelay et al. Observers will be notified each time one of the thresholds
 			/// defined by those constants is crossed.
 			virtual void scsi_bus_did_change(Bus *, BusState new_state, double time_since_change) = 0;
+
+			/// Offers an observer the chance to complete the data-phase byte that it is currently requesting,
+			/// as if the initiator had acknowledged it with the supplied value on the data lines, without the
+			/// remainder of the REQ/ACK handshake being simulated. An observer that does so should request the
+			/// next byte immediately, and return @c true.
+			///
+			/// Observers that decline should return @c false, after which the initiator will perform a normal handshake.
+			virtual bool scsi_bus_acknowledge_data(Bus *, uint8_t) {
+				return false;
+			}
 		};
 		/*!
 			Adds an observer.
@@ -147,6 +157,15 @@ class Bus: public ClockingHint::Source, public Activity::Source {
 		*/
 		void update_observers();
 
+		/*!
+			Attempts to complete the data-phase byte currently being requested by a target in a
+			single step, as per @c Observer::scsi_bus_acknowledge_data; an initiator that is about
+			to acknowledge a byte may call this first to avoid the full handshake.
+
+			@returns @c true if an observer completed the byte; @c false otherwise.
+		*/
+		bool acknowledge_data(uint8_t initiator_data);
+
 		// As per ClockingHint::Source.
 		ClockingHint::Preference preferred_clocking() const final;
 
@@ -352,6 +352,7 @@ template <typename Executor> class Target: public Bus::Observer, public Responde
 
 		// Bus::Observer.
 		void scsi_bus_did_change(Bus *, BusState new_state, double time_since_change) final;
+		bool scsi_bus_acknowledge_data(Bus *, uint8_t initiator_data) final;
 
 		// Responder
 		void send_data(std::vector<uint8_t> &&data, continuation next) final;
@@ -152,6 +152,31 @@ template <typename Executor> void Target<Executor>::scsi_bus_did_change(Bus *, B
 	}
 }
 
+template <typename Executor> bool Target<Executor>::scsi_bus_acknowledge_data(Bus *, uint8_t initiator_data) {
+	// Only a byte that is currently being requested, and that isn't the final byte of
+	// the data phase, can be completed immediately; the final byte is left to the full
+	// handshake so that the next phase begins exactly as it otherwise would.
+	if(!(bus_state_ & Line::Request) || data_pointer_ + 1 >= data_.size()) {
+		return false;
+	}
+
+	switch(phase_) {
+		default: return false;
+
+		case Phase::ReceivingData:
+			data_[data_pointer_] = initiator_data;
+			++data_pointer_;
+		break;
+
+		case Phase::SendingData:
+			++data_pointer_;
+			bus_state_ = (bus_state_ & ~0xff) | data_[data_pointer_];
+			set_device_output(bus_state_);
+		break;
+	}
+	return true;
+}
+
 template <typename Executor> void Target<Executor>::begin_command(uint8_t first_byte) {
 	// The logic below is valid for SCSI-1. TODO: other SCSIs.
 	switch(first_byte >> 5) {
@@ -293,6 +293,68 @@ struct Time {
 		}
 };
 
+/*!
+	Contains either an absolute time or a time interval as a 64-bit fixed-point quantity, with 32 bits
+	each of integral and fractional part. Like @c Time it has no inherent unit, so may count either seconds
+	or cycles.
+
+	All arithmetic and comparisons are plain integer operations, in exchange for which values are rounded
+	to the nearest 2^-32 upon conversion from a @c Time. So this is intended for paths that accumulate or
+	compare large numbers of times, with conversion to and from @c Time at their boundaries.
+*/
+struct FixedTime {
+	static constexpr int FractionalBits = 32;
+	static constexpr uint64_t One = uint64_t(1) << FractionalBits;
+
+	uint64_t value = 0;
+
+	constexpr FixedTime() = default;
+	constexpr explicit FixedTime(const Time &time) : value(rounded_quotient(time.length, time.clock_rate)) {}
+
+	static constexpr FixedTime from_value(uint64_t value) {
+		FixedTime result;
+		result.value = value;
+		return result;
+	}
+
+	/// @returns This time as a @c Time, which will be exact unless this time is very large.
+	Time as_time() const {
+		return Time(value, One);
+	}
+
+	/// @returns The floating point conversion of this time.
+	template <typename T> T get() const {
+		return T(value) / T(One);
+	}
+
+	/// @returns The smallest integer that is no less than this time.
+	constexpr uint64_t ceiling() const {
+		return (value >> FractionalBits) + ((value & (One - 1)) ? 1 : 0);
+	}
+
+	constexpr bool operator < (const FixedTime &other) const		{	return value < other.value;		}
+	constexpr bool operator <= (const FixedTime &other) const		{	return value <= other.value;	}
+	constexpr bool operator > (const FixedTime &other) const		{	return value > other.value;		}
+	constexpr bool operator >= (const FixedTime &other) const		{	return value >= other.value;	}
+	constexpr bool operator == (const FixedTime &other) const		{	return value == other.value;	}
+	constexpr bool operator != (const FixedTime &other) const		{	return value != other.value;	}
+
+	constexpr FixedTime operator + (const FixedTime &other) const	{	return from_value(value + other.value);	}
+	constexpr FixedTime operator - (const FixedTime &other) const	{	return from_value(value - other.value);	}
+	constexpr FixedTime &operator += (const FixedTime &other)		{	value += other.value;	return *this;	}
+	constexpr FixedTime &operator -= (const FixedTime &other)		{	value -= other.value;	return *this;	}
+
+	private:
+		static constexpr uint64_t rounded_quotient(unsigned int length, unsigned int clock_rate) {
+			// length is at most 32 bits, so the shifted dividend fits in 64; the remainder is less than
+			// clock_rate and therefore can safely be doubled for rounding.
+			const uint64_t dividend = uint64_t(length) << FractionalBits;
+			const uint64_t quotient = dividend / clock_rate;
+			const uint64_t remainder = dividend % clock_rate;
+			return quotient + ((remainder << 1) >= clock_rate ? 1 : 0);
+		}
+};
+
 }
 
 #endif /* Storage_h */
@@ -8,6 +8,7 @@
 
 #include "CAS.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -179,7 +180,35 @@ void CAS::virtual_reset() {
 	distance_into_bit_ = 0;
 }
 
+uint64_t CAS::virtual_seek(uint64_t offset, uint64_t current) {
+	const auto checkpoint = std::upper_bound(
+		checkpoints_.begin(), checkpoints_.end(), offset,
+		[] (uint64_t offset, const Checkpoint &checkpoint) {
+			return offset < checkpoint.offset;
+		});
+	if(offset >= current && (checkpoint == checkpoints_.begin() || (checkpoint - 1)->offset <= current)) {
+		return current;
+	}
+	if(checkpoint == checkpoints_.begin()) {
+		virtual_reset();
+		return 0;
+	}
+
+	const auto &resume = *(checkpoint - 1);
+	chunk_pointer_ = resume.chunk_pointer;
+	phase_ = resume.phase;
+	distance_into_phase_ = resume.distance_into_phase;
+	distance_into_bit_ = resume.distance_into_bit;
+	return resume.offset;
+}
+
 Tape::Pulse CAS::virtual_get_next_pulse() {
+	// Capture the current state every so often, for the benefit of virtual_seek.
+	const uint64_t offset = get_offset();
+	if(checkpoints_.empty() || offset >= checkpoints_.back().offset + 4096) {
+		checkpoints_.push_back({offset, chunk_pointer_, phase_, distance_into_phase_, distance_into_bit_});
+	}
+
 	Pulse pulse;
 	pulse.length.clock_rate = 9600;
 	// Clock rate is four times the baud rate (of 2400), because the quickest thing that might need
@@ -41,6 +41,7 @@ class CAS: public Tape {
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		uint64_t virtual_seek(uint64_t offset, uint64_t current);
 
 		// Storage for the array of data blobs to transcribe into audio;
 		// each chunk is preceded by a header which may be long, and is optionally
@@ -65,6 +66,16 @@ class CAS: public Tape {
 		} phase_ = Phase::Header;
 		std::size_t distance_into_phase_ = 0;
 		std::size_t distance_into_bit_ = 0;
+
+		// Periodic captures of the state above, to allow rewinding without replaying from the start.
+		struct Checkpoint {
+			uint64_t offset;
+			std::size_t chunk_pointer;
+			Phase phase;
+			std::size_t distance_into_phase;
+			std::size_t distance_into_bit;
+		};
+		std::vector<Checkpoint> checkpoints_;
 };
 
 }
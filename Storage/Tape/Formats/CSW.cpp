@@ -10,12 +10,12 @@
 
 #include "../../FileHolder.hpp"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace Storage::Tape;
 
-CSW::CSW(const std::string &file_name) :
-	source_data_pointer_(0) {
+CSW::CSW(const std::string &file_name) {
 	Storage::FileHolder file(file_name);
 	if(file.stats().st_size < 0x20) throw ErrorNotCSW;
 
@@ -62,69 +62,167 @@ CSW::CSW(const std::string &file_name) :
 	}
 
 	// Grab all data remaining in the file.
-	std::vector<uint8_t> file_data;
 	std::size_t remaining_data = size_t(file.stats().st_size) - size_t(file.tell());
-	file_data.resize(remaining_data);
-	file.read(file_data.data(), remaining_data);
+	source_data_.resize(remaining_data);
+	file.read(source_data_.data(), remaining_data);
 
-	if(compression_type_ == CompressionType::ZRLE) {
-		// The only clue given by CSW as to the output size in bytes is that there will be
-		// number_of_waves waves. Waves are usually one byte, but may be five. So this code
-		// is pessimistic.
-		source_data_.resize(size_t(number_of_waves) * 5);
-
-		// uncompress will tell how many compressed bytes there actually were, so use its
-		// modification of output_length to throw away all the memory that isn't actually
-		// needed.
-		uLongf output_length = uLongf(number_of_waves * 5);
-		uncompress(source_data_.data(), &output_length, file_data.data(), file_data.size());
-		source_data_.resize(std::size_t(output_length));
-	} else {
-		source_data_ = std::move(file_data);
-	}
+	// The number of waves isn't needed; data is inflated only until zlib reports its end.
+	(void)number_of_waves;
 
 	invert_pulse();
+	initial_type_ = pulse_.type;
+	virtual_reset();
 }
 
-CSW::CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) : compression_type_(compression_type) {
+CSW::CSW(std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate) :
+	compression_type_(compression_type),
+	source_data_(std::move(data)) {
 	pulse_.length.clock_rate = sampling_rate;
 	pulse_.type = initial_level ? Pulse::High : Pulse::Low;
-	source_data_ = std::move(data);
+	initial_type_ = pulse_.type;
+	virtual_reset();
+}
+
+CSW::~CSW() {
+	if(compression_type_ == CompressionType::ZRLE) {
+		inflateEnd(&stream_);
+	}
+	for(auto &checkpoint: checkpoints_) {
+		if(checkpoint.stream) inflateEnd(checkpoint.stream.get());
+	}
+}
+
+// MARK: - Data source.
+
+namespace {
+
+/// The number of RLE bytes to consume between checkpoints.
+constexpr uint64_t CheckpointInterval = 4 * 1024 * 1024;
+
+}
+
+void CSW::start_stream() {
+	if(compression_type_ == CompressionType::RLE) {
+		data_ = source_data_.data();
+		data_size_ = source_data_.size();
+		data_pointer_ = 0;
+		return;
+	}
+
+	stream_.next_in = source_data_.data();
+	stream_.avail_in = uInt(source_data_.size());
+	stream_is_finished_ = false;
+	if(stream_.state) {
+		stream_is_finished_ = inflateReset(&stream_) != Z_OK;
+	} else {
+		stream_is_finished_ = inflateInit(&stream_) != Z_OK;
+	}
+
+	data_ = window_.data();
+	data_size_ = data_pointer_ = 0;
+}
+
+bool CSW::refill() {
+	if(compression_type_ == CompressionType::RLE) return false;
+
+	data_pointer_ = data_size_ = 0;
+	while(!data_size_ && !stream_is_finished_) {
+		stream_.next_out = window_.data();
+		stream_.avail_out = uInt(window_.size());
+		stream_is_finished_ = inflate(&stream_, Z_NO_FLUSH) != Z_OK;
+		data_size_ = window_.size() - stream_.avail_out;
+	}
+	return data_size_;
+}
+
+uint64_t CSW::position() const {
+	if(compression_type_ == CompressionType::RLE) return data_pointer_;
+	return uint64_t(stream_.total_out) - (data_size_ - data_pointer_);
 }
 
 uint8_t CSW::get_next_byte() {
-	if(source_data_pointer_ == source_data_.size()) return 0xff;
-	uint8_t result = source_data_[source_data_pointer_];
-	source_data_pointer_++;
-	return result;
+	if(data_pointer_ == data_size_ && !refill()) return 0xff;
+	return data_[data_pointer_++];
 }
 
 uint32_t CSW::get_next_int32le() {
-	if(source_data_pointer_ > source_data_.size() - 4) return 0xffff;
-	uint32_t result = uint32_t(
-		(source_data_[source_data_pointer_ + 0] << 0) |
-		(source_data_[source_data_pointer_ + 1] << 8) |
-		(source_data_[source_data_pointer_ + 2] << 16) |
-		(source_data_[source_data_pointer_ + 3] << 24));
-	source_data_pointer_ += 4;
+	uint32_t result = 0;
+	for(int shift = 0; shift < 32; shift += 8) {
+		if(is_at_end()) return 0xffff;
+		result |= uint32_t(get_next_byte()) << shift;
+	}
 	return result;
 }
 
+// MARK: - Checkpoints.
+
+void CSW::add_checkpoint() {
+	Checkpoint checkpoint{pulse_count_, position(), pulse_.type, nullptr};
+	if(compression_type_ == CompressionType::ZRLE) {
+		checkpoint.stream = std::make_unique<z_stream>();
+		if(inflateCopy(checkpoint.stream.get(), &stream_) != Z_OK) return;
+	}
+	checkpoints_.push_back(std::move(checkpoint));
+}
+
+uint64_t CSW::virtual_seek(uint64_t offset, uint64_t current) {
+	// Find the latest checkpoint no later than offset, if any, and use it only if it's
+	// closer than the current position.
+	const auto checkpoint = std::upper_bound(
+		checkpoints_.begin(), checkpoints_.end(), offset,
+		[] (uint64_t offset, const Checkpoint &checkpoint) {
+			return offset < checkpoint.pulse_count;
+		});
+	if(offset >= current && (checkpoint == checkpoints_.begin() || (checkpoint - 1)->pulse_count <= current)) {
+		return current;
+	}
+	if(checkpoint == checkpoints_.begin()) {
+		virtual_reset();
+		return 0;
+	}
+
+	const auto &resume = *(checkpoint - 1);
+	if(compression_type_ == CompressionType::ZRLE) {
+		inflateEnd(&stream_);
+		stream_is_finished_ = inflateCopy(&stream_, resume.stream.get()) != Z_OK;
+		data_size_ = data_pointer_ = 0;
+	} else {
+		data_pointer_ = size_t(resume.position);
+	}
+	pulse_.type = resume.type;
+	pulse_count_ = resume.pulse_count;
+	return pulse_count_;
+}
+
+// MARK: - Tape.
+
 void CSW::invert_pulse() {
 	pulse_.type = (pulse_.type == Pulse::High) ? Pulse::Low : Pulse::High;
 }
 
 bool CSW::is_at_end() {
-	return source_data_pointer_ == source_data_.size();
+	return data_pointer_ == data_size_ && !refill();
 }
 
 void CSW::virtual_reset() {
-	source_data_pointer_ = 0;
+	pulse_.type = initial_type_;
+	pulse_count_ = 0;
+	start_stream();
 }
 
 Tape::Pulse CSW::virtual_get_next_pulse() {
+	// Checkpoints for compressed data are taken only when the window is empty, so that
+	// they needn't include any inflated data.
+	if(
+		(compression_type_ == CompressionType::RLE || data_pointer_ == data_size_) &&
+		position() >= (checkpoints_.empty() ? 0 : checkpoints_.back().position) + CheckpointInterval
+	) {
+		add_checkpoint();
+	}
+
 	invert_pulse();
 	pulse_.length.length = get_next_byte();
 	if(!pulse_.length.length) pulse_.length.length = get_next_int32le();
+	++pulse_count_;
 	return pulse_;
 }
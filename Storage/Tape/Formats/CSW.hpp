@@ -11,6 +11,8 @@
 
 #include "../Tape.hpp"
 
+#include <array>
+#include <memory>
 #include <string>
 #include <vector>
 #include <zlib.h>
@@ -20,6 +22,10 @@ namespace Tape {
 
 /*!
 	Provides a @c Tape containing a CSW tape image, which is a compressed 1-bit sampling.
+
+	Compressed images are inflated on demand into a small window rather than in full, with the
+	inflation state being captured periodically so that earlier parts of the tape can be returned to
+	without starting again from the beginning.
 */
 class CSW: public Tape {
 	public:
@@ -38,7 +44,11 @@ class CSW: public Tape {
 		/*!
 			Constructs a @c CSW containing content as specified. Does not throw.
 		*/
-		CSW(const std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate);
+		CSW(std::vector<uint8_t> &&data, CompressionType compression_type, bool initial_level, uint32_t sampling_rate);
+		~CSW();
+
+		CSW(const CSW &) = delete;
+		CSW &operator =(const CSW &) = delete;
 
 		enum {
 			ErrorNotCSW
@@ -50,16 +60,46 @@ class CSW: public Tape {
 	private:
 		void virtual_reset();
 		Pulse virtual_get_next_pulse();
+		uint64_t virtual_seek(uint64_t offset, uint64_t current);
 
 		Pulse pulse_;
+		Pulse::Type initial_type_;
 		CompressionType compression_type_;
 
 		uint8_t get_next_byte();
 		uint32_t get_next_int32le();
 		void invert_pulse();
 
+		// The contents of the file following its header; this is left compressed if it was compressed.
 		std::vector<uint8_t> source_data_;
-		std::size_t source_data_pointer_;
+
+		// The RLE data currently being read: either source_data_ itself or, for compressed files,
+		// a window of inflated data.
+		const uint8_t *data_ = nullptr;
+		std::size_t data_size_ = 0;
+		std::size_t data_pointer_ = 0;
+
+		// Inflation state, for compressed files.
+		z_stream stream_{};
+		bool stream_is_finished_ = false;
+		std::array<uint8_t, 65536> window_;
+		void start_stream();
+		bool refill();
+
+		// The number of pulses supplied since the tape was reset, and the number of RLE bytes consumed.
+		uint64_t pulse_count_ = 0;
+		uint64_t position() const;
+
+		// Points from which the tape can be resumed; for compressed files each carries a copy of the
+		// inflation state, which zlib requires remain at a fixed address.
+		struct Checkpoint {
+			uint64_t pulse_count;
+			uint64_t position;
+			Pulse::Type type;
+			std::unique_ptr<z_stream> stream;
+		};
+		std::vector<Checkpoint> checkpoints_;
+		void add_checkpoint();
 };
 
 }
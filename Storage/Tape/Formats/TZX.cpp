@@ -19,7 +19,7 @@ const unsigned int TZXClockMSMultiplier = 3500;
 }
 
 TZX::TZX(const std::string &file_name) :
-	file_(file_name),
+	file_(file_name, FileHolder::FileMode::Read),
 	current_level_(false) {
 
 	// Check for signature followed by a 0x1a
@@ -38,6 +38,7 @@ TZX::TZX(const std::string &file_name) :
 
 void TZX::virtual_reset() {
 	clear();
+	csw_.reset();
 	set_is_at_end(false);
 	file_.seek(0x0a, SEEK_SET);
 
@@ -48,8 +49,25 @@ void TZX::virtual_reset() {
 	post_gap(500);
 }
 
+std::optional<uint64_t> TZX::get_batch_position() {
+	// A CSW recording in progress has state of its own, so positions are captured only between blocks.
+	if(csw_) return std::nullopt;
+	return (uint64_t(file_.tell()) << 1) | (current_level_ ? 1 : 0);
+}
+
+void TZX::set_batch_position(uint64_t position) {
+	csw_.reset();
+	file_.seek(long(position >> 1), SEEK_SET);
+	current_level_ = position & 1;
+}
+
 void TZX::get_next_pulses() {
 	while(empty()) {
+		if(csw_) {
+			get_csw_pulses();
+			continue;
+		}
+
 		uint8_t chunk_id = file_.get8();
 		if(file_.eof()) {
 			set_is_at_end(true);
@@ -108,15 +126,25 @@ void TZX::get_csw_recording_block() {
 
 	std::vector<uint8_t> raw_block = file_.read(block_length - 10);
 
-	CSW csw(std::move(raw_block), (compression_type == 2) ? CSW::CompressionType::ZRLE : CSW::CompressionType::RLE, current_level_, sampling_rate);
-	while(!csw.is_at_end()) {
-		Tape::Pulse next_pulse = csw.get_next_pulse();
+	// Pulses are taken from the recording in batches by get_csw_pulses, rather than all at once,
+	// since a recording may run to many millions of pulses.
+	csw_ = std::make_unique<CSW>(std::move(raw_block), (compression_type == 2) ? CSW::CompressionType::ZRLE : CSW::CompressionType::RLE, current_level_, sampling_rate);
+	csw_pause_after_block_ = pause_after_block;
+
+	(void)number_of_compressed_pulses;
+}
+
+void TZX::get_csw_pulses() {
+	for(int c = 0; c < 4096 && !csw_->is_at_end(); c++) {
+		Tape::Pulse next_pulse = csw_->get_next_pulse();
 		current_level_ = (next_pulse.type == Tape::Pulse::High);
 		emplace_back(std::move(next_pulse));
 	}
 
-	(void)number_of_compressed_pulses;
-	post_gap(pause_after_block);
+	if(csw_->is_at_end()) {
+		csw_.reset();
+		post_gap(csw_pause_after_block_);
+	}
 }
 
 void TZX::get_generalised_data_block() {
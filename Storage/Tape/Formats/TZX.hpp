@@ -11,7 +11,9 @@
 
 #include "../PulseQueuedTape.hpp"
 #include "../../FileHolder.hpp"
+#include "CSW.hpp"
 
+#include <memory>
 #include <string>
 
 namespace Storage {
@@ -38,9 +40,15 @@ class TZX: public PulseQueuedTape {
 
 		void virtual_reset();
 		void get_next_pulses();
+		std::optional<uint64_t> get_batch_position();
+		void set_batch_position(uint64_t);
 
 		bool current_level_;
 
+		// The CSW recording currently being played, if any.
+		std::unique_ptr<CSW> csw_;
+		unsigned int csw_pause_after_block_ = 0;
+
 		void get_standard_speed_data_block();
 		void get_turbo_speed_data_block();
 		void get_pure_tone_data_block();
@@ -48,6 +56,7 @@ class TZX: public PulseQueuedTape {
 		void get_pure_data_block();
 		void get_direct_recording_block();
 		void get_csw_recording_block();
+		void get_csw_pulses();
 		void get_generalised_data_block();
 		void get_pause();
 
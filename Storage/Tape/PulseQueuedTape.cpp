@@ -8,6 +8,8 @@
 
 #include "PulseQueuedTape.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Tape;
 
 PulseQueuedTape::PulseQueuedTape() : pulse_pointer_(0), is_at_end_(false) {}
@@ -51,6 +53,15 @@ Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
 	}
 
 	if(pulse_pointer_ == queued_pulses_.size()) {
+		// Note the subclass's position, if it can supply one and nothing has been recorded recently.
+		const uint64_t offset = Tape::get_offset();
+		if(checkpoints_.empty() || offset >= checkpoints_.back().offset + 1024) {
+			const auto position = get_batch_position();
+			if(position) {
+				checkpoints_.push_back({offset, *position});
+			}
+		}
+
 		clear();
 		get_next_pulses();
 
@@ -63,3 +74,23 @@ Tape::Pulse PulseQueuedTape::virtual_get_next_pulse() {
 	pulse_pointer_++;
 	return queued_pulses_[read_pointer];
 }
+
+uint64_t PulseQueuedTape::virtual_seek(uint64_t offset, uint64_t current) {
+	const auto checkpoint = std::upper_bound(
+		checkpoints_.begin(), checkpoints_.end(), offset,
+		[] (uint64_t offset, const Checkpoint &checkpoint) {
+			return offset < checkpoint.offset;
+		});
+	if(offset >= current && (checkpoint == checkpoints_.begin() || (checkpoint - 1)->offset <= current)) {
+		return current;
+	}
+	if(checkpoint == checkpoints_.begin()) {
+		reset();
+		return 0;
+	}
+
+	clear();
+	set_is_at_end(false);
+	set_batch_position((checkpoint - 1)->position);
+	return (checkpoint - 1)->offset;
+}
@@ -10,6 +10,7 @@
 #define PulseQueuedTape_hpp
 
 #include "Tape.hpp"
+#include <optional>
 #include <vector>
 
 namespace Storage {
@@ -24,6 +25,10 @@ namespace Tape {
 	Otherwise get_next_pulse() returns something from the pulse queue if there is
 	anything there, and otherwise calls get_next_pulses(). get_next_pulses() is
 	virtual, giving subclasses a chance to provide the next batch of pulses.
+
+	Subclasses that can summarise their state between batches as a single integer may also
+	implement get_batch_position() and set_batch_position(), allowing earlier parts of the
+	tape to be revisited without replaying from the start.
 */
 class PulseQueuedTape: public Tape {
 	public:
@@ -39,10 +44,24 @@ class PulseQueuedTape: public Tape {
 		void set_is_at_end(bool);
 		virtual void get_next_pulses() = 0;
 
+		/// @returns A description of the subclass's current state, at a point where the next call will be to
+		/// get_next_pulses, or @c std::nullopt if no such description is currently possible.
+		virtual std::optional<uint64_t> get_batch_position() { return std::nullopt; }
+
+		/// Restores a state previously described by get_batch_position().
+		virtual void set_batch_position(uint64_t) {}
+
 	private:
 		Pulse virtual_get_next_pulse();
+		uint64_t virtual_seek(uint64_t offset, uint64_t current);
 		Pulse silence();
 
+		struct Checkpoint {
+			uint64_t offset;
+			uint64_t position;
+		};
+		std::vector<Checkpoint> checkpoints_;
+
 		std::vector<Pulse> queued_pulses_;
 		std::size_t pulse_pointer_;
 		bool is_at_end_;
@@ -8,6 +8,8 @@
 
 #include "Tape.hpp"
 
+#include <algorithm>
+
 using namespace Storage::Tape;
 
 // MARK: - Lifecycle
@@ -18,24 +20,61 @@ TapePlayer::TapePlayer(int input_clock_rate) :
 
 // MARK: - Seeking
 
+void Storage::Tape::Tape::add_index_entry(const FixedTime &time) {
+	if(offset_ % IndexInterval) return;
+	if(!index_.empty() && index_.back().offset >= offset_) return;
+	index_.push_back({time, offset_});
+}
+
 void Storage::Tape::Tape::seek(Time &seek_time) {
-	Time next_time(0);
-	reset();
-	while(next_time <= seek_time) {
+	const FixedTime target(seek_time);
+
+	// Start from the latest indexed pulse that begins no later than seek_time, if any.
+	const auto entry = std::upper_bound(
+		index_.begin(), index_.end(), target,
+		[] (const FixedTime &time, const IndexEntry &entry) {
+			return time < entry.time;
+		});
+
+	FixedTime next_time;
+	if(entry == index_.begin()) {
+		reset();
+	} else {
+		set_offset((entry - 1)->offset);
+		next_time = (entry - 1)->time;
+	}
+
+	while(next_time <= target) {
+		add_index_entry(next_time);
 		get_next_pulse();
-		next_time += pulse_.length;
+		next_time += FixedTime(pulse_.length);
 	}
 }
 
 Storage::Time Tape::get_current_time() {
-	Time time(0);
-	uint64_t steps = get_offset();
-	reset();
-	while(steps--) {
+	const uint64_t target = get_offset();
+
+	// Start from the latest indexed pulse that is no later than the current one, if any.
+	const auto entry = std::upper_bound(
+		index_.begin(), index_.end(), target,
+		[] (uint64_t offset, const IndexEntry &entry) {
+			return offset < entry.offset;
+		});
+
+	FixedTime time;
+	if(entry == index_.begin()) {
+		reset();
+	} else {
+		set_offset((entry - 1)->offset);
+		time = (entry - 1)->time;
+	}
+
+	while(offset_ < target) {
+		add_index_entry(time);
 		get_next_pulse();
-		time += pulse_.length;
+		time += FixedTime(pulse_.length);
 	}
-	return time;
+	return time.as_time();
 }
 
 void Storage::Tape::Tape::reset() {
@@ -55,9 +94,7 @@ uint64_t Tape::get_offset() {
 
 void Tape::set_offset(uint64_t offset) {
 	if(offset == offset_) return;
-	if(offset < offset_) {
-		reset();
-	}
+	offset_ = virtual_seek(offset, offset_);
 	offset -= offset_;
 	while(offset--) get_next_pulse();
 }
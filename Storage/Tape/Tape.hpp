@@ -10,6 +10,7 @@
 #define Tape_hpp
 
 #include <memory>
+#include <vector>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ClockingHintSource.hpp"
@@ -71,23 +72,50 @@ class Tape {
 		virtual void set_offset(uint64_t);
 
 		/*!
-			Calculates and returns the amount of time that has elapsed since the time began. Potentially expensive.
+			Calculates and returns the amount of time that has elapsed since the time began. Potentially expensive
+			the first time that any given part of the tape is considered.
 		*/
 		virtual Time get_current_time();
 
 		/*!
-			Seeks to @c time. Potentially expensive.
+			Seeks to @c time. Potentially expensive the first time that any given part of the tape is considered.
 		*/
 		virtual void seek(Time &time);
 
 		virtual ~Tape() {};
 
 	private:
-		uint64_t offset_;
+		uint64_t offset_ = 0;
 		Tape::Pulse pulse_;
 
+		// A sparse index of pulse offsets and the times at which those pulses begin, built up as a side effect
+		// of seek and get_current_time so that later calls can skip directly to a nearby offset.
+		// Times are accumulated in fixed point, as pulses of differing clock rates would otherwise
+		// each require rational arithmetic.
+		struct IndexEntry {
+			FixedTime time;
+			uint64_t offset;
+		};
+		std::vector<IndexEntry> index_;
+		static constexpr uint64_t IndexInterval = 4096;
+		void add_index_entry(const FixedTime &time);
+
 		virtual Pulse virtual_get_next_pulse() = 0;
 		virtual void virtual_reset() = 0;
+
+		/*!
+			Moves the tape directly to the latest point it can reach that is no later than pulse @c offset, given
+			that it is currently at pulse @c current, if doing so is quicker than advancing pulse by pulse.
+			Subclasses that can't seek faster than by replaying from the start need not override this.
+
+			@returns the offset of the pulse that will be supplied next; this will be @c current if the tape
+				wasn't moved.
+		*/
+		virtual uint64_t virtual_seek(uint64_t offset, uint64_t current) {
+			if(offset >= current) return current;
+			virtual_reset();
+			return 0;
+		}
 };
 
 /*!
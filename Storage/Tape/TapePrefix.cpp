@@ -0,0 +1,33 @@
+//
+//  TapePrefix.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "TapePrefix.hpp"
+
+using namespace Storage::Tape;
+
+TapePrefix::TapePrefix(const std::shared_ptr<Tape> &tape, Time length) :
+	tape_(tape), length_(length) {}
+
+bool TapePrefix::is_at_end() {
+	return elapsed_ >= length_ || tape_->is_at_end();
+}
+
+Tape::Pulse TapePrefix::virtual_get_next_pulse() {
+	if(elapsed_ >= length_) {
+		return Pulse(Pulse::Zero, Time(1));
+	}
+
+	const Pulse pulse = tape_->get_next_pulse();
+	elapsed_ += FixedTime(pulse.length);
+	return pulse;
+}
+
+void TapePrefix::virtual_reset() {
+	tape_->reset();
+	elapsed_ = FixedTime();
+}
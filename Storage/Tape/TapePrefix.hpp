@@ -0,0 +1,45 @@
+//
+//  TapePrefix.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 15/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef TapePrefix_hpp
+#define TapePrefix_hpp
+
+#include "Tape.hpp"
+
+#include <memory>
+
+namespace Storage {
+namespace Tape {
+
+/*!
+	Presents no more than a given running time of another tape, starting from its current position,
+	and thereafter reports being at the end. Pulses are pulled from the underlying tape only as they
+	are consumed, so a long tape costs no more to inspect than a short one.
+
+	Once the limit has been reached get_next_pulse() returns a second of silence, as would any
+	other tape that had ended. Resetting a prefix resets the underlying tape too, and measures
+	the limit from its start.
+*/
+class TapePrefix: public Tape {
+	public:
+		TapePrefix(const std::shared_ptr<Tape> &tape, Time length);
+		bool is_at_end() final;
+
+	private:
+		Pulse virtual_get_next_pulse() final;
+		void virtual_reset() final;
+
+		std::shared_ptr<Tape> tape_;
+		const FixedTime length_;
+		FixedTime elapsed_;
+};
+
+}
+}
+
+#endif /* TapePrefix_hpp */